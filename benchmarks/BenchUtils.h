@@ -0,0 +1,96 @@
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+/**
+ * @brief 基准测试公共工具
+ *
+ * 计时取多次运行中的最短时间，减少调度抖动的影响；
+ * 命令行统一使用 --name value 形式的参数。
+ */
+namespace bench {
+
+inline double nowSeconds() {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+// 运行 fn 共 repeats 次，返回单次最短耗时（秒）
+template <typename Fn>
+double bestOf(int repeats, Fn fn) {
+    double best = 1e30;
+    for (int i = 0; i < repeats; ++i) {
+        double start = nowSeconds();
+        fn();
+        double elapsed = nowSeconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// 防止编译器把结果未被使用的计算优化掉
+inline void doNotOptimize(const void* p) {
+    static const void* volatile sink;
+    sink = p;
+    (void)sink;
+}
+
+inline size_t argSize(int argc, char** argv, const char* name, size_t defaultValue) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return static_cast<size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+        }
+    }
+    return defaultValue;
+}
+
+inline std::string argString(int argc, char** argv, const char* name, const std::string& defaultValue) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+    return defaultValue;
+}
+
+// 进程启动以来的常驻内存峰值（字节），取不到时返回 0
+inline size_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<size_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);            // macOS 以字节为单位
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024u;    // Linux 以 KB 为单位
+#endif
+#endif
+}
+
+inline void printHeader(const char* title) {
+    std::printf("\n== %s ==\n", title);
+}
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,154 @@
+// BVH 射线查询基准：起伏球面网格（默认约 0.5M 个三角形），随机射线射向球心附近，
+// 统计构建时间与最近交点 / 任意交点的每秒射线数，并与逐三角形求交对比
+// 用法：bench_bvh [--segments N] [--rays R] [--repeats K]
+
+#include "BenchUtils.h"
+#include "core/Parallel.h"
+#include "mesh/MeshBVH.h"
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 经纬度各 segments 分段的球面，半径随角度起伏，避免射线全部垂直入射
+void makeBumpySphere(size_t segments, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    const float kPi = 3.14159265358979f;
+    vertices.clear();
+    indices.clear();
+    vertices.reserve((segments + 1) * (segments + 1));
+    indices.reserve(segments * segments * 6);
+    for (size_t y = 0; y <= segments; ++y) {
+        for (size_t x = 0; x <= segments; ++x) {
+            float u = static_cast<float>(x) / static_cast<float>(segments);
+            float v = static_cast<float>(y) / static_cast<float>(segments);
+            float theta = u * 2.0f * kPi;
+            float phi = v * kPi;
+            float r = 1.0f + 0.05f * std::sin(theta * 12.0f) * std::sin(phi * 9.0f);
+            glm::vec3 n(std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi));
+            vertices.push_back(Vertex(n * r, n, glm::vec2(u, v)));
+        }
+    }
+    for (size_t y = 0; y < segments; ++y) {
+        for (size_t x = 0; x < segments; ++x) {
+            unsigned int current = static_cast<unsigned int>(y * (segments + 1) + x);
+            unsigned int next = current + static_cast<unsigned int>(segments + 1);
+            indices.insert(indices.end(), { next, current, current + 1, next + 1, current + 1, next });
+        }
+    }
+}
+
+// 起点在半径 3 的球面上，指向半径 1.2 内的随机点：约 3/4 的射线命中
+std::vector<MeshBVH::Ray> makeRays(size_t count) {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    std::uniform_real_distribution<float> uniform(-1.2f, 1.2f);
+    std::vector<MeshBVH::Ray> rays(count);
+    for (auto& ray : rays) {
+        glm::vec3 origin = glm::normalize(glm::vec3(gaussian(rng), gaussian(rng), gaussian(rng))) * 3.0f;
+        glm::vec3 target(uniform(rng), uniform(rng), uniform(rng));
+        ray = MeshBVH::Ray(origin, glm::normalize(target - origin));
+    }
+    return rays;
+}
+
+bool bruteForce(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                const MeshBVH::Ray& ray, float& closest) {
+    bool found = false;
+    closest = ray.tMax;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        glm::vec3 p0 = vertices[indices[i]].position;
+        glm::vec3 e1 = vertices[indices[i + 1]].position - p0;
+        glm::vec3 e2 = vertices[indices[i + 2]].position - p0;
+        glm::vec3 pvec = glm::cross(ray.direction, e2);
+        float det = glm::dot(e1, pvec);
+        if (std::fabs(det) < 1e-30f) continue;
+        float invDet = 1.0f / det;
+        glm::vec3 tvec = ray.origin - p0;
+        float u = glm::dot(tvec, pvec) * invDet;
+        if (u < 0.0f || u > 1.0f) continue;
+        glm::vec3 qvec = glm::cross(tvec, e1);
+        float v = glm::dot(ray.direction, qvec) * invDet;
+        if (v < 0.0f || u + v > 1.0f) continue;
+        float t = glm::dot(e2, qvec) * invDet;
+        if (t >= ray.tMin && t <= closest) {
+            closest = t;
+            found = true;
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t segments = bench::argSize(argc, argv, "--segments", 512);
+    size_t rayCount = bench::argSize(argc, argv, "--rays", 1 << 20);
+    int repeats = static_cast<int>(bench::argSize(argc, argv, "--repeats", 3));
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeBumpySphere(segments, vertices, indices);
+    std::vector<MeshBVH::Ray> rays = makeRays(rayCount);
+
+    std::printf("BVH benchmark: %zu triangles, %zu rays, %u workers\n",
+                indices.size() / 3, rays.size(), Parallel::getMaxWorkers());
+
+    MeshBVH bvh;
+    bench::printHeader("Build");
+    double buildTime = bench::bestOf(repeats, [&]() {
+        bvh.build(vertices, indices);
+        bench::doNotOptimize(&bvh);
+    });
+    MeshBVH::Stats stats = bvh.getStats();
+    std::printf("build       %9.2f ms  %8.2f Mtri/s\n", buildTime * 1e3, stats.triangleCount / buildTime / 1e6);
+    std::printf("nodes       %zu (%zu leaves), depth %u, SAH cost %.2f, %.1f MB\n",
+                stats.nodeCount, stats.leafCount, stats.maxDepth, stats.sahCost,
+                bvh.getMemoryUsage() / (1024.0 * 1024.0));
+
+    // 查询是只读的，多线程按射线区间划分
+    std::atomic<size_t> hitCount(0);
+    auto runQueries = [&](bool anyHit) {
+        hitCount = 0;
+        Parallel::forRange(rays.size(), 4096, [&](size_t begin, size_t end, unsigned int) {
+            size_t hits = 0;
+            MeshBVH::Hit hit;
+            for (size_t i = begin; i < end; ++i) {
+                hits += anyHit ? bvh.occluded(rays[i]) : bvh.intersect(rays[i], hit);
+            }
+            hitCount += hits;
+        });
+    };
+
+    bench::printHeader("Queries");
+    const unsigned int workerCounts[] = { 1, 0 };
+    for (int anyHit = 0; anyHit < 2; ++anyHit) {
+        double singleTime = 0.0;
+        for (unsigned int workers : workerCounts) {
+            Parallel::setMaxWorkers(workers);
+            double t = bench::bestOf(repeats, [&]() { runQueries(anyHit != 0); });
+            if (workers == 1) singleTime = t;
+            std::printf("%-8s %2u workers  %9.2f ms  %8.2f Mrays/s  x%.2f  (%.1f%% hit)\n",
+                        anyHit ? "any" : "closest", Parallel::getMaxWorkers(), t * 1e3,
+                        rays.size() / t / 1e6, singleTime / t, 100.0 * hitCount / rays.size());
+        }
+    }
+    Parallel::setMaxWorkers(0);
+
+    // 逐三角形求交只测少量射线，并核对结果
+    size_t bruteRays = std::min<size_t>(rays.size(), 64);
+    size_t mismatches = 0;
+    double bruteTime = bench::bestOf(1, [&]() {
+        for (size_t i = 0; i < bruteRays; ++i) {
+            float expected;
+            bool found = bruteForce(vertices, indices, rays[i], expected);
+            MeshBVH::Hit hit;
+            bool bvhFound = bvh.intersect(rays[i], hit);
+            if (found != bvhFound || (found && std::fabs(hit.t - expected) > 1e-4f)) ++mismatches;
+        }
+    });
+    std::printf("%-8s %2u workers  %9.2f ms  %8.4f Mrays/s  (%zu rays, %zu mismatches)\n",
+                "brute", 1u, bruteTime * 1e3, bruteRays / bruteTime / 1e6, bruteRays, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+// 网格编码基准：内置图元表（立方体 / 球 / 圆环）与大型合成网格（起伏高度场、起伏球面），
+// 统计顶点流 / 索引流的压缩率、编码时间与单线程解码吞吐（按解码后的字节数计），并用 memcpy 作参照
+// 用法：bench_mesh_codec [--grid N] [--segments S] [--repeats K]
+
+#include "BenchUtils.h"
+#include "mesh/MeshCodec.h"
+#include "mesh/PrimitiveTables.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Case {
+    std::string name;
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
+// N x N 个格子的起伏高度场，顶点和索引按行排列
+Case makeTerrain(size_t size) {
+    Case c;
+    c.name = "terrain " + std::to_string(size);
+    c.vertices.reserve((size + 1) * (size + 1));
+    c.indices.reserve(size * size * 6);
+    for (size_t z = 0; z <= size; ++z) {
+        for (size_t x = 0; x <= size; ++x) {
+            float u = static_cast<float>(x) / static_cast<float>(size);
+            float v = static_cast<float>(z) / static_cast<float>(size);
+            float h = 0.1f * std::sin(u * 23.0f) * std::cos(v * 17.0f) + 0.02f * std::sin(u * 131.0f + v * 97.0f);
+            glm::vec3 normal = glm::normalize(glm::vec3(-2.3f * std::cos(u * 23.0f), 1.0f, 1.7f * std::sin(v * 17.0f)));
+            c.vertices.push_back(Vertex(glm::vec3(u * 100.0f, h * 100.0f, v * 100.0f), normal, glm::vec2(u * 16.0f, v * 16.0f)));
+        }
+    }
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t x = 0; x < size; ++x) {
+            unsigned int i0 = static_cast<unsigned int>(z * (size + 1) + x);
+            unsigned int i2 = i0 + static_cast<unsigned int>(size + 1);
+            c.indices.insert(c.indices.end(), { i0, i2, i0 + 1, i0 + 1, i2, i2 + 1 });
+        }
+    }
+    return c;
+}
+
+// 经纬度各 segments 分段、半径起伏的球面
+Case makeBumpySphere(size_t segments) {
+    const float kPi = 3.14159265358979f;
+    Case c;
+    c.name = "sphere " + std::to_string(segments);
+    for (size_t y = 0; y <= segments; ++y) {
+        for (size_t x = 0; x <= segments; ++x) {
+            float u = static_cast<float>(x) / static_cast<float>(segments);
+            float v = static_cast<float>(y) / static_cast<float>(segments);
+            float theta = u * 2.0f * kPi;
+            float phi = v * kPi;
+            float r = 1.0f + 0.05f * std::sin(theta * 12.0f) * std::sin(phi * 9.0f);
+            glm::vec3 n(std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi));
+            c.vertices.push_back(Vertex(n * r, n, glm::vec2(u, v)));
+        }
+    }
+    for (size_t y = 0; y < segments; ++y) {
+        for (size_t x = 0; x < segments; ++x) {
+            unsigned int current = static_cast<unsigned int>(y * (segments + 1) + x);
+            unsigned int next = current + static_cast<unsigned int>(segments + 1);
+            c.indices.insert(c.indices.end(), { next, current, current + 1, next + 1, current + 1, next });
+        }
+    }
+    return c;
+}
+
+Case fromTable(const char* name, const PrimitiveTables::TableView& table) {
+    Case c;
+    c.name = name;
+    PrimitiveTables::copyTo(table, 1.0f, c.vertices, c.indices);
+    return c;
+}
+
+double gbPerSecond(size_t bytes, double seconds) {
+    return bytes / seconds / 1e9;
+}
+
+// 返回解码结果是否与原数据逐字节一致
+bool runCase(const Case& c, int repeats) {
+    const size_t stride = sizeof(Vertex);
+    const size_t vertexBytes = c.vertices.size() * stride;
+    const size_t indexBytes = c.indices.size() * sizeof(unsigned int);
+    const size_t triangles = c.indices.size() / 3;
+
+    std::vector<unsigned char> encodedVertices;
+    std::vector<unsigned char> encodedIndices;
+    encodedVertices.reserve(MeshCodec::getVertexBufferBound(c.vertices.size(), stride));
+    encodedIndices.reserve(MeshCodec::getIndexBufferBound(c.indices.size()));
+    double vertexEncode = bench::bestOf(repeats, [&]() {
+        MeshCodec::encodeVertices(c.vertices.data(), c.vertices.size(), stride, encodedVertices);
+    });
+    double indexEncode = bench::bestOf(repeats, [&]() {
+        MeshCodec::encodeIndices(c.indices.data(), c.indices.size(), encodedIndices);
+    });
+
+    std::vector<Vertex> vertices(c.vertices.size());
+    std::vector<unsigned int> indices(c.indices.size());
+    bool ok = true;
+    double vertexDecode = bench::bestOf(repeats, [&]() {
+        ok &= MeshCodec::decodeVertices(encodedVertices.data(), encodedVertices.size(),
+                                        vertices.data(), vertices.size(), stride);
+        bench::doNotOptimize(vertices.data());
+    });
+    double indexDecode = bench::bestOf(repeats, [&]() {
+        ok &= MeshCodec::decodeIndices(encodedIndices.data(), encodedIndices.size(), indices.data(), indices.size());
+        bench::doNotOptimize(indices.data());
+    });
+    ok = ok && std::memcmp(vertices.data(), c.vertices.data(), vertexBytes) == 0 && indices == c.indices;
+
+    std::printf("%-14s %9zu %9zu  %5.1f%% %6.2f GB/s %6.2f GB/s  %5.2f B/tri %6.2f GB/s %6.2f GB/s  %s\n",
+                c.name.c_str(), c.vertices.size(), triangles,
+                100.0 * encodedVertices.size() / vertexBytes,
+                gbPerSecond(vertexBytes, vertexEncode), gbPerSecond(vertexBytes, vertexDecode),
+                triangles ? static_cast<double>(encodedIndices.size()) / triangles : 0.0,
+                gbPerSecond(indexBytes, indexEncode), gbPerSecond(indexBytes, indexDecode),
+                ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t gridSize = bench::argSize(argc, argv, "--grid", 1024);
+    size_t segments = bench::argSize(argc, argv, "--segments", 1024);
+    int repeats = static_cast<int>(bench::argSize(argc, argv, "--repeats", 5));
+
+    std::vector<Case> cases;
+    cases.push_back(fromTable("cube", PrimitiveTables::cube()));
+    cases.push_back(fromTable("sphere 64", PrimitiveTables::sphere(64)));
+    cases.push_back(fromTable("torus 32", PrimitiveTables::torus(32)));
+    cases.push_back(makeTerrain(gridSize));
+    cases.push_back(makeBumpySphere(segments));
+
+    std::printf("Mesh codec benchmark: %zu-byte vertices, single thread\n", sizeof(Vertex));
+    bench::printHeader("Compression and throughput");
+    std::printf("%-14s %9s %9s  %6s %11s %11s  %9s %11s %11s\n", "mesh", "vertices", "triangles",
+                "vtx", "vtx enc", "vtx dec", "idx", "idx enc", "idx dec");
+    bool ok = true;
+    for (const Case& c : cases) ok &= runCase(c, repeats);
+
+    // 参照：同样大小的未压缩顶点数据直接拷贝
+    const Case& largest = cases[3];
+    std::vector<Vertex> copy(largest.vertices.size());
+    double copyTime = bench::bestOf(repeats, [&]() {
+        std::memcpy(copy.data(), largest.vertices.data(), copy.size() * sizeof(Vertex));
+        bench::doNotOptimize(copy.data());
+    });
+    std::printf("%-14s %9zu %9s  %6s %11s %6.2f GB/s\n", "memcpy", copy.size(), "-", "-", "-",
+                gbPerSecond(copy.size() * sizeof(Vertex), copyTime));
+    return ok ? 0 : 1;
+}
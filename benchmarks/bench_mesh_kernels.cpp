@@ -0,0 +1,110 @@
+// 顶点内核基准：AABB / 包围球 / 位置变换 / 法线变换，在 56 字节 Vertex 数组上跨步访问
+// 用法：bench_mesh_kernels [--vertices N] [--repeats R]
+
+#include "BenchUtils.h"
+#include "mesh/MeshKernels.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<Vertex> makeVertices(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<Vertex> vertices(count);
+    for (auto& v : vertices) {
+        v.position = glm::vec3(dist(rng), dist(rng), dist(rng));
+        v.normal = glm::normalize(glm::vec3(dist(rng), dist(rng), dist(rng)) + glm::vec3(0.001f));
+    }
+    return vertices;
+}
+
+// 改造前 CMesh::calculateBoundingBox 的写法，作为参考基线
+void aabbGlmLoop(const std::vector<Vertex>& vertices, glm::vec3& mn, glm::vec3& mx) {
+    mn = mx = vertices[0].position;
+    for (const auto& v : vertices) {
+        mn = glm::min(mn, v.position);
+        mx = glm::max(mx, v.position);
+    }
+}
+
+void report(const char* name, const char* level, double seconds, size_t count, double baseline) {
+    double nsPerVertex = seconds * 1e9 / static_cast<double>(count);
+    double mverts = static_cast<double>(count) / seconds / 1e6;
+    std::printf("%-22s %-7s %8.3f ms  %7.2f ns/vert  %8.1f Mvert/s  x%.2f\n",
+                name, level, seconds * 1e3, nsPerVertex, mverts, baseline / seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = bench::argSize(argc, argv, "--vertices", 4u << 20);
+    int repeats = static_cast<int>(bench::argSize(argc, argv, "--repeats", 10));
+
+    std::vector<Vertex> vertices = makeVertices(count);
+    std::vector<Vertex> scratch = vertices;
+    const size_t stride = sizeof(Vertex);
+
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+    model = glm::rotate(model, 0.7f, glm::vec3(0.3f, 1.0f, 0.2f));
+    model = glm::scale(model, glm::vec3(1.5f, 0.5f, 2.0f));
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+
+    std::printf("MeshKernels benchmark: %zu vertices, stride %zu bytes, detected %s\n",
+                count, stride, MeshKernels::getLevelName(MeshKernels::getDetectedLevel()));
+
+    glm::vec3 mn, mx;
+    bench::printHeader("AABB");
+    double glmTime = bench::bestOf(repeats, [&]() {
+        aabbGlmLoop(vertices, mn, mx);
+        bench::doNotOptimize(&mn);
+    });
+    report("glm loop (old path)", "-", glmTime, count, glmTime);
+
+    const MeshKernels::SimdLevel levels[] = {
+        MeshKernels::SimdLevel::Scalar, MeshKernels::SimdLevel::SSE2, MeshKernels::SimdLevel::AVX2
+    };
+
+    double scalarAABB = 0.0, scalarSphere = 0.0, scalarPos = 0.0, scalarNrm = 0.0;
+    for (MeshKernels::SimdLevel level : levels) {
+        if (level > MeshKernels::getDetectedLevel()) continue;
+        MeshKernels::setActiveLevel(level);
+        const char* name = MeshKernels::getLevelName(level);
+
+        double t = bench::bestOf(repeats, [&]() {
+            MeshKernels::computeAABB(vertices, mn, mx);
+            bench::doNotOptimize(&mn);
+        });
+        if (level == MeshKernels::SimdLevel::Scalar) scalarAABB = t;
+        report("computeAABB", name, t, count, scalarAABB);
+
+        glm::vec3 center;
+        float radius = 0.0f;
+        t = bench::bestOf(repeats, [&]() {
+            MeshKernels::computeBoundingSphere(vertices, center, radius);
+            bench::doNotOptimize(&radius);
+        });
+        if (level == MeshKernels::SimdLevel::Scalar) scalarSphere = t;
+        report("computeBoundingSphere", name, t, count, scalarSphere);
+
+        t = bench::bestOf(repeats, [&]() {
+            MeshKernels::transformPositions(&vertices[0].position.x, stride,
+                                            &scratch[0].position.x, stride, count, model);
+            bench::doNotOptimize(scratch.data());
+        });
+        if (level == MeshKernels::SimdLevel::Scalar) scalarPos = t;
+        report("transformPositions", name, t, count, scalarPos);
+
+        t = bench::bestOf(repeats, [&]() {
+            MeshKernels::transformNormals(&vertices[0].normal.x, stride,
+                                          &scratch[0].normal.x, stride, count, normalMatrix, true);
+            bench::doNotOptimize(scratch.data());
+        });
+        if (level == MeshKernels::SimdLevel::Scalar) scalarNrm = t;
+        report("transformNormals", name, t, count, scalarNrm);
+    }
+
+    MeshKernels::setActiveLevel(MeshKernels::getDetectedLevel());
+    return 0;
+}
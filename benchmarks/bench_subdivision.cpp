@@ -0,0 +1,90 @@
+// Loop 细分基准：起伏网格细分多层，输出默认约 2M 个三角形，对比单线程与全部工作线程，并记录内存峰值
+// 用法：bench_subdivision [--grid N] [--levels L] [--repeats R]
+
+#include "BenchUtils.h"
+#include "core/Parallel.h"
+#include "mesh/MeshUtils.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// N x N 个格子的起伏高度场，每格两个三角形
+void makeTerrain(size_t n, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    vertices.clear();
+    indices.clear();
+    vertices.reserve((n + 1) * (n + 1));
+    indices.reserve(n * n * 6);
+    for (size_t z = 0; z <= n; ++z) {
+        for (size_t x = 0; x <= n; ++x) {
+            float u = static_cast<float>(x) / static_cast<float>(n);
+            float v = static_cast<float>(z) / static_cast<float>(n);
+            float h = 0.1f * std::sin(u * 19.0f) * std::cos(v * 13.0f);
+            vertices.push_back(Vertex(glm::vec3(u, h, v), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(u, v)));
+        }
+    }
+    for (size_t z = 0; z < n; ++z) {
+        for (size_t x = 0; x < n; ++x) {
+            unsigned int i0 = static_cast<unsigned int>(z * (n + 1) + x);
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + static_cast<unsigned int>(n + 1);
+            unsigned int i3 = i2 + 1;
+            indices.insert(indices.end(), { i0, i2, i1, i1, i2, i3 });
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t grid = bench::argSize(argc, argv, "--grid", 64);
+    unsigned int levels = static_cast<unsigned int>(bench::argSize(argc, argv, "--levels", 4));
+    int repeats = static_cast<int>(bench::argSize(argc, argv, "--repeats", 3));
+
+    std::vector<Vertex> baseVertices;
+    std::vector<unsigned int> baseIndices;
+    makeTerrain(grid, baseVertices, baseIndices);
+
+    size_t outputTriangles = baseIndices.size() / 3;
+    for (unsigned int i = 0; i < levels; ++i) outputTriangles *= 4;
+
+    std::printf("Loop subdivision benchmark: %zu triangles x 4^%u = %zu triangles, %u workers\n",
+                baseIndices.size() / 3, levels, outputTriangles, Parallel::getMaxWorkers());
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    size_t rssBefore = bench::peakResidentBytes();
+
+    bench::printHeader("subdivideLoop");
+    const unsigned int workerCounts[] = { 1, 0 };
+    double singleTime = 0.0;
+    for (unsigned int workers : workerCounts) {
+        Parallel::setMaxWorkers(workers);
+        bool ok = true;
+        double t = bench::bestOf(repeats, [&]() {
+            vertices = baseVertices;
+            indices = baseIndices;
+            ok = MeshUtils::subdivideLoop(vertices, indices, levels) && ok;
+            bench::doNotOptimize(indices.data());
+        });
+        if (!ok) {
+            std::printf("subdivideLoop failed (output exceeds 32-bit indices?)\n");
+            return 1;
+        }
+        if (workers == 1) singleTime = t;
+        std::printf("%2u workers  %9.2f ms  %8.2f Mtri/s  x%.2f\n",
+                    Parallel::getMaxWorkers(), t * 1e3,
+                    static_cast<double>(outputTriangles) / t / 1e6, singleTime / t);
+    }
+    Parallel::setMaxWorkers(0);
+
+    size_t outputBytes = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int);
+    size_t rssAfter = bench::peakResidentBytes();
+    bench::printHeader("Memory");
+    std::printf("output      %zu vertices, %zu triangles, %.1f MB\n",
+                vertices.size(), indices.size() / 3, outputBytes / (1024.0 * 1024.0));
+    std::printf("peak RSS    %.1f MB (before subdivision %.1f MB, x%.2f of output)\n",
+                rssAfter / (1024.0 * 1024.0), rssBefore / (1024.0 * 1024.0),
+                outputBytes ? static_cast<double>(rssAfter - rssBefore) / outputBytes : 0.0);
+    return 0;
+}
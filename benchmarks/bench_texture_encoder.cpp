@@ -0,0 +1,131 @@
+// 块压缩编码基准：合成的颜色图（平滑渐变 + 细节）、带 alpha 的颜色图、由高度场生成的法线贴图和单通道遮罩，
+// 按格式与质量预设统计单线程 / 全部线程的编码吞吐（百万像素每秒，只编码 0 级）与 PSNR
+// 用法：bench_texture_encoder [--size N] [--repeats K]
+
+#include "BenchUtils.h"
+#include "core/Parallel.h"
+#include "mesh/TextureEncoder.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Case {
+    std::string name;
+    int channels;
+    BlockFormat format;
+    std::vector<unsigned char> pixels;
+};
+
+unsigned char toByte(double v) {
+    return static_cast<unsigned char>(std::min(255.0, std::max(0.0, v + 0.5)));
+}
+
+// 低频渐变叠加中高频细节，三个通道相关但不完全相同，接近照片类纹理
+Case makeColor(int size, bool alpha) {
+    Case c;
+    c.name = alpha ? "color+alpha" : "color";
+    c.channels = alpha ? 4 : 3;
+    c.format = alpha ? BlockFormat::BC3 : BlockFormat::BC1;
+    c.pixels.resize(static_cast<size_t>(size) * size * c.channels);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            double u = static_cast<double>(x) / size;
+            double v = static_cast<double>(y) / size;
+            double base = 0.5 + 0.35 * std::sin(u * 9.0 + std::cos(v * 7.0) * 2.0);
+            double detail = 0.08 * std::sin(x * 0.7 + y * 0.3) * std::cos(y * 0.45 - x * 0.2);
+            unsigned char* p = c.pixels.data() + (static_cast<size_t>(y) * size + x) * c.channels;
+            p[0] = toByte((base + detail) * 255.0);
+            p[1] = toByte((0.8 * base + 0.1 + detail * 0.5) * 255.0);
+            p[2] = toByte((0.6 - 0.4 * base + detail) * 255.0);
+            if (alpha) p[3] = toByte((0.5 + 0.5 * std::sin(u * 13.0) * std::cos(v * 11.0)) * 255.0);
+        }
+    }
+    return c;
+}
+
+// 起伏高度场的切线空间法线，只保存 xy
+Case makeNormalMap(int size) {
+    Case c;
+    c.name = "normal map";
+    c.channels = 2;
+    c.format = BlockFormat::BC5;
+    c.pixels.resize(static_cast<size_t>(size) * size * 2);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            double dx = 0.6 * std::cos(x * 0.11) * std::sin(y * 0.07) + 0.2 * std::cos(x * 0.9 + y * 0.4);
+            double dy = -0.6 * std::sin(x * 0.11) * std::cos(y * 0.07) + 0.2 * std::cos(x * 0.4 - y * 0.8);
+            double len = std::sqrt(dx * dx + dy * dy + 1.0);
+            unsigned char* p = c.pixels.data() + (static_cast<size_t>(y) * size + x) * 2;
+            p[0] = toByte((-dx / len * 0.5 + 0.5) * 255.0);
+            p[1] = toByte((-dy / len * 0.5 + 0.5) * 255.0);
+        }
+    }
+    return c;
+}
+
+Case makeMask(int size) {
+    Case c;
+    c.name = "mask";
+    c.channels = 1;
+    c.format = BlockFormat::BC4;
+    c.pixels.resize(static_cast<size_t>(size) * size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            double r = std::sqrt(static_cast<double>((x - size / 2) * (x - size / 2) + (y - size / 3) * (y - size / 3)));
+            c.pixels[static_cast<size_t>(y) * size + x] = toByte(127.5 + 127.5 * std::sin(r * 0.08) + 20.0 * std::sin(x * 1.3));
+        }
+    }
+    return c;
+}
+
+double megapixelsPerSecond(int size, double seconds) {
+    return static_cast<double>(size) * size / seconds / 1e6;
+}
+
+void runCase(const Case& c, int size, int repeats) {
+    for (int q = 0; q < static_cast<int>(EncodeQuality::Count); ++q) {
+        EncodeOptions options;
+        options.format = c.format;
+        options.quality = static_cast<EncodeQuality>(q);
+        options.generateMips = false;
+        CompressedImage image;
+
+        Parallel::setMaxWorkers(1);
+        double single = bench::bestOf(repeats, [&]() {
+            TextureEncoder::encode(c.pixels.data(), size, size, c.channels, options, image);
+            bench::doNotOptimize(image.data.data());
+        });
+        Parallel::setMaxWorkers(0);
+        double parallel = bench::bestOf(repeats, [&]() {
+            TextureEncoder::encode(c.pixels.data(), size, size, c.channels, options, image);
+            bench::doNotOptimize(image.data.data());
+        });
+
+        std::printf("%-12s %-4s %-7s %9.2f MP/s %9.2f MP/s %6.1fx  %6.2f dB\n",
+                    c.name.c_str(), TextureContainer::getFormatName(c.format), TextureEncoder::getQualityName(options.quality),
+                    megapixelsPerSecond(size, single), megapixelsPerSecond(size, parallel),
+                    single / parallel, TextureEncoder::measurePSNR(c.pixels.data(), size, size, c.channels, image));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int size = static_cast<int>(bench::argSize(argc, argv, "--size", 1024));
+    int repeats = static_cast<int>(bench::argSize(argc, argv, "--repeats", 3));
+    unsigned int threads = Parallel::getMaxWorkers();
+
+    std::vector<Case> cases;
+    cases.push_back(makeColor(size, false));
+    cases.push_back(makeColor(size, true));
+    cases.push_back(makeNormalMap(size));
+    cases.push_back(makeMask(size));
+
+    std::printf("Texture encoder benchmark: %dx%d, level 0 only, %u threads\n", size, size, threads);
+    bench::printHeader("Throughput and quality");
+    std::printf("%-12s %-4s %-7s %14s %14s %7s  %9s\n", "image", "fmt", "quality", "1 thread", "all threads", "scale", "PSNR");
+    for (const Case& c : cases) runCase(c, size, repeats);
+    return 0;
+}
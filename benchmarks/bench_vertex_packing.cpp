@@ -0,0 +1,122 @@
+// 顶点上传带宽基准：完整 56 字节 Vertex 与按布局紧排 / 量化编码后的写入量和吞吐
+// 目标缓冲区模拟映射后的 GPU 内存（只写），不需要 OpenGL 上下文
+// 用法：bench_vertex_packing [--vertices N] [--repeats R]
+
+#include "BenchUtils.h"
+#include "mesh/MeshKernels.h"
+#include "mesh/VertexFormat.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<Vertex> makeVertices(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    // 法线取单位长度，量化误差才有意义
+    std::vector<Vertex> vertices(count);
+    for (auto& v : vertices) {
+        v.position = glm::vec3(dist(rng), dist(rng), dist(rng)) * 100.0f;
+        v.normal = glm::normalize(glm::vec3(dist(rng), dist(rng), dist(rng)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+        v.texCoords = glm::vec2(dist(rng), dist(rng));
+        v.tangent = glm::vec3(dist(rng), dist(rng), dist(rng));
+        v.bitangent = glm::vec3(dist(rng), dist(rng), dist(rng));
+    }
+    return vertices;
+}
+
+void report(const char* name, const char* path, size_t stride, double seconds, size_t count, double baseline) {
+    double megabytes = static_cast<double>(stride * count) / (1024.0 * 1024.0);
+    double mverts = static_cast<double>(count) / seconds / 1e6;
+    std::printf("%-18s %-9s %3zu B/vert %8.1f MB %8.3f ms %8.1f Mvert/s %7.2f GB/s  x%.2f\n",
+                name, path, stride, megabytes, seconds * 1e3, mverts,
+                static_cast<double>(stride * count) / seconds / 1e9, baseline / seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = bench::argSize(argc, argv, "--vertices", 2u << 20);
+    int repeats = static_cast<int>(bench::argSize(argc, argv, "--repeats", 10));
+
+    std::vector<Vertex> vertices = makeVertices(count);
+    std::vector<unsigned char> target(count * sizeof(Vertex));
+
+    std::printf("Vertex packing benchmark: %zu vertices, source stride %zu bytes\n", count, sizeof(Vertex));
+
+    // 改造前的上传方式：整个 Vertex 数组原样写入
+    bench::printHeader("Full Vertex (old path)");
+    double fullTime = bench::bestOf(repeats, [&]() {
+        std::memcpy(target.data(), vertices.data(), count * sizeof(Vertex));
+        bench::doNotOptimize(target.data());
+    });
+    report("Vertex", "memcpy", sizeof(Vertex), fullTime, count, fullTime);
+
+    struct Case {
+        const char* name;
+        VertexAttributeLayout layout;
+        bool specialized;    // 四种预设布局走 Format<Mask> 模板，其余走通用路径
+    };
+    VertexAttributeLayout positionTex;
+    positionTex.addAttribute(VertexAttribute::Position, 3);
+    positionTex.addAttribute(VertexAttribute::TexCoords, 2);
+    const Case cases[] = {
+        { "PositionOnly", VertexAttributeLayout::PositionOnly(), true },
+        { "PositionNormal", VertexAttributeLayout::PositionNormal(), true },
+        { "PositionNormalTex", VertexAttributeLayout::PositionNormalTex(), true },
+        { "Position+Tex", positionTex, false },
+    };
+
+    bench::printHeader("Packed layouts (x = speedup over full Vertex upload)");
+    for (const Case& c : cases) {
+        double t = bench::bestOf(repeats, [&]() {
+            VertexFormat::pack(c.layout, vertices.data(), count, target.data());
+            bench::doNotOptimize(target.data());
+        });
+        report(c.name, c.specialized ? "template" : "generic", c.layout.stride, t, count, fullTime);
+
+        if (c.specialized) {
+            t = bench::bestOf(repeats, [&]() {
+                VertexFormat::packGeneric(c.layout, vertices.data(), count, target.data());
+                bench::doNotOptimize(target.data());
+            });
+            report(c.name, "generic", c.layout.stride, t, count, fullTime);
+        }
+    }
+
+    // 量化布局：编码内核按各 SIMD 级别分别计时，并报告相对 float 数据的误差
+    const Case quantized[] = {
+        { "Compact", VertexAttributeLayout::Compact(), true },
+        { "Quantized", VertexAttributeLayout::Quantized(), true },
+    };
+    const MeshKernels::SimdLevel detected = MeshKernels::getDetectedLevel();
+    const VertexFormat::PositionRange range = VertexFormat::computePositionRange(vertices.data(), count);
+
+    bench::printHeader("Quantized layouts (x = speedup over full Vertex upload)");
+    for (const Case& c : quantized) {
+        for (int level = 0; level <= static_cast<int>(detected); ++level) {
+            MeshKernels::setActiveLevel(static_cast<MeshKernels::SimdLevel>(level));
+            double t = bench::bestOf(repeats, [&]() {
+                VertexFormat::pack(c.layout, vertices.data(), count, target.data(), range);
+                bench::doNotOptimize(target.data());
+            });
+            report(c.name, MeshKernels::getLevelName(MeshKernels::getActiveLevel()), c.layout.stride, t, count,
+                   fullTime);
+        }
+        MeshKernels::setActiveLevel(detected);
+    }
+
+    bench::printHeader("Quantization error (position range from bounding box)");
+    for (const Case& c : quantized) {
+        VertexFormat::ErrorReport err = VertexFormat::measureError(c.layout, vertices.data(), count, range);
+        std::printf("%-18s %3zu B/vert  position %.5f  normal %.3f deg  uv %.5f\n",
+                    c.name, err.bytesPerVertex, err.maxPositionError, err.maxNormalErrorDegrees,
+                    err.maxTexCoordError);
+    }
+
+    const size_t defaultStride = VertexAttributeLayout::PositionNormalTex().stride;
+    std::printf("\nDefault layout uploads %zu of %zu bytes per vertex (%.0f%% less bus traffic)\n",
+                static_cast<size_t>(defaultStride), sizeof(Vertex),
+                100.0 * (1.0 - static_cast<double>(defaultStride) / sizeof(Vertex)));
+    return 0;
+}
@@ -0,0 +1,30 @@
+# Benchmarks.cmake
+# 性能基准测试配置
+
+option(OPENGL_DEMO_BUILD_BENCHMARKS "Build performance benchmarks" ON)
+if(NOT OPENGL_DEMO_BUILD_BENCHMARKS)
+    return()
+endif()
+
+if(NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
+    message(STATUS "Benchmarks: no CMAKE_BUILD_TYPE set, use -DCMAKE_BUILD_TYPE=Release for meaningful numbers")
+endif()
+
+# 所有基准程序共享一份库目标，避免每个可执行文件重复编译 LIB_SOURCES
+add_library(opengl_bench_core STATIC ${LIB_SOURCES})
+target_include_directories(opengl_bench_core PUBLIC
+    ${COMMON_INCLUDE_DIRS}
+    ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks
+)
+target_link_libraries(opengl_bench_core PUBLIC ${PLATFORM_LIBRARIES})
+
+# 每个 benchmarks/*.cpp 生成一个独立的可执行文件，通过 bench_all 目标统一构建
+file(GLOB BENCHMARK_SOURCES "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp")
+add_custom_target(bench_all)
+
+foreach(BENCH_SOURCE ${BENCHMARK_SOURCES})
+    get_filename_component(BENCH_NAME ${BENCH_SOURCE} NAME_WE)
+    add_executable(${BENCH_NAME} ${BENCH_SOURCE})
+    target_link_libraries(${BENCH_NAME} opengl_bench_core)
+    add_dependencies(bench_all ${BENCH_NAME})
+endforeach()
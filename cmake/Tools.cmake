@@ -0,0 +1,12 @@
+# Tools.cmake
+# 离线资源工具配置
+
+option(OPENGL_DEMO_BUILD_TOOLS "Build offline asset tools" ON)
+if(NOT OPENGL_DEMO_BUILD_TOOLS)
+    return()
+endif()
+
+# asset_cook：把图片编码为带完整 mip 链的块压缩纹理（DDS / KTX）
+add_executable(asset_cook ${CMAKE_CURRENT_SOURCE_DIR}/tools/asset_cook.cpp ${LIB_SOURCES})
+target_include_directories(asset_cook PRIVATE ${COMMON_INCLUDE_DIRS})
+target_link_libraries(asset_cook ${PLATFORM_LIBRARIES})
@@ -3,13 +3,18 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <chrono>
 #include <memory>
 #include <string>
 #include "core/Camera.h"
+#include "core/StreamingBuffer.h"
 #include "shader/Shader.h"
+#include "mesh/AsyncTextureLoader.h"
 #include "mesh/Mesh.h"
+#include "mesh/MeshBVH.h"
 #include "mesh/Material.h"
 #include "mesh/Texture.h"
+#include "mesh/TextureStreamer.h"
 #include "lighting/LightManager.h"
 #include "lighting/ShadowMapper.h"
 #include "particles/Particle.h"
@@ -27,6 +32,9 @@ struct AppConfig {
     std::string shaderFragment = "resources/shaders/mesh.fs";
     std::string modelPath = "resources/models/cube.obj";
     glm::vec3 backgroundColor = glm::vec3(0.3f, 0.35f, 0.4f);  // 浅灰蓝色背景
+    bool asyncTextureLoading = true;  // false 时在 initialize() 中同步加载全部纹理（用于对比首帧时间）
+    bool compressTextures = false;    // 首次加载时把图片编码为 BCn 并缓存（见 CTexture::setCompressionSettings）
+    size_t textureBudgetMB = 0;       // 非 0 时由 TextureStreamer 按屏幕占用流式加载 mip 级别，显存预算（MB）
 };
 
 /**
@@ -102,7 +110,30 @@ private:
     std::shared_ptr<CMesh> texturedCube;
     std::vector<std::shared_ptr<CMesh>> modelMeshes;
     
-    // 纹理
+    // 场景对象（每帧更新模型矩阵）
+    struct SceneObject {
+        std::shared_ptr<CMesh> mesh;
+        glm::mat4 model = glm::mat4(1.0f);
+        glm::vec3 color = glm::vec3(1.0f);   // 无纹理或简单着色器下的漫反射颜色
+        bool textured = true;
+        std::shared_ptr<MeshBVH> bvh;        // 拾取用，多个对象可共享同一网格的 BVH
+        glm::vec3 worldMin = glm::vec3(0.0f);  // 世界空间包围盒，updateScene() 中更新
+        glm::vec3 worldMax = glm::vec3(0.0f);
+    };
+    std::vector<SceneObject> sceneObjects_;
+    int pickedObject_ = -1;                  // 准星指向的对象下标，-1 表示没有
+    glm::vec3 sceneBoundsMin_ = glm::vec3(0.0f);  // 世界空间场景包围盒
+    glm::vec3 sceneBoundsMax_ = glm::vec3(0.0f);
+    
+    // 每帧流式数据（粒子实例、动态网格、uniform block）共享的环形缓冲区
+    std::shared_ptr<StreamingBuffer> streamingBuffer_;
+    
+    // 静态场景网格共用的几何大缓冲区，同一布局的网格共用一个 VAO
+    std::shared_ptr<GeometryArena> geometryArena_;
+    
+    // 纹理：后台解码，每帧在预算内经暂存缓冲区上传，就绪前绑定占位纹理
+    std::unique_ptr<AsyncTextureLoader> textureLoader_;
+    std::unique_ptr<TextureStreamer> textureStreamer_;  // 设置了显存预算时代替 textureLoader_ 加载纹理
     std::shared_ptr<CTexture> diffuseTexture;
     std::shared_ptr<CTexture> specularTexture;
     
@@ -112,6 +143,7 @@ private:
     std::shared_ptr<CShader> shadowShader;    // Shadow depth pass shader
     std::unique_ptr<ShadowMapper> shadowMapper;
     bool shadowsEnabled_ = true;
+    bool shadowMultiDraw_ = false;            // gl_DrawIDARB available: batch shadow draws of one mesh
     
     // Particle system
     std::unique_ptr<ParticleEmitter> particleEmitter_;
@@ -123,11 +155,18 @@ private:
     std::unique_ptr<Skybox> skybox_;
     int skyboxPreset_ = 0;
     bool skyboxEnabled_ = true;
+    std::string ambientSkyName_;    // skybox whose irradiance lightManager holds
     
     // 时间管理
     float deltaTime;
     float lastFrame;
     
+    // 启动耗时统计：initialize() 开始到首帧显示、到全部纹理就绪
+    std::chrono::steady_clock::time_point startTime_;
+    bool firstFrameReported_ = false;
+    bool texturesReadyReported_ = false;
+    size_t streamingRequestsReported_ = 0;
+    
     /**
      * @brief 初始化 GLFW 窗口
      * @return true 成功
@@ -145,6 +184,26 @@ private:
      */
     void initScene();
     
+    /**
+     * @brief Update per-frame object transforms and world-space scene bounds
+     */
+    void updateScene();
+    
+    /**
+     * @brief 按各对象的世界空间包围盒统计纹理使用，在预算内流式加载 mip 级别
+     */
+    void updateTextureStreaming();
+    
+    /**
+     * @brief 从屏幕中心（准星）沿视线做射线检测，更新 pickedObject_
+     */
+    void pickAtCrosshair();
+    
+    /**
+     * @brief 首帧显示后、全部纹理就绪后各输出一次距 initialize() 开始的耗时
+     */
+    void reportStartupTiming();
+    
     /**
      * @brief Initialize lighting system
      */
@@ -0,0 +1,40 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <glad/glad.h>
+#include <cstddef>
+
+/**
+ * @brief GL 绑定状态缓存（仅限 GL 线程）
+ *
+ * 目前只跟踪 VAO：绑定前与缓存比较，相同则跳过 glBindVertexArray。
+ * 绘制结束后不再绑回 0，连续绘制同一缓冲池的网格只需一次绑定。
+ *
+ * 缓存要准确，所有 VAO 的绑定与删除都必须经过这里；
+ * 外部代码（第三方库、测试）直接调用了 glBindVertexArray 时应调用 invalidate()。
+ * 另外 VAO 常驻绑定时，绑定 GL_ELEMENT_ARRAY_BUFFER 会改写该 VAO，
+ * 单独操作索引缓冲前先 bindVertexArray(0)。
+ */
+class GLState {
+public:
+    // 绑定 VAO，已绑定时跳过
+    static void bindVertexArray(GLuint vao);
+
+    // 删除 VAO 并把句柄置 0；正被绑定时同时重置缓存（删除后名字可能被复用）
+    static void deleteVertexArray(GLuint& vao);
+
+    // 缓存认为当前绑定的 VAO
+    static GLuint getBoundVertexArray();
+
+    // 丢弃缓存，下一次 bindVertexArray() 一定会调用 GL
+    static void invalidate();
+
+    // 实际调用 glBindVertexArray 的次数（用于统计与单元测试）
+    static size_t getBindCount();
+    static void resetBindCount();
+
+private:
+    GLState() = delete;
+};
+
+#endif
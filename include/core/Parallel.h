@@ -0,0 +1,53 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief 简单的数据并行辅助
+ *
+ * 把 [0, count) 切成连续区间分给多个线程执行，当前线程负责第 0 段。
+ * 每段回调都会拿到自己的 worker 编号，便于做每线程累加再归约。
+ */
+class Parallel {
+public:
+    /**
+     * @brief 区间回调
+     * @param begin 区间起点（含）
+     * @param end 区间终点（不含）
+     * @param worker 执行该区间的 worker 编号，取值 [0, workerCount)
+     */
+    typedef std::function<void(size_t begin, size_t end, unsigned int worker)> RangeFunction;
+
+    /**
+     * @brief 获取最大 worker 数（默认为硬件线程数，至少为 1）
+     */
+    static unsigned int getMaxWorkers();
+
+    /**
+     * @brief 限制最大 worker 数，0 表示恢复为硬件线程数（用于基准测试和单元测试）
+     */
+    static void setMaxWorkers(unsigned int count);
+
+    /**
+     * @brief 计算处理 count 个元素时实际使用的 worker 数
+     * @param count 元素个数
+     * @param minGrain 每个 worker 至少分到的元素个数
+     * @return worker 数，调用方可据此预分配每线程缓冲区
+     */
+    static unsigned int getWorkerCount(size_t count, size_t minGrain);
+
+    /**
+     * @brief 并行执行区间回调，返回前等待所有区间完成
+     * @param count 元素个数
+     * @param minGrain 每个 worker 至少分到的元素个数，数据量小时退化为单线程
+     * @param fn 区间回调
+     */
+    static void forRange(size_t count, size_t minGrain, const RangeFunction& fn);
+
+private:
+    Parallel() = delete;
+};
+
+#endif
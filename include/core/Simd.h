@@ -0,0 +1,18 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/**
+ * @brief 编译期 SSE2 检测
+ *
+ * SSE2 是 x86-64 的基线指令集，32 位 x86 只有在编译器开启 SSE2 时才使用。
+ * SIMD_SSE2 为 1 时已包含 <emmintrin.h>，为 0 时使用标量路径。
+ * 需要更高指令集（AVX2 等）的代码在运行时检测 CPU，见 MeshKernels / ImageKernels。
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define SIMD_SSE2 0
+#endif
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef STREAMING_BUFFER_H
+#define STREAMING_BUFFER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/**
+ * @brief 环形缓冲区的纯 CPU 记账（不调用 GL，便于单元测试）
+ *
+ * 位置使用单调递增的 64 位字节计数，offset = position % capacity。
+ * [tail, head) 是 GPU 可能仍在读取的区间，新分配不能与之重叠。
+ */
+class RingAllocator {
+public:
+    explicit RingAllocator(size_t capacity = 0);
+
+    /**
+     * @brief 尝试分配 size 字节
+     * @param alignment 对齐字节数（offset 需是其整数倍）
+     * @param outOffset 在缓冲区中的字节偏移
+     * @param outPosition 分配起点的单调位置，用于 isLive()
+     * @return 空间不足时返回 false，状态不变
+     */
+    bool tryAllocate(size_t size, size_t alignment, size_t& outOffset, uint64_t& outPosition);
+
+    /**
+     * @brief GPU 已读完 position 之前的全部数据
+     */
+    void retire(uint64_t position);
+
+    /**
+     * @brief 整块存储被重新分配（orphan），之前的所有分配都作废
+     */
+    void reset();
+
+    /**
+     * @brief 从 position 开始的分配是否仍未被覆盖或作废
+     */
+    bool isLive(uint64_t position) const;
+
+    /**
+     * @brief 开始新的一帧：之后的分配由下一个 fence 保护
+     */
+    void beginFrame();
+
+    /**
+     * @brief 从 position 开始的分配是否在当前帧写入且仍有效
+     *
+     * 只有当前帧的分配受即将插入的 fence 保护；更早帧的区间在其 fence 触发后即可被回收，
+     * 此后再提交读取它的绘制，GPU 执行时数据可能已被覆盖。
+     */
+    bool isCurrentFrame(uint64_t position) const;
+
+    uint64_t getHead() const { return head_; }
+    uint64_t getFrameStart() const { return frameStart_; }
+    uint64_t getTail() const { return tail_; }
+    size_t getCapacity() const { return capacity_; }
+    size_t getUsedBytes() const { return static_cast<size_t>(head_ - tail_); }
+
+private:
+    size_t capacity_;
+    uint64_t head_;
+    uint64_t tail_;
+    uint64_t resetPosition_;
+    uint64_t frameStart_;
+};
+
+/**
+ * @brief 按帧流式写入的 GPU 缓冲区
+ *
+ * 所有数据写入同一个 GL 缓冲区的环形空间：每次分配用
+ * glMapBufferRange(UNSYNCHRONIZED | INVALIDATE_RANGE) 映射目标区间，驱动不做同步；
+ * 每帧结束时插入一个 glFenceSync，环绕回来之前等待对应的 fence，保证不覆盖 GPU 正在读的数据。
+ * 单帧写入量超过容量时退化为整块 orphan（glBufferData(nullptr)）。
+ *
+ * 顶点、索引、实例数据和 uniform block 都可以从同一个环里分配：
+ * GL 缓冲区本身不区分用途，只是绑定目标不同。
+ *
+ * 分配得到的区间只在写入它的那一帧内可以提交绘制：fence 只覆盖写入帧，
+ * 触发后区间即被回收，之后的帧需要重新分配上传（见 isCurrentFrame()）。
+ */
+class StreamingBuffer {
+public:
+    struct Allocation {
+        void* data = nullptr;      // 映射指针，unmap() 之前可写
+        GLintptr offset = 0;       // 在缓冲区中的字节偏移
+        GLsizeiptr size = 0;
+        uint64_t position = 0;     // 环中的单调位置，配合 isLive() 使用
+
+        bool isValid() const { return size > 0; }
+    };
+
+    struct Stats {
+        size_t bytesThisFrame = 0;
+        size_t allocationsThisFrame = 0;
+        size_t fenceWaits = 0;     // 因环绕需要阻塞等待 GPU 的次数（累计）
+        size_t orphans = 0;        // 单帧超出容量而整块重新分配的次数（累计）
+        size_t framesInFlight = 0;
+    };
+
+    explicit StreamingBuffer(size_t capacity = 4 * 1024 * 1024);
+    ~StreamingBuffer();
+
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    /**
+     * @brief 创建 GL 缓冲区（需要有效的 GL 上下文）
+     */
+    bool initialize();
+
+    /**
+     * @brief 分配并映射一段可写区间，写完后必须调用 unmap()
+     * @return 失败（超过总容量或映射失败）时返回无效的 Allocation
+     */
+    Allocation map(size_t size, size_t alignment = 16);
+    void unmap();
+
+    /**
+     * @brief 分配并拷贝数据（map + memcpy + unmap）
+     */
+    Allocation upload(const void* data, size_t size, size_t alignment = 16);
+
+    /**
+     * @brief 按 GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 对齐上传 uniform block 数据
+     */
+    Allocation uploadUniform(const void* data, size_t size);
+
+    /**
+     * @brief 把分配区间绑定到 uniform block 绑定点
+     */
+    void bindUniformRange(GLuint bindingPoint, const Allocation& allocation) const;
+
+    /**
+     * @brief 分配的数据是否仍有效（未被环绕覆盖、未被 orphan）
+     */
+    bool isLive(const Allocation& allocation) const;
+
+    /**
+     * @brief 分配是否在当前帧写入且有效，只有这样的区间可以用于本帧的绘制
+     */
+    bool isCurrentFrame(const Allocation& allocation) const;
+
+    /**
+     * @brief 一帧的所有绘制提交之后调用：插入 fence 并回收已完成的帧
+     */
+    void endFrame();
+
+    GLuint getBuffer() const { return buffer_; }
+    size_t getCapacity() const { return ring_.getCapacity(); }
+    size_t getUniformAlignment() const { return uniformAlignment_; }
+    const Stats& getStats() const { return stats_; }
+    bool isInitialized() const { return buffer_ != 0; }
+
+private:
+    struct FrameFence {
+        GLsync fence;
+        uint64_t end;   // 该帧写到的单调位置
+    };
+
+    GLuint buffer_;
+    size_t uniformAlignment_;
+    bool mapped_;
+    RingAllocator ring_;
+    std::deque<FrameFence> fences_;
+    Stats stats_;
+
+    bool reserve(size_t size, size_t alignment, size_t& offset, uint64_t& position);
+    void retireSignaledFences();
+    void waitOldestFence();
+    void orphan();
+};
+
+#endif
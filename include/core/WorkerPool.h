@@ -0,0 +1,60 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 常驻的后台线程池
+ *
+ * 与 Parallel::forRange（调用方等待全部区间完成）不同，submit() 立即返回，
+ * 任务按提交顺序由空闲线程取出执行，用于文件读取、图片解码等不阻塞渲染线程的工作。
+ * 任务之间没有顺序保证，结果需要由任务自己加锁交回。
+ */
+class WorkerPool {
+public:
+    typedef std::function<void()> Task;
+
+    /**
+     * @param threadCount 线程数，0 表示 Parallel::getMaxWorkers()
+     */
+    explicit WorkerPool(unsigned int threadCount = 0);
+
+    /**
+     * @brief 丢弃尚未开始的任务，等待正在执行的任务结束后回收线程
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(Task task);
+
+    /**
+     * @brief 阻塞直到队列为空且没有正在执行的任务
+     */
+    void waitIdle();
+
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(threads_.size()); }
+
+    // 已提交但尚未开始执行的任务数
+    size_t getQueuedCount() const;
+
+private:
+    std::vector<std::thread> threads_;
+    std::deque<Task> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable taskReady_;
+    std::condition_variable idle_;
+    size_t running_;
+    bool stopping_;
+
+    void workerLoop();
+};
+
+#endif
@@ -7,6 +7,7 @@
 #define LIGHT_MANAGER_H
 
 #include "lighting/Light.h"
+#include "lighting/SphericalHarmonics.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -55,6 +56,12 @@ public:
     void setAmbientColor(const glm::vec3& color) { ambientColor_ = color; }
     glm::vec3 getAmbientColor() const { return ambientColor_; }
 
+    // Image-based ambient (e.g. from the skybox); replaces the flat ambient color while set
+    void setAmbientSH(const SHCoefficients& sh) { ambientSH_ = sh; hasAmbientSH_ = true; }
+    void clearAmbientSH() { hasAmbientSH_ = false; }
+    bool hasAmbientSH() const { return hasAmbientSH_; }
+    const SHCoefficients& getAmbientSH() const { return ambientSH_; }
+
     // Iterate all enabled lights
     void forEachEnabledLight(std::function<void(const Light*, int)> callback) const;
 
@@ -65,6 +72,8 @@ private:
     std::vector<std::shared_ptr<Light>> lights_;
     std::unordered_map<std::string, size_t> nameIndexMap_;
     glm::vec3 ambientColor_;
+    SHCoefficients ambientSH_;
+    bool hasAmbientSH_;
 };
 
 #endif // LIGHT_MANAGER_H
@@ -0,0 +1,63 @@
+/**
+ * @file SphericalHarmonics.h
+ * @brief L2 spherical harmonics projection of cubemaps for image-based ambient lighting
+ */
+
+#ifndef SPHERICAL_HARMONICS_H
+#define SPHERICAL_HARMONICS_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * @brief Nine RGB coefficients of an L2 spherical harmonics expansion
+ *
+ * Order: (0,0), (1,-1), (1,0), (1,1), (2,-2), (2,-1), (2,0), (2,1), (2,2).
+ */
+struct SHCoefficients {
+    static const int Count = 9;
+
+    glm::vec3 coefficients[Count];
+
+    SHCoefficients() {
+        for (int i = 0; i < Count; ++i) coefficients[i] = glm::vec3(0.0f);
+    }
+};
+
+/**
+ * @brief Spherical harmonics helpers (CPU only, safe to call from worker threads)
+ *
+ * Typical use: projectCubemap() once when an environment changes, then convolveIrradiance()
+ * and upload the nine coefficients; the shader evaluates them per pixel with evaluate()'s
+ * polynomial, about nine multiply-adds.
+ */
+namespace SphericalHarmonics {
+
+// Real SH basis for a unit direction
+void evaluateBasis(const glm::vec3& dir, float out[SHCoefficients::Count]);
+
+/**
+ * @brief Project a cubemap of linear RGB radiance onto the L2 basis
+ *
+ * Every texel is weighted by its solid angle, and the weights are normalized to 4pi so small
+ * faces integrate exactly. Rows of all faces are spread over Parallel::forRange and each row
+ * is accumulated four texels at a time with SSE2 when ImageKernels allows it; the result does
+ * not depend on the thread count.
+ * @param faces faceSize^2 RGB floats per face, GL face order, rows top to bottom
+ */
+SHCoefficients projectCubemap(const std::vector<float> faces[6], int faceSize);
+
+/**
+ * @brief Convolve radiance coefficients with the clamped cosine lobe
+ *
+ * Scales band l by A_l / pi (1, 2/3, 1/4), so evaluate() returns irradiance / pi: the
+ * outgoing radiance of a white Lambertian surface, ready to multiply by albedo.
+ */
+void convolveIrradiance(SHCoefficients& sh);
+
+// Reconstruct the expansion in direction n (normalized)
+glm::vec3 evaluate(const SHCoefficients& sh, const glm::vec3& n);
+
+} // namespace SphericalHarmonics
+
+#endif // SPHERICAL_HARMONICS_H
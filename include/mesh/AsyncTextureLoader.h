@@ -0,0 +1,245 @@
+#ifndef ASYNC_TEXTURE_LOADER_H
+#define ASYNC_TEXTURE_LOADER_H
+
+#include <glad/glad.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/WorkerPool.h"
+#include "mesh/Texture.h"
+#include "mesh/TextureContainer.h"
+
+class StreamingBuffer;
+
+/**
+ * @brief 解码完成的图片
+ *
+ * 普通图片解码后在后台线程按上传格式准备完整 mip 链（CTexture::prepareLevels：RGB 扩展为 RGBA），
+ * 保存在 levels 中，每级按行紧密排列；channels 为源图片的通道数。
+ * .dds / .ktx 只解析容器，块压缩数据与全部 mip 级别保存在 compressed 中，levels 为空。
+ */
+struct DecodedImage {
+    uint64_t id = 0;
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::vector<ImageLevel> levels;
+    CompressedImage compressed;
+    double decodeSeconds = 0.0;
+
+    bool isValid() const { return !levels.empty() || isCompressed(); }
+    bool isCompressed() const { return !compressed.empty(); }
+    int getUploadChannels() const { return CTexture::getUploadChannels(channels); }
+
+    // 按行上传的划分：未压缩纹理每行一个像素行；块压缩纹理每行为一个块行（4 像素高）
+    size_t getLevelCount() const { return isCompressed() ? compressed.levels.size() : levels.size(); }
+    int getLevelWidth(size_t level) const { return isCompressed() ? compressed.levels[level].width : levels[level].width; }
+    int getLevelHeight(size_t level) const { return isCompressed() ? compressed.levels[level].height : levels[level].height; }
+    int getRowCount(size_t level) const { return isCompressed() ? (getLevelHeight(level) + 3) / 4 : getLevelHeight(level); }
+    size_t getRowBytes(size_t level = 0) const;
+    const unsigned char* getRowData(size_t level, int row) const;
+
+    /**
+     * @brief 预算内下一块上传的行数（AsyncTextureLoader 与 TextureStreamer 共用）
+     * @param remaining 本帧剩余的上传预算（字节）
+     * @param uploadedThisFrame 本帧已有上传时，剩余预算不足一行返回 0，留到下一帧；否则至少返回 1
+     * @param maxChunkBytes 单块字节上限，0 表示不限
+     */
+    int getChunkRows(size_t level, int firstRow, size_t remaining, bool uploadedThisFrame,
+                     size_t maxChunkBytes = 0) const;
+
+    // 为绑定在 GL_TEXTURE_2D 上的纹理分配 level 级存储，empty 时释放（宽高为 0）；调用时不能绑定 PBO
+    void allocateLevel(size_t level, bool empty = false) const;
+
+    /**
+     * @brief 把 level 级的 [firstRow, firstRow + rows) 行上传到绑定在 GL_TEXTURE_2D 上的纹理
+     * @param pixels 行数据的内存地址，或绑定了 GL_PIXEL_UNPACK_BUFFER 时的缓冲区偏移
+     */
+    void uploadRows(size_t level, int firstRow, int rows, const void* pixels) const;
+
+    // 给绑定在 GL_TEXTURE_2D 上的纹理设置与 CTexture 同步加载时一致的采样参数；各级别已上传，不生成 mipmap
+    void applySamplerDefaults() const;
+
+    /**
+     * @brief 驱动不支持该块压缩格式时解码为 RGBA8 级别（GL 线程调用，见 CTexture::isBlockFormatSupported）
+     * @return 无法解码（BC7）时返回 false，图片被清空
+     */
+    bool decompressIfUnsupported();
+    size_t getLevelBytes(size_t level) const { return getRowBytes(level) * static_cast<size_t>(getRowCount(level)); }
+
+    // 全部级别的字节数
+    size_t getByteSize() const {
+        if (isCompressed()) return compressed.getByteSize();
+        size_t size = 0;
+        for (const ImageLevel& level : levels) size += level.pixels.size();
+        return size;
+    }
+};
+
+/**
+ * @brief 图片解码队列（纯 CPU，不调用 GL，便于单元测试）
+ *
+ * submit() 把文件读取、stbi_load 与 mip 生成（或 KTX / DDS 容器解析、块压缩编码）交给后台线程池，poll() 在调用线程取回已完成的结果。
+ * 解码失败的结果也会交回（isValid() 为 false），调用方据此结束等待。
+ */
+class ImageDecodeQueue {
+public:
+    /**
+     * @param workers 解码线程数，0 表示 Parallel::getMaxWorkers()
+     */
+    explicit ImageDecodeQueue(unsigned int workers = 0);
+
+    /**
+     * @brief 提交解码请求
+     * @param mips 普通图片生成 mip 链的参数
+     * @return 请求编号（从 1 开始递增），与 DecodedImage::id 对应
+     */
+    uint64_t submit(const std::string& path, const MipOptions& mips = MipOptions());
+
+    /**
+     * @brief 提交解码请求，在后台线程编码为块压缩格式（TextureEncoder::loadOrEncode，带缓存）
+     *
+     * 编码失败时退回按原格式解码，按 mips 生成 mip 链。
+     */
+    uint64_t submitEncoded(const std::string& path, const EncodeOptions& options, const std::string& cacheDirectory,
+                           const MipOptions& mips = MipOptions());
+
+    /**
+     * @brief 取回已完成的结果，追加到 out 末尾，不阻塞
+     * @return 本次取回的数量
+     */
+    size_t poll(std::vector<DecodedImage>& out);
+
+    /**
+     * @brief 阻塞直到所有已提交的请求解码完成（结果仍需 poll() 取回）
+     */
+    void waitIdle();
+
+    // 已提交但尚未被 poll() 取回的请求数
+    size_t getPendingCount() const;
+
+    unsigned int getWorkerCount() const { return pool_.getThreadCount(); }
+
+private:
+    typedef std::function<void(DecodedImage&)> DecodeFunction;
+
+    uint64_t enqueue(const std::string& path, DecodeFunction decode);
+
+    mutable std::mutex mutex_;
+    std::vector<DecodedImage> completed_;
+    uint64_t nextId_;
+    size_t pending_;
+    // 最后声明，析构时先回收线程，保证任务不再访问上面的成员
+    WorkerPool pool_;
+};
+
+/**
+ * @brief 异步纹理加载器
+ *
+ * load() 立即返回一个绑定 1x1 占位纹理的 CTexture，图片在后台线程解码；
+ * 渲染线程每帧调用 update()，在上传预算内把解码好的像素按行分块写入暂存缓冲区（PBO），
+ * 再用 glTexSubImage2D 从缓冲区偏移上传到新的纹理对象。mip 链已在后台线程生成，逐级上传，不调用 glGenerateMipmap；
+ * 全部级别上传完成后用 CTexture::adopt() 替换占位纹理，已持有该 CTexture 的材质无需任何改动。
+ * 块压缩纹理（.dds / .ktx）逐级按块行（4 像素高）用 glCompressedTexSubImage2D 上传预先生成的全部级别。
+ *
+ * 暂存缓冲区使用共享的 StreamingBuffer（GL 缓冲区不区分用途，绑定到 GL_PIXEL_UNPACK_BUFFER 即可），
+ * 由它的 fence 保证不覆盖 GPU 尚未读取的数据；未提供或映射失败时直接从内存上传。
+ * 除解码外所有函数都必须在 GL 线程调用。
+ */
+class AsyncTextureLoader {
+public:
+    struct Stats {
+        size_t requested = 0;
+        size_t resident = 0;            // 已替换为真实纹理的数量
+        size_t compressed = 0;          // 其中块压缩纹理的数量
+        size_t failed = 0;              // 解码失败，保留占位纹理
+        size_t bytesUploaded = 0;       // 累计
+        size_t bytesThisFrame = 0;      // 最近一次 update() 上传的字节数
+        size_t stagedChunks = 0;        // 经暂存缓冲区上传的分块数（累计）
+        size_t directChunks = 0;        // 直接从内存上传的分块数（累计）
+        double decodeSeconds = 0.0;     // 各线程解码耗时之和
+        double lastResidentSeconds = 0.0;  // 从第一次 load() 到最近一张纹理就绪的时间
+    };
+
+    /**
+     * @param stagingBuffer 上传用的暂存环形缓冲区，可为 nullptr
+     * @param workers 解码线程数，0 表示 Parallel::getMaxWorkers()
+     */
+    explicit AsyncTextureLoader(std::shared_ptr<StreamingBuffer> stagingBuffer = nullptr,
+                                unsigned int workers = 0);
+    ~AsyncTextureLoader();
+
+    AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+    AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+    /**
+     * @brief 请求加载纹理，返回的 CTexture 在就绪前绑定占位纹理
+     *
+     * 占位颜色：法线贴图为平坦法线 (0.5, 0.5, 1)，其它为中灰。
+     * CTexture 的压缩设置开启时，图片在后台线程编码为块压缩格式（见 CTexture::CompressionSettings）。
+     * 调用方释放返回的 CTexture 后，尚未完成的上传会被丢弃。
+     */
+    std::shared_ptr<CTexture> load(const std::string& path, TextureType type = TextureType::Diffuse);
+
+    // 创建 1x1 占位纹理（颜色同上），path 记录为将要加载的文件
+    static std::shared_ptr<CTexture> createPlaceholder(const std::string& path, TextureType type);
+
+    /**
+     * @brief 每帧调用一次：取回解码结果，在预算内上传
+     * @return 本次就绪（替换了占位纹理）的纹理数
+     */
+    size_t update();
+
+    /**
+     * @brief 等待所有解码完成并不限预算地上传（加载界面、测试、同步加载模式）
+     */
+    void finishAll();
+
+    /**
+     * @brief 每帧上传的字节数上限，至少上传一行以保证进度；默认 1 MB
+     */
+    void setUploadBudget(size_t bytesPerFrame) { uploadBudget_ = bytesPerFrame; }
+    size_t getUploadBudget() const { return uploadBudget_; }
+
+    // 没有等待解码或上传中的纹理
+    bool isIdle() const { return waiting_.empty() && uploads_.empty(); }
+
+    const Stats& getStats() const { return stats_; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Upload {
+        DecodedImage image;
+        std::weak_ptr<CTexture> texture;
+        GLuint id = 0;          // 上传目标纹理对象，首个分块上传前创建
+        size_t level = 0;       // 正在上传的 mip 级别
+        int nextRow = 0;        // 该级别下一行（块压缩纹理为块行）
+    };
+
+    ImageDecodeQueue decoder_;
+    std::shared_ptr<StreamingBuffer> stagingBuffer_;
+    std::unordered_map<uint64_t, std::weak_ptr<CTexture>> waiting_;  // 解码中
+    std::deque<Upload> uploads_;                                      // 按解码完成顺序上传
+    std::vector<DecodedImage> decoded_;
+    size_t uploadBudget_;
+    Clock::time_point firstRequest_;
+    Stats stats_;
+
+    void collectDecoded();
+    size_t uploadWithinBudget(size_t budget);
+    // 上传当前级别的 rows 行，返回上传的字节数
+    size_t uploadRows(Upload& upload, int rows);
+    void allocateStorage(Upload& upload);
+    void finishUpload(Upload& upload);
+};
+
+#endif
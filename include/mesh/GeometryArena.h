@@ -0,0 +1,239 @@
+#ifndef GEOMETRY_ARENA_H
+#define GEOMETRY_ARENA_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "mesh/Vertex.h"
+
+/**
+ * @brief 区间分配器的纯 CPU 记账（不调用 GL，便于单元测试）
+ *
+ * 在 [0, capacity) 上按首次适配分配连续区间，单位由调用方决定
+ * （GeometryArena 中为顶点数 / 索引数）。空闲块按偏移排序，释放时与相邻空闲块合并。
+ */
+class FreeListAllocator {
+public:
+    static const size_t InvalidOffset;
+
+    // compact() 产生的搬移：区间 [from, from + size) 移到 to
+    struct Move {
+        size_t from;
+        size_t to;
+        size_t size;
+    };
+
+    explicit FreeListAllocator(size_t capacity = 0);
+
+    /**
+     * @brief 分配 size 个单位
+     * @return 起始偏移，空间不足或 size 为 0 时返回 InvalidOffset
+     */
+    size_t allocate(size_t size);
+
+    /**
+     * @brief 释放 allocate() 返回的区间，offset 未分配时忽略
+     */
+    void free(size_t offset);
+
+    /**
+     * @brief 容量扩大到 newCapacity，新增部分追加为空闲块
+     */
+    void grow(size_t newCapacity);
+
+    /**
+     * @brief 把所有已分配区间按原顺序紧排到开头
+     * @return 每个已分配区间的搬移，按 to 升序（from >= to）
+     */
+    std::vector<Move> compact();
+
+    size_t getCapacity() const { return capacity_; }
+    size_t getUsed() const { return used_; }
+    size_t getFree() const { return capacity_ - used_; }
+    size_t getAllocationCount() const { return allocations_.size(); }
+    size_t getFreeBlockCount() const { return freeBlocks_.size(); }
+    size_t getLargestFreeBlock() const;
+
+    /**
+     * @brief 碎片率：1 - 最大空闲块 / 空闲总量，0 表示空闲空间完全连续
+     */
+    float getFragmentation() const;
+
+private:
+    size_t capacity_;
+    size_t used_;
+    std::map<size_t, size_t> freeBlocks_;     // offset -> size
+    std::map<size_t, size_t> allocations_;    // offset -> size
+};
+
+/**
+ * @brief 几何数据大缓冲区
+ *
+ * 每种顶点布局一组 VAO + VBO + EBO，网格只持有其中的顶点 / 索引区间。
+ * 同一布局的网格共用一个 VAO，切换网格不需要重新设置属性指针；
+ * 绘制使用 glDrawElementsBaseVertex，索引保持从 0 开始，顶点区间移动后无需改写索引。
+ * drawMulti() 把一组网格按布局分组，每组一次 glMultiDrawElementsBaseVertex。
+ * VAO 经 GLState 绑定，绘制后不解绑，连续绘制同一布局的网格只绑定一次。
+ *
+ * 空间不足时缓冲区按倍数扩容（glCopyBufferSubData 保留原有数据，偏移不变）；
+ * 频繁增删造成碎片时调用 defragment() 紧排，句柄不变，区间偏移随之更新。
+ *
+ * 缓冲区中的顶点按布局紧排（VertexFormat::pack），每种布局的顶点单位为 layout.stride 字节。
+ */
+class GeometryArena {
+public:
+    typedef uint32_t Handle;
+    static const Handle InvalidHandle;
+
+    // 句柄对应的区间（单位：顶点 / 索引）
+    struct Range {
+        size_t baseVertex = 0;
+        size_t vertexCount = 0;
+        size_t firstIndex = 0;
+        size_t indexCount = 0;
+    };
+
+    struct Stats {
+        size_t layouts = 0;
+        size_t allocations = 0;
+        size_t vertexBytesUsed = 0;
+        size_t vertexBytesCapacity = 0;
+        size_t indexBytesUsed = 0;
+        size_t indexBytesCapacity = 0;
+        float fragmentation = 0.0f;    // 所有缓冲区中最高的碎片率
+    };
+
+    /**
+     * @param initialVertices 每种布局初始的顶点容量
+     * @param initialIndices 每种布局初始的索引容量
+     */
+    explicit GeometryArena(size_t initialVertices = 64 * 1024, size_t initialIndices = 256 * 1024);
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    /**
+     * @brief 分配顶点区间和索引区间（indexCount 可以为 0）
+     * @return 需要 OpenGL 上下文；vertexCount 或 layout.stride 为 0 时返回 InvalidHandle
+     */
+    Handle allocate(const VertexAttributeLayout& layout, size_t vertexCount, size_t indexCount);
+    void free(Handle handle);
+    bool isValid(Handle handle) const;
+    Range getRange(Handle handle) const;
+
+    /**
+     * @brief 写入区间内 [first, first + count) 的数据，越界返回 false
+     *
+     * 顶点数据须已按区间所在布局紧排，每个顶点 layout.stride 字节。
+     */
+    bool uploadVertices(Handle handle, size_t first, const void* data, size_t count);
+    bool uploadIndices(Handle handle, size_t first, const unsigned int* data, size_t count);
+
+    /**
+     * @brief 从其他缓冲区对象复制数据到区间开头（显存内复制）
+     * @param sourceOffset 源缓冲区中的字节偏移
+     */
+    bool copyVertices(Handle handle, GLuint sourceBuffer, GLintptr sourceOffset, size_t count);
+    bool copyIndices(Handle handle, GLuint sourceBuffer, GLintptr sourceOffset, size_t count);
+
+    /**
+     * @brief 复制一份区间数据到新句柄
+     */
+    Handle duplicate(Handle handle);
+
+    /**
+     * @brief 改变区间大小，保留两者较短部分的原有数据；句柄不变
+     */
+    bool resize(Handle handle, size_t vertexCount, size_t indexCount);
+
+    /**
+     * @brief 把区间移到另一种布局的缓冲区；句柄不变
+     *
+     * 索引数据随之搬移；顶点格式随布局改变，需要调用方重新 uploadVertices()。
+     */
+    bool setLayout(Handle handle, const VertexAttributeLayout& layout);
+
+    // 区间所在的缓冲区对象，配合 getRange() 读取或复制数据
+    GLuint getVertexBuffer(Handle handle) const;
+    GLuint getIndexBuffer(Handle handle) const;
+
+    /**
+     * @brief 绑定句柄所在布局的 VAO
+     */
+    void bind(Handle handle) const;
+
+    /**
+     * @brief 绘制单个区间；有索引时用 glDrawElementsBaseVertex
+     * @param instanceCount 0 表示非实例化绘制
+     */
+    void draw(Handle handle, GLenum mode, unsigned int instanceCount = 0) const;
+
+    /**
+     * @brief 只绘制区间内的一段（合批网格的子网格）
+     * @param first 相对区间起点的首个索引，无索引时为首个顶点
+     * @param count 索引数（无索引时为顶点数），超出区间的部分被截断
+     */
+    void drawRange(Handle handle, GLenum mode, size_t first, size_t count, unsigned int instanceCount = 0) const;
+
+    /**
+     * @brief 批量绘制：按布局分组，每组绑定一次 VAO 并发出一次 multi-draw
+     *
+     * 所有区间使用同一 shader 和 uniform，适合阴影、深度预渲染等不区分对象的 pass。
+     * unorm16 位置的还原范围是逐网格的 uniform，量化范围不同的网格不能放在同一批。
+     * 同一布局内有索引的区间按 handles 中的顺序绘制，shader 可用 gl_DrawIDARB 取逐次绘制的数据。
+     */
+    void drawMulti(const std::vector<Handle>& handles, GLenum mode) const;
+
+    /**
+     * @brief 紧排所有缓冲区，消除空闲块之间的碎片
+     * @return 复制的字节数
+     */
+    size_t defragment();
+
+    Stats getStats() const;
+
+private:
+    struct Pool {
+        VertexAttributeLayout layout;
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        GLuint ebo = 0;
+        FreeListAllocator vertices;
+        FreeListAllocator indices;
+    };
+
+    struct Entry {
+        size_t pool = 0;
+        Range range;
+        bool alive = false;
+    };
+
+    // 批量绘制的临时数组，复用以避免每帧分配
+    struct MultiDrawScratch {
+        std::vector<GLsizei> counts;
+        std::vector<const void*> offsets;
+        std::vector<GLint> baseVertices;
+        std::vector<GLint> firsts;
+    };
+
+    size_t initialVertices_;
+    size_t initialIndices_;
+    std::vector<Pool> pools_;
+    std::vector<Entry> entries_;
+    std::vector<Handle> freeHandles_;
+    mutable MultiDrawScratch scratch_;
+    mutable std::vector<std::vector<Handle>> groups_;
+
+    size_t findOrCreatePool(const VertexAttributeLayout& layout);
+    void setupPoolAttributes(const Pool& pool) const;
+    bool allocateRange(size_t poolIndex, size_t vertexCount, size_t indexCount, Range& range);
+    void freeRange(size_t poolIndex, const Range& range);
+    Handle addEntry(size_t poolIndex, const Range& range);
+    void growBuffer(Pool& pool, bool indexBuffer, size_t minimumFree);
+    void copyRange(GLuint source, GLuint target, size_t fromBytes, size_t toBytes, size_t bytes) const;
+};
+
+#endif
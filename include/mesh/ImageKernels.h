@@ -0,0 +1,90 @@
+#ifndef IMAGE_KERNELS_H
+#define IMAGE_KERNELS_H
+
+#include <cstddef>
+#include <vector>
+#include "mesh/MeshKernels.h"
+
+/**
+ * @brief mip 降采样滤波器
+ */
+enum class MipFilter {
+    Box = 0,    // 按源像素覆盖面积加权，2:1 时即 2x2 平均
+    Kaiser,     // Kaiser 窗 sinc（半宽 3 个输出像素，alpha = 4），更锐利，负瓣结果截断到 [0, 1]
+    Count
+};
+
+/**
+ * @brief mip 生成参数
+ */
+struct MipOptions {
+    MipFilter filter = MipFilter::Kaiser;
+    bool srgb = true;     // 颜色通道按 sRGB 解码到线性空间滤波再编码回去；法线、粗糙度等数据贴图应关闭
+    bool wrap = false;    // 边缘按平铺（GL_REPEAT）取样，否则重复边缘像素
+};
+
+/**
+ * @brief 一个 mip 级别的像素（按行紧密排列）
+ */
+struct ImageLevel {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+/**
+ * @brief 8 位图片的批量处理内核：mip 降采样与像素格式转换
+ *
+ * 与 MeshKernels 一样提供标量、SSE2 和 AVX2(+FMA) 三种实现，按 CPU 能力选择；
+ * 整幅图片按行（转换类内核按像素段）用 Parallel::forRange 分给多个线程。
+ * 降采样是可分离的：先按垂直抽头把若干源行累加为一行，再做水平滤波，
+ * 累加在 float 上进行，垂直方向一次处理 4 / 8 个分量，水平方向对 4 通道图片一次处理一个 / 两个像素。
+ * 标量与 SSE2 的运算顺序相同，结果逐字节一致；AVX2 使用 FMA，个别像素可能相差 1。
+ *
+ * alpha（4 通道的第 4 个分量、2 通道的第 2 个分量）始终按线性值滤波。
+ */
+class ImageKernels {
+public:
+    typedef MeshKernels::SimdLevel SimdLevel;
+
+    // 当前使用的级别，默认为 MeshKernels::getDetectedLevel()
+    static SimdLevel getActiveLevel();
+
+    // 强制使用某一级别（用于基准测试和单元测试），超过 CPU 能力时取检测到的级别
+    static void setActiveLevel(SimdLevel level);
+
+    // RGB 扩展为 RGBA（alpha 为 255），上传时行总是 4 字节对齐
+    static void expandRGBToRGBA(const unsigned char* rgb, unsigned char* rgba, size_t count);
+
+    // RGBA 预乘 alpha：c * a / 255 就近取整（在存储空间计算，不做 sRGB 解码），in 与 out 可以相同
+    static void premultiplyAlpha(const unsigned char* in, unsigned char* out, size_t count);
+
+    /**
+     * @brief RGBA 通道重排，in 与 out 可以相同
+     * @param pattern 4 个字符，依次给出输出 r / g / b / a 的来源：'r' 'g' 'b' 'a' 或常量 '0' '1'，如 "bgra"、"rrr1"
+     * @return pattern 无效时返回 false，不写 out
+     */
+    static bool swizzle(const unsigned char* in, unsigned char* out, size_t count, const char* pattern);
+
+    // 完整 mip 链的级别数（每级宽高减半、至少为 1，直到 1x1）
+    static int getMipLevelCount(int width, int height);
+
+    /**
+     * @brief 降采样一级到 max(1, width / 2) x max(1, height / 2)，奇数尺寸按覆盖比例取样
+     * @param channels 1~4
+     */
+    static void downsample(const unsigned char* src, int width, int height, int channels,
+                           unsigned char* dst, const MipOptions& options);
+
+    /**
+     * @brief 由 levels[0] 逐级降采样，补齐到 1x1 的完整 mip 链（已有的其它级别会被替换）
+     */
+    static void generateMipChain(std::vector<ImageLevel>& levels, int channels, const MipOptions& options);
+
+    static const char* getFilterName(MipFilter filter);
+
+private:
+    ImageKernels() = delete;
+};
+
+#endif
@@ -26,6 +26,14 @@ public:
     // 纹理
     std::vector<std::shared_ptr<CTexture>> textures;
     
+    // 纹理坐标变换 uv * uvScale + uvOffset，用于纹理图集中的子区域（见 TextureAtlas），默认不变换
+    glm::vec2 uvScale;
+    glm::vec2 uvOffset;
+    
+    // 纹理数组中的层（见 TextureArrayPool），-1 表示不使用；同一数组的材质之间切换只改层号
+    std::shared_ptr<CTexture> textureArray;
+    int textureLayer;
+    
     // 构造函数
     CMaterial();
     CMaterial(const std::string& name);
@@ -53,6 +61,10 @@ public:
     // 材质属性设置
     void setColors(const glm::vec3& diffuse, const glm::vec3& specular, const glm::vec3& ambient);
     void setProperties(float shininess, float specularStrength, float opacity = 1.0f);
+    void setUVTransform(const glm::vec2& scale, const glm::vec2& offset);
+    bool hasUVTransform() const { return uvScale != glm::vec2(1.0f) || uvOffset != glm::vec2(0.0f); }
+    void setTextureLayer(std::shared_ptr<CTexture> array, int layer);
+    bool hasTextureLayer() const { return textureArray != nullptr && textureLayer >= 0; }
     
     // 应用材质（使用内置Shader）
     void apply() const;
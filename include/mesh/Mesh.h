@@ -17,7 +17,10 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include "mesh/Vertex.h"
+#include "mesh/VertexFormat.h"
 #include "mesh/Material.h"
+#include "core/StreamingBuffer.h"
+#include "mesh/GeometryArena.h"
 
 class CShader;
 
@@ -30,6 +33,13 @@ enum class PrimitiveType {
     Points = GL_POINTS
 };
 
+// 缓冲区更新方式
+enum class BufferUsage {
+    Static,     // 很少更新：GL_STATIC_DRAW，尺寸不变时用 glBufferSubData
+    Dynamic,    // 经常更新：GL_DYNAMIC_DRAW，按 1.5 倍预留容量，避免反复重新分配
+    Stream      // 每帧更新：从共享的 StreamingBuffer 环中分配，不占用独立 VBO
+};
+
 class CMesh {
 public:
     // 构造函数
@@ -37,11 +47,20 @@ public:
     CMesh(const std::vector<Vertex>& vertices, PrimitiveType primitive = PrimitiveType::Triangles);
     CMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, 
            PrimitiveType primitive = PrimitiveType::Triangles);
+    // 右值版本直接接管传入数组的存储，不做拷贝
+    CMesh(std::vector<Vertex>&& vertices, PrimitiveType primitive = PrimitiveType::Triangles);
+    CMesh(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices,
+           PrimitiveType primitive = PrimitiveType::Triangles);
+    // 直接上传已按 layout 紧排的静态顶点数据（如 PrimitiveTables 的编译期表），不复制到 CPU 端数组，
+    // 构造后的状态与释放了 CPU 数据的网格相同；boundsMin / boundsMax 为顶点的包围盒，unorm16 位置按默认范围 [0, 1] 还原
+    CMesh(const VertexAttributeLayout& layout, const void* packedVertices, size_t vertexCount,
+          const unsigned int* indices, size_t indexCount, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+          PrimitiveType primitive = PrimitiveType::Triangles);
     
     // 析构函数
     ~CMesh();
     
-    // 拷贝/赋值
+    // 拷贝/赋值：共享几何数据（不重新上传），材质等属性各自独立
     CMesh(const CMesh& other);
     CMesh& operator=(const CMesh& other);
     
@@ -52,12 +71,30 @@ public:
     // 顶点数据管理
     void setVertices(const std::vector<Vertex>& vertices);
     void setIndices(const std::vector<unsigned int>& indices);
-    const std::vector<Vertex>& getVertices() const { return vertices; }
-    const std::vector<unsigned int>& getIndices() const { return indices; }
+    void setVertices(std::vector<Vertex>&& vertices);
+    void setIndices(std::vector<unsigned int>&& indices);
+    // CPU 数据释放后返回空数组，数量请使用 getVertexCount / getIndexCount
+    const std::vector<Vertex>& getVertices() const { return geometry->vertices; }
+    const std::vector<unsigned int>& getIndices() const { return geometry->indices; }
     
-    // 顶点属性布局
-    void setVertexLayout(const VertexAttributeLayout& layout);
-    const VertexAttributeLayout& getVertexLayout() const { return vertexLayout; }
+    // 顶点属性布局：GPU 端只上传布局中的属性，按 layout.stride 紧密交错
+    // 已上传的网格换布局会从 CPU 数据重新打包；CPU 数据已释放时返回 false
+    bool setVertexLayout(const VertexAttributeLayout& layout);
+    const VertexAttributeLayout& getVertexLayout() const { return geometry->vertexLayout; }
+    size_t getVertexStride() const { return geometry->vertexLayout.stride; }
+    
+    // unorm16 位置（VertexAttributeLayout::Quantized）在整体上传时按包围盒量化
+    // 着色器需要 positionQuantized / positionScale / positionBias 三个 uniform 还原位置，
+    // draw(shader) 会自动设置；使用 draw() 时由调用方在设置 model 矩阵时调用 applyPositionDequantization
+    const VertexFormat::PositionRange& getPositionRange() const { return geometry->positionRange; }
+    void applyPositionDequantization(const CShader& shader) const;
+    
+    // 深度专用位置流：另存一份只含位置的顶点缓冲区（编码与主布局中的位置相同）和独立的 VAO，
+    // 阴影贴图、深度预渲染等只读取位置的 pass 用 drawPositionsOnly() 绘制，每顶点只读 12 字节（unorm16 为 8 字节）
+    // 与主缓冲区共用索引；Stream 模式不支持，已上传且 CPU 数据已释放时无法开启，两种情况返回 false
+    bool setPositionStreamEnabled(bool enabled);
+    bool hasPositionStream() const { return geometry->positionStream; }
+    size_t getPositionStreamStride() const;
     
     // 材质管理
     void setMaterial(std::shared_ptr<CMaterial> material) { this->material = material; }
@@ -70,19 +107,58 @@ public:
     void draw() const;  // 使用Material中的Shader
     void draw(CShader& shader) const;  // 使用指定Shader
     void drawInstanced(unsigned int instanceCount) const;
+    void drawPositionsOnly() const;  // 不应用材质；未开启位置流时使用主 VAO
+    // 经位置流把整个网格连续绘制 drawCount 次（一次 glMultiDrawElements），shader 用 gl_DrawIDARB 区分每次绘制
+    // 需要位置流和索引，否则不绘制并返回 false
+    bool drawPositionsOnlyMulti(unsigned int drawCount) const;
+    // 只绘制 [first, first + count) 的索引（无索引时为顶点），用于合批网格按子网格分段绘制；不应用材质
+    void drawRange(size_t first, size_t count) const;
     
     // 数据更新
     void updateVertexData(const std::vector<Vertex>& vertices);
     void updateIndexData(const std::vector<unsigned int>& indices);
+    void updateVertexData(std::vector<Vertex>&& vertices);
+    void updateIndexData(std::vector<unsigned int>&& indices);
+    
+    // 局部更新：只上传 [first, first + count) 区间，不能超出现有数据范围
+    bool updateVertexRange(size_t first, const Vertex* data, size_t count);
+    bool updateIndexRange(size_t first, const unsigned int* data, size_t count);
+    
+    // 缓冲区更新方式，Stream 需要提供共享的 StreamingBuffer，否则退化为 Dynamic
+    void setBufferUsage(BufferUsage usage, std::shared_ptr<StreamingBuffer> streamingBuffer = nullptr);
+    BufferUsage getBufferUsage() const { return geometry->bufferUsage; }
+    
+    // 几何数据放入共享的 GeometryArena，不再占用独立的 VAO/VBO/EBO；nullptr 表示改回独立缓冲区
+    // 已在 Arena 中的数据在显存内复制；Stream 模式不支持，离开 Arena 需要 CPU 数据，失败时返回 false
+    bool setGeometryArena(std::shared_ptr<GeometryArena> arena);
+    std::shared_ptr<GeometryArena> getGeometryArena() const { return geometry->arena; }
+    GeometryArena::Handle getArenaHandle() const { return geometry->arenaHandle; }
     
     // 图元类型
     void setPrimitiveType(PrimitiveType type) { primitiveType = type; }
     PrimitiveType getPrimitiveType() const { return primitiveType; }
     
     // 网格信息
-    size_t getVertexCount() const { return vertices.size(); }
-    size_t getIndexCount() const { return indices.size(); }
-    bool hasIndices() const { return !indices.empty(); }
+    size_t getVertexCount() const { return geometry->vertexCount; }
+    size_t getIndexCount() const { return geometry->indexCount; }
+    bool hasIndices() const { return geometry->indexCount > 0; }
+    
+    // 几何数据共享：拷贝出的网格共用同一组 VAO/VBO/EBO，任一方修改几何数据前先复制出私有的一份
+    bool sharesGeometryWith(const CMesh& other) const { return geometry == other.geometry; }
+    long getGeometryUseCount() const { return geometry.use_count(); }
+    
+    // CPU 端数据释放：上传到 GPU 后丢弃顶点/索引数组，保留数量与包围盒
+    // 释放后 calculateNormals 等依赖 CPU 数据的操作不再生效，局部更新只写入 GPU；
+    // Stream 模式需要 CPU 数据补传，不能释放；释放作用于共享的几何数据，所有拷贝一并生效
+    void setReleaseCpuDataAfterUpload(bool release);
+    bool getReleaseCpuDataAfterUpload() const { return releaseAfterUpload; }
+    bool releaseCpuData();
+    bool isCpuDataReleased() const { return geometry->isCpuDataReleased(); }
+    
+    // 当前顶点/索引数组占用的 CPU 内存（字节，按容量计）
+    size_t getCpuMemoryUsage() const;
+    // 所有存活网格因释放 CPU 数据而节省的内存（字节）
+    static size_t getTotalReleasedCpuBytes();
     
     // 包围盒
     struct BoundingBox {
@@ -100,38 +176,103 @@ public:
     };
     
     void calculateBoundingBox();
-    const BoundingBox& getBoundingBox() const { return boundingBox; }
+    const BoundingBox& getBoundingBox() const { return geometry->boundingBox; }
+    
+    // 默认折痕角（度），与 OBJ 缺少法线时生成所用的相同
+    static constexpr float DefaultCreaseAngle = 60.0f;
     
-    // 顶点计算辅助
-    void calculateNormals();
+    // 顶点计算辅助（仅三角形图元）
+    // creaseAngle: 折痕角（度），面夹角超过该值的边保持硬边并拆分顶点；180 表示完全平滑
+    void calculateNormals(float creaseAngle = DefaultCreaseAngle);
     void calculateTangentsAndBitangents();
 
 private:
-    // OpenGL对象
-    unsigned int VAO;
-    unsigned int VBO;
-    unsigned int EBO;
+    // 几何数据：GPU 对象与 CPU 数组，由拷贝出的网格共享
+    struct Geometry {
+        // OpenGL对象
+        unsigned int VAO;
+        unsigned int VBO;
+        unsigned int EBO;
+        
+        // 数据
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        size_t vertexCount;     // CPU 数据释放后仍保持有效
+        size_t indexCount;
+        VertexAttributeLayout vertexLayout;
+        BoundingBox boundingBox;
+        VertexFormat::PositionRange positionRange;  // unorm16 位置的量化范围
+        
+        // 深度 pass 用的位置流（可选），总是独立缓冲区，索引来自主缓冲区
+        bool positionStream;
+        unsigned int positionVAO;
+        unsigned int positionVBO;
+        size_t positionCapacity;
+        
+        // 是否已初始化
+        bool initialized;
+        
+        // 缓冲区更新方式与已分配容量（字节）
+        BufferUsage bufferUsage;
+        size_t vboCapacity;
+        size_t eboCapacity;
+        
+        // Stream 模式下的环形缓冲区分配；不是本帧写入的区间在绘制前从 CPU 数据重新上传
+        std::shared_ptr<StreamingBuffer> streamingBuffer;
+        StreamingBuffer::Allocation streamVertices;
+        StreamingBuffer::Allocation streamIndices;
+        
+        // GeometryArena 中的区间，有效时不使用上面的 VAO/VBO/EBO
+        std::shared_ptr<GeometryArena> arena;
+        GeometryArena::Handle arenaHandle;
+        
+        size_t releasedBytes;   // 计入全局统计的已释放字节数
+        
+        Geometry();
+        ~Geometry();
+        Geometry(const Geometry&) = delete;
+        Geometry& operator=(const Geometry&) = delete;
+        
+        bool isCpuDataReleased() const { return vertices.size() != vertexCount || indices.size() != indexCount; }
+        void updateReleasedBytes();
+        void updatePositionRange();
+    };
     
-    // 数据
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    VertexAttributeLayout vertexLayout;
+    // 从不为空；默认构造和被移动后的网格指向共享的空几何数据
+    std::shared_ptr<Geometry> geometry;
     
     // 属性
     PrimitiveType primitiveType;
     std::shared_ptr<CMaterial> material;
-    BoundingBox boundingBox;
     
-    // 是否已初始化
-    bool initialized;
+    // 上传后释放 CPU 数据
+    bool releaseAfterUpload;
+    
+    static std::shared_ptr<Geometry> emptyGeometry();
     
     // 内部函数
     void initialize();
-    void setupVertexAttributes();
-    void cleanup();
+    void setupVertexAttributes() const;
+    
+    // 写时复制：几何数据被其他网格共享时，复制一份私有的（显存内拷贝缓冲区）
+    void detachGeometry();
     
-    // 拷贝辅助
-    void copyFrom(const CMesh& other);
+    // 上传辅助
+    bool usesStreaming() const;
+    bool usesArena() const { return geometry->arena && geometry->arena->isValid(geometry->arenaHandle); }
+    bool uploadToArena(bool uploadVertices, bool uploadIndices);
+    void deleteOwnedObjects();
+    void uploadVertexBuffer();
+    void uploadIndexBuffer();
+    bool uploadStream() const;
+    void uploadOwnedBuffer(GLenum target, unsigned int& buffer, size_t& capacity, const void* data, size_t bytes);
+    void drawElementsOrArrays(unsigned int instanceCount, size_t first = 0,
+                              size_t count = static_cast<size_t>(-1)) const;
+    void uploadPositionStream();
+    void setupPositionAttributes() const;
+    GLintptr bindPositionIndexBuffer() const;  // 返回索引的字节偏移
+    void deletePositionStream();
+    void afterUpload();
     
     // 纹理坐标范围计算
     void calculateTextureCoordinateRange();
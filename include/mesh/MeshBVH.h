@@ -0,0 +1,153 @@
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh/Vertex.h"
+
+class CMesh;
+
+/**
+ * @brief 单个网格三角形的层次包围盒（BVH），用于射线求交和拾取
+ *
+ * 构建：按三角形包围盒中心做分箱 SAH（表面积启发式）得到二叉树，再把二叉树压平成四叉节点。
+ * 每个节点以 SoA 形式存放 4 个子包围盒（128 字节，两条缓存行），兄弟节点相邻存放；
+ * 叶子引用的三角形按划分后的顺序连续存放，预先算好顶点和两条边（Möller–Trumbore 直接使用）。
+ *
+ * 遍历：x86 上一条射线一次用 SSE 测试 4 个子包围盒，其它平台用标量实现，结果相同。
+ * 最近交点按子节点进入距离由近到远访问，并跳过比当前最近交点更远的子树；
+ * occluded() 找到任意交点即返回，用于阴影 / 可见性测试。
+ *
+ * 构建后只读，多个线程可以同时查询。
+ */
+class MeshBVH {
+public:
+    /**
+     * @brief 射线，direction 不要求归一化，交点参数 t 以 direction 的长度为单位
+     */
+    struct Ray {
+        glm::vec3 origin = glm::vec3(0.0f);
+        glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+        float tMin = 0.0f;
+        float tMax = std::numeric_limits<float>::infinity();
+
+        Ray() = default;
+        Ray(const glm::vec3& o, const glm::vec3& d,
+            float minT = 0.0f, float maxT = std::numeric_limits<float>::infinity())
+            : origin(o), direction(d), tMin(minT), tMax(maxT) {}
+    };
+
+    struct Hit {
+        float t = std::numeric_limits<float>::infinity();
+        uint32_t triangle = 0;    // 原索引数组中的三角形序号（indices[3 * triangle]）
+        float u = 0.0f;           // 重心坐标：交点 = (1 - u - v) * p0 + u * p1 + v * p2
+        float v = 0.0f;
+    };
+
+    // 场景中的一个实例：共享的 BVH + 模型矩阵
+    struct Instance {
+        const MeshBVH* bvh = nullptr;
+        glm::mat4 model = glm::mat4(1.0f);
+        glm::mat4 inverseModel = glm::mat4(1.0f);
+
+        Instance() = default;
+        Instance(const MeshBVH* b, const glm::mat4& m);
+    };
+
+    struct SceneHit {
+        float t = std::numeric_limits<float>::infinity();   // 世界空间射线参数
+        size_t instance = 0;                                 // instances 中的下标
+        uint32_t triangle = 0;
+        float u = 0.0f;
+        float v = 0.0f;
+        glm::vec3 position = glm::vec3(0.0f);                // 世界空间交点
+    };
+
+    struct Stats {
+        size_t nodeCount = 0;
+        size_t leafCount = 0;
+        size_t triangleCount = 0;
+        unsigned int maxDepth = 0;
+        float sahCost = 0.0f;      // 以根包围盒表面积归一化的 SAH 代价
+    };
+
+    MeshBVH() = default;
+
+    /**
+     * @brief 从三角形列表构建，替换原有内容
+     * @return 索引越界或数量不是 3 的倍数时返回 false，BVH 清空
+     */
+    bool build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    bool build(const glm::vec3* positions, size_t vertexCount, const unsigned int* indices, size_t indexCount);
+
+    /**
+     * @brief 从网格的 CPU 数据构建
+     * @return CPU 数据已释放、非三角形图元或构建失败时返回 nullptr
+     *
+     * 需要在网格释放 CPU 数据（setReleaseCpuDataAfterUpload / releaseCpuData）之前调用。
+     */
+    static std::shared_ptr<MeshBVH> fromMesh(const CMesh& mesh);
+
+    // 最近交点（t 在 [tMin, tMax] 内），未命中时返回 false，hit 不变
+    bool intersect(const Ray& ray, Hit& hit) const;
+
+    // 是否存在任意交点，找到第一个即返回
+    bool occluded(const Ray& ray) const;
+
+    /**
+     * @brief 场景级射线检测：射线变换到每个实例的局部空间后查询其 BVH
+     *
+     * 局部射线方向不归一化，t 与世界空间射线一致，可以直接比较不同实例的交点远近。
+     * bvh 为空的实例被跳过。
+     */
+    static bool raycast(const std::vector<Instance>& instances, const Ray& ray, SceneHit& hit);
+    static bool occluded(const std::vector<Instance>& instances, const Ray& ray);
+
+    /**
+     * @brief 由 NDC 坐标（[-1, 1]，y 向上）和相机矩阵生成世界空间射线
+     *
+     * 起点在近平面上，方向已归一化；屏幕中心（准星）对应 ndc = (0, 0)。
+     */
+    static Ray rayFromScreen(const glm::vec2& ndc, const glm::mat4& view, const glm::mat4& projection);
+
+    bool empty() const { return nodes_.empty(); }
+    size_t getTriangleCount() const { return triangles_.size(); }
+    size_t getNodeCount() const { return nodes_.size(); }
+    const glm::vec3& getBoundsMin() const { return boundsMin_; }
+    const glm::vec3& getBoundsMax() const { return boundsMax_; }
+    Stats getStats() const;
+
+    // 节点与三角形数据占用的字节数
+    size_t getMemoryUsage() const;
+
+    // 压平后的四叉节点：槽位 i 的包围盒 + 子节点 / 叶子三角形区间
+    struct alignas(16) Node {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        uint32_t child[4];    // count 为 0 时是子节点下标，否则是首个三角形
+        uint32_t count[4];    // 叶子三角形数，0 表示内部节点；空槽的包围盒为空（min > max）
+    };
+
+    // 预处理后的三角形：p0 与两条边，primitive 为原三角形序号
+    struct Triangle {
+        glm::vec3 p0;
+        glm::vec3 e1;
+        glm::vec3 e2;
+        uint32_t primitive;
+    };
+
+private:
+    template <bool AnyHit>
+    bool traverse(const Ray& ray, Hit& hit) const;
+
+    std::vector<Node> nodes_;
+    std::vector<Triangle> triangles_;
+    glm::vec3 boundsMin_ = glm::vec3(0.0f);
+    glm::vec3 boundsMax_ = glm::vec3(0.0f);
+};
+
+#endif
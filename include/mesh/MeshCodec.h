@@ -0,0 +1,69 @@
+#ifndef MESH_CODEC_H
+#define MESH_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CMesh;
+
+/**
+ * @brief 网格几何数据的无损压缩编码，用于磁盘存储（.mshc）
+ *
+ * 索引流：逐个索引编码为 4 位代码，两个代码占一个字节。代码表示「最近使用过的 13 个顶点中的第 k 个」
+ * （模拟顶点缓存的 FIFO）、「第一次出现的下一个顶点」、「上一个索引 + 1」，
+ * 都不满足时转义为与上一个索引之差的 zigzag 变长整数，写入单独的字节流。
+ * 按顶点缓存优化过、顶点按首次使用排序的网格，大部分三角形只需 1.5 字节。
+ *
+ * 顶点流：按 32 位分量逐列处理（stride 须为 4 的倍数），每个分量与上一个顶点的同一分量求差并做 zigzag，
+ * 再拆成 4 个字节通道；每个通道每 16 个值一组，按组内最大值选择 0 / 2 / 4 / 8 位打包。
+ * 平滑变化的属性高位字节几乎全为 0，整组不占空间。解码在 x86 上用 SSE2 展开位组、
+ * 重组字节并做前缀和，其它平台用结果相同的标量实现。
+ *
+ * 所有解码函数都检查输入长度，数据截断或损坏时返回 false / nullptr，不会越界读取。
+ */
+namespace MeshCodec {
+
+// 编码后的顶点流 / 索引流的最大字节数，用于预先分配
+size_t getVertexBufferBound(size_t vertexCount, size_t stride);
+size_t getIndexBufferBound(size_t indexCount);
+
+/**
+ * @brief 编码顶点流
+ * @param vertices 顶点数据，count 个、每个 stride 字节
+ * @return stride 不是 4 的倍数或为 0 时返回 false
+ */
+bool encodeVertices(const void* vertices, size_t count, size_t stride, std::vector<unsigned char>& out);
+
+/**
+ * @brief 解码顶点流到 vertices（count * stride 字节），count / stride 须与编码时相同
+ */
+bool decodeVertices(const unsigned char* data, size_t size, void* vertices, size_t count, size_t stride);
+
+bool encodeIndices(const unsigned int* indices, size_t count, std::vector<unsigned char>& out);
+bool decodeIndices(const unsigned char* data, size_t size, unsigned int* indices, size_t count);
+
+/**
+ * @brief 编码网格的顶点、索引、图元类型与包围盒（不含材质）
+ * @return CPU 数据已释放时返回 false
+ */
+bool encodeMesh(const CMesh& mesh, std::vector<unsigned char>& out);
+
+/**
+ * @brief 解码 encodeMesh 的结果，顶点和索引直接解码到 CMesh 持有的数组中
+ * @param consumed 输出本网格占用的字节数（可为 nullptr），用于依次解码连续存放的多个网格
+ * @return 数据不完整或格式不符时返回 nullptr
+ */
+std::shared_ptr<CMesh> decodeMesh(const unsigned char* data, size_t size, size_t* consumed = nullptr);
+
+/**
+ * @brief 把多个网格依次编码写入文件
+ * @return 打开 / 写入失败或某个网格无法编码时返回 false
+ */
+bool saveMeshes(const std::string& filepath, const std::vector<std::shared_ptr<CMesh>>& meshes);
+
+} // namespace MeshCodec
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef MESH_KERNELS_H
+#define MESH_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh/Vertex.h"
+
+/**
+ * @brief 顶点数组的批量计算内核
+ *
+ * 同一接口下提供标量、SSE2 和 AVX2(+FMA) 三种实现，首次使用时按 CPU 能力选择最快的一种。
+ * 所有内核以「首个 float 指针 + 字节步长」描述输入，因此既能处理紧凑的 vec3 数组，
+ * 也能直接在 56 字节的 Vertex 数组上跨步访问 position / normal。
+ * 半精度编码使用 F16C，随 AVX2 级别启用（支持 AVX2 的 CPU 都支持 F16C）。
+ */
+class MeshKernels {
+public:
+    enum class SimdLevel {
+        Scalar = 0,
+        SSE2,
+        AVX2
+    };
+
+    // CPU 支持的最高级别
+    static SimdLevel getDetectedLevel();
+
+    // 当前使用的级别
+    static SimdLevel getActiveLevel();
+
+    // 强制使用某一级别（用于基准测试和单元测试），超过 CPU 能力时取检测到的级别
+    static void setActiveLevel(SimdLevel level);
+
+    static const char* getLevelName(SimdLevel level);
+
+    // AABB 归约，count 为 0 时返回 false
+    static bool computeAABB(const float* positions, size_t count, size_t stride,
+                            glm::vec3& outMin, glm::vec3& outMax);
+    static bool computeAABB(const std::vector<Vertex>& vertices, glm::vec3& outMin, glm::vec3& outMax);
+
+    // 包围球：以 AABB 中心为球心、到最远顶点的距离为半径
+    static bool computeBoundingSphere(const float* positions, size_t count, size_t stride,
+                                      glm::vec3& outCenter, float& outRadius);
+    static bool computeBoundingSphere(const std::vector<Vertex>& vertices, glm::vec3& outCenter, float& outRadius);
+
+    // 用仿射矩阵变换位置（忽略投影分量），in 与 out 可以相同（原地变换）
+    static void transformPositions(const float* in, size_t inStride, float* out, size_t outStride,
+                                   size_t count, const glm::mat4& matrix);
+
+    // 用法线矩阵变换方向向量，renormalize 为 true 时重新归一化（零向量保持为零）
+    static void transformNormals(const float* in, size_t inStride, float* out, size_t outStride,
+                                 size_t count, const glm::mat3& normalMatrix, bool renormalize = true);
+
+    // 原地变换 Vertex 数组：位置用 model，法线 / 切线 / 副切线用其逆转置
+    static void transformVertices(Vertex* vertices, size_t count, const glm::mat4& model);
+
+    // 变换 AABB 并返回新的轴对齐包围盒（Arvo 方法）
+    static void transformAABB(const glm::vec3& min, const glm::vec3& max, const glm::mat4& matrix,
+                              glm::vec3& outMin, glm::vec3& outMax);
+
+    // 量化编码：输出同样按字节步长跨步写入，便于直接写进交错的顶点缓冲区
+
+    // xyz 编码为 GL_INT_2_10_10_10_REV 的 snorm（round(v * 511)，先限制在 [-1, 1]），w 位为 0
+    static void encodeSnorm10(const float* in, size_t inStride, void* out, size_t outStride, size_t count);
+
+    // (v - bias) * invScale 限制在 [0, 1] 后编码为 unorm16；components 为 1~3，写入的 short 数补齐为偶数（补 0）
+    static void encodeUnorm16(const float* in, size_t inStride, unsigned components,
+                              const glm::vec3& bias, const glm::vec3& invScale,
+                              void* out, size_t outStride, size_t count);
+
+    // IEEE 半精度（就近舍入到偶数）；components 为 1~3，写入的 half 数补齐为偶数（补 0）
+    static void encodeHalf(const float* in, size_t inStride, unsigned components,
+                           void* out, size_t outStride, size_t count);
+
+    // 单个值的半精度转换，与 encodeHalf 的结果一致
+    static uint16_t floatToHalf(float value);
+    static float halfToFloat(uint16_t value);
+
+private:
+    MeshKernels() = delete;
+};
+
+#endif
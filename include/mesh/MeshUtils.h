@@ -10,6 +10,8 @@
 class MeshUtils {
 public:
     // 基础几何体生成
+    // 结果按（形状，参数）缓存：参数相同的调用返回共享同一组 VAO/VBO/EBO 的网格拷贝，不再重新生成和上传
+    // 每次返回的网格材质各自独立，修改几何数据前按写时复制分离；分段数较高时按环（行）并行生成顶点和索引
     static std::shared_ptr<CMesh> createCube(float size = 1.0f);
     static std::shared_ptr<CMesh> createSphere(float radius = 1.0f, unsigned int segments = 32);
     static std::shared_ptr<CMesh> createPlane(float width = 1.0f, float height = 1.0f, unsigned int widthSegments = 1, unsigned int heightSegments = 1);
@@ -18,18 +20,72 @@ public:
     static std::shared_ptr<CMesh> createTorus(float outerRadius = 1.0f, float innerRadius = 0.5f, unsigned int sides = 32, unsigned int rings = 32);
     static std::shared_ptr<CMesh> createCapsule(float radius = 1.0f, float height = 1.0f, unsigned int segments = 32);
     
+    // 编译期静态表（PrimitiveTables）直接从只读数据上传：不在堆上生成顶点、不做三角函数运算，不保留 CPU 数据
+    // 布局为 PositionNormalTex，尺寸为单位大小（由模型矩阵缩放）；没有对应分段数的静态表时返回 nullptr
+    static std::shared_ptr<CMesh> createStaticCube();
+    static std::shared_ptr<CMesh> createStaticSphere(unsigned int segments = 32);  // 16 / 32 / 64
+    static std::shared_ptr<CMesh> createStaticTorus(unsigned int segments = 32);   // 16 / 32，外半径 1、内半径 0.5
+    
+    // 几何体缓存统计
+    struct PrimitiveCacheStats {
+        size_t hits = 0;            // 直接复用已有几何数据的次数
+        size_t misses = 0;          // 实际生成并上传的次数
+        size_t liveEntries = 0;     // 仍有网格在使用的缓存条目
+    };
+    
+    // 缓存只持有弱引用，某个参数组合的网格全部销毁后几何数据随之释放；
+    // 缓存的几何数据被 releaseCpuData 释放后，下次调用重新生成，保证返回的网格总带有 CPU 数据
+    static void setPrimitiveCacheEnabled(bool enabled);
+    static bool isPrimitiveCacheEnabled();
+    static PrimitiveCacheStats getPrimitiveCacheStats();
+    // 清空条目和统计，已返回的网格不受影响
+    static void clearPrimitiveCache();
+    
     // 顶点计算
-    static void calculateNormals(std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    // 平滑法线：按面积 × 顶角加权，位置相同的顶点（如 UV 接缝两侧）共享法线，按三角形区间并行
+    // keepNormals 非空时，标记为非 0 的顶点保留原法线（如文件中已有的法线），不改写也不拆分
+    static void calculateNormals(std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                 const std::vector<char>* keepNormals = nullptr);
+    // 带折痕角的平滑法线：面法线夹角超过 creaseAngle（度）的面之间保持硬边，必要时拆分顶点并改写 indices
+    static void calculateNormals(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, float creaseAngle,
+                                 const std::vector<char>* keepNormals = nullptr);
+    // MikkTSpace 兼容切线：按顶角加权累加投影后的切线，Gram-Schmidt 正交化，bitangent = sign * cross(N, T)
     static void calculateTangentsAndBitangents(std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
     static void calculateBoundingBox(const std::vector<Vertex>& vertices, CMesh::BoundingBox& bbox);
     
     // 顶点索引化（消除重复顶点）
     static std::vector<unsigned int> indexVertices(const std::vector<Vertex>& vertices, std::vector<Vertex>& indexedVertices);
     
+    // 合并结果中一段连续的绘制区间
+    struct SubMesh {
+        size_t firstIndex = 0;      // 在合并后索引数组中的起点；合并结果无索引时为首个顶点
+        size_t indexCount = 0;      // 合并结果无索引时为顶点数
+        size_t baseVertex = 0;      // 源网格第 0 个顶点在合并后顶点数组中的位置（索引已加上该偏移）
+        size_t vertexCount = 0;
+        std::shared_ptr<CMaterial> material;
+    };
+    
     // 顶点数据合并
     static std::shared_ptr<CMesh> mergeMeshes(const std::vector<std::shared_ptr<CMesh>>& meshes);
+    // 按 transforms[i] 把第 i 个网格变换到世界空间后再合并，transforms 数量不匹配时返回 nullptr
+    // 任一网格已释放 CPU 数据时同样返回 nullptr
+    static std::shared_ptr<CMesh> mergeMeshes(const std::vector<std::shared_ptr<CMesh>>& meshes,
+                                              const std::vector<glm::mat4>& transforms);
+    // 静态合批：先按源网格的顶点 / 索引数做前缀和一次分配，再按区间并行复制、变换顶点和改写索引
+    // subMeshes 与 meshes 一一对应，记录每个源网格的区间与材质；部分源网格没有索引时为其补上顺序索引
+    static std::shared_ptr<CMesh> mergeMeshes(const std::vector<std::shared_ptr<CMesh>>& meshes,
+                                              const std::vector<glm::mat4>& transforms,
+                                              std::vector<SubMesh>& subMeshes);
+    // 把材质相同的相邻区间合成一段，每段一次 CMesh::drawRange；合并前把同材质的网格排在一起可减少段数
+    static std::vector<SubMesh> coalesceSubMeshes(const std::vector<SubMesh>& subMeshes);
     
-    // 网格细分
+    // Loop 细分（仅三角形）：每层把每个三角形分成 4 个，边上的新顶点经无锁边哈希表在相邻三角形间共享
+    // 内部边与顶点按 Loop 规则平滑，边界 / 非流形边（含 UV 接缝）按边界规则；纹理坐标线性插值，
+    // 法线（原本有切线时连同切线）细分后重新计算。各阶段按三角形 / 顶点区间并行，结果与线程数无关；
+    // 第一层统计出边数后按闭式增长（三角形 ×4，E' = 2E + 3T）一次预留最终顶点数组
+    // 索引越界或结果超出 32 位索引范围时返回 false，输入保持不变
+    static bool subdivideLoop(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, unsigned int levels = 1);
+    // 网格细分：复制 CPU 数据后调用 subdivideLoop，保留材质；CPU 数据已释放、非三角形图元或细分失败时返回 nullptr
     static std::shared_ptr<CMesh> subdivideMesh(std::shared_ptr<CMesh> mesh, unsigned int subdivisions = 1);
     
     // 法线可视化（生成法线线段网格）
@@ -39,11 +95,20 @@ public:
     static std::shared_ptr<CMesh> createBoundingBoxVisualization(const CMesh::BoundingBox& bbox);
 
 private:
-    // 辅助函数
+    // 辅助函数：生成几何体的顶点和索引（不经过缓存）
+    static void generateCubeVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, float size);
     static void generateSphereVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
                                     float radius, unsigned int segments);
     static void generatePlaneVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
                                    float width, float height, unsigned int widthSegments, unsigned int heightSegments);
+    static void generateCylinderVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                      float radius, float height, unsigned int segments);
+    static void generateConeVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                  float radius, float height, unsigned int segments);
+    static void generateTorusVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                   float outerRadius, float innerRadius, unsigned int sides, unsigned int rings);
+    static void generateCapsuleVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                     float radius, float height, unsigned int segments);
     
     // 数学辅助
     static glm::vec3 calculateTangent(const Vertex& v0, const Vertex& v1, const Vertex& v2);
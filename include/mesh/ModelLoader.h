@@ -59,6 +59,9 @@ public:
 
 private:
     struct OBJIndex {
+        // 面定义中省略的纹理坐标/法线索引
+        static const unsigned int kMissing = 0xFFFFFFFFu;
+        
         unsigned int positionIndex;
         unsigned int normalIndex;
         unsigned int texCoordIndex;
@@ -82,6 +85,18 @@ private:
                    std::vector<std::shared_ptr<CMesh>>& meshes);
 };
 
+/**
+ * @brief 压缩网格（.mshc，MeshCodec::saveMeshes 写出）加载器
+ *
+ * 文件由若干个 MeshCodec::encodeMesh 的结果依次拼接而成，每个对应一个网格。
+ */
+class CompressedMeshLoader : public IModelLoader {
+public:
+    std::vector<std::shared_ptr<CMesh>> loadModel(const std::string& filepath) override;
+    bool canLoad(const std::string& filepath) const override;
+    const char* getSupportedExtension() const override { return "mshc"; }
+};
+
 /**
  * @brief Factory for creating model loaders.
  */
@@ -0,0 +1,278 @@
+#ifndef PRIMITIVE_TABLES_H
+#define PRIMITIVE_TABLES_H
+
+#include <cstddef>
+#include <vector>
+#include "mesh/Vertex.h"
+
+/**
+ * @brief 编译期生成的几何体顶点 / 索引表
+ *
+ * 生成函数都是 constexpr（C++14），三角函数用 constexpr 泰勒级数计算，每行 / 每列的角度只算一次。
+ * 常用细分级别的表在 PrimitiveTables.cpp 中实例化为 constexpr 常量，位于只读数据段：
+ * 启动时不做三角函数运算，也不在堆上生成顶点。
+ *
+ * StaticVertex 与 VertexAttributeLayout::PositionNormalTex() 的内存排列相同（32 字节），
+ * 表中的顶点可以不经转换直接上传（MeshUtils::createStaticCube 等）。
+ */
+namespace PrimitiveTables {
+
+struct StaticVertex {
+    float position[3];
+    float normal[3];
+    float texCoords[2];
+};
+
+template <size_t VertexCount, size_t IndexCount>
+struct Table {
+    static const size_t vertexCount = VertexCount;
+    static const size_t indexCount = IndexCount;
+
+    StaticVertex vertices[VertexCount];
+    unsigned int indices[IndexCount];
+    float boundsMin[3];
+    float boundsMax[3];
+};
+
+template <size_t VertexCount, size_t IndexCount>
+const size_t Table<VertexCount, IndexCount>::vertexCount;
+template <size_t VertexCount, size_t IndexCount>
+const size_t Table<VertexCount, IndexCount>::indexCount;
+
+/**
+ * @brief 运行时访问静态表的视图，没有对应的表时为空
+ */
+struct TableView {
+    const StaticVertex* vertices = nullptr;
+    size_t vertexCount = 0;
+    const unsigned int* indices = nullptr;
+    size_t indexCount = 0;
+    const float* boundsMin = nullptr;
+    const float* boundsMax = nullptr;
+
+    bool empty() const { return vertexCount == 0; }
+};
+
+template <size_t VertexCount, size_t IndexCount>
+TableView makeView(const Table<VertexCount, IndexCount>& table) {
+    TableView view;
+    view.vertices = table.vertices;
+    view.vertexCount = VertexCount;
+    view.indices = table.indices;
+    view.indexCount = IndexCount;
+    view.boundsMin = table.boundsMin;
+    view.boundsMax = table.boundsMax;
+    return view;
+}
+
+namespace detail {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// [-pi/2, pi/2] 上的泰勒级数，截断误差低于 1e-16
+constexpr double sinSeries(double x) {
+    double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; ++n) {
+        term *= -x2 / static_cast<double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double sin(double x) {
+    // 先归约到 [-pi, pi]，再利用 sin(pi - x) = sin(x) 折到 [-pi/2, pi/2]
+    long turns = static_cast<long>(x / (2.0 * kPi));
+    x -= static_cast<double>(turns) * 2.0 * kPi;
+    if (x > kPi) x -= 2.0 * kPi;
+    if (x < -kPi) x += 2.0 * kPi;
+    if (x > 0.5 * kPi) x = kPi - x;
+    else if (x < -0.5 * kPi) x = -kPi - x;
+    return sinSeries(x);
+}
+
+constexpr double cos(double x) {
+    return sin(x + 0.5 * kPi);
+}
+
+template <size_t VertexCount, size_t IndexCount>
+constexpr void computeBounds(Table<VertexCount, IndexCount>& table) {
+    for (int c = 0; c < 3; ++c) {
+        table.boundsMin[c] = table.vertices[0].position[c];
+        table.boundsMax[c] = table.vertices[0].position[c];
+    }
+    for (size_t i = 1; i < VertexCount; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            float p = table.vertices[i].position[c];
+            if (p < table.boundsMin[c]) table.boundsMin[c] = p;
+            if (p > table.boundsMax[c]) table.boundsMax[c] = p;
+        }
+    }
+}
+
+// 相邻两行顶点之间的四边形：(current, next, current + 1), (current + 1, next, next + 1)
+template <size_t VertexCount, size_t IndexCount>
+constexpr void writeQuadRows(Table<VertexCount, IndexCount>& table, unsigned int rows, unsigned int columns) {
+    size_t out = 0;
+    for (unsigned int row = 0; row < rows; ++row) {
+        for (unsigned int column = 0; column < columns; ++column) {
+            unsigned int current = row * (columns + 1) + column;
+            unsigned int next = current + columns + 1;
+            table.indices[out++] = current;
+            table.indices[out++] = next;
+            table.indices[out++] = current + 1;
+            table.indices[out++] = current + 1;
+            table.indices[out++] = next;
+            table.indices[out++] = next + 1;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 边长 1 的立方体，每面 4 个顶点（法线、纹理坐标按面独立），从外侧看逆时针
+ *
+ * 每个面由法线 n 和面内的 u / v 方向描述（u × v = n），四个角按 (0,0) (1,0) (1,1) (0,1) 排列，
+ * 纹理从外侧看不镜像。面的顺序：前、后、顶、底、右、左。
+ */
+constexpr Table<24, 36> makeCube() {
+    Table<24, 36> table{};
+    const float faces[6][3][3] = {
+        // 法线            u 方向             v 方向
+        { { 0, 0, 1 },  { 1, 0, 0 },  { 0, 1, 0 } },    // 前
+        { { 0, 0, -1 }, { -1, 0, 0 }, { 0, 1, 0 } },    // 后
+        { { 0, 1, 0 },  { 1, 0, 0 },  { 0, 0, -1 } },   // 顶
+        { { 0, -1, 0 }, { 1, 0, 0 },  { 0, 0, 1 } },    // 底
+        { { 1, 0, 0 },  { 0, 0, -1 }, { 0, 1, 0 } },    // 右
+        { { -1, 0, 0 }, { 0, 0, 1 },  { 0, 1, 0 } }     // 左
+    };
+    const float corners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+    for (unsigned int face = 0; face < 6; ++face) {
+        for (unsigned int corner = 0; corner < 4; ++corner) {
+            StaticVertex& v = table.vertices[face * 4 + corner];
+            float u = corners[corner][0];
+            float w = corners[corner][1];
+            for (int c = 0; c < 3; ++c) {
+                v.position[c] = 0.5f * faces[face][0][c] + (u - 0.5f) * faces[face][1][c] + (w - 0.5f) * faces[face][2][c];
+                v.normal[c] = faces[face][0][c];
+            }
+            v.texCoords[0] = u;
+            v.texCoords[1] = w;
+        }
+        const unsigned int quad[6] = { 0, 1, 2, 2, 3, 0 };
+        for (unsigned int k = 0; k < 6; ++k) {
+            table.indices[face * 6 + k] = face * 4 + quad[k];
+        }
+    }
+    detail::computeBounds(table);
+    return table;
+}
+
+/**
+ * @brief 半径 1 的 UV 球体，顶点排列与 MeshUtils::createSphere 相同
+ */
+template <unsigned int Segments>
+constexpr Table<(Segments + 1) * (Segments + 1), Segments * Segments * 6> makeSphere() {
+    Table<(Segments + 1) * (Segments + 1), Segments * Segments * 6> table{};
+
+    // 经度 / 纬度方向各 Segments + 1 个角度，三角函数只算一次
+    double cosX[Segments + 1] = {}, sinX[Segments + 1] = {};
+    double cosY[Segments + 1] = {}, sinY[Segments + 1] = {};
+    for (unsigned int i = 0; i <= Segments; ++i) {
+        float t = static_cast<float>(i) / static_cast<float>(Segments);
+        cosX[i] = detail::cos(static_cast<double>(t * 2.0f) * detail::kPi);
+        sinX[i] = detail::sin(static_cast<double>(t * 2.0f) * detail::kPi);
+        cosY[i] = detail::cos(static_cast<double>(t) * detail::kPi);
+        sinY[i] = detail::sin(static_cast<double>(t) * detail::kPi);
+    }
+
+    for (unsigned int y = 0; y <= Segments; ++y) {
+        for (unsigned int x = 0; x <= Segments; ++x) {
+            StaticVertex& v = table.vertices[y * (Segments + 1) + x];
+            float xPos = static_cast<float>(cosX[x] * sinY[y]);
+            float yPos = static_cast<float>(cosY[y]);
+            float zPos = static_cast<float>(sinX[x] * sinY[y]);
+            v.position[0] = v.normal[0] = xPos;
+            v.position[1] = v.normal[1] = yPos;
+            v.position[2] = v.normal[2] = zPos;
+            v.texCoords[0] = static_cast<float>(x) / static_cast<float>(Segments);
+            v.texCoords[1] = static_cast<float>(y) / static_cast<float>(Segments);
+        }
+    }
+
+    // 与 createSphere 的绕序一致：(next, current, current + 1), (next + 1, current + 1, next)
+    size_t out = 0;
+    for (unsigned int y = 0; y < Segments; ++y) {
+        for (unsigned int x = 0; x < Segments; ++x) {
+            unsigned int current = y * (Segments + 1) + x;
+            unsigned int next = current + Segments + 1;
+            table.indices[out++] = next;
+            table.indices[out++] = current;
+            table.indices[out++] = current + 1;
+            table.indices[out++] = next + 1;
+            table.indices[out++] = current + 1;
+            table.indices[out++] = next;
+        }
+    }
+    detail::computeBounds(table);
+    return table;
+}
+
+/**
+ * @brief 圆环，顶点排列与 MeshUtils::createTorus 相同
+ */
+template <unsigned int Sides, unsigned int Rings>
+constexpr Table<(Sides + 1) * (Rings + 1), Sides * Rings * 6> makeTorus(float outerRadius, float innerRadius) {
+    Table<(Sides + 1) * (Rings + 1), Sides * Rings * 6> table{};
+    float tubeRadius = (outerRadius - innerRadius) * 0.5f;
+    float ringRadius = innerRadius + tubeRadius;
+
+    double cosTheta[Rings + 1] = {}, sinTheta[Rings + 1] = {};
+    double cosPhi[Sides + 1] = {}, sinPhi[Sides + 1] = {};
+    for (unsigned int ring = 0; ring <= Rings; ++ring) {
+        float theta = static_cast<float>(static_cast<float>(ring) / Rings * 2.0f * detail::kPi);
+        cosTheta[ring] = detail::cos(theta);
+        sinTheta[ring] = detail::sin(theta);
+    }
+    for (unsigned int side = 0; side <= Sides; ++side) {
+        float phi = static_cast<float>(static_cast<float>(side) / Sides * 2.0f * detail::kPi);
+        cosPhi[side] = detail::cos(phi);
+        sinPhi[side] = detail::sin(phi);
+    }
+
+    for (unsigned int ring = 0; ring <= Rings; ++ring) {
+        for (unsigned int side = 0; side <= Sides; ++side) {
+            StaticVertex& v = table.vertices[ring * (Sides + 1) + side];
+            v.position[0] = static_cast<float>((ringRadius + tubeRadius * cosPhi[side]) * cosTheta[ring]);
+            v.position[1] = static_cast<float>(tubeRadius * sinPhi[side]);
+            v.position[2] = static_cast<float>((ringRadius + tubeRadius * cosPhi[side]) * sinTheta[ring]);
+            v.normal[0] = static_cast<float>(cosPhi[side] * cosTheta[ring]);
+            v.normal[1] = static_cast<float>(sinPhi[side]);
+            v.normal[2] = static_cast<float>(cosPhi[side] * sinTheta[ring]);
+            v.texCoords[0] = static_cast<float>(ring) / Rings;
+            v.texCoords[1] = static_cast<float>(side) / Sides;
+        }
+    }
+    detail::writeQuadRows(table, Rings, Sides);
+    detail::computeBounds(table);
+    return table;
+}
+
+// 预生成的表（PrimitiveTables.cpp）
+TableView cube();
+// 半径 1，segments 为 16 / 32 / 64，其它分段数返回空视图
+TableView sphere(unsigned int segments);
+// 外半径 1、内半径 0.5，sides = rings = segments，支持 16 / 32，其它分段数返回空视图
+TableView torus(unsigned int segments);
+
+/**
+ * @brief 把表展开成 Vertex / 索引数组，位置乘以 scale（需要 CPU 端数据时使用）
+ */
+void copyTo(const TableView& table, float scale, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+} // namespace PrimitiveTables
+
+#endif
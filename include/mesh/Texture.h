@@ -4,6 +4,9 @@
 #include <glad/glad.h>
 #include <string>
 #include <iostream>
+#include <vector>
+#include "mesh/ImageKernels.h"
+#include "mesh/TextureEncoder.h"
 
 // 前向声明 - 使用extern "C"确保C链接
 extern "C" {
@@ -27,12 +30,56 @@ public:
     std::string path;
     int width, height, nrChannels;
     
-    // 构造函数：从文件加载
+    /**
+     * @brief 首次加载时压缩并缓存的设置（默认关闭）
+     *
+     * 开启后，从文件创建的非 .dds / .ktx 纹理经 TextureEncoder::loadOrEncode 编码为块压缩格式，
+     * 结果缓存在 cacheDirectory 中，之后的加载直接读取缓存；编码失败时按原格式加载。
+     */
+    struct CompressionSettings {
+        bool enabled = false;
+        EncodeQuality quality = EncodeQuality::Normal;
+        std::string cacheDirectory = "cache/textures";
+    };
+    
+    // 对之后创建的纹理生效，可在任意线程调用
+    static void setCompressionSettings(const CompressionSettings& settings);
+    static CompressionSettings getCompressionSettings();
+    
+    // 按当前设置为该类型的纹理生成编码参数（法线贴图为 BC5，其它按内容选择）
+    static EncodeOptions getEncodeOptions(TextureType texType);
+    
+    // 该类型纹理的 mip 参数：漫反射贴图在线性空间滤波，其它按数据贴图处理；与默认的 GL_REPEAT 一致按平铺取样
+    static MipOptions getMipOptions(TextureType texType);
+    
+    /**
+     * @brief 按上传格式准备完整 mip 链（纯 CPU，可在后台线程调用）
+     *
+     * RGB 扩展为 RGBA，其它通道数保持不变；各级别由 ImageKernels::generateMipChain 生成。
+     */
+    static void prepareLevels(const unsigned char* pixels, int w, int h, int channels,
+                              const MipOptions& mips, std::vector<ImageLevel>& levels);
+    
+    // 上传时的通道数（RGB 按 RGBA 上传）
+    static int getUploadChannels(int channels) { return channels == 3 ? 4 : channels; }
+    
+    /**
+     * @brief 驱动是否支持该块压缩格式（GL 线程调用，首次调用时查询并缓存）
+     *
+     * BC4 / BC5 属于核心的 RGTC；BC1 / BC3 需要 EXT_texture_compression_s3tc，
+     * BC7 需要 GL 4.2 或 ARB_texture_compression_bptc。不支持时 BC1 / BC3 解码为 RGBA8 上传，BC7 加载失败。
+     */
+    static bool isBlockFormatSupported(BlockFormat format);
+    
+    // 构造函数：从文件加载（.dds / .ktx 按块压缩纹理上传，其它格式经 stb_image 解码或按压缩设置编码）
     CTexture(const std::string& filepath, TextureType texType = TextureType::Diffuse);
     
     // 构造函数：从数据创建
     CTexture(unsigned char* data, int width, int height, int channels, TextureType texType = TextureType::Diffuse);
     
+    // 构造函数：从块压缩数据创建，直接上传全部 mip 级别，不调用 glGenerateMipmap
+    CTexture(const CompressedImage& image, TextureType texType = TextureType::Diffuse);
+    
     // 析构函数
     ~CTexture();
     
@@ -51,20 +98,49 @@ public:
     // 设置过滤模式
     void setFilterMode(GLenum minFilter, GLenum magFilter);
     
-    // 生成Mipmap
+    // 用 glGenerateMipmap 重新生成 Mipmap（块压缩纹理已带全部级别，忽略）
     void generateMipmaps();
     
     // 获取格式信息
     GLenum getFormat() const;
     GLenum getInternalFormat() const;
-
-private:
-    // 初始化纹理
-    void initialize(unsigned char* data);
     
-    // 获取GL格式的辅助函数
+    // 接管纹理对象 id（释放原有对象），用于异步加载完成后替换占位纹理
+    void adopt(unsigned int id, int w, int h, int channels);
+    void adoptCompressed(unsigned int id, const CompressedImage& image);
+    // 接管 GL_TEXTURE_2D_ARRAY 纹理对象（layers 层，每层完整 mip 链），用于 TextureArrayPool
+    void adoptArray(unsigned int id, int w, int h, int layers, int channels);
+    
+    bool isCompressed() const { return compressedFormat_ != 0; }
+    
+    // 纹理目标：普通纹理为 GL_TEXTURE_2D，纹理数组为 GL_TEXTURE_2D_ARRAY；bind() 等操作按目标进行
+    GLenum getTarget() const { return target_; }
+    bool isArray() const { return target_ == GL_TEXTURE_2D_ARRAY; }
+    int getLayerCount() const { return layers_; }
+    
+    // 显存占用：块压缩纹理为各级别数据之和，未压缩纹理按完整 mip 链估算（RGB 按 4 字节/像素）
+    size_t getGpuMemoryBytes() const { return gpuBytes_; }
+    
+    // 所有存活纹理的显存占用之和
+    static size_t getTotalGpuMemoryBytes();
+    
+    // 更新显存占用，用于只驻留部分级别的流式纹理（见 TextureStreamer）
+    void setGpuMemoryBytes(size_t bytes);
+    
+    // 按通道数获取GL格式
     static GLenum getGLFormat(int channels);
     static GLenum getGLInternalFormat(int channels);
+
+private:
+    GLenum compressedFormat_ = 0;
+    GLenum target_ = GL_TEXTURE_2D;
+    int layers_ = 1;
+    size_t gpuBytes_ = 0;
+    
+    // 初始化纹理：在 CPU 上生成 mip 链后逐级上传
+    void initialize(unsigned char* data);
+    void initializeCompressed(const CompressedImage& image);
+    void uploadLevels(const std::vector<ImageLevel>& levels);
 };
 
 #endif
\ No newline at end of file
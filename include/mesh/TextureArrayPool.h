@@ -0,0 +1,115 @@
+#ifndef TEXTURE_ARRAY_POOL_H
+#define TEXTURE_ARRAY_POOL_H
+
+#include <glad/glad.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mesh/Texture.h"
+
+/**
+ * @brief 纹理数组池：同尺寸、同格式的纹理放进共享的 GL_TEXTURE_2D_ARRAY，材质只引用层号
+ *
+ * 与 TextureAtlas 相比，各层互不渗色、保留完整 mip 链并可以平铺（GL_REPEAT），但要求尺寸与通道数相同。
+ * 每个格式类别（宽、高、上传通道数）按需创建数组，每个数组预分配 layersPerArray 层；放满时新建一个数组。
+ *
+ * 着色器按层号采样：层号来自顶点属性 LayerAttribute（lighting.vs 中的 aTextureLayer）。
+ * - 逐次绘制：setDrawLayer() 设置该属性的当前值（属性数组未开启时生效），不切换纹理也不改 uniform；
+ * - 实例化绘制：setInstanceLayers() 在当前 VAO 上把该属性指向每实例一个 float 的缓冲区（divisor = 1），
+ *   绘制完成后用 clearInstanceLayers() 还原。
+ * 同一数组中的材质因此只需绑定一次纹理。
+ */
+class TextureArrayPool {
+public:
+    // 着色器中层号属性的位置，紧接 VertexAttribute 的 5 个属性
+    static const GLuint LayerAttribute = 5;
+
+    // 纹理数组固定使用的纹理单元：0 为 diffuseTexture、1 为 shadowMap，类型不同的采样器不能共用一个单元
+    static const unsigned int TextureUnit = 2;
+
+    // 格式类别：同一类别的纹理可以放进同一个数组
+    struct FormatClass {
+        int width = 0;
+        int height = 0;
+        int channels = 0;      // 上传通道数（RGB 按 RGBA）
+
+        bool operator==(const FormatClass& other) const {
+            return width == other.width && height == other.height && channels == other.channels;
+        }
+        bool operator!=(const FormatClass& other) const { return !(*this == other); }
+    };
+
+    // 纹理在池中的位置
+    struct Slot {
+        std::shared_ptr<CTexture> array;
+        int layer = -1;
+
+        bool isValid() const { return array != nullptr && layer >= 0; }
+    };
+
+    struct Stats {
+        size_t arrays = 0;
+        size_t layersUsed = 0;
+        size_t layersCapacity = 0;
+        size_t gpuBytes = 0;       // 所有数组按容量分配的显存
+    };
+
+    /**
+     * @param layersPerArray 每个数组的层数，不超过 GL_MAX_ARRAY_TEXTURE_LAYERS
+     */
+    explicit TextureArrayPool(int layersPerArray = 64);
+
+    TextureArrayPool(const TextureArrayPool&) = delete;
+    TextureArrayPool& operator=(const TextureArrayPool&) = delete;
+
+    static FormatClass getFormatClass(int width, int height, int channels);
+
+    /**
+     * @brief 把图片放入同类别数组的空闲层，需要 OpenGL 上下文
+     *
+     * 按 CTexture::getMipOptions(type) 在 CPU 上生成完整 mip 链后逐级上传。
+     * @return 尺寸或通道数无效时返回无效的 Slot
+     */
+    Slot add(const unsigned char* pixels, int width, int height, int channels,
+             TextureType type = TextureType::Diffuse);
+
+    // 用 stb_image 读取文件后 add()，失败时返回无效的 Slot
+    Slot addFile(const std::string& path, TextureType type = TextureType::Diffuse);
+
+    // 归还层，之后的 add() 可以复用；数组本身保留
+    void release(const Slot& slot);
+
+    size_t getArrayCount() const { return arrays_.size(); }
+    int getLayersPerArray() const { return layersPerArray_; }
+    Stats getStats() const;
+
+    // 设置之后非实例化绘制使用的层号
+    static void setDrawLayer(int layer);
+
+    /**
+     * @brief 在当前绑定的 VAO 上开启每实例层号（buffer 中每实例一个 float，stride 为 0 表示紧排）
+     */
+    static void setInstanceLayers(GLuint buffer, size_t offset, GLsizei stride = 0);
+
+    /**
+     * @brief 实例化绘制结束后调用：关闭当前 VAO 上的层号属性数组并把 divisor 复位为 0
+     *
+     * 网格池的 VAO 被多个网格共享，不复位的话之后的非实例化绘制会读到残留的每实例层号流。
+     */
+    static void clearInstanceLayers();
+
+private:
+    struct Array {
+        FormatClass format;
+        std::shared_ptr<CTexture> texture;
+        std::vector<int> freeLayers;   // 从小到大取用
+    };
+
+    int layersPerArray_;
+    std::vector<Array> arrays_;
+
+    Array* findArray(const FormatClass& format);
+    Array& createArray(const FormatClass& format, TextureType type);
+};
+
+#endif
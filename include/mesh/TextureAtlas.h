@@ -0,0 +1,176 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh/ImageKernels.h"
+#include "mesh/Texture.h"
+#include "mesh/Vertex.h"
+
+class CMaterial;
+class CMesh;
+
+/**
+ * @brief MaxRects 矩形装箱（Best Short Side Fit）
+ *
+ * 维护页内所有极大空闲矩形；放入一个矩形后切分与之相交的空闲矩形，并删除被其它空闲矩形包含的项。
+ * 选择短边剩余最小的位置，同分时取长边剩余最小的。不旋转矩形。
+ */
+class MaxRectsPacker {
+public:
+    struct Rect {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+
+        bool contains(const Rect& other) const {
+            return other.x >= x && other.y >= y &&
+                   other.x + other.width <= x + width && other.y + other.height <= y + height;
+        }
+        bool intersects(const Rect& other) const {
+            return other.x < x + width && other.x + other.width > x &&
+                   other.y < y + height && other.y + other.height > y;
+        }
+    };
+
+    MaxRectsPacker(int width, int height);
+
+    // 放入 width x height 的矩形，放不下时返回 false
+    bool insert(int width, int height, Rect& out);
+
+    // 已放入矩形的面积占比
+    float getOccupancy() const;
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+private:
+    int width_;
+    int height_;
+    size_t usedArea_;
+    std::vector<Rect> freeRects_;
+
+    void splitFreeRects(const Rect& used);
+    void pruneFreeRects();
+};
+
+/**
+ * @brief 图集构建参数
+ */
+struct AtlasOptions {
+    int pageSize = 2048;       // 页的边长（2 的幂）
+    int padding = 4;           // 每张图片四周复制边缘像素的宽度（0 级纹素）
+    int maxImageSize = 512;    // 边长超过该值的图片不打包
+    bool srgb = true;          // 页的 mip 按 sRGB 在线性空间滤波（颜色贴图）；数据贴图应关闭
+};
+
+/**
+ * @brief 图片在图集中的位置
+ *
+ * 原纹理坐标 uv（[0, 1]）映射为 uv * uvScale + uvOffset。
+ */
+struct AtlasRegion {
+    int page = -1;             // -1 表示未打包（过大或放不下）
+    int x = 0;                 // 图片在页内的像素矩形（不含 padding）
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    glm::vec2 uvScale = glm::vec2(1.0f);
+    glm::vec2 uvOffset = glm::vec2(0.0f);
+
+    bool isValid() const { return page >= 0; }
+    glm::vec2 transform(const glm::vec2& uv) const { return uv * uvScale + uvOffset; }
+};
+
+/**
+ * @brief 纹理图集：把许多小纹理打包到共享的页中，减少绘制之间的纹理切换
+ *
+ * addImage() / addFile() / addTexture() 收集图片（统一转换为 RGBA），build() 按边长从大到小用 MaxRects 装箱，
+ * 页放满时新开一页。每张图片四周留 padding 宽的边缘延伸，矩形的位置与尺寸对齐到 2^(mip 级别数 - 1)，
+ * 使每个 mip 级别上图片仍落在整纹素上、边缘延伸至少还剩 1 个纹素：
+ * 级别数为 1 + floor(log2(padding))，页的 mip 用 box 滤波生成（2x2 平均不会跨过对齐边界）。
+ *
+ * 打包后有两种改写方式：
+ * - remapUVs() 直接改写网格的纹理坐标（网格的 CPU 数据必须仍在）；
+ * - applyToMaterial() 把材质的纹理换成页纹理，并设置材质的 uv 变换（顶点着色器中应用）。
+ * 只适用于纹理坐标在 [0, 1] 内的网格：图集中的子区域不能平铺（GL_REPEAT）。
+ */
+class TextureAtlas {
+public:
+    explicit TextureAtlas(const AtlasOptions& options = AtlasOptions());
+
+    /**
+     * @brief 添加图片（1~4 通道，转换为 RGBA）
+     * @return 图片下标，用于 getRegion()；尺寸无效时返回 -1
+     */
+    int addImage(const std::string& name, const unsigned char* pixels, int width, int height, int channels);
+
+    // 用 stb_image 读取文件，失败时返回 -1
+    int addFile(const std::string& path);
+
+    // 读回纹理的 0 级像素（glGetTexImage，需要 OpenGL 上下文）；块压缩纹理返回 -1
+    int addTexture(const CTexture& texture);
+
+    /**
+     * @brief 装箱并生成各页的像素与 mip 级别
+     * @return 所有图片都已打包；过大的图片 region 无效
+     */
+    bool build();
+
+    size_t getImageCount() const { return images_.size(); }
+    size_t getPageCount() const { return pages_.size(); }
+    const AtlasRegion& getRegion(int index) const { return images_[static_cast<size_t>(index)].region; }
+    int findImage(const std::string& name) const;
+
+    // 页的各 mip 级别（RGBA，按行紧密排列）
+    const std::vector<ImageLevel>& getPageLevels(size_t page) const { return pages_[page]; }
+
+    // 页的 mip 级别数：1 + floor(log2(padding))，不超过完整 mip 链
+    int getMipLevelCount() const;
+
+    // 图片（含 padding）占所有页面积的比例
+    float getOccupancy() const;
+
+    /**
+     * @brief 上传一页为纹理（GL_CLAMP_TO_EDGE，只有 getMipLevelCount() 级），需要 OpenGL 上下文
+     */
+    std::shared_ptr<CTexture> createTexture(size_t page, TextureType type = TextureType::Diffuse) const;
+
+    /**
+     * @brief 把纹理坐标映射到图集子区域
+     * @return 有纹理坐标超出 [0, 1] 时返回 false，不做修改
+     */
+    static bool remapUVs(std::vector<Vertex>& vertices, const AtlasRegion& region);
+    // 改写网格的顶点数据并重新上传；CPU 数据已释放时返回 false
+    static bool remapUVs(CMesh& mesh, const AtlasRegion& region);
+
+    /**
+     * @brief 让材质使用图集：替换（或添加）与页纹理同类型的纹理，并设置 uv 变换
+     *
+     * uv 变换作用于材质的全部纹理，多种贴图需用相同的图片尺寸与顺序分别构建图集，得到相同的布局。
+     */
+    static void applyToMaterial(CMaterial& material, const AtlasRegion& region,
+                                const std::shared_ptr<CTexture>& page);
+
+private:
+    struct Image {
+        std::string name;
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;  // RGBA
+        AtlasRegion region;
+    };
+
+    AtlasOptions options_;
+    std::vector<Image> images_;
+    std::vector<std::vector<ImageLevel>> pages_;
+    size_t usedArea_ = 0;
+
+    // 把图片及其边缘延伸写入页的 0 级
+    void blit(const Image& image, const MaxRectsPacker::Rect& cell, ImageLevel& page) const;
+};
+
+#endif
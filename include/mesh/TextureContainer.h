@@ -0,0 +1,111 @@
+#ifndef TEXTURE_CONTAINER_H
+#define TEXTURE_CONTAINER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// S3TC 属于 EXT_texture_compression_s3tc 扩展，核心 profile 的 glad 头文件中没有
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+/**
+ * @brief 块压缩格式（4x4 像素一块）
+ */
+enum class BlockFormat {
+    BC1 = 0,   // RGB + 1 位 alpha，8 字节/块
+    BC3,       // RGBA，16 字节/块
+    BC4,       // 单通道，8 字节/块
+    BC5,       // 双通道（法线贴图），16 字节/块
+    BC7,       // 高质量 RGBA，16 字节/块
+    Count
+};
+
+/**
+ * @brief 从 KTX / DDS 容器读出的块压缩纹理，包含预先生成的全部 mip 级别
+ */
+struct CompressedImage {
+    struct Level {
+        int width = 0;
+        int height = 0;
+        size_t offset = 0;   // 在 data 中的字节偏移
+        size_t size = 0;
+    };
+
+    BlockFormat format = BlockFormat::BC1;
+    bool srgb = false;
+    int width = 0;
+    int height = 0;
+    std::vector<Level> levels;         // levels[0] 为原始尺寸
+    std::vector<unsigned char> data;   // 各级别依次紧密存放
+
+    bool empty() const { return levels.empty(); }
+    size_t getByteSize() const { return data.size(); }
+    const unsigned char* getLevelData(size_t level) const { return data.data() + levels[level].offset; }
+
+    // glCompressedTexImage2D 使用的内部格式
+    GLenum getGLInternalFormat() const;
+
+    // 解码后的通道数：BC4 为 1，BC5 为 2，其它为 4
+    int getChannels() const;
+};
+
+/**
+ * @brief KTX（1.1）/ DDS 容器的解析与写出（纯 CPU，不调用 GL）
+ *
+ * 只接受 2D 纹理（不含立方体贴图、数组、体纹理），格式限 BC1 / BC3 / BC4 / BC5 / BC7。
+ * DDS 支持 DXT1 / DXT5 / ATI1 / ATI2 / BC4U / BC5U 四字符码与 DX10 扩展头；
+ * KTX 按 glInternalFormat 识别，大小端均可。
+ * 每个级别的数据长度都按宽高校验，截断或不一致时返回 false（out 为空）并在 error 中说明原因。
+ */
+namespace TextureContainer {
+
+// 扩展名为 .dds / .ktx（不区分大小写）
+bool isContainerPath(const std::string& path);
+
+bool parseDDS(const unsigned char* data, size_t size, CompressedImage& out, std::string* error = nullptr);
+bool parseKTX(const unsigned char* data, size_t size, CompressedImage& out, std::string* error = nullptr);
+
+/**
+ * @brief 按文件头自动识别 DDS / KTX
+ */
+bool parse(const unsigned char* data, size_t size, CompressedImage& out, std::string* error = nullptr);
+
+/**
+ * @brief 读取并解析文件
+ */
+bool load(const std::string& path, CompressedImage& out, std::string* error = nullptr);
+
+/**
+ * @brief 写出为 DDS（BC1 / BC3 / BC4 / BC5 用四字符码，sRGB 与 BC7 用 DX10 扩展头）或 KTX 1.1（小端）
+ */
+void writeDDS(const CompressedImage& image, std::vector<unsigned char>& out);
+void writeKTX(const CompressedImage& image, std::vector<unsigned char>& out);
+
+/**
+ * @brief 按扩展名写出文件：.ktx 为 KTX，其它为 DDS
+ */
+bool save(const std::string& path, const CompressedImage& image, std::string* error = nullptr);
+
+// 每块字节数（8 或 16）
+size_t getBlockBytes(BlockFormat format);
+
+// width x height 的一个级别压缩后的字节数（不足 4 像素按一整块计）
+size_t getLevelSize(BlockFormat format, int width, int height);
+
+const char* getFormatName(BlockFormat format);
+
+} // namespace TextureContainer
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef TEXTURE_ENCODER_H
+#define TEXTURE_ENCODER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "mesh/ImageKernels.h"
+#include "mesh/TextureContainer.h"
+
+/**
+ * @brief 编码质量预设
+ */
+enum class EncodeQuality {
+    Fast = 0,   // 主轴端点，一次选取索引
+    Normal,     // 再做两轮最小二乘端点拟合
+    High,       // 再在量化后的端点附近逐分量搜索
+    Count
+};
+
+/**
+ * @brief 编码参数
+ */
+struct EncodeOptions {
+    BlockFormat format = BlockFormat::Count;   // Count 表示按内容自动选择（见 TextureEncoder::chooseFormat）
+    EncodeQuality quality = EncodeQuality::Normal;
+    bool normalMap = false;      // 自动选择格式时按法线贴图处理（BC5）
+    bool srgb = false;
+    bool generateMips = true;    // 生成完整 mip 链（ImageKernels::generateMipChain）
+    MipFilter mipFilter = MipFilter::Kaiser;
+    bool gammaCorrectMips = true;   // BC1 / BC3 的 RGB 在线性空间滤波 mip；法线贴图与 BC4 / BC5 总是按线性值
+};
+
+/**
+ * @brief CPU 块压缩编码器（BC1 / BC3 / BC4 / BC5）
+ *
+ * 每个 4x4 块独立编码，整幅图按块用 Parallel::forRange 分给多个线程。
+ * BC1 颜色端点取像素协方差的主轴，索引选取与误差计算在 x86 上用 SSE2 一次处理 4 个像素，
+ * 其它平台用标量实现；像素值都是整数，两种实现的浮点运算都是精确的，结果逐字节相同。
+ * BC4 / BC5 的单通道块在 8 值与 6 值两种模式中选误差小的一种。
+ * 解码函数按 D3D 规范的整数公式实现，用于测试与 PSNR 统计。
+ */
+namespace TextureEncoder {
+
+// 是否支持编码该格式（BC7 只能解析，不能编码）
+bool isEncodable(BlockFormat format);
+
+/**
+ * @brief 按内容选择格式：法线贴图与双通道为 BC5，单通道为 BC4，alpha 不全为 255 的为 BC3，其余为 BC1
+ */
+BlockFormat chooseFormat(const unsigned char* pixels, int width, int height, int channels, bool normalMap);
+
+/**
+ * @brief 编码一个块
+ * @param rgba 16 个像素的 RGBA，按行排列
+ * @param out 8 或 16 字节（TextureContainer::getBlockBytes）
+ */
+void encodeBlock(BlockFormat format, EncodeQuality quality, const unsigned char* rgba, unsigned char* out);
+
+/**
+ * @brief 解码一个块到 16 个 RGBA 像素；BC4 为 (r, 0, 0, 255)，BC5 为 (r, g, 0, 255)，BC7 输出全 0
+ */
+void decodeBlock(BlockFormat format, const unsigned char* block, unsigned char* rgba);
+
+/**
+ * @brief 编码整幅图片（channels 为 1~4，含义与 stb_image 相同）
+ * @return 参数无效或格式不支持编码时返回 false
+ */
+bool encode(const unsigned char* pixels, int width, int height, int channels,
+            const EncodeOptions& options, CompressedImage& out, std::string* error = nullptr);
+
+/**
+ * @brief 解码一个级别到 RGBA（宽 x 高 x 4 字节），用于测试和质量统计
+ */
+void decodeLevel(const CompressedImage& image, size_t level, std::vector<unsigned char>& rgba);
+
+/**
+ * @brief 解码全部级别为 RGBA 的 mip 链，驱动不支持该压缩格式时改按未压缩纹理上传
+ * @return 不能解码的格式（BC7）返回 false，levels 为空
+ */
+bool decompress(const CompressedImage& image, std::vector<ImageLevel>& levels);
+
+/**
+ * @brief 计算 0 级相对原图的 PSNR（dB），只统计该格式保存的通道：BC1 为 RGB，BC3 为 RGBA，BC4 为 R，BC5 为 RG
+ * @return 完全一致时返回正无穷；尺寸不符或不能解码的格式（BC7）返回 0
+ */
+double measurePSNR(const unsigned char* pixels, int width, int height, int channels, const CompressedImage& image);
+
+/**
+ * @brief 读取图片并编码，结果缓存为 DDS；源文件内容与参数不变时直接读取缓存
+ *
+ * 缓存文件名由源文件名和（文件内容、格式、质量、sRGB、mip 设置）的哈希组成，
+ * 源文件修改后自动失效。缓存目录不存在时自动创建，写入失败不影响返回的结果。
+ * 只访问文件与 CPU，可以在后台线程调用。
+ * @param fromCache 输出结果是否来自缓存（可为 nullptr）
+ */
+bool loadOrEncode(const std::string& path, const EncodeOptions& options, const std::string& cacheDirectory,
+                  CompressedImage& out, bool* fromCache = nullptr, std::string* error = nullptr);
+
+const char* getQualityName(EncodeQuality quality);
+
+} // namespace TextureEncoder
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <glad/glad.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh/AsyncTextureLoader.h"
+#include "mesh/Texture.h"
+
+/**
+ * @brief 按屏幕占用流式加载 mip 级别的纹理驻留管理
+ *
+ * load() 与 AsyncTextureLoader 一样立即返回占位纹理，后台线程解码并生成完整 mip 链（或按压缩设置编码），
+ * CPU 端保留全部级别作为流式数据源，上传直接从 CPU 数据进行。显存中只驻留 [base, 最粗级别]：
+ * - 解码完成后先上传边长不超过 getTailSize() 的粗级别（常驻尾部），替换占位纹理；
+ * - 每帧按使用该纹理的物体在屏幕上的大小选择所需级别，逐级向细上传，每级上传完成后降低 GL_TEXTURE_BASE_LEVEL；
+ * - 所需级别总显存超过预算时，从纹素 / 像素比最大（最"过采样"）的纹理开始放弃细级别，
+ *   提高 GL_TEXTURE_BASE_LEVEL 并释放这些级别的存储。
+ *
+ * 每帧调用顺序：beginFrame() → 对每个绘制对象 addUsage() → update()。
+ * 本帧没有 addUsage() 的纹理只保留常驻尾部。
+ *
+ * @code
+ * TextureStreamer streamer(64 * 1024 * 1024);
+ * auto diffuse = streamer.load("resources/textures/container2.png");
+ * // 每帧
+ * streamer.beginFrame(view, projection, viewportHeight);
+ * streamer.addUsage(diffuse, worldMin, worldMax);
+ * streamer.update();
+ * @endcode
+ */
+class TextureStreamer {
+public:
+    struct Stats {
+        size_t textures = 0;            // 管理中的纹理数（已解码）
+        size_t residentBytes = 0;       // 已驻留级别的显存
+        size_t requestedBytes = 0;      // 按屏幕占用所需级别的显存（不受预算限制）
+        size_t targetBytes = 0;         // 预算内分配的级别的显存
+        size_t failed = 0;              // 解码失败，保留占位纹理
+        size_t bytesUploaded = 0;       // 累计
+        size_t bytesThisFrame = 0;      // 最近一次 update() 上传的字节数
+        size_t levelsStreamed = 0;      // 常驻尾部之外上传的级别数（累计）
+        size_t levelsEvicted = 0;       // 因预算或屏幕占用变小释放的级别数（累计）
+        size_t requestsCompleted = 0;   // 完成的流式请求数（所需级别全部驻留）
+        double lastLatencySeconds = 0.0;   // 最近一次请求从出现到完成的时间
+        double maxLatencySeconds = 0.0;
+        double totalLatencySeconds = 0.0;
+
+        double getAverageLatencySeconds() const {
+            return requestsCompleted > 0 ? totalLatencySeconds / static_cast<double>(requestsCompleted) : 0.0;
+        }
+    };
+
+    /**
+     * @brief 预算分配的输入与结果（纯 CPU，便于测试）
+     */
+    struct Residency {
+        std::vector<size_t> levelBytes;  // 每级显存
+        int width = 0;                   // 0 级尺寸
+        int height = 0;
+        int tailLevel = 0;               // 常驻尾部的第一级，不会被放弃
+        int desiredLevel = 0;            // 按屏幕占用所需的最细级别
+        float screenPixels = 0.0f;       // 屏幕上的大小（像素），0 表示本帧未使用
+        int targetLevel = 0;             // 输出：预算内驻留的最细级别
+
+        // [level, 最粗级别] 的显存
+        size_t getBytesFrom(int level) const;
+    };
+
+    /**
+     * @param budgetBytes 显存预算（所有流式纹理之和）
+     * @param workers 解码线程数，0 表示 Parallel::getMaxWorkers()
+     */
+    explicit TextureStreamer(size_t budgetBytes = 64 * 1024 * 1024, unsigned int workers = 0);
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    /**
+     * @brief 请求流式加载纹理，返回的 CTexture 在常驻尾部上传前绑定占位纹理
+     *
+     * 调用方释放返回的 CTexture 后，对应的 CPU 数据在下一次 update() 释放。
+     */
+    std::shared_ptr<CTexture> load(const std::string& path, TextureType type = TextureType::Diffuse);
+
+    /**
+     * @brief 开始一帧的使用统计
+     * @param viewportHeight 视口高度（像素）
+     */
+    void beginFrame(const glm::mat4& view, const glm::mat4& projection, float viewportHeight);
+
+    /**
+     * @brief 记录一次使用：纹理贴在世界空间包围盒为 [boundsMin, boundsMax] 的物体上
+     * @param uvScale 纹理在包围盒直径上重复的次数（平铺地面等大于 1）
+     *
+     * 同一纹理多次使用时取屏幕上最大的一次。
+     */
+    void addUsage(const std::shared_ptr<CTexture>& texture, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                  float uvScale = 1.0f);
+
+    /**
+     * @brief 每帧调用一次：取回解码结果，按本帧使用重新分配级别，释放超出的级别，在上传预算内向细级别上传
+     */
+    void update();
+
+    /**
+     * @brief 等待所有解码完成并不限上传预算地把各纹理补齐到当前分配的级别（测试、加载界面）
+     */
+    void finishAll();
+
+    void setBudget(size_t bytes) { budget_ = bytes; }
+    size_t getBudget() const { return budget_; }
+
+    // 每帧上传的字节数上限，至少上传一行以保证进度；默认 1 MB
+    void setUploadBudget(size_t bytesPerFrame) { uploadBudget_ = bytesPerFrame; }
+    size_t getUploadBudget() const { return uploadBudget_; }
+
+    // 级别偏移：正值选更粗的级别
+    void setLodBias(float bias) { lodBias_ = bias; }
+    float getLodBias() const { return lodBias_; }
+
+    // 没有解码中的纹理，且所有纹理都已驻留到分配的级别
+    bool isIdle() const;
+
+    const Stats& getStats() const { return stats_; }
+
+    // 常驻尾部：边长不超过该值的级别在解码后立即上传，不会被放弃
+    static int getTailSize() { return 64; }
+
+    /**
+     * @brief 物体在屏幕上的大小：包围球直径投影后的像素数
+     *
+     * 按到包围球的距离而不是视线深度计算，镜头转动时结果不变；相机在包围球内时返回 FLT_MAX。
+     * 支持透视与正交投影。
+     */
+    static float getScreenPixels(const glm::mat4& view, const glm::mat4& projection, float viewportHeight,
+                                 const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    /**
+     * @brief 按屏幕大小选择所需的最细级别：log2(纹理边长 / 屏幕像素) + bias，截断到 [0, levelCount - 1]
+     * @param screenPixels 0 表示未使用，返回最粗级别
+     */
+    static int selectLevel(int width, int height, int levelCount, float screenPixels, float bias);
+
+    /**
+     * @brief 在预算内分配各纹理的 targetLevel
+     *
+     * 先取 desiredLevel；总显存超出预算时反复对纹素 / 像素比最大的纹理放弃最细的一级，
+     * 直到满足预算或只剩常驻尾部。常驻尾部本身超出预算时不再放弃。
+     */
+    static void fitBudget(std::vector<Residency*>& textures, size_t budget);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Entry {
+        std::weak_ptr<CTexture> texture;
+        DecodedImage image;             // 全部级别的 CPU 数据
+        Residency residency;
+        GLuint id = 0;
+        int residentLevel = 0;          // 已驻留的最细级别（GL_TEXTURE_BASE_LEVEL）
+        int nextRow = 0;                // 正在上传 residentLevel - 1 级的下一行，0 表示还未分配该级
+        bool streaming = false;         // 有未完成的向细请求
+        Clock::time_point requestTime;
+    };
+
+    ImageDecodeQueue decoder_;
+    std::unordered_map<uint64_t, std::weak_ptr<CTexture>> waiting_;  // 解码中
+    std::unordered_map<const CTexture*, Entry> entries_;
+    std::vector<DecodedImage> decoded_;
+    size_t budget_;
+    size_t uploadBudget_;
+    float lodBias_ = 0.0f;
+    glm::mat4 view_ = glm::mat4(1.0f);
+    glm::mat4 projection_ = glm::mat4(1.0f);
+    float viewportHeight_ = 0.0f;
+    Stats stats_;
+
+    // 以下返回值均为上传的字节数
+    size_t collectDecoded();
+    size_t streamWithinBudget(size_t budget);
+    // 上传常驻尾部并替换占位纹理
+    size_t uploadTail(Entry& entry, const std::shared_ptr<CTexture>& texture);
+    size_t uploadRows(Entry& entry, int level, int rows);
+
+    void releaseExpired();
+    void assignLevels();
+    // 释放比 level 更细的级别，并放弃未完成的上传
+    void evictTo(Entry& entry, int level);
+    void updateResidentBytes(Entry& entry);
+    void updateStats();
+};
+
+#endif
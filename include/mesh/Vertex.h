@@ -52,14 +52,24 @@ enum class VertexAttribute {
     Count
 };
 
+// 属性在 GPU 缓冲区中的编码
+enum class VertexAttributeFormat {
+    Float,      // 32 位浮点
+    Half,       // 16 位浮点（GL_HALF_FLOAT）
+    Unorm16,    // 16 位无符号归一化；位置按包围盒量化，其余属性要求在 [0, 1]
+    Snorm10     // GL_INT_2_10_10_10_REV 归一化：xyz 各 10 位，w 2 位（切线存手性）
+};
+
 struct VertexAttributeLayout {
     struct Attribute {
         VertexAttribute type;
         unsigned int count;
         unsigned int offset;
+        VertexAttributeFormat format;
         
-        Attribute(VertexAttribute t, unsigned int c, unsigned int o) 
-            : type(t), count(c), offset(o) {}
+        Attribute(VertexAttribute t, unsigned int c, unsigned int o,
+                  VertexAttributeFormat f = VertexAttributeFormat::Float) 
+            : type(t), count(c), offset(o), format(f) {}
     };
     
     std::vector<Attribute> attributes;
@@ -67,9 +77,25 @@ struct VertexAttributeLayout {
     
     VertexAttributeLayout() : stride(0) {}
     
-    void addAttribute(VertexAttribute type, unsigned int count) {
-        attributes.emplace_back(type, count, stride);
-        stride += count * sizeof(float);
+    void addAttribute(VertexAttribute type, unsigned int count,
+                      VertexAttributeFormat format = VertexAttributeFormat::Float) {
+        // 10_10_10_2 固定 4 个分量
+        if (format == VertexAttributeFormat::Snorm10) count = 4;
+        attributes.emplace_back(type, count, stride, format);
+        stride += attributeBytes(count, format);
+    }
+    
+    // 属性占用的字节数，16 位格式补齐到 4 字节对齐
+    static unsigned int attributeBytes(unsigned int count, VertexAttributeFormat format) {
+        switch (format) {
+            case VertexAttributeFormat::Half:
+            case VertexAttributeFormat::Unorm16:
+                return ((count + 1) & ~1u) * 2;
+            case VertexAttributeFormat::Snorm10:
+                return 4;
+            default:
+                return count * sizeof(float);
+        }
     }
     
     // 常用布局预设
@@ -103,6 +129,24 @@ struct VertexAttributeLayout {
         layout.addAttribute(VertexAttribute::Bitangent, 3);
         return layout;
     }
+    
+    // 压缩布局：float 位置 + 10_10_10_2 法线 + half 纹理坐标，20 字节，着色器无需改动
+    static VertexAttributeLayout Compact() {
+        VertexAttributeLayout layout;
+        layout.addAttribute(VertexAttribute::Position, 3);
+        layout.addAttribute(VertexAttribute::Normal, 4, VertexAttributeFormat::Snorm10);
+        layout.addAttribute(VertexAttribute::TexCoords, 2, VertexAttributeFormat::Half);
+        return layout;
+    }
+    
+    // 量化布局：unorm16 位置（着色器按包围盒还原）+ 10_10_10_2 法线 + half 纹理坐标，16 字节
+    static VertexAttributeLayout Quantized() {
+        VertexAttributeLayout layout;
+        layout.addAttribute(VertexAttribute::Position, 3, VertexAttributeFormat::Unorm16);
+        layout.addAttribute(VertexAttribute::Normal, 4, VertexAttributeFormat::Snorm10);
+        layout.addAttribute(VertexAttribute::TexCoords, 2, VertexAttributeFormat::Half);
+        return layout;
+    }
 };
 
 #endif
\ No newline at end of file
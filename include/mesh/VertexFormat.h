@@ -0,0 +1,149 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <cstddef>
+#include <cstring>
+#include "mesh/Vertex.h"
+
+/**
+ * @brief 按 VertexAttributeLayout 把 Vertex 数组紧排成 GPU 顶点数据
+ *
+ * Vertex 结构固定 56 字节（含切线/副切线），而常用布局只需要其中一部分：
+ * 上传时只写入布局中的属性，按布局的 stride / offset 交错排列。
+ *
+ * 常用布局（属性按枚举顺序、分量数与 Vertex 成员一致）由 Format<Mask> 模板生成
+ * 专门的打包循环，属性判断在编译期消除；其它自定义布局走逐属性的通用路径。
+ *
+ * 带压缩编码的布局（Half / Unorm16 / Snorm10）按属性逐列调用 MeshKernels 的 SIMD 编码内核。
+ * unorm16 位置相对包围盒量化，着色器用 PositionRange 还原：position = bias + q * scale。
+ */
+namespace VertexFormat {
+
+// 属性位，与 VertexAttribute 枚举一一对应
+const unsigned PositionBit  = 1u << static_cast<unsigned>(VertexAttribute::Position);
+const unsigned NormalBit    = 1u << static_cast<unsigned>(VertexAttribute::Normal);
+const unsigned TexCoordsBit = 1u << static_cast<unsigned>(VertexAttribute::TexCoords);
+const unsigned TangentBit   = 1u << static_cast<unsigned>(VertexAttribute::Tangent);
+const unsigned BitangentBit = 1u << static_cast<unsigned>(VertexAttribute::Bitangent);
+
+template <unsigned Mask>
+struct Format {
+    static const size_t stride =
+        ((Mask & PositionBit)  ? sizeof(glm::vec3) : 0) +
+        ((Mask & NormalBit)    ? sizeof(glm::vec3) : 0) +
+        ((Mask & TexCoordsBit) ? sizeof(glm::vec2) : 0) +
+        ((Mask & TangentBit)   ? sizeof(glm::vec3) : 0) +
+        ((Mask & BitangentBit) ? sizeof(glm::vec3) : 0);
+
+    static void pack(const Vertex* src, size_t count, unsigned char* dst) {
+        for (size_t i = 0; i < count; ++i) {
+            const Vertex& v = src[i];
+            unsigned char* out = dst + i * stride;
+            if (Mask & PositionBit)  { std::memcpy(out, &v.position, sizeof(glm::vec3));  out += sizeof(glm::vec3); }
+            if (Mask & NormalBit)    { std::memcpy(out, &v.normal, sizeof(glm::vec3));    out += sizeof(glm::vec3); }
+            if (Mask & TexCoordsBit) { std::memcpy(out, &v.texCoords, sizeof(glm::vec2)); out += sizeof(glm::vec2); }
+            if (Mask & TangentBit)   { std::memcpy(out, &v.tangent, sizeof(glm::vec3));   out += sizeof(glm::vec3); }
+            if (Mask & BitangentBit) { std::memcpy(out, &v.bitangent, sizeof(glm::vec3)); }
+        }
+    }
+};
+
+template <unsigned Mask>
+const size_t Format<Mask>::stride;
+
+typedef Format<PositionBit> PositionOnly;
+typedef Format<PositionBit | NormalBit> PositionNormal;
+typedef Format<PositionBit | NormalBit | TexCoordsBit> PositionNormalTex;
+typedef Format<PositionBit | NormalBit | TexCoordsBit | TangentBit | BitangentBit> Full;
+
+static_assert(PositionNormalTex::stride == 32, "PositionNormalTex should pack to 32 bytes");
+static_assert(Full::stride == sizeof(Vertex), "Full layout should match the Vertex struct");
+
+/**
+ * @brief unorm16 位置的还原参数：position = bias + q * scale，q 在 [0, 1]
+ */
+struct PositionRange {
+    glm::vec3 bias;
+    glm::vec3 scale;
+
+    PositionRange() : bias(0.0f), scale(1.0f) {}
+    PositionRange(const glm::vec3& b, const glm::vec3& s) : bias(b), scale(s) {}
+};
+
+/**
+ * @brief 与 float 原始数据相比的编码误差
+ */
+struct ErrorReport {
+    size_t bytesPerVertex = 0;
+    float maxPositionError = 0.0f;          // 模型空间距离
+    float maxNormalErrorDegrees = 0.0f;
+    float maxTangentErrorDegrees = 0.0f;
+    float maxTexCoordError = 0.0f;
+    size_t handednessMismatches = 0;        // 切线 w 与原始 TBN 手性不符的顶点数
+};
+
+/**
+ * @brief 布局中是否有非 Float 编码的属性
+ */
+bool isQuantized(const VertexAttributeLayout& layout);
+
+/**
+ * @brief 位置是否以 unorm16 编码（需要着色器按 PositionRange 还原）
+ */
+bool hasQuantizedPositions(const VertexAttributeLayout& layout);
+
+/**
+ * @brief 以顶点包围盒作为量化范围；count 为 0 时返回默认值
+ */
+PositionRange computePositionRange(const Vertex* src, size_t count);
+
+/**
+ * @brief 布局是否为常用形式（Float 编码，属性按枚举顺序、分量数与 Vertex 成员一致且紧密排列）
+ * @return 属性位掩码，不是常用形式时返回 0
+ */
+unsigned getCanonicalMask(const VertexAttributeLayout& layout);
+
+/**
+ * @brief 两个布局打包出的数据格式相同（属性、分量数、编码、偏移与 stride 一致）
+ */
+bool sameFormat(const VertexAttributeLayout& a, const VertexAttributeLayout& b);
+
+/**
+ * @brief 布局的内存排列与 Vertex 结构完全相同，可以直接上传原数组
+ */
+bool matchesVertex(const VertexAttributeLayout& layout);
+
+/**
+ * @brief 只含位置属性的布局，分量数与编码沿用 layout 中的位置；layout 没有位置时返回 float3
+ */
+VertexAttributeLayout getPositionLayout(const VertexAttributeLayout& layout);
+
+/**
+ * @brief 按布局紧排 count 个顶点到 dst（至少 count * layout.stride 字节）
+ *
+ * 常用布局分派到 Format<Mask>::pack，带压缩编码的布局使用 SIMD 编码内核，其余使用 packGeneric。
+ * @param range unorm16 位置的量化范围，超出范围的位置被截断
+ */
+void pack(const VertexAttributeLayout& layout, const Vertex* src, size_t count, void* dst,
+          const PositionRange& range = PositionRange());
+
+/**
+ * @brief 逐属性复制的通用路径，只处理 Float 编码的属性；分量数超过 Vertex 成员的部分补 0
+ */
+void packGeneric(const VertexAttributeLayout& layout, const Vertex* src, size_t count, void* dst);
+
+/**
+ * @brief 编码后再解码，统计与原始 float 数据的最大误差
+ */
+ErrorReport measureError(const VertexAttributeLayout& layout, const Vertex* src, size_t count,
+                         const PositionRange& range);
+
+/**
+ * @brief 按布局设置当前 VAO 的属性指针（需要 OpenGL 上下文，并已绑定 GL_ARRAY_BUFFER）
+ * @param baseOffset 顶点数据在缓冲区中的起始字节偏移
+ */
+void setupAttributePointers(const VertexAttributeLayout& layout, size_t baseOffset);
+
+} // namespace VertexFormat
+
+#endif
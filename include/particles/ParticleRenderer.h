@@ -9,6 +9,8 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
+#include "core/StreamingBuffer.h"
 #include "particles/Particle.h"
 #include "shader/Shader.h"
 
@@ -50,6 +52,12 @@ public:
      */
     void setAdditiveBlending(bool enabled) { additiveBlending_ = enabled; }
     
+    /**
+     * @brief Stream per-instance data through a shared ring buffer instead of the private VBO
+     * @param buffer Initialized streaming buffer, or nullptr to use the private VBO
+     */
+    void setStreamingBuffer(std::shared_ptr<StreamingBuffer> buffer) { streamingBuffer_ = buffer; }
+    
 private:
     std::shared_ptr<CShader> shader_;
     unsigned int vao_;
@@ -58,6 +66,8 @@ private:
     bool hasTexture_;
     bool additiveBlending_;
     bool initialized_;
+    std::shared_ptr<StreamingBuffer> streamingBuffer_;
+    bool usingStream_;   // Instance attributes currently point into streamingBuffer_
     
     /**
      * @brief Create quad VAO for particle rendering
@@ -65,10 +75,18 @@ private:
     void createQuadVAO();
     
     /**
-     * @brief Update particle buffer data
-     * @param emitter Particle emitter
+     * @brief Point the instance attributes at a buffer range
+     * @param buffer Buffer holding the instance data
+     * @param baseOffset Byte offset of the first instance
+     */
+    void setInstanceAttributes(unsigned int buffer, size_t baseOffset);
+    
+    /**
+     * @brief Upload per-instance data for the alive particles
+     * @param particles Alive particles
+     * @return Number of instances uploaded
      */
-    void updateParticleBuffer(const ParticleEmitter& emitter);
+    size_t updateParticleBuffer(const std::vector<Particle*>& particles);
 };
 
 #endif // PARTICLE_RENDERER_H
@@ -0,0 +1,167 @@
+/**
+ * @file CubemapCache.h
+ * @brief Asynchronously decoded, cached cubemap textures
+ */
+
+#ifndef CUBEMAP_CACHE_H
+#define CUBEMAP_CACHE_H
+
+#include <glad/glad.h>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/WorkerPool.h"
+#include "lighting/SphericalHarmonics.h"
+#include "mesh/ImageKernels.h"
+
+/**
+ * @brief Cache of cubemaps keyed by name
+ *
+ * request() returns immediately; the six faces are decoded in parallel on a worker pool and a
+ * full mip chain is built on the CPU. update() (GL thread) uploads decoded faces within a
+ * per-frame byte budget into storage that is allocated once (glTexStorage2D when available),
+ * and publishes the cubemap only after every face and level is in place.
+ *
+ * A single .hdr equirectangular panorama is also accepted: it is converted to an RGB16F cubemap
+ * on a worker thread (see HdrCubemap) and the cooked result is kept in a cache directory, so
+ * later runs skip the conversion.
+ *
+ * Once all faces are decoded, the worker also projects a small mip onto L2 spherical harmonics
+ * (irradiance for ambient lighting), so the coefficients cost nothing when switching back.
+ *
+ * Each cubemap is decoded at most once: later requests for the same name hit the cache, and a
+ * cubemap whose faces are missing or mismatched is remembered as failed instead of retried.
+ * The cache owns the texture objects and deletes them when destroyed.
+ */
+class CubemapCache {
+public:
+    enum class State {
+        Missing,    // never requested
+        Pending,    // decoding or uploading
+        Ready,
+        Failed
+    };
+
+    struct Stats {
+        size_t ready = 0;
+        size_t pending = 0;
+        size_t failed = 0;
+        size_t hits = 0;                // request() calls served by an existing entry
+        size_t gpuBytes = 0;            // all ready cubemaps, including mips
+        size_t bytesThisFrame = 0;
+        double lastLoadSeconds = 0.0;   // request() to Ready for the most recent cubemap
+    };
+
+    /**
+     * @param threadCount Decode threads, 0 means Parallel::getMaxWorkers()
+     * @param uploadBudget Bytes uploaded per update() call; at least one mip level is always uploaded
+     */
+    explicit CubemapCache(unsigned int threadCount = 0, size_t uploadBudget = 4 * 1024 * 1024);
+    ~CubemapCache();
+
+    CubemapCache(const CubemapCache&) = delete;
+    CubemapCache& operator=(const CubemapCache&) = delete;
+
+    /**
+     * @brief Start loading a cubemap unless it is already cached, pending or failed
+     * @param faces 6 face images (right, left, top, bottom, back, front), or one .hdr panorama
+     * @return State after the call; Failed immediately if faces holds neither
+     */
+    State request(const std::string& name, const std::vector<std::string>& faces);
+
+    State getState(const std::string& name) const;
+
+    // Texture ID of a ready cubemap, 0 otherwise
+    GLuint getTexture(const std::string& name) const;
+
+    // Whether a ready cubemap holds linear HDR data that needs tone mapping
+    bool isHdr(const std::string& name) const;
+
+    /**
+     * @brief Irradiance of a ready cubemap (see SphericalHarmonics::convolveIrradiance)
+     * @return false if the cubemap is not ready
+     */
+    bool getIrradiance(const std::string& name, SHCoefficients& out) const;
+
+    /**
+     * @brief Upload decoded faces within the budget (GL thread)
+     * @return Number of cubemaps that became Ready or Failed during this call
+     */
+    size_t update();
+
+    // Wait for every pending decode and upload it all (blocking; used by synchronous loads)
+    void finishAll();
+
+    void setUploadBudget(size_t bytes) { uploadBudget_ = bytes; }
+    size_t getUploadBudget() const { return uploadBudget_; }
+
+    // Directory for cooked HDR cubemaps; empty disables the disk cache. Set before requesting.
+    void setHdrCacheDirectory(const std::string& directory) { hdrCacheDirectory_ = directory; }
+    const std::string& getHdrCacheDirectory() const { return hdrCacheDirectory_; }
+
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct Face {
+        bool decoded = false;
+        int channels = 0;          // upload channels (RGB expanded to RGBA)
+        GLenum internalFormat = GL_RGBA8;
+        GLenum format = GL_RGBA;
+        GLenum type = GL_UNSIGNED_BYTE;
+        std::vector<ImageLevel> levels;
+    };
+
+    struct Job {
+        std::string name;
+        std::vector<std::string> paths;
+        Face faces[6];
+        bool hdr = false;
+        bool valid = false;        // set by the last decode task
+        SHCoefficients irradiance;
+        int remaining = 6;         // tasks still decoding, guarded by mutex_
+        std::chrono::steady_clock::time_point start;
+    };
+
+    struct Upload {
+        std::shared_ptr<Job> job;
+        GLuint id = 0;
+        int face = 0;
+        size_t level = 0;
+    };
+
+    struct Entry {
+        State state = State::Pending;
+        GLuint texture = 0;
+        size_t bytes = 0;
+        bool hdr = false;
+        SHCoefficients irradiance;
+    };
+
+    std::map<std::string, Entry> entries_;
+    std::deque<Upload> uploads_;
+    size_t uploadBudget_;
+    std::string hdrCacheDirectory_;
+    Stats stats_;
+
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<Job>> decoded_;    // all faces decoded, guarded by mutex_
+
+    // Declared last so worker threads stop before the state they write to is destroyed
+    WorkerPool pool_;
+
+    void decodeFace(const std::shared_ptr<Job>& job, int face);
+    void decodePanorama(const std::shared_ptr<Job>& job);
+    void completeTask(const std::shared_ptr<Job>& job);
+    bool validate(const Job& job) const;
+    static SHCoefficients projectIrradiance(const Job& job);
+    void allocateStorage(Upload& upload);
+    void finish(Upload& upload);
+    void fail(const std::string& name);
+    void updateCounts();
+};
+
+#endif // CUBEMAP_CACHE_H
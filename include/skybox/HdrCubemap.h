@@ -0,0 +1,91 @@
+/**
+ * @file HdrCubemap.h
+ * @brief Equirectangular HDR panorama to cubemap conversion with an on-disk cooked cache
+ */
+
+#ifndef HDR_CUBEMAP_H
+#define HDR_CUBEMAP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh/ImageKernels.h"
+
+/**
+ * @brief Cubemap with half-float RGB texels (GL_RGB16F, 6 bytes per texel)
+ *
+ * faces[i] holds the mip chain of face GL_TEXTURE_CUBE_MAP_POSITIVE_X + i; rows are stored
+ * top to bottom in upload order, like the LDR face images.
+ */
+struct HdrCubemapImage {
+    static const size_t BytesPerTexel = 6;
+
+    std::vector<ImageLevel> faces[6];
+
+    bool empty() const { return faces[0].empty(); }
+    int getSize() const { return empty() ? 0 : faces[0][0].width; }
+    size_t getLevelCount() const { return faces[0].size(); }
+    size_t getByteSize() const;
+};
+
+/**
+ * @brief Pure CPU conversion; safe to call from worker threads
+ *
+ * The panorama is sampled bilinearly (wrapping horizontally, clamped at the poles) for the
+ * centre of every face texel. Faces and rows are spread over Parallel::forRange. Mips are 2x2
+ * box averages of the linear float data, so no energy is lost to gamma. Values are clamped to
+ * the half-float range before conversion.
+ */
+namespace HdrCubemap {
+
+// Extension .hdr (case-insensitive)
+bool isHdrPath(const std::string& path);
+
+// Face edge for a panorama of the given width: width / 4, at least 1
+int getDefaultFaceSize(int panoramaWidth);
+
+/**
+ * @brief Unit direction through face texel coordinates (s, t) in [-1, 1]
+ *
+ * Follows the OpenGL cubemap face convention; t = -1 is the first (top) row of the face.
+ */
+glm::vec3 getFaceDirection(int face, float s, float t);
+
+/**
+ * @brief Bilinear sample of an equirectangular panorama in direction dir (need not be normalized)
+ *
+ * +Y is up; u = 0.5 + atan2(z, x) / 2pi, v = acos(y) / pi with v = 0 at the first row.
+ */
+glm::vec3 sampleEquirect(const float* pixels, int width, int height, int channels, const glm::vec3& dir);
+
+/**
+ * @brief Resample a linear float panorama (3 or 4 channels) into six faceSize^2 RGB float faces
+ */
+void convertEquirect(const float* pixels, int width, int height, int channels, int faceSize,
+                     std::vector<float> faces[6]);
+
+/**
+ * @brief Build the half-float mip chain from level-0 RGB float faces
+ */
+void buildMipChain(const std::vector<float> faces[6], int faceSize, HdrCubemapImage& out);
+
+// Cooked cubemap file: "HDRCUBE1", face size, level count, then every face's levels in order
+bool save(const std::string& path, const HdrCubemapImage& image);
+bool load(const std::string& path, HdrCubemapImage& image);
+
+/**
+ * @brief Load an .hdr panorama as a cubemap, reusing the cooked cache when possible
+ *
+ * The cache file name combines the source file name with a hash of its contents, the face size
+ * and the converter version, so edited panoramas are converted again. An empty cacheDirectory
+ * disables the cache; write failures do not affect the result.
+ * @param faceSize Face edge, 0 means getDefaultFaceSize()
+ * @param fromCache Set to whether the result came from the cache (may be nullptr)
+ */
+bool loadOrConvert(const std::string& path, const std::string& cacheDirectory, int faceSize,
+                   HdrCubemapImage& out, bool* fromCache = nullptr, std::string* error = nullptr);
+
+} // namespace HdrCubemap
+
+#endif // HDR_CUBEMAP_H
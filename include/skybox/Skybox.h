@@ -8,14 +8,21 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <memory>
 #include <string>
 #include <vector>
+#include "skybox/CubemapCache.h"
+
+class CShader;
 
 /**
  * @brief Skybox class
  * 
  * Renders a skybox using cubemap texture.
  * The skybox is always rendered at maximum depth (far plane).
+ *
+ * Cubemaps come from a CubemapCache owned by the skybox: switching back to a preset reuses its
+ * texture, and a new preset keeps the current cubemap on screen until it is fully uploaded.
  */
 class Skybox {
 public:
@@ -33,12 +40,41 @@ public:
     bool initialize();
     
     /**
-     * @brief Load skybox from cubemap faces
-     * @param faces Array of 6 cubemap face textures (right, left, top, bottom, back, front)
+     * @brief Load skybox from cubemap faces and wait for it (blocking)
+     * @param faces Array of 6 cubemap face textures (right, left, top, bottom, back, front),
+     *              or a single .hdr equirectangular panorama
      * @return true if successful
      */
     bool loadCubemap(const std::vector<std::string>& faces);
     
+    /**
+     * @brief Switch to a named cubemap without blocking
+     *
+     * Cached cubemaps switch immediately; otherwise the faces are decoded in the background and
+     * update() switches once they are uploaded. If loading fails the current cubemap stays.
+     * @param faces Array of 6 cubemap face textures (right, left, top, bottom, back, front),
+     *              or a single .hdr equirectangular panorama (converted once, then cooked to disk)
+     */
+    void requestCubemap(const std::string& name, const std::vector<std::string>& faces);
+    
+    /**
+     * @brief Upload pending cubemap data and switch when ready (call once per frame)
+     */
+    void update();
+    
+    const std::string& getCurrentName() const { return currentName_; }
+    bool isSwitchPending() const { return !pendingName_.empty(); }
+    const CubemapCache& getCache() const { return cache_; }
+    
+    /**
+     * @brief Ambient irradiance of the current cubemap as L2 spherical harmonics
+     *
+     * Computed once per cubemap when it is decoded; compare getCurrentName() to know when the
+     * lighting needs the new coefficients.
+     * @return false while no cubemap is shown
+     */
+    bool getIrradiance(SHCoefficients& out) const { return cache_.getIrradiance(currentName_, out); }
+    
     /**
      * @brief Render skybox
      * @param view View matrix
@@ -68,15 +104,26 @@ public:
     
     glm::vec2 getRotation() const { return glm::vec2(yaw_, pitch_); }
     
+    /**
+     * @brief Exposure used to tone map HDR cubemaps (ignored for LDR faces)
+     */
+    void setExposure(float exposure) { exposure_ = exposure; }
+    float getExposure() const { return exposure_; }
+    
 private:
     unsigned int vao_;
     unsigned int vbo_;
-    unsigned int cubemapTexture_;
+    unsigned int cubemapTexture_;   // owned by cache_
+    std::unique_ptr<CShader> shader_;
+    CubemapCache cache_;
+    std::string currentName_;
+    std::string pendingName_;
     bool enabled_;
     
     // Rotation for day/night cycle
     float yaw_;
     float pitch_;
+    float exposure_;
     
     /**
      * @brief Create skybox VAO/VBO
@@ -95,6 +142,7 @@ namespace SkyboxPresets {
     std::vector<std::string> createNight();
     std::vector<std::string> createSunset();
     std::vector<std::string> createCloudy();
+    std::vector<std::string> createPanorama(const std::string& path);
 }
 
 #endif // SKYBOX_H
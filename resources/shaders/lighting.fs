@@ -7,6 +7,7 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
 in vec4 FragPosLightSpace;  // For shadow calculation
+flat in int TextureLayer;
 
 // Material properties
 struct Material {
@@ -39,6 +40,10 @@ uniform int numLights;
 uniform vec3 viewPos;
 uniform vec3 ambientColor;
 
+// Irradiance / pi of the environment as L2 spherical harmonics (see SphericalHarmonics.h)
+uniform vec3 ambientSH[9];
+uniform int useAmbientSH;
+
 // Shadow mapping
 uniform sampler2D shadowMap;
 uniform mat4 lightSpaceMatrix;
@@ -51,15 +56,23 @@ uniform int pcfEnabled;
 uniform sampler2D diffuseTexture;
 uniform int hasDiffuseTexture;
 
+// Texture array shared by many materials; each draw or instance picks a layer
+// Must sit on its own texture unit: samplers of different types cannot share one
+uniform sampler2DArray diffuseArray;
+uniform int useTextureArray;
+
 vec3 calculateDirectionalLight(LightData light, vec3 normal, vec3 viewDir);
 vec3 calculatePointLight(LightData light, vec3 normal, vec3 fragPos, vec3 viewDir);
 vec3 calculateSpotLight(LightData light, vec3 normal, vec3 fragPos, vec3 viewDir);
 float calculateShadow(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir);
+vec3 evaluateAmbientSH(vec3 n);
 
 void main() {
     // Get base color from texture or material
     vec3 baseColor;
-    if (hasDiffuseTexture == 1) {
+    if (useTextureArray == 1) {
+        baseColor = texture(diffuseArray, vec3(TexCoords, float(TextureLayer))).rgb;
+    } else if (hasDiffuseTexture == 1) {
         baseColor = texture(diffuseTexture, TexCoords).rgb;
     } else {
         baseColor = material.diffuse;
@@ -69,7 +82,8 @@ void main() {
     vec3 viewDir = normalize(viewPos - FragPos);
     
     // Start with ambient
-    vec3 result = ambientColor * baseColor * material.ambient;
+    vec3 ambient = useAmbientSH == 1 ? max(evaluateAmbientSH(norm), vec3(0.0)) : ambientColor;
+    vec3 result = ambient * baseColor * material.ambient;
     
     // Add contribution from each light
     for (int i = 0; i < numLights && i < 8; i++) {
@@ -104,6 +118,18 @@ void main() {
     FragColor = vec4(result, 1.0);
 }
 
+vec3 evaluateAmbientSH(vec3 n) {
+    return ambientSH[0] * 0.282095
+         + ambientSH[1] * (0.488603 * n.y)
+         + ambientSH[2] * (0.488603 * n.z)
+         + ambientSH[3] * (0.488603 * n.x)
+         + ambientSH[4] * (1.092548 * n.x * n.y)
+         + ambientSH[5] * (1.092548 * n.y * n.z)
+         + ambientSH[6] * (0.315392 * (3.0 * n.z * n.z - 1.0))
+         + ambientSH[7] * (1.092548 * n.x * n.z)
+         + ambientSH[8] * (0.546274 * (n.x * n.x - n.y * n.y));
+}
+
 vec3 calculateDirectionalLight(LightData light, vec3 normal, vec3 viewDir) {
     vec3 lightDir = normalize(-light.direction);
     
@@ -4,22 +4,36 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+// Texture array layer: per-instance attribute, or the current attribute value set per draw; see TextureArrayPool
+layout (location = 5) in float aTextureLayer;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 out vec4 FragPosLightSpace;  // Position in light space for shadow calculation
+flat out int TextureLayer;
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 uniform mat4 lightSpaceMatrix;  // For shadow mapping
 
+// Quantized (unorm16) positions are restored against the mesh bounds; see CMesh::applyPositionDequantization
+uniform bool positionQuantized;
+uniform vec3 positionScale;
+uniform vec3 positionBias;
+
+// Texture atlas sub-rectangle: uv * uvTransform.xy + uvTransform.zw; see CMaterial::setUVTransform
+uniform bool uvTransformEnabled;
+uniform vec4 uvTransform;
+
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    vec3 position = positionQuantized ? positionBias + aPos * positionScale : aPos;
+    FragPos = vec3(model * vec4(position, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
-    TexCoords = aTexCoords;
+    TexCoords = uvTransformEnabled ? aTexCoords * uvTransform.xy + uvTransform.zw : aTexCoords;
     FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
+    TextureLayer = int(aTextureLayer + 0.5);
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
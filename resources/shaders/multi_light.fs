@@ -92,7 +92,10 @@ void main() {
     vec3 normal = normalize(Normal);
     if (hasNormalTexture) {
         // 从法线贴图读取法线（从切线空间转换到世界空间）
-        vec3 tangentNormal = texture(normalTexture, TexCoord).rgb * 2.0 - 1.0;
+        // 由 xy 重建 z，双通道（BC5）法线贴图同样适用
+        vec3 tangentNormal;
+        tangentNormal.xy = texture(normalTexture, TexCoord).rg * 2.0 - 1.0;
+        tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
         // TODO: 需要计算 TBN 矩阵进行变换
         // 目前直接使用顶点法线
         normal = normalize(Normal);
@@ -11,10 +11,20 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+// Quantized (unorm16) positions are restored against the mesh bounds; see CMesh::applyPositionDequantization
+uniform bool positionQuantized;
+uniform vec3 positionScale;
+uniform vec3 positionBias;
+
+// Texture atlas sub-rectangle: uv * uvTransform.xy + uvTransform.zw; see CMaterial::setUVTransform
+uniform bool uvTransformEnabled;
+uniform vec4 uvTransform;
+
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    vec3 position = positionQuantized ? positionBias + aPos * positionScale : aPos;
+    FragPos = vec3(model * vec4(position, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
-    TexCoord = aTexCoord;
+    TexCoord = uvTransformEnabled ? aTexCoord * uvTransform.xy + uvTransform.zw : aTexCoord;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
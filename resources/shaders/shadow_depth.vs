@@ -1,4 +1,5 @@
 #version 330 core
+#extension GL_ARB_shader_draw_parameters : enable
 // Shadow mapping - depth pass vertex shader
 
 layout (location = 0) in vec3 aPos;
@@ -6,6 +7,21 @@ layout (location = 0) in vec3 aPos;
 uniform mat4 lightSpaceMatrix;
 uniform mat4 model;
 
+// Batched draws (CMesh::drawPositionsOnlyMulti) pick their model matrix by draw index
+const int MAX_BATCH_DRAWS = 16;
+uniform bool batched;
+uniform mat4 models[MAX_BATCH_DRAWS];
+
+// Quantized (unorm16) positions are restored against the mesh bounds; see CMesh::applyPositionDequantization
+uniform bool positionQuantized;
+uniform vec3 positionScale;
+uniform vec3 positionBias;
+
 void main() {
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    vec3 position = positionQuantized ? positionBias + aPos * positionScale : aPos;
+    mat4 world = model;
+#ifdef GL_ARB_shader_draw_parameters
+    if (batched) world = models[gl_DrawIDARB];
+#endif
+    gl_Position = lightSpaceMatrix * world * vec4(position, 1.0);
 }
@@ -7,6 +7,15 @@ in vec3 TexCoords;
 
 uniform samplerCube skybox;
 
+// HDR cubemaps hold linear radiance: tone map and gamma encode for the LDR framebuffer
+uniform bool hdr;
+uniform float exposure;
+
 void main() {
-    FragColor = texture(skybox, TexCoords);
+    vec4 color = texture(skybox, TexCoords);
+    if (hdr) {
+        vec3 mapped = vec3(1.0) - exp(-color.rgb * exposure);
+        color = vec4(pow(mapped, vec3(1.0 / 2.2)), 1.0);
+    }
+    FragColor = color;
 }
@@ -1,7 +1,40 @@
 #include "core/Application.h"
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
+#include "mesh/MeshKernels.h"
 #include "mesh/ModelLoader.h"
+#include "mesh/PrimitiveTables.h"
+#include "mesh/TextureArrayPool.h"
+#include "mesh/VertexFormat.h"
+
+namespace {
+
+// 场景中旋转立方体的摆放（位置、旋转速度、无光照模式下的颜色）
+struct CubeInfo {
+    glm::vec3 position;
+    float rotationSpeed;
+    glm::vec3 color;
+};
+
+const CubeInfo kSceneCubes[] = {
+    { glm::vec3( 0.0f,  0.0f,  0.0f), 0.3f, glm::vec3(1.0f, 1.0f, 1.0f) },
+    { glm::vec3( 2.0f,  0.0f, -1.0f), 0.5f, glm::vec3(1.0f, 0.8f, 0.8f) },
+    { glm::vec3(-2.0f,  0.0f, -1.0f), 0.2f, glm::vec3(0.8f, 1.0f, 0.8f) },
+    { glm::vec3( 0.0f,  1.5f, -2.0f), 0.4f, glm::vec3(0.8f, 0.8f, 1.0f) }
+};
+
+const glm::vec3 kGroundColor(0.4f, 0.4f, 0.4f);
+
+// 被准星选中的对象不贴纹理，漫反射颜色乘以该系数
+const glm::vec3 kPickedTint(1.5f, 1.3f, 0.6f);
+
+// 阴影 pass 一次 multi-draw 最多合并的对象数，与 shadow_depth.vs 的 MAX_BATCH_DRAWS 一致
+const size_t kMaxShadowBatch = 16;
+
+// GeometryArena 碎片率超过该值时紧排
+const float kArenaDefragmentThreshold = 0.5f;
+
+} // namespace
 
 Application::Application(const AppConfig& config)
     : config(config),
@@ -19,6 +52,8 @@ Application::~Application() {
 }
 
 bool Application::initialize() {
+    startTime_ = std::chrono::steady_clock::now();
+
     if (!initWindow()) {
         return false;
     }
@@ -67,6 +102,8 @@ bool Application::initOpenGL() {
     }
 
     glEnable(GL_DEPTH_TEST);
+    // Shadow pass batches objects into one multi-draw when the shader can read gl_DrawIDARB
+    shadowMultiDraw_ = glfwExtensionSupported("GL_ARB_shader_draw_parameters") == GLFW_TRUE;
     return true;
 }
 
@@ -112,6 +149,18 @@ void Application::initScene() {
         std::cerr << "Failed to initialize shadow mapper" << std::endl;
     }
 
+    // Shared per-frame ring for streamed vertex / instance / uniform data
+    streamingBuffer_ = std::make_shared<StreamingBuffer>();
+    if (!streamingBuffer_->initialize()) {
+        std::cerr << "Failed to initialize streaming buffer" << std::endl;
+        streamingBuffer_.reset();
+    }
+
+    geometryArena_ = std::make_shared<GeometryArena>();
+
+    // 纹理上传与流式数据共用同一个环形缓冲区
+    textureLoader_ = std::make_unique<AsyncTextureLoader>(streamingBuffer_);
+
     // Initialize lights
     initLights();
     
@@ -127,67 +176,58 @@ void Application::initScene() {
     material->setColors(glm::vec3(1.0f), glm::vec3(0.5f), glm::vec3(0.1f));
     material->setProperties(32.0f, 0.5f);
 
-    // 加载纹理
-    try {
-        diffuseTexture = std::make_shared<CTexture>(
-            "resources/textures/container2.png",
-            TextureType::Diffuse
-        );
+    // 加载纹理：异步模式下立即得到占位纹理，首帧不等待解码
+    if (config.compressTextures) {
+        CTexture::CompressionSettings compression;
+        compression.enabled = true;
+        CTexture::setCompressionSettings(compression);
+    }
+    if (config.textureBudgetMB > 0) {
+        // 先上传粗级别，细级别按屏幕占用在预算内流式加载
+        textureStreamer_ = std::make_unique<TextureStreamer>(config.textureBudgetMB * 1024 * 1024);
+        diffuseTexture = textureStreamer_->load("resources/textures/container2.png", TextureType::Diffuse);
+    } else {
+        diffuseTexture = textureLoader_->load("resources/textures/container2.png", TextureType::Diffuse);
+    }
+    if (!config.asyncTextureLoading) {
+        textureLoader_->finishAll();
+        if (textureStreamer_) {
+            textureStreamer_->finishAll();
+        }
         std::cout << "Loaded diffuse texture: "
                   << diffuseTexture->width << "x" << diffuseTexture->height
                   << std::endl;
-    } catch (const std::exception& e) {
-        std::cerr << "Texture load error: " << e.what() << std::endl;
-    }
-
-    // 创建带纹理坐标的立方体
-    std::vector<Vertex> cubeVertices = {
-        // 前面
-        Vertex(glm::vec3(-0.5f, -0.5f,  0.5f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 0.0f)),
-        Vertex(glm::vec3( 0.5f, -0.5f,  0.5f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 0.0f)),
-        Vertex(glm::vec3( 0.5f,  0.5f,  0.5f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 1.0f)),
-        Vertex(glm::vec3(-0.5f,  0.5f,  0.5f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 1.0f)),
-        // 后面
-        Vertex(glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec2(1.0f, 0.0f)),
-        Vertex(glm::vec3(-0.5f,  0.5f, -0.5f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec2(1.0f, 1.0f)),
-        Vertex(glm::vec3( 0.5f,  0.5f, -0.5f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec2(0.0f, 1.0f)),
-        Vertex(glm::vec3( 0.5f, -0.5f, -0.5f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec2(0.0f, 0.0f)),
-        // 顶面
-        Vertex(glm::vec3(-0.5f,  0.5f, -0.5f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f, 1.0f)),
-        Vertex(glm::vec3(-0.5f,  0.5f,  0.5f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f, 0.0f)),
-        Vertex(glm::vec3( 0.5f,  0.5f,  0.5f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(1.0f, 0.0f)),
-        Vertex(glm::vec3( 0.5f,  0.5f, -0.5f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(1.0f, 1.0f)),
-        // 底面
-        Vertex(glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.0f, 0.0f)),
-        Vertex(glm::vec3( 0.5f, -0.5f, -0.5f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(1.0f, 0.0f)),
-        Vertex(glm::vec3( 0.5f, -0.5f,  0.5f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(1.0f, 1.0f)),
-        Vertex(glm::vec3(-0.5f, -0.5f,  0.5f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.0f, 1.0f)),
-        // 右面
-        Vertex(glm::vec3( 0.5f, -0.5f, -0.5f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(1.0f, 0.0f)),
-        Vertex(glm::vec3( 0.5f,  0.5f, -0.5f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(1.0f, 1.0f)),
-        Vertex(glm::vec3( 0.5f,  0.5f,  0.5f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(0.0f, 1.0f)),
-        Vertex(glm::vec3( 0.5f, -0.5f,  0.5f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(0.0f, 0.0f)),
-        // 左面
-        Vertex(glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec2(0.0f, 0.0f)),
-        Vertex(glm::vec3(-0.5f, -0.5f,  0.5f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec2(1.0f, 0.0f)),
-        Vertex(glm::vec3(-0.5f,  0.5f,  0.5f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec2(1.0f, 1.0f)),
-        Vertex(glm::vec3(-0.5f,  0.5f, -0.5f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec2(0.0f, 1.0f))
-    };
+    }
 
-    std::vector<unsigned int> cubeIndices = {
-        0, 1, 2, 2, 3, 0,       // 前
-        4, 5, 6, 6, 7, 4,       // 后
-        8, 9, 10, 10, 11, 8,    // 顶
-        12, 13, 14, 14, 15, 12, // 底
-        16, 17, 18, 18, 19, 16, // 右
-        20, 21, 22, 22, 23, 20  // 左
-    };
+    // 创建带纹理坐标的立方体：顶点来自编译期生成的静态表（与 MeshUtils::createCube 同一份数据）
+    // 静态网格要量化打包并另存位置流，需要 CPU 端数组，这里展开成 Vertex
+    std::vector<Vertex> cubeVertices;
+    std::vector<unsigned int> cubeIndices;
+    PrimitiveTables::copyTo(PrimitiveTables::cube(), 1.0f, cubeVertices, cubeIndices);
+
+    // 静态网格使用量化布局（16 字节/顶点），上传前统计与 float 数据的误差
+    const VertexAttributeLayout staticLayout = VertexAttributeLayout::Quantized();
+    VertexFormat::ErrorReport cubeError = VertexFormat::measureError(
+        staticLayout, cubeVertices.data(), cubeVertices.size(),
+        VertexFormat::computePositionRange(cubeVertices.data(), cubeVertices.size()));
 
-    texturedCube = std::make_shared<CMesh>(cubeVertices, cubeIndices);
+    texturedCube = std::make_shared<CMesh>(std::move(cubeVertices), std::move(cubeIndices));
     texturedCube->setMaterial(material);
+    texturedCube->setVertexLayout(staticLayout);
+    texturedCube->setGeometryArena(geometryArena_);
+    // 阴影 pass 只读位置，另存一份位置流，需在释放 CPU 数据前开启
+    texturedCube->setPositionStreamEnabled(true);
+    // 拾取用的 BVH 需要 CPU 端三角形，在释放前构建
+    std::shared_ptr<MeshBVH> cubeBVH = MeshBVH::fromMesh(*texturedCube);
+    // 场景网格上传后不再修改，CPU 端只需保留数量与包围盒
+    texturedCube->setReleaseCpuDataAfterUpload(true);
     
-    std::cout << "Textured cube created with " << cubeVertices.size() 
-              << " vertices and " << cubeIndices.size() << " indices" << std::endl;
+    std::cout << "Textured cube created with " << texturedCube->getVertexCount() 
+              << " vertices and " << texturedCube->getIndexCount() << " indices" << std::endl;
+    std::cout << "Quantized vertices: " << cubeError.bytesPerVertex << " bytes (float " << sizeof(Vertex)
+              << "), max error position " << cubeError.maxPositionError
+              << ", normal " << cubeError.maxNormalErrorDegrees << " deg"
+              << ", uv " << cubeError.maxTexCoordError << std::endl;
 
     // 创建简单三角形（无纹理）
     std::vector<Vertex> triangleVertices = {
@@ -201,8 +241,95 @@ void Application::initScene() {
                glm::vec3(0.0f, 0.0f, 1.0f),
                glm::vec2(1.0f, 0.0f))
     };
-    triangleMesh = std::make_shared<CMesh>(triangleVertices);
+    triangleMesh = std::make_shared<CMesh>(std::move(triangleVertices));
     triangleMesh->setMaterial(material);
+    triangleMesh->setVertexLayout(staticLayout);
+    triangleMesh->setGeometryArena(geometryArena_);
+    triangleMesh->setPositionStreamEnabled(true);
+    triangleMesh->setReleaseCpuDataAfterUpload(true);
+
+    // 场景对象：4 个旋转立方体 + 压扁的立方体作为地面，变换在 updateScene() 中每帧更新
+    for (const auto& cube : kSceneCubes) {
+        SceneObject object;
+        object.mesh = texturedCube;
+        object.color = cube.color;
+        object.textured = true;
+        object.bvh = cubeBVH;
+        sceneObjects_.push_back(object);
+    }
+    SceneObject ground;
+    ground.mesh = texturedCube;
+    ground.color = kGroundColor;
+    ground.textured = false;
+    ground.bvh = cubeBVH;
+    ground.model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.5f, 0.0f));
+    ground.model = glm::scale(ground.model, glm::vec3(10.0f, 0.1f, 10.0f));
+    sceneObjects_.push_back(ground);
+
+    updateScene();
+    
+    std::cout << "CPU geometry released after upload: " << CMesh::getTotalReleasedCpuBytes()
+              << " bytes" << std::endl;
+}
+
+void Application::updateScene() {
+    float currentTime = isPaused ? pausedTime : (float)glfwGetTime();
+
+    size_t cubeCount = sizeof(kSceneCubes) / sizeof(kSceneCubes[0]);
+    for (size_t i = 0; i < cubeCount && i < sceneObjects_.size(); ++i) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), kSceneCubes[i].position);
+        sceneObjects_[i].model = glm::rotate(model, currentTime * kSceneCubes[i].rotationSpeed,
+                                             glm::vec3(0.5f, 1.0f, 0.3f));
+    }
+
+    // 世界空间包围盒：每个对象的局部 AABB 经模型矩阵变换后合并
+    bool hasBounds = false;
+    for (auto& object : sceneObjects_) {
+        if (!object.mesh) continue;
+        const CMesh::BoundingBox& local = object.mesh->getBoundingBox();
+        if (!local.isValid) continue;
+
+        MeshKernels::transformAABB(local.min, local.max, object.model, object.worldMin, object.worldMax);
+        if (!hasBounds) {
+            sceneBoundsMin_ = object.worldMin;
+            sceneBoundsMax_ = object.worldMax;
+            hasBounds = true;
+        } else {
+            sceneBoundsMin_ = glm::min(sceneBoundsMin_, object.worldMin);
+            sceneBoundsMax_ = glm::max(sceneBoundsMax_, object.worldMax);
+        }
+    }
+    if (!hasBounds) {
+        sceneBoundsMin_ = sceneBoundsMax_ = glm::vec3(0.0f);
+    }
+
+    // 每帧拾取一次：物体旋转和视角变化（鼠标、自动旋转）都会改变准星下的对象
+    pickAtCrosshair();
+}
+
+void Application::updateTextureStreaming() {
+    textureStreamer_->beginFrame(camera.getViewMatrix(), camera.getProjectionMatrix(config.width, config.height),
+                                 static_cast<float>(config.height));
+    for (const auto& object : sceneObjects_) {
+        if (object.textured) {
+            textureStreamer_->addUsage(diffuseTexture, object.worldMin, object.worldMax);
+        }
+    }
+    textureStreamer_->update();
+}
+
+void Application::pickAtCrosshair() {
+    std::vector<MeshBVH::Instance> instances;
+    instances.reserve(sceneObjects_.size());
+    for (const auto& object : sceneObjects_) {
+        instances.emplace_back(object.bvh.get(), object.model);
+    }
+
+    // 光标被锁定，拾取点固定在屏幕中心
+    MeshBVH::Ray ray = MeshBVH::rayFromScreen(glm::vec2(0.0f), camera.getViewMatrix(),
+                                              camera.getProjectionMatrix(config.width, config.height));
+    MeshBVH::SceneHit hit;
+    pickedObject_ = MeshBVH::raycast(instances, ray, hit) ? static_cast<int>(hit.instance) : -1;
 }
 
 void Application::run() {
@@ -215,19 +342,52 @@ void Application::run() {
         if (particleEmitter_ && particlesEnabled_) {
             particleEmitter_->update(deltaTime);
         }
-        
+
+        updateScene();
+
+        // Upload decoded textures within the per-frame budget before drawing
+        if (textureLoader_) {
+            textureLoader_->update();
+        }
+        if (textureStreamer_) {
+            updateTextureStreaming();
+        }
+        if (skybox_) {
+            skybox_->update();
+            // Ambient follows the skybox; its coefficients only change when the cubemap does
+            SHCoefficients irradiance;
+            if (skybox_->getCurrentName() != ambientSkyName_ && skybox_->getIrradiance(irradiance)) {
+                lightManager.setAmbientSH(irradiance);
+                ambientSkyName_ = skybox_->getCurrentName();
+            }
+        }
         render();
 
+        // All draws for this frame are submitted; fence the streamed ranges
+        if (streamingBuffer_) {
+            streamingBuffer_->endFrame();
+        }
+
         // FPS calculation
         frameCount++;
         fpsTimer += deltaTime;
         if (fpsTimer >= 1.0f) {
+            // Compact the geometry arena once freed ranges leave too many holes
+            if (geometryArena_ && geometryArena_->getStats().fragmentation > kArenaDefragmentThreshold) {
+                geometryArena_->defragment();
+            }
+
             currentFPS = frameCount / fpsTimer;
             float frameTime = 1000.0f / currentFPS;
             std::string title = config.title +
                 " | FPS: " + std::to_string(static_cast<int>(currentFPS)) +
                 " | Frame: " + std::to_string(static_cast<int>(frameTime)) + "ms" +
                 " | Camera: " + camera.getModeName();
+            if (textureStreamer_) {
+                const TextureStreamer::Stats& streaming = textureStreamer_->getStats();
+                title += " | Textures: " + std::to_string(streaming.residentBytes / 1024) + "/" +
+                    std::to_string(streaming.requestedBytes / 1024) + " KB";
+            }
             if (isPaused) {
                 title += " [PAUSED]";
             }
@@ -237,10 +397,46 @@ void Application::run() {
         }
 
         glfwSwapBuffers(window);
+        reportStartupTiming();
         glfwPollEvents();
     }
 }
 
+void Application::reportStartupTiming() {
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime_).count();
+
+    if (!firstFrameReported_) {
+        firstFrameReported_ = true;
+        std::cout << "Time to first frame: " << elapsedMs << " ms ("
+                  << (config.asyncTextureLoading ? "async" : "sync") << " texture loading)" << std::endl;
+    }
+
+    if (!texturesReadyReported_ && textureLoader_ && textureLoader_->isIdle()) {
+        texturesReadyReported_ = true;
+        const AsyncTextureLoader::Stats& stats = textureLoader_->getStats();
+        std::cout << "Textures ready after " << elapsedMs << " ms: " << stats.resident << " loaded, "
+                  << stats.failed << " failed, " << stats.decodeSeconds * 1000.0 << " ms decode on workers, "
+                  << stats.bytesUploaded / 1024 << " KB uploaded (" << stats.stagedChunks << " staged / "
+                  << stats.directChunks << " direct chunks), " << stats.compressed << " block-compressed, "
+                  << CTexture::getTotalGpuMemoryBytes() / 1024 << " KB texture memory" << std::endl;
+    }
+
+    // 流式纹理：每次所需级别全部驻留后输出一次（请求完成数变化时）
+    if (textureStreamer_) {
+        const TextureStreamer::Stats& stats = textureStreamer_->getStats();
+        if (stats.requestsCompleted != streamingRequestsReported_ && textureStreamer_->isIdle()) {
+            streamingRequestsReported_ = stats.requestsCompleted;
+            std::cout << "Texture streaming idle after " << elapsedMs << " ms: "
+                      << stats.residentBytes / 1024 << " KB resident / " << stats.requestedBytes / 1024
+                      << " KB requested (budget " << textureStreamer_->getBudget() / 1024 << " KB), "
+                      << stats.levelsStreamed << " levels streamed, " << stats.levelsEvicted << " evicted, latency avg "
+                      << stats.getAverageLatencySeconds() * 1000.0 << " ms / max "
+                      << stats.maxLatencySeconds * 1000.0 << " ms" << std::endl;
+        }
+    }
+}
+
 void Application::close() {
     glfwSetWindowShouldClose(window, true);
 }
@@ -527,6 +723,15 @@ void Application::setGlobalUniforms() {
     // Set ambient color
     lightingShader->setVec3("ambientColor", lightManager.getAmbientColor());
 
+    // Image-based ambient: nine SH coefficients, evaluated per pixel in place of ambientColor
+    lightingShader->setInt("useAmbientSH", lightManager.hasAmbientSH() ? 1 : 0);
+    if (lightManager.hasAmbientSH()) {
+        const SHCoefficients& sh = lightManager.getAmbientSH();
+        for (int i = 0; i < SHCoefficients::Count; ++i) {
+            lightingShader->setVec3("ambientSH[" + std::to_string(i) + "]", sh.coefficients[i]);
+        }
+    }
+
     // Set material properties
     lightingShader->setVec3("material.ambient", material->ambientColor);
     lightingShader->setVec3("material.diffuse", material->diffuseColor);
@@ -540,6 +745,9 @@ void Application::setGlobalUniforms() {
         diffuseTexture->bind(0);
         lightingShader->setInt("diffuseTexture", 0);
     }
+    // Texture arrays get their own unit (diffuse is 0, shadow map is 1) so the sampler types never share a unit
+    lightingShader->setInt("useTextureArray", 0);
+    lightingShader->setInt("diffuseArray", static_cast<int>(TextureArrayPool::TextureUnit));
 
     // Set light data
     int numLights = lightManager.getEnabledLightCount();
@@ -621,48 +829,23 @@ void Application::renderScene() {
 }
 
 void Application::renderSimpleScene() {
-    float currentTime = isPaused ? pausedTime : (float)glfwGetTime();
-
-    shader->setInt("hasDiffuseTexture", 1);
-    glActiveTexture(GL_TEXTURE0);
-    diffuseTexture->bind(0);
-
-    struct CubeInfo {
-        glm::vec3 position;
-        float rotationSpeed;
-        glm::vec3 color;
-    };
-
-    CubeInfo cubes[] = {
-        { glm::vec3( 0.0f,  0.0f,  0.0f), 0.3f, glm::vec3(1.0f, 1.0f, 1.0f) },
-        { glm::vec3( 2.0f,  0.0f, -1.0f), 0.5f, glm::vec3(1.0f, 0.8f, 0.8f) },
-        { glm::vec3(-2.0f,  0.0f, -1.0f), 0.2f, glm::vec3(0.8f, 1.0f, 0.8f) },
-        { glm::vec3( 0.0f,  1.5f, -2.0f), 0.4f, glm::vec3(0.8f, 0.8f, 1.0f) }
-    };
-
-    for (const auto& cube : cubes) {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, cube.position);
-        model = glm::rotate(model, currentTime * cube.rotationSpeed,
-                           glm::vec3(0.5f, 1.0f, 0.3f));
-        shader->setMat4("model", model);
-        shader->setVec3("materialDiffuse", cube.color);
-        texturedCube->draw();
+    for (size_t i = 0; i < sceneObjects_.size(); ++i) {
+        const SceneObject& object = sceneObjects_[i];
+        bool picked = static_cast<int>(i) == pickedObject_;
+        bool textured = object.textured && diffuseTexture && !picked;
+        shader->setInt("hasDiffuseTexture", textured ? 1 : 0);
+        if (textured) {
+            glActiveTexture(GL_TEXTURE0);
+            diffuseTexture->bind(0);
+        }
+        shader->setMat4("model", object.model);
+        shader->setVec3("materialDiffuse", picked ? object.color * kPickedTint : object.color);
+        object.mesh->applyPositionDequantization(*shader);
+        object.mesh->draw();
     }
-
-    shader->setInt("hasDiffuseTexture", 0);
-    shader->setVec3("materialDiffuse", glm::vec3(0.4f, 0.4f, 0.4f));
-
-    glm::mat4 groundModel = glm::mat4(1.0f);
-    groundModel = glm::translate(groundModel, glm::vec3(0.0f, -0.5f, 0.0f));
-    groundModel = glm::scale(groundModel, glm::vec3(10.0f, 0.1f, 10.0f));
-    shader->setMat4("model", groundModel);
-    texturedCube->draw();
 }
 
 void Application::renderLitScene() {
-    float currentTime = isPaused ? pausedTime : (float)glfwGetTime();
-
     lightingShader->use();
     
     // Debug: 检查着色器是否有效
@@ -683,38 +866,19 @@ void Application::renderLitScene() {
         lightingShader->setInt("diffuseTexture", 0);
     }
 
-    // Render cubes with lighting
-    struct CubeInfo {
-        glm::vec3 position;
-        float rotationSpeed;
-    };
-
-    CubeInfo cubes[] = {
-        { glm::vec3( 0.0f,  0.0f,  0.0f), 0.3f },
-        { glm::vec3( 2.0f,  0.0f, -1.0f), 0.5f },
-        { glm::vec3(-2.0f,  0.0f, -1.0f), 0.2f },
-        { glm::vec3( 0.0f,  1.5f, -2.0f), 0.4f }
-    };
-
-    for (const auto& cube : cubes) {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, cube.position);
-        model = glm::rotate(model, currentTime * cube.rotationSpeed,
-                           glm::vec3(0.5f, 1.0f, 0.3f));
-        lightingShader->setMat4("model", model);
-        texturedCube->draw();
+    // Render scene objects with lighting (untextured objects use their flat color)
+    for (size_t i = 0; i < sceneObjects_.size(); ++i) {
+        const SceneObject& object = sceneObjects_[i];
+        bool picked = static_cast<int>(i) == pickedObject_;
+        glm::vec3 diffuse = object.textured ? material->diffuseColor : object.color;
+        if (picked) diffuse = diffuse * kPickedTint;
+        lightingShader->setInt("hasDiffuseTexture", object.textured && hasDiffuse && !picked ? 1 : 0);
+        lightingShader->setVec3("material.diffuse", diffuse);
+        lightingShader->setMat4("model", object.model);
+        object.mesh->applyPositionDequantization(*lightingShader);
+        object.mesh->draw();
     }
 
-    // Render ground
-    lightingShader->setInt("hasDiffuseTexture", 0);
-    lightingShader->setVec3("material.diffuse", glm::vec3(0.4f, 0.4f, 0.4f));
-
-    glm::mat4 groundModel = glm::mat4(1.0f);
-    groundModel = glm::translate(groundModel, glm::vec3(0.0f, -0.5f, 0.0f));
-    groundModel = glm::scale(groundModel, glm::vec3(10.0f, 0.1f, 10.0f));
-    lightingShader->setMat4("model", groundModel);
-    texturedCube->draw();
-
     // Render skybox (render last to avoid depth test issues)
     if (skybox_ && skyboxEnabled_) {
         skybox_->render(camera.getViewMatrix(),
@@ -743,6 +907,7 @@ void Application::renderLightIndicators() {
         model = glm::scale(model, glm::vec3(0.2f));
         shader->setMat4("model", model);
         shader->setVec3("materialDiffuse", light->getColor());
+        texturedCube->applyPositionDequantization(*shader);
         texturedCube->draw();
     }
 }
@@ -757,8 +922,9 @@ void Application::renderShadowPass() {
     auto sun = dirLights[0];
     if (!sun->isEnabled()) return;
 
-    // Update light space matrix
-    shadowMapper->updateLightSpaceMatrix(sun->getDirection(), glm::vec3(0.0f, 0.0f, -1.0f));
+    // Update light space matrix, centered on the current world-space scene bounds
+    glm::vec3 sceneCenter = (sceneBoundsMin_ + sceneBoundsMax_) * 0.5f;
+    shadowMapper->updateLightSpaceMatrix(sun->getDirection(), sceneCenter);
 
     // Begin shadow pass
     shadowMapper->beginPass();
@@ -767,38 +933,34 @@ void Application::renderShadowPass() {
     shadowShader->use();
     shadowShader->setMat4("lightSpaceMatrix", shadowMapper->getLightSpaceMatrix());
 
-    // Render scene geometry (depth only)
-    float currentTime = isPaused ? pausedTime : (float)glfwGetTime();
-
-    // Render cubes
-    struct CubeInfo {
-        glm::vec3 position;
-        float rotationSpeed;
-    };
-
-    CubeInfo cubes[] = {
-        { glm::vec3( 0.0f,  0.0f,  0.0f), 0.3f },
-        { glm::vec3( 2.0f,  0.0f, -1.0f), 0.5f },
-        { glm::vec3(-2.0f,  0.0f, -1.0f), 0.2f },
-        { glm::vec3( 0.0f,  1.5f, -2.0f), 0.4f }
-    };
+    // Render scene geometry (depth only). Consecutive objects sharing a mesh go through one
+    // multi-draw on its position stream; the shader picks each model matrix by gl_DrawIDARB.
+    size_t begin = 0;
+    while (begin < sceneObjects_.size()) {
+        const CMesh& mesh = *sceneObjects_[begin].mesh;
+        size_t end = begin + 1;
+        if (shadowMultiDraw_ && mesh.hasPositionStream() && mesh.hasIndices()) {
+            while (end < sceneObjects_.size() && end - begin < kMaxShadowBatch &&
+                   sceneObjects_[end].mesh.get() == &mesh) {
+                ++end;
+            }
+        }
 
-    for (const auto& cube : cubes) {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, cube.position);
-        model = glm::rotate(model, currentTime * cube.rotationSpeed,
-                           glm::vec3(0.5f, 1.0f, 0.3f));
-        shadowShader->setMat4("model", model);
-        texturedCube->draw();
+        mesh.applyPositionDequantization(*shadowShader);
+        if (end - begin == 1) {
+            shadowShader->setMat4("model", sceneObjects_[begin].model);
+            mesh.drawPositionsOnly();
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                shadowShader->setMat4("models[" + std::to_string(i - begin) + "]", sceneObjects_[i].model);
+            }
+            shadowShader->setBool("batched", true);
+            mesh.drawPositionsOnlyMulti(static_cast<unsigned int>(end - begin));
+            shadowShader->setBool("batched", false);
+        }
+        begin = end;
     }
 
-    // Render ground
-    glm::mat4 groundModel = glm::mat4(1.0f);
-    groundModel = glm::translate(groundModel, glm::vec3(0.0f, -0.5f, 0.0f));
-    groundModel = glm::scale(groundModel, glm::vec3(10.0f, 0.1f, 10.0f));
-    shadowShader->setMat4("model", groundModel);
-    texturedCube->draw();
-
     // End shadow pass
     shadowMapper->endPass();
 }
@@ -890,6 +1052,7 @@ void Application::initParticles() {
         std::cerr << "Failed to initialize particle renderer" << std::endl;
         return;
     }
+    particleRenderer_->setStreamingBuffer(streamingBuffer_);
 
     // Initialize particle emitter with fire preset
     particleEmitter_ = std::make_unique<ParticleEmitter>(ParticlePresets::createFire());
@@ -902,11 +1065,10 @@ void Application::initSkybox() {
     skybox_ = std::make_unique<Skybox>();
     skybox_->initialize();
     
-    // Load default skybox (day)
-    auto faces = SkyboxPresets::createDay();
-    skybox_->loadCubemap(faces);
+    // Load default skybox (day) in the background; the sky appears once its faces are uploaded
+    skybox_->requestCubemap("Day", SkyboxPresets::createDay());
     
-    std::cout << "Skybox initialized (Day preset)" << std::endl;
+    std::cout << "Skybox initialized (Day preset requested)" << std::endl;
 }
 
 void Application::cycleSkyboxPreset() {
@@ -914,24 +1076,24 @@ void Application::cycleSkyboxPreset() {
     
     skyboxPreset_ = (skyboxPreset_ + 1) % 4;
     
+    // Switching is asynchronous: the current sky stays until the new one is uploaded,
+    // and presets whose faces are missing are reported once and skipped
     switch (skyboxPreset_) {
         case 0:
-            skybox_->loadCubemap(SkyboxPresets::createDay());
-            std::cout << "Skybox: Day" << std::endl;
+            skybox_->requestCubemap("Day", SkyboxPresets::createDay());
             break;
         case 1:
-            skybox_->loadCubemap(SkyboxPresets::createNight());
-            std::cout << "Skybox: Night" << std::endl;
+            skybox_->requestCubemap("Night", SkyboxPresets::createNight());
             break;
         case 2:
-            skybox_->loadCubemap(SkyboxPresets::createSunset());
-            std::cout << "Skybox: Sunset" << std::endl;
+            skybox_->requestCubemap("Sunset", SkyboxPresets::createSunset());
             break;
         case 3:
-            skybox_->loadCubemap(SkyboxPresets::createCloudy());
-            std::cout << "Skybox: Cloudy" << std::endl;
+            skybox_->requestCubemap("Cloudy", SkyboxPresets::createCloudy());
             break;
     }
+    std::cout << "Skybox: " << (skybox_->isSwitchPending() ? "loading " : "showing ")
+              << skybox_->getCurrentName() << std::endl;
 }
 
 void Application::cycleParticlePreset() {
@@ -0,0 +1,44 @@
+#include "core/GLState.h"
+
+namespace {
+
+// 缓存无效时的取值，任何真实 VAO 名字都与它不同
+const GLuint kUnknown = ~0u;
+
+GLuint g_boundVertexArray = kUnknown;
+size_t g_bindCount = 0;
+
+} // namespace
+
+void GLState::bindVertexArray(GLuint vao) {
+    if (g_boundVertexArray == vao) return;
+    glBindVertexArray(vao);
+    g_boundVertexArray = vao;
+    ++g_bindCount;
+}
+
+void GLState::deleteVertexArray(GLuint& vao) {
+    if (vao == 0) return;
+    // 删除正绑定的 VAO 时 GL 会自动绑回 0
+    if (g_boundVertexArray == vao) {
+        g_boundVertexArray = 0;
+    }
+    glDeleteVertexArrays(1, &vao);
+    vao = 0;
+}
+
+GLuint GLState::getBoundVertexArray() {
+    return g_boundVertexArray == kUnknown ? 0 : g_boundVertexArray;
+}
+
+void GLState::invalidate() {
+    g_boundVertexArray = kUnknown;
+}
+
+size_t GLState::getBindCount() {
+    return g_bindCount;
+}
+
+void GLState::resetBindCount() {
+    g_bindCount = 0;
+}
@@ -0,0 +1,58 @@
+#include "core/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+std::atomic<unsigned int> g_maxWorkersOverride(0);
+}
+
+unsigned int Parallel::getMaxWorkers() {
+    unsigned int limit = g_maxWorkersOverride.load();
+    if (limit != 0) return limit;
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1u : hw;
+}
+
+void Parallel::setMaxWorkers(unsigned int count) {
+    g_maxWorkersOverride = count;
+}
+
+unsigned int Parallel::getWorkerCount(size_t count, size_t minGrain) {
+    if (count == 0) return 1;
+    size_t grain = std::max<size_t>(minGrain, 1);
+    size_t byWork = (count + grain - 1) / grain;
+    return static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(byWork, getMaxWorkers())));
+}
+
+void Parallel::forRange(size_t count, size_t minGrain, const RangeFunction& fn) {
+    if (count == 0) return;
+
+    unsigned int workers = getWorkerCount(count, minGrain);
+    if (workers == 1) {
+        fn(0, count, 0);
+        return;
+    }
+
+    // 区间尽量均分，前 remainder 段各多一个元素
+    size_t chunk = count / workers;
+    size_t remainder = count % workers;
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+
+    size_t begin = chunk + (remainder > 0 ? 1 : 0);
+    for (unsigned int w = 1; w < workers; ++w) {
+        size_t size = chunk + (w < remainder ? 1 : 0);
+        size_t end = begin + size;
+        threads.emplace_back([&fn, begin, end, w]() { fn(begin, end, w); });
+        begin = end;
+    }
+
+    fn(0, chunk + (remainder > 0 ? 1 : 0), 0);
+
+    for (auto& t : threads) {
+        t.join();
+    }
+}
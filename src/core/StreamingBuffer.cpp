@@ -0,0 +1,253 @@
+#include "core/StreamingBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// 单次阻塞等待 fence 的超时（纳秒），超时后继续循环等待
+const GLuint64 kFenceTimeout = 1000000000ull;
+
+size_t alignUp(size_t value, size_t alignment) {
+    if (alignment <= 1) return value;
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ============================================================================
+// RingAllocator
+// ============================================================================
+
+RingAllocator::RingAllocator(size_t capacity)
+    : capacity_(capacity), head_(0), tail_(0), resetPosition_(0), frameStart_(0) {
+}
+
+bool RingAllocator::tryAllocate(size_t size, size_t alignment, size_t& outOffset, uint64_t& outPosition) {
+    if (size == 0 || size > capacity_) return false;
+
+    size_t offset = static_cast<size_t>(head_ % capacity_);
+    size_t aligned = alignUp(offset, alignment);
+    uint64_t start = head_ + (aligned - offset);
+
+    // 放不下尾部剩余空间时跳到缓冲区开头，跳过的字节也计入占用
+    if (aligned + size > capacity_) {
+        start = head_ + (capacity_ - offset);
+        aligned = 0;
+    }
+
+    uint64_t end = start + size;
+    if (end - tail_ > capacity_) return false;
+
+    head_ = end;
+    outOffset = aligned;
+    outPosition = start;
+    return true;
+}
+
+void RingAllocator::retire(uint64_t position) {
+    tail_ = std::max(tail_, std::min(position, head_));
+}
+
+void RingAllocator::reset() {
+    tail_ = head_;
+    resetPosition_ = head_;
+    frameStart_ = head_;
+}
+
+bool RingAllocator::isLive(uint64_t position) const {
+    return position >= resetPosition_ && head_ <= position + capacity_;
+}
+
+void RingAllocator::beginFrame() {
+    frameStart_ = head_;
+}
+
+bool RingAllocator::isCurrentFrame(uint64_t position) const {
+    return position >= frameStart_ && isLive(position);
+}
+
+// ============================================================================
+// StreamingBuffer
+// ============================================================================
+
+StreamingBuffer::StreamingBuffer(size_t capacity)
+    : buffer_(0),
+      uniformAlignment_(256),
+      mapped_(false),
+      ring_(capacity) {
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    for (auto& frame : fences_) {
+        glDeleteSync(frame.fence);
+    }
+    fences_.clear();
+
+    if (buffer_ != 0) {
+        glDeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+}
+
+bool StreamingBuffer::initialize() {
+    if (buffer_ != 0) return true;
+    if (ring_.getCapacity() == 0) return false;
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0) {
+        uniformAlignment_ = static_cast<size_t>(alignment);
+    }
+
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(ring_.getCapacity()), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    return buffer_ != 0;
+}
+
+bool StreamingBuffer::reserve(size_t size, size_t alignment, size_t& offset, uint64_t& position) {
+    if (buffer_ == 0 || size == 0 || size > ring_.getCapacity()) return false;
+
+    retireSignaledFences();
+    while (!ring_.tryAllocate(size, alignment, offset, position)) {
+        if (!fences_.empty()) {
+            // 环已绕回到 GPU 仍在读取的帧，只能等待
+            waitOldestFence();
+        } else {
+            // 当前帧自己就写满了整个环
+            orphan();
+            if (!ring_.tryAllocate(size, alignment, offset, position)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    stats_.bytesThisFrame += size;
+    stats_.allocationsThisFrame++;
+    return true;
+}
+
+StreamingBuffer::Allocation StreamingBuffer::map(size_t size, size_t alignment) {
+    Allocation allocation;
+    if (mapped_) {
+        std::cerr << "StreamingBuffer::map called while a previous range is still mapped" << std::endl;
+        return allocation;
+    }
+
+    size_t offset = 0;
+    uint64_t position = 0;
+    if (!reserve(size, alignment, offset, position)) {
+        return allocation;
+    }
+
+    // 区间已由 fence 保证不被 GPU 使用，因此可以跳过驱动的隐式同步
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    void* ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset),
+                                 static_cast<GLsizeiptr>(size),
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!ptr) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return allocation;
+    }
+
+    mapped_ = true;
+    allocation.data = ptr;
+    allocation.offset = static_cast<GLintptr>(offset);
+    allocation.size = static_cast<GLsizeiptr>(size);
+    allocation.position = position;
+    return allocation;
+}
+
+void StreamingBuffer::unmap() {
+    if (!mapped_) return;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    mapped_ = false;
+}
+
+StreamingBuffer::Allocation StreamingBuffer::upload(const void* data, size_t size, size_t alignment) {
+    Allocation allocation = map(size, alignment);
+    if (!allocation.isValid()) return allocation;
+
+    std::memcpy(allocation.data, data, size);
+    unmap();
+    allocation.data = nullptr;
+    return allocation;
+}
+
+StreamingBuffer::Allocation StreamingBuffer::uploadUniform(const void* data, size_t size) {
+    return upload(data, size, uniformAlignment_);
+}
+
+void StreamingBuffer::bindUniformRange(GLuint bindingPoint, const Allocation& allocation) const {
+    if (!allocation.isValid()) return;
+    glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, buffer_, allocation.offset, allocation.size);
+}
+
+bool StreamingBuffer::isLive(const Allocation& allocation) const {
+    return allocation.isValid() && ring_.isLive(allocation.position);
+}
+
+bool StreamingBuffer::isCurrentFrame(const Allocation& allocation) const {
+    return allocation.isValid() && ring_.isCurrentFrame(allocation.position);
+}
+
+void StreamingBuffer::endFrame() {
+    if (buffer_ == 0) return;
+
+    if (ring_.getHead() != ring_.getFrameStart()) {
+        FrameFence frame;
+        frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        frame.end = ring_.getHead();
+        fences_.push_back(frame);
+        ring_.beginFrame();
+    }
+
+    retireSignaledFences();
+    stats_.framesInFlight = fences_.size();
+    stats_.bytesThisFrame = 0;
+    stats_.allocationsThisFrame = 0;
+}
+
+void StreamingBuffer::retireSignaledFences() {
+    while (!fences_.empty()) {
+        GLenum result = glClientWaitSync(fences_.front().fence, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        ring_.retire(fences_.front().end);
+        glDeleteSync(fences_.front().fence);
+        fences_.pop_front();
+    }
+}
+
+void StreamingBuffer::waitOldestFence() {
+    FrameFence frame = fences_.front();
+    fences_.pop_front();
+    stats_.fenceWaits++;
+
+    GLenum result = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeout);
+    while (result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync(frame.fence, 0, kFenceTimeout);
+    }
+    glDeleteSync(frame.fence);
+    ring_.retire(frame.end);
+}
+
+void StreamingBuffer::orphan() {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(ring_.getCapacity()), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    for (auto& frame : fences_) {
+        glDeleteSync(frame.fence);
+    }
+    fences_.clear();
+    ring_.reset();
+    stats_.orphans++;
+}
@@ -0,0 +1,62 @@
+#include "core/WorkerPool.h"
+#include "core/Parallel.h"
+
+WorkerPool::WorkerPool(unsigned int threadCount)
+    : running_(0), stopping_(false) {
+    unsigned int count = threadCount != 0 ? threadCount : Parallel::getMaxWorkers();
+    threads_.reserve(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        threads_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    taskReady_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+void WorkerPool::submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+    }
+    taskReady_.notify_one();
+}
+
+void WorkerPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return queue_.empty() && running_ == 0; });
+}
+
+size_t WorkerPool::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void WorkerPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        taskReady_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (stopping_) return;
+
+        Task task = std::move(queue_.front());
+        queue_.pop_front();
+        ++running_;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        --running_;
+        if (queue_.empty() && running_ == 0) {
+            idle_.notify_all();
+        }
+    }
+}
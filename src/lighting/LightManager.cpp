@@ -7,7 +7,8 @@
 #include <algorithm>
 
 LightManager::LightManager()
-    : ambientColor_(0.1f, 0.1f, 0.1f) {
+    : ambientColor_(0.1f, 0.1f, 0.1f)
+    , hasAmbientSH_(false) {
 }
 
 void LightManager::addLight(std::shared_ptr<Light> light) {
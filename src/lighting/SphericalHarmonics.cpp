@@ -0,0 +1,222 @@
+/**
+ * @file SphericalHarmonics.cpp
+ * @brief L2 spherical harmonics projection and evaluation
+ */
+
+#include "lighting/SphericalHarmonics.h"
+#include "core/Parallel.h"
+#include "mesh/ImageKernels.h"
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SPHERICAL_HARMONICS_X86 1
+#include <immintrin.h>
+#else
+#define SPHERICAL_HARMONICS_X86 0
+#endif
+
+#if SPHERICAL_HARMONICS_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SPHERICAL_HARMONICS_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define SPHERICAL_HARMONICS_TARGET_SSE2
+#endif
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Basis normalization constants
+const float kY00 = 0.282095f;
+const float kY1 = 0.488603f;
+const float kY2 = 1.092548f;
+const float kY20 = 0.315392f;
+const float kY22 = 0.546274f;
+
+// Per row: 9 RGB sums followed by the solid angle sum
+const int kRowFloats = SHCoefficients::Count * 3 + 1;
+
+// Unnormalized direction of face texel (s, t) is axis + s * sAxis + t * tAxis (OpenGL convention)
+struct FaceFrame {
+    float axis[3];
+    float sAxis[3];
+    float tAxis[3];
+};
+
+const FaceFrame kFaceFrames[6] = {
+    { {  1, 0, 0 }, { 0, 0, -1 }, { 0, -1,  0 } },
+    { { -1, 0, 0 }, { 0, 0,  1 }, { 0, -1,  0 } },
+    { { 0,  1, 0 }, { 1, 0,  0 }, { 0,  0,  1 } },
+    { { 0, -1, 0 }, { 1, 0,  0 }, { 0,  0, -1 } },
+    { { 0, 0,  1 }, { 1, 0,  0 }, { 0, -1,  0 } },
+    { { 0, 0, -1 }, { -1, 0, 0 }, { 0, -1,  0 } }
+};
+
+// Accumulates texels [begin, end) of one row into sums
+void projectRowScalar(const float* rgb, const FaceFrame& frame, float t, float step, int begin, int end, float* sums) {
+    for (int x = begin; x < end; ++x) {
+        float s = (static_cast<float>(x) + 0.5f) * step - 1.0f;
+        float invLength = 1.0f / std::sqrt(1.0f + s * s + t * t);
+        // Solid angle of a texel is proportional to (1 + s^2 + t^2)^(-3/2)
+        float weight = invLength * invLength * invLength;
+
+        glm::vec3 dir;
+        for (int c = 0; c < 3; ++c) dir[c] = (frame.axis[c] + s * frame.sAxis[c] + t * frame.tAxis[c]) * invLength;
+        float basis[SHCoefficients::Count];
+        SphericalHarmonics::evaluateBasis(dir, basis);
+
+        const float* color = rgb + static_cast<size_t>(x) * 3;
+        for (int i = 0; i < SHCoefficients::Count; ++i) {
+            float scale = basis[i] * weight;
+            sums[i * 3 + 0] += scale * color[0];
+            sums[i * 3 + 1] += scale * color[1];
+            sums[i * 3 + 2] += scale * color[2];
+        }
+        sums[kRowFloats - 1] += weight;
+    }
+}
+
+#if SPHERICAL_HARMONICS_X86
+
+SPHERICAL_HARMONICS_TARGET_SSE2
+inline float horizontalSum(__m128 v) {
+    float lanes[4];
+    _mm_storeu_ps(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+// Four texels per iteration: directions, weights and all nine basis functions in SSE lanes
+SPHERICAL_HARMONICS_TARGET_SSE2
+void projectRowSSE2(const float* rgb, const FaceFrame& frame, float t, float step, int width, float* sums) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 vt2 = _mm_set1_ps(1.0f + t * t);
+    __m128 base[3];
+    __m128 sAxis[3];
+    for (int c = 0; c < 3; ++c) {
+        base[c] = _mm_set1_ps(frame.axis[c] + t * frame.tAxis[c]);
+        sAxis[c] = _mm_set1_ps(frame.sAxis[c]);
+    }
+
+    __m128 acc[SHCoefficients::Count * 3];
+    for (int i = 0; i < SHCoefficients::Count * 3; ++i) acc[i] = _mm_setzero_ps();
+    __m128 weightSum = _mm_setzero_ps();
+
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128 index = _mm_setr_ps(static_cast<float>(x), static_cast<float>(x + 1),
+                                   static_cast<float>(x + 2), static_cast<float>(x + 3));
+        __m128 s = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(index, _mm_set1_ps(0.5f)), _mm_set1_ps(step)), one);
+        __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(vt2, _mm_mul_ps(s, s))));
+        __m128 weight = _mm_mul_ps(_mm_mul_ps(invLength, invLength), invLength);
+
+        __m128 nx = _mm_mul_ps(_mm_add_ps(base[0], _mm_mul_ps(s, sAxis[0])), invLength);
+        __m128 ny = _mm_mul_ps(_mm_add_ps(base[1], _mm_mul_ps(s, sAxis[1])), invLength);
+        __m128 nz = _mm_mul_ps(_mm_add_ps(base[2], _mm_mul_ps(s, sAxis[2])), invLength);
+
+        __m128 basis[SHCoefficients::Count];
+        basis[0] = _mm_set1_ps(kY00);
+        basis[1] = _mm_mul_ps(_mm_set1_ps(kY1), ny);
+        basis[2] = _mm_mul_ps(_mm_set1_ps(kY1), nz);
+        basis[3] = _mm_mul_ps(_mm_set1_ps(kY1), nx);
+        basis[4] = _mm_mul_ps(_mm_set1_ps(kY2), _mm_mul_ps(nx, ny));
+        basis[5] = _mm_mul_ps(_mm_set1_ps(kY2), _mm_mul_ps(ny, nz));
+        basis[6] = _mm_mul_ps(_mm_set1_ps(kY20), _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(3.0f), _mm_mul_ps(nz, nz)), one));
+        basis[7] = _mm_mul_ps(_mm_set1_ps(kY2), _mm_mul_ps(nx, nz));
+        basis[8] = _mm_mul_ps(_mm_set1_ps(kY22), _mm_sub_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)));
+
+        // De-interleave RGB of the four texels and fold in the solid angle
+        const float* c = rgb + static_cast<size_t>(x) * 3;
+        __m128 r = _mm_mul_ps(_mm_setr_ps(c[0], c[3], c[6], c[9]), weight);
+        __m128 g = _mm_mul_ps(_mm_setr_ps(c[1], c[4], c[7], c[10]), weight);
+        __m128 b = _mm_mul_ps(_mm_setr_ps(c[2], c[5], c[8], c[11]), weight);
+        for (int i = 0; i < SHCoefficients::Count; ++i) {
+            acc[i * 3 + 0] = _mm_add_ps(acc[i * 3 + 0], _mm_mul_ps(basis[i], r));
+            acc[i * 3 + 1] = _mm_add_ps(acc[i * 3 + 1], _mm_mul_ps(basis[i], g));
+            acc[i * 3 + 2] = _mm_add_ps(acc[i * 3 + 2], _mm_mul_ps(basis[i], b));
+        }
+        weightSum = _mm_add_ps(weightSum, weight);
+    }
+
+    for (int i = 0; i < SHCoefficients::Count * 3; ++i) sums[i] += horizontalSum(acc[i]);
+    sums[kRowFloats - 1] += horizontalSum(weightSum);
+    projectRowScalar(rgb, frame, t, step, x, width, sums);
+}
+
+#endif
+
+} // namespace
+
+namespace SphericalHarmonics {
+
+void evaluateBasis(const glm::vec3& dir, float out[SHCoefficients::Count]) {
+    const float x = dir.x, y = dir.y, z = dir.z;
+    out[0] = kY00;
+    out[1] = kY1 * y;
+    out[2] = kY1 * z;
+    out[3] = kY1 * x;
+    out[4] = kY2 * x * y;
+    out[5] = kY2 * y * z;
+    out[6] = kY20 * (3.0f * z * z - 1.0f);
+    out[7] = kY2 * x * z;
+    out[8] = kY22 * (x * x - y * y);
+}
+
+SHCoefficients projectCubemap(const std::vector<float> faces[6], int faceSize) {
+    SHCoefficients sh;
+    if (faceSize <= 0) return sh;
+
+    const size_t rowCount = static_cast<size_t>(faceSize) * 6;
+    const float step = 2.0f / static_cast<float>(faceSize);
+#if SPHERICAL_HARMONICS_X86
+    const bool simd = ImageKernels::getActiveLevel() != ImageKernels::SimdLevel::Scalar;
+#endif
+
+    // Sums per row rather than per worker, so the total is independent of scheduling
+    std::vector<float> rows(rowCount * kRowFloats, 0.0f);
+    Parallel::forRange(rowCount, 16, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t row = begin; row < end; ++row) {
+            int face = static_cast<int>(row / faceSize);
+            int y = static_cast<int>(row % faceSize);
+            float t = (static_cast<float>(y) + 0.5f) * step - 1.0f;
+            const float* rgb = &faces[face][static_cast<size_t>(y) * faceSize * 3];
+            float* sums = &rows[row * kRowFloats];
+#if SPHERICAL_HARMONICS_X86
+            if (simd) {
+                projectRowSSE2(rgb, kFaceFrames[face], t, step, faceSize, sums);
+                continue;
+            }
+#endif
+            projectRowScalar(rgb, kFaceFrames[face], t, step, 0, faceSize, sums);
+        }
+    });
+
+    double totals[kRowFloats] = {};
+    for (size_t row = 0; row < rowCount; ++row) {
+        for (int i = 0; i < kRowFloats; ++i) totals[i] += rows[row * kRowFloats + i];
+    }
+    if (totals[kRowFloats - 1] <= 0.0) return sh;
+
+    const double scale = 4.0 * kPi / totals[kRowFloats - 1];
+    for (int i = 0; i < SHCoefficients::Count; ++i) {
+        sh.coefficients[i] = glm::vec3(static_cast<float>(totals[i * 3 + 0] * scale),
+                                       static_cast<float>(totals[i * 3 + 1] * scale),
+                                       static_cast<float>(totals[i * 3 + 2] * scale));
+    }
+    return sh;
+}
+
+void convolveIrradiance(SHCoefficients& sh) {
+    const float bands[3] = { 1.0f, 2.0f / 3.0f, 0.25f };
+    for (int i = 0; i < SHCoefficients::Count; ++i) {
+        sh.coefficients[i] *= bands[i == 0 ? 0 : (i < 4 ? 1 : 2)];
+    }
+}
+
+glm::vec3 evaluate(const SHCoefficients& sh, const glm::vec3& n) {
+    float basis[SHCoefficients::Count];
+    evaluateBasis(n, basis);
+    glm::vec3 result(0.0f);
+    for (int i = 0; i < SHCoefficients::Count; ++i) result += sh.coefficients[i] * basis[i];
+    return result;
+}
+
+} // namespace SphericalHarmonics
@@ -6,12 +6,27 @@
  */
 
 #include "core/Application.h"
+#include <cstdlib>
+#include <cstring>
 
-int main() {
+int main(int argc, char** argv) {
     // 创建配置（可选：自定义参数）
     AppConfig config;
     config.title = "OpenGL Demo - Modular";
     
+    // --sync-textures：启动时同步加载纹理，用于对比首帧时间
+    // --compress-textures：首次加载时编码为块压缩纹理并缓存到 cache/textures
+    // --texture-budget MB：按屏幕占用流式加载纹理 mip 级别，显存预算为 MB
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sync-textures") == 0) {
+            config.asyncTextureLoading = false;
+        } else if (std::strcmp(argv[i], "--compress-textures") == 0) {
+            config.compressTextures = true;
+        } else if (std::strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc) {
+            config.textureBudgetMB = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+    
     // 创建应用
     Application app(config);
     
@@ -0,0 +1,354 @@
+#include "mesh/AsyncTextureLoader.h"
+#include "core/StreamingBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const size_t kDefaultUploadBudget = 1024 * 1024;
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// stb_image 解码后生成上传用的 mip 链
+void decodeLevels(const std::string& path, const MipOptions& mips, DecodedImage& image) {
+    unsigned char* pixels = stbi_load(path.c_str(), &image.width, &image.height, &image.channels, 0);
+    if (!pixels) return;
+    CTexture::prepareLevels(pixels, image.width, image.height, image.channels, mips, image.levels);
+    stbi_image_free(pixels);
+}
+
+} // namespace
+
+// ==================== DecodedImage ====================
+
+size_t DecodedImage::getRowBytes(size_t level) const {
+    if (!isCompressed()) {
+        return static_cast<size_t>(levels[level].width) * static_cast<size_t>(getUploadChannels());
+    }
+    return static_cast<size_t>((getLevelWidth(level) + 3) / 4) * TextureContainer::getBlockBytes(compressed.format);
+}
+
+const unsigned char* DecodedImage::getRowData(size_t level, int row) const {
+    const unsigned char* base = isCompressed() ? compressed.getLevelData(level) : levels[level].pixels.data();
+    return base + getRowBytes(level) * static_cast<size_t>(row);
+}
+
+int DecodedImage::getChunkRows(size_t level, int firstRow, size_t remaining, bool uploadedThisFrame,
+                               size_t maxChunkBytes) const {
+    // 本帧已有上传且剩余预算不足一行时留到下一帧
+    size_t rowBytes = getRowBytes(level);
+    if (uploadedThisFrame && remaining < rowBytes) return 0;
+
+    size_t chunkBytes = maxChunkBytes > 0 ? std::min(remaining, maxChunkBytes) : remaining;
+    size_t rowsLeft = static_cast<size_t>(getRowCount(level) - firstRow);
+    return static_cast<int>(std::min(rowsLeft, std::max<size_t>(1, chunkBytes / rowBytes)));
+}
+
+void DecodedImage::allocateLevel(size_t level, bool empty) const {
+    int width = empty ? 0 : getLevelWidth(level);
+    int height = empty ? 0 : getLevelHeight(level);
+    if (isCompressed()) {
+        GLsizei size = empty ? 0 : static_cast<GLsizei>(getLevelBytes(level));
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), compressed.getGLInternalFormat(),
+                               width, height, 0, size, nullptr);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), CTexture::getGLInternalFormat(channels),
+                     width, height, 0, CTexture::getGLFormat(getUploadChannels()), GL_UNSIGNED_BYTE, nullptr);
+    }
+}
+
+void DecodedImage::uploadRows(size_t level, int firstRow, int rows, const void* pixels) const {
+    // 行紧密排列（单 / 双通道宽度为奇数时行长不是 4 的倍数）
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (isCompressed()) {
+        // 块行：最后一个块行可能不足 4 像素高
+        int y = firstRow * 4;
+        int height = std::min(rows * 4, getLevelHeight(level) - y);
+        GLsizei size = static_cast<GLsizei>(getRowBytes(level) * static_cast<size_t>(rows));
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), 0, y, getLevelWidth(level), height,
+                                  compressed.getGLInternalFormat(), size, pixels);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), 0, firstRow, getLevelWidth(level), rows,
+                        CTexture::getGLFormat(getUploadChannels()), GL_UNSIGNED_BYTE, pixels);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void DecodedImage::applySamplerDefaults() const {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, getLevelCount() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+bool DecodedImage::decompressIfUnsupported() {
+    if (!isCompressed() || CTexture::isBlockFormatSupported(compressed.format)) return true;
+
+    bool decoded = TextureEncoder::decompress(compressed, levels);
+    channels = decoded ? 4 : 0;
+    compressed = CompressedImage();
+    return decoded;
+}
+
+// ==================== ImageDecodeQueue ====================
+
+ImageDecodeQueue::ImageDecodeQueue(unsigned int workers)
+    : nextId_(1), pending_(0), pool_(workers) {
+}
+
+uint64_t ImageDecodeQueue::submit(const std::string& path, const MipOptions& mips) {
+    return enqueue(path, [path, mips](DecodedImage& image) {
+        if (TextureContainer::isContainerPath(path)) {
+            TextureContainer::load(path, image.compressed);
+        } else {
+            decodeLevels(path, mips, image);
+        }
+    });
+}
+
+uint64_t ImageDecodeQueue::submitEncoded(const std::string& path, const EncodeOptions& options,
+                                         const std::string& cacheDirectory, const MipOptions& mips) {
+    return enqueue(path, [path, options, cacheDirectory, mips](DecodedImage& image) {
+        if (!TextureEncoder::loadOrEncode(path, options, cacheDirectory, image.compressed)) {
+            decodeLevels(path, mips, image);
+        }
+    });
+}
+
+uint64_t ImageDecodeQueue::enqueue(const std::string& path, DecodeFunction decode) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = nextId_++;
+        ++pending_;
+    }
+    pool_.submit([this, id, path, decode]() {
+        auto start = std::chrono::steady_clock::now();
+        DecodedImage image;
+        image.id = id;
+        image.path = path;
+        decode(image);
+        if (image.isCompressed()) {
+            image.width = image.compressed.width;
+            image.height = image.compressed.height;
+            image.channels = image.compressed.getChannels();
+        } else if (image.levels.empty()) {
+            image.width = image.height = image.channels = 0;
+        }
+        image.decodeSeconds = secondsSince(start);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed_.push_back(std::move(image));
+    });
+    return id;
+}
+
+size_t ImageDecodeQueue::poll(std::vector<DecodedImage>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = completed_.size();
+    for (auto& image : completed_) {
+        out.push_back(std::move(image));
+    }
+    completed_.clear();
+    pending_ -= count;
+    return count;
+}
+
+void ImageDecodeQueue::waitIdle() {
+    pool_.waitIdle();
+}
+
+size_t ImageDecodeQueue::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+// ==================== AsyncTextureLoader ====================
+
+AsyncTextureLoader::AsyncTextureLoader(std::shared_ptr<StreamingBuffer> stagingBuffer, unsigned int workers)
+    : decoder_(workers),
+      stagingBuffer_(std::move(stagingBuffer)),
+      uploadBudget_(kDefaultUploadBudget) {
+}
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+    for (auto& upload : uploads_) {
+        if (upload.id != 0) {
+            glDeleteTextures(1, &upload.id);
+        }
+    }
+}
+
+std::shared_ptr<CTexture> AsyncTextureLoader::load(const std::string& path, TextureType type) {
+    if (stats_.requested == 0) {
+        firstRequest_ = Clock::now();
+    }
+    ++stats_.requested;
+
+    auto texture = createPlaceholder(path, type);
+    CTexture::CompressionSettings compression = CTexture::getCompressionSettings();
+    MipOptions mips = CTexture::getMipOptions(type);
+    uint64_t id = (compression.enabled && !TextureContainer::isContainerPath(path))
+        ? decoder_.submitEncoded(path, CTexture::getEncodeOptions(type), compression.cacheDirectory, mips)
+        : decoder_.submit(path, mips);
+    waiting_[id] = texture;
+    return texture;
+}
+
+std::shared_ptr<CTexture> AsyncTextureLoader::createPlaceholder(const std::string& path, TextureType type) {
+    unsigned char placeholder[4] = { 128, 128, 128, 255 };
+    if (type == TextureType::Normal) {
+        placeholder[2] = 255;
+    }
+    auto texture = std::make_shared<CTexture>(placeholder, 1, 1, 4, type);
+    texture->path = path;
+    return texture;
+}
+
+size_t AsyncTextureLoader::update() {
+    collectDecoded();
+    size_t residentBefore = stats_.resident;
+    stats_.bytesThisFrame = uploadWithinBudget(uploadBudget_);
+    return stats_.resident - residentBefore;
+}
+
+void AsyncTextureLoader::finishAll() {
+    size_t uploaded = 0;
+    while (!isIdle()) {
+        decoder_.waitIdle();
+        collectDecoded();
+        uploaded += uploadWithinBudget(static_cast<size_t>(-1));
+    }
+    stats_.bytesThisFrame = uploaded;
+}
+
+void AsyncTextureLoader::collectDecoded() {
+    decoded_.clear();
+    decoder_.poll(decoded_);
+    for (auto& image : decoded_) {
+        auto it = waiting_.find(image.id);
+        if (it == waiting_.end()) continue;
+        std::weak_ptr<CTexture> texture = it->second;
+        waiting_.erase(it);
+
+        stats_.decodeSeconds += image.decodeSeconds;
+        image.decompressIfUnsupported();
+        if (!image.isValid()) {
+            ++stats_.failed;
+            std::cout << "Failed to load texture: " << image.path << std::endl;
+            continue;
+        }
+        if (texture.expired()) continue;
+
+        Upload upload;
+        upload.image = std::move(image);
+        upload.texture = texture;
+        uploads_.push_back(std::move(upload));
+    }
+}
+
+size_t AsyncTextureLoader::uploadWithinBudget(size_t budget) {
+    size_t uploaded = 0;
+    while (!uploads_.empty()) {
+        Upload& upload = uploads_.front();
+        if (upload.texture.expired()) {
+            if (upload.id != 0) glDeleteTextures(1, &upload.id);
+            uploads_.pop_front();
+            continue;
+        }
+
+        // 分块不超过暂存缓冲区的一半，避免单块就迫使整个环等待 GPU
+        size_t maxChunkBytes = 0;
+        if (stagingBuffer_ && stagingBuffer_->isInitialized()) {
+            maxChunkBytes = stagingBuffer_->getCapacity() / 2;
+        }
+        int rows = upload.image.getChunkRows(upload.level, upload.nextRow, budget - uploaded, uploaded > 0,
+                                             maxChunkBytes);
+        if (rows == 0) break;
+        uploaded += uploadRows(upload, rows);
+
+        if (upload.nextRow == upload.image.getRowCount(upload.level)) {
+            upload.nextRow = 0;
+            if (++upload.level == upload.image.getLevelCount()) {
+                finishUpload(upload);
+                uploads_.pop_front();
+            }
+        }
+        if (uploaded >= budget) break;
+    }
+    stats_.bytesUploaded += uploaded;
+    return uploaded;
+}
+
+void AsyncTextureLoader::allocateStorage(Upload& upload) {
+    const DecodedImage& image = upload.image;
+    glGenTextures(1, &upload.id);
+    glBindTexture(GL_TEXTURE_2D, upload.id);
+
+    // 一次分配全部级别，之后按行（块压缩纹理按块行）填充
+    for (size_t i = 0; i < image.getLevelCount(); ++i) {
+        image.allocateLevel(i);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.getLevelCount()) - 1);
+}
+
+size_t AsyncTextureLoader::uploadRows(Upload& upload, int rows) {
+    const DecodedImage& image = upload.image;
+    size_t size = image.getRowBytes(upload.level) * static_cast<size_t>(rows);
+    const unsigned char* src = image.getRowData(upload.level, upload.nextRow);
+
+    // 分配存储时不能绑定 PBO，否则 nullptr 会被当作缓冲区偏移 0
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (upload.id == 0) {
+        allocateStorage(upload);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, upload.id);
+    }
+
+    StreamingBuffer::Allocation staging;
+    if (stagingBuffer_ && stagingBuffer_->isInitialized()) {
+        staging = stagingBuffer_->map(size);
+    }
+    const void* pixels = src;
+    if (staging.isValid()) {
+        std::memcpy(staging.data, src, size);
+        stagingBuffer_->unmap();
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBuffer_->getBuffer());
+        pixels = reinterpret_cast<const void*>(static_cast<uintptr_t>(staging.offset));
+        ++stats_.stagedChunks;
+    } else {
+        ++stats_.directChunks;
+    }
+
+    image.uploadRows(upload.level, upload.nextRow, rows, pixels);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    upload.nextRow += rows;
+    return size;
+}
+
+void AsyncTextureLoader::finishUpload(Upload& upload) {
+    const DecodedImage& image = upload.image;
+
+    glBindTexture(GL_TEXTURE_2D, upload.id);
+    image.applySamplerDefaults();
+
+    if (auto texture = upload.texture.lock()) {
+        if (image.isCompressed()) {
+            texture->adoptCompressed(upload.id, image.compressed);
+            ++stats_.compressed;
+        } else {
+            texture->adopt(upload.id, image.width, image.height, image.channels);
+        }
+        upload.id = 0;
+        ++stats_.resident;
+        stats_.lastResidentSeconds = secondsSince(firstRequest_);
+        std::cout << "Loaded texture: " << image.path << " (" << image.width << "x" << image.height
+                  << ", decoded in " << image.decodeSeconds * 1000.0 << " ms)" << std::endl;
+    } else {
+        glDeleteTextures(1, &upload.id);
+        upload.id = 0;
+    }
+}
@@ -0,0 +1,576 @@
+#include "mesh/GeometryArena.h"
+#include "core/GLState.h"
+#include "mesh/VertexFormat.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+// ============================================================================
+// FreeListAllocator
+// ============================================================================
+
+const size_t FreeListAllocator::InvalidOffset = static_cast<size_t>(-1);
+
+FreeListAllocator::FreeListAllocator(size_t capacity)
+    : capacity_(capacity), used_(0) {
+    if (capacity_ > 0) {
+        freeBlocks_[0] = capacity_;
+    }
+}
+
+size_t FreeListAllocator::allocate(size_t size) {
+    if (size == 0) return InvalidOffset;
+
+    // 首次适配：偏移小的块优先，已用数据自然聚集在缓冲区前部
+    for (auto it = freeBlocks_.begin(); it != freeBlocks_.end(); ++it) {
+        if (it->second < size) continue;
+
+        size_t offset = it->first;
+        size_t remaining = it->second - size;
+        freeBlocks_.erase(it);
+        if (remaining > 0) {
+            freeBlocks_[offset + size] = remaining;
+        }
+        allocations_[offset] = size;
+        used_ += size;
+        return offset;
+    }
+    return InvalidOffset;
+}
+
+void FreeListAllocator::free(size_t offset) {
+    auto allocation = allocations_.find(offset);
+    if (allocation == allocations_.end()) return;
+
+    size_t size = allocation->second;
+    allocations_.erase(allocation);
+    used_ -= size;
+
+    // 与后一个空闲块合并
+    auto next = freeBlocks_.lower_bound(offset);
+    if (next != freeBlocks_.end() && next->first == offset + size) {
+        size += next->second;
+        next = freeBlocks_.erase(next);
+    }
+    // 与前一个空闲块合并
+    if (next != freeBlocks_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+    freeBlocks_[offset] = size;
+}
+
+void FreeListAllocator::grow(size_t newCapacity) {
+    if (newCapacity <= capacity_) return;
+
+    size_t extra = newCapacity - capacity_;
+    if (!freeBlocks_.empty()) {
+        auto last = std::prev(freeBlocks_.end());
+        if (last->first + last->second == capacity_) {
+            last->second += extra;
+            capacity_ = newCapacity;
+            return;
+        }
+    }
+    freeBlocks_[capacity_] = extra;
+    capacity_ = newCapacity;
+}
+
+std::vector<FreeListAllocator::Move> FreeListAllocator::compact() {
+    std::vector<Move> moves;
+    moves.reserve(allocations_.size());
+
+    std::map<size_t, size_t> packed;
+    size_t cursor = 0;
+    for (const auto& allocation : allocations_) {
+        Move move;
+        move.from = allocation.first;
+        move.to = cursor;
+        move.size = allocation.second;
+        moves.push_back(move);
+        packed[cursor] = allocation.second;
+        cursor += allocation.second;
+    }
+
+    allocations_.swap(packed);
+    freeBlocks_.clear();
+    if (cursor < capacity_) {
+        freeBlocks_[cursor] = capacity_ - cursor;
+    }
+    return moves;
+}
+
+size_t FreeListAllocator::getLargestFreeBlock() const {
+    size_t largest = 0;
+    for (const auto& block : freeBlocks_) {
+        largest = std::max(largest, block.second);
+    }
+    return largest;
+}
+
+float FreeListAllocator::getFragmentation() const {
+    size_t freeUnits = getFree();
+    if (freeUnits == 0) return 0.0f;
+    return 1.0f - static_cast<float>(getLargestFreeBlock()) / static_cast<float>(freeUnits);
+}
+
+// ============================================================================
+// GeometryArena
+// ============================================================================
+
+const GeometryArena::Handle GeometryArena::InvalidHandle = 0xFFFFFFFFu;
+
+GeometryArena::GeometryArena(size_t initialVertices, size_t initialIndices)
+    : initialVertices_(initialVertices)
+    , initialIndices_(initialIndices) {
+}
+
+GeometryArena::~GeometryArena() {
+    for (auto& pool : pools_) {
+        GLState::deleteVertexArray(pool.vao);
+        if (pool.vbo != 0) glDeleteBuffers(1, &pool.vbo);
+        if (pool.ebo != 0) glDeleteBuffers(1, &pool.ebo);
+    }
+}
+
+size_t GeometryArena::findOrCreatePool(const VertexAttributeLayout& layout) {
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        if (VertexFormat::sameFormat(pools_[i].layout, layout)) return i;
+    }
+
+    Pool pool;
+    pool.layout = layout;
+    pool.vertices = FreeListAllocator(initialVertices_);
+    pool.indices = FreeListAllocator(initialIndices_);
+
+    glGenVertexArrays(1, &pool.vao);
+    glGenBuffers(1, &pool.vbo);
+    glGenBuffers(1, &pool.ebo);
+
+    GLState::bindVertexArray(pool.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, pool.vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(initialVertices_ * layout.stride), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(initialIndices_ * sizeof(unsigned int)), nullptr, GL_STATIC_DRAW);
+    setupPoolAttributes(pool);
+    GLState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    pools_.push_back(pool);
+    return pools_.size() - 1;
+}
+
+void GeometryArena::setupPoolAttributes(const Pool& pool) const {
+    // 与 CMesh 一致：缓冲区中的顶点按布局紧排
+    glBindBuffer(GL_ARRAY_BUFFER, pool.vbo);
+    VertexFormat::setupAttributePointers(pool.layout, 0);
+}
+
+void GeometryArena::copyRange(GLuint source, GLuint target, size_t fromBytes, size_t toBytes, size_t bytes) const {
+    if (bytes == 0) return;
+    glBindBuffer(GL_COPY_READ_BUFFER, source);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                        static_cast<GLintptr>(fromBytes), static_cast<GLintptr>(toBytes), static_cast<GLsizeiptr>(bytes));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GeometryArena::growBuffer(Pool& pool, bool indexBuffer, size_t minimumFree) {
+    FreeListAllocator& allocator = indexBuffer ? pool.indices : pool.vertices;
+    GLuint& buffer = indexBuffer ? pool.ebo : pool.vbo;
+    size_t unit = indexBuffer ? sizeof(unsigned int) : pool.layout.stride;
+
+    // 新增部分接在末尾，与末尾的空闲块合并后至少有 minimumFree
+    size_t oldCapacity = allocator.getCapacity();
+    size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + minimumFree);
+
+    GLuint grown = 0;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newCapacity * unit), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    copyRange(buffer, grown, 0, 0, oldCapacity * unit);
+    glDeleteBuffers(1, &buffer);
+    buffer = grown;
+
+    // 已有偏移不变，只需把 VAO 指向新缓冲区
+    GLState::bindVertexArray(pool.vao);
+    if (indexBuffer) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+    } else {
+        setupPoolAttributes(pool);
+    }
+    GLState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    allocator.grow(newCapacity);
+}
+
+bool GeometryArena::allocateRange(size_t poolIndex, size_t vertexCount, size_t indexCount, Range& range) {
+    Pool& pool = pools_[poolIndex];
+
+    size_t baseVertex = pool.vertices.allocate(vertexCount);
+    if (baseVertex == FreeListAllocator::InvalidOffset) {
+        growBuffer(pool, false, vertexCount);
+        baseVertex = pool.vertices.allocate(vertexCount);
+        if (baseVertex == FreeListAllocator::InvalidOffset) return false;
+    }
+
+    size_t firstIndex = 0;
+    if (indexCount > 0) {
+        firstIndex = pool.indices.allocate(indexCount);
+        if (firstIndex == FreeListAllocator::InvalidOffset) {
+            growBuffer(pool, true, indexCount);
+            firstIndex = pool.indices.allocate(indexCount);
+        }
+        if (firstIndex == FreeListAllocator::InvalidOffset) {
+            pool.vertices.free(baseVertex);
+            return false;
+        }
+    }
+
+    range.baseVertex = baseVertex;
+    range.vertexCount = vertexCount;
+    range.firstIndex = firstIndex;
+    range.indexCount = indexCount;
+    return true;
+}
+
+void GeometryArena::freeRange(size_t poolIndex, const Range& range) {
+    Pool& pool = pools_[poolIndex];
+    pool.vertices.free(range.baseVertex);
+    if (range.indexCount > 0) {
+        pool.indices.free(range.firstIndex);
+    }
+}
+
+GeometryArena::Handle GeometryArena::addEntry(size_t poolIndex, const Range& range) {
+    Handle handle;
+    if (!freeHandles_.empty()) {
+        handle = freeHandles_.back();
+        freeHandles_.pop_back();
+    } else {
+        handle = static_cast<Handle>(entries_.size());
+        entries_.push_back(Entry());
+    }
+
+    Entry& entry = entries_[handle];
+    entry.pool = poolIndex;
+    entry.range = range;
+    entry.alive = true;
+    return handle;
+}
+
+GeometryArena::Handle GeometryArena::allocate(const VertexAttributeLayout& layout, size_t vertexCount, size_t indexCount) {
+    if (vertexCount == 0 || layout.stride == 0) return InvalidHandle;
+
+    size_t poolIndex = findOrCreatePool(layout);
+    Range range;
+    if (!allocateRange(poolIndex, vertexCount, indexCount, range)) return InvalidHandle;
+    return addEntry(poolIndex, range);
+}
+
+void GeometryArena::free(Handle handle) {
+    if (!isValid(handle)) return;
+
+    Entry& entry = entries_[handle];
+    freeRange(entry.pool, entry.range);
+    entry.alive = false;
+    freeHandles_.push_back(handle);
+}
+
+bool GeometryArena::isValid(Handle handle) const {
+    return handle < entries_.size() && entries_[handle].alive;
+}
+
+GeometryArena::Range GeometryArena::getRange(Handle handle) const {
+    return isValid(handle) ? entries_[handle].range : Range();
+}
+
+bool GeometryArena::uploadVertices(Handle handle, size_t first, const void* data, size_t count) {
+    if (!isValid(handle) || !data || count == 0) return false;
+    const Entry& entry = entries_[handle];
+    if (first + count > entry.range.vertexCount) return false;
+
+    // 用 COPY_WRITE 目标写入，不影响当前绑定的 VAO / 数组缓冲区
+    const Pool& pool = pools_[entry.pool];
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>((entry.range.baseVertex + first) * pool.layout.stride),
+                    static_cast<GLsizeiptr>(count * pool.layout.stride), data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return true;
+}
+
+bool GeometryArena::uploadIndices(Handle handle, size_t first, const unsigned int* data, size_t count) {
+    if (!isValid(handle) || !data || count == 0) return false;
+    const Entry& entry = entries_[handle];
+    if (first + count > entry.range.indexCount) return false;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pools_[entry.pool].ebo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>((entry.range.firstIndex + first) * sizeof(unsigned int)),
+                    static_cast<GLsizeiptr>(count * sizeof(unsigned int)), data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return true;
+}
+
+bool GeometryArena::copyVertices(Handle handle, GLuint sourceBuffer, GLintptr sourceOffset, size_t count) {
+    if (!isValid(handle) || count > entries_[handle].range.vertexCount) return false;
+    const Entry& entry = entries_[handle];
+    const Pool& pool = pools_[entry.pool];
+    copyRange(sourceBuffer, pool.vbo, static_cast<size_t>(sourceOffset),
+              entry.range.baseVertex * pool.layout.stride, count * pool.layout.stride);
+    return true;
+}
+
+bool GeometryArena::copyIndices(Handle handle, GLuint sourceBuffer, GLintptr sourceOffset, size_t count) {
+    if (!isValid(handle) || count > entries_[handle].range.indexCount) return false;
+    const Entry& entry = entries_[handle];
+    copyRange(sourceBuffer, pools_[entry.pool].ebo, static_cast<size_t>(sourceOffset),
+              entry.range.firstIndex * sizeof(unsigned int), count * sizeof(unsigned int));
+    return true;
+}
+
+GeometryArena::Handle GeometryArena::duplicate(Handle handle) {
+    if (!isValid(handle)) return InvalidHandle;
+
+    Entry source = entries_[handle];
+    Range range;
+    if (!allocateRange(source.pool, source.range.vertexCount, source.range.indexCount, range)) {
+        return InvalidHandle;
+    }
+
+    // 同一缓冲区内不重叠的区间之间可以直接复制；扩容后缓冲区对象可能已更换，分配完再取
+    const Pool& pool = pools_[source.pool];
+    size_t stride = pool.layout.stride;
+    copyRange(pool.vbo, pool.vbo, source.range.baseVertex * stride,
+              range.baseVertex * stride, range.vertexCount * stride);
+    copyRange(pool.ebo, pool.ebo, source.range.firstIndex * sizeof(unsigned int),
+              range.firstIndex * sizeof(unsigned int), range.indexCount * sizeof(unsigned int));
+    return addEntry(source.pool, range);
+}
+
+bool GeometryArena::resize(Handle handle, size_t vertexCount, size_t indexCount) {
+    if (!isValid(handle) || vertexCount == 0) return false;
+
+    Entry& entry = entries_[handle];
+    Range old = entry.range;
+    if (old.vertexCount == vertexCount && old.indexCount == indexCount) return true;
+
+    Range range;
+    if (!allocateRange(entry.pool, vertexCount, indexCount, range)) return false;
+
+    const Pool& pool = pools_[entry.pool];
+    size_t stride = pool.layout.stride;
+    copyRange(pool.vbo, pool.vbo, old.baseVertex * stride, range.baseVertex * stride,
+              std::min(old.vertexCount, vertexCount) * stride);
+    copyRange(pool.ebo, pool.ebo, old.firstIndex * sizeof(unsigned int), range.firstIndex * sizeof(unsigned int),
+              std::min(old.indexCount, indexCount) * sizeof(unsigned int));
+
+    freeRange(entry.pool, old);
+    entry.range = range;
+    return true;
+}
+
+bool GeometryArena::setLayout(Handle handle, const VertexAttributeLayout& layout) {
+    if (!isValid(handle) || layout.stride == 0) return false;
+
+    // 新建 pool 会使 pools_ 中的引用失效，先确定目标再取引用
+    size_t target = findOrCreatePool(layout);
+    Entry& entry = entries_[handle];
+    if (target == entry.pool) return true;
+
+    Range range;
+    if (!allocateRange(target, entry.range.vertexCount, entry.range.indexCount, range)) return false;
+
+    // 顶点按布局紧排，换布局后格式不同，只搬移索引，顶点由调用方重新上传
+    const Pool& from = pools_[entry.pool];
+    const Pool& to = pools_[target];
+    copyRange(from.ebo, to.ebo, entry.range.firstIndex * sizeof(unsigned int), range.firstIndex * sizeof(unsigned int),
+              range.indexCount * sizeof(unsigned int));
+
+    freeRange(entry.pool, entry.range);
+    entry.pool = target;
+    entry.range = range;
+    return true;
+}
+
+GLuint GeometryArena::getVertexBuffer(Handle handle) const {
+    return isValid(handle) ? pools_[entries_[handle].pool].vbo : 0;
+}
+
+GLuint GeometryArena::getIndexBuffer(Handle handle) const {
+    return isValid(handle) ? pools_[entries_[handle].pool].ebo : 0;
+}
+
+void GeometryArena::bind(Handle handle) const {
+    if (isValid(handle)) {
+        GLState::bindVertexArray(pools_[entries_[handle].pool].vao);
+    }
+}
+
+void GeometryArena::draw(Handle handle, GLenum mode, unsigned int instanceCount) const {
+    drawRange(handle, mode, 0, std::numeric_limits<size_t>::max(), instanceCount);
+}
+
+void GeometryArena::drawRange(Handle handle, GLenum mode, size_t first, size_t count,
+                              unsigned int instanceCount) const {
+    if (!isValid(handle)) return;
+
+    const Entry& entry = entries_[handle];
+    const Range& range = entry.range;
+    size_t total = range.indexCount > 0 ? range.indexCount : range.vertexCount;
+    if (first >= total) return;
+    count = std::min(count, total - first);
+    GLState::bindVertexArray(pools_[entry.pool].vao);
+
+    if (range.indexCount > 0) {
+        GLsizei indexCount = static_cast<GLsizei>(count);
+        const void* offset = (const void*)((range.firstIndex + first) * sizeof(unsigned int));
+        GLint baseVertex = static_cast<GLint>(range.baseVertex);
+        if (instanceCount > 0) {
+            glDrawElementsInstancedBaseVertex(mode, indexCount, GL_UNSIGNED_INT, offset, instanceCount, baseVertex);
+        } else {
+            glDrawElementsBaseVertex(mode, indexCount, GL_UNSIGNED_INT, offset, baseVertex);
+        }
+    } else {
+        GLint firstVertex = static_cast<GLint>(range.baseVertex + first);
+        GLsizei vertexCount = static_cast<GLsizei>(count);
+        if (instanceCount > 0) {
+            glDrawArraysInstanced(mode, firstVertex, vertexCount, instanceCount);
+        } else {
+            glDrawArrays(mode, firstVertex, vertexCount);
+        }
+    }
+}
+
+void GeometryArena::drawMulti(const std::vector<Handle>& handles, GLenum mode) const {
+    groups_.resize(pools_.size());
+    for (auto& group : groups_) {
+        group.clear();
+    }
+    for (Handle handle : handles) {
+        if (isValid(handle)) {
+            groups_[entries_[handle].pool].push_back(handle);
+        }
+    }
+
+    for (size_t poolIndex = 0; poolIndex < groups_.size(); ++poolIndex) {
+        const std::vector<Handle>& group = groups_[poolIndex];
+        if (group.empty()) continue;
+
+        GLState::bindVertexArray(pools_[poolIndex].vao);
+
+        // 有索引的区间：一次 glMultiDrawElementsBaseVertex
+        scratch_.counts.clear();
+        scratch_.offsets.clear();
+        scratch_.baseVertices.clear();
+        for (Handle handle : group) {
+            const Range& range = entries_[handle].range;
+            if (range.indexCount == 0) continue;
+            scratch_.counts.push_back(static_cast<GLsizei>(range.indexCount));
+            scratch_.offsets.push_back((const void*)(range.firstIndex * sizeof(unsigned int)));
+            scratch_.baseVertices.push_back(static_cast<GLint>(range.baseVertex));
+        }
+        if (!scratch_.counts.empty()) {
+            glMultiDrawElementsBaseVertex(mode, scratch_.counts.data(), GL_UNSIGNED_INT, scratch_.offsets.data(),
+                                          static_cast<GLsizei>(scratch_.counts.size()), scratch_.baseVertices.data());
+        }
+
+        // 无索引的区间：一次 glMultiDrawArrays
+        scratch_.counts.clear();
+        scratch_.firsts.clear();
+        for (Handle handle : group) {
+            const Range& range = entries_[handle].range;
+            if (range.indexCount > 0) continue;
+            scratch_.firsts.push_back(static_cast<GLint>(range.baseVertex));
+            scratch_.counts.push_back(static_cast<GLsizei>(range.vertexCount));
+        }
+        if (!scratch_.counts.empty()) {
+            glMultiDrawArrays(mode, scratch_.firsts.data(), scratch_.counts.data(),
+                              static_cast<GLsizei>(scratch_.counts.size()));
+        }
+    }
+}
+
+size_t GeometryArena::defragment() {
+    size_t bytesCopied = 0;
+
+    for (size_t poolIndex = 0; poolIndex < pools_.size(); ++poolIndex) {
+        Pool& pool = pools_[poolIndex];
+
+        for (int pass = 0; pass < 2; ++pass) {
+            bool indexBuffer = (pass == 1);
+            FreeListAllocator& allocator = indexBuffer ? pool.indices : pool.vertices;
+            GLuint& buffer = indexBuffer ? pool.ebo : pool.vbo;
+            size_t unit = indexBuffer ? sizeof(unsigned int) : pool.layout.stride;
+
+            // 已经紧排时所有 move 都是原地的，跳过复制
+            std::vector<FreeListAllocator::Move> moves = allocator.compact();
+            bool anyMoved = false;
+            for (const auto& move : moves) {
+                if (move.from != move.to) {
+                    anyMoved = true;
+                    break;
+                }
+            }
+            if (!anyMoved) continue;
+
+            // 同一缓冲区内的搬移可能重叠，复制到新缓冲区再替换
+            GLuint packed = 0;
+            glGenBuffers(1, &packed);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, packed);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(allocator.getCapacity() * unit), nullptr, GL_STATIC_DRAW);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            for (const auto& move : moves) {
+                copyRange(buffer, packed, move.from * unit, move.to * unit, move.size * unit);
+                bytesCopied += move.size * unit;
+            }
+            glDeleteBuffers(1, &buffer);
+            buffer = packed;
+
+            GLState::bindVertexArray(pool.vao);
+            if (indexBuffer) {
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+            } else {
+                setupPoolAttributes(pool);
+            }
+            GLState::bindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            // moves 按 from 升序，二分查找每个区间的新偏移
+            for (auto& entry : entries_) {
+                if (!entry.alive || entry.pool != poolIndex) continue;
+                if (indexBuffer && entry.range.indexCount == 0) continue;
+                size_t& offset = indexBuffer ? entry.range.firstIndex : entry.range.baseVertex;
+                auto it = std::lower_bound(moves.begin(), moves.end(), offset,
+                    [](const FreeListAllocator::Move& move, size_t value) { return move.from < value; });
+                if (it != moves.end() && it->from == offset) {
+                    offset = it->to;
+                }
+            }
+        }
+    }
+
+    return bytesCopied;
+}
+
+GeometryArena::Stats GeometryArena::getStats() const {
+    Stats stats;
+    stats.layouts = pools_.size();
+    for (const auto& entry : entries_) {
+        if (entry.alive) ++stats.allocations;
+    }
+    for (const auto& pool : pools_) {
+        stats.vertexBytesUsed += pool.vertices.getUsed() * pool.layout.stride;
+        stats.vertexBytesCapacity += pool.vertices.getCapacity() * pool.layout.stride;
+        stats.indexBytesUsed += pool.indices.getUsed() * sizeof(unsigned int);
+        stats.indexBytesCapacity += pool.indices.getCapacity() * sizeof(unsigned int);
+        stats.fragmentation = std::max(stats.fragmentation, pool.vertices.getFragmentation());
+        stats.fragmentation = std::max(stats.fragmentation, pool.indices.getFragmentation());
+    }
+    return stats;
+}
@@ -0,0 +1,646 @@
+#include "mesh/ImageKernels.h"
+#include "core/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define IMAGE_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define IMAGE_KERNELS_X86 0
+#endif
+
+// 与 MeshKernels 相同：GCC / Clang 需要在函数级别打开 AVX2 指令集
+#if IMAGE_KERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+#define IMAGE_KERNELS_TARGET_SSE2 __attribute__((target("sse2")))
+#define IMAGE_KERNELS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define IMAGE_KERNELS_TARGET_SSE2
+#define IMAGE_KERNELS_TARGET_AVX2
+#endif
+
+namespace {
+
+typedef ImageKernels::SimdLevel SimdLevel;
+
+const size_t kPixelsPerTask = 64 * 1024;   // 转换类内核每个线程至少处理的像素数
+const size_t kRowsPerBatch = 16;           // 降采样每批输出行数，批内用到的源行只解码一次
+const double kPi = 3.14159265358979323846;
+const double kKaiserWidth = 3.0;           // 以输出像素计的半宽
+const double kKaiserAlpha = 4.0;
+const int kEncodeTableSize = 1 << 14;      // 线性值到 sRGB 字节的查找表精度
+
+// 输出通道的来源：0~3 为输入通道，4 为常量 0，5 为常量 255
+struct Swizzle {
+    int source[4];
+};
+
+// ---------------------------------------------------------------------------
+// sRGB 查找表
+// ---------------------------------------------------------------------------
+
+struct GammaTables {
+    float toLinear[256];    // sRGB 字节 -> 线性值
+    float identity[256];    // 线性字节 -> [0, 1]
+    unsigned char toSRGB[kEncodeTableSize + 1];
+};
+
+double srgbToLinear(double v) {
+    return v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4);
+}
+
+double linearToSRGB(double v) {
+    return v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+}
+
+const GammaTables& gammaTables() {
+    static const GammaTables tables = []() {
+        GammaTables t;
+        for (int i = 0; i < 256; ++i) {
+            t.toLinear[i] = static_cast<float>(srgbToLinear(i / 255.0));
+            t.identity[i] = static_cast<float>(i / 255.0);
+        }
+        // 表格间距远小于 sRGB 字节的间距，未滤波的像素（纯色区域）解码再编码后保持不变
+        for (int i = 0; i <= kEncodeTableSize; ++i) {
+            double srgb = linearToSRGB(static_cast<double>(i) / kEncodeTableSize);
+            t.toSRGB[i] = static_cast<unsigned char>(srgb * 255.0 + 0.5);
+        }
+        return t;
+    }();
+    return tables;
+}
+
+// ---------------------------------------------------------------------------
+// 滤波抽头
+// ---------------------------------------------------------------------------
+
+// 每个输出像素固定 count 个抽头（不足的补权重 0），第 i 个输出像素的抽头在 [i * count, (i + 1) * count)
+struct FilterTaps {
+    int count = 0;
+    std::vector<int> index;
+    std::vector<float> weight;
+};
+
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    double half = x * 0.5;
+    for (int k = 1; k < 64 && term > sum * 1e-12; ++k) {
+        term *= (half / k) * (half / k);
+        sum += term;
+    }
+    return sum;
+}
+
+double kaiser(double x) {
+    if (std::abs(x) >= kKaiserWidth) return 0.0;
+    double t = x / kKaiserWidth;
+    double window = besselI0(kKaiserAlpha * std::sqrt(1.0 - t * t)) / besselI0(kKaiserAlpha);
+    double sinc = x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+    return sinc * window;
+}
+
+int sampleIndex(int i, int size, bool wrap) {
+    if (wrap) return ((i % size) + size) % size;
+    return std::min(std::max(i, 0), size - 1);
+}
+
+// 输出像素 i 覆盖源区间 [i * scale, (i + 1) * scale)，源像素 j 的中心在 j + 0.5
+FilterTaps buildTaps(int srcSize, int dstSize, const MipOptions& options) {
+    const double scale = static_cast<double>(srcSize) / dstSize;
+    const bool box = options.filter == MipFilter::Box;
+    const double support = (box ? 0.5 : kKaiserWidth) * scale;
+    const int span = static_cast<int>(std::ceil(2.0 * support)) + 2;
+
+    std::vector<double> weights(static_cast<size_t>(dstSize) * span);
+    std::vector<int> start(static_cast<size_t>(dstSize));
+    std::vector<int> first(static_cast<size_t>(dstSize));
+    std::vector<int> last(static_cast<size_t>(dstSize));
+    int count = 1;
+    for (int i = 0; i < dstSize; ++i) {
+        const double center = (i + 0.5) * scale;
+        start[i] = static_cast<int>(std::floor(center - support - 0.5));
+        double* w = &weights[static_cast<size_t>(i) * span];
+        double sum = 0.0;
+        first[i] = span;
+        last[i] = -1;
+        for (int k = 0; k < span; ++k) {
+            double j = static_cast<double>(start[i] + k);
+            w[k] = box ? std::max(0.0, std::min(j + 1.0, center + support) - std::max(j, center - support))
+                       : kaiser((j + 0.5 - center) / scale);
+            sum += w[k];
+            if (w[k] != 0.0) {
+                first[i] = std::min(first[i], k);
+                last[i] = k;
+            }
+        }
+        for (int k = 0; k < span; ++k) w[k] /= sum;
+        count = std::max(count, last[i] - first[i] + 1);
+    }
+
+    FilterTaps taps;
+    taps.count = count;
+    taps.index.resize(static_cast<size_t>(dstSize) * count);
+    taps.weight.resize(static_cast<size_t>(dstSize) * count);
+    for (int i = 0; i < dstSize; ++i) {
+        for (int k = 0; k < count; ++k) {
+            int tap = first[i] + k;
+            size_t at = static_cast<size_t>(i) * count + k;
+            taps.weight[at] = tap <= last[i] ? static_cast<float>(weights[static_cast<size_t>(i) * span + tap]) : 0.0f;
+            taps.index[at] = sampleIndex(start[i] + std::min(tap, last[i]), srcSize, options.wrap);
+        }
+    }
+    return taps;
+}
+
+void decodeRow(const unsigned char* src, size_t pixels, int channels, const float* const* tables, float* out) {
+    for (size_t x = 0; x < pixels; ++x) {
+        for (int c = 0; c < channels; ++c) {
+            out[x * channels + c] = tables[c][src[x * channels + c]];
+        }
+    }
+}
+
+void encodeRow(const float* in, size_t pixels, int channels, const bool* srgb, unsigned char* out) {
+    const unsigned char* table = gammaTables().toSRGB;
+    for (size_t x = 0; x < pixels; ++x) {
+        for (int c = 0; c < channels; ++c) {
+            // Kaiser 的负瓣可能越界，先截断
+            float v = std::min(1.0f, std::max(0.0f, in[x * channels + c]));
+            out[x * channels + c] = srgb[c] ? table[static_cast<int>(v * kEncodeTableSize + 0.5f)]
+                                            : static_cast<unsigned char>(v * 255.0f + 0.5f);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 标量实现
+// ---------------------------------------------------------------------------
+
+inline unsigned char mulDiv255(unsigned int c, unsigned int a) {
+    // 对 0~255 的全部输入都等于 round(c * a / 255)
+    unsigned int t = c * a + 128;
+    return static_cast<unsigned char>((t + (t >> 8)) >> 8);
+}
+
+void expandScalar(const unsigned char* rgb, unsigned char* rgba, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        rgba[i * 4 + 0] = rgb[i * 3 + 0];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+void premultiplyScalar(const unsigned char* in, unsigned char* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        unsigned int a = in[i * 4 + 3];
+        out[i * 4 + 0] = mulDiv255(in[i * 4 + 0], a);
+        out[i * 4 + 1] = mulDiv255(in[i * 4 + 1], a);
+        out[i * 4 + 2] = mulDiv255(in[i * 4 + 2], a);
+        out[i * 4 + 3] = static_cast<unsigned char>(a);
+    }
+}
+
+void swizzleScalar(const unsigned char* in, unsigned char* out, size_t count, const Swizzle& swizzle) {
+    for (size_t i = 0; i < count; ++i) {
+        // 先读完整个像素，保证原地重排安全
+        const unsigned char p[6] = { in[i * 4 + 0], in[i * 4 + 1], in[i * 4 + 2], in[i * 4 + 3], 0, 255 };
+        for (int c = 0; c < 4; ++c) {
+            out[i * 4 + c] = p[swizzle.source[c]];
+        }
+    }
+}
+
+void verticalScalar(const float* const* rows, const float* weights, int taps, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        float sum = 0.0f;
+        for (int k = 0; k < taps; ++k) sum += weights[k] * rows[k][i];
+        out[i] = sum;
+    }
+}
+
+// index / weight 指向第一个输出像素的抽头，每个输出像素 taps 个
+void horizontalScalar(const float* in, int channels, const int* index, const float* weight, int taps,
+                      float* out, int dstWidth) {
+    for (int x = 0; x < dstWidth; ++x, index += taps, weight += taps) {
+        for (int c = 0; c < channels; ++c) {
+            float sum = 0.0f;
+            for (int k = 0; k < taps; ++k) sum += weight[k] * in[static_cast<size_t>(index[k]) * channels + c];
+            out[static_cast<size_t>(x) * channels + c] = sum;
+        }
+    }
+}
+
+void horizontal4Scalar(const float* in, const int* index, const float* weight, int taps, float* out, int dstWidth) {
+    horizontalScalar(in, 4, index, weight, taps, out, dstWidth);
+}
+
+#if IMAGE_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// SSE2 实现
+// ---------------------------------------------------------------------------
+
+// 一次 4 个像素：第 k 个 32 位通道需要字节 [3k, 3k + 2]，整体左移 k 字节后再按通道取出
+IMAGE_KERNELS_TARGET_SSE2
+void expandSSE2(const unsigned char* rgb, unsigned char* rgba, size_t count) {
+    const __m128i m0 = _mm_setr_epi32(0x00FFFFFF, 0, 0, 0);
+    const __m128i m1 = _mm_setr_epi32(0, 0x00FFFFFF, 0, 0);
+    const __m128i m2 = _mm_setr_epi32(0, 0, 0x00FFFFFF, 0);
+    const __m128i m3 = _mm_setr_epi32(0, 0, 0, 0x00FFFFFF);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+    // 每次读 16 字节、只用 12 字节，剩余不足 6 个像素时交给标量
+    for (; i + 6 <= count; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + i * 3));
+        __m128i r = _mm_or_si128(_mm_and_si128(x, m0), _mm_and_si128(_mm_slli_si128(x, 1), m1));
+        r = _mm_or_si128(r, _mm_and_si128(_mm_slli_si128(x, 2), m2));
+        r = _mm_or_si128(r, _mm_and_si128(_mm_slli_si128(x, 3), m3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), _mm_or_si128(r, alpha));
+    }
+    expandScalar(rgb + i * 3, rgba + i * 4, count - i);
+}
+
+// 8 个 16 位分量 (r0 g0 b0 a0 r1 g1 b1 a1) 乘以各自像素的 alpha，alpha 分量乘以 255
+IMAGE_KERNELS_TARGET_SSE2
+inline __m128i premultiply2(__m128i v) {
+    const __m128i keepColor = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i alphaLane = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xFF), 0xFF);
+    a = _mm_or_si128(_mm_and_si128(a, keepColor), alphaLane);
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(v, a), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+IMAGE_KERNELS_TARGET_SSE2
+void premultiplySSE2(const unsigned char* in, unsigned char* out, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+        __m128i lo = premultiply2(_mm_unpacklo_epi8(x, zero));
+        __m128i hi = premultiply2(_mm_unpackhi_epi8(x, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_packus_epi16(lo, hi));
+    }
+    premultiplyScalar(in + i * 4, out + i * 4, count - i);
+}
+
+// SSE2 没有字节重排指令：每个输出通道把整个 32 位像素移位到位后按通道取出
+IMAGE_KERNELS_TARGET_SSE2
+void swizzleSSE2(const unsigned char* in, unsigned char* out, size_t count, const Swizzle& swizzle) {
+    __m128i masks[4];
+    __m128i shifts[4];
+    __m128i constant = _mm_setzero_si128();
+    for (int c = 0; c < 4; ++c) {
+        int source = swizzle.source[c];
+        masks[c] = _mm_set1_epi32(0xFF << (8 * c));
+        shifts[c] = _mm_cvtsi32_si128(source < 4 ? 8 * std::abs(source - c) : 0);
+        if (source == 5) constant = _mm_or_si128(constant, masks[c]);
+    }
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+        __m128i r = constant;
+        for (int c = 0; c < 4; ++c) {
+            int source = swizzle.source[c];
+            if (source >= 4) continue;
+            __m128i v = source > c ? _mm_srl_epi32(x, shifts[c]) : _mm_sll_epi32(x, shifts[c]);
+            r = _mm_or_si128(r, _mm_and_si128(v, masks[c]));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), r);
+    }
+    swizzleScalar(in + i * 4, out + i * 4, count - i, swizzle);
+}
+
+// 运算顺序与标量实现相同（先乘后加、按抽头顺序累加），结果逐位一致
+IMAGE_KERNELS_TARGET_SSE2
+void verticalSSE2(const float* const* rows, const float* weights, int taps, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 a = _mm_setzero_ps();
+        __m128 b = _mm_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            __m128 w = _mm_set1_ps(weights[k]);
+            a = _mm_add_ps(a, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i)));
+            b = _mm_add_ps(b, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i + 4)));
+        }
+        _mm_storeu_ps(out + i, a);
+        _mm_storeu_ps(out + i + 4, b);
+    }
+    for (; i < n; ++i) {
+        float sum = 0.0f;
+        for (int k = 0; k < taps; ++k) sum += weights[k] * rows[k][i];
+        out[i] = sum;
+    }
+}
+
+IMAGE_KERNELS_TARGET_SSE2
+void horizontal4SSE2(const float* in, const int* index, const float* weight, int taps, float* out, int dstWidth) {
+    for (int x = 0; x < dstWidth; ++x, index += taps, weight += taps) {
+        __m128 sum = _mm_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weight[k]), _mm_loadu_ps(in + static_cast<size_t>(index[k]) * 4)));
+        }
+        _mm_storeu_ps(out + static_cast<size_t>(x) * 4, sum);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA 实现
+// ---------------------------------------------------------------------------
+
+// 一次 8 个像素：两个 128 位通道各装 4 个 RGB 像素（12 字节），再按字节重排
+IMAGE_KERNELS_TARGET_AVX2
+void expandAVX2(const unsigned char* rgb, unsigned char* rgba, size_t count) {
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128,
+                                             0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+    // 高半部分从第 12 字节读 16 字节，剩余不足 10 个像素时交给 SSE2
+    for (; i + 10 <= count; i += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + i * 3));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + i * 3 + 12));
+        __m256i x = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(x, shuffle), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i * 4), r);
+    }
+    expandSSE2(rgb + i * 3, rgba + i * 4, count - i);
+}
+
+IMAGE_KERNELS_TARGET_AVX2
+inline __m256i premultiply4(__m256i v) {
+    const __m256i keepColor = _mm256_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0);
+    const __m256i alphaLane = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+    __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, 0xFF), 0xFF);
+    a = _mm256_or_si256(_mm256_and_si256(a, keepColor), alphaLane);
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(v, a), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+// unpack 与 packus 都在 128 位通道内进行，像素顺序保持不变
+IMAGE_KERNELS_TARGET_AVX2
+void premultiplyAVX2(const unsigned char* in, unsigned char* out, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 4));
+        __m256i lo = premultiply4(_mm256_unpacklo_epi8(x, zero));
+        __m256i hi = premultiply4(_mm256_unpackhi_epi8(x, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_packus_epi16(lo, hi));
+    }
+    premultiplySSE2(in + i * 4, out + i * 4, count - i);
+}
+
+IMAGE_KERNELS_TARGET_AVX2
+void swizzleAVX2(const unsigned char* in, unsigned char* out, size_t count, const Swizzle& swizzle) {
+    alignas(32) int8_t control[32];
+    alignas(32) int8_t ones[32];
+    for (int p = 0; p < 8; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            int source = swizzle.source[c];
+            control[p * 4 + c] = static_cast<int8_t>(source < 4 ? (p % 4) * 4 + source : -128);
+            ones[p * 4 + c] = static_cast<int8_t>(source == 5 ? -1 : 0);
+        }
+    }
+    const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(control));
+    const __m256i constant = _mm256_load_si256(reinterpret_cast<const __m256i*>(ones));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 4));
+        __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(x, shuffle), constant);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), r);
+    }
+    swizzleScalar(in + i * 4, out + i * 4, count - i, swizzle);
+}
+
+IMAGE_KERNELS_TARGET_AVX2
+void verticalAVX2(const float* const* rows, const float* weights, int taps, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_setzero_ps();
+        __m256 b = _mm256_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            __m256 w = _mm256_set1_ps(weights[k]);
+            a = _mm256_fmadd_ps(w, _mm256_loadu_ps(rows[k] + i), a);
+            b = _mm256_fmadd_ps(w, _mm256_loadu_ps(rows[k] + i + 8), b);
+        }
+        _mm256_storeu_ps(out + i, a);
+        _mm256_storeu_ps(out + i + 8, b);
+    }
+    for (; i < n; ++i) {
+        float sum = 0.0f;
+        for (int k = 0; k < taps; ++k) sum += weights[k] * rows[k][i];
+        out[i] = sum;
+    }
+}
+
+// 一次两个输出像素，高低 128 位各放一个
+IMAGE_KERNELS_TARGET_AVX2
+void horizontal4AVX2(const float* in, const int* index, const float* weight, int taps, float* out, int dstWidth) {
+    int x = 0;
+    for (; x + 2 <= dstWidth; x += 2, index += 2 * taps, weight += 2 * taps) {
+        const int* indexB = index + taps;
+        const float* weightB = weight + taps;
+        __m256 sum = _mm256_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + static_cast<size_t>(index[k]) * 4)),
+                                            _mm_loadu_ps(in + static_cast<size_t>(indexB[k]) * 4), 1);
+            __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(weight[k])), _mm_set1_ps(weightB[k]), 1);
+            sum = _mm256_fmadd_ps(w, v, sum);
+        }
+        _mm256_storeu_ps(out + static_cast<size_t>(x) * 4, sum);
+    }
+    horizontal4SSE2(in, index, weight, taps, out + static_cast<size_t>(x) * 4, dstWidth - x);
+}
+
+#endif // IMAGE_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// 分发
+// ---------------------------------------------------------------------------
+
+typedef void (*ExpandFunc)(const unsigned char*, unsigned char*, size_t);
+typedef void (*PremultiplyFunc)(const unsigned char*, unsigned char*, size_t);
+typedef void (*SwizzleFunc)(const unsigned char*, unsigned char*, size_t, const Swizzle&);
+typedef void (*VerticalFunc)(const float* const*, const float*, int, float*, size_t);
+typedef void (*Horizontal4Func)(const float*, const int*, const float*, int, float*, int);
+
+struct KernelTable {
+    ExpandFunc expand;
+    PremultiplyFunc premultiply;
+    SwizzleFunc swizzle;
+    VerticalFunc vertical;
+    Horizontal4Func horizontal4;
+};
+
+const KernelTable kScalarTable = {
+    expandScalar, premultiplyScalar, swizzleScalar, verticalScalar, horizontal4Scalar
+};
+#if IMAGE_KERNELS_X86
+const KernelTable kSSE2Table = {
+    expandSSE2, premultiplySSE2, swizzleSSE2, verticalSSE2, horizontal4SSE2
+};
+const KernelTable kAVX2Table = {
+    expandAVX2, premultiplyAVX2, swizzleAVX2, verticalAVX2, horizontal4AVX2
+};
+#endif
+
+std::atomic<int>& activeLevelStorage() {
+    static std::atomic<int> level(static_cast<int>(MeshKernels::getDetectedLevel()));
+    return level;
+}
+
+const KernelTable& kernels() {
+    switch (static_cast<SimdLevel>(activeLevelStorage().load(std::memory_order_relaxed))) {
+#if IMAGE_KERNELS_X86
+        case SimdLevel::AVX2: return kAVX2Table;
+        case SimdLevel::SSE2: return kSSE2Table;
+#endif
+        default: return kScalarTable;
+    }
+}
+
+bool parseSwizzle(const char* pattern, Swizzle& swizzle) {
+    if (!pattern || std::strlen(pattern) != 4) return false;
+    const char* names = "rgba01";
+    for (int c = 0; c < 4; ++c) {
+        const char* found = std::strchr(names, pattern[c]);
+        if (!found || pattern[c] == '\0') return false;
+        swizzle.source[c] = static_cast<int>(found - names);
+    }
+    return true;
+}
+
+} // namespace
+
+ImageKernels::SimdLevel ImageKernels::getActiveLevel() {
+    return static_cast<SimdLevel>(activeLevelStorage().load());
+}
+
+void ImageKernels::setActiveLevel(SimdLevel level) {
+    SimdLevel clamped = std::min(level, MeshKernels::getDetectedLevel());
+    activeLevelStorage() = static_cast<int>(clamped);
+}
+
+void ImageKernels::expandRGBToRGBA(const unsigned char* rgb, unsigned char* rgba, size_t count) {
+    ExpandFunc expand = kernels().expand;
+    Parallel::forRange(count, kPixelsPerTask, [&](size_t begin, size_t end, unsigned int) {
+        expand(rgb + begin * 3, rgba + begin * 4, end - begin);
+    });
+}
+
+void ImageKernels::premultiplyAlpha(const unsigned char* in, unsigned char* out, size_t count) {
+    PremultiplyFunc premultiply = kernels().premultiply;
+    Parallel::forRange(count, kPixelsPerTask, [&](size_t begin, size_t end, unsigned int) {
+        premultiply(in + begin * 4, out + begin * 4, end - begin);
+    });
+}
+
+bool ImageKernels::swizzle(const unsigned char* in, unsigned char* out, size_t count, const char* pattern) {
+    Swizzle parsed;
+    if (!parseSwizzle(pattern, parsed)) return false;
+    SwizzleFunc swizzleFunc = kernels().swizzle;
+    Parallel::forRange(count, kPixelsPerTask, [&](size_t begin, size_t end, unsigned int) {
+        swizzleFunc(in + begin * 4, out + begin * 4, end - begin, parsed);
+    });
+    return true;
+}
+
+int ImageKernels::getMipLevelCount(int width, int height) {
+    int count = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        ++count;
+    }
+    return count;
+}
+
+void ImageKernels::downsample(const unsigned char* src, int width, int height, int channels,
+                              unsigned char* dst, const MipOptions& options) {
+    const int dstWidth = std::max(1, width / 2);
+    const int dstHeight = std::max(1, height / 2);
+    const FilterTaps columns = buildTaps(width, dstWidth, options);
+    const FilterTaps rows = buildTaps(height, dstHeight, options);
+    const KernelTable& k = kernels();
+
+    const GammaTables& gamma = gammaTables();
+    const int alpha = channels == 4 ? 3 : channels == 2 ? 1 : -1;
+    const float* decode[4];
+    bool srgb[4];
+    for (int c = 0; c < 4; ++c) {
+        srgb[c] = options.srgb && c != alpha;
+        decode[c] = srgb[c] ? gamma.toLinear : gamma.identity;
+    }
+
+    const size_t srcRowBytes = static_cast<size_t>(width) * channels;
+    const size_t dstRowBytes = static_cast<size_t>(dstWidth) * channels;
+    Parallel::forRange(static_cast<size_t>(dstHeight), kRowsPerBatch, [&](size_t begin, size_t end, unsigned int) {
+        std::vector<int> slot(static_cast<size_t>(height), -1);   // 源行在 cache 中的位置
+        std::vector<int> used;
+        std::vector<float> cache;
+        std::vector<float> column(srcRowBytes);
+        std::vector<float> line(dstRowBytes);
+        std::vector<const float*> taps(static_cast<size_t>(rows.count));
+
+        for (size_t batch = begin; batch < end; batch += kRowsPerBatch) {
+            const size_t batchEnd = std::min(end, batch + kRowsPerBatch);
+            for (int y : used) slot[y] = -1;
+            used.clear();
+            for (size_t y = batch; y < batchEnd; ++y) {
+                for (int t = 0; t < rows.count; ++t) {
+                    int s = rows.index[y * rows.count + t];
+                    if (slot[s] < 0) {
+                        slot[s] = static_cast<int>(used.size());
+                        used.push_back(s);
+                    }
+                }
+            }
+            cache.resize(used.size() * srcRowBytes);
+            for (size_t i = 0; i < used.size(); ++i) {
+                decodeRow(src + static_cast<size_t>(used[i]) * srcRowBytes, static_cast<size_t>(width), channels,
+                          decode, cache.data() + i * srcRowBytes);
+            }
+
+            for (size_t y = batch; y < batchEnd; ++y) {
+                for (int t = 0; t < rows.count; ++t) {
+                    taps[t] = cache.data() + static_cast<size_t>(slot[rows.index[y * rows.count + t]]) * srcRowBytes;
+                }
+                k.vertical(taps.data(), &rows.weight[y * rows.count], rows.count, column.data(), srcRowBytes);
+                if (channels == 4) {
+                    k.horizontal4(column.data(), columns.index.data(), columns.weight.data(), columns.count,
+                                  line.data(), dstWidth);
+                } else {
+                    horizontalScalar(column.data(), channels, columns.index.data(), columns.weight.data(),
+                                     columns.count, line.data(), dstWidth);
+                }
+                encodeRow(line.data(), static_cast<size_t>(dstWidth), channels, srgb, dst + y * dstRowBytes);
+            }
+        }
+    });
+}
+
+void ImageKernels::generateMipChain(std::vector<ImageLevel>& levels, int channels, const MipOptions& options) {
+    if (levels.empty() || levels[0].width <= 0 || levels[0].height <= 0) return;
+    levels.resize(static_cast<size_t>(getMipLevelCount(levels[0].width, levels[0].height)));
+    for (size_t i = 1; i < levels.size(); ++i) {
+        const ImageLevel& src = levels[i - 1];
+        ImageLevel& dst = levels[i];
+        dst.width = std::max(1, src.width / 2);
+        dst.height = std::max(1, src.height / 2);
+        dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * channels);
+        downsample(src.pixels.data(), src.width, src.height, channels, dst.pixels.data(), options);
+    }
+}
+
+const char* ImageKernels::getFilterName(MipFilter filter) {
+    switch (filter) {
+        case MipFilter::Box: return "box";
+        case MipFilter::Kaiser: return "kaiser";
+        default: return "unknown";
+    }
+}
@@ -1,4 +1,5 @@
 #include "mesh/Material.h"
+#include "mesh/TextureArrayPool.h"
 #include "shader/Shader.h"
 
 CMaterial::CMaterial() 
@@ -10,6 +11,9 @@ CMaterial::CMaterial()
       specularStrength(1.0f),
       opacity(1.0f),
       refractiveIndex(1.0f),
+      uvScale(1.0f),
+      uvOffset(0.0f),
+      textureLayer(-1),
       name("DefaultMaterial"),
       shader(nullptr) {
 }
@@ -23,6 +27,9 @@ CMaterial::CMaterial(const std::string& name)
       specularStrength(1.0f),
       opacity(1.0f),
       refractiveIndex(1.0f),
+      uvScale(1.0f),
+      uvOffset(0.0f),
+      textureLayer(-1),
       name(name),
       shader(nullptr) {
 }
@@ -36,6 +43,10 @@ CMaterial::CMaterial(const CMaterial& other) {
     specularStrength = other.specularStrength;
     opacity = other.opacity;
     refractiveIndex = other.refractiveIndex;
+    uvScale = other.uvScale;
+    uvOffset = other.uvOffset;
+    textureArray = other.textureArray;
+    textureLayer = other.textureLayer;
     name = other.name;
     shader = other.shader;
     
@@ -56,6 +67,10 @@ CMaterial& CMaterial::operator=(const CMaterial& other) {
         specularStrength = other.specularStrength;
         opacity = other.opacity;
         refractiveIndex = other.refractiveIndex;
+        uvScale = other.uvScale;
+        uvOffset = other.uvOffset;
+        textureArray = other.textureArray;
+        textureLayer = other.textureLayer;
         name = other.name;
         shader = other.shader;
         
@@ -123,6 +138,16 @@ void CMaterial::setProperties(float shininess, float specularStrength, float opa
     this->opacity = opacity;
 }
 
+void CMaterial::setUVTransform(const glm::vec2& scale, const glm::vec2& offset) {
+    uvScale = scale;
+    uvOffset = offset;
+}
+
+void CMaterial::setTextureLayer(std::shared_ptr<CTexture> array, int layer) {
+    textureArray = array;
+    textureLayer = array ? layer : -1;
+}
+
 void CMaterial::apply() const {
     if (!shader) return;
     
@@ -143,9 +168,21 @@ void CMaterial::applyToShader(CShader& targetShader) const {
     targetShader.setFloat("material.opacity", opacity);
     targetShader.setFloat("material.refractiveIndex", refractiveIndex);
     
+    // 图集子区域的纹理坐标变换，在顶点着色器中应用
+    targetShader.setBool("uvTransformEnabled", hasUVTransform());
+    targetShader.setVec4("uvTransform", glm::vec4(uvScale, uvOffset));
+    
     // 绑定纹理
     bindTextures(targetShader);
     
+    // 纹理数组绑定在专用纹理单元，层号通过顶点属性传入
+    targetShader.setBool("useTextureArray", hasTextureLayer());
+    if (hasTextureLayer()) {
+        textureArray->bind(TextureArrayPool::TextureUnit);
+        targetShader.setInt("diffuseArray", static_cast<int>(TextureArrayPool::TextureUnit));
+        TextureArrayPool::setDrawLayer(textureLayer);
+    }
+    
     // 设置是否有纹理的标志
     targetShader.setBool("material.hasTextures", !textures.empty());
     targetShader.setInt("material.textureCount", static_cast<int>(textures.size()));
@@ -1,163 +1,348 @@
 #include "mesh/Mesh.h"
+#include "core/GLState.h"
+#include "mesh/MeshKernels.h"
+#include "mesh/MeshUtils.h"
+#include "mesh/VertexFormat.h"
 #include "shader/Shader.h"
-#include <iostream>
+#include <algorithm>
+#include <atomic>
 
-CMesh::CMesh() 
-    : VAO(0), VBO(0), EBO(0), 
+namespace {
+// 所有存活几何数据因释放 CPU 数据而节省的字节数
+std::atomic<size_t> g_releasedCpuBytes(0);
+
+// 显存内复制缓冲区对象，不经过 CPU
+void copyBufferObject(GLuint source, GLuint& target, size_t bytes, GLenum hint) {
+    glGenBuffers(1, &target);
+    glBindBuffer(GL_COPY_READ_BUFFER, source);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, hint);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(bytes));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+// 按布局紧排顶点；布局与 Vertex 结构一致时直接返回原数组，不做拷贝
+const void* packVertices(const VertexAttributeLayout& layout, const Vertex* data, size_t count,
+                         const VertexFormat::PositionRange& range, std::vector<unsigned char>& scratch) {
+    if (VertexFormat::matchesVertex(layout)) return data;
+    scratch.resize(count * layout.stride);
+    VertexFormat::pack(layout, data, count, scratch.data(), range);
+    return scratch.data();
+}
+}
+
+CMesh::Geometry::Geometry()
+    : VAO(0), VBO(0), EBO(0),
+      vertexCount(0), indexCount(0),
+      vertexLayout(VertexAttributeLayout::PositionNormalTex()),
+      positionStream(false), positionVAO(0), positionVBO(0), positionCapacity(0),
+      initialized(false),
+      bufferUsage(BufferUsage::Static),
+      vboCapacity(0), eboCapacity(0),
+      arenaHandle(GeometryArena::InvalidHandle),
+      releasedBytes(0) {
+}
+
+CMesh::Geometry::~Geometry() {
+    if (VAO != 0) {
+        GLState::deleteVertexArray(VAO);
+    }
+    if (VBO != 0) {
+        glDeleteBuffers(1, &VBO);
+    }
+    if (EBO != 0) {
+        glDeleteBuffers(1, &EBO);
+    }
+    if (positionVAO != 0) {
+        GLState::deleteVertexArray(positionVAO);
+    }
+    if (positionVBO != 0) {
+        glDeleteBuffers(1, &positionVBO);
+    }
+    if (arena) {
+        arena->free(arenaHandle);
+    }
+    g_releasedCpuBytes -= releasedBytes;
+}
+
+void CMesh::Geometry::updateReleasedBytes() {
+    size_t bytes = 0;
+    if (vertices.size() != vertexCount) bytes += vertexCount * sizeof(Vertex);
+    if (indices.size() != indexCount) bytes += indexCount * sizeof(unsigned int);
+    g_releasedCpuBytes -= releasedBytes;
+    g_releasedCpuBytes += bytes;
+    releasedBytes = bytes;
+}
+
+void CMesh::Geometry::updatePositionRange() {
+    // 量化范围只在整体上传时更新；局部更新沿用原范围，超出部分被截断
+    if (VertexFormat::hasQuantizedPositions(vertexLayout) && vertices.size() == vertexCount) {
+        positionRange = VertexFormat::computePositionRange(vertices.data(), vertices.size());
+    }
+}
+
+std::shared_ptr<CMesh::Geometry> CMesh::emptyGeometry() {
+    // 从不初始化：任何写操作都会先 detachGeometry()
+    static const std::shared_ptr<Geometry> empty = std::make_shared<Geometry>();
+    return empty;
+}
+
+CMesh::CMesh()
+    : geometry(emptyGeometry()),
       primitiveType(PrimitiveType::Triangles),
       material(nullptr),
-      initialized(false) {
-    vertexLayout = VertexAttributeLayout::PositionNormalTex();
+      releaseAfterUpload(false) {
 }
 
 CMesh::CMesh(const std::vector<Vertex>& vertices, PrimitiveType primitive)
-    : VAO(0), VBO(0), EBO(0),
-      vertices(vertices), indices(),
+    : CMesh(std::vector<Vertex>(vertices), primitive) {
+}
+
+CMesh::CMesh(std::vector<Vertex>&& vertices, PrimitiveType primitive)
+    : geometry(std::make_shared<Geometry>()),
       primitiveType(primitive),
       material(nullptr),
-      initialized(false) {
-    vertexLayout = VertexAttributeLayout::PositionNormalTex();
+      releaseAfterUpload(false) {
+    geometry->vertices = std::move(vertices);
+    geometry->vertexCount = geometry->vertices.size();
     initialize();
 }
 
 CMesh::CMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, PrimitiveType primitive)
-    : VAO(0), VBO(0), EBO(0),
-      vertices(vertices), indices(indices),
+    : CMesh(std::vector<Vertex>(vertices), std::vector<unsigned int>(indices), primitive) {
+}
+
+CMesh::CMesh(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices, PrimitiveType primitive)
+    : geometry(std::make_shared<Geometry>()),
       primitiveType(primitive),
       material(nullptr),
-      initialized(false) {
-    vertexLayout = VertexAttributeLayout::PositionNormalTex();
+      releaseAfterUpload(false) {
+    geometry->vertices = std::move(vertices);
+    geometry->indices = std::move(indices);
+    geometry->vertexCount = geometry->vertices.size();
+    geometry->indexCount = geometry->indices.size();
     initialize();
 }
 
+CMesh::CMesh(const VertexAttributeLayout& layout, const void* packedVertices, size_t vertexCount,
+             const unsigned int* indices, size_t indexCount, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+             PrimitiveType primitive)
+    : geometry(std::make_shared<Geometry>()),
+      primitiveType(primitive),
+      material(nullptr),
+      releaseAfterUpload(false) {
+    Geometry& g = *geometry;
+    g.vertexLayout = layout;
+    g.vertexCount = vertexCount;
+    g.indexCount = indices ? indexCount : 0;
+    g.boundingBox = BoundingBox(boundsMin, boundsMax);
+    
+    // 从调用方的存储直接写入独立缓冲区，不经过 vertices / indices 数组
+    glGenVertexArrays(1, &g.VAO);
+    uploadOwnedBuffer(GL_ARRAY_BUFFER, g.VBO, g.vboCapacity, packedVertices, vertexCount * layout.stride);
+    if (hasIndices()) {
+        uploadOwnedBuffer(GL_ELEMENT_ARRAY_BUFFER, g.EBO, g.eboCapacity, indices, g.indexCount * sizeof(unsigned int));
+    }
+    
+    GLState::bindVertexArray(g.VAO);
+    setupVertexAttributes();
+    GLState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    g.initialized = true;
+    g.updateReleasedBytes();
+}
+
 CMesh::~CMesh() {
-    cleanup();
+    // GPU 对象随最后一个引用的 Geometry 一起释放
 }
 
-CMesh::CMesh(const CMesh& other) 
-    : VAO(0), VBO(0), EBO(0),
-      vertices(other.vertices),
-      indices(other.indices),
-      vertexLayout(other.vertexLayout),
+CMesh::CMesh(const CMesh& other)
+    : geometry(other.geometry),
       primitiveType(other.primitiveType),
       material(other.material),
-      boundingBox(other.boundingBox),
-      initialized(false) {
-    initialize();
+      releaseAfterUpload(other.releaseAfterUpload) {
 }
 
 CMesh& CMesh::operator=(const CMesh& other) {
     if (this != &other) {
-        cleanup();
-        
-        vertices = other.vertices;
-        indices = other.indices;
-        vertexLayout = other.vertexLayout;
+        geometry = other.geometry;
         primitiveType = other.primitiveType;
         material = other.material;
-        boundingBox = other.boundingBox;
-        initialized = false;
-        
-        initialize();
+        releaseAfterUpload = other.releaseAfterUpload;
     }
     return *this;
 }
 
-CMesh::CMesh(CMesh&& other) noexcept 
-    : VAO(other.VAO), VBO(other.VBO), EBO(other.EBO),
-      vertices(std::move(other.vertices)),
-      indices(std::move(other.indices)),
-      vertexLayout(other.vertexLayout),
+CMesh::CMesh(CMesh&& other) noexcept
+    : geometry(std::move(other.geometry)),
       primitiveType(other.primitiveType),
-      material(other.material),
-      boundingBox(other.boundingBox),
-      initialized(other.initialized) {
-    
-    other.VAO = 0;
-    other.VBO = 0;
-    other.EBO = 0;
-    other.initialized = false;
+      material(std::move(other.material)),
+      releaseAfterUpload(other.releaseAfterUpload) {
+    other.geometry = emptyGeometry();
 }
 
 CMesh& CMesh::operator=(CMesh&& other) noexcept {
     if (this != &other) {
-        cleanup();
-        
-        VAO = other.VAO;
-        VBO = other.VBO;
-        EBO = other.EBO;
-        vertices = std::move(other.vertices);
-        indices = std::move(other.indices);
-        vertexLayout = other.vertexLayout;
+        geometry = std::move(other.geometry);
         primitiveType = other.primitiveType;
-        material = other.material;
-        boundingBox = other.boundingBox;
-        initialized = other.initialized;
-        
-        other.VAO = 0;
-        other.VBO = 0;
-        other.EBO = 0;
-        other.initialized = false;
+        material = std::move(other.material);
+        releaseAfterUpload = other.releaseAfterUpload;
+        other.geometry = emptyGeometry();
     }
     return *this;
 }
 
+void CMesh::detachGeometry() {
+    if (geometry.use_count() <= 1) return;
+    
+    std::shared_ptr<Geometry> source = geometry;
+    geometry = std::make_shared<Geometry>();
+    Geometry& g = *geometry;
+    
+    g.vertices = source->vertices;
+    g.indices = source->indices;
+    g.vertexCount = source->vertexCount;
+    g.indexCount = source->indexCount;
+    g.vertexLayout = source->vertexLayout;
+    g.boundingBox = source->boundingBox;
+    g.positionRange = source->positionRange;
+    g.positionStream = source->positionStream;
+    g.bufferUsage = source->bufferUsage;
+    g.streamingBuffer = source->streamingBuffer;
+    g.arena = source->arena;
+    
+    if (!source->initialized) return;
+    
+    if (source->positionVBO != 0 && source->positionCapacity > 0) {
+        // 位置流总是独立缓冲区，不论主数据在哪里都在显存内复制
+        GLenum hint = g.bufferUsage == BufferUsage::Static ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+        copyBufferObject(source->positionVBO, g.positionVBO, source->positionCapacity, hint);
+        g.positionCapacity = source->positionCapacity;
+        setupPositionAttributes();
+    }
+    
+    if (source->arena && source->arena->isValid(source->arenaHandle)) {
+        // Arena 内复制一份区间
+        g.arenaHandle = g.arena->duplicate(source->arenaHandle);
+        g.initialized = true;
+        g.updateReleasedBytes();
+        return;
+    }
+    
+    glGenVertexArrays(1, &g.VAO);
+    if (source->streamVertices.isValid()) {
+        // 环形缓冲区中的数据只读，两份几何数据可以引用同一段分配
+        g.streamVertices = source->streamVertices;
+        g.streamIndices = source->streamIndices;
+    } else {
+        // CPU 数据可能已释放，直接在显存内复制，连同预留容量一起
+        GLenum hint = g.bufferUsage == BufferUsage::Static ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+        if (source->VBO != 0 && source->vboCapacity > 0) {
+            copyBufferObject(source->VBO, g.VBO, source->vboCapacity, hint);
+            g.vboCapacity = source->vboCapacity;
+        }
+        if (source->EBO != 0 && source->eboCapacity > 0) {
+            copyBufferObject(source->EBO, g.EBO, source->eboCapacity, hint);
+            g.eboCapacity = source->eboCapacity;
+        }
+    }
+    
+    GLState::bindVertexArray(g.VAO);
+    setupVertexAttributes();
+    if (g.streamVertices.isValid() && hasIndices()) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g.streamingBuffer->getBuffer());
+    } else if (g.EBO != 0) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g.EBO);
+    }
+    GLState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    g.initialized = true;
+    g.updateReleasedBytes();
+}
+
 void CMesh::setVertices(const std::vector<Vertex>& newVertices) {
-    vertices = newVertices;
-    if (!initialized) {
+    setVertices(std::vector<Vertex>(newVertices));
+}
+
+void CMesh::setVertices(std::vector<Vertex>&& newVertices) {
+    if (!geometry->initialized) {
+        detachGeometry();
+        geometry->vertices = std::move(newVertices);
+        geometry->vertexCount = geometry->vertices.size();
         initialize();
     } else {
-        updateVertexData(newVertices);
+        updateVertexData(std::move(newVertices));
     }
 }
 
 void CMesh::setIndices(const std::vector<unsigned int>& newIndices) {
-    indices = newIndices;
-    if (!initialized) {
+    setIndices(std::vector<unsigned int>(newIndices));
+}
+
+void CMesh::setIndices(std::vector<unsigned int>&& newIndices) {
+    if (!geometry->initialized) {
+        detachGeometry();
+        geometry->indices = std::move(newIndices);
+        geometry->indexCount = geometry->indices.size();
         initialize();
     } else {
-        updateIndexData(newIndices);
+        updateIndexData(std::move(newIndices));
     }
 }
 
-void CMesh::setVertexLayout(const VertexAttributeLayout& layout) {
-    vertexLayout = layout;
-    if (initialized) {
+bool CMesh::setVertexLayout(const VertexAttributeLayout& layout) {
+    if (VertexFormat::sameFormat(geometry->vertexLayout, layout)) return true;
+    // GPU 端按布局紧排，换布局需要从 CPU 数据重新打包
+    if (geometry->initialized && geometry->isCpuDataReleased()) return false;
+    
+    detachGeometry();
+    Geometry& g = *geometry;
+    g.vertexLayout = layout;
+    if (!g.initialized) return true;
+    
+    if (usesArena()) {
+        // 不同布局位于不同的 Arena 缓冲区
+        g.arena->setLayout(g.arenaHandle, layout);
+        uploadToArena(true, false);
+        uploadPositionStream();
+    } else {
+        uploadVertexBuffer();
+        GLState::bindVertexArray(g.VAO);
         setupVertexAttributes();
+        GLState::bindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
+    return true;
 }
 
 void CMesh::bind() const {
-    if (initialized) {
-        glBindVertexArray(VAO);
+    if (usesArena()) {
+        geometry->arena->bind(geometry->arenaHandle);
+    } else if (geometry->initialized) {
+        GLState::bindVertexArray(geometry->VAO);
     }
 }
 
 void CMesh::unbind() const {
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
 
 void CMesh::draw() const {
-    if (!initialized || vertices.empty()) return;
+    if (!geometry->initialized || geometry->vertexCount == 0) return;
     
     // 如果有材质且材质有shader，使用材质的shader
     if (material && material->hasShader()) {
         material->apply();  // 使用内置shader并应用材质参数
     }
     
-    bind();
-    
-    if (hasIndices()) {
-        glDrawElements(static_cast<GLenum>(primitiveType), static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
-    } else {
-        glDrawArrays(static_cast<GLenum>(primitiveType), 0, static_cast<GLsizei>(vertices.size()));
-    }
-    
-    unbind();
+    drawElementsOrArrays(0);
 }
 
 void CMesh::draw(CShader& shader) const {
-    if (!initialized || vertices.empty()) return;
+    if (!geometry->initialized || geometry->vertexCount == 0) return;
     
     // 使用指定的shader
     shader.use();
@@ -166,199 +351,693 @@ void CMesh::draw(CShader& shader) const {
     if (material) {
         material->applyToShader(shader);
     }
+    applyPositionDequantization(shader);
     
-    bind();
+    drawElementsOrArrays(0);
+}
+
+void CMesh::applyPositionDequantization(const CShader& shader) const {
+    bool quantized = VertexFormat::hasQuantizedPositions(geometry->vertexLayout);
+    shader.setBool("positionQuantized", quantized);
+    if (quantized) {
+        shader.setVec3("positionScale", geometry->positionRange.scale);
+        shader.setVec3("positionBias", geometry->positionRange.bias);
+    }
+}
+
+bool CMesh::setPositionStreamEnabled(bool enabled) {
+    if (enabled == geometry->positionStream) return true;
+    if (enabled) {
+        // 环形缓冲区中的数据每帧重新分配，位置流无法跟随；位置流需要从 CPU 数据打包
+        if (geometry->bufferUsage == BufferUsage::Stream) return false;
+        if (geometry->initialized && geometry->isCpuDataReleased()) return false;
+    }
     
+    detachGeometry();
+    Geometry& g = *geometry;
+    g.positionStream = enabled;
+    if (!enabled) {
+        deletePositionStream();
+    } else if (g.initialized) {
+        uploadPositionStream();
+    }
+    return true;
+}
+
+size_t CMesh::getPositionStreamStride() const {
+    if (!geometry->positionStream) return 0;
+    return VertexFormat::getPositionLayout(geometry->vertexLayout).stride;
+}
+
+void CMesh::drawInstanced(unsigned int instanceCount) const {
+    if (!geometry->initialized || geometry->vertexCount == 0) return;
+    
+    drawElementsOrArrays(instanceCount);
+}
+
+void CMesh::drawPositionsOnly() const {
+    const Geometry& g = *geometry;
+    if (!g.initialized || g.vertexCount == 0) return;
+    if (g.positionVAO == 0) {
+        drawElementsOrArrays(0);
+        return;
+    }
+    
+    GLenum mode = static_cast<GLenum>(primitiveType);
+    GLState::bindVertexArray(g.positionVAO);
     if (hasIndices()) {
-        glDrawElements(static_cast<GLenum>(primitiveType), static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+        GLintptr indexOffset = bindPositionIndexBuffer();
+        glDrawElements(mode, static_cast<GLsizei>(g.indexCount), GL_UNSIGNED_INT, (void*)indexOffset);
     } else {
-        glDrawArrays(static_cast<GLenum>(primitiveType), 0, static_cast<GLsizei>(vertices.size()));
+        glDrawArrays(mode, 0, static_cast<GLsizei>(g.vertexCount));
+    }
+}
+
+bool CMesh::drawPositionsOnlyMulti(unsigned int drawCount) const {
+    const Geometry& g = *geometry;
+    if (!g.initialized || g.positionVAO == 0 || !hasIndices()) return false;
+    if (drawCount == 0) return true;
+    
+    GLState::bindVertexArray(g.positionVAO);
+    GLintptr indexOffset = bindPositionIndexBuffer();
+    
+    // 每次绘制的索引区间相同，gl_DrawIDARB 按绘制次序从 0 递增
+    std::vector<GLsizei> counts(drawCount, static_cast<GLsizei>(g.indexCount));
+    std::vector<const void*> offsets(drawCount, (const void*)indexOffset);
+    glMultiDrawElements(static_cast<GLenum>(primitiveType), counts.data(), GL_UNSIGNED_INT, offsets.data(),
+                        static_cast<GLsizei>(drawCount));
+    return true;
+}
+
+GLintptr CMesh::bindPositionIndexBuffer() const {
+    const Geometry& g = *geometry;
+    
+    // 索引缓冲区会随 Arena 扩容、整理或改回独立缓冲区而更换，绘制前按当前位置重新绑定
+    // Arena 中的索引相对网格自身的 baseVertex，而位置流从第 0 个顶点开始，无需偏移
+    GLuint indexBuffer = g.EBO;
+    GLintptr indexOffset = 0;
+    if (usesArena()) {
+        indexBuffer = g.arena->getIndexBuffer(g.arenaHandle);
+        indexOffset = static_cast<GLintptr>(g.arena->getRange(g.arenaHandle).firstIndex * sizeof(unsigned int));
     }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    return indexOffset;
+}
+
+void CMesh::drawRange(size_t first, size_t count) const {
+    if (!geometry->initialized || geometry->vertexCount == 0 || count == 0) return;
     
-    unbind();
+    drawElementsOrArrays(0, first, count);
 }
 
-void CMesh::drawInstanced(unsigned int instanceCount) const {
-    if (!initialized || vertices.empty()) return;
+void CMesh::drawElementsOrArrays(unsigned int instanceCount, size_t first, size_t count) const {
+    const Geometry& g = *geometry;
+    GLenum mode = static_cast<GLenum>(primitiveType);
+    
+    // 超出数据范围的部分截断
+    size_t total = hasIndices() ? g.indexCount : g.vertexCount;
+    if (first >= total) return;
+    count = std::min(count, total - first);
+    
+    if (usesArena()) {
+        g.arena->drawRange(g.arenaHandle, mode, first, count, instanceCount);
+        return;
+    }
+    
+    // Stream 模式的区间只受写入帧的 fence 保护，每帧第一次绘制时从 CPU 数据重新上传
+    GLintptr indexOffset = 0;
+    if (g.bufferUsage == BufferUsage::Stream && g.streamVertices.isValid()) {
+        if (!g.streamingBuffer->isCurrentFrame(g.streamVertices) ||
+            (hasIndices() && !g.streamingBuffer->isCurrentFrame(g.streamIndices))) {
+            if (!uploadStream()) return;
+        }
+        indexOffset = g.streamIndices.offset;
+    }
     
     bind();
     
     if (hasIndices()) {
-        glDrawElementsInstanced(static_cast<GLenum>(primitiveType), static_cast<GLsizei>(indices.size()), 
-                              GL_UNSIGNED_INT, 0, instanceCount);
+        GLsizei indexCount = static_cast<GLsizei>(count);
+        indexOffset += static_cast<GLintptr>(first * sizeof(unsigned int));
+        if (instanceCount > 0) {
+            glDrawElementsInstanced(mode, indexCount, GL_UNSIGNED_INT, (void*)indexOffset, instanceCount);
+        } else {
+            glDrawElements(mode, indexCount, GL_UNSIGNED_INT, (void*)indexOffset);
+        }
     } else {
-        glDrawArraysInstanced(static_cast<GLenum>(primitiveType), 0, static_cast<GLsizei>(vertices.size()), instanceCount);
+        GLint firstVertex = static_cast<GLint>(first);
+        GLsizei vertexCount = static_cast<GLsizei>(count);
+        if (instanceCount > 0) {
+            glDrawArraysInstanced(mode, firstVertex, vertexCount, instanceCount);
+        } else {
+            glDrawArrays(mode, firstVertex, vertexCount);
+        }
     }
-    
-    unbind();
 }
 
 void CMesh::updateVertexData(const std::vector<Vertex>& newVertices) {
-    vertices = newVertices;
+    if (&newVertices == &geometry->vertices) {
+        // 原地修改后重新上传（如 calculateNormals），无需拷贝
+        geometry->vertexCount = geometry->vertices.size();
+        if (geometry->initialized) {
+            uploadVertexBuffer();
+        }
+        afterUpload();
+        return;
+    }
+    updateVertexData(std::vector<Vertex>(newVertices));
+}
+
+void CMesh::updateVertexData(std::vector<Vertex>&& newVertices) {
+    detachGeometry();
+    geometry->vertices = std::move(newVertices);
+    geometry->vertexCount = geometry->vertices.size();
     
-    if (initialized) {
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (geometry->initialized) {
+        uploadVertexBuffer();
     }
+    afterUpload();
 }
 
 void CMesh::updateIndexData(const std::vector<unsigned int>& newIndices) {
-    indices = newIndices;
+    if (&newIndices == &geometry->indices) {
+        geometry->indexCount = geometry->indices.size();
+        if (geometry->initialized) {
+            uploadIndexBuffer();
+        }
+        afterUpload();
+        return;
+    }
+    updateIndexData(std::vector<unsigned int>(newIndices));
+}
+
+void CMesh::updateIndexData(std::vector<unsigned int>&& newIndices) {
+    detachGeometry();
+    geometry->indices = std::move(newIndices);
+    geometry->indexCount = geometry->indices.size();
     
-    if (initialized && hasIndices()) {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    if (geometry->initialized) {
+        uploadIndexBuffer();
     }
+    afterUpload();
 }
 
-void CMesh::calculateBoundingBox() {
-    if (vertices.empty()) {
-        boundingBox = BoundingBox();
-        return;
+bool CMesh::updateVertexRange(size_t first, const Vertex* data, size_t count) {
+    if (!data || count == 0 || first + count > geometry->vertexCount) return false;
+    
+    detachGeometry();
+    Geometry& g = *geometry;
+    
+    // CPU 数据已释放时只更新 GPU 端
+    if (g.vertices.size() == g.vertexCount) {
+        std::copy(data, data + count, g.vertices.begin() + first);
     }
+    if (!g.initialized) return true;
     
-    glm::vec3 minPos = vertices[0].position;
-    glm::vec3 maxPos = vertices[0].position;
+    if (g.bufferUsage == BufferUsage::Stream && g.streamVertices.isValid()) {
+        // 环中的旧区间可能仍在被 GPU 读取，不能原地修改，整体重新分配
+        return uploadStream();
+    }
     
-    for (const auto& vertex : vertices) {
-        minPos = glm::min(minPos, vertex.position);
-        maxPos = glm::max(maxPos, vertex.position);
+    // 只打包更新的区间
+    std::vector<unsigned char> scratch;
+    const void* packed = packVertices(g.vertexLayout, data, count, g.positionRange, scratch);
+    bool uploaded = true;
+    if (usesArena()) {
+        uploaded = g.arena->uploadVertices(g.arenaHandle, first, packed, count);
+    } else {
+        size_t stride = g.vertexLayout.stride;
+        glBindBuffer(GL_ARRAY_BUFFER, g.VBO);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(first * stride),
+                        static_cast<GLsizeiptr>(count * stride), packed);
     }
     
-    boundingBox = BoundingBox(minPos, maxPos);
+    if (g.positionVBO != 0) {
+        VertexAttributeLayout positionLayout = VertexFormat::getPositionLayout(g.vertexLayout);
+        scratch.resize(count * positionLayout.stride);
+        VertexFormat::pack(positionLayout, data, count, scratch.data(), g.positionRange);
+        glBindBuffer(GL_ARRAY_BUFFER, g.positionVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(first * positionLayout.stride),
+                        static_cast<GLsizeiptr>(scratch.size()), scratch.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return uploaded;
 }
 
-void CMesh::calculateNormals() {
-    // 简单的法线计算 - 为每个面计算法线
-    if (hasIndices()) {
-        // 基于索引的法线计算
-        for (size_t i = 0; i < indices.size(); i += 3) {
-            if (i + 2 >= indices.size()) break;
-            
-            const Vertex& v0 = vertices[indices[i]];
-            const Vertex& v1 = vertices[indices[i + 1]];
-            const Vertex& v2 = vertices[indices[i + 2]];
-            
-            glm::vec3 edge1 = v1.position - v0.position;
-            glm::vec3 edge2 = v2.position - v0.position;
-            glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
-            
-            // 将法线应用到三个顶点
-            const_cast<Vertex&>(v0).normal = normal;
-            const_cast<Vertex&>(v1).normal = normal;
-            const_cast<Vertex&>(v2).normal = normal;
-        }
+bool CMesh::updateIndexRange(size_t first, const unsigned int* data, size_t count) {
+    if (!data || count == 0 || first + count > geometry->indexCount) return false;
+    
+    detachGeometry();
+    Geometry& g = *geometry;
+    
+    if (g.indices.size() == g.indexCount) {
+        std::copy(data, data + count, g.indices.begin() + first);
+    }
+    if (!g.initialized) return true;
+    
+    if (usesArena()) {
+        return g.arena->uploadIndices(g.arenaHandle, first, data, count);
+    }
+    if (g.bufferUsage == BufferUsage::Stream && g.streamVertices.isValid()) {
+        return uploadStream();
+    }
+    
+    GLState::bindVertexArray(g.VAO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g.EBO);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(first * sizeof(unsigned int)),
+                    static_cast<GLsizeiptr>(count * sizeof(unsigned int)), data);
+    GLState::bindVertexArray(0);
+    return true;
+}
+
+void CMesh::setReleaseCpuDataAfterUpload(bool release) {
+    releaseAfterUpload = release;
+    if (release && geometry->initialized) {
+        releaseCpuData();
+    }
+}
+
+bool CMesh::releaseCpuData() {
+    Geometry& g = *geometry;
+    // Stream 模式在环形缓冲区被覆盖后需要 CPU 数据补传
+    if (!g.initialized || g.bufferUsage == BufferUsage::Stream) return false;
+    
+    std::vector<Vertex>().swap(g.vertices);
+    std::vector<unsigned int>().swap(g.indices);
+    g.updateReleasedBytes();
+    return true;
+}
+
+size_t CMesh::getCpuMemoryUsage() const {
+    return geometry->vertices.capacity() * sizeof(Vertex) +
+           geometry->indices.capacity() * sizeof(unsigned int);
+}
+
+size_t CMesh::getTotalReleasedCpuBytes() {
+    return g_releasedCpuBytes.load();
+}
+
+void CMesh::afterUpload() {
+    if (releaseAfterUpload && geometry->initialized) {
+        releaseCpuData();
     } else {
-        // 基于顶点的法线计算
-        for (size_t i = 0; i < vertices.size(); i += 3) {
-            if (i + 2 >= vertices.size()) break;
-            
-            Vertex& v0 = vertices[i];
-            Vertex& v1 = vertices[i + 1];
-            Vertex& v2 = vertices[i + 2];
-            
-            glm::vec3 edge1 = v1.position - v0.position;
-            glm::vec3 edge2 = v2.position - v0.position;
-            glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
-            
-            v0.normal = normal;
-            v1.normal = normal;
-            v2.normal = normal;
-        }
+        geometry->updateReleasedBytes();
     }
 }
 
-void CMesh::calculateTangentsAndBitangents() {
-    // TODO: 实现切线和副切线计算
-    // 这需要基于纹理坐标和位置来计算
-    std::cout << "Tangent calculation not yet implemented" << std::endl;
+void CMesh::setBufferUsage(BufferUsage usage, std::shared_ptr<StreamingBuffer> stream) {
+    detachGeometry();
+    Geometry& g = *geometry;
+    
+    if (g.arena || g.isCpuDataReleased()) {
+        // Arena 中的缓冲区由所有网格共享；释放后没有 CPU 数据可供重新上传
+        // 两种情况都只记录更新方式，不能切换到 Stream
+        if (usage != BufferUsage::Stream) g.bufferUsage = usage;
+        return;
+    }
+    
+    g.bufferUsage = usage;
+    g.streamingBuffer = stream;
+    if (usage == BufferUsage::Stream) {
+        // Stream 模式不保留位置流
+        g.positionStream = false;
+        deletePositionStream();
+    }
+    
+    if (!g.initialized) return;
+    
+    uploadVertexBuffer();
+    if (usesStreaming()) {
+        // 数据已全部进入环形缓冲区，释放独立的 VBO / EBO
+        if (g.VBO != 0) { glDeleteBuffers(1, &g.VBO); g.VBO = 0; g.vboCapacity = 0; }
+        if (g.EBO != 0) { glDeleteBuffers(1, &g.EBO); g.EBO = 0; g.eboCapacity = 0; }
+    } else {
+        uploadIndexBuffer();
+    }
 }
 
-void CMesh::initialize() {
-    if (initialized) return;
+bool CMesh::setGeometryArena(std::shared_ptr<GeometryArena> arena) {
+    detachGeometry();
+    Geometry& g = *geometry;
+    if (arena == g.arena) return true;
+    if (g.bufferUsage == BufferUsage::Stream) return false;
+    
+    if (!g.initialized) {
+        // 首次上传时直接分配到 Arena
+        g.arena = arena;
+        return true;
+    }
     
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
+    if (!arena) {
+        // 离开 Arena：从 CPU 数据上传到独立缓冲区
+        if (g.isCpuDataReleased()) return false;
+        g.arena->free(g.arenaHandle);
+        g.arena.reset();
+        g.arenaHandle = GeometryArena::InvalidHandle;
     
-    if (!vertices.empty()) {
-        glBindVertexArray(VAO);
-        
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-        
+        glGenVertexArrays(1, &g.VAO);
+        std::vector<unsigned char> scratch;
+        g.updatePositionRange();
+        const void* packed = packVertices(g.vertexLayout, g.vertices.data(), g.vertexCount, g.positionRange, scratch);
+        uploadOwnedBuffer(GL_ARRAY_BUFFER, g.VBO, g.vboCapacity, packed, g.vertexCount * g.vertexLayout.stride);
         if (hasIndices()) {
-            glGenBuffers(1, &EBO);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+            uploadOwnedBuffer(GL_ELEMENT_ARRAY_BUFFER, g.EBO, g.eboCapacity, g.indices.data(), g.indexCount * sizeof(unsigned int));
         }
-        
+        GLState::bindVertexArray(g.VAO);
         setupVertexAttributes();
-        
-        glBindVertexArray(0);
+        GLState::bindVertexArray(0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return true;
+    }
+    
+    GeometryArena::Handle handle = GeometryArena::InvalidHandle;
+    if (g.vertexCount > 0) {
+        handle = arena->allocate(g.vertexLayout, g.vertexCount, g.indexCount);
+        if (handle == GeometryArena::InvalidHandle) return false;
+    
+        // 数据来自独立缓冲区或另一个 Arena，都在显存内复制，不需要 CPU 数据
+        GLuint sourceVertices = g.VBO;
+        GLuint sourceIndices = g.EBO;
+        GLintptr vertexOffset = 0;
+        GLintptr indexOffset = 0;
+        if (usesArena()) {
+            GeometryArena::Range range = g.arena->getRange(g.arenaHandle);
+            sourceVertices = g.arena->getVertexBuffer(g.arenaHandle);
+            sourceIndices = g.arena->getIndexBuffer(g.arenaHandle);
+            vertexOffset = static_cast<GLintptr>(range.baseVertex * g.vertexLayout.stride);
+            indexOffset = static_cast<GLintptr>(range.firstIndex * sizeof(unsigned int));
+        }
+        arena->copyVertices(handle, sourceVertices, vertexOffset, g.vertexCount);
         if (hasIndices()) {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            arena->copyIndices(handle, sourceIndices, indexOffset, g.indexCount);
         }
     }
     
-    calculateBoundingBox();
-    initialized = true;
-}
-
-void CMesh::setupVertexAttributes() {
-    // 使用实际的 Vertex 结构大小作为 stride，而不是 layout 计算的值
-    // 因为 Vertex 结构可能包含额外的属性（如 tangent, bitangent）
-    GLsizei actualStride = sizeof(Vertex);
-    
-    for (const auto& attr : vertexLayout.attributes) {
-        switch (attr.type) {
-            case VertexAttribute::Position:
-                glVertexAttribPointer(static_cast<GLuint>(attr.type), attr.count, GL_FLOAT, GL_FALSE, actualStride, (void*)attr.offset);
-                glEnableVertexAttribArray(static_cast<GLuint>(attr.type));
-                break;
-            case VertexAttribute::Normal:
-                glVertexAttribPointer(static_cast<GLuint>(attr.type), attr.count, GL_FLOAT, GL_FALSE, actualStride, (void*)attr.offset);
-                glEnableVertexAttribArray(static_cast<GLuint>(attr.type));
-                break;
-            case VertexAttribute::TexCoords:
-                glVertexAttribPointer(static_cast<GLuint>(attr.type), attr.count, GL_FLOAT, GL_FALSE, actualStride, (void*)attr.offset);
-                glEnableVertexAttribArray(static_cast<GLuint>(attr.type));
-                break;
-            case VertexAttribute::Tangent:
-                glVertexAttribPointer(static_cast<GLuint>(attr.type), attr.count, GL_FLOAT, GL_FALSE, actualStride, (void*)attr.offset);
-                glEnableVertexAttribArray(static_cast<GLuint>(attr.type));
-                break;
-            case VertexAttribute::Bitangent:
-                glVertexAttribPointer(static_cast<GLuint>(attr.type), attr.count, GL_FLOAT, GL_FALSE, actualStride, (void*)attr.offset);
-                glEnableVertexAttribArray(static_cast<GLuint>(attr.type));
-                break;
-            default:
-                break;
+    if (g.arena) {
+        g.arena->free(g.arenaHandle);
+    }
+    deleteOwnedObjects();
+    g.arena = arena;
+    g.arenaHandle = handle;
+    return true;
+}
+
+bool CMesh::uploadToArena(bool uploadVertices, bool uploadIndices) {
+    Geometry& g = *geometry;
+    
+    if (g.vertexCount == 0) {
+        g.arena->free(g.arenaHandle);
+        g.arenaHandle = GeometryArena::InvalidHandle;
+        return true;
+    }
+    
+    if (!g.arena->isValid(g.arenaHandle)) {
+        g.arenaHandle = g.arena->allocate(g.vertexLayout, g.vertexCount, g.indexCount);
+        if (g.arenaHandle == GeometryArena::InvalidHandle) return false;
+        uploadVertices = uploadIndices = true;
+    } else if (!g.arena->resize(g.arenaHandle, g.vertexCount, g.indexCount)) {
+        return false;
+    }
+    
+    // 尺寸变化时另一组数据已在 resize 中保留，只写入调用方更新的那组
+    if (uploadVertices && g.vertices.size() == g.vertexCount) {
+        std::vector<unsigned char> scratch;
+        g.updatePositionRange();
+        const void* packed = packVertices(g.vertexLayout, g.vertices.data(), g.vertexCount, g.positionRange, scratch);
+        g.arena->uploadVertices(g.arenaHandle, 0, packed, g.vertexCount);
+    }
+    if (uploadIndices && hasIndices() && g.indices.size() == g.indexCount) {
+        g.arena->uploadIndices(g.arenaHandle, 0, g.indices.data(), g.indexCount);
+    }
+    return true;
+}
+
+void CMesh::deleteOwnedObjects() {
+    Geometry& g = *geometry;
+    GLState::deleteVertexArray(g.VAO);
+    if (g.VBO != 0) { glDeleteBuffers(1, &g.VBO); g.VBO = 0; }
+    if (g.EBO != 0) { glDeleteBuffers(1, &g.EBO); g.EBO = 0; }
+    g.vboCapacity = 0;
+    g.eboCapacity = 0;
+}
+
+bool CMesh::usesStreaming() const {
+    const Geometry& g = *geometry;
+    return g.bufferUsage == BufferUsage::Stream && g.streamingBuffer && g.streamingBuffer->isInitialized();
+}
+
+void CMesh::uploadVertexBuffer() {
+    Geometry& g = *geometry;
+    if (g.arena) {
+        uploadToArena(true, false);
+        uploadPositionStream();
+        return;
+    }
+    if (usesStreaming()) {
+        if (uploadStream()) return;
+        // 数据比整个环还大，改用独立缓冲区
+        g.bufferUsage = BufferUsage::Dynamic;
+    }
+    
+    bool wasStreaming = g.streamVertices.isValid();
+    g.streamVertices = StreamingBuffer::Allocation();
+    g.streamIndices = StreamingBuffer::Allocation();
+    
+    std::vector<unsigned char> scratch;
+    g.updatePositionRange();
+    const void* packed = packVertices(g.vertexLayout, g.vertices.data(), g.vertexCount, g.positionRange, scratch);
+    uploadOwnedBuffer(GL_ARRAY_BUFFER, g.VBO, g.vboCapacity, packed, g.vertexCount * g.vertexLayout.stride);
+    if (wasStreaming) {
+        // 属性指针和索引绑定此前指向环形缓冲区，改回独立缓冲区
+        GLState::bindVertexArray(g.VAO);
+        setupVertexAttributes();
+        GLState::bindVertexArray(0);
+        uploadIndexBuffer();
+    }
+    uploadPositionStream();
+}
+
+void CMesh::uploadIndexBuffer() {
+    Geometry& g = *geometry;
+    if (g.arena) {
+        uploadToArena(false, true);
+        return;
+    }
+    if (usesStreaming()) {
+        if (uploadStream()) return;
+        g.bufferUsage = BufferUsage::Dynamic;
+        uploadVertexBuffer();
+        return;
+    }
+    
+    if (!hasIndices() && g.EBO == 0) return;
+    uploadOwnedBuffer(GL_ELEMENT_ARRAY_BUFFER, g.EBO, g.eboCapacity, g.indices.data(), g.indexCount * sizeof(unsigned int));
+}
+
+void CMesh::uploadOwnedBuffer(GLenum target, unsigned int& buffer, size_t& capacity, const void* data, size_t bytes) {
+    if (buffer == 0) {
+        glGenBuffers(1, &buffer);
+        capacity = 0;
+    }
+    
+    // 索引缓冲区的绑定属于 VAO 状态，需要在 VAO 绑定时操作
+    GLState::bindVertexArray(geometry->VAO);
+    glBindBuffer(target, buffer);
+    
+    if (bytes > 0 && bytes <= capacity) {
+        // 容量足够时只更新内容，不重新分配存储
+        glBufferSubData(target, 0, static_cast<GLsizeiptr>(bytes), data);
+    } else if (bytes > 0) {
+        size_t newCapacity = bytes;
+        GLenum hint = GL_STATIC_DRAW;
+        if (geometry->bufferUsage != BufferUsage::Static) {
+            newCapacity = std::max(bytes, capacity + capacity / 2);
+            hint = GL_DYNAMIC_DRAW;
         }
+        glBufferData(target, static_cast<GLsizeiptr>(newCapacity), nullptr, hint);
+        glBufferSubData(target, 0, static_cast<GLsizeiptr>(bytes), data);
+        capacity = newCapacity;
+    }
+    
+    GLState::bindVertexArray(0);
+    if (target == GL_ARRAY_BUFFER) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 }
 
-void CMesh::cleanup() {
-    if (VAO != 0) {
-        glDeleteVertexArrays(1, &VAO);
-        VAO = 0;
+bool CMesh::uploadStream() const {
+    Geometry& g = *geometry;
+    if (!g.streamingBuffer || g.vertices.empty()) return false;
+    
+    // 直接打包到映射的环形缓冲区区间，省去中间拷贝
+    StreamingBuffer::Allocation vertexAlloc = g.streamingBuffer->map(
+        g.vertices.size() * g.vertexLayout.stride, sizeof(float));
+    if (!vertexAlloc.isValid()) return false;
+    g.updatePositionRange();
+    VertexFormat::pack(g.vertexLayout, g.vertices.data(), g.vertices.size(), vertexAlloc.data, g.positionRange);
+    g.streamingBuffer->unmap();
+    vertexAlloc.data = nullptr;
+    
+    StreamingBuffer::Allocation indexAlloc;
+    if (hasIndices()) {
+        indexAlloc = g.streamingBuffer->upload(g.indices.data(), g.indices.size() * sizeof(unsigned int),
+                                               sizeof(unsigned int));
+        if (!indexAlloc.isValid()) return false;
     }
     
-    if (VBO != 0) {
-        glDeleteBuffers(1, &VBO);
-        VBO = 0;
+    g.streamVertices = vertexAlloc;
+    g.streamIndices = indexAlloc;
+    
+    // 每次分配的偏移不同，需要重新设置属性指针的基址
+    GLState::bindVertexArray(g.VAO);
+    setupVertexAttributes();
+    if (hasIndices()) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g.streamingBuffer->getBuffer());
     }
+    GLState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void CMesh::calculateBoundingBox() {
+    Geometry& g = *geometry;
+    // CPU 数据已释放时保留释放前计算的包围盒
+    if (g.vertices.size() != g.vertexCount) return;
     
-    if (EBO != 0) {
-        glDeleteBuffers(1, &EBO);
-        EBO = 0;
+    if (g.vertices.empty()) {
+        g.boundingBox = BoundingBox();
+        return;
+    }
+    
+    glm::vec3 minPos, maxPos;
+    MeshKernels::computeAABB(g.vertices, minPos, maxPos);
+    g.boundingBox = BoundingBox(minPos, maxPos);
+}
+
+void CMesh::calculateNormals(float creaseAngle) {
+    if (geometry->vertices.empty() || primitiveType != PrimitiveType::Triangles) return;
+
+    detachGeometry();
+    std::vector<Vertex>& vertices = geometry->vertices;
+    std::vector<unsigned int>& indices = geometry->indices;
+
+    if (hasIndices()) {
+        MeshUtils::calculateNormals(vertices, indices, creaseAngle);
+        updateVertexData(vertices);
+        updateIndexData(indices);
+    } else {
+        // 非索引网格每个顶点只被一个三角形引用，不会发生拆分
+        std::vector<unsigned int> sequential(vertices.size());
+        for (size_t i = 0; i < sequential.size(); ++i) {
+            sequential[i] = static_cast<unsigned int>(i);
+        }
+        MeshUtils::calculateNormals(vertices, sequential, creaseAngle);
+        updateVertexData(vertices);
+    }
+}
+
+void CMesh::calculateTangentsAndBitangents() {
+    if (geometry->vertices.empty() || primitiveType != PrimitiveType::Triangles) return;
+
+    detachGeometry();
+    std::vector<Vertex>& vertices = geometry->vertices;
+
+    if (hasIndices()) {
+        MeshUtils::calculateTangentsAndBitangents(vertices, geometry->indices);
+    } else {
+        std::vector<unsigned int> sequential(vertices.size());
+        for (size_t i = 0; i < sequential.size(); ++i) {
+            sequential[i] = static_cast<unsigned int>(i);
+        }
+        MeshUtils::calculateTangentsAndBitangents(vertices, sequential);
+    }
+    updateVertexData(vertices);
+}
+
+void CMesh::initialize() {
+    Geometry& g = *geometry;
+    if (g.initialized) return;
+    
+    if (g.arena && uploadToArena(true, true)) {
+        // 数据位于共享的 GeometryArena 中
+    } else {
+        g.arena.reset();
+        glGenVertexArrays(1, &g.VAO);
+    
+        if (usesStreaming() && uploadStream()) {
+            // 数据全部位于共享的环形缓冲区中
+        } else {
+            if (g.bufferUsage == BufferUsage::Stream) {
+                g.bufferUsage = BufferUsage::Dynamic;
+            }
+            std::vector<unsigned char> scratch;
+            g.updatePositionRange();
+            const void* packed = packVertices(g.vertexLayout, g.vertices.data(), g.vertices.size(), g.positionRange, scratch);
+            uploadOwnedBuffer(GL_ARRAY_BUFFER, g.VBO, g.vboCapacity, packed, g.vertices.size() * g.vertexLayout.stride);
+            if (hasIndices()) {
+                uploadOwnedBuffer(GL_ELEMENT_ARRAY_BUFFER, g.EBO, g.eboCapacity, g.indices.data(), g.indices.size() * sizeof(unsigned int));
+            }
+    
+            GLState::bindVertexArray(g.VAO);
+            setupVertexAttributes();
+            GLState::bindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
     }
     
-    initialized = false;
+    uploadPositionStream();
+    calculateBoundingBox();
+    g.initialized = true;
+    afterUpload();
+}
+
+void CMesh::setupVertexAttributes() const {
+    const Geometry& g = *geometry;
+    
+    // Stream 模式下数据位于环形缓冲区的某个偏移处
+    GLuint buffer = g.VBO;
+    size_t baseOffset = 0;
+    if (g.bufferUsage == BufferUsage::Stream && g.streamVertices.isValid()) {
+        buffer = g.streamingBuffer->getBuffer();
+        baseOffset = static_cast<size_t>(g.streamVertices.offset);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    
+    // 缓冲区中只有布局里的属性，按布局的 stride / offset / 编码紧密交错
+    VertexFormat::setupAttributePointers(g.vertexLayout, baseOffset);
+}
+
+void CMesh::uploadPositionStream() {
+    Geometry& g = *geometry;
+    if (!g.positionStream || usesStreaming() || g.vertices.size() != g.vertexCount) return;
+    
+    // 编码与主布局中的位置一致，unorm16 时沿用同一个量化范围，着色器的还原 uniform 不变
+    VertexAttributeLayout positionLayout = VertexFormat::getPositionLayout(g.vertexLayout);
+    std::vector<unsigned char> packed(g.vertexCount * positionLayout.stride);
+    VertexFormat::pack(positionLayout, g.vertices.data(), g.vertexCount, packed.data(), g.positionRange);
+    uploadOwnedBuffer(GL_ARRAY_BUFFER, g.positionVBO, g.positionCapacity, packed.data(), packed.size());
+    setupPositionAttributes();
+}
+
+void CMesh::setupPositionAttributes() const {
+    Geometry& g = *geometry;
+    if (g.positionVAO == 0) {
+        glGenVertexArrays(1, &g.positionVAO);
+    }
+    GLState::bindVertexArray(g.positionVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, g.positionVBO);
+    VertexFormat::setupAttributePointers(VertexFormat::getPositionLayout(g.vertexLayout), 0);
+    GLState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CMesh::deletePositionStream() {
+    Geometry& g = *geometry;
+    GLState::deleteVertexArray(g.positionVAO);
+    if (g.positionVBO != 0) { glDeleteBuffers(1, &g.positionVBO); g.positionVBO = 0; }
+    g.positionCapacity = 0;
 }
 
 void CMesh::calculateTextureCoordinateRange() {
     // TODO: 实现纹理坐标范围计算
-}
\ No newline at end of file
+}
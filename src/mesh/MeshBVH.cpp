@@ -0,0 +1,607 @@
+#include "mesh/MeshBVH.h"
+#include "mesh/Mesh.h"
+#include "core/Parallel.h"
+#include "core/Simd.h"
+#include <algorithm>
+#include <cmath>
+
+static_assert(sizeof(MeshBVH::Node) == 128, "BVH node should span two cache lines");
+
+namespace {
+
+const unsigned int kBinCount = 16;
+const uint32_t kMaxLeafSize = 4;
+// 超过该深度直接生成叶子，保证遍历栈有上界
+const unsigned int kMaxBuildDepth = 48;
+// 每层最多压入 3 个兄弟节点
+const int kStackSize = 3 * kMaxBuildDepth + 8;
+// SAH 中一次节点遍历相对一次三角形求交的代价
+const float kTraversalCost = 1.0f;
+const size_t kBoundsGrain = 16384;
+
+const float kInfinity = std::numeric_limits<float>::infinity();
+
+struct Aabb {
+    glm::vec3 min = glm::vec3(kInfinity);
+    glm::vec3 max = glm::vec3(-kInfinity);
+
+    void grow(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void grow(const Aabb& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+    bool valid() const { return min.x <= max.x; }
+    float area() const {
+        if (!valid()) return 0.0f;
+        glm::vec3 e = max - min;
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+};
+
+// 构建用的二叉节点，count > 0 为叶子（order 中 [first, first + count)）
+struct BuildNode {
+    Aabb bounds;
+    uint32_t left = 0;
+    uint32_t right = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+struct BuildTask {
+    uint32_t node;
+    uint32_t first;
+    uint32_t count;
+    unsigned int depth;
+};
+
+struct Bin {
+    Aabb bounds;
+    uint32_t count = 0;
+};
+
+// 分箱 SAH：在三个轴上各分 kBinCount 箱，返回代价最小的划分
+struct Split {
+    int axis = -1;
+    unsigned int bin = 0;      // 左侧为 [0, bin]
+    float cost = kInfinity;
+};
+
+Split findSahSplit(const std::vector<uint32_t>& order, uint32_t first, uint32_t count,
+                   const std::vector<Aabb>& boxes, const std::vector<glm::vec3>& centroids,
+                   const Aabb& centroidBounds) {
+    Split best;
+    for (int axis = 0; axis < 3; ++axis) {
+        float lo = centroidBounds.min[axis];
+        float extent = centroidBounds.max[axis] - lo;
+        if (!(extent > 0.0f)) continue;
+        float scale = static_cast<float>(kBinCount) / extent;
+
+        Bin bins[kBinCount];
+        for (uint32_t i = first; i < first + count; ++i) {
+            uint32_t tri = order[i];
+            unsigned int b = std::min(static_cast<unsigned int>((centroids[tri][axis] - lo) * scale), kBinCount - 1);
+            bins[b].count++;
+            bins[b].bounds.grow(boxes[tri]);
+        }
+
+        // 从右向左累计右侧面积，再从左向右扫描
+        float rightArea[kBinCount];
+        uint32_t rightCount[kBinCount];
+        Aabb accum;
+        uint32_t accumCount = 0;
+        for (unsigned int b = kBinCount - 1; b > 0; --b) {
+            accum.grow(bins[b].bounds);
+            accumCount += bins[b].count;
+            rightArea[b] = accum.area();
+            rightCount[b] = accumCount;
+        }
+        accum = Aabb();
+        accumCount = 0;
+        for (unsigned int b = 0; b + 1 < kBinCount; ++b) {
+            accum.grow(bins[b].bounds);
+            accumCount += bins[b].count;
+            if (accumCount == 0 || rightCount[b + 1] == 0) continue;
+            float cost = accum.area() * accumCount + rightArea[b + 1] * rightCount[b + 1];
+            if (cost < best.cost) {
+                best.axis = axis;
+                best.bin = b;
+                best.cost = cost;
+            }
+        }
+    }
+    return best;
+}
+
+inline unsigned int binOf(const glm::vec3& centroid, int axis, const Aabb& centroidBounds) {
+    float lo = centroidBounds.min[axis];
+    float scale = static_cast<float>(kBinCount) / (centroidBounds.max[axis] - lo);
+    return std::min(static_cast<unsigned int>((centroid[axis] - lo) * scale), kBinCount - 1);
+}
+
+void buildBinaryTree(const std::vector<Aabb>& boxes, const std::vector<glm::vec3>& centroids,
+                     std::vector<uint32_t>& order, std::vector<BuildNode>& nodes) {
+    nodes.clear();
+    nodes.reserve(order.size() * 2 / kMaxLeafSize + 1);
+    nodes.push_back(BuildNode());
+
+    std::vector<BuildTask> tasks;
+    tasks.push_back(BuildTask{ 0, 0, static_cast<uint32_t>(order.size()), 0 });
+    while (!tasks.empty()) {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        Aabb bounds, centroidBounds;
+        for (uint32_t i = task.first; i < task.first + task.count; ++i) {
+            bounds.grow(boxes[order[i]]);
+            centroidBounds.grow(centroids[order[i]]);
+        }
+        nodes[task.node].bounds = bounds;
+
+        bool makeLeaf = task.count <= 1 || task.depth >= kMaxBuildDepth;
+        Split split;
+        if (!makeLeaf) {
+            split = findSahSplit(order, task.first, task.count, boxes, centroids, centroidBounds);
+            float area = bounds.area();
+            float splitCost = kTraversalCost + (area > 0.0f ? split.cost / area : 0.0f);
+            // 三角形不多且划分不比直接求交便宜时停止
+            if (task.count <= kMaxLeafSize && (split.axis < 0 || splitCost >= static_cast<float>(task.count))) {
+                makeLeaf = true;
+            }
+        }
+        if (makeLeaf) {
+            nodes[task.node].first = task.first;
+            nodes[task.node].count = task.count;
+            continue;
+        }
+
+        uint32_t leftCount;
+        if (split.axis >= 0) {
+            auto middle = std::partition(order.begin() + task.first, order.begin() + task.first + task.count,
+                                         [&](uint32_t tri) {
+                                             return binOf(centroids[tri], split.axis, centroidBounds) <= split.bin;
+                                         });
+            leftCount = static_cast<uint32_t>(middle - (order.begin() + task.first));
+        } else {
+            // 中心点重合，SAH 无法区分：按数量对半分
+            leftCount = task.count / 2;
+        }
+
+        uint32_t left = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(BuildNode());
+        nodes.push_back(BuildNode());
+        nodes[task.node].left = left;
+        nodes[task.node].right = left + 1;
+        tasks.push_back(BuildTask{ left + 1, task.first + leftCount, task.count - leftCount, task.depth + 1 });
+        tasks.push_back(BuildTask{ left, task.first, leftCount, task.depth + 1 });
+    }
+}
+
+void setSlot(MeshBVH::Node& node, int slot, const Aabb& bounds, uint32_t child, uint32_t count) {
+    node.minX[slot] = bounds.min.x;
+    node.minY[slot] = bounds.min.y;
+    node.minZ[slot] = bounds.min.z;
+    node.maxX[slot] = bounds.max.x;
+    node.maxY[slot] = bounds.max.y;
+    node.maxZ[slot] = bounds.max.z;
+    node.child[slot] = child;
+    node.count[slot] = count;
+}
+
+// 二叉树压平成四叉树：每次展开面积最大的内部子节点，直到凑满 4 个槽位
+void collapseToWide(const std::vector<BuildNode>& binary, std::vector<MeshBVH::Node>& nodes) {
+    nodes.clear();
+    nodes.reserve(binary.size() / 2 + 1);
+    nodes.push_back(MeshBVH::Node());
+
+    struct Pending {
+        uint32_t binary;
+        uint32_t wide;
+    };
+    std::vector<Pending> pending;
+    pending.push_back(Pending{ 0, 0 });
+    while (!pending.empty()) {
+        Pending current = pending.back();
+        pending.pop_back();
+
+        uint32_t children[4];
+        int childCount = 0;
+        const BuildNode& source = binary[current.binary];
+        if (source.count > 0) {
+            // 只有根节点可能是叶子（三角形很少）
+            children[childCount++] = current.binary;
+        } else {
+            children[childCount++] = source.left;
+            children[childCount++] = source.right;
+            while (childCount < 4) {
+                int open = -1;
+                float openArea = -1.0f;
+                for (int i = 0; i < childCount; ++i) {
+                    const BuildNode& candidate = binary[children[i]];
+                    if (candidate.count == 0 && candidate.bounds.area() > openArea) {
+                        open = i;
+                        openArea = candidate.bounds.area();
+                    }
+                }
+                if (open < 0) break;
+                const BuildNode& opened = binary[children[open]];
+                children[open] = opened.left;
+                children[childCount++] = opened.right;
+            }
+        }
+
+        // 内部子节点先分配下标，兄弟节点相邻存放
+        uint32_t childNodes[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < childCount; ++i) {
+            if (binary[children[i]].count == 0) {
+                childNodes[i] = static_cast<uint32_t>(nodes.size());
+                nodes.push_back(MeshBVH::Node());
+            }
+        }
+
+        MeshBVH::Node& node = nodes[current.wide];
+        for (int i = 0; i < 4; ++i) {
+            if (i >= childCount) {
+                setSlot(node, i, Aabb(), 0, 0);
+                continue;
+            }
+            const BuildNode& child = binary[children[i]];
+            if (child.count > 0) {
+                setSlot(node, i, child.bounds, child.first, child.count);
+            } else {
+                setSlot(node, i, child.bounds, childNodes[i], 0);
+            }
+        }
+        for (int i = childCount - 1; i >= 0; --i) {
+            if (binary[children[i]].count == 0) {
+                pending.push_back(Pending{ children[i], childNodes[i] });
+            }
+        }
+    }
+}
+
+// 方向分量为 0 时用极大值代替无穷，避免 0 * inf 产生 NaN
+inline float safeInverse(float d) {
+    return std::fabs(d) > 1e-30f ? 1.0f / d : std::copysign(1e30f, d);
+}
+
+struct PreparedRay {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    glm::vec3 inverse;
+    int negative[3];
+    float tMin;
+};
+
+PreparedRay prepare(const MeshBVH::Ray& ray) {
+    PreparedRay prepared;
+    prepared.origin = ray.origin;
+    prepared.direction = ray.direction;
+    prepared.inverse = glm::vec3(safeInverse(ray.direction.x), safeInverse(ray.direction.y),
+                                 safeInverse(ray.direction.z));
+    for (int c = 0; c < 3; ++c) {
+        prepared.negative[c] = prepared.inverse[c] < 0.0f ? 1 : 0;
+    }
+    prepared.tMin = ray.tMin;
+    return prepared;
+}
+
+// 4 个子包围盒的 slab 测试，返回命中槽位的位掩码和各自的进入距离
+inline int intersectSlots(const MeshBVH::Node& node, const PreparedRay& ray, float tMax, float tNear[4]) {
+    // 按方向符号选取近 / 远平面，空槽（min > max）因此总是 tNear > tFar
+    const float* nearX = ray.negative[0] ? node.maxX : node.minX;
+    const float* farX = ray.negative[0] ? node.minX : node.maxX;
+    const float* nearY = ray.negative[1] ? node.maxY : node.minY;
+    const float* farY = ray.negative[1] ? node.minY : node.maxY;
+    const float* nearZ = ray.negative[2] ? node.maxZ : node.minZ;
+    const float* farZ = ray.negative[2] ? node.minZ : node.maxZ;
+#if SIMD_SSE2
+    const __m128 ox = _mm_set1_ps(ray.origin.x);
+    const __m128 oy = _mm_set1_ps(ray.origin.y);
+    const __m128 oz = _mm_set1_ps(ray.origin.z);
+    const __m128 ix = _mm_set1_ps(ray.inverse.x);
+    const __m128 iy = _mm_set1_ps(ray.inverse.y);
+    const __m128 iz = _mm_set1_ps(ray.inverse.z);
+
+    __m128 tx0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearX), ox), ix);
+    __m128 ty0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearY), oy), iy);
+    __m128 tz0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearZ), oz), iz);
+    __m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farX), ox), ix);
+    __m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farY), oy), iy);
+    __m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farZ), oz), iz);
+
+    __m128 enter = _mm_max_ps(_mm_max_ps(tx0, ty0), _mm_max_ps(tz0, _mm_set1_ps(ray.tMin)));
+    __m128 exit = _mm_min_ps(_mm_min_ps(tx1, ty1), _mm_min_ps(tz1, _mm_set1_ps(tMax)));
+    _mm_storeu_ps(tNear, enter);
+    return _mm_movemask_ps(_mm_cmple_ps(enter, exit));
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        float tx0 = (nearX[i] - ray.origin.x) * ray.inverse.x;
+        float ty0 = (nearY[i] - ray.origin.y) * ray.inverse.y;
+        float tz0 = (nearZ[i] - ray.origin.z) * ray.inverse.z;
+        float tx1 = (farX[i] - ray.origin.x) * ray.inverse.x;
+        float ty1 = (farY[i] - ray.origin.y) * ray.inverse.y;
+        float tz1 = (farZ[i] - ray.origin.z) * ray.inverse.z;
+        float enter = std::max(std::max(tx0, ty0), std::max(tz0, ray.tMin));
+        float exit = std::min(std::min(tx1, ty1), std::min(tz1, tMax));
+        tNear[i] = enter;
+        if (enter <= exit) mask |= 1 << i;
+    }
+    return mask;
+#endif
+}
+
+// Möller–Trumbore，双面求交
+inline bool intersectTriangle(const MeshBVH::Triangle& tri, const PreparedRay& ray, float tMax,
+                              float& t, float& u, float& v) {
+    glm::vec3 pvec = glm::cross(ray.direction, tri.e2);
+    float det = glm::dot(tri.e1, pvec);
+    if (std::fabs(det) < 1e-30f) return false;
+    float invDet = 1.0f / det;
+    glm::vec3 tvec = ray.origin - tri.p0;
+    u = glm::dot(tvec, pvec) * invDet;
+    if (u < 0.0f || u > 1.0f) return false;
+    glm::vec3 qvec = glm::cross(tvec, tri.e1);
+    v = glm::dot(ray.direction, qvec) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    t = glm::dot(tri.e2, qvec) * invDet;
+    return t >= ray.tMin && t <= tMax;
+}
+
+struct StackEntry {
+    uint32_t child;
+    uint32_t count;
+    float tNear;
+};
+
+} // namespace
+
+MeshBVH::Instance::Instance(const MeshBVH* b, const glm::mat4& m)
+    : bvh(b), model(m), inverseModel(glm::inverse(m)) {}
+
+bool MeshBVH::build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    std::vector<glm::vec3> positions(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        positions[i] = vertices[i].position;
+    }
+    return build(positions.data(), positions.size(), indices.data(), indices.size());
+}
+
+bool MeshBVH::build(const glm::vec3* positions, size_t vertexCount, const unsigned int* indices, size_t indexCount) {
+    nodes_.clear();
+    triangles_.clear();
+    boundsMin_ = boundsMax_ = glm::vec3(0.0f);
+
+    if (indexCount % 3 != 0 || indexCount / 3 > std::numeric_limits<uint32_t>::max()) return false;
+    for (size_t i = 0; i < indexCount; ++i) {
+        if (indices[i] >= vertexCount) return false;
+    }
+
+    // 退化三角形（面积为 0）不可能被命中，不参与构建
+    size_t triangleCount = indexCount / 3;
+    std::vector<Aabb> boxes(triangleCount);
+    std::vector<glm::vec3> centroids(triangleCount);
+    std::vector<unsigned char> degenerate(triangleCount, 0);
+    Parallel::forRange(triangleCount, kBoundsGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t t = begin; t < end; ++t) {
+            const glm::vec3& p0 = positions[indices[t * 3]];
+            const glm::vec3& p1 = positions[indices[t * 3 + 1]];
+            const glm::vec3& p2 = positions[indices[t * 3 + 2]];
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            if (n.x == 0.0f && n.y == 0.0f && n.z == 0.0f) {
+                degenerate[t] = 1;
+                continue;
+            }
+            boxes[t].grow(p0);
+            boxes[t].grow(p1);
+            boxes[t].grow(p2);
+            centroids[t] = (boxes[t].min + boxes[t].max) * 0.5f;
+        }
+    });
+
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (!degenerate[t]) order.push_back(static_cast<uint32_t>(t));
+    }
+    if (order.empty()) return true;
+
+    std::vector<BuildNode> binary;
+    buildBinaryTree(boxes, centroids, order, binary);
+    collapseToWide(binary, nodes_);
+    boundsMin_ = binary[0].bounds.min;
+    boundsMax_ = binary[0].bounds.max;
+
+    // 三角形按叶子顺序存放，叶子引用连续区间
+    triangles_.resize(order.size());
+    Parallel::forRange(order.size(), kBoundsGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t t = order[i];
+            const glm::vec3& p0 = positions[indices[t * 3]];
+            Triangle& tri = triangles_[i];
+            tri.p0 = p0;
+            tri.e1 = positions[indices[t * 3 + 1]] - p0;
+            tri.e2 = positions[indices[t * 3 + 2]] - p0;
+            tri.primitive = t;
+        }
+    });
+    return true;
+}
+
+std::shared_ptr<MeshBVH> MeshBVH::fromMesh(const CMesh& mesh) {
+    if (mesh.isCpuDataReleased() || mesh.getPrimitiveType() != PrimitiveType::Triangles) {
+        return nullptr;
+    }
+
+    const std::vector<Vertex>& vertices = mesh.getVertices();
+    auto bvh = std::make_shared<MeshBVH>();
+    bool ok;
+    if (mesh.getIndices().empty()) {
+        std::vector<unsigned int> indices(vertices.size() - vertices.size() % 3);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = static_cast<unsigned int>(i);
+        }
+        ok = bvh->build(vertices, indices);
+    } else {
+        ok = bvh->build(vertices, mesh.getIndices());
+    }
+    return ok ? bvh : nullptr;
+}
+
+template <bool AnyHit>
+bool MeshBVH::traverse(const Ray& ray, Hit& hit) const {
+    if (nodes_.empty() || !(ray.tMin <= ray.tMax)) return false;
+
+    PreparedRay prepared = prepare(ray);
+    float closest = ray.tMax;
+    bool found = false;
+
+    StackEntry stack[kStackSize];
+    int top = 0;
+    stack[top++] = StackEntry{ 0, 0, ray.tMin };
+    while (top > 0) {
+        const StackEntry entry = stack[--top];
+        if (entry.tNear > closest) continue;
+
+        if (entry.count > 0) {
+            for (uint32_t i = entry.child; i < entry.child + entry.count; ++i) {
+                float t, u, v;
+                if (!intersectTriangle(triangles_[i], prepared, closest, t, u, v)) continue;
+                found = true;
+                closest = t;
+                hit.t = t;
+                hit.triangle = triangles_[i].primitive;
+                hit.u = u;
+                hit.v = v;
+                if (AnyHit) return true;
+            }
+            continue;
+        }
+
+        const Node& node = nodes_[entry.child];
+        float tNear[4];
+        int mask = intersectSlots(node, prepared, closest, tNear);
+        if (mask == 0) continue;
+
+        StackEntry children[4];
+        int childCount = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (!(mask & (1 << i))) continue;
+            StackEntry child{ node.child[i], node.count[i], tNear[i] };
+            // 最近交点：按进入距离从远到近入栈，近的先出栈
+            int j = childCount++;
+            while (!AnyHit && j > 0 && children[j - 1].tNear < child.tNear) {
+                children[j] = children[j - 1];
+                --j;
+            }
+            children[j] = child;
+        }
+        for (int i = 0; i < childCount; ++i) {
+            stack[top++] = children[i];
+        }
+    }
+    return found;
+}
+
+bool MeshBVH::intersect(const Ray& ray, Hit& hit) const {
+    Hit result;
+    if (!traverse<false>(ray, result)) return false;
+    hit = result;
+    return true;
+}
+
+bool MeshBVH::occluded(const Ray& ray) const {
+    Hit ignored;
+    return traverse<true>(ray, ignored);
+}
+
+bool MeshBVH::raycast(const std::vector<Instance>& instances, const Ray& ray, SceneHit& hit) {
+    bool found = false;
+    float closest = ray.tMax;
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const Instance& instance = instances[i];
+        if (!instance.bvh) continue;
+
+        // 方向只做线性变换不归一化，局部 t 与世界 t 相同
+        Ray local(glm::vec3(instance.inverseModel * glm::vec4(ray.origin, 1.0f)),
+                  glm::mat3(instance.inverseModel) * ray.direction, ray.tMin, closest);
+        Hit localHit;
+        if (!instance.bvh->intersect(local, localHit)) continue;
+
+        found = true;
+        closest = localHit.t;
+        hit.t = localHit.t;
+        hit.instance = i;
+        hit.triangle = localHit.triangle;
+        hit.u = localHit.u;
+        hit.v = localHit.v;
+    }
+    if (found) {
+        hit.position = ray.origin + ray.direction * hit.t;
+    }
+    return found;
+}
+
+bool MeshBVH::occluded(const std::vector<Instance>& instances, const Ray& ray) {
+    for (const Instance& instance : instances) {
+        if (!instance.bvh) continue;
+        Ray local(glm::vec3(instance.inverseModel * glm::vec4(ray.origin, 1.0f)),
+                  glm::mat3(instance.inverseModel) * ray.direction, ray.tMin, ray.tMax);
+        if (instance.bvh->occluded(local)) return true;
+    }
+    return false;
+}
+
+MeshBVH::Ray MeshBVH::rayFromScreen(const glm::vec2& ndc, const glm::mat4& view, const glm::mat4& projection) {
+    glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc.x, ndc.y, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+    glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+    glm::vec3 target = glm::vec3(farPoint) / farPoint.w;
+    return Ray(origin, glm::normalize(target - origin));
+}
+
+MeshBVH::Stats MeshBVH::getStats() const {
+    Stats stats;
+    stats.nodeCount = nodes_.size();
+    stats.triangleCount = triangles_.size();
+    if (nodes_.empty()) return stats;
+
+    Aabb root;
+    root.grow(boundsMin_);
+    root.grow(boundsMax_);
+    float rootArea = root.area();
+
+    // 代价 = Σ 子包围盒面积 × (叶子三角形数，内部节点记 1) / 根面积 + 根节点的一次遍历
+    double cost = kTraversalCost;
+    std::vector<std::pair<uint32_t, unsigned int>> pending(1, std::make_pair(0u, 1u));
+    while (!pending.empty()) {
+        std::pair<uint32_t, unsigned int> current = pending.back();
+        pending.pop_back();
+        stats.maxDepth = std::max(stats.maxDepth, current.second);
+        const Node& node = nodes_[current.first];
+        for (int i = 0; i < 4; ++i) {
+            Aabb slot;
+            slot.min = glm::vec3(node.minX[i], node.minY[i], node.minZ[i]);
+            slot.max = glm::vec3(node.maxX[i], node.maxY[i], node.maxZ[i]);
+            if (!slot.valid()) continue;
+            float weight = rootArea > 0.0f ? slot.area() / rootArea : 1.0f;
+            if (node.count[i] > 0) {
+                stats.leafCount++;
+                cost += weight * node.count[i];
+            } else {
+                cost += weight * kTraversalCost;
+                pending.push_back(std::make_pair(node.child[i], current.second + 1));
+            }
+        }
+    }
+    stats.sahCost = static_cast<float>(cost);
+    return stats;
+}
+
+size_t MeshBVH::getMemoryUsage() const {
+    return nodes_.size() * sizeof(Node) + triangles_.size() * sizeof(Triangle);
+}
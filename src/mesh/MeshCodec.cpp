@@ -0,0 +1,506 @@
+#include "mesh/MeshCodec.h"
+#include "mesh/Mesh.h"
+#include "core/Simd.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const unsigned char kVertexStreamVersion = 1;
+const unsigned char kIndexStreamVersion = 1;
+const char kMeshMagic[4] = { 'M', 'S', 'H', 'C' };
+const uint32_t kMeshVersion = 1;
+
+// 每块顶点数，必须是 16 的倍数；块内各分量的临时数组放在栈上
+const size_t kBlockVertices = 256;
+const size_t kGroupSize = 16;
+const size_t kMaxGroups = kBlockVertices / kGroupSize;
+
+// 索引代码：0..12 为 FIFO 位置，其余三个为特殊代码
+const unsigned int kFifoCodes = 13;
+const unsigned int kCodeNext = 13;
+const unsigned int kCodeIncrement = 14;
+const unsigned int kCodeEscape = 15;
+
+struct MeshHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t primitive;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t stride;
+    uint32_t vertexBytes;
+    uint32_t indexBytes;
+};
+
+inline uint32_t zigzag(uint32_t delta) {
+    return (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+}
+
+inline uint32_t unzigzag(uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1u));
+}
+
+// 组内最大值所需的位数：0 / 2 / 4 / 8 分别对应模式 0 / 1 / 2 / 3
+inline unsigned int groupMode(const unsigned char* values) {
+    unsigned char maxValue = 0;
+    for (size_t i = 0; i < kGroupSize; ++i) {
+        maxValue = std::max(maxValue, values[i]);
+    }
+    if (maxValue == 0) return 0;
+    if (maxValue < 4) return 1;
+    if (maxValue < 16) return 2;
+    return 3;
+}
+
+inline size_t modeBytes(unsigned int mode) {
+    static const size_t bytes[4] = { 0, 4, 8, 16 };
+    return bytes[mode];
+}
+
+inline size_t groupCount(size_t blockVertices) {
+    return (blockVertices + kGroupSize - 1) / kGroupSize;
+}
+
+inline size_t headerBytes(size_t groups) {
+    return (groups + 3) / 4;
+}
+
+// 每个块、每个分量的 4 个字节通道至少有组头，据此得到顶点流长度的下限
+size_t getMinVertexBytes(size_t vertexCount, size_t stride) {
+    size_t lanes = stride / 4 * 4;
+    size_t bytes = vertexCount / kBlockVertices * lanes * headerBytes(kMaxGroups);
+    size_t tail = vertexCount % kBlockVertices;
+    if (tail > 0) {
+        bytes += lanes * headerBytes(groupCount(tail));
+    }
+    return 1 + bytes;
+}
+
+bool isValidPrimitive(uint32_t primitive) {
+    switch (static_cast<PrimitiveType>(primitive)) {
+        case PrimitiveType::Triangles:
+        case PrimitiveType::TriangleStrip:
+        case PrimitiveType::TriangleFan:
+        case PrimitiveType::Lines:
+        case PrimitiveType::LineStrip:
+        case PrimitiveType::Points:
+            return true;
+    }
+    return false;
+}
+
+// 一个字节通道：头部每组 2 位模式，随后按模式写入各组的打包数据
+void encodeLane(const unsigned char* values, size_t groups, std::vector<unsigned char>& out) {
+    size_t header = out.size();
+    out.resize(header + headerBytes(groups), 0);
+    for (size_t g = 0; g < groups; ++g) {
+        const unsigned char* v = values + g * kGroupSize;
+        unsigned int mode = groupMode(v);
+        out[header + g / 4] |= static_cast<unsigned char>(mode << ((g % 4) * 2));
+        switch (mode) {
+            case 1:
+                for (size_t i = 0; i < kGroupSize; i += 4) {
+                    out.push_back(static_cast<unsigned char>(v[i] | (v[i + 1] << 2) | (v[i + 2] << 4) | (v[i + 3] << 6)));
+                }
+                break;
+            case 2:
+                for (size_t i = 0; i < kGroupSize; i += 2) {
+                    out.push_back(static_cast<unsigned char>(v[i] | (v[i + 1] << 4)));
+                }
+                break;
+            case 3:
+                out.insert(out.end(), v, v + kGroupSize);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+#if SIMD_SSE2
+
+// 展开一组 16 个值
+inline __m128i unpackGroup(const unsigned char* data, unsigned int mode) {
+    switch (mode) {
+        case 1: {
+            int packed;
+            std::memcpy(&packed, data, 4);
+            const __m128i x = _mm_cvtsi32_si128(packed);
+            const __m128i mask = _mm_set1_epi8(3);
+            __m128i v0 = _mm_and_si128(x, mask);
+            __m128i v1 = _mm_and_si128(_mm_srli_epi16(x, 2), mask);
+            __m128i v2 = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+            __m128i v3 = _mm_and_si128(_mm_srli_epi16(x, 6), mask);
+            // 字节 j 依次含第 4j .. 4j + 3 个值
+            return _mm_unpacklo_epi16(_mm_unpacklo_epi8(v0, v1), _mm_unpacklo_epi8(v2, v3));
+        }
+        case 2: {
+            const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+            const __m128i mask = _mm_set1_epi8(15);
+            return _mm_unpacklo_epi8(_mm_and_si128(x, mask), _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+        }
+        case 3:
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        default:
+            return _mm_setzero_si128();
+    }
+}
+
+#else
+
+inline void unpackGroup(const unsigned char* data, unsigned int mode, unsigned char* values) {
+    switch (mode) {
+        case 1:
+            for (size_t i = 0; i < kGroupSize; ++i) values[i] = (data[i / 4] >> ((i % 4) * 2)) & 3;
+            break;
+        case 2:
+            for (size_t i = 0; i < kGroupSize; ++i) values[i] = (data[i / 2] >> ((i % 2) * 4)) & 15;
+            break;
+        case 3:
+            std::memcpy(values, data, kGroupSize);
+            break;
+        default:
+            std::memset(values, 0, kGroupSize);
+            break;
+    }
+}
+
+#endif
+
+// 解码一个字节通道到 lane（groups * 16 字节），返回下一个通道的起点，数据不足时返回 nullptr
+const unsigned char* decodeLane(const unsigned char* data, const unsigned char* end, size_t groups,
+                                unsigned char* lane) {
+    size_t header = headerBytes(groups);
+    if (static_cast<size_t>(end - data) < header) return nullptr;
+    const unsigned char* payload = data + header;
+    for (size_t g = 0; g < groups; ++g) {
+        unsigned int mode = (data[g / 4] >> ((g % 4) * 2)) & 3;
+        size_t bytes = modeBytes(mode);
+        if (static_cast<size_t>(end - payload) < bytes) return nullptr;
+#if SIMD_SSE2
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lane + g * kGroupSize), unpackGroup(payload, mode));
+#else
+        unpackGroup(payload, mode, lane + g * kGroupSize);
+#endif
+        payload += bytes;
+    }
+    return payload;
+}
+
+// 4 个字节通道重组为 32 位 zigzag 差值，还原后做前缀和得到分量值；carry 为上一个顶点的分量
+void reconstructComponent(unsigned char lanes[4][kBlockVertices], size_t groups, uint32_t& carry,
+                          uint32_t* words) {
+#if SIMD_SSE2
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i running = _mm_set1_epi32(static_cast<int>(carry));
+    for (size_t g = 0; g < groups; ++g) {
+        size_t offset = g * kGroupSize;
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[0] + offset));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[1] + offset));
+        __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[2] + offset));
+        __m128i b3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[3] + offset));
+        __m128i lo01 = _mm_unpacklo_epi8(b0, b1);
+        __m128i hi01 = _mm_unpackhi_epi8(b0, b1);
+        __m128i lo23 = _mm_unpacklo_epi8(b2, b3);
+        __m128i hi23 = _mm_unpackhi_epi8(b2, b3);
+        __m128i quads[4] = {
+            _mm_unpacklo_epi16(lo01, lo23), _mm_unpackhi_epi16(lo01, lo23),
+            _mm_unpacklo_epi16(hi01, hi23), _mm_unpackhi_epi16(hi01, hi23)
+        };
+        for (int q = 0; q < 4; ++q) {
+            __m128i z = quads[q];
+            __m128i d = _mm_xor_si128(_mm_srli_epi32(z, 1), _mm_sub_epi32(zero, _mm_and_si128(z, one)));
+            // 4 个元素的前缀和，再加上前一组的最后一个值
+            d = _mm_add_epi32(d, _mm_slli_si128(d, 4));
+            d = _mm_add_epi32(d, _mm_slli_si128(d, 8));
+            d = _mm_add_epi32(d, running);
+            running = _mm_shuffle_epi32(d, _MM_SHUFFLE(3, 3, 3, 3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(words + offset + q * 4), d);
+        }
+    }
+    carry = static_cast<uint32_t>(_mm_cvtsi128_si32(running));
+#else
+    for (size_t i = 0; i < groups * kGroupSize; ++i) {
+        uint32_t z = lanes[0][i] | (lanes[1][i] << 8) | (lanes[2][i] << 16) | (static_cast<uint32_t>(lanes[3][i]) << 24);
+        carry += unzigzag(z);
+        words[i] = carry;
+    }
+#endif
+}
+
+void writeVarint(uint32_t value, std::vector<unsigned char>& out) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+inline bool readVarint(const unsigned char*& data, const unsigned char* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (data == end) return false;
+        unsigned char byte = *data++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// 最近使用的顶点：16 项环形缓冲，只有最近 kFifoCodes（13）项可被代码引用；
+// 位置 k 为倒数第 k + 1 个未命中时压入的索引
+struct IndexFifo {
+    uint32_t entries[16];
+    uint32_t head = 0;
+
+    IndexFifo() { std::fill(entries, entries + 16, ~0u); }
+
+    uint32_t at(unsigned int position) const { return entries[(head - 1 - position) & 15]; }
+    void push(uint32_t index) { entries[head++ & 15] = index; }
+    int find(uint32_t index) const {
+        for (unsigned int k = 0; k < kFifoCodes; ++k) {
+            if (at(k) == index) return static_cast<int>(k);
+        }
+        return -1;
+    }
+};
+
+} // namespace
+
+namespace MeshCodec {
+
+size_t getVertexBufferBound(size_t vertexCount, size_t stride) {
+    size_t lanes = stride / 4 * 4;
+    size_t fullBlocks = vertexCount / kBlockVertices;
+    size_t tail = vertexCount % kBlockVertices;
+    size_t bytes = fullBlocks * lanes * (headerBytes(kMaxGroups) + kMaxGroups * kGroupSize);
+    if (tail > 0) {
+        bytes += lanes * (headerBytes(groupCount(tail)) + groupCount(tail) * kGroupSize);
+    }
+    return 1 + bytes;
+}
+
+size_t getIndexBufferBound(size_t indexCount) {
+    return 1 + (indexCount + 1) / 2 + indexCount * 5;
+}
+
+bool encodeVertices(const void* vertices, size_t count, size_t stride, std::vector<unsigned char>& out) {
+    if (stride == 0 || stride % 4 != 0) return false;
+
+    const unsigned char* source = static_cast<const unsigned char*>(vertices);
+    size_t components = stride / 4;
+    out.clear();
+    out.reserve(getVertexBufferBound(count, stride));
+    out.push_back(kVertexStreamVersion);
+
+    std::vector<uint32_t> previous(components, 0);
+    unsigned char lanes[4][kBlockVertices];
+    for (size_t base = 0; base < count; base += kBlockVertices) {
+        size_t blockCount = std::min(kBlockVertices, count - base);
+        size_t groups = groupCount(blockCount);
+        for (size_t c = 0; c < components; ++c) {
+            std::memset(lanes, 0, sizeof(lanes));
+            uint32_t prev = previous[c];
+            for (size_t i = 0; i < blockCount; ++i) {
+                uint32_t word;
+                std::memcpy(&word, source + (base + i) * stride + c * 4, 4);
+                uint32_t z = zigzag(word - prev);
+                prev = word;
+                lanes[0][i] = static_cast<unsigned char>(z);
+                lanes[1][i] = static_cast<unsigned char>(z >> 8);
+                lanes[2][i] = static_cast<unsigned char>(z >> 16);
+                lanes[3][i] = static_cast<unsigned char>(z >> 24);
+            }
+            previous[c] = prev;
+            for (int b = 0; b < 4; ++b) {
+                encodeLane(lanes[b], groups, out);
+            }
+        }
+    }
+    return true;
+}
+
+bool decodeVertices(const unsigned char* data, size_t size, void* vertices, size_t count, size_t stride) {
+    if (stride == 0 || stride % 4 != 0 || size < 1 || data[0] != kVertexStreamVersion) return false;
+
+    const unsigned char* cursor = data + 1;
+    const unsigned char* end = data + size;
+    unsigned char* target = static_cast<unsigned char*>(vertices);
+    size_t components = stride / 4;
+
+    std::vector<uint32_t> previous(components, 0);
+    unsigned char lanes[4][kBlockVertices];
+    uint32_t words[kBlockVertices];
+    for (size_t base = 0; base < count; base += kBlockVertices) {
+        size_t blockCount = std::min(kBlockVertices, count - base);
+        size_t groups = groupCount(blockCount);
+        unsigned char* blockTarget = target + base * stride;
+        for (size_t c = 0; c < components; ++c) {
+            for (int b = 0; b < 4; ++b) {
+                cursor = decodeLane(cursor, end, groups, lanes[b]);
+                if (!cursor) return false;
+            }
+            reconstructComponent(lanes, groups, previous[c], words);
+            // 末组填充的差值由编码端写 0，carry 仍以最后一个真实顶点为准，不依赖填充内容
+            previous[c] = words[blockCount - 1];
+            for (size_t i = 0; i < blockCount; ++i) {
+                std::memcpy(blockTarget + i * stride + c * 4, &words[i], 4);
+            }
+        }
+    }
+    return cursor == end;
+}
+
+bool encodeIndices(const unsigned int* indices, size_t count, std::vector<unsigned char>& out) {
+    out.clear();
+    out.reserve(getIndexBufferBound(count));
+    out.push_back(kIndexStreamVersion);
+    size_t codeStart = out.size();
+    out.resize(codeStart + (count + 1) / 2, 0);
+
+    std::vector<unsigned char> escapes;
+    IndexFifo fifo;
+    uint32_t next = 0;
+    uint32_t last = ~0u;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t index = indices[i];
+        int position = fifo.find(index);
+        unsigned int code;
+        if (position >= 0) {
+            code = static_cast<unsigned int>(position);
+        } else {
+            if (index == next) {
+                code = kCodeNext;
+            } else if (index == last + 1) {
+                code = kCodeIncrement;
+            } else {
+                code = kCodeEscape;
+                writeVarint(zigzag(index - last), escapes);
+            }
+            fifo.push(index);
+        }
+        out[codeStart + i / 2] |= static_cast<unsigned char>(code << ((i % 2) * 4));
+        if (index >= next) next = index + 1;
+        last = index;
+    }
+    out.insert(out.end(), escapes.begin(), escapes.end());
+    return true;
+}
+
+bool decodeIndices(const unsigned char* data, size_t size, unsigned int* indices, size_t count) {
+    size_t codeBytes = (count + 1) / 2;
+    if (size < 1 + codeBytes || data[0] != kIndexStreamVersion) return false;
+
+    const unsigned char* codes = data + 1;
+    const unsigned char* escapes = codes + codeBytes;
+    const unsigned char* end = data + size;
+
+    IndexFifo fifo;
+    uint32_t next = 0;
+    uint32_t last = ~0u;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned int code = (codes[i / 2] >> ((i % 2) * 4)) & 15;
+        uint32_t index;
+        if (code < kFifoCodes) {
+            index = fifo.at(code);
+            if (index == ~0u) return false;
+        } else {
+            if (code == kCodeNext) {
+                index = next;
+            } else if (code == kCodeIncrement) {
+                index = last + 1;
+            } else {
+                uint32_t delta;
+                if (!readVarint(escapes, end, delta)) return false;
+                index = last + unzigzag(delta);
+            }
+            fifo.push(index);
+        }
+        indices[i] = index;
+        if (index >= next) next = index + 1;
+        last = index;
+    }
+    return escapes == end;
+}
+
+bool encodeMesh(const CMesh& mesh, std::vector<unsigned char>& out) {
+    if (mesh.isCpuDataReleased()) return false;
+
+    const std::vector<Vertex>& vertices = mesh.getVertices();
+    const std::vector<unsigned int>& indices = mesh.getIndices();
+    std::vector<unsigned char> vertexStream, indexStream;
+    if (!encodeVertices(vertices.data(), vertices.size(), sizeof(Vertex), vertexStream) ||
+        !encodeIndices(indices.data(), indices.size(), indexStream)) {
+        return false;
+    }
+
+    MeshHeader header;
+    std::memcpy(header.magic, kMeshMagic, 4);
+    header.version = kMeshVersion;
+    header.primitive = static_cast<uint32_t>(mesh.getPrimitiveType());
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    header.stride = static_cast<uint32_t>(sizeof(Vertex));
+    header.vertexBytes = static_cast<uint32_t>(vertexStream.size());
+    header.indexBytes = static_cast<uint32_t>(indexStream.size());
+
+    out.resize(sizeof(header) + vertexStream.size() + indexStream.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), vertexStream.data(), vertexStream.size());
+    std::memcpy(out.data() + sizeof(header) + vertexStream.size(), indexStream.data(), indexStream.size());
+    return true;
+}
+
+std::shared_ptr<CMesh> decodeMesh(const unsigned char* data, size_t size, size_t* consumed) {
+    MeshHeader header;
+    if (size < sizeof(header)) return nullptr;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMeshMagic, 4) != 0 || header.version != kMeshVersion ||
+        header.stride != sizeof(Vertex)) {
+        return nullptr;
+    }
+    size_t total = sizeof(header) + static_cast<size_t>(header.vertexBytes) + header.indexBytes;
+    if (size < total || !isValidPrimitive(header.primitive)) return nullptr;
+
+    // 先用流长度校验数量再分配，损坏的文件头不会触发巨量分配
+    if (header.vertexBytes < getMinVertexBytes(header.vertexCount, header.stride) ||
+        header.indexBytes < 1 + (static_cast<size_t>(header.indexCount) + 1) / 2) {
+        return nullptr;
+    }
+
+    const unsigned char* vertexStream = data + sizeof(header);
+    const unsigned char* indexStream = vertexStream + header.vertexBytes;
+    std::vector<Vertex> vertices(header.vertexCount);
+    std::vector<unsigned int> indices(header.indexCount);
+    if (!decodeVertices(vertexStream, header.vertexBytes, vertices.data(), vertices.size(), sizeof(Vertex)) ||
+        !decodeIndices(indexStream, header.indexBytes, indices.data(), indices.size())) {
+        return nullptr;
+    }
+    for (unsigned int index : indices) {
+        if (index >= vertices.size()) return nullptr;
+    }
+
+    if (consumed) *consumed = total;
+    PrimitiveType primitive = static_cast<PrimitiveType>(header.primitive);
+    if (indices.empty()) {
+        return std::make_shared<CMesh>(std::move(vertices), primitive);
+    }
+    return std::make_shared<CMesh>(std::move(vertices), std::move(indices), primitive);
+}
+
+bool saveMeshes(const std::string& filepath, const std::vector<std::shared_ptr<CMesh>>& meshes) {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file) return false;
+
+    std::vector<unsigned char> encoded;
+    for (const auto& mesh : meshes) {
+        if (!mesh || !encodeMesh(*mesh, encoded)) return false;
+        file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    }
+    return static_cast<bool>(file);
+}
+
+} // namespace MeshCodec
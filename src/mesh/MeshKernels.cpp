@@ -0,0 +1,820 @@
+#include "mesh/MeshKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MESH_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define MESH_KERNELS_X86 0
+#endif
+
+// GCC / Clang 需要在函数级别打开 AVX2 指令集；MSVC 允许直接使用任意 intrinsic
+#if MESH_KERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+#define MESH_KERNELS_TARGET_SSE2 __attribute__((target("sse2")))
+#define MESH_KERNELS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define MESH_KERNELS_TARGET_F16C __attribute__((target("avx2,fma,f16c")))
+#else
+#define MESH_KERNELS_TARGET_SSE2
+#define MESH_KERNELS_TARGET_AVX2
+#define MESH_KERNELS_TARGET_F16C
+#endif
+
+namespace {
+
+typedef MeshKernels::SimdLevel SimdLevel;
+
+inline const float* advance(const float* p, size_t bytes) {
+    return reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(p) + bytes);
+}
+
+inline float* advance(float* p, size_t bytes) {
+    return reinterpret_cast<float*>(reinterpret_cast<unsigned char*>(p) + bytes);
+}
+
+// 矩阵按列主序展开为 12 个 float：c0.xyz c1.xyz c2.xyz c3.xyz
+struct Affine {
+    float c[4][3];
+};
+
+Affine toAffine(const glm::mat4& m) {
+    Affine a;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            a.c[col][row] = m[col][row];
+        }
+    }
+    return a;
+}
+
+Affine toAffine(const glm::mat3& m) {
+    Affine a;
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            a.c[col][row] = m[col][row];
+        }
+    }
+    a.c[3][0] = a.c[3][1] = a.c[3][2] = 0.0f;
+    return a;
+}
+
+// ---------------------------------------------------------------------------
+// 标量实现
+// ---------------------------------------------------------------------------
+
+void aabbScalar(const float* p, size_t count, size_t stride, float* outMin, float* outMax) {
+    float mn[3] = { p[0], p[1], p[2] };
+    float mx[3] = { p[0], p[1], p[2] };
+    for (size_t i = 1; i < count; ++i) {
+        p = advance(p, stride);
+        for (int k = 0; k < 3; ++k) {
+            mn[k] = std::min(mn[k], p[k]);
+            mx[k] = std::max(mx[k], p[k]);
+        }
+    }
+    for (int k = 0; k < 3; ++k) {
+        outMin[k] = mn[k];
+        outMax[k] = mx[k];
+    }
+}
+
+float maxDistSqScalar(const float* p, size_t count, size_t stride, const float* center) {
+    float best = 0.0f;
+    for (size_t i = 0; i < count; ++i, p = advance(p, stride)) {
+        float dx = p[0] - center[0];
+        float dy = p[1] - center[1];
+        float dz = p[2] - center[2];
+        best = std::max(best, dx * dx + dy * dy + dz * dz);
+    }
+    return best;
+}
+
+void transformScalar(const float* in, size_t inStride, float* out, size_t outStride,
+                     size_t count, const Affine& m, bool translate, bool renormalize) {
+    const float tx = translate ? m.c[3][0] : 0.0f;
+    const float ty = translate ? m.c[3][1] : 0.0f;
+    const float tz = translate ? m.c[3][2] : 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        // 先读完整个输入再写，保证原地变换安全
+        float x = in[0], y = in[1], z = in[2];
+        float rx = m.c[0][0] * x + m.c[1][0] * y + m.c[2][0] * z + tx;
+        float ry = m.c[0][1] * x + m.c[1][1] * y + m.c[2][1] * z + ty;
+        float rz = m.c[0][2] * x + m.c[1][2] * y + m.c[2][2] * z + tz;
+        if (renormalize) {
+            float lenSq = rx * rx + ry * ry + rz * rz;
+            if (lenSq > 0.0f) {
+                float inv = 1.0f / std::sqrt(lenSq);
+                rx *= inv;
+                ry *= inv;
+                rz *= inv;
+            }
+        }
+        out[0] = rx;
+        out[1] = ry;
+        out[2] = rz;
+        in = advance(in, inStride);
+        out = advance(out, outStride);
+    }
+}
+
+// 限制范围的写法与 _mm_max_ps / _mm_min_ps 一致：NaN 取下限
+inline float clampLikeSSE(float v, float lo, float hi) {
+    v = v > lo ? v : lo;
+    return v < hi ? v : hi;
+}
+
+inline uint32_t packSnorm10(int x, int y, int z) {
+    return (static_cast<uint32_t>(x) & 0x3FFu) |
+           ((static_cast<uint32_t>(y) & 0x3FFu) << 10) |
+           ((static_cast<uint32_t>(z) & 0x3FFu) << 20);
+}
+
+// 16 位输出补齐为偶数个分量，保证每个属性 4 字节对齐
+inline unsigned paddedComponents(unsigned components) {
+    return (components + 1) & ~1u;
+}
+
+// 就近舍入到偶数，与 F16C 的 _MM_FROUND_TO_NEAREST_INT 一致
+uint16_t floatToHalfScalar(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t absBits = bits & 0x7FFFFFFFu;
+
+    if (absBits >= 0x7F800000u) {
+        // Inf 保持，NaN 转为静默 NaN 并保留高位尾数
+        return static_cast<uint16_t>(sign | (absBits > 0x7F800000u ? 0x7E00u | ((absBits >> 13) & 0x3FFu) : 0x7C00u));
+    }
+    if (absBits >= 0x477FF000u) {
+        // >= 65520 舍入后超出半精度范围
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (absBits < 0x38800000u) {
+        // 半精度非规格化数（< 2^-14），单位 2^-24
+        if (absBits <= 0x33000000u) return static_cast<uint16_t>(sign);
+        uint32_t mantissa = (absBits & 0x7FFFFFu) | 0x800000u;
+        uint32_t shift = 126u - (absBits >> 23);
+        uint32_t result = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (result & 1u))) ++result;
+        return static_cast<uint16_t>(sign | result);
+    }
+    // 规格化数：指数偏置从 127 改为 15，尾数截到 10 位后舍入（进位可以进入指数）
+    uint32_t result = (absBits - 0x38000000u) >> 13;
+    uint32_t remainder = absBits & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u))) ++result;
+    return static_cast<uint16_t>(sign | result);
+}
+
+void encodeSnorm10Scalar(const float* in, size_t inStride, unsigned char* out, size_t outStride, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        int q[3];
+        for (int k = 0; k < 3; ++k) {
+            q[k] = static_cast<int>(std::nearbyint(clampLikeSSE(in[k], -1.0f, 1.0f) * 511.0f));
+        }
+        uint32_t packed = packSnorm10(q[0], q[1], q[2]);
+        std::memcpy(out, &packed, sizeof(packed));
+        in = advance(in, inStride);
+        out += outStride;
+    }
+}
+
+void encodeUnorm16Scalar(const float* in, size_t inStride, unsigned components, const float* bias,
+                         const float* invScale, unsigned char* out, size_t outStride, size_t count) {
+    const unsigned slots = paddedComponents(components);
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t q[4] = { 0, 0, 0, 0 };
+        for (unsigned k = 0; k < components; ++k) {
+            float v = clampLikeSSE((in[k] - bias[k]) * invScale[k], 0.0f, 1.0f);
+            q[k] = static_cast<uint16_t>(std::nearbyint(v * 65535.0f));
+        }
+        std::memcpy(out, q, slots * sizeof(uint16_t));
+        in = advance(in, inStride);
+        out += outStride;
+    }
+}
+
+void encodeHalfScalar(const float* in, size_t inStride, unsigned components, unsigned char* out,
+                      size_t outStride, size_t count) {
+    const unsigned slots = paddedComponents(components);
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t h[4] = { 0, 0, 0, 0 };
+        for (unsigned k = 0; k < components; ++k) {
+            h[k] = floatToHalfScalar(in[k]);
+        }
+        std::memcpy(out, h, slots * sizeof(uint16_t));
+        in = advance(in, inStride);
+        out += outStride;
+    }
+}
+
+#if MESH_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// SSE2 实现
+// ---------------------------------------------------------------------------
+
+// 只读 12 字节，避免越过数组末尾；w 分量为 0
+MESH_KERNELS_TARGET_SSE2 inline __m128 load3(const float* p) {
+    __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)));
+    __m128 z = _mm_load_ss(p + 2);
+    return _mm_movelh_ps(xy, z);
+}
+
+MESH_KERNELS_TARGET_SSE2 inline void store3(float* p, __m128 v) {
+    _mm_store_sd(reinterpret_cast<double*>(p), _mm_castps_pd(v));
+    _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+MESH_KERNELS_TARGET_SSE2 inline void storeMinMax(__m128 mn, __m128 mx, float* outMin, float* outMax) {
+    store3(outMin, mn);
+    store3(outMax, mx);
+}
+
+MESH_KERNELS_TARGET_SSE2
+void aabbSSE2(const float* p, size_t count, size_t stride, float* outMin, float* outMax) {
+    __m128 first = load3(p);
+    __m128 mn0 = first, mx0 = first, mn1 = first, mx1 = first;
+
+    size_t i = 0;
+    // 两组累加器交替使用，打断 min/max 的依赖链
+    for (; i + 4 <= count; i += 4) {
+        __m128 a = load3(p);
+        __m128 b = load3(advance(p, stride));
+        __m128 c = load3(advance(p, stride * 2));
+        __m128 d = load3(advance(p, stride * 3));
+        mn0 = _mm_min_ps(mn0, a); mx0 = _mm_max_ps(mx0, a);
+        mn1 = _mm_min_ps(mn1, b); mx1 = _mm_max_ps(mx1, b);
+        mn0 = _mm_min_ps(mn0, c); mx0 = _mm_max_ps(mx0, c);
+        mn1 = _mm_min_ps(mn1, d); mx1 = _mm_max_ps(mx1, d);
+        p = advance(p, stride * 4);
+    }
+    for (; i < count; ++i) {
+        __m128 a = load3(p);
+        mn0 = _mm_min_ps(mn0, a);
+        mx0 = _mm_max_ps(mx0, a);
+        p = advance(p, stride);
+    }
+    storeMinMax(_mm_min_ps(mn0, mn1), _mm_max_ps(mx0, mx1), outMin, outMax);
+}
+
+MESH_KERNELS_TARGET_SSE2 inline __m128 lengthSq3(__m128 v) {
+    __m128 sq = _mm_mul_ps(v, v);
+    __m128 y = _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 z = _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2));
+    __m128 x = _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(0, 0, 0, 0));
+    return _mm_add_ps(_mm_add_ps(x, y), z);
+}
+
+MESH_KERNELS_TARGET_SSE2
+float maxDistSqSSE2(const float* p, size_t count, size_t stride, const float* center) {
+    __m128 c = load3(center);
+    __m128 best0 = _mm_setzero_ps();
+    __m128 best1 = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128 a = _mm_sub_ps(load3(p), c);
+        __m128 b = _mm_sub_ps(load3(advance(p, stride)), c);
+        best0 = _mm_max_ps(best0, lengthSq3(a));
+        best1 = _mm_max_ps(best1, lengthSq3(b));
+        p = advance(p, stride * 2);
+    }
+    for (; i < count; ++i) {
+        __m128 a = _mm_sub_ps(load3(p), c);
+        best0 = _mm_max_ps(best0, lengthSq3(a));
+        p = advance(p, stride);
+    }
+    // lengthSq3 广播到全部分量，x 分量即为结果
+    return _mm_cvtss_f32(_mm_max_ps(best0, best1));
+}
+
+MESH_KERNELS_TARGET_SSE2
+void transformSSE2(const float* in, size_t inStride, float* out, size_t outStride,
+                   size_t count, const Affine& m, bool translate, bool renormalize) {
+    const __m128 c0 = load3(m.c[0]);
+    const __m128 c1 = load3(m.c[1]);
+    const __m128 c2 = load3(m.c[2]);
+    const __m128 c3 = translate ? load3(m.c[3]) : _mm_setzero_ps();
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        __m128 v = load3(in);
+        __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)),
+                              _mm_add_ps(_mm_mul_ps(c2, z), c3));
+        if (renormalize) {
+            __m128 lenSq = lengthSq3(r);
+            __m128 nonZero = _mm_cmpgt_ps(lenSq, zero);
+            __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(lenSq));
+            __m128 scaled = _mm_mul_ps(r, inv);
+            r = _mm_or_ps(_mm_and_ps(nonZero, scaled), _mm_andnot_ps(nonZero, r));
+        }
+        store3(out, r);
+        in = advance(in, inStride);
+        out = advance(out, outStride);
+    }
+}
+
+// 读取 1~3 个分量，其余分量为 0
+MESH_KERNELS_TARGET_SSE2 inline __m128 loadComponents(const float* p, unsigned components) {
+    if (components >= 3) return load3(p);
+    if (components == 2) return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)));
+    return _mm_load_ss(p);
+}
+
+// 写出低 slots 个 uint16
+MESH_KERNELS_TARGET_SSE2 inline void storePacked16(unsigned char* out, __m128i packed, unsigned slots) {
+    if (slots == 4) {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+    } else {
+        int low = _mm_cvtsi128_si32(packed);
+        std::memcpy(out, &low, sizeof(low));
+    }
+}
+
+// 4 个 [0, 65535] 的 int32 收窄为 uint16：偏移到有符号范围后用饱和打包
+MESH_KERNELS_TARGET_SSE2 inline void storeUnorm16(unsigned char* out, __m128i q, unsigned slots) {
+    const __m128i offset = _mm_set1_epi32(32768);
+    const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+    storePacked16(out, _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(q, offset), _mm_setzero_si128()), flip), slots);
+}
+
+MESH_KERNELS_TARGET_SSE2
+void encodeSnorm10SSE2(const float* in, size_t inStride, unsigned char* out, size_t outStride, size_t count) {
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    const __m128 hi = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(511.0f);
+    for (size_t i = 0; i < count; ++i) {
+        __m128 v = _mm_min_ps(_mm_max_ps(load3(in), lo), hi);
+        // cvtps 按当前舍入模式（默认就近舍入到偶数），与标量的 nearbyint 一致
+        int32_t q[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(q), _mm_cvtps_epi32(_mm_mul_ps(v, scale)));
+        uint32_t packed = packSnorm10(q[0], q[1], q[2]);
+        std::memcpy(out, &packed, sizeof(packed));
+        in = advance(in, inStride);
+        out += outStride;
+    }
+}
+
+MESH_KERNELS_TARGET_SSE2
+void encodeUnorm16SSE2(const float* in, size_t inStride, unsigned components, const float* bias,
+                       const float* invScale, unsigned char* out, size_t outStride, size_t count) {
+    const unsigned slots = paddedComponents(components);
+    const __m128 b = load3(bias);
+    const __m128 s = load3(invScale);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 range = _mm_set1_ps(65535.0f);
+    // 只保留前 components 个分量，其余写 0
+    const __m128i mask = _mm_cmplt_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32(static_cast<int>(components)));
+    for (size_t i = 0; i < count; ++i) {
+        __m128 v = _mm_mul_ps(_mm_sub_ps(loadComponents(in, components), b), s);
+        v = _mm_min_ps(_mm_max_ps(v, zero), one);
+        __m128i q = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(v, range)), mask);
+        storeUnorm16(out, q, slots);
+        in = advance(in, inStride);
+        out += outStride;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA 实现：每次处理两个顶点，高低 128 位各放一个
+// ---------------------------------------------------------------------------
+
+MESH_KERNELS_TARGET_AVX2 inline __m256 load3x2(const float* a, const float* b) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(load3(a)), load3(b), 1);
+}
+
+MESH_KERNELS_TARGET_AVX2
+void aabbAVX2(const float* p, size_t count, size_t stride, float* outMin, float* outMax) {
+    __m256 first = load3x2(p, p);
+    __m256 mn0 = first, mx0 = first, mn1 = first, mx1 = first;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 a = load3x2(p, advance(p, stride));
+        __m256 b = load3x2(advance(p, stride * 2), advance(p, stride * 3));
+        mn0 = _mm256_min_ps(mn0, a); mx0 = _mm256_max_ps(mx0, a);
+        mn1 = _mm256_min_ps(mn1, b); mx1 = _mm256_max_ps(mx1, b);
+        p = advance(p, stride * 4);
+    }
+    __m256 mn = _mm256_min_ps(mn0, mn1);
+    __m256 mx = _mm256_max_ps(mx0, mx1);
+    __m128 mnLo = _mm_min_ps(_mm256_castps256_ps128(mn), _mm256_extractf128_ps(mn, 1));
+    __m128 mxLo = _mm_max_ps(_mm256_castps256_ps128(mx), _mm256_extractf128_ps(mx, 1));
+    for (; i < count; ++i) {
+        __m128 a = load3(p);
+        mnLo = _mm_min_ps(mnLo, a);
+        mxLo = _mm_max_ps(mxLo, a);
+        p = advance(p, stride);
+    }
+    storeMinMax(mnLo, mxLo, outMin, outMax);
+}
+
+MESH_KERNELS_TARGET_AVX2
+float maxDistSqAVX2(const float* p, size_t count, size_t stride, const float* center) {
+    __m256 c = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(center));
+    __m256 best = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m256 d = _mm256_sub_ps(load3x2(p, advance(p, stride)), c);
+        // 0x71：x/y/z 参与点积，结果写入每个 128 位通道的 x 分量
+        best = _mm256_max_ps(best, _mm256_dp_ps(d, d, 0x71));
+        p = advance(p, stride * 2);
+    }
+    __m128 bestLo = _mm_max_ps(_mm256_castps256_ps128(best), _mm256_extractf128_ps(best, 1));
+    for (; i < count; ++i) {
+        __m128 d = _mm_sub_ps(load3(p), _mm256_castps256_ps128(c));
+        bestLo = _mm_max_ps(bestLo, _mm_dp_ps(d, d, 0x71));
+        p = advance(p, stride);
+    }
+    return _mm_cvtss_f32(bestLo);
+}
+
+MESH_KERNELS_TARGET_AVX2
+void transformAVX2(const float* in, size_t inStride, float* out, size_t outStride,
+                   size_t count, const Affine& m, bool translate, bool renormalize) {
+    const __m128 c0s = load3(m.c[0]);
+    const __m128 c1s = load3(m.c[1]);
+    const __m128 c2s = load3(m.c[2]);
+    const __m128 c3s = translate ? load3(m.c[3]) : _mm_setzero_ps();
+    const __m256 c0 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0s), c0s, 1);
+    const __m256 c1 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1s), c1s, 1);
+    const __m256 c2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c2s), c2s, 1);
+    const __m256 c3 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3s), c3s, 1);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const float* in1 = advance(in, inStride);
+        float* out1 = advance(out, outStride);
+
+        __m256 v = load3x2(in, in1);
+        __m256 x = _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 r = _mm256_fmadd_ps(c0, x, _mm256_fmadd_ps(c1, y, _mm256_fmadd_ps(c2, z, c3)));
+        if (renormalize) {
+            __m256 lenSq = _mm256_dp_ps(r, r, 0x7F);
+            __m256 nonZero = _mm256_cmp_ps(lenSq, zero, _CMP_GT_OQ);
+            __m256 scaled = _mm256_mul_ps(r, _mm256_div_ps(one, _mm256_sqrt_ps(lenSq)));
+            r = _mm256_blendv_ps(r, scaled, nonZero);
+        }
+        // 两个顶点都读完后再写，in == out 时同样安全
+        store3(out, _mm256_castps256_ps128(r));
+        store3(out1, _mm256_extractf128_ps(r, 1));
+
+        in = advance(in1, inStride);
+        out = advance(out1, outStride);
+    }
+    if (i < count) {
+        transformSSE2(in, inStride, out, outStride, count - i, m, translate, renormalize);
+    }
+}
+
+MESH_KERNELS_TARGET_AVX2
+void encodeSnorm10AVX2(const float* in, size_t inStride, unsigned char* out, size_t outStride, size_t count) {
+    const __m256 lo = _mm256_set1_ps(-1.0f);
+    const __m256 hi = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(511.0f);
+    const __m256i mask = _mm256_set1_epi32(0x3FF);
+    // x / y / z 移到 0 / 10 / 20 位，w 移出 32 位后为 0
+    const __m256i shifts = _mm256_setr_epi32(0, 10, 20, 32, 0, 10, 20, 32);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const float* in1 = advance(in, inStride);
+        __m256 v = _mm256_min_ps(_mm256_max_ps(load3x2(in, in1), lo), hi);
+        __m256i bits = _mm256_sllv_epi32(_mm256_and_si256(_mm256_cvtps_epi32(_mm256_mul_ps(v, scale)), mask), shifts);
+        // 每个 128 位通道内把 4 个分量或到一起
+        bits = _mm256_or_si256(bits, _mm256_shuffle_epi32(bits, _MM_SHUFFLE(2, 3, 0, 1)));
+        bits = _mm256_or_si256(bits, _mm256_shuffle_epi32(bits, _MM_SHUFFLE(1, 0, 3, 2)));
+        int p0 = _mm_cvtsi128_si32(_mm256_castsi256_si128(bits));
+        int p1 = _mm_cvtsi128_si32(_mm256_extracti128_si256(bits, 1));
+        std::memcpy(out, &p0, sizeof(p0));
+        std::memcpy(out + outStride, &p1, sizeof(p1));
+        in = advance(in1, inStride);
+        out += outStride * 2;
+    }
+    if (i < count) {
+        encodeSnorm10SSE2(in, inStride, out, outStride, count - i);
+    }
+}
+
+MESH_KERNELS_TARGET_AVX2
+void encodeUnorm16AVX2(const float* in, size_t inStride, unsigned components, const float* bias,
+                       const float* invScale, unsigned char* out, size_t outStride, size_t count) {
+    const unsigned slots = paddedComponents(components);
+    const __m128 bs = load3(bias);
+    const __m128 ss = load3(invScale);
+    const __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(bs), bs, 1);
+    const __m256 s = _mm256_insertf128_ps(_mm256_castps128_ps256(ss), ss, 1);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 range = _mm256_set1_ps(65535.0f);
+    const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(components)),
+                                            _mm256_setr_epi32(0, 1, 2, 3, 0, 1, 2, 3));
+    const __m256i offset = _mm256_set1_epi32(32768);
+    const __m256i flip = _mm256_set1_epi16(static_cast<short>(0x8000));
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const float* in1 = advance(in, inStride);
+        __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(loadComponents(in, components)),
+                                        loadComponents(in1, components), 1);
+        v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(v, b), s), zero), one);
+        __m256i q = _mm256_and_si256(_mm256_cvtps_epi32(_mm256_mul_ps(v, range)), mask);
+        // packs 在每个 128 位通道内进行，两个顶点的结果分别位于两个通道的低 64 位
+        __m256i packed = _mm256_xor_si256(_mm256_packs_epi32(_mm256_sub_epi32(q, offset), _mm256_setzero_si256()), flip);
+        storePacked16(out, _mm256_castsi256_si128(packed), slots);
+        storePacked16(out + outStride, _mm256_extracti128_si256(packed, 1), slots);
+        in = advance(in1, inStride);
+        out += outStride * 2;
+    }
+    if (i < count) {
+        encodeUnorm16SSE2(in, inStride, components, bias, invScale, out, outStride, count - i);
+    }
+}
+
+// F16C：每个顶点一次 vcvtps2ph，未读取的分量为 0，编码后也是 0
+MESH_KERNELS_TARGET_F16C
+void encodeHalfF16C(const float* in, size_t inStride, unsigned components, unsigned char* out,
+                    size_t outStride, size_t count) {
+    const unsigned slots = paddedComponents(components);
+    for (size_t i = 0; i < count; ++i) {
+        __m128i h = _mm_cvtps_ph(loadComponents(in, components), _MM_FROUND_TO_NEAREST_INT);
+        if (slots == 4) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), h);
+        } else {
+            int low = _mm_cvtsi128_si32(h);
+            std::memcpy(out, &low, sizeof(low));
+        }
+        in = advance(in, inStride);
+        out += outStride;
+    }
+}
+
+bool cpuSupportsAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool f16c = (info[2] & (1 << 29)) != 0;
+    if (!osxsave || !fma || !avx || !f16c) return false;
+    // 操作系统需要保存 YMM 寄存器状态
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    // libgcc 的检测同时检查了 OSXSAVE / XGETBV
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+#endif
+}
+
+bool cpuSupportsSSE2() {
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif // MESH_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// 分发
+// ---------------------------------------------------------------------------
+
+typedef void (*AABBFunc)(const float*, size_t, size_t, float*, float*);
+typedef float (*MaxDistSqFunc)(const float*, size_t, size_t, const float*);
+typedef void (*TransformFunc)(const float*, size_t, float*, size_t, size_t, const Affine&, bool, bool);
+typedef void (*Snorm10Func)(const float*, size_t, unsigned char*, size_t, size_t);
+typedef void (*Unorm16Func)(const float*, size_t, unsigned, const float*, const float*, unsigned char*, size_t, size_t);
+typedef void (*HalfFunc)(const float*, size_t, unsigned, unsigned char*, size_t, size_t);
+
+struct KernelTable {
+    AABBFunc aabb;
+    MaxDistSqFunc maxDistSq;
+    TransformFunc transform;
+    Snorm10Func encodeSnorm10;
+    Unorm16Func encodeUnorm16;
+    HalfFunc encodeHalf;
+};
+
+const KernelTable kScalarTable = {
+    aabbScalar, maxDistSqScalar, transformScalar,
+    encodeSnorm10Scalar, encodeUnorm16Scalar, encodeHalfScalar
+};
+#if MESH_KERNELS_X86
+// SSE2 没有半精度转换指令，沿用标量实现
+const KernelTable kSSE2Table = {
+    aabbSSE2, maxDistSqSSE2, transformSSE2,
+    encodeSnorm10SSE2, encodeUnorm16SSE2, encodeHalfScalar
+};
+const KernelTable kAVX2Table = {
+    aabbAVX2, maxDistSqAVX2, transformAVX2,
+    encodeSnorm10AVX2, encodeUnorm16AVX2, encodeHalfF16C
+};
+#endif
+
+SimdLevel detectLevel() {
+#if MESH_KERNELS_X86
+    if (cpuSupportsSSE2()) {
+        return cpuSupportsAVX2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel detectedLevel() {
+    static const SimdLevel level = detectLevel();
+    return level;
+}
+
+std::atomic<int>& activeLevelStorage() {
+    static std::atomic<int> level(static_cast<int>(detectedLevel()));
+    return level;
+}
+
+const KernelTable& kernels() {
+    switch (static_cast<SimdLevel>(activeLevelStorage().load(std::memory_order_relaxed))) {
+#if MESH_KERNELS_X86
+        case SimdLevel::AVX2: return kAVX2Table;
+        case SimdLevel::SSE2: return kSSE2Table;
+#endif
+        default: return kScalarTable;
+    }
+}
+
+} // namespace
+
+MeshKernels::SimdLevel MeshKernels::getDetectedLevel() {
+    return detectedLevel();
+}
+
+MeshKernels::SimdLevel MeshKernels::getActiveLevel() {
+    return static_cast<SimdLevel>(activeLevelStorage().load());
+}
+
+void MeshKernels::setActiveLevel(SimdLevel level) {
+    SimdLevel clamped = std::min(level, detectedLevel());
+    activeLevelStorage() = static_cast<int>(clamped);
+}
+
+const char* MeshKernels::getLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE2: return "SSE2";
+        default: return "Scalar";
+    }
+}
+
+bool MeshKernels::computeAABB(const float* positions, size_t count, size_t stride,
+                              glm::vec3& outMin, glm::vec3& outMax) {
+    if (!positions || count == 0) {
+        return false;
+    }
+    float mn[3], mx[3];
+    kernels().aabb(positions, count, stride, mn, mx);
+    outMin = glm::vec3(mn[0], mn[1], mn[2]);
+    outMax = glm::vec3(mx[0], mx[1], mx[2]);
+    return true;
+}
+
+bool MeshKernels::computeAABB(const std::vector<Vertex>& vertices, glm::vec3& outMin, glm::vec3& outMax) {
+    if (vertices.empty()) {
+        return false;
+    }
+    return computeAABB(&vertices[0].position.x, vertices.size(), sizeof(Vertex), outMin, outMax);
+}
+
+bool MeshKernels::computeBoundingSphere(const float* positions, size_t count, size_t stride,
+                                        glm::vec3& outCenter, float& outRadius) {
+    glm::vec3 mn, mx;
+    if (!computeAABB(positions, count, stride, mn, mx)) {
+        return false;
+    }
+    outCenter = (mn + mx) * 0.5f;
+    // AVX2 路径按 16 字节广播球心，留出第 4 个分量
+    float center[4] = { outCenter.x, outCenter.y, outCenter.z, 0.0f };
+    outRadius = std::sqrt(kernels().maxDistSq(positions, count, stride, center));
+    return true;
+}
+
+bool MeshKernels::computeBoundingSphere(const std::vector<Vertex>& vertices, glm::vec3& outCenter, float& outRadius) {
+    if (vertices.empty()) {
+        return false;
+    }
+    return computeBoundingSphere(&vertices[0].position.x, vertices.size(), sizeof(Vertex), outCenter, outRadius);
+}
+
+void MeshKernels::transformPositions(const float* in, size_t inStride, float* out, size_t outStride,
+                                     size_t count, const glm::mat4& matrix) {
+    if (!in || !out || count == 0) return;
+    kernels().transform(in, inStride, out, outStride, count, toAffine(matrix), true, false);
+}
+
+void MeshKernels::transformNormals(const float* in, size_t inStride, float* out, size_t outStride,
+                                   size_t count, const glm::mat3& normalMatrix, bool renormalize) {
+    if (!in || !out || count == 0) return;
+    kernels().transform(in, inStride, out, outStride, count, toAffine(normalMatrix), false, renormalize);
+}
+
+void MeshKernels::transformVertices(Vertex* vertices, size_t count, const glm::mat4& model) {
+    if (!vertices || count == 0) return;
+
+    const size_t stride = sizeof(Vertex);
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+    // 切线和副切线沿表面方向，用模型矩阵本身变换
+    glm::mat3 tangentMatrix(model);
+
+    transformPositions(&vertices[0].position.x, stride, &vertices[0].position.x, stride, count, model);
+    transformNormals(&vertices[0].normal.x, stride, &vertices[0].normal.x, stride, count, normalMatrix);
+    transformNormals(&vertices[0].tangent.x, stride, &vertices[0].tangent.x, stride, count, tangentMatrix);
+    transformNormals(&vertices[0].bitangent.x, stride, &vertices[0].bitangent.x, stride, count, tangentMatrix);
+}
+
+void MeshKernels::transformAABB(const glm::vec3& min, const glm::vec3& max, const glm::mat4& matrix,
+                                glm::vec3& outMin, glm::vec3& outMax) {
+    glm::vec3 translation(matrix[3]);
+    glm::vec3 newMin = translation;
+    glm::vec3 newMax = translation;
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            float a = matrix[col][row] * min[col];
+            float b = matrix[col][row] * max[col];
+            newMin[row] += std::min(a, b);
+            newMax[row] += std::max(a, b);
+        }
+    }
+    outMin = newMin;
+    outMax = newMax;
+}
+
+void MeshKernels::encodeSnorm10(const float* in, size_t inStride, void* out, size_t outStride, size_t count) {
+    if (!in || !out || count == 0) return;
+    kernels().encodeSnorm10(in, inStride, static_cast<unsigned char*>(out), outStride, count);
+}
+
+void MeshKernels::encodeUnorm16(const float* in, size_t inStride, unsigned components,
+                                const glm::vec3& bias, const glm::vec3& invScale,
+                                void* out, size_t outStride, size_t count) {
+    if (!in || !out || count == 0 || components == 0 || components > 3) return;
+    // SSE2 路径按 12 字节读取 bias / invScale
+    const float b[3] = { bias.x, bias.y, bias.z };
+    const float s[3] = { invScale.x, invScale.y, invScale.z };
+    kernels().encodeUnorm16(in, inStride, components, b, s, static_cast<unsigned char*>(out), outStride, count);
+}
+
+void MeshKernels::encodeHalf(const float* in, size_t inStride, unsigned components,
+                             void* out, size_t outStride, size_t count) {
+    if (!in || !out || count == 0 || components == 0 || components > 3) return;
+    kernels().encodeHalf(in, inStride, components, static_cast<unsigned char*>(out), outStride, count);
+}
+
+uint16_t MeshKernels::floatToHalf(float value) {
+    return floatToHalfScalar(value);
+}
+
+float MeshKernels::halfToFloat(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // 非规格化数：mantissa * 2^-24，可以精确表示为 float
+        float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+        std::memcpy(&bits, &magnitude, sizeof(bits));
+        bits |= sign;
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
@@ -3,81 +3,292 @@
 #include <cmath>
 
 #include "mesh/MeshUtils.h"
+#include "core/Parallel.h"
+#include "mesh/MeshKernels.h"
+#include "mesh/PrimitiveTables.h"
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
 
 // 基础几何体生成
-std::shared_ptr<CMesh> MeshUtils::createCube(float size) {
+namespace {
+
+// 每个 worker 至少生成的顶点数，分段数不高时整个几何体在调用线程内生成
+const size_t kPrimitiveVertexGrain = 16384;
+
+// 按行（环）并行生成，每行 rowVertices 个顶点；fn(row) 写入该行的顶点和以该行为起点的索引
+template <typename Fn>
+void forEachRow(unsigned int rows, unsigned int rowVertices, Fn fn) {
+    size_t grain = std::max<size_t>(1, kPrimitiveVertexGrain / std::max(1u, rowVertices));
+    Parallel::forRange(rows, grain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t row = begin; row < end; ++row) {
+            fn(static_cast<unsigned int>(row));
+        }
+    });
+}
+
+// 相邻两行顶点之间的 quads 个四边形，每个写入 (current, next, current + 1), (current + 1, next, next + 1)
+void writeQuadRow(unsigned int* out, unsigned int rowStart, unsigned int rowStride, unsigned int quads) {
+    for (unsigned int i = 0; i < quads; ++i) {
+        unsigned int current = rowStart + i;
+        unsigned int next = current + rowStride;
+        out[0] = current;
+        out[1] = next;
+        out[2] = current + 1;
+        out[3] = current + 1;
+        out[4] = next;
+        out[5] = next + 1;
+        out += 6;
+    }
+}
+
+enum class PrimitiveShape { Cube, Sphere, Plane, Cylinder, Cone, Torus, Capsule, StaticCube, StaticSphere, StaticTorus };
+
+// 缓存键：形状、浮点参数的位模式和分段数，未使用的参数为 0
+struct PrimitiveKey {
+    PrimitiveShape shape;
+    uint32_t params[2];
+    unsigned int segments[2];
+
+    PrimitiveKey(PrimitiveShape s, float a, float b, unsigned int segmentsA, unsigned int segmentsB)
+        : shape(s) {
+        float values[2] = { a + 0.0f, b + 0.0f };  // 把 -0.0 归一到 +0.0
+        std::memcpy(params, values, sizeof(params));
+        segments[0] = segmentsA;
+        segments[1] = segmentsB;
+    }
+
+    bool operator==(const PrimitiveKey& other) const {
+        return shape == other.shape &&
+               params[0] == other.params[0] && params[1] == other.params[1] &&
+               segments[0] == other.segments[0] && segments[1] == other.segments[1];
+    }
+};
+
+struct PrimitiveKeyHash {
+    size_t operator()(const PrimitiveKey& key) const {
+        size_t h = static_cast<size_t>(key.shape);
+        h = h * 0x9E3779B1u ^ key.params[0];
+        h = h * 0x9E3779B1u ^ key.params[1];
+        h = h * 0x9E3779B1u ^ key.segments[0];
+        h = h * 0x9E3779B1u ^ key.segments[1];
+        return h;
+    }
+};
+
+// 条目只持有原型网格的弱引用；原型由返回给调用方的拷贝共同持有
+struct PrimitiveCache {
+    std::mutex mutex;
+    std::unordered_map<PrimitiveKey, std::weak_ptr<CMesh>, PrimitiveKeyHash> entries;
+    MeshUtils::PrimitiveCacheStats stats;
+    size_t pruneThreshold = 64;     // 条目数达到该值时清理失效条目
+    bool enabled = true;
+};
+
+PrimitiveCache& primitiveCache() {
+    static PrimitiveCache cache;
+    return cache;
+}
+
+typedef std::function<void(std::vector<Vertex>&, std::vector<unsigned int>&)> PrimitiveGenerator;
+
+std::shared_ptr<CMesh> buildPrimitive(const PrimitiveGenerator& generate) {
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
+    generate(vertices, indices);
     
-    float halfSize = size * 0.5f;
+    auto mesh = std::make_shared<CMesh>(std::move(vertices), std::move(indices));
+    mesh->calculateBoundingBox();
+    return mesh;
+}
+
+// 与原型共享几何数据的拷贝（材质独立）；拷贝持有原型，最后一个拷贝销毁时原型和几何数据一起释放
+std::shared_ptr<CMesh> shareGeometry(const std::shared_ptr<CMesh>& prototype) {
+    return std::shared_ptr<CMesh>(new CMesh(*prototype), [prototype](CMesh* mesh) { delete mesh; });
+}
+
+// 静态表直接上传，不生成 CPU 端数组
+std::shared_ptr<CMesh> buildStaticPrimitive(const PrimitiveTables::TableView& table) {
+    return std::make_shared<CMesh>(VertexAttributeLayout::PositionNormalTex(), table.vertices, table.vertexCount,
+                                   table.indices, table.indexCount,
+                                   glm::vec3(table.boundsMin[0], table.boundsMin[1], table.boundsMin[2]),
+                                   glm::vec3(table.boundsMax[0], table.boundsMax[1], table.boundsMax[2]));
+}
+
+// 调用方已持有 cache.mutex；requireCpuData 时 CPU 数据已释放的条目视为未命中
+std::shared_ptr<CMesh> findPrimitive(PrimitiveCache& cache, const PrimitiveKey& key, bool requireCpuData) {
+    auto it = cache.entries.find(key);
+    if (it == cache.entries.end()) return nullptr;
     
-    // 立方体的8个顶点
-    vertices = {
-        // 前面 (Z+)
-        Vertex(glm::vec3(-halfSize, -halfSize, halfSize), glm::vec3(0, 0, 1), glm::vec2(0, 0)),
-        Vertex(glm::vec3(halfSize, -halfSize, halfSize), glm::vec3(0, 0, 1), glm::vec2(1, 0)),
-        Vertex(glm::vec3(halfSize, halfSize, halfSize), glm::vec3(0, 0, 1), glm::vec2(1, 1)),
-        Vertex(glm::vec3(-halfSize, halfSize, halfSize), glm::vec3(0, 0, 1), glm::vec2(0, 1)),
-        
-        // 后面 (Z-)
-        Vertex(glm::vec3(-halfSize, -halfSize, -halfSize), glm::vec3(0, 0, -1), glm::vec2(0, 0)),
-        Vertex(glm::vec3(halfSize, -halfSize, -halfSize), glm::vec3(0, 0, -1), glm::vec2(1, 0)),
-        Vertex(glm::vec3(halfSize, halfSize, -halfSize), glm::vec3(0, 0, -1), glm::vec2(1, 1)),
-        Vertex(glm::vec3(-halfSize, halfSize, -halfSize), glm::vec3(0, 0, -1), glm::vec2(0, 1)),
-        
-        // 左面 (X-)
-        Vertex(glm::vec3(-halfSize, -halfSize, -halfSize), glm::vec3(-1, 0, 0), glm::vec2(0, 0)),
-        Vertex(glm::vec3(-halfSize, -halfSize, halfSize), glm::vec3(-1, 0, 0), glm::vec2(1, 0)),
-        Vertex(glm::vec3(-halfSize, halfSize, halfSize), glm::vec3(-1, 0, 0), glm::vec2(1, 1)),
-        Vertex(glm::vec3(-halfSize, halfSize, -halfSize), glm::vec3(-1, 0, 0), glm::vec2(0, 1)),
-        
-        // 右面 (X+)
-        Vertex(glm::vec3(halfSize, -halfSize, -halfSize), glm::vec3(1, 0, 0), glm::vec2(0, 0)),
-        Vertex(glm::vec3(halfSize, -halfSize, halfSize), glm::vec3(1, 0, 0), glm::vec2(1, 0)),
-        Vertex(glm::vec3(halfSize, halfSize, halfSize), glm::vec3(1, 0, 0), glm::vec2(1, 1)),
-        Vertex(glm::vec3(halfSize, halfSize, -halfSize), glm::vec3(1, 0, 0), glm::vec2(0, 1)),
-        
-        // 底面 (Y-)
-        Vertex(glm::vec3(-halfSize, -halfSize, -halfSize), glm::vec3(0, -1, 0), glm::vec2(0, 0)),
-        Vertex(glm::vec3(halfSize, -halfSize, -halfSize), glm::vec3(0, -1, 0), glm::vec2(1, 0)),
-        Vertex(glm::vec3(halfSize, -halfSize, halfSize), glm::vec3(0, -1, 0), glm::vec2(1, 1)),
-        Vertex(glm::vec3(-halfSize, -halfSize, halfSize), glm::vec3(0, -1, 0), glm::vec2(0, 1)),
-        
-        // 顶面 (Y+)
-        Vertex(glm::vec3(-halfSize, halfSize, -halfSize), glm::vec3(0, 1, 0), glm::vec2(0, 0)),
-        Vertex(glm::vec3(halfSize, halfSize, -halfSize), glm::vec3(0, 1, 0), glm::vec2(1, 0)),
-        Vertex(glm::vec3(halfSize, halfSize, halfSize), glm::vec3(0, 1, 0), glm::vec2(1, 1)),
-        Vertex(glm::vec3(-halfSize, halfSize, halfSize), glm::vec3(0, 1, 0), glm::vec2(0, 1))
-    };
+    std::shared_ptr<CMesh> prototype = it->second.lock();
+    if (!prototype || (requireCpuData && prototype->isCpuDataReleased())) return nullptr;
+    ++cache.stats.hits;
+    return shareGeometry(prototype);
+}
+
+std::shared_ptr<CMesh> insertPrimitive(PrimitiveCache& cache, const PrimitiveKey& key,
+                                       const std::shared_ptr<CMesh>& prototype) {
+    ++cache.stats.misses;
+    cache.entries[key] = prototype;
     
-    // 立方体的12个三角形（6个面，每个面2个三角形）
-    indices = {
-        // 前面
-        0, 1, 2, 2, 3, 0,
-        // 后面
-        4, 6, 5, 6, 4, 7,
-        // 左面
-        8, 9, 10, 10, 11, 8,
-        // 右面
-        12, 14, 13, 14, 12, 15,
-        // 底面
-        16, 18, 17, 18, 16, 19,
-        // 顶面
-        20, 21, 22, 22, 23, 20
-    };
+    if (cache.entries.size() >= cache.pruneThreshold) {
+        for (auto entry = cache.entries.begin(); entry != cache.entries.end();) {
+            if (entry->second.expired()) entry = cache.entries.erase(entry);
+            else ++entry;
+        }
+        cache.pruneThreshold = std::max<size_t>(64, cache.entries.size() * 2);
+    }
+    return shareGeometry(prototype);
+}
+
+std::shared_ptr<CMesh> acquirePrimitive(const PrimitiveKey& key, const PrimitiveGenerator& generate) {
+    PrimitiveCache& cache = primitiveCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (!cache.enabled) {
+        return buildPrimitive(generate);
+    }
     
-    auto mesh = std::make_shared<CMesh>(vertices, indices);
-    mesh->calculateBoundingBox();
-    return mesh;
+    std::shared_ptr<CMesh> mesh = findPrimitive(cache, key, true);
+    return mesh ? mesh : insertPrimitive(cache, key, buildPrimitive(generate));
+}
+
+std::shared_ptr<CMesh> acquireStaticPrimitive(const PrimitiveKey& key, const PrimitiveTables::TableView& table) {
+    if (table.empty()) return nullptr;
+    
+    PrimitiveCache& cache = primitiveCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (!cache.enabled) {
+        return buildStaticPrimitive(table);
+    }
+    
+    std::shared_ptr<CMesh> mesh = findPrimitive(cache, key, false);
+    return mesh ? mesh : insertPrimitive(cache, key, buildStaticPrimitive(table));
+}
+
+} // namespace
+
+std::shared_ptr<CMesh> MeshUtils::createCube(float size) {
+    return acquirePrimitive(PrimitiveKey(PrimitiveShape::Cube, size, 0.0f, 0, 0),
+        [&](std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+            generateCubeVertices(vertices, indices, size);
+        });
 }
 
 std::shared_ptr<CMesh> MeshUtils::createSphere(float radius, unsigned int segments) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    return acquirePrimitive(PrimitiveKey(PrimitiveShape::Sphere, radius, 0.0f, segments, 0),
+        [&](std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+            generateSphereVertices(vertices, indices, radius, segments);
+        });
+}
+
+std::shared_ptr<CMesh> MeshUtils::createPlane(float width, float height, unsigned int widthSegments, unsigned int heightSegments) {
+    return acquirePrimitive(PrimitiveKey(PrimitiveShape::Plane, width, height, widthSegments, heightSegments),
+        [&](std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+            generatePlaneVertices(vertices, indices, width, height, widthSegments, heightSegments);
+        });
+}
+
+std::shared_ptr<CMesh> MeshUtils::createCylinder(float radius, float height, unsigned int segments) {
+    return acquirePrimitive(PrimitiveKey(PrimitiveShape::Cylinder, radius, height, segments, 0),
+        [&](std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+            generateCylinderVertices(vertices, indices, radius, height, segments);
+        });
+}
+
+std::shared_ptr<CMesh> MeshUtils::createCone(float radius, float height, unsigned int segments) {
+    return acquirePrimitive(PrimitiveKey(PrimitiveShape::Cone, radius, height, segments, 0),
+        [&](std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+            generateConeVertices(vertices, indices, radius, height, segments);
+        });
+}
+
+std::shared_ptr<CMesh> MeshUtils::createTorus(float outerRadius, float innerRadius, unsigned int sides, unsigned int rings) {
+    return acquirePrimitive(PrimitiveKey(PrimitiveShape::Torus, outerRadius, innerRadius, sides, rings),
+        [&](std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+            generateTorusVertices(vertices, indices, outerRadius, innerRadius, sides, rings);
+        });
+}
+
+std::shared_ptr<CMesh> MeshUtils::createCapsule(float radius, float height, unsigned int segments) {
+    return acquirePrimitive(PrimitiveKey(PrimitiveShape::Capsule, radius, height, segments, 0),
+        [&](std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+            generateCapsuleVertices(vertices, indices, radius, height, segments);
+        });
+}
+
+std::shared_ptr<CMesh> MeshUtils::createStaticCube() {
+    return acquireStaticPrimitive(PrimitiveKey(PrimitiveShape::StaticCube, 0.0f, 0.0f, 0, 0),
+                                  PrimitiveTables::cube());
+}
+
+std::shared_ptr<CMesh> MeshUtils::createStaticSphere(unsigned int segments) {
+    return acquireStaticPrimitive(PrimitiveKey(PrimitiveShape::StaticSphere, 0.0f, 0.0f, segments, 0),
+                                  PrimitiveTables::sphere(segments));
+}
+
+std::shared_ptr<CMesh> MeshUtils::createStaticTorus(unsigned int segments) {
+    return acquireStaticPrimitive(PrimitiveKey(PrimitiveShape::StaticTorus, 0.0f, 0.0f, segments, 0),
+                                  PrimitiveTables::torus(segments));
+}
+
+// 几何体缓存
+void MeshUtils::setPrimitiveCacheEnabled(bool enabled) {
+    PrimitiveCache& cache = primitiveCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.enabled = enabled;
+}
+
+bool MeshUtils::isPrimitiveCacheEnabled() {
+    PrimitiveCache& cache = primitiveCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.enabled;
+}
+
+MeshUtils::PrimitiveCacheStats MeshUtils::getPrimitiveCacheStats() {
+    PrimitiveCache& cache = primitiveCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    PrimitiveCacheStats stats = cache.stats;
+    stats.liveEntries = 0;
+    for (const auto& entry : cache.entries) {
+        if (!entry.second.expired()) ++stats.liveEntries;
+    }
+    return stats;
+}
+
+void MeshUtils::clearPrimitiveCache() {
+    PrimitiveCache& cache = primitiveCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.clear();
+    cache.stats = PrimitiveCacheStats();
+    cache.pruneThreshold = 64;
+}
+
+void MeshUtils::generateCubeVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, float size) {
+    // 顶点来自编译期生成的静态表，按边长缩放
+    PrimitiveTables::copyTo(PrimitiveTables::cube(), size, vertices, indices);
+}
+
+void MeshUtils::generateSphereVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                       float radius, unsigned int segments) {
+    // 常用分段数直接展开编译期生成的静态表，不做三角函数运算
+    PrimitiveTables::TableView table = PrimitiveTables::sphere(segments);
+    if (!table.empty()) {
+        PrimitiveTables::copyTo(table, radius, vertices, indices);
+        return;
+    }
+    
+    const unsigned int columns = segments + 1;
+    vertices.resize(static_cast<size_t>(columns) * (segments + 1));
+    indices.resize(static_cast<size_t>(segments) * segments * 6);
     
-    // 生成球体顶点
-    for (unsigned int y = 0; y <= segments; ++y) {
+    // 每个环生成一行顶点，以及该环与下一环之间的索引
+    forEachRow(segments + 1, columns, [&](unsigned int y) {
         for (unsigned int x = 0; x <= segments; ++x) {
             float xSegment = (float)x / (float)segments;
             float ySegment = (float)y / (float)segments;
@@ -85,75 +296,53 @@ std::shared_ptr<CMesh> MeshUtils::createSphere(float radius, unsigned int segmen
             float yPos = std::cos(ySegment * M_PI);
             float zPos = std::sin(xSegment * 2.0f * M_PI) * std::sin(ySegment * M_PI);
             
-            Vertex vertex;
+            Vertex& vertex = vertices[y * columns + x];
             vertex.position = glm::vec3(xPos, yPos, zPos) * radius;
             vertex.normal = glm::vec3(xPos, yPos, zPos);
             vertex.texCoords = glm::vec2(xSegment, ySegment);
-            vertices.push_back(vertex);
         }
-    }
-    
-    // 生成索引
-    for (unsigned int y = 0; y < segments; ++y) {
+        if (y == segments) return;
+        
+        unsigned int* out = &indices[static_cast<size_t>(y) * segments * 6];
         for (unsigned int x = 0; x < segments; ++x) {
-            indices.push_back((y + 1) * (segments + 1) + x);
-            indices.push_back(y * (segments + 1) + x);
-            indices.push_back(y * (segments + 1) + x + 1);
+            *out++ = (y + 1) * columns + x;
+            *out++ = y * columns + x;
+            *out++ = y * columns + x + 1;
             
-            indices.push_back((y + 1) * (segments + 1) + x + 1);
-            indices.push_back(y * (segments + 1) + x + 1);
-            indices.push_back((y + 1) * (segments + 1) + x);
+            *out++ = (y + 1) * columns + x + 1;
+            *out++ = y * columns + x + 1;
+            *out++ = (y + 1) * columns + x;
         }
-    }
-    
-    auto mesh = std::make_shared<CMesh>(vertices, indices);
-    mesh->calculateBoundingBox();
-    return mesh;
+    });
 }
 
-std::shared_ptr<CMesh> MeshUtils::createPlane(float width, float height, unsigned int widthSegments, unsigned int heightSegments) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    
+void MeshUtils::generatePlaneVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                      float width, float height, unsigned int widthSegments, unsigned int heightSegments) {
     float halfWidth = width * 0.5f;
     float halfHeight = height * 0.5f;
+    const unsigned int columns = widthSegments + 1;
+    vertices.resize(static_cast<size_t>(columns) * (heightSegments + 1));
+    indices.resize(static_cast<size_t>(widthSegments) * heightSegments * 6);
     
-    // 生成平面顶点
-    for (unsigned int y = 0; y <= heightSegments; ++y) {
+    // 每行顶点与该行到下一行之间的索引
+    forEachRow(heightSegments + 1, columns, [&](unsigned int y) {
         for (unsigned int x = 0; x <= widthSegments; ++x) {
             float xPos = (float)x / (float)widthSegments * width - halfWidth;
             float yPos = (float)y / (float)heightSegments * height - halfHeight;
             
-            Vertex vertex;
+            Vertex& vertex = vertices[y * columns + x];
             vertex.position = glm::vec3(xPos, 0.0f, yPos);
             vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
             vertex.texCoords = glm::vec2((float)x / widthSegments, (float)y / heightSegments);
-            vertices.push_back(vertex);
         }
-    }
-    
-    // 生成索引
-    for (unsigned int y = 0; y < heightSegments; ++y) {
-        for (unsigned int x = 0; x < widthSegments; ++x) {
-            indices.push_back(y * (widthSegments + 1) + x);
-            indices.push_back((y + 1) * (widthSegments + 1) + x);
-            indices.push_back(y * (widthSegments + 1) + x + 1);
-            
-            indices.push_back(y * (widthSegments + 1) + x + 1);
-            indices.push_back((y + 1) * (widthSegments + 1) + x);
-            indices.push_back((y + 1) * (widthSegments + 1) + x + 1);
-        }
-    }
-    
-    auto mesh = std::make_shared<CMesh>(vertices, indices);
-    mesh->calculateBoundingBox();
-    return mesh;
+        if (y == heightSegments) return;
+        
+        writeQuadRow(&indices[static_cast<size_t>(y) * widthSegments * 6], y * columns, columns, widthSegments);
+    });
 }
 
-std::shared_ptr<CMesh> MeshUtils::createCylinder(float radius, float height, unsigned int segments) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    
+void MeshUtils::generateCylinderVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                         float radius, float height, unsigned int segments) {
     float halfHeight = height * 0.5f;
     float angleStep = 2.0f * M_PI / segments;
     
@@ -240,16 +429,10 @@ std::shared_ptr<CMesh> MeshUtils::createCylinder(float radius, float height, uns
         indices.push_back(topCenterIdx + i + 1);
         indices.push_back(topCenterIdx + i + 2);
     }
-    
-    auto mesh = std::make_shared<CMesh>(vertices, indices);
-    mesh->calculateBoundingBox();
-    return mesh;
 }
 
-std::shared_ptr<CMesh> MeshUtils::createCone(float radius, float height, unsigned int segments) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    
+void MeshUtils::generateConeVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                     float radius, float height, unsigned int segments) {
     float halfHeight = height * 0.5f;
     float angleStep = 2.0f * M_PI / segments;
     
@@ -313,37 +496,342 @@ std::shared_ptr<CMesh> MeshUtils::createCone(float radius, float height, unsigne
         indices.push_back(bottomCenterIdx + i + 2);
         indices.push_back(bottomCenterIdx + i + 1);
     }
-    
-    auto mesh = std::make_shared<CMesh>(vertices, indices);
-    mesh->calculateBoundingBox();
-    return mesh;
 }
 
 // 顶点计算
-void MeshUtils::calculateNormals(std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-    std::vector<glm::vec3> normals(vertices.size(), glm::vec3(0.0f));
-    
-    // 计算面法线并累加到顶点
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        if (i + 2 >= indices.size()) break;
-        
-        const Vertex& v0 = vertices[indices[i]];
-        const Vertex& v1 = vertices[indices[i + 1]];
-        const Vertex& v2 = vertices[indices[i + 2]];
-        
-        glm::vec3 edge1 = v1.position - v0.position;
-        glm::vec3 edge2 = v2.position - v0.position;
-        glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
-        
-        normals[indices[i]] += normal;
-        normals[indices[i + 1]] += normal;
-        normals[indices[i + 2]] += normal;
+namespace {
+
+// 每个 worker 至少处理的三角形 / 顶点数，避免小网格开线程得不偿失
+const size_t kTriangleGrain = 8192;
+const size_t kVertexGrain = 16384;
+
+// 每个三角形的单位面法线和三个顶角处的权重（面积 × 顶角）
+struct FaceInfo {
+    glm::vec3 normal;
+    float weight[3];
+};
+
+float angleBetween(const glm::vec3& a, const glm::vec3& b) {
+    float lenSq = glm::dot(a, a) * glm::dot(b, b);
+    if (lenSq <= 0.0f) return 0.0f;
+    float c = glm::dot(a, b) / std::sqrt(lenSq);
+    return std::acos(std::max(-1.0f, std::min(1.0f, c)));
+}
+
+// 三角形顶角
+void cornerAngles(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, float angles[3]) {
+    angles[0] = angleBetween(p1 - p0, p2 - p0);
+    angles[1] = angleBetween(p2 - p1, p0 - p1);
+    angles[2] = static_cast<float>(M_PI) - angles[0] - angles[1];
+    if (angles[2] < 0.0f) angles[2] = 0.0f;
+}
+
+bool isValidTriangle(const std::vector<unsigned int>& indices, size_t tri, size_t vertexCount) {
+    return indices[tri * 3] < vertexCount &&
+           indices[tri * 3 + 1] < vertexCount &&
+           indices[tri * 3 + 2] < vertexCount;
+}
+
+void computeFaceInfo(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                     std::vector<FaceInfo>& faces) {
+    size_t triangleCount = indices.size() / 3;
+    faces.resize(triangleCount);
+
+    Parallel::forRange(triangleCount, kTriangleGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t t = begin; t < end; ++t) {
+            FaceInfo& face = faces[t];
+            face.normal = glm::vec3(0.0f);
+            face.weight[0] = face.weight[1] = face.weight[2] = 0.0f;
+            if (!isValidTriangle(indices, t, vertices.size())) continue;
+
+            const glm::vec3& p0 = vertices[indices[t * 3]].position;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float len = glm::length(n);
+            if (len <= 1e-20f) continue;  // 退化三角形不参与
+
+            float area = 0.5f * len;
+            float angles[3];
+            cornerAngles(p0, p1, p2, angles);
+
+            face.normal = n / len;
+            for (int k = 0; k < 3; ++k) {
+                face.weight[k] = area * angles[k];
+            }
+        }
+    });
+}
+
+struct PositionKey {
+    uint32_t bits[3];
+    bool operator==(const PositionKey& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
     }
-    
-    // 归一化顶点法线
-    for (size_t i = 0; i < normals.size(); ++i) {
-        vertices[i].normal = glm::normalize(normals[i]);
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& key) const {
+        size_t h = key.bits[0];
+        h = h * 0x9E3779B1u ^ key.bits[1];
+        h = h * 0x9E3779B1u ^ key.bits[2];
+        return h;
+    }
+};
+
+// 按位置焊接：返回每个顶点所属的位置组，使 UV 接缝两侧的顶点共享平滑法线
+unsigned int weldPositions(const std::vector<Vertex>& vertices, std::vector<unsigned int>& groupOf) {
+    std::unordered_map<PositionKey, unsigned int, PositionKeyHash> groups;
+    groups.reserve(vertices.size());
+    groupOf.resize(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        PositionKey key;
+        for (int c = 0; c < 3; ++c) {
+            float v = vertices[i].position[c] + 0.0f;  // 把 -0.0 归一到 +0.0
+            std::memcpy(&key.bits[c], &v, sizeof(float));
+        }
+        auto result = groups.insert(std::make_pair(key, static_cast<unsigned int>(groups.size())));
+        groupOf[i] = result.first->second;
     }
+    return static_cast<unsigned int>(groups.size());
+}
+
+// 顶点是否标记为保留原法线
+bool keepsNormal(const std::vector<char>* keepNormals, size_t vertex) {
+    return keepNormals && vertex < keepNormals->size() && (*keepNormals)[vertex];
+}
+
+} // namespace
+
+void MeshUtils::calculateNormals(std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                 const std::vector<char>* keepNormals) {
+    if (vertices.empty() || indices.size() < 3) return;
+
+    std::vector<unsigned int> groupOf;
+    unsigned int groupCount = weldPositions(vertices, groupOf);
+
+    std::vector<FaceInfo> faces;
+    computeFaceInfo(vertices, indices, faces);
+
+    // 每个 worker 累加到自己的缓冲区，避免写冲突
+    size_t triangleCount = faces.size();
+    unsigned int workers = Parallel::getWorkerCount(triangleCount, kTriangleGrain);
+    std::vector<std::vector<glm::vec3>> partial(workers);
+
+    Parallel::forRange(triangleCount, kTriangleGrain, [&](size_t begin, size_t end, unsigned int worker) {
+        std::vector<glm::vec3>& acc = partial[worker];
+        acc.assign(groupCount, glm::vec3(0.0f));
+        for (size_t t = begin; t < end; ++t) {
+            const FaceInfo& face = faces[t];
+            for (int k = 0; k < 3; ++k) {
+                if (face.weight[k] > 0.0f) {
+                    acc[groupOf[indices[t * 3 + k]]] += face.normal * face.weight[k];
+                }
+            }
+        }
+    });
+
+    // 归约：把各 worker 的部分和加到第 0 份
+    std::vector<glm::vec3>& normals = partial[0];
+    Parallel::forRange(groupCount, kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (unsigned int w = 1; w < workers; ++w) {
+            const std::vector<glm::vec3>& acc = partial[w];
+            for (size_t g = begin; g < end; ++g) {
+                normals[g] += acc[g];
+            }
+        }
+    });
+
+    Parallel::forRange(vertices.size(), kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) {
+            if (keepsNormal(keepNormals, i)) continue;
+            const glm::vec3& n = normals[groupOf[i]];
+            float len = glm::length(n);
+            if (len > 0.0f) {
+                vertices[i].normal = n / len;  // 孤立顶点保留原法线
+            }
+        }
+    });
+}
+
+void MeshUtils::calculateNormals(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, float creaseAngle,
+                                 const std::vector<char>* keepNormals) {
+    if (creaseAngle >= 180.0f) {
+        calculateNormals(vertices, static_cast<const std::vector<unsigned int>&>(indices), keepNormals);
+        return;
+    }
+    if (vertices.empty() || indices.size() < 3) return;
+
+    std::vector<unsigned int> groupOf;
+    unsigned int groupCount = weldPositions(vertices, groupOf);
+
+    std::vector<FaceInfo> faces;
+    computeFaceInfo(vertices, indices, faces);
+
+    size_t cornerCount = faces.size() * 3;
+
+    // 位置组 -> 角（三角形 * 3 + k）的 CSR 邻接表
+    std::vector<unsigned int> groupStart(groupCount + 1, 0);
+    for (size_t c = 0; c < cornerCount; ++c) {
+        if (indices[c] < vertices.size()) groupStart[groupOf[indices[c]] + 1]++;
+    }
+    for (unsigned int g = 0; g < groupCount; ++g) {
+        groupStart[g + 1] += groupStart[g];
+    }
+    std::vector<unsigned int> groupCorners(groupStart[groupCount]);
+    {
+        std::vector<unsigned int> cursor(groupStart.begin(), groupStart.end() - 1);
+        for (size_t c = 0; c < cornerCount; ++c) {
+            if (indices[c] < vertices.size()) {
+                groupCorners[cursor[groupOf[indices[c]]]++] = static_cast<unsigned int>(c);
+            }
+        }
+    }
+
+    // 每个角只收集与自身面法线夹角不超过折痕角的相邻面，角之间互不写冲突
+    float cosCrease = std::cos(glm::radians(creaseAngle));
+    std::vector<glm::vec3> cornerNormals(cornerCount, glm::vec3(0.0f));
+
+    Parallel::forRange(cornerCount, kTriangleGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t c = begin; c < end; ++c) {
+            if (indices[c] >= vertices.size()) continue;
+            const glm::vec3& own = faces[c / 3].normal;
+            if (glm::dot(own, own) == 0.0f) continue;
+
+            unsigned int g = groupOf[indices[c]];
+            glm::vec3 sum(0.0f);
+            for (unsigned int i = groupStart[g]; i < groupStart[g + 1]; ++i) {
+                unsigned int other = groupCorners[i];
+                const FaceInfo& face = faces[other / 3];
+                if (glm::dot(own, face.normal) >= cosCrease) {
+                    sum += face.normal * face.weight[other % 3];
+                }
+            }
+            float len = glm::length(sum);
+            cornerNormals[c] = len > 0.0f ? sum / len : own;
+        }
+    });
+
+    // 写回：同一顶点被不同法线引用时拆分出新顶点
+    const float kSameNormal = 0.9999f;
+    std::vector<char> assigned(vertices.size(), 0);
+    std::unordered_map<unsigned int, std::vector<unsigned int>> splits;
+
+    for (size_t c = 0; c < cornerCount; ++c) {
+        unsigned int v = indices[c];
+        if (v >= assigned.size() || keepsNormal(keepNormals, v)) continue;
+        const glm::vec3& n = cornerNormals[c];
+        if (glm::dot(n, n) == 0.0f) continue;
+
+        if (!assigned[v]) {
+            vertices[v].normal = n;
+            assigned[v] = 1;
+            continue;
+        }
+        if (glm::dot(vertices[v].normal, n) >= kSameNormal) continue;
+
+        std::vector<unsigned int>& copies = splits[v];
+        unsigned int target = v;
+        for (unsigned int copy : copies) {
+            if (glm::dot(vertices[copy].normal, n) >= kSameNormal) {
+                target = copy;
+                break;
+            }
+        }
+        if (target == v) {
+            Vertex vertex = vertices[v];
+            vertex.normal = n;
+            target = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(vertex);
+            copies.push_back(target);
+        }
+        indices[c] = target;
+    }
+}
+
+void MeshUtils::calculateTangentsAndBitangents(std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    if (vertices.empty() || indices.size() < 3) return;
+
+    size_t triangleCount = indices.size() / 3;
+    unsigned int workers = Parallel::getWorkerCount(triangleCount, kTriangleGrain);
+
+    // 每个 worker 独立累加切线和副切线方向
+    struct TangentAccum {
+        glm::vec3 tangent;
+        glm::vec3 bitangent;
+    };
+    std::vector<std::vector<TangentAccum>> partial(workers);
+
+    Parallel::forRange(triangleCount, kTriangleGrain, [&](size_t begin, size_t end, unsigned int worker) {
+        std::vector<TangentAccum>& acc = partial[worker];
+        TangentAccum zero = { glm::vec3(0.0f), glm::vec3(0.0f) };
+        acc.assign(vertices.size(), zero);
+
+        for (size_t t = begin; t < end; ++t) {
+            if (!isValidTriangle(indices, t, vertices.size())) continue;
+            unsigned int idx[3] = { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] };
+            const Vertex& v0 = vertices[idx[0]];
+            const Vertex& v1 = vertices[idx[1]];
+            const Vertex& v2 = vertices[idx[2]];
+
+            glm::vec3 e1 = v1.position - v0.position;
+            glm::vec3 e2 = v2.position - v0.position;
+            glm::vec2 d1 = v1.texCoords - v0.texCoords;
+            glm::vec2 d2 = v2.texCoords - v0.texCoords;
+
+            float det = d1.x * d2.y - d2.x * d1.y;
+            if (std::fabs(det) <= 1e-20f) continue;  // UV 退化
+            float r = 1.0f / det;
+            glm::vec3 sdir = (e1 * d2.y - e2 * d1.y) * r;
+            glm::vec3 tdir = (e2 * d1.x - e1 * d2.x) * r;
+
+            float angles[3];
+            cornerAngles(v0.position, v1.position, v2.position, angles);
+
+            for (int k = 0; k < 3; ++k) {
+                // 与 MikkTSpace 一致：先投影到顶点法线的切平面再按顶角加权
+                const glm::vec3& n = vertices[idx[k]].normal;
+                glm::vec3 projected = sdir - n * glm::dot(n, sdir);
+                float len = glm::length(projected);
+                if (len > 0.0f) {
+                    acc[idx[k]].tangent += projected * (angles[k] / len);
+                }
+                acc[idx[k]].bitangent += tdir * angles[k];
+            }
+        }
+    });
+
+    Parallel::forRange(vertices.size(), kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) {
+            glm::vec3 t(0.0f);
+            glm::vec3 b(0.0f);
+            for (unsigned int w = 0; w < workers; ++w) {
+                t += partial[w][i].tangent;
+                b += partial[w][i].bitangent;
+            }
+
+            Vertex& vertex = vertices[i];
+            const glm::vec3& n = vertex.normal;
+
+            // Gram-Schmidt 正交化
+            t -= n * glm::dot(n, t);
+            float len = glm::length(t);
+            if (len <= 1e-12f) {
+                // 没有有效 UV：取任意与法线正交的方向
+                glm::vec3 axis = std::fabs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                t = glm::cross(n, axis);
+                len = glm::length(t);
+                if (len <= 1e-12f) continue;
+            }
+            t /= len;
+
+            float handedness = glm::dot(glm::cross(n, t), b) < 0.0f ? -1.0f : 1.0f;
+            vertex.tangent = t;
+            vertex.bitangent = glm::cross(n, t) * handedness;
+        }
+    });
 }
 
 void MeshUtils::calculateBoundingBox(const std::vector<Vertex>& vertices, CMesh::BoundingBox& bbox) {
@@ -352,14 +840,8 @@ void MeshUtils::calculateBoundingBox(const std::vector<Vertex>& vertices, CMesh:
         return;
     }
     
-    glm::vec3 minPos = vertices[0].position;
-    glm::vec3 maxPos = vertices[0].position;
-    
-    for (const auto& vertex : vertices) {
-        minPos = glm::min(minPos, vertex.position);
-        maxPos = glm::max(maxPos, vertex.position);
-    }
-    
+    glm::vec3 minPos, maxPos;
+    MeshKernels::computeAABB(vertices, minPos, maxPos);
     bbox = CMesh::BoundingBox(minPos, maxPos);
 }
 
@@ -392,45 +874,482 @@ std::shared_ptr<CMesh> MeshUtils::createBoundingBoxVisualization(const CMesh::Bo
         0, 4, 1, 5, 2, 6, 3, 7   // 连接线
     };
     
-    auto mesh = std::make_shared<CMesh>(vertices, indices, PrimitiveType::Lines);
+    auto mesh = std::make_shared<CMesh>(std::move(vertices), std::move(indices), PrimitiveType::Lines);
     return mesh;
 }
 
 // 网格合并
 std::shared_ptr<CMesh> MeshUtils::mergeMeshes(const std::vector<std::shared_ptr<CMesh>>& meshes) {
-    std::vector<Vertex> allVertices;
-    std::vector<unsigned int> allIndices;
-    unsigned int vertexOffset = 0;
-    
+    return mergeMeshes(meshes, std::vector<glm::mat4>());
+}
+
+std::shared_ptr<CMesh> MeshUtils::mergeMeshes(const std::vector<std::shared_ptr<CMesh>>& meshes,
+                                              const std::vector<glm::mat4>& transforms) {
+    std::vector<SubMesh> subMeshes;
+    return mergeMeshes(meshes, transforms, subMeshes);
+}
+
+std::shared_ptr<CMesh> MeshUtils::mergeMeshes(const std::vector<std::shared_ptr<CMesh>>& meshes,
+                                              const std::vector<glm::mat4>& transforms,
+                                              std::vector<SubMesh>& subMeshes) {
+    subMeshes.clear();
+    if (!transforms.empty() && transforms.size() != meshes.size()) {
+        return nullptr;
+    }
+    // 已释放 CPU 数据的网格无法读取顶点
+    bool anyIndexed = false;
     for (const auto& mesh : meshes) {
-        // 添加顶点
-        const auto& vertices = mesh->getVertices();
-        allVertices.insert(allVertices.end(), vertices.begin(), vertices.end());
-        
-        // 添加索引（调整偏移）
-        const auto& indices = mesh->getIndices();
-        for (unsigned int index : indices) {
-            allIndices.push_back(index + vertexOffset);
+        if (mesh->isCpuDataReleased()) {
+            return nullptr;
         }
+        anyIndexed = anyIndexed || mesh->hasIndices();
+    }
+    
+    // 前缀和：每个源网格在合并数组中的起点，末尾为总数
+    const size_t meshCount = meshes.size();
+    std::vector<size_t> vertexOffsets(meshCount + 1, 0);
+    std::vector<size_t> indexOffsets(meshCount + 1, 0);
+    subMeshes.resize(meshCount);
+    for (size_t m = 0; m < meshCount; ++m) {
+        size_t vertexCount = meshes[m]->getVertexCount();
+        // 有索引的合并结果中，无索引的源网格补上顺序索引
+        size_t indexCount = meshes[m]->hasIndices() ? meshes[m]->getIndexCount() : (anyIndexed ? vertexCount : 0);
+        vertexOffsets[m + 1] = vertexOffsets[m] + vertexCount;
+        indexOffsets[m + 1] = indexOffsets[m] + indexCount;
         
-        vertexOffset += vertices.size();
+        SubMesh& sub = subMeshes[m];
+        sub.baseVertex = vertexOffsets[m];
+        sub.vertexCount = vertexCount;
+        sub.firstIndex = anyIndexed ? indexOffsets[m] : vertexOffsets[m];
+        sub.indexCount = anyIndexed ? indexCount : vertexCount;
+        sub.material = meshes[m]->getMaterial();
+    }
+    if (vertexOffsets[meshCount] > std::numeric_limits<unsigned int>::max()) {
+        subMeshes.clear();
+        return nullptr;
     }
     
-    auto mergedMesh = std::make_shared<CMesh>(allVertices, allIndices);
+    std::vector<Vertex> allVertices(vertexOffsets[meshCount]);
+    std::vector<unsigned int> allIndices(indexOffsets[meshCount]);
+    
+    // 按合并后的元素区间并行，单个大网格也能分给多个线程；区间跨越的每个源网格各处理一段
+    Parallel::forRange(allVertices.size(), kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        size_t m = std::upper_bound(vertexOffsets.begin(), vertexOffsets.end(), begin) - vertexOffsets.begin() - 1;
+        for (; begin < end; ++m) {
+            size_t segmentEnd = std::min(end, vertexOffsets[m + 1]);
+            if (segmentEnd == begin) continue;
+            const Vertex* source = meshes[m]->getVertices().data() + (begin - vertexOffsets[m]);
+            std::copy(source, source + (segmentEnd - begin), allVertices.begin() + begin);
+            if (!transforms.empty()) {
+                MeshKernels::transformVertices(&allVertices[begin], segmentEnd - begin, transforms[m]);
+            }
+            begin = segmentEnd;
+        }
+    });
+    
+    Parallel::forRange(allIndices.size(), kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        size_t m = std::upper_bound(indexOffsets.begin(), indexOffsets.end(), begin) - indexOffsets.begin() - 1;
+        for (; begin < end; ++m) {
+            size_t segmentEnd = std::min(end, indexOffsets[m + 1]);
+            if (segmentEnd == begin) continue;
+            unsigned int base = static_cast<unsigned int>(vertexOffsets[m]);
+            size_t local = begin - indexOffsets[m];
+            if (meshes[m]->hasIndices()) {
+                const unsigned int* source = meshes[m]->getIndices().data() + local;
+                for (size_t i = begin; i < segmentEnd; ++i) {
+                    allIndices[i] = *source++ + base;
+                }
+            } else {
+                for (size_t i = begin; i < segmentEnd; ++i) {
+                    allIndices[i] = static_cast<unsigned int>(local++) + base;
+                }
+            }
+            begin = segmentEnd;
+        }
+    });
+    
+    auto mergedMesh = std::make_shared<CMesh>(std::move(allVertices), std::move(allIndices));
     mergedMesh->calculateBoundingBox();
     return mergedMesh;
 }
 
+std::vector<MeshUtils::SubMesh> MeshUtils::coalesceSubMeshes(const std::vector<SubMesh>& subMeshes) {
+    std::vector<SubMesh> result;
+    for (const SubMesh& sub : subMeshes) {
+        if (sub.indexCount == 0) continue;
+        if (!result.empty()) {
+            SubMesh& last = result.back();
+            if (last.material == sub.material && last.firstIndex + last.indexCount == sub.firstIndex) {
+                last.indexCount += sub.indexCount;
+                last.vertexCount = sub.baseVertex + sub.vertexCount - last.baseVertex;
+                continue;
+            }
+        }
+        result.push_back(sub);
+    }
+    return result;
+}
+
+// ============================================================================
+// Loop 细分
+// ============================================================================
+
+namespace {
+
+const uint64_t kEmptyEdge = ~0ull;
+const uint32_t kNoOwner = ~0u;
+
+// 边哈希表的槽：键为 (min, max) 顶点对
+// owner 为引用该边的最小三角形角点编号（t * 3 + k），用来给边分配与线程数无关的确定编号
+struct EdgeSlot {
+    std::atomic<uint64_t> key;
+    std::atomic<uint32_t> owner;
+    std::atomic<uint32_t> faces;        // 引用该边的三角形数，2 为内部边
+    uint32_t opposite[2];               // 前两个三角形中与该边相对的顶点
+    uint32_t id;                        // 按所属角点顺序分配的边编号
+};
+
+// 无锁边哈希表：开放寻址 + 线性探测，多个线程可同时插入
+class EdgeHashTable {
+public:
+    explicit EdgeHashTable(size_t maxEdges) : bits_(4) {
+        // 负载因子不超过 0.5
+        while ((size_t(1) << bits_) < maxEdges * 2) ++bits_;
+        size_t capacity = size_t(1) << bits_;
+        mask_ = capacity - 1;
+        slots_.reset(new EdgeSlot[capacity]);
+        Parallel::forRange(capacity, kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t i = begin; i < end; ++i) {
+                slots_[i].key.store(kEmptyEdge, std::memory_order_relaxed);
+                slots_[i].owner.store(kNoOwner, std::memory_order_relaxed);
+                slots_[i].faces.store(0, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // 三角形角点 corner 引用边 (a, b)，c 为相对顶点；返回边所在的槽
+    uint32_t insert(uint32_t a, uint32_t b, uint32_t c, uint32_t corner) {
+        uint64_t key = a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+        size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - bits_));
+        for (;;) {
+            EdgeSlot& s = slots_[slot];
+            uint64_t current = s.key.load(std::memory_order_acquire);
+            if (current == kEmptyEdge &&
+                s.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                current = key;
+            }
+            if (current == key) {
+                uint32_t n = s.faces.fetch_add(1, std::memory_order_relaxed);
+                if (n < 2) s.opposite[n] = c;
+                uint32_t owner = s.owner.load(std::memory_order_relaxed);
+                while (corner < owner &&
+                       !s.owner.compare_exchange_weak(owner, corner, std::memory_order_relaxed)) {
+                }
+                return static_cast<uint32_t>(slot);
+            }
+            slot = (slot + 1) & mask_;
+        }
+    }
+
+    EdgeSlot& operator[](size_t slot) { return slots_[slot]; }
+
+private:
+    unsigned int bits_;
+    size_t mask_;
+    std::unique_ptr<EdgeSlot[]> slots_;
+};
+
+struct SubdivisionEdge {
+    uint32_t a, b;
+    uint32_t opposite[2];
+    uint32_t faces;
+};
+
+// Loop 顶点规则中邻点的权重 β
+float loopBeta(size_t valence) {
+    double n = static_cast<double>(valence);
+    double c = 3.0 / 8.0 + 0.25 * std::cos(2.0 * M_PI / n);
+    return static_cast<float>((5.0 / 8.0 - c * c) / n);
+}
+
+// 一层 Loop 细分：构造时建立边哈希表并统计边数（只读输入），apply() 写出细分结果
+class LoopLevel {
+public:
+    LoopLevel(const std::vector<unsigned int>& indices, size_t maxEdges)
+        : triangleCount_(indices.size() / 3),
+          table_(maxEdges),
+          cornerSlots_(triangleCount_ * 3),
+          workers_(Parallel::getWorkerCount(triangleCount_, kTriangleGrain)),
+          ownedOffsets_(workers_ + 1, 0) {
+        // 并行插入每个三角形的三条边
+        Parallel::forRange(triangleCount_, kTriangleGrain, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t t = begin; t < end; ++t) {
+                for (uint32_t k = 0; k < 3; ++k) {
+                    uint32_t corner = static_cast<uint32_t>(t * 3 + k);
+                    cornerSlots_[corner] = table_.insert(indices[corner], indices[t * 3 + (k + 1) % 3],
+                                                         indices[t * 3 + (k + 2) % 3], corner);
+                }
+            }
+        });
+        // 每条边恰好属于一个角点：按段统计，前缀和即为各段边编号的起点
+        Parallel::forRange(triangleCount_, kTriangleGrain, [&](size_t begin, size_t end, unsigned int worker) {
+            size_t n = 0;
+            for (size_t c = begin * 3; c < end * 3; ++c) {
+                n += table_[cornerSlots_[c]].owner.load(std::memory_order_relaxed) == c;
+            }
+            ownedOffsets_[worker + 1] = n;
+        });
+        for (unsigned int w = 0; w < workers_; ++w) ownedOffsets_[w + 1] += ownedOffsets_[w];
+    }
+
+    size_t getEdgeCount() const { return ownedOffsets_[workers_]; }
+
+    // 顶点原地追加（容量已预留时不重新分配），索引换成 4 倍大小的新数组
+    void apply(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+private:
+    void collectEdges(const std::vector<unsigned int>& indices);
+    void buildAdjacency(size_t vertexCount);
+
+    size_t triangleCount_;
+    EdgeHashTable table_;
+    std::vector<uint32_t> cornerSlots_;
+    unsigned int workers_;
+    std::vector<size_t> ownedOffsets_;
+    std::vector<SubdivisionEdge> edges_;
+    std::vector<size_t> adjacencyStart_;
+    std::vector<uint32_t> adjacency_;
+};
+
+void LoopLevel::collectEdges(const std::vector<unsigned int>& indices) {
+    // 边按所属角点的顺序编号，结果与线程数无关
+    edges_.resize(getEdgeCount());
+    Parallel::forRange(triangleCount_, kTriangleGrain, [&](size_t begin, size_t end, unsigned int worker) {
+        size_t next = ownedOffsets_[worker];
+        for (size_t c = begin * 3; c < end * 3; ++c) {
+            EdgeSlot& slot = table_[cornerSlots_[c]];
+            if (slot.owner.load(std::memory_order_relaxed) != c) continue;
+            slot.id = static_cast<uint32_t>(next);
+            SubdivisionEdge& e = edges_[next++];
+            size_t t = c / 3;
+            e.a = indices[c];
+            e.b = indices[t * 3 + (c + 1) % 3];
+            e.faces = slot.faces.load(std::memory_order_relaxed);
+            e.opposite[0] = slot.opposite[0];
+            e.opposite[1] = e.faces >= 2 ? slot.opposite[1] : slot.opposite[0];
+        }
+    });
+}
+
+void LoopLevel::buildAdjacency(size_t vertexCount) {
+    // 顶点到边的 CSR 邻接表：计数、前缀和、填充
+    std::unique_ptr<std::atomic<size_t>[]> cursor(new std::atomic<size_t>[vertexCount]);
+    for (size_t v = 0; v < vertexCount; ++v) cursor[v].store(0, std::memory_order_relaxed);
+    Parallel::forRange(edges_.size(), kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t e = begin; e < end; ++e) {
+            cursor[edges_[e].a].fetch_add(1, std::memory_order_relaxed);
+            if (edges_[e].b != edges_[e].a) cursor[edges_[e].b].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    adjacencyStart_.assign(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyStart_[v + 1] = adjacencyStart_[v] + cursor[v].load(std::memory_order_relaxed);
+        cursor[v].store(adjacencyStart_[v], std::memory_order_relaxed);
+    }
+    adjacency_.resize(adjacencyStart_[vertexCount]);
+    Parallel::forRange(edges_.size(), kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t e = begin; e < end; ++e) {
+            uint32_t id = static_cast<uint32_t>(e);
+            adjacency_[cursor[edges_[e].a].fetch_add(1, std::memory_order_relaxed)] = id;
+            if (edges_[e].b != edges_[e].a) {
+                adjacency_[cursor[edges_[e].b].fetch_add(1, std::memory_order_relaxed)] = id;
+            }
+        }
+    });
+}
+
+void LoopLevel::apply(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    const size_t vertexCount = vertices.size();
+    const size_t edgeCount = getEdgeCount();
+    collectEdges(indices);
+    buildAdjacency(vertexCount);
+
+    // 原有顶点的新位置先写入临时数组，边顶点还要读取旧位置
+    std::vector<glm::vec3> smoothed(vertexCount);
+    Parallel::forRange(vertexCount, kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t v = begin; v < end; ++v) {
+            // 邻边排序后求和顺序固定，结果与线程数无关
+            uint32_t* first = adjacency_.data() + adjacencyStart_[v];
+            uint32_t* last = adjacency_.data() + adjacencyStart_[v + 1];
+            std::sort(first, last);
+
+            const glm::vec3& p = vertices[v].position;
+            glm::vec3 ring(0.0f), boundary(0.0f);
+            size_t boundaryEdges = 0;
+            for (uint32_t* it = first; it != last; ++it) {
+                const SubdivisionEdge& e = edges_[*it];
+                const glm::vec3& q = vertices[e.a == v ? e.b : e.a].position;
+                ring += q;
+                if (e.faces != 2) {
+                    boundary += q;
+                    ++boundaryEdges;
+                }
+            }
+
+            size_t valence = static_cast<size_t>(last - first);
+            if (boundaryEdges == 0 && valence >= 3) {
+                float beta = loopBeta(valence);
+                smoothed[v] = p * (1.0f - static_cast<float>(valence) * beta) + ring * beta;
+            } else if (boundaryEdges == 2) {
+                // 边界顶点只沿边界平滑，UV 接缝两侧的顶点结果一致
+                smoothed[v] = p * 0.75f + boundary * 0.125f;
+            } else {
+                // 角点、非流形顶点与孤立顶点保持不动
+                smoothed[v] = p;
+            }
+        }
+    });
+
+    // 边顶点：内部边 3/8 (a + b) + 1/8 (c + d)，边界和非流形边取中点；纹理坐标线性插值
+    vertices.resize(vertexCount + edgeCount);
+    Parallel::forRange(edgeCount, kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t e = begin; e < end; ++e) {
+            const SubdivisionEdge& edge = edges_[e];
+            const Vertex& a = vertices[edge.a];
+            const Vertex& b = vertices[edge.b];
+            Vertex& out = vertices[vertexCount + e];
+            if (edge.faces == 2) {
+                out.position = (a.position + b.position) * 0.375f +
+                               (vertices[edge.opposite[0]].position + vertices[edge.opposite[1]].position) * 0.125f;
+            } else {
+                out.position = (a.position + b.position) * 0.5f;
+            }
+            out.texCoords = (a.texCoords + b.texCoords) * 0.5f;
+        }
+    });
+    Parallel::forRange(vertexCount, kVertexGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t v = begin; v < end; ++v) {
+            vertices[v].position = smoothed[v];
+        }
+    });
+
+    // 每个三角形分成 4 个：三个角各一个，中间一个由三个边顶点组成
+    std::vector<unsigned int> refined(triangleCount_ * 12);
+    Parallel::forRange(triangleCount_, kTriangleGrain, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t t = begin; t < end; ++t) {
+            const unsigned int* tri = &indices[t * 3];
+            // m[k] 位于边 (tri[k], tri[k + 1]) 上
+            unsigned int m[3];
+            for (int k = 0; k < 3; ++k) {
+                m[k] = static_cast<unsigned int>(vertexCount + table_[cornerSlots_[t * 3 + k]].id);
+            }
+            const unsigned int split[12] = {
+                tri[0], m[0], m[2],
+                tri[1], m[1], m[0],
+                tri[2], m[2], m[1],
+                m[0], m[1], m[2]
+            };
+            std::copy(split, split + 12, refined.begin() + t * 12);
+        }
+    });
+    indices.swap(refined);
+}
+
+} // namespace
+
+bool MeshUtils::subdivideLoop(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, unsigned int levels) {
+    const size_t triangleCount = indices.size() / 3;
+    if (levels == 0 || triangleCount == 0) return true;
+    const size_t vertexCount = vertices.size();
+    if (std::any_of(indices.begin(), indices.end(), [&](unsigned int i) { return i >= vertexCount; })) {
+        return false;
+    }
+
+    // 三角形数按 4^levels 增长，最终的索引数和顶点编号都要放得进 32 位
+    const uint64_t limit = std::numeric_limits<uint32_t>::max();
+    uint64_t finalTriangles = triangleCount;
+    for (unsigned int level = 0; level < levels; ++level) {
+        finalTriangles *= 4;
+        if (finalTriangles * 3 >= limit) return false;
+    }
+
+    bool hadTangents = std::any_of(vertices.begin(), vertices.end(), [](const Vertex& v) {
+        return v.tangent != glm::vec3(0.0f);
+    });
+
+    size_t maxEdges = triangleCount * 3;
+    size_t levelTriangles = triangleCount;
+    for (unsigned int level = 0; level < levels; ++level) {
+        LoopLevel step(indices, maxEdges);
+        if (level == 0) {
+            // 此后每层的边数有闭式解 E' = 2E + 3T（每条边一分为二，每个三角形内部新增 3 条），
+            // 顶点数 V' = V + E，据此一次预留最终的顶点数组
+            uint64_t v = vertexCount, e = step.getEdgeCount(), t = triangleCount;
+            for (unsigned int l = 0; l < levels; ++l) {
+                v += e;
+                e = 2 * e + 3 * t;
+                t *= 4;
+            }
+            if (v > limit) return false;
+            vertices.reserve(static_cast<size_t>(v));
+        }
+        maxEdges = 2 * step.getEdgeCount() + 3 * levelTriangles;
+        step.apply(vertices, indices);
+        levelTriangles *= 4;
+    }
+
+    // 原有法线已失效，边顶点没有法线：整体重新计算；原本带切线的网格同时重新计算切线
+    calculateNormals(vertices, indices);
+    if (hadTangents) {
+        calculateTangentsAndBitangents(vertices, indices);
+    }
+    return true;
+}
+
+std::shared_ptr<CMesh> MeshUtils::subdivideMesh(std::shared_ptr<CMesh> mesh, unsigned int subdivisions) {
+    if (!mesh || mesh->isCpuDataReleased() || mesh->getPrimitiveType() != PrimitiveType::Triangles) {
+        return nullptr;
+    }
+
+    std::vector<Vertex> vertices = mesh->getVertices();
+    std::vector<unsigned int> indices = mesh->getIndices();
+    if (indices.empty()) {
+        // 无索引网格的三角形彼此不相连，各自按边界规则细分
+        indices.resize(vertices.size() - vertices.size() % 3);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = static_cast<unsigned int>(i);
+        }
+    }
+    if (!subdivideLoop(vertices, indices, subdivisions)) {
+        return nullptr;
+    }
+
+    auto result = std::make_shared<CMesh>(std::move(vertices), std::move(indices));
+    result->setMaterial(mesh->getMaterial());
+    result->calculateBoundingBox();
+    return result;
+}
+
 // 圆环生成
-std::shared_ptr<CMesh> MeshUtils::createTorus(float outerRadius, float innerRadius, unsigned int sides, unsigned int rings) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+void MeshUtils::generateTorusVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                      float outerRadius, float innerRadius, unsigned int sides, unsigned int rings) {
+    // 静态表的外半径为 1、内半径为 0.5；比例相同的圆环按外半径缩放静态表
+    if (sides == rings && innerRadius * 2.0f == outerRadius) {
+        PrimitiveTables::TableView table = PrimitiveTables::torus(sides);
+        if (!table.empty()) {
+            PrimitiveTables::copyTo(table, outerRadius, vertices, indices);
+            return;
+        }
+    }
     
     float tubeRadius = (outerRadius - innerRadius) * 0.5f;
     float ringRadius = innerRadius + tubeRadius;
+    const unsigned int columns = sides + 1;
+    vertices.resize(static_cast<size_t>(columns) * (rings + 1));
+    indices.resize(static_cast<size_t>(sides) * rings * 6);
     
-    // 生成顶点
-    for (unsigned int ring = 0; ring <= rings; ring++) {
+    // 每个环生成一行顶点，以及该环与下一环之间的索引
+    forEachRow(rings + 1, columns, [&](unsigned int ring) {
         float theta = static_cast<float>(ring) / rings * 2.0f * M_PI;
         
         for (unsigned int side = 0; side <= sides; side++) {
@@ -450,166 +1369,91 @@ std::shared_ptr<CMesh> MeshUtils::createTorus(float outerRadius, float innerRadi
             float u = static_cast<float>(ring) / rings;
             float v = static_cast<float>(side) / sides;
             
-            vertices.push_back(Vertex(
+            vertices[ring * columns + side] = Vertex(
                 glm::vec3(x, y, z),
                 glm::vec3(nx, ny, nz),
                 glm::vec2(u, v)
-            ));
-        }
-    }
-    
-    // 生成索引
-    for (unsigned int ring = 0; ring < rings; ring++) {
-        for (unsigned int side = 0; side < sides; side++) {
-            unsigned int current = ring * (sides + 1) + side;
-            unsigned int next = current + sides + 1;
-            
-            // 两个三角形组成一个四边形
-            indices.push_back(current);
-            indices.push_back(next);
-            indices.push_back(current + 1);
-            
-            indices.push_back(current + 1);
-            indices.push_back(next);
-            indices.push_back(next + 1);
+            );
         }
-    }
-    
-    auto mesh = std::make_shared<CMesh>(vertices, indices);
-    mesh->calculateBoundingBox();
-    return mesh;
+        if (ring == rings) return;
+        
+        // 两个三角形组成一个四边形
+        writeQuadRow(&indices[static_cast<size_t>(ring) * sides * 6], ring * columns, columns, sides);
+    });
 }
 
 // 胶囊体生成
-std::shared_ptr<CMesh> MeshUtils::createCapsule(float radius, float height, unsigned int segments) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    
+void MeshUtils::generateCapsuleVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                        float radius, float height, unsigned int segments) {
     float halfHeight = height * 0.5f;
     unsigned int rings = segments / 2;  // 每个半球的环数
+    const unsigned int columns = segments + 1;
     
-    // 生成上半球
-    for (unsigned int ring = 0; ring <= rings; ring++) {
-        float theta = static_cast<float>(ring) / rings * M_PI * 0.5f;  // 0 到 PI/2
-        
-        for (unsigned int seg = 0; seg <= segments; seg++) {
-            float phi = static_cast<float>(seg) / segments * 2.0f * M_PI;
-            
-            float x = radius * sin(theta) * cos(phi);
-            float y = halfHeight + radius * cos(theta);
-            float z = radius * sin(theta) * sin(phi);
-            
-            float nx = sin(theta) * cos(phi);
-            float ny = cos(theta);
-            float nz = sin(theta) * sin(phi);
-            
-            float u = static_cast<float>(seg) / segments;
-            float v = static_cast<float>(ring) / rings;
-            
-            vertices.push_back(Vertex(
-                glm::vec3(x, y, z),
-                glm::vec3(nx, ny, nz),
-                glm::vec2(u, v)
-            ));
-        }
-    }
-    
-    // 生成圆柱体中间部分
-    unsigned int cylinderTopIndex = vertices.size();
-    for (unsigned int ring = 0; ring <= 1; ring++) {
-        float y = halfHeight - (static_cast<float>(ring) * height);
-        
-        for (unsigned int seg = 0; seg <= segments; seg++) {
-            float phi = static_cast<float>(seg) / segments * 2.0f * M_PI;
-            
-            float x = radius * cos(phi);
-            float z = radius * sin(phi);
-            
-            float u = static_cast<float>(seg) / segments;
-            float v = 0.5f;
-            
-            vertices.push_back(Vertex(
-                glm::vec3(x, y, z),
-                glm::vec3(cos(phi), 0.0f, sin(phi)),
-                glm::vec2(u, v)
-            ));
-        }
-    }
-    
-    // 生成下半球
-    unsigned int bottomHemisphereStart = vertices.size();
-    for (unsigned int ring = 0; ring <= rings; ring++) {
-        float theta = M_PI * 0.5f + static_cast<float>(ring) / rings * M_PI * 0.5f;  // PI/2 到 PI
-        
-        for (unsigned int seg = 0; seg <= segments; seg++) {
-            float phi = static_cast<float>(seg) / segments * 2.0f * M_PI;
-            
-            float x = radius * sin(theta) * cos(phi);
-            float y = -halfHeight + radius * cos(theta);
-            float z = radius * sin(theta) * sin(phi);
-            
-            float nx = sin(theta) * cos(phi);
-            float ny = cos(theta);
-            float nz = sin(theta) * sin(phi);
-            
-            float u = static_cast<float>(seg) / segments;
-            float v = static_cast<float>(ring) / rings;
-            
-            vertices.push_back(Vertex(
-                glm::vec3(x, y, z),
-                glm::vec3(nx, ny, nz),
-                glm::vec2(u, v)
-            ));
-        }
-    }
+    // 顶点行：上半球 rings + 1 行，圆柱体中间部分 2 行，下半球 rings + 1 行；
+    // 每段内相邻两行之间生成四边形，段与段之间不相连
+    const unsigned int cylinderTopRow = rings + 1;
+    const unsigned int bottomHemisphereRow = rings + 3;
+    const unsigned int rowCount = 2 * rings + 4;
+    vertices.resize(static_cast<size_t>(columns) * rowCount);
+    indices.resize(static_cast<size_t>(segments) * (2 * rings + 1) * 6);
     
-    // 生成上半球索引
-    for (unsigned int ring = 0; ring < rings; ring++) {
-        for (unsigned int seg = 0; seg < segments; seg++) {
-            unsigned int current = ring * (segments + 1) + seg;
-            unsigned int next = current + segments + 1;
+    forEachRow(rowCount, columns, [&](unsigned int row) {
+        Vertex* out = &vertices[static_cast<size_t>(row) * columns];
+        if (row < cylinderTopRow || row >= bottomHemisphereRow) {
+            // 半球：上半球 theta 从 0 到 PI/2，下半球从 PI/2 到 PI
+            bool top = row < cylinderTopRow;
+            unsigned int ring = top ? row : row - bottomHemisphereRow;
+            float theta = top ? static_cast<float>(ring) / rings * M_PI * 0.5f
+                              : M_PI * 0.5f + static_cast<float>(ring) / rings * M_PI * 0.5f;
+            float centerY = top ? halfHeight : -halfHeight;
             
-            indices.push_back(current);
-            indices.push_back(next);
-            indices.push_back(current + 1);
+            for (unsigned int seg = 0; seg <= segments; seg++) {
+                float phi = static_cast<float>(seg) / segments * 2.0f * M_PI;
+                
+                float x = radius * sin(theta) * cos(phi);
+                float y = centerY + radius * cos(theta);
+                float z = radius * sin(theta) * sin(phi);
+                
+                float nx = sin(theta) * cos(phi);
+                float ny = cos(theta);
+                float nz = sin(theta) * sin(phi);
+                
+                float u = static_cast<float>(seg) / segments;
+                float v = static_cast<float>(ring) / rings;
+                
+                out[seg] = Vertex(
+                    glm::vec3(x, y, z),
+                    glm::vec3(nx, ny, nz),
+                    glm::vec2(u, v)
+                );
+            }
+        } else {
+            // 圆柱体中间部分
+            float y = halfHeight - (static_cast<float>(row - cylinderTopRow) * height);
             
-            indices.push_back(current + 1);
-            indices.push_back(next);
-            indices.push_back(next + 1);
+            for (unsigned int seg = 0; seg <= segments; seg++) {
+                float phi = static_cast<float>(seg) / segments * 2.0f * M_PI;
+                
+                float x = radius * cos(phi);
+                float z = radius * sin(phi);
+                
+                float u = static_cast<float>(seg) / segments;
+                float v = 0.5f;
+                
+                out[seg] = Vertex(
+                    glm::vec3(x, y, z),
+                    glm::vec3(cos(phi), 0.0f, sin(phi)),
+                    glm::vec2(u, v)
+                );
+            }
         }
-    }
-    
-    // 生成圆柱体中间部分索引
-    for (unsigned int seg = 0; seg < segments; seg++) {
-        unsigned int current = cylinderTopIndex + seg;
-        unsigned int next = current + segments + 1;
         
-        indices.push_back(current);
-        indices.push_back(next);
-        indices.push_back(current + 1);
-        
-        indices.push_back(current + 1);
-        indices.push_back(next);
-        indices.push_back(next + 1);
-    }
-    
-    // 生成下半球索引
-    for (unsigned int ring = 0; ring < rings; ring++) {
-        for (unsigned int seg = 0; seg < segments; seg++) {
-            unsigned int current = bottomHemisphereStart + ring * (segments + 1) + seg;
-            unsigned int next = current + segments + 1;
-            
-            indices.push_back(current);
-            indices.push_back(next);
-            indices.push_back(current + 1);
-            
-            indices.push_back(current + 1);
-            indices.push_back(next);
-            indices.push_back(next + 1);
-        }
-    }
-    
-    auto mesh = std::make_shared<CMesh>(vertices, indices);
-    mesh->calculateBoundingBox();
-    return mesh;
-}
\ No newline at end of file
+        // 索引按上半球、圆柱体、下半球的顺序排列，第 quad 行四边形连接 row 与 row + 1
+        unsigned int quad;
+        if (row < rings) quad = row;
+        else if (row == cylinderTopRow) quad = rings;
+        else if (row >= bottomHemisphereRow && row + 1 < rowCount) quad = row - 2;
+        else return;
+        writeQuadRow(&indices[static_cast<size_t>(quad) * segments * 6], row * columns, columns, segments);
+    });
+}
@@ -1,5 +1,8 @@
 #include "mesh/ModelLoader.h"
+#include "mesh/MeshCodec.h"
+#include "mesh/MeshUtils.h"
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <unordered_map>
 #include <algorithm>
@@ -65,22 +68,23 @@ void OBJLoader::parseOBJ(const std::string& content,
         ss >> texCoord.x >> texCoord.y;
         texCoords.push_back(texCoord);
     } else if (type == "f") {
+        std::vector<OBJIndex> face;
         std::string faceData;
         while (ss >> faceData) {
             OBJIndex index;
             size_t slash1 = faceData.find('/');
-            size_t slash2 = faceData.find('/', slash1 + 1);
+            size_t slash2 = slash1 == std::string::npos ? std::string::npos : faceData.find('/', slash1 + 1);
             
             // 位置索引 (OBJ 使用 1-based 索引)
             int posIdx = std::stoi(faceData.substr(0, slash1));
             index.positionIndex = static_cast<unsigned int>(posIdx > 0 ? posIdx - 1 : positions.size() + posIdx);
             
-            if (slash2 != std::string::npos && slash2 != slash1 + 1) {
-                // 纹理坐标索引
-                int texIdx = std::stoi(faceData.substr(slash1 + 1, slash2 - slash1 - 1));
+            if (slash1 != std::string::npos && slash1 + 1 < faceData.length() && slash2 != slash1 + 1) {
+                // 纹理坐标索引（v/vt 或 v/vt/vn）
+                int texIdx = std::stoi(faceData.substr(slash1 + 1, slash2 == std::string::npos ? std::string::npos : slash2 - slash1 - 1));
                 index.texCoordIndex = static_cast<unsigned int>(texIdx > 0 ? texIdx - 1 : texCoords.size() + texIdx);
             } else {
-                index.texCoordIndex = 0;
+                index.texCoordIndex = OBJIndex::kMissing;
             }
             
             if (slash2 != std::string::npos && slash2 + 1 < faceData.length()) {
@@ -88,10 +92,17 @@ void OBJLoader::parseOBJ(const std::string& content,
                 int normIdx = std::stoi(faceData.substr(slash2 + 1));
                 index.normalIndex = static_cast<unsigned int>(normIdx > 0 ? normIdx - 1 : normals.size() + normIdx);
             } else {
-                index.normalIndex = 0;
+                index.normalIndex = OBJIndex::kMissing;
             }
             
-            indices.push_back(index);
+            face.push_back(index);
+        }
+        
+        // 多边形按扇形三角化
+        for (size_t i = 2; i < face.size(); ++i) {
+            indices.push_back(face[0]);
+            indices.push_back(face[i - 1]);
+            indices.push_back(face[i]);
         }
     }
 }
@@ -109,6 +120,11 @@ void OBJLoader::createMesh(const std::vector<glm::vec3>& positions,
     // 索引化顶点，消除重复
     std::unordered_map<size_t, unsigned int> vertexMap;
     
+    // 文件中缺失的属性才需要生成；hasNormal 标记带 vn 的顶点，生成法线时保留它们
+    bool missingNormals = false;
+    bool missingTexCoords = false;
+    std::vector<char> hasNormal;
+    
     for (const auto& idx : indices) {
         // 边界检查
         if (idx.positionIndex >= positions.size()) {
@@ -132,13 +148,19 @@ void OBJLoader::createMesh(const std::vector<glm::vec3>& positions,
             vertex.position = positions[idx.positionIndex];
             
             // 法线（可选）
-            if (!normals.empty() && idx.normalIndex < normals.size()) {
+            if (idx.normalIndex < normals.size()) {
                 vertex.normal = normals[idx.normalIndex];
+                hasNormal.push_back(1);
+            } else {
+                missingNormals = true;
+                hasNormal.push_back(0);
             }
             
             // 纹理坐标（可选）
-            if (!texCoords.empty() && idx.texCoordIndex < texCoords.size()) {
+            if (idx.texCoordIndex < texCoords.size()) {
                 vertex.texCoords = texCoords[idx.texCoordIndex];
+            } else {
+                missingTexCoords = true;
             }
             
             vertices.push_back(vertex);
@@ -148,14 +170,57 @@ void OBJLoader::createMesh(const std::vector<glm::vec3>& positions,
         }
     }
     
+    // 在上传前生成缺失的法线 / 切线，避免重复上传；只有缺少 vn 的顶点才生成法线
+    if (missingNormals) {
+        MeshUtils::calculateNormals(vertices, meshIndices, CMesh::DefaultCreaseAngle, &hasNormal);
+    }
+    // OBJ 不存储切线，有完整 UV 时才生成
+    if (!missingTexCoords) {
+        MeshUtils::calculateTangentsAndBitangents(vertices, meshIndices);
+    }
+    
     // 创建网格
-    auto mesh = std::shared_ptr<CMesh>(new CMesh(vertices, meshIndices));
-    mesh->calculateNormals(); // 如果没有法线，计算默认法线
+    auto mesh = std::shared_ptr<CMesh>(new CMesh(std::move(vertices), std::move(meshIndices)));
     mesh->calculateBoundingBox();
     
     meshes.push_back(mesh);
 }
 
+// CompressedMeshLoader实现
+std::vector<std::shared_ptr<CMesh>> CompressedMeshLoader::loadModel(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        throw ModelLoadException("Failed to open compressed mesh file: " + filepath);
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::vector<std::shared_ptr<CMesh>> meshes;
+    size_t offset = 0;
+    while (offset < data.size()) {
+        size_t consumed = 0;
+        auto mesh = MeshCodec::decodeMesh(data.data() + offset, data.size() - offset, &consumed);
+        if (!mesh) {
+            throw ModelLoadException("Corrupted compressed mesh file: " + filepath);
+        }
+        meshes.push_back(mesh);
+        offset += consumed;
+    }
+    if (meshes.empty()) {
+        throw ModelLoadException("Compressed mesh file contains no meshes: " + filepath);
+    }
+    return meshes;
+}
+
+bool CompressedMeshLoader::canLoad(const std::string& filepath) const {
+    size_t dotPos = filepath.find_last_of('.');
+    if (dotPos == std::string::npos) return false;
+    
+    std::string ext = filepath.substr(dotPos + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    
+    return ext == "mshc";
+}
+
 std::vector<std::unique_ptr<IModelLoader>> ModelLoaderFactory::loaders;
 
 std::unique_ptr<IModelLoader> ModelLoaderFactory::createLoader(const std::string& filepath) {
@@ -170,6 +235,9 @@ std::unique_ptr<IModelLoader> ModelLoaderFactory::createLoader(const std::string
     if (extension == "obj") {
         return std::unique_ptr<IModelLoader>(new OBJLoader());
     }
+    if (extension == "mshc") {
+        return std::unique_ptr<IModelLoader>(new CompressedMeshLoader());
+    }
     
     return nullptr;
 }
@@ -189,5 +257,5 @@ bool CModelLoader::isSupported(const std::string& filepath) {
 }
 
 std::vector<std::string> CModelLoader::getSupportedFormats() {
-    return {"obj"};
+    return {"obj", "mshc"};
 }
@@ -0,0 +1,53 @@
+#include "mesh/PrimitiveTables.h"
+#include "mesh/VertexFormat.h"
+
+namespace PrimitiveTables {
+
+static_assert(sizeof(StaticVertex) == VertexFormat::PositionNormalTex::stride,
+              "StaticVertex should match the PositionNormalTex layout");
+
+namespace {
+
+// constexpr 常量在编译期求值，放在只读数据段
+constexpr Table<24, 36> kCube = makeCube();
+constexpr auto kSphere16 = makeSphere<16>();
+constexpr auto kSphere32 = makeSphere<32>();
+constexpr auto kSphere64 = makeSphere<64>();
+constexpr auto kTorus16 = makeTorus<16, 16>(1.0f, 0.5f);
+constexpr auto kTorus32 = makeTorus<32, 32>(1.0f, 0.5f);
+
+} // namespace
+
+TableView cube() {
+    return makeView(kCube);
+}
+
+TableView sphere(unsigned int segments) {
+    switch (segments) {
+        case 16: return makeView(kSphere16);
+        case 32: return makeView(kSphere32);
+        case 64: return makeView(kSphere64);
+        default: return TableView();
+    }
+}
+
+TableView torus(unsigned int segments) {
+    switch (segments) {
+        case 16: return makeView(kTorus16);
+        case 32: return makeView(kTorus32);
+        default: return TableView();
+    }
+}
+
+void copyTo(const TableView& table, float scale, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    vertices.resize(table.vertexCount);
+    for (size_t i = 0; i < table.vertexCount; ++i) {
+        const StaticVertex& v = table.vertices[i];
+        vertices[i] = Vertex(glm::vec3(v.position[0], v.position[1], v.position[2]) * scale,
+                             glm::vec3(v.normal[0], v.normal[1], v.normal[2]),
+                             glm::vec2(v.texCoords[0], v.texCoords[1]));
+    }
+    indices.assign(table.indices, table.indices + table.indexCount);
+}
+
+} // namespace PrimitiveTables
@@ -1,13 +1,99 @@
 #include "mesh/Texture.h"
+#include "mesh/TextureContainer.h"
+#include <atomic>
+#include <cstring>
+#include <mutex>
 
 // stb_image implementation
 #define STB_IMAGE_IMPLEMENTATION
 #include "mesh/stb_image.h"
 
+namespace {
+
+std::atomic<size_t> g_textureGpuBytes(0);
+
+std::mutex g_compressionMutex;
+CTexture::CompressionSettings g_compression;
+
+// 完整 mip 链的字节数估算，驱动通常把 RGB8 按 4 字节存放
+size_t estimateMipChainBytes(int width, int height, int channels) {
+    size_t bytesPerPixel = channels == 3 ? 4 : static_cast<size_t>(channels);
+    size_t total = 0;
+    for (;;) {
+        total += static_cast<size_t>(width) * static_cast<size_t>(height) * bytesPerPixel;
+        if (width <= 1 && height <= 1) break;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return total;
+}
+
+bool hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension && std::strcmp(extension, name) == 0) return true;
+    }
+    return false;
+}
+
+struct BlockFormatSupport {
+    bool s3tc = false;
+    bool bptc = false;
+};
+
+// 扩展列表在上下文创建后不变，只查询一次
+const BlockFormatSupport& getBlockFormatSupport() {
+    static const BlockFormatSupport support = [] {
+        BlockFormatSupport result;
+        result.s3tc = hasExtension("GL_EXT_texture_compression_s3tc");
+        result.bptc = GLAD_GL_VERSION_4_2 || hasExtension("GL_ARB_texture_compression_bptc");
+        return result;
+    }();
+    return support;
+}
+
+} // namespace
+
 // CTexture implementation
 CTexture::CTexture(const std::string& filepath, TextureType texType) 
     : type(texType), path(filepath), width(0), height(0), nrChannels(0), ID(0) {
     
+    CompressedImage image;
+    std::string error;
+    const char* source = nullptr;
+    if (TextureContainer::isContainerPath(filepath)) {
+        if (!TextureContainer::load(filepath, image, &error)) {
+            std::cout << "Failed to load texture: " << filepath << " (" << error << ")" << std::endl;
+            return;
+        }
+        source = "container";
+    } else {
+        CompressionSettings compression = getCompressionSettings();
+        bool fromCache = false;
+        if (compression.enabled) {
+            if (TextureEncoder::loadOrEncode(filepath, getEncodeOptions(texType), compression.cacheDirectory,
+                                             image, &fromCache, &error)) {
+                source = fromCache ? "cached" : "encoded";
+            } else {
+                std::cout << "Failed to compress texture: " << filepath << " (" << error
+                          << "), loading uncompressed" << std::endl;
+            }
+        }
+    }
+    if (source) {
+        initializeCompressed(image);
+        if (ID != 0) {
+            std::cout << "Loaded texture: " << filepath << " (" << width << "x" << height << " "
+                      << TextureContainer::getFormatName(image.format) << ", " << image.levels.size()
+                      << " levels, " << source << ")" << std::endl;
+            return;
+        }
+        // 驱动不支持且无法解码：容器文件到此失败，原图改为未压缩加载
+        if (TextureContainer::isContainerPath(filepath)) return;
+    }
+    
     // 加载图片数据
     unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &nrChannels, 0);
     if (data) {
@@ -27,15 +113,23 @@ CTexture::CTexture(unsigned char* data, int w, int h, int channels, TextureType
     }
 }
 
+CTexture::CTexture(const CompressedImage& image, TextureType texType)
+    : type(texType), path(""), width(0), height(0), nrChannels(0), ID(0) {
+    if (!image.empty()) {
+        initializeCompressed(image);
+    }
+}
+
 CTexture::~CTexture() {
     if (ID != 0) {
         glDeleteTextures(1, &ID);
     }
+    setGpuMemoryBytes(0);
 }
 
 void CTexture::bind(unsigned int textureUnit) const {
     glActiveTexture(GL_TEXTURE0 + textureUnit);
-    glBindTexture(GL_TEXTURE_2D, ID);
+    glBindTexture(target_, ID);
 }
 
 void CTexture::unbind(unsigned int textureUnit) {
@@ -56,19 +150,20 @@ const char* CTexture::getTypeString() const {
 
 void CTexture::setWrapMode(GLenum wrapS, GLenum wrapT) {
     bind();
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
+    glTexParameteri(target_, GL_TEXTURE_WRAP_S, wrapS);
+    glTexParameteri(target_, GL_TEXTURE_WRAP_T, wrapT);
 }
 
 void CTexture::setFilterMode(GLenum minFilter, GLenum magFilter) {
     bind();
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+    glTexParameteri(target_, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(target_, GL_TEXTURE_MAG_FILTER, magFilter);
 }
 
 void CTexture::generateMipmaps() {
+    if (isCompressed()) return;
     bind();
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glGenerateMipmap(target_);
 }
 
 GLenum CTexture::getFormat() const {
@@ -76,25 +171,173 @@ GLenum CTexture::getFormat() const {
 }
 
 GLenum CTexture::getInternalFormat() const {
-    return getGLInternalFormat(nrChannels);
+    return isCompressed() ? compressedFormat_ : getGLInternalFormat(nrChannels);
+}
+
+void CTexture::adopt(unsigned int id, int w, int h, int channels) {
+    if (ID != 0 && ID != id) {
+        glDeleteTextures(1, &ID);
+    }
+    ID = id;
+    width = w;
+    height = h;
+    nrChannels = channels;
+    compressedFormat_ = 0;
+    target_ = GL_TEXTURE_2D;
+    layers_ = 1;
+    setGpuMemoryBytes(estimateMipChainBytes(w, h, channels));
+}
+
+void CTexture::adoptArray(unsigned int id, int w, int h, int layers, int channels) {
+    adopt(id, w, h, channels);
+    target_ = GL_TEXTURE_2D_ARRAY;
+    layers_ = layers;
+    setGpuMemoryBytes(estimateMipChainBytes(w, h, channels) * static_cast<size_t>(layers));
+}
+
+void CTexture::adoptCompressed(unsigned int id, const CompressedImage& image) {
+    adopt(id, image.width, image.height, image.getChannels());
+    compressedFormat_ = image.getGLInternalFormat();
+    setGpuMemoryBytes(image.getByteSize());
+}
+
+void CTexture::setCompressionSettings(const CompressionSettings& settings) {
+    std::lock_guard<std::mutex> lock(g_compressionMutex);
+    g_compression = settings;
+}
+
+CTexture::CompressionSettings CTexture::getCompressionSettings() {
+    std::lock_guard<std::mutex> lock(g_compressionMutex);
+    return g_compression;
+}
+
+EncodeOptions CTexture::getEncodeOptions(TextureType texType) {
+    EncodeOptions options;
+    options.quality = getCompressionSettings().quality;
+    options.normalMap = texType == TextureType::Normal;
+    options.gammaCorrectMips = getMipOptions(texType).srgb;
+    return options;
+}
+
+MipOptions CTexture::getMipOptions(TextureType texType) {
+    MipOptions options;
+    options.srgb = texType == TextureType::Diffuse;
+    options.wrap = true;
+    return options;
+}
+
+void CTexture::prepareLevels(const unsigned char* pixels, int w, int h, int channels,
+                             const MipOptions& mips, std::vector<ImageLevel>& levels) {
+    const size_t count = static_cast<size_t>(w) * static_cast<size_t>(h);
+    const int uploadChannels = getUploadChannels(channels);
+    levels.assign(1, ImageLevel());
+    levels[0].width = w;
+    levels[0].height = h;
+    levels[0].pixels.resize(count * static_cast<size_t>(uploadChannels));
+    if (channels == 3) {
+        ImageKernels::expandRGBToRGBA(pixels, levels[0].pixels.data(), count);
+    } else {
+        std::memcpy(levels[0].pixels.data(), pixels, levels[0].pixels.size());
+    }
+    ImageKernels::generateMipChain(levels, uploadChannels, mips);
+}
+
+size_t CTexture::getTotalGpuMemoryBytes() {
+    return g_textureGpuBytes.load();
+}
+
+void CTexture::setGpuMemoryBytes(size_t bytes) {
+    g_textureGpuBytes -= gpuBytes_;
+    g_textureGpuBytes += bytes;
+    gpuBytes_ = bytes;
 }
 
 void CTexture::initialize(unsigned char* data) {
+    std::vector<ImageLevel> levels;
+    prepareLevels(data, width, height, nrChannels, getMipOptions(type), levels);
+    uploadLevels(levels);
+    setGpuMemoryBytes(estimateMipChainBytes(width, height, nrChannels));
+}
+
+void CTexture::uploadLevels(const std::vector<ImageLevel>& levels) {
     glGenTextures(1, &ID);
     glBindTexture(GL_TEXTURE_2D, ID);
     
-    GLenum format = getFormat();
+    GLenum format = getGLFormat(getUploadChannels(nrChannels));
     GLenum internalFormat = getInternalFormat();
     
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    // 单 / 双通道的行长不一定是 4 的倍数
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat, levels[i].width, levels[i].height, 0,
+                     format, GL_UNSIGNED_BYTE, levels[i].pixels.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     
     // 设置默认的纹理参数
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size()) - 1);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    generateMipmaps();
+}
+
+void CTexture::initializeCompressed(const CompressedImage& image) {
+    width = image.width;
+    height = image.height;
+
+    if (!isBlockFormatSupported(image.format)) {
+        // 解码为 RGBA8，按未压缩纹理上传
+        std::vector<ImageLevel> levels;
+        if (!TextureEncoder::decompress(image, levels)) {
+            std::cout << "Texture format " << TextureContainer::getFormatName(image.format)
+                      << " is not supported by the driver" << std::endl;
+            width = height = 0;
+            return;
+        }
+        std::cout << "Texture format " << TextureContainer::getFormatName(image.format)
+                  << " is not supported by the driver, decoded to RGBA8" << std::endl;
+        nrChannels = 4;
+        uploadLevels(levels);
+        size_t bytes = 0;
+        for (const ImageLevel& level : levels) bytes += level.pixels.size();
+        setGpuMemoryBytes(bytes);
+        return;
+    }
+
+    nrChannels = image.getChannels();
+    compressedFormat_ = image.getGLInternalFormat();
+
+    glGenTextures(1, &ID);
+    glBindTexture(GL_TEXTURE_2D, ID);
+
+    // 级别已预先生成，逐级上传，不调用 glGenerateMipmap
+    for (size_t i = 0; i < image.levels.size(); ++i) {
+        const CompressedImage::Level& level = image.levels[i];
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), compressedFormat_,
+                               level.width, level.height, 0,
+                               static_cast<GLsizei>(level.size), image.getLevelData(i));
+    }
+    GLint maxLevel = static_cast<GLint>(image.levels.size()) - 1;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxLevel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, maxLevel > 0 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    setGpuMemoryBytes(image.getByteSize());
+}
+
+bool CTexture::isBlockFormatSupported(BlockFormat format) {
+    switch (format) {
+        case BlockFormat::BC1:
+        case BlockFormat::BC3:
+            return getBlockFormatSupport().s3tc;
+        case BlockFormat::BC7:
+            return getBlockFormatSupport().bptc;
+        default:
+            return true;
+    }
 }
 
 GLenum CTexture::getGLFormat(int channels) {
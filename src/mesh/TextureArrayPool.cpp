@@ -0,0 +1,137 @@
+#include "mesh/TextureArrayPool.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+TextureArrayPool::TextureArrayPool(int layersPerArray)
+    : layersPerArray_(std::max(1, layersPerArray)) {
+}
+
+TextureArrayPool::FormatClass TextureArrayPool::getFormatClass(int width, int height, int channels) {
+    FormatClass format;
+    format.width = width;
+    format.height = height;
+    format.channels = CTexture::getUploadChannels(channels);
+    return format;
+}
+
+TextureArrayPool::Slot TextureArrayPool::add(const unsigned char* pixels, int width, int height, int channels,
+                                             TextureType type) {
+    Slot slot;
+    if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) return slot;
+
+    FormatClass format = getFormatClass(width, height, channels);
+    Array* array = findArray(format);
+    if (!array) array = &createArray(format, type);
+
+    slot.array = array->texture;
+    slot.layer = array->freeLayers.back();
+    array->freeLayers.pop_back();
+
+    // CPU 生成 mip 链，逐级写入该层
+    std::vector<ImageLevel> levels;
+    CTexture::prepareLevels(pixels, width, height, channels, CTexture::getMipOptions(type), levels);
+    GLenum glFormat = CTexture::getGLFormat(format.channels);
+    slot.array->bind();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(i), 0, 0, slot.layer,
+                        levels[i].width, levels[i].height, 1, glFormat, GL_UNSIGNED_BYTE, levels[i].pixels.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return slot;
+}
+
+TextureArrayPool::Slot TextureArrayPool::addFile(const std::string& path, TextureType type) {
+    int width;
+    int height;
+    int channels;
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    if (!pixels) {
+        std::cerr << "Failed to load texture for array: " << path << std::endl;
+        return Slot();
+    }
+    Slot slot = add(pixels, width, height, channels, type);
+    stbi_image_free(pixels);
+    return slot;
+}
+
+void TextureArrayPool::release(const Slot& slot) {
+    if (!slot.isValid()) return;
+    for (Array& array : arrays_) {
+        if (array.texture != slot.array) continue;
+        if (std::find(array.freeLayers.begin(), array.freeLayers.end(), slot.layer) == array.freeLayers.end()) {
+            array.freeLayers.push_back(slot.layer);
+            std::sort(array.freeLayers.begin(), array.freeLayers.end(), std::greater<int>());
+        }
+        return;
+    }
+}
+
+TextureArrayPool::Stats TextureArrayPool::getStats() const {
+    Stats stats;
+    stats.arrays = arrays_.size();
+    for (const Array& array : arrays_) {
+        size_t capacity = static_cast<size_t>(array.texture->getLayerCount());
+        stats.layersCapacity += capacity;
+        stats.layersUsed += capacity - array.freeLayers.size();
+        stats.gpuBytes += array.texture->getGpuMemoryBytes();
+    }
+    return stats;
+}
+
+void TextureArrayPool::setDrawLayer(int layer) {
+    glVertexAttrib1f(LayerAttribute, static_cast<float>(layer));
+}
+
+void TextureArrayPool::setInstanceLayers(GLuint buffer, size_t offset, GLsizei stride) {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(LayerAttribute, 1, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+    glEnableVertexAttribArray(LayerAttribute);
+    glVertexAttribDivisor(LayerAttribute, 1);
+}
+
+void TextureArrayPool::clearInstanceLayers() {
+    glVertexAttribDivisor(LayerAttribute, 0);
+    glDisableVertexAttribArray(LayerAttribute);
+}
+
+TextureArrayPool::Array* TextureArrayPool::findArray(const FormatClass& format) {
+    for (Array& array : arrays_) {
+        if (array.format == format && !array.freeLayers.empty()) return &array;
+    }
+    return nullptr;
+}
+
+TextureArrayPool::Array& TextureArrayPool::createArray(const FormatClass& format, TextureType type) {
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    int layers = maxLayers > 0 ? std::min(layersPerArray_, static_cast<int>(maxLayers)) : layersPerArray_;
+
+    // 预分配所有层的完整 mip 链，之后只用 glTexSubImage3D 写入
+    GLuint id;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+    GLenum internalFormat = CTexture::getGLInternalFormat(format.channels);
+    GLenum glFormat = CTexture::getGLFormat(format.channels);
+    int levels = ImageKernels::getMipLevelCount(format.width, format.height);
+    for (int level = 0; level < levels; ++level) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, std::max(1, format.width >> level),
+                     std::max(1, format.height >> level), layers, 0, glFormat, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    Array array;
+    array.format = format;
+    array.texture = std::make_shared<CTexture>(nullptr, format.width, format.height, format.channels, type);
+    array.texture->adoptArray(id, format.width, format.height, layers, format.channels);
+    array.texture->path = "texture array " + std::to_string(format.width) + "x" + std::to_string(format.height) +
+                          " #" + std::to_string(arrays_.size());
+    for (int layer = layers - 1; layer >= 0; --layer) array.freeLayers.push_back(layer);
+    arrays_.push_back(std::move(array));
+    return arrays_.back();
+}
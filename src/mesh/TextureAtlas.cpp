@@ -0,0 +1,336 @@
+#include "mesh/TextureAtlas.h"
+#include "mesh/Material.h"
+#include "mesh/Mesh.h"
+#include "mesh/stb_image.h"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+MaxRectsPacker::Rect makeRect(int x, int y, int width, int height) {
+    MaxRectsPacker::Rect rect;
+    rect.x = x;
+    rect.y = y;
+    rect.width = width;
+    rect.height = height;
+    return rect;
+}
+
+// 纹理坐标允许的误差（导出工具常把 1.0 写成 1.0000001）
+const float kUVEpsilon = 1e-4f;
+
+} // namespace
+
+// ==================== MaxRectsPacker ====================
+
+MaxRectsPacker::MaxRectsPacker(int width, int height)
+    : width_(width), height_(height), usedArea_(0) {
+    freeRects_.push_back(makeRect(0, 0, width, height));
+}
+
+bool MaxRectsPacker::insert(int width, int height, Rect& out) {
+    if (width <= 0 || height <= 0) return false;
+
+    // Best Short Side Fit：短边剩余最小，同分时长边剩余最小
+    int bestShort = INT_MAX;
+    int bestLong = INT_MAX;
+    const Rect* best = nullptr;
+    for (const Rect& free : freeRects_) {
+        if (free.width < width || free.height < height) continue;
+        int leftoverX = free.width - width;
+        int leftoverY = free.height - height;
+        int shortSide = std::min(leftoverX, leftoverY);
+        int longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+            bestShort = shortSide;
+            bestLong = longSide;
+            best = &free;
+        }
+    }
+    if (!best) return false;
+
+    out = makeRect(best->x, best->y, width, height);
+    splitFreeRects(out);
+    pruneFreeRects();
+    usedArea_ += static_cast<size_t>(width) * static_cast<size_t>(height);
+    return true;
+}
+
+float MaxRectsPacker::getOccupancy() const {
+    double total = static_cast<double>(width_) * static_cast<double>(height_);
+    return total > 0.0 ? static_cast<float>(static_cast<double>(usedArea_) / total) : 0.0f;
+}
+
+void MaxRectsPacker::splitFreeRects(const Rect& used) {
+    // 与 used 相交的空闲矩形切成最多 4 个（互相重叠的）极大矩形
+    std::vector<Rect> result;
+    result.reserve(freeRects_.size() + 4);
+    for (const Rect& free : freeRects_) {
+        if (!free.intersects(used)) {
+            result.push_back(free);
+            continue;
+        }
+        int freeRight = free.x + free.width;
+        int freeBottom = free.y + free.height;
+        int usedRight = used.x + used.width;
+        int usedBottom = used.y + used.height;
+        if (used.x > free.x) result.push_back(makeRect(free.x, free.y, used.x - free.x, free.height));
+        if (usedRight < freeRight) result.push_back(makeRect(usedRight, free.y, freeRight - usedRight, free.height));
+        if (used.y > free.y) result.push_back(makeRect(free.x, free.y, free.width, used.y - free.y));
+        if (usedBottom < freeBottom) result.push_back(makeRect(free.x, usedBottom, free.width, freeBottom - usedBottom));
+    }
+    freeRects_.swap(result);
+}
+
+void MaxRectsPacker::pruneFreeRects() {
+    // 删除被其它空闲矩形包含的项（相同的矩形只保留一个）
+    for (size_t i = 0; i < freeRects_.size(); ++i) {
+        for (size_t j = i + 1; j < freeRects_.size();) {
+            if (freeRects_[j].contains(freeRects_[i])) {
+                freeRects_.erase(freeRects_.begin() + static_cast<std::ptrdiff_t>(i));
+                --i;
+                break;
+            }
+            if (freeRects_[i].contains(freeRects_[j])) {
+                freeRects_.erase(freeRects_.begin() + static_cast<std::ptrdiff_t>(j));
+            } else {
+                ++j;
+            }
+        }
+    }
+}
+
+// ==================== TextureAtlas ====================
+
+TextureAtlas::TextureAtlas(const AtlasOptions& options)
+    : options_(options) {
+}
+
+int TextureAtlas::addImage(const std::string& name, const unsigned char* pixels, int width, int height,
+                           int channels) {
+    if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) return -1;
+
+    Image image;
+    image.name = name;
+    image.width = width;
+    image.height = height;
+    size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    image.pixels.resize(count * 4);
+    if (channels == 4) {
+        std::memcpy(image.pixels.data(), pixels, count * 4);
+    } else if (channels == 3) {
+        ImageKernels::expandRGBToRGBA(pixels, image.pixels.data(), count);
+    } else {
+        // 与 stb_image 一致：单通道为灰度，双通道为灰度 + alpha
+        for (size_t i = 0; i < count; ++i) {
+            unsigned char gray = pixels[i * channels];
+            unsigned char* out = &image.pixels[i * 4];
+            out[0] = out[1] = out[2] = gray;
+            out[3] = channels == 2 ? pixels[i * 2 + 1] : 255;
+        }
+    }
+    images_.push_back(std::move(image));
+    return static_cast<int>(images_.size()) - 1;
+}
+
+int TextureAtlas::addFile(const std::string& path) {
+    int width;
+    int height;
+    int channels;
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!pixels) return -1;
+    int index = addImage(path, pixels, width, height, 4);
+    stbi_image_free(pixels);
+    return index;
+}
+
+int TextureAtlas::addTexture(const CTexture& texture) {
+    if (texture.isCompressed() || texture.ID == 0 || texture.width <= 0 || texture.height <= 0) return -1;
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(texture.width) * static_cast<size_t>(texture.height) * 4);
+    glBindTexture(GL_TEXTURE_2D, texture.ID);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    return addImage(texture.path, pixels.data(), texture.width, texture.height, 4);
+}
+
+int TextureAtlas::findImage(const std::string& name) const {
+    for (size_t i = 0; i < images_.size(); ++i) {
+        if (images_[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int TextureAtlas::getMipLevelCount() const {
+    int levels = 1;
+    while ((2 << (levels - 1)) <= options_.padding) ++levels;
+    return std::min(levels, ImageKernels::getMipLevelCount(options_.pageSize, options_.pageSize));
+}
+
+float TextureAtlas::getOccupancy() const {
+    double total = static_cast<double>(pages_.size()) * options_.pageSize * options_.pageSize;
+    return total > 0.0 ? static_cast<float>(static_cast<double>(usedArea_) / total) : 0.0f;
+}
+
+bool TextureAtlas::build() {
+    pages_.clear();
+    usedArea_ = 0;
+
+    // 在 align 对齐的网格上装箱，各级 mip 上图片边界都落在整纹素上
+    const int levels = getMipLevelCount();
+    const int align = 1 << (levels - 1);
+    const int cells = options_.pageSize / align;
+    const int padding = options_.padding;
+
+    // 边长从大到小放入，大图先占位、小图填缝
+    std::vector<size_t> order(images_.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        const Image& ia = images_[a];
+        const Image& ib = images_[b];
+        int sideA = std::max(ia.width, ia.height);
+        int sideB = std::max(ib.width, ib.height);
+        if (sideA != sideB) return sideA > sideB;
+        return ia.width * ia.height > ib.width * ib.height;
+    });
+
+    bool packedAll = true;
+    std::vector<MaxRectsPacker> packers;
+    for (size_t index : order) {
+        Image& image = images_[index];
+        image.region = AtlasRegion();
+        int cellWidth = (image.width + 2 * padding + align - 1) / align;
+        int cellHeight = (image.height + 2 * padding + align - 1) / align;
+        if (std::max(image.width, image.height) > options_.maxImageSize || cellWidth > cells || cellHeight > cells) {
+            packedAll = false;
+            continue;
+        }
+
+        MaxRectsPacker::Rect cell;
+        size_t page = 0;
+        while (page < packers.size() && !packers[page].insert(cellWidth, cellHeight, cell)) ++page;
+        if (page == packers.size()) {
+            packers.emplace_back(cells, cells);
+            packers.back().insert(cellWidth, cellHeight, cell);
+            ImageLevel level;
+            level.width = level.height = options_.pageSize;
+            level.pixels.assign(static_cast<size_t>(options_.pageSize) * options_.pageSize * 4, 0);
+            pages_.push_back(std::vector<ImageLevel>(1, std::move(level)));
+        }
+
+        MaxRectsPacker::Rect pixels = makeRect(cell.x * align, cell.y * align, cell.width * align, cell.height * align);
+        blit(image, pixels, pages_[page][0]);
+        usedArea_ += static_cast<size_t>(pixels.width) * static_cast<size_t>(pixels.height);
+
+        AtlasRegion& region = image.region;
+        region.page = static_cast<int>(page);
+        region.x = pixels.x + padding;
+        region.y = pixels.y + padding;
+        region.width = image.width;
+        region.height = image.height;
+        float size = static_cast<float>(options_.pageSize);
+        region.uvScale = glm::vec2(image.width / size, image.height / size);
+        region.uvOffset = glm::vec2(region.x / size, region.y / size);
+    }
+
+    // box 滤波的 2x2 平均不跨过对齐边界，边缘延伸在每一级都至少还剩 1 个纹素
+    MipOptions mips;
+    mips.filter = MipFilter::Box;
+    mips.srgb = options_.srgb;
+    for (auto& page : pages_) {
+        for (int level = 1; level < levels; ++level) {
+            const ImageLevel& source = page[static_cast<size_t>(level - 1)];
+            ImageLevel target;
+            target.width = std::max(1, source.width / 2);
+            target.height = std::max(1, source.height / 2);
+            target.pixels.resize(static_cast<size_t>(target.width) * target.height * 4);
+            ImageKernels::downsample(source.pixels.data(), source.width, source.height, 4, target.pixels.data(), mips);
+            page.push_back(std::move(target));
+        }
+    }
+    return packedAll;
+}
+
+void TextureAtlas::blit(const Image& image, const MaxRectsPacker::Rect& cell, ImageLevel& page) const {
+    // 单元格内图片以外的部分按最近的边缘像素填充
+    const int originX = cell.x + options_.padding;
+    const int originY = cell.y + options_.padding;
+    const size_t rowBytes = static_cast<size_t>(image.width) * 4;
+    for (int y = cell.y; y < cell.y + cell.height; ++y) {
+        int sy = std::min(std::max(y - originY, 0), image.height - 1);
+        const unsigned char* src = &image.pixels[static_cast<size_t>(sy) * rowBytes];
+        unsigned char* dst = &page.pixels[(static_cast<size_t>(y) * page.width + cell.x) * 4];
+        for (int x = cell.x; x < cell.x + cell.width; ++x, dst += 4) {
+            int sx = std::min(std::max(x - originX, 0), image.width - 1);
+            std::memcpy(dst, src + static_cast<size_t>(sx) * 4, 4);
+        }
+    }
+}
+
+std::shared_ptr<CTexture> TextureAtlas::createTexture(size_t page, TextureType type) const {
+    const std::vector<ImageLevel>& levels = pages_[page];
+
+    GLuint id;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D, id);
+    size_t bytes = 0;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), CTexture::getGLInternalFormat(4),
+                     levels[i].width, levels[i].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels[i].pixels.data());
+        bytes += levels[i].pixels.size();
+    }
+
+    // 子图之间不能平铺，只生成边缘延伸覆盖得到的级别
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size()) - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    unsigned char placeholder[4] = { 0, 0, 0, 255 };
+    auto texture = std::make_shared<CTexture>(placeholder, 1, 1, 4, type);
+    texture->adopt(id, levels[0].width, levels[0].height, 4);
+    texture->setGpuMemoryBytes(bytes);
+    texture->path = "atlas page " + std::to_string(page);
+    return texture;
+}
+
+bool TextureAtlas::remapUVs(std::vector<Vertex>& vertices, const AtlasRegion& region) {
+    if (!region.isValid()) return false;
+    for (const Vertex& vertex : vertices) {
+        const glm::vec2& uv = vertex.texCoords;
+        if (uv.x < -kUVEpsilon || uv.y < -kUVEpsilon || uv.x > 1.0f + kUVEpsilon || uv.y > 1.0f + kUVEpsilon) {
+            return false;
+        }
+    }
+    for (Vertex& vertex : vertices) {
+        vertex.texCoords = region.transform(glm::clamp(vertex.texCoords, glm::vec2(0.0f), glm::vec2(1.0f)));
+    }
+    return true;
+}
+
+bool TextureAtlas::remapUVs(CMesh& mesh, const AtlasRegion& region) {
+    if (mesh.isCpuDataReleased()) return false;
+    std::vector<Vertex> vertices = mesh.getVertices();
+    if (!remapUVs(vertices, region)) return false;
+    mesh.updateVertexData(std::move(vertices));
+    return true;
+}
+
+void TextureAtlas::applyToMaterial(CMaterial& material, const AtlasRegion& region,
+                                   const std::shared_ptr<CTexture>& page) {
+    bool replaced = false;
+    for (auto& texture : material.textures) {
+        if (texture && texture->type == page->type) {
+            texture = page;
+            replaced = true;
+        }
+    }
+    if (!replaced) {
+        material.addTexture(page);
+    }
+    material.setUVTransform(region.uvScale, region.uvOffset);
+}
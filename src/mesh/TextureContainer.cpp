@@ -0,0 +1,407 @@
+#include "mesh/TextureContainer.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+const uint32_t kDDSMagic = 0x20534444;        // "DDS "
+const size_t kDDSHeaderSize = 124;
+const size_t kDDSHeaderDX10Size = 20;
+const uint32_t kDDPFFourCC = 0x4;
+const uint32_t kDDSCaps2Cubemap = 0x200;
+const uint32_t kDDSCaps2Volume = 0x200000;
+
+const unsigned char kKTXIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+const size_t kKTXHeaderSize = 64;
+const uint32_t kKTXEndianness = 0x04030201;
+
+// DXGI_FORMAT 中的 BC 格式
+enum DXGIFormat : uint32_t {
+    DXGI_BC1_UNORM = 71, DXGI_BC1_UNORM_SRGB = 72,
+    DXGI_BC3_UNORM = 77, DXGI_BC3_UNORM_SRGB = 78,
+    DXGI_BC4_UNORM = 80,
+    DXGI_BC5_UNORM = 83,
+    DXGI_BC7_UNORM = 98, DXGI_BC7_UNORM_SRGB = 99
+};
+const uint32_t kDX10Texture2D = 3;
+
+uint32_t readU32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+void writeU32(std::vector<unsigned char>& out, size_t offset, uint32_t v) {
+    std::memcpy(out.data() + offset, &v, 4);
+}
+
+uint32_t byteSwap(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xFF00u) | ((v << 8) & 0xFF0000u) | (v << 24);
+}
+
+uint32_t fourCC(const char* code) {
+    return static_cast<uint32_t>(code[0]) | (static_cast<uint32_t>(code[1]) << 8) |
+           (static_cast<uint32_t>(code[2]) << 16) | (static_cast<uint32_t>(code[3]) << 24);
+}
+
+bool fail(std::string* error, const char* message) {
+    if (error) *error = message;
+    return false;
+}
+
+int getMaxLevelCount(int width, int height) {
+    int levels = 1;
+    for (int size = std::max(width, height); size > 1; size >>= 1) ++levels;
+    return levels;
+}
+
+// 填写 levels 的尺寸与偏移（数据紧密存放时），返回全部级别的总字节数
+size_t layoutLevels(CompressedImage& image, int levelCount) {
+    image.levels.resize(static_cast<size_t>(levelCount));
+    size_t offset = 0;
+    for (int i = 0; i < levelCount; ++i) {
+        CompressedImage::Level& level = image.levels[static_cast<size_t>(i)];
+        level.width = std::max(1, image.width >> i);
+        level.height = std::max(1, image.height >> i);
+        level.offset = offset;
+        level.size = TextureContainer::getLevelSize(image.format, level.width, level.height);
+        offset += level.size;
+    }
+    return offset;
+}
+
+bool validateSize(int width, int height, uint32_t levelCount, std::string* error) {
+    if (width <= 0 || height <= 0 || width > 65536 || height > 65536) {
+        return fail(error, "unsupported texture size");
+    }
+    if (levelCount > static_cast<uint32_t>(getMaxLevelCount(width, height))) {
+        return fail(error, "too many mip levels for texture size");
+    }
+    return true;
+}
+
+bool formatFromDXGI(uint32_t dxgi, CompressedImage& out) {
+    switch (dxgi) {
+        case DXGI_BC1_UNORM: out.format = BlockFormat::BC1; return true;
+        case DXGI_BC1_UNORM_SRGB: out.format = BlockFormat::BC1; out.srgb = true; return true;
+        case DXGI_BC3_UNORM: out.format = BlockFormat::BC3; return true;
+        case DXGI_BC3_UNORM_SRGB: out.format = BlockFormat::BC3; out.srgb = true; return true;
+        case DXGI_BC4_UNORM: out.format = BlockFormat::BC4; return true;
+        case DXGI_BC5_UNORM: out.format = BlockFormat::BC5; return true;
+        case DXGI_BC7_UNORM: out.format = BlockFormat::BC7; return true;
+        case DXGI_BC7_UNORM_SRGB: out.format = BlockFormat::BC7; out.srgb = true; return true;
+        default: return false;
+    }
+}
+
+bool formatFromGL(uint32_t internalFormat, CompressedImage& out) {
+    switch (internalFormat) {
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT: out.format = BlockFormat::BC1; return true;
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT: out.format = BlockFormat::BC1; out.srgb = true; return true;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: out.format = BlockFormat::BC3; return true;
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT: out.format = BlockFormat::BC3; out.srgb = true; return true;
+        case GL_COMPRESSED_RED_RGTC1: out.format = BlockFormat::BC4; return true;
+        case GL_COMPRESSED_RG_RGTC2: out.format = BlockFormat::BC5; return true;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM: out.format = BlockFormat::BC7; return true;
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM: out.format = BlockFormat::BC7; out.srgb = true; return true;
+        default: return false;
+    }
+}
+
+uint32_t formatToDXGI(const CompressedImage& image) {
+    switch (image.format) {
+        case BlockFormat::BC1: return image.srgb ? DXGI_BC1_UNORM_SRGB : DXGI_BC1_UNORM;
+        case BlockFormat::BC3: return image.srgb ? DXGI_BC3_UNORM_SRGB : DXGI_BC3_UNORM;
+        case BlockFormat::BC4: return DXGI_BC4_UNORM;
+        case BlockFormat::BC5: return DXGI_BC5_UNORM;
+        default: return image.srgb ? DXGI_BC7_UNORM_SRGB : DXGI_BC7_UNORM;
+    }
+}
+
+} // namespace
+
+// ==================== CompressedImage ====================
+
+GLenum CompressedImage::getGLInternalFormat() const {
+    switch (format) {
+        case BlockFormat::BC1: return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case BlockFormat::BC3: return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case BlockFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+        case BlockFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+        case BlockFormat::BC7: return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default: return 0;
+    }
+}
+
+int CompressedImage::getChannels() const {
+    switch (format) {
+        case BlockFormat::BC4: return 1;
+        case BlockFormat::BC5: return 2;
+        default: return 4;
+    }
+}
+
+// ==================== TextureContainer ====================
+
+namespace TextureContainer {
+
+bool isContainerPath(const std::string& path) {
+    size_t dotPos = path.find_last_of('.');
+    if (dotPos == std::string::npos) return false;
+
+    std::string ext = path.substr(dotPos + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == "dds" || ext == "ktx";
+}
+
+size_t getBlockBytes(BlockFormat format) {
+    return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8 : 16;
+}
+
+size_t getLevelSize(BlockFormat format, int width, int height) {
+    size_t blocksX = (static_cast<size_t>(std::max(width, 1)) + 3) / 4;
+    size_t blocksY = (static_cast<size_t>(std::max(height, 1)) + 3) / 4;
+    return blocksX * blocksY * getBlockBytes(format);
+}
+
+const char* getFormatName(BlockFormat format) {
+    switch (format) {
+        case BlockFormat::BC1: return "BC1";
+        case BlockFormat::BC3: return "BC3";
+        case BlockFormat::BC4: return "BC4";
+        case BlockFormat::BC5: return "BC5";
+        case BlockFormat::BC7: return "BC7";
+        default: return "unknown";
+    }
+}
+
+bool parseDDS(const unsigned char* data, size_t size, CompressedImage& out, std::string* error) {
+    out = CompressedImage();
+    CompressedImage image;
+    if (size < 4 + kDDSHeaderSize || readU32(data) != kDDSMagic) {
+        return fail(error, "not a DDS file");
+    }
+    const unsigned char* header = data + 4;
+    if (readU32(header) != kDDSHeaderSize) {
+        return fail(error, "invalid DDS header size");
+    }
+    int height = static_cast<int>(readU32(header + 8));
+    int width = static_cast<int>(readU32(header + 12));
+    uint32_t levelCount = std::max<uint32_t>(readU32(header + 24), 1);
+    uint32_t pixelFlags = readU32(header + 76);
+    uint32_t code = readU32(header + 80);
+    uint32_t caps2 = readU32(header + 108);
+
+    if (caps2 & (kDDSCaps2Cubemap | kDDSCaps2Volume)) {
+        return fail(error, "DDS cubemaps and volume textures are not supported");
+    }
+    if (!(pixelFlags & kDDPFFourCC)) {
+        return fail(error, "uncompressed DDS formats are not supported");
+    }
+
+    size_t dataOffset = 4 + kDDSHeaderSize;
+    if (code == fourCC("DXT1")) {
+        image.format = BlockFormat::BC1;
+    } else if (code == fourCC("DXT5")) {
+        image.format = BlockFormat::BC3;
+    } else if (code == fourCC("ATI1") || code == fourCC("BC4U")) {
+        image.format = BlockFormat::BC4;
+    } else if (code == fourCC("ATI2") || code == fourCC("BC5U")) {
+        image.format = BlockFormat::BC5;
+    } else if (code == fourCC("DX10")) {
+        if (size < dataOffset + kDDSHeaderDX10Size) {
+            return fail(error, "truncated DDS DX10 header");
+        }
+        const unsigned char* dx10 = data + dataOffset;
+        if (!formatFromDXGI(readU32(dx10), image)) {
+            return fail(error, "unsupported DXGI format (expected BC1/BC3/BC4/BC5/BC7)");
+        }
+        if (readU32(dx10 + 4) != kDX10Texture2D || readU32(dx10 + 12) > 1) {
+            return fail(error, "only single 2D DDS textures are supported");
+        }
+        dataOffset += kDDSHeaderDX10Size;
+    } else {
+        return fail(error, "unsupported DDS compression (expected DXT1/DXT5/ATI1/ATI2/DX10)");
+    }
+
+    if (!validateSize(width, height, levelCount, error)) return false;
+    image.width = width;
+    image.height = height;
+    size_t total = layoutLevels(image, static_cast<int>(levelCount));
+    if (size - dataOffset < total) {
+        return fail(error, "truncated DDS level data");
+    }
+    image.data.assign(data + dataOffset, data + dataOffset + total);
+    out = std::move(image);
+    return true;
+}
+
+bool parseKTX(const unsigned char* data, size_t size, CompressedImage& out, std::string* error) {
+    out = CompressedImage();
+    CompressedImage image;
+    if (size < kKTXHeaderSize || std::memcmp(data, kKTXIdentifier, sizeof(kKTXIdentifier)) != 0) {
+        return fail(error, "not a KTX 1.1 file");
+    }
+
+    uint32_t endianness = readU32(data + 12);
+    bool swap = endianness != kKTXEndianness;
+    if (swap && byteSwap(endianness) != kKTXEndianness) {
+        return fail(error, "invalid KTX endianness");
+    }
+    auto field = [&](size_t offset) {
+        uint32_t v = readU32(data + offset);
+        return swap ? byteSwap(v) : v;
+    };
+
+    uint32_t glType = field(16);
+    uint32_t glInternalFormat = field(28);
+    int width = static_cast<int>(field(36));
+    int height = static_cast<int>(field(40));
+    uint32_t depth = field(44);
+    uint32_t arrayElements = field(48);
+    uint32_t faces = field(52);
+    uint32_t levelCount = std::max<uint32_t>(field(56), 1);
+    uint32_t keyValueBytes = field(60);
+
+    if (glType != 0 || !formatFromGL(glInternalFormat, image)) {
+        return fail(error, "unsupported KTX format (expected BC1/BC3/BC4/BC5/BC7)");
+    }
+    if (depth != 0 || arrayElements != 0 || faces != 1 || height == 0) {
+        return fail(error, "only single 2D KTX textures are supported");
+    }
+    if (!validateSize(width, height, levelCount, error)) {
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    size_t total = layoutLevels(image, static_cast<int>(levelCount));
+    image.data.resize(total);
+
+    // 每个级别前有 4 字节的 imageSize，数据按 4 字节对齐
+    size_t cursor = kKTXHeaderSize;
+    if (keyValueBytes > size - cursor) {
+        return fail(error, "truncated KTX key/value data");
+    }
+    cursor += keyValueBytes;
+    for (const auto& level : image.levels) {
+        if (size - cursor < 4) {
+            return fail(error, "truncated KTX level data");
+        }
+        uint32_t imageSize = field(cursor);
+        cursor += 4;
+        if (imageSize != level.size) {
+            return fail(error, "KTX level size does not match its dimensions");
+        }
+        if (size - cursor < imageSize) {
+            return fail(error, "truncated KTX level data");
+        }
+        std::memcpy(image.data.data() + level.offset, data + cursor, imageSize);
+        cursor += (imageSize + 3) & ~size_t(3);
+        cursor = std::min(cursor, size);
+    }
+    out = std::move(image);
+    return true;
+}
+
+bool parse(const unsigned char* data, size_t size, CompressedImage& out, std::string* error) {
+    if (size >= 4 && readU32(data) == kDDSMagic) {
+        return parseDDS(data, size, out, error);
+    }
+    if (size >= sizeof(kKTXIdentifier) && std::memcmp(data, kKTXIdentifier, sizeof(kKTXIdentifier)) == 0) {
+        return parseKTX(data, size, out, error);
+    }
+    out = CompressedImage();
+    return fail(error, "unknown texture container");
+}
+
+void writeDDS(const CompressedImage& image, std::vector<unsigned char>& out) {
+    // sRGB 与 BC7 没有对应的四字符码，使用 DX10 扩展头
+    bool dx10 = image.srgb || image.format == BlockFormat::BC7;
+    out.assign(4 + kDDSHeaderSize + (dx10 ? kDDSHeaderDX10Size : 0), 0);
+    writeU32(out, 0, kDDSMagic);
+
+    const size_t h = 4;
+    writeU32(out, h, static_cast<uint32_t>(kDDSHeaderSize));
+    writeU32(out, h + 4, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000);   // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT | LINEARSIZE
+    writeU32(out, h + 8, static_cast<uint32_t>(image.height));
+    writeU32(out, h + 12, static_cast<uint32_t>(image.width));
+    writeU32(out, h + 16, image.empty() ? 0 : static_cast<uint32_t>(image.levels[0].size));
+    writeU32(out, h + 24, static_cast<uint32_t>(image.levels.size()));
+    writeU32(out, h + 72, 32);
+    writeU32(out, h + 76, kDDPFFourCC);
+    const char* code = "DX10";
+    if (!dx10) {
+        code = image.format == BlockFormat::BC1 ? "DXT1" : image.format == BlockFormat::BC3 ? "DXT5"
+             : image.format == BlockFormat::BC4 ? "BC4U" : "BC5U";
+    }
+    writeU32(out, h + 80, fourCC(code));
+    writeU32(out, h + 104, 0x1000 | (image.levels.size() > 1 ? 0x400008 : 0));   // TEXTURE | MIPMAP | COMPLEX
+    if (dx10) {
+        const size_t d = h + kDDSHeaderSize;
+        writeU32(out, d, formatToDXGI(image));
+        writeU32(out, d + 4, kDX10Texture2D);
+        writeU32(out, d + 12, 1);
+    }
+    out.insert(out.end(), image.data.begin(), image.data.end());
+}
+
+void writeKTX(const CompressedImage& image, std::vector<unsigned char>& out) {
+    out.assign(kKTXHeaderSize, 0);
+    std::memcpy(out.data(), kKTXIdentifier, sizeof(kKTXIdentifier));
+    writeU32(out, 12, kKTXEndianness);
+    writeU32(out, 20, 1);                                // glTypeSize
+    writeU32(out, 28, image.getGLInternalFormat());
+    writeU32(out, 32, image.getChannels() == 1 ? GL_RED : image.getChannels() == 2 ? GL_RG : GL_RGBA);
+    writeU32(out, 36, static_cast<uint32_t>(image.width));
+    writeU32(out, 40, static_cast<uint32_t>(image.height));
+    writeU32(out, 52, 1);
+    writeU32(out, 56, static_cast<uint32_t>(image.levels.size()));
+    for (const auto& level : image.levels) {
+        size_t at = out.size();
+        out.resize(at + 4);
+        writeU32(out, at, static_cast<uint32_t>(level.size));
+        out.insert(out.end(), image.data.begin() + level.offset, image.data.begin() + level.offset + level.size);
+        out.resize((out.size() + 3) & ~size_t(3), 0);
+    }
+}
+
+bool save(const std::string& path, const CompressedImage& image, std::string* error) {
+    if (image.empty()) {
+        return fail(error, "empty image");
+    }
+    std::vector<unsigned char> data;
+    std::string ext = path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == ".ktx") {
+        writeKTX(image, data);
+    } else {
+        writeDDS(image, data);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return fail(error, "failed to open file for writing");
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        return fail(error, "failed to write file");
+    }
+    return true;
+}
+
+bool load(const std::string& path, CompressedImage& out, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        out = CompressedImage();
+        return fail(error, "failed to open file");
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return parse(data.data(), data.size(), out, error);
+}
+
+} // namespace TextureContainer
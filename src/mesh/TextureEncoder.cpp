@@ -0,0 +1,897 @@
+#include "mesh/TextureEncoder.h"
+#include "core/Parallel.h"
+#include "core/Simd.h"
+#include "mesh/stb_image.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+// 编码结果变化时递增，使旧缓存失效
+const uint64_t kEncoderVersion = 2;
+
+// 每个 worker 至少分到的块数
+const size_t kBlocksPerTask = 64;
+
+bool fail(std::string* error, const char* message) {
+    if (error) *error = message;
+    return false;
+}
+
+// ==================== 颜色块（BC1 / BC3 的 RGB 部分） ====================
+
+int expand5(int v) { return (v << 3) | (v >> 2); }
+int expand6(int v) { return (v << 2) | (v >> 4); }
+
+uint16_t pack565(int r, int g, int b) {
+    int r5 = (std::min(std::max(r, 0), 255) * 31 + 127) / 255;
+    int g6 = (std::min(std::max(g, 0), 255) * 63 + 127) / 255;
+    int b5 = (std::min(std::max(b, 0), 255) * 31 + 127) / 255;
+    return static_cast<uint16_t>((r5 << 11) | (g6 << 5) | b5);
+}
+
+void unpack565(uint16_t c, int* rgb) {
+    rgb[0] = expand5(c >> 11);
+    rgb[1] = expand6((c >> 5) & 63);
+    rgb[2] = expand5(c & 31);
+}
+
+// 像素值都是 0~255 的整数，误差平方和不超过 2^24，float 运算是精确的
+struct ColorBlock {
+    alignas(16) float r[16];
+    alignas(16) float g[16];
+    alignas(16) float b[16];
+    alignas(16) float weight[16];   // BC1 中 alpha < 128 的像素为 0，不计入误差
+    int opaqueCount;
+};
+
+struct Palette {
+    float r[4];
+    float g[4];
+    float b[4];
+    int count;   // 3 色模式下第 4 个索引表示透明，不参与选取
+};
+
+enum class ColorMode {
+    FourColor,    // BC1：c0 > c1
+    ThreeColor,   // BC1：c0 <= c1，索引 3 为透明黑
+    AlwaysFour    // BC3：颜色部分总是 4 色
+};
+
+struct EncodedColor {
+    uint16_t c0 = 0;
+    uint16_t c1 = 0;
+    bool fourColor = true;
+    float error = std::numeric_limits<float>::max();
+    unsigned char indices[16] = {};
+};
+
+// 与解码器相同的调色板
+Palette makePalette(uint16_t c0, uint16_t c1, bool fourColor) {
+    int a[3];
+    int b[3];
+    unpack565(c0, a);
+    unpack565(c1, b);
+    Palette p;
+    float* channels[3] = { p.r, p.g, p.b };
+    for (int c = 0; c < 3; ++c) {
+        channels[c][0] = static_cast<float>(a[c]);
+        channels[c][1] = static_cast<float>(b[c]);
+        if (fourColor) {
+            channels[c][2] = static_cast<float>((2 * a[c] + b[c]) / 3);
+            channels[c][3] = static_cast<float>((a[c] + 2 * b[c]) / 3);
+        } else {
+            channels[c][2] = static_cast<float>((a[c] + b[c]) / 2);
+            channels[c][3] = 0.0f;
+        }
+    }
+    p.count = fourColor ? 4 : 3;
+    return p;
+}
+
+#if SIMD_SSE2
+
+inline __m128 distanceSq(__m128 r, __m128 g, __m128 b, const Palette& p, int k) {
+    __m128 dr = _mm_sub_ps(r, _mm_set1_ps(p.r[k]));
+    __m128 dg = _mm_sub_ps(g, _mm_set1_ps(p.g[k]));
+    __m128 db = _mm_sub_ps(b, _mm_set1_ps(p.b[k]));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+}
+
+// 每次处理 4 个像素：逐个调色板颜色求距离，保留最近的索引
+float selectIndices(const ColorBlock& block, const Palette& p, unsigned char* indices) {
+    __m128 total = _mm_setzero_ps();
+    for (int i = 0; i < 16; i += 4) {
+        __m128 r = _mm_load_ps(block.r + i);
+        __m128 g = _mm_load_ps(block.g + i);
+        __m128 b = _mm_load_ps(block.b + i);
+        __m128 best = distanceSq(r, g, b, p, 0);
+        __m128 bestIndex = _mm_setzero_ps();
+        for (int k = 1; k < p.count; ++k) {
+            __m128 d = distanceSq(r, g, b, p, k);
+            __m128 closer = _mm_cmplt_ps(d, best);
+            best = _mm_min_ps(best, d);
+            bestIndex = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(static_cast<float>(k))),
+                                  _mm_andnot_ps(closer, bestIndex));
+        }
+        total = _mm_add_ps(total, _mm_mul_ps(best, _mm_load_ps(block.weight + i)));
+
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_cvttps_epi32(bestIndex));
+        for (int j = 0; j < 4; ++j) indices[i + j] = static_cast<unsigned char>(lanes[j]);
+    }
+    alignas(16) float sums[4];
+    _mm_store_ps(sums, total);
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+#else
+
+float selectIndices(const ColorBlock& block, const Palette& p, unsigned char* indices) {
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = 0.0f;
+        int bestIndex = 0;
+        for (int k = 0; k < p.count; ++k) {
+            float dr = block.r[i] - p.r[k];
+            float dg = block.g[i] - p.g[k];
+            float db = block.b[i] - p.b[k];
+            float d = (dr * dr + dg * dg) + db * db;
+            if (k == 0 || d < best) {
+                best = d;
+                bestIndex = k;
+            }
+        }
+        total += best * block.weight[i];
+        indices[i] = static_cast<unsigned char>(bestIndex);
+    }
+    return total;
+}
+
+#endif
+
+// 按解码器的规则排列端点并选取索引，返回误差
+float evaluateColor(const ColorBlock& block, ColorMode mode, uint16_t c0, uint16_t c1, EncodedColor& out) {
+    bool fourColor;
+    if (mode == ColorMode::ThreeColor) {
+        if (c0 > c1) std::swap(c0, c1);
+        fourColor = false;
+    } else {
+        if (c0 < c1) std::swap(c0, c1);
+        // BC1 两端点相同时解码器按 3 色模式处理，前 3 个颜色都等于端点，结果不变
+        fourColor = mode == ColorMode::AlwaysFour || c0 > c1;
+    }
+    out.c0 = c0;
+    out.c1 = c1;
+    out.fourColor = fourColor;
+    out.error = selectIndices(block, makePalette(c0, c1, fourColor), out.indices);
+    if (mode == ColorMode::ThreeColor) {
+        for (int i = 0; i < 16; ++i) {
+            if (block.weight[i] == 0.0f) out.indices[i] = 3;
+        }
+    }
+    return out.error;
+}
+
+// 单色块：每个 8 位值对应一对端点，使 (2 * hi + lo) / 3 最接近该值（索引 2）
+struct SingleColorTable {
+    unsigned char hi5[256], lo5[256], hi6[256], lo6[256];
+
+    SingleColorTable() {
+        build(31, expand5, hi5, lo5);
+        build(63, expand6, hi6, lo6);
+    }
+
+    static void build(int maxValue, int (*expand)(int), unsigned char* hi, unsigned char* lo) {
+        for (int v = 0; v < 256; ++v) {
+            int bestError = 256;
+            for (int a = 0; a <= maxValue && bestError > 0; ++a) {
+                for (int b = 0; b <= maxValue; ++b) {
+                    int error = std::abs((2 * expand(a) + expand(b)) / 3 - v);
+                    if (error < bestError) {
+                        bestError = error;
+                        hi[v] = static_cast<unsigned char>(a);
+                        lo[v] = static_cast<unsigned char>(b);
+                    }
+                }
+            }
+        }
+    }
+};
+
+const SingleColorTable& getSingleColorTable() {
+    static const SingleColorTable table;
+    return table;
+}
+
+// 主轴两端的像素作为初始端点
+void principalAxisEndpoints(const ColorBlock& block, uint16_t& c0, uint16_t& c1) {
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    float minC[3] = { 255.0f, 255.0f, 255.0f };
+    float maxC[3] = { 0.0f, 0.0f, 0.0f };
+    const float* channels[3] = { block.r, block.g, block.b };
+    for (int i = 0; i < 16; ++i) {
+        if (block.weight[i] == 0.0f) continue;
+        for (int c = 0; c < 3; ++c) {
+            mean[c] += channels[c][i];
+            minC[c] = std::min(minC[c], channels[c][i]);
+            maxC[c] = std::max(maxC[c], channels[c][i]);
+        }
+    }
+    for (int c = 0; c < 3; ++c) mean[c] /= static_cast<float>(block.opaqueCount);
+
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };   // rr rg rb gg gb bb
+    for (int i = 0; i < 16; ++i) {
+        if (block.weight[i] == 0.0f) continue;
+        float d[3] = { block.r[i] - mean[0], block.g[i] - mean[1], block.b[i] - mean[2] };
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+
+    // 幂迭代求主特征向量，从包围盒对角线出发
+    float axis[3] = { maxC[0] - minC[0], maxC[1] - minC[1], maxC[2] - minC[2] };
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[3] = { cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                          cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                          cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2] };
+        float scale = std::max(std::fabs(next[0]), std::max(std::fabs(next[1]), std::fabs(next[2])));
+        if (scale < 1e-6f) break;
+        for (int c = 0; c < 3; ++c) axis[c] = next[c] / scale;
+    }
+
+    float minT = std::numeric_limits<float>::max();
+    float maxT = -std::numeric_limits<float>::max();
+    int minIndex = 0;
+    int maxIndex = 0;
+    for (int i = 0; i < 16; ++i) {
+        if (block.weight[i] == 0.0f) continue;
+        float t = block.r[i] * axis[0] + block.g[i] * axis[1] + block.b[i] * axis[2];
+        if (t < minT) { minT = t; minIndex = i; }
+        if (t > maxT) { maxT = t; maxIndex = i; }
+    }
+    c0 = pack565(static_cast<int>(block.r[maxIndex]), static_cast<int>(block.g[maxIndex]), static_cast<int>(block.b[maxIndex]));
+    c1 = pack565(static_cast<int>(block.r[minIndex]), static_cast<int>(block.g[minIndex]), static_cast<int>(block.b[minIndex]));
+}
+
+// 固定索引，用最小二乘求两个端点；矩阵奇异（所有像素用同一权重）时返回 false
+bool refineEndpoints(const ColorBlock& block, const EncodedColor& current, uint16_t& c0, uint16_t& c1) {
+    static const float kFourWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    static const float kThreeWeights[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+    const float* weights = current.fourColor ? kFourWeights : kThreeWeights;
+
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[3] = { 0.0f, 0.0f, 0.0f };
+    float bx[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i) {
+        if (block.weight[i] == 0.0f) continue;
+        float a = weights[current.indices[i]];
+        float b = 1.0f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        float x[3] = { block.r[i], block.g[i], block.b[i] };
+        for (int c = 0; c < 3; ++c) {
+            ax[c] += a * x[c];
+            bx[c] += b * x[c];
+        }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-4f) return false;
+
+    int e0[3];
+    int e1[3];
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = static_cast<int>(std::lround((ax[c] * bb - bx[c] * ab) / det));
+        e1[c] = static_cast<int>(std::lround((bx[c] * aa - ax[c] * ab) / det));
+    }
+    c0 = pack565(e0[0], e0[1], e0[2]);
+    c1 = pack565(e1[0], e1[1], e1[2]);
+    return true;
+}
+
+// 在量化后的端点附近逐分量 ±1 搜索，直到不再改进
+void searchEndpoints(const ColorBlock& block, ColorMode mode, EncodedColor& best) {
+    static const int kShifts[3] = { 11, 5, 0 };
+    static const int kMax[3] = { 31, 63, 31 };
+    for (int pass = 0; pass < 8 && best.error > 0.0f; ++pass) {
+        bool improved = false;
+        for (int endpoint = 0; endpoint < 2; ++endpoint) {
+            for (int c = 0; c < 3; ++c) {
+                for (int delta = -1; delta <= 1; delta += 2) {
+                    uint16_t e[2] = { best.c0, best.c1 };
+                    int value = ((e[endpoint] >> kShifts[c]) & kMax[c]) + delta;
+                    if (value < 0 || value > kMax[c]) continue;
+                    e[endpoint] = static_cast<uint16_t>((e[endpoint] & ~(kMax[c] << kShifts[c])) | (value << kShifts[c]));
+
+                    EncodedColor candidate;
+                    if (evaluateColor(block, mode, e[0], e[1], candidate) < best.error) {
+                        best = candidate;
+                        improved = true;
+                    }
+                }
+            }
+        }
+        if (!improved) break;
+    }
+}
+
+void fitColor(const ColorBlock& block, ColorMode mode, EncodeQuality quality, EncodedColor& best) {
+    uint16_t c0;
+    uint16_t c1;
+    principalAxisEndpoints(block, c0, c1);
+    evaluateColor(block, mode, c0, c1, best);
+
+    if (quality >= EncodeQuality::Normal) {
+        for (int iteration = 0; iteration < 2 && best.error > 0.0f; ++iteration) {
+            EncodedColor candidate;
+            if (!refineEndpoints(block, best, c0, c1) ||
+                evaluateColor(block, mode, c0, c1, candidate) >= best.error) {
+                break;
+            }
+            best = candidate;
+        }
+    }
+    if (quality == EncodeQuality::High) {
+        searchEndpoints(block, mode, best);
+    }
+}
+
+void writeColorBlock(const EncodedColor& color, unsigned char* out) {
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= static_cast<uint32_t>(color.indices[i]) << (2 * i);
+    out[0] = static_cast<unsigned char>(color.c0);
+    out[1] = static_cast<unsigned char>(color.c0 >> 8);
+    out[2] = static_cast<unsigned char>(color.c1);
+    out[3] = static_cast<unsigned char>(color.c1 >> 8);
+    std::memcpy(out + 4, &bits, 4);   // 小端
+}
+
+void encodeColorBlock(const unsigned char* rgba, EncodeQuality quality, bool allowTransparency, unsigned char* out) {
+    ColorBlock block;
+    block.opaqueCount = 0;
+    for (int i = 0; i < 16; ++i) {
+        block.r[i] = rgba[i * 4 + 0];
+        block.g[i] = rgba[i * 4 + 1];
+        block.b[i] = rgba[i * 4 + 2];
+        block.weight[i] = (allowTransparency && rgba[i * 4 + 3] < 128) ? 0.0f : 1.0f;
+        if (block.weight[i] != 0.0f) ++block.opaqueCount;
+    }
+
+    ColorMode mode = ColorMode::AlwaysFour;
+    if (allowTransparency) {
+        mode = block.opaqueCount < 16 ? ColorMode::ThreeColor : ColorMode::FourColor;
+    }
+
+    EncodedColor best;
+    if (block.opaqueCount == 0) {
+        evaluateColor(block, ColorMode::ThreeColor, 0, 0, best);
+        writeColorBlock(best, out);
+        return;
+    }
+
+    int first = 0;
+    while (block.weight[first] == 0.0f) ++first;
+    bool solid = true;
+    for (int i = first + 1; i < 16 && solid; ++i) {
+        solid = block.weight[i] == 0.0f ||
+                (block.r[i] == block.r[first] && block.g[i] == block.g[first] && block.b[i] == block.b[first]);
+    }
+
+    if (solid) {
+        int r = static_cast<int>(block.r[first]);
+        int g = static_cast<int>(block.g[first]);
+        int b = static_cast<int>(block.b[first]);
+        uint16_t rounded = pack565(r, g, b);
+        evaluateColor(block, mode, rounded, rounded, best);
+        if (mode != ColorMode::ThreeColor && best.error > 0.0f) {
+            const SingleColorTable& table = getSingleColorTable();
+            uint16_t hi = static_cast<uint16_t>((table.hi5[r] << 11) | (table.hi6[g] << 5) | table.hi5[b]);
+            uint16_t lo = static_cast<uint16_t>((table.lo5[r] << 11) | (table.lo6[g] << 5) | table.lo5[b]);
+            EncodedColor candidate;
+            if (evaluateColor(block, mode, hi, lo, candidate) < best.error) best = candidate;
+        }
+    } else {
+        fitColor(block, mode, quality, best);
+        // 高质量时不透明的 BC1 块也尝试 3 色模式（中点有时比 1/3 点更合适）
+        if (mode == ColorMode::FourColor && quality == EncodeQuality::High && best.error > 0.0f) {
+            EncodedColor candidate;
+            fitColor(block, ColorMode::ThreeColor, quality, candidate);
+            if (candidate.error < best.error) best = candidate;
+        }
+    }
+    writeColorBlock(best, out);
+}
+
+void decodeColorBlock(const unsigned char* block, bool alwaysFourColor, unsigned char* rgba) {
+    uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    uint32_t bits;
+    std::memcpy(&bits, block + 4, 4);
+
+    bool fourColor = alwaysFourColor || c0 > c1;
+    Palette p = makePalette(c0, c1, fourColor);
+    for (int i = 0; i < 16; ++i) {
+        int index = (bits >> (2 * i)) & 3;
+        unsigned char* pixel = rgba + i * 4;
+        pixel[0] = static_cast<unsigned char>(p.r[index]);
+        pixel[1] = static_cast<unsigned char>(p.g[index]);
+        pixel[2] = static_cast<unsigned char>(p.b[index]);
+        pixel[3] = (!fourColor && index == 3) ? 0 : 255;
+    }
+}
+
+// ==================== 单通道块（BC4，BC3 的 alpha，BC5 的两个通道） ====================
+
+// a0 > a1 为 8 值模式，否则为 6 值模式加 0 和 255
+void makeChannelPalette(int a0, int a1, int* p) {
+    p[0] = a0;
+    p[1] = a1;
+    if (a0 > a1) {
+        for (int i = 2; i < 8; ++i) p[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+    } else {
+        for (int i = 2; i < 6; ++i) p[i] = ((6 - i) * a0 + (i - 1) * a1 + 2) / 5;
+        p[6] = 0;
+        p[7] = 255;
+    }
+}
+
+struct EncodedChannel {
+    int a0 = 0;
+    int a1 = 0;
+    int error = std::numeric_limits<int>::max();
+    unsigned char indices[16] = {};
+};
+
+#if SIMD_SSE2
+
+// 16 个 int16 值分两组，绝对差最小即平方差最小；平方和用 madd 在 32 位中累加
+int selectChannelIndices(const int16_t* values, const int* p, unsigned char* indices) {
+    __m128i v[2] = { _mm_load_si128(reinterpret_cast<const __m128i*>(values)),
+                     _mm_load_si128(reinterpret_cast<const __m128i*>(values + 8)) };
+    __m128i total = _mm_setzero_si128();
+    for (int half = 0; half < 2; ++half) {
+        __m128i p0 = _mm_set1_epi16(static_cast<int16_t>(p[0]));
+        __m128i best = _mm_max_epi16(_mm_sub_epi16(v[half], p0), _mm_sub_epi16(p0, v[half]));
+        __m128i bestIndex = _mm_setzero_si128();
+        for (int k = 1; k < 8; ++k) {
+            __m128i pk = _mm_set1_epi16(static_cast<int16_t>(p[k]));
+            __m128i d = _mm_max_epi16(_mm_sub_epi16(v[half], pk), _mm_sub_epi16(pk, v[half]));
+            __m128i closer = _mm_cmplt_epi16(d, best);
+            best = _mm_min_epi16(best, d);
+            bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi16(static_cast<int16_t>(k))),
+                                     _mm_andnot_si128(closer, bestIndex));
+        }
+        total = _mm_add_epi32(total, _mm_madd_epi16(best, best));
+
+        alignas(16) int16_t lanes[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), bestIndex);
+        for (int j = 0; j < 8; ++j) indices[half * 8 + j] = static_cast<unsigned char>(lanes[j]);
+    }
+    alignas(16) int32_t sums[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(sums), total);
+    return sums[0] + sums[1] + sums[2] + sums[3];
+}
+
+#else
+
+int selectChannelIndices(const int16_t* values, const int* p, unsigned char* indices) {
+    int total = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = std::abs(values[i] - p[0]);
+        int bestIndex = 0;
+        for (int k = 1; k < 8; ++k) {
+            int d = std::abs(values[i] - p[k]);
+            if (d < best) {
+                best = d;
+                bestIndex = k;
+            }
+        }
+        total += best * best;
+        indices[i] = static_cast<unsigned char>(bestIndex);
+    }
+    return total;
+}
+
+#endif
+
+int evaluateChannel(const int16_t* values, int a0, int a1, EncodedChannel& out) {
+    int p[8];
+    makeChannelPalette(a0, a1, p);
+    out.a0 = a0;
+    out.a1 = a1;
+    out.error = selectChannelIndices(values, p, out.indices);
+    return out.error;
+}
+
+void encodeChannelBlock(const unsigned char* rgba, int channel, EncodeQuality quality, unsigned char* out) {
+    alignas(16) int16_t values[16];
+    int minV = 255, maxV = 0;
+    int minInner = 255, maxInner = 0;   // 不含 0 和 255，用于 6 值模式
+    for (int i = 0; i < 16; ++i) {
+        int v = rgba[i * 4 + channel];
+        values[i] = static_cast<int16_t>(v);
+        minV = std::min(minV, v);
+        maxV = std::max(maxV, v);
+        if (v != 0 && v != 255) {
+            minInner = std::min(minInner, v);
+            maxInner = std::max(maxInner, v);
+        }
+    }
+    if (minInner > maxInner) minInner = maxInner = 0;
+
+    EncodedChannel best;
+    evaluateChannel(values, maxV, minV, best);
+    if (quality >= EncodeQuality::Normal && best.error > 0) {
+        EncodedChannel candidate;
+        if (evaluateChannel(values, minInner, maxInner, candidate) < best.error) best = candidate;
+    }
+    if (quality == EncodeQuality::High && best.error > 0) {
+        // 两种模式下各自在端点附近 ±1 范围内穷举
+        const int starts[2][2] = { { maxV, minV }, { minInner, maxInner } };
+        for (int mode = 0; mode < 2; ++mode) {
+            for (int d0 = -1; d0 <= 1; ++d0) {
+                for (int d1 = -1; d1 <= 1; ++d1) {
+                    int a0 = std::min(std::max(starts[mode][0] + d0, 0), 255);
+                    int a1 = std::min(std::max(starts[mode][1] + d1, 0), 255);
+                    if ((mode == 0) != (a0 > a1)) continue;
+                    EncodedChannel candidate;
+                    if (evaluateChannel(values, a0, a1, candidate) < best.error) best = candidate;
+                }
+            }
+        }
+    }
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= static_cast<uint64_t>(best.indices[i]) << (3 * i);
+    out[0] = static_cast<unsigned char>(best.a0);
+    out[1] = static_cast<unsigned char>(best.a1);
+    for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<unsigned char>(bits >> (8 * i));
+}
+
+void decodeChannelBlock(const unsigned char* block, unsigned char* rgba, int channel) {
+    int p[8];
+    makeChannelPalette(block[0], block[1], p);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    for (int i = 0; i < 16; ++i) {
+        rgba[i * 4 + channel] = static_cast<unsigned char>(p[(bits >> (3 * i)) & 7]);
+    }
+}
+
+// ==================== 整幅图片 ====================
+
+// 按 GL 上传时的通道含义扩展为 RGBA：单通道为 (r, 0, 0, 255)，双通道为 (r, g, 0, 255)
+std::vector<unsigned char> expandToRGBA(const unsigned char* pixels, int width, int height, int channels) {
+    size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    std::vector<unsigned char> rgba(count * 4);
+    if (channels == 4) {
+        std::memcpy(rgba.data(), pixels, count * 4);
+        return rgba;
+    }
+    if (channels == 3) {
+        ImageKernels::expandRGBToRGBA(pixels, rgba.data(), count);
+        return rgba;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* src = pixels + i * static_cast<size_t>(channels);
+        unsigned char* dst = rgba.data() + i * 4;
+        dst[0] = src[0];
+        dst[1] = channels >= 2 ? src[1] : 0;
+        dst[2] = channels >= 3 ? src[2] : 0;
+        dst[3] = channels == 4 ? src[3] : 255;
+    }
+    return rgba;
+}
+
+// 按块并行编码一个级别，图片边缘不足 4 像素的块重复边缘像素
+void encodeLevel(const unsigned char* rgba, int width, int height, BlockFormat format,
+                 EncodeQuality quality, unsigned char* out) {
+    const size_t blocksX = (static_cast<size_t>(width) + 3) / 4;
+    const size_t blocksY = (static_cast<size_t>(height) + 3) / 4;
+    const size_t blockBytes = TextureContainer::getBlockBytes(format);
+    Parallel::forRange(blocksX * blocksY, kBlocksPerTask, [&](size_t begin, size_t end, unsigned int) {
+        unsigned char block[64];
+        for (size_t i = begin; i < end; ++i) {
+            size_t bx = i % blocksX;
+            size_t by = i / blocksX;
+            for (int y = 0; y < 4; ++y) {
+                size_t sy = std::min(by * 4 + y, static_cast<size_t>(height - 1));
+                for (int x = 0; x < 4; ++x) {
+                    size_t sx = std::min(bx * 4 + x, static_cast<size_t>(width - 1));
+                    std::memcpy(block + (y * 4 + x) * 4, rgba + (sy * width + sx) * 4, 4);
+                }
+            }
+            TextureEncoder::encodeBlock(format, quality, block, out + i * blockBytes);
+        }
+    });
+}
+
+// 参与 PSNR 统计的通道数（按 RGBA 顺序取前 n 个）
+int getStoredChannels(BlockFormat format) {
+    switch (format) {
+        case BlockFormat::BC1: return 3;
+        case BlockFormat::BC4: return 1;
+        case BlockFormat::BC5: return 2;
+        default: return 4;
+    }
+}
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;   // FNV-1a
+    }
+    return hash;
+}
+
+void createDirectories(const std::string& path) {
+    for (size_t pos = 0; pos != std::string::npos;) {
+        pos = path.find_first_of("/\\", pos + 1);
+        std::string prefix = path.substr(0, pos);
+        if (prefix.empty()) continue;
+#ifdef _WIN32
+        _mkdir(prefix.c_str());
+#else
+        mkdir(prefix.c_str(), 0755);
+#endif
+    }
+}
+
+std::string getCacheFileName(const std::string& path, uint64_t key) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos) name = name.substr(0, dot);
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+    return name + "_" + hex + ".dds";
+}
+
+} // namespace
+
+namespace TextureEncoder {
+
+bool isEncodable(BlockFormat format) {
+    return format == BlockFormat::BC1 || format == BlockFormat::BC3 ||
+           format == BlockFormat::BC4 || format == BlockFormat::BC5;
+}
+
+BlockFormat chooseFormat(const unsigned char* pixels, int width, int height, int channels, bool normalMap) {
+    if (normalMap || channels == 2) return BlockFormat::BC5;
+    if (channels == 1) return BlockFormat::BC4;
+    if (channels == 4) {
+        size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+        for (size_t i = 0; i < count; ++i) {
+            if (pixels[i * 4 + 3] != 255) return BlockFormat::BC3;
+        }
+    }
+    return BlockFormat::BC1;
+}
+
+void encodeBlock(BlockFormat format, EncodeQuality quality, const unsigned char* rgba, unsigned char* out) {
+    switch (format) {
+        case BlockFormat::BC1:
+            encodeColorBlock(rgba, quality, true, out);
+            break;
+        case BlockFormat::BC3:
+            encodeChannelBlock(rgba, 3, quality, out);
+            encodeColorBlock(rgba, quality, false, out + 8);
+            break;
+        case BlockFormat::BC4:
+            encodeChannelBlock(rgba, 0, quality, out);
+            break;
+        case BlockFormat::BC5:
+            encodeChannelBlock(rgba, 0, quality, out);
+            encodeChannelBlock(rgba, 1, quality, out + 8);
+            break;
+        default:
+            std::memset(out, 0, TextureContainer::getBlockBytes(format));
+            break;
+    }
+}
+
+void decodeBlock(BlockFormat format, const unsigned char* block, unsigned char* rgba) {
+    switch (format) {
+        case BlockFormat::BC1:
+            decodeColorBlock(block, false, rgba);
+            break;
+        case BlockFormat::BC3:
+            decodeColorBlock(block + 8, true, rgba);
+            decodeChannelBlock(block, rgba, 3);
+            break;
+        case BlockFormat::BC4:
+        case BlockFormat::BC5:
+            for (int i = 0; i < 16; ++i) {
+                rgba[i * 4 + 1] = rgba[i * 4 + 2] = 0;
+                rgba[i * 4 + 3] = 255;
+            }
+            decodeChannelBlock(block, rgba, 0);
+            if (format == BlockFormat::BC5) decodeChannelBlock(block + 8, rgba, 1);
+            break;
+        default:
+            std::memset(rgba, 0, 64);
+            break;
+    }
+}
+
+bool encode(const unsigned char* pixels, int width, int height, int channels,
+            const EncodeOptions& options, CompressedImage& out, std::string* error) {
+    out = CompressedImage();
+    if (!pixels || width <= 0 || height <= 0 || width > 65536 || height > 65536 || channels < 1 || channels > 4) {
+        return fail(error, "invalid image");
+    }
+    BlockFormat format = options.format;
+    if (format == BlockFormat::Count) {
+        format = chooseFormat(pixels, width, height, channels, options.normalMap);
+    }
+    if (!isEncodable(format)) {
+        return fail(error, "unsupported encode format (expected BC1/BC3/BC4/BC5)");
+    }
+
+    CompressedImage image;
+    image.format = format;
+    image.srgb = options.srgb && (format == BlockFormat::BC1 || format == BlockFormat::BC3);
+    image.width = width;
+    image.height = height;
+    int levelCount = options.generateMips ? ImageKernels::getMipLevelCount(width, height) : 1;
+    size_t offset = 0;
+    image.levels.resize(static_cast<size_t>(levelCount));
+    for (int i = 0; i < levelCount; ++i) {
+        CompressedImage::Level& level = image.levels[static_cast<size_t>(i)];
+        level.width = std::max(1, width >> i);
+        level.height = std::max(1, height >> i);
+        level.offset = offset;
+        level.size = TextureContainer::getLevelSize(format, level.width, level.height);
+        offset += level.size;
+    }
+    image.data.resize(offset);
+
+    std::vector<ImageLevel> mips(1);
+    mips[0].width = width;
+    mips[0].height = height;
+    mips[0].pixels = expandToRGBA(pixels, width, height, channels);
+    if (options.generateMips) {
+        MipOptions mipOptions;
+        mipOptions.filter = options.mipFilter;
+        mipOptions.srgb = options.gammaCorrectMips && !options.normalMap &&
+                          (format == BlockFormat::BC1 || format == BlockFormat::BC3);
+        ImageKernels::generateMipChain(mips, 4, mipOptions);
+    }
+    for (size_t i = 0; i < image.levels.size(); ++i) {
+        const CompressedImage::Level& level = image.levels[i];
+        encodeLevel(mips[i].pixels.data(), level.width, level.height, format, options.quality,
+                    image.data.data() + level.offset);
+    }
+    out = std::move(image);
+    return true;
+}
+
+void decodeLevel(const CompressedImage& image, size_t level, std::vector<unsigned char>& rgba) {
+    const CompressedImage::Level& l = image.levels[level];
+    const size_t width = static_cast<size_t>(l.width);
+    const size_t height = static_cast<size_t>(l.height);
+    const size_t blocksX = (width + 3) / 4;
+    const size_t blockBytes = TextureContainer::getBlockBytes(image.format);
+    rgba.resize(width * height * 4);
+
+    const unsigned char* data = image.getLevelData(level);
+    unsigned char block[64];
+    for (size_t by = 0; by * 4 < height; ++by) {
+        for (size_t bx = 0; bx < blocksX; ++bx) {
+            decodeBlock(image.format, data + (by * blocksX + bx) * blockBytes, block);
+            for (size_t y = 0; y < 4 && by * 4 + y < height; ++y) {
+                for (size_t x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                    std::memcpy(rgba.data() + ((by * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+}
+
+bool decompress(const CompressedImage& image, std::vector<ImageLevel>& levels) {
+    levels.clear();
+    if (image.empty() || !isEncodable(image.format)) return false;
+
+    levels.resize(image.levels.size());
+    for (size_t i = 0; i < image.levels.size(); ++i) {
+        levels[i].width = image.levels[i].width;
+        levels[i].height = image.levels[i].height;
+        decodeLevel(image, i, levels[i].pixels);
+    }
+    return true;
+}
+
+double measurePSNR(const unsigned char* pixels, int width, int height, int channels, const CompressedImage& image) {
+    if (image.empty() || image.width != width || image.height != height || !isEncodable(image.format)) {
+        return 0.0;
+    }
+    std::vector<unsigned char> reference = expandToRGBA(pixels, width, height, channels);
+    std::vector<unsigned char> decoded;
+    decodeLevel(image, 0, decoded);
+
+    const int stored = getStoredChannels(image.format);
+    double sum = 0.0;
+    size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    for (size_t i = 0; i < count; ++i) {
+        for (int c = 0; c < stored; ++c) {
+            double d = static_cast<double>(reference[i * 4 + c]) - decoded[i * 4 + c];
+            sum += d * d;
+        }
+    }
+    double mse = sum / static_cast<double>(count * stored);
+    if (mse == 0.0) return std::numeric_limits<double>::infinity();
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+bool loadOrEncode(const std::string& path, const EncodeOptions& options, const std::string& cacheDirectory,
+                  CompressedImage& out, bool* fromCache, std::string* error) {
+    out = CompressedImage();
+    if (fromCache) *fromCache = false;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return fail(error, "failed to open file");
+    }
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    uint64_t key = hashBytes(14695981039346656037ull, bytes.data(), bytes.size());
+    const int settings[8] = { static_cast<int>(kEncoderVersion), static_cast<int>(options.format),
+                              static_cast<int>(options.quality), options.normalMap, options.srgb, options.generateMips,
+                              static_cast<int>(options.mipFilter), options.gammaCorrectMips };
+    key = hashBytes(key, settings, sizeof(settings));
+    std::string cachePath = cacheDirectory + "/" + getCacheFileName(path, key);
+
+    if (TextureContainer::load(cachePath, out)) {
+        if (fromCache) *fromCache = true;
+        return true;
+    }
+
+    int width;
+    int height;
+    int channels;
+    std::unique_ptr<unsigned char, void (*)(void*)> pixels(
+        stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels, 0),
+        stbi_image_free);
+    if (!pixels) {
+        return fail(error, "failed to decode image");
+    }
+    if (!encode(pixels.get(), width, height, channels, options, out, error)) {
+        return false;
+    }
+
+    // 先写临时文件再改名，多个线程同时编码同一张图时不会读到写了一半的缓存
+    static std::atomic<unsigned> counter(0);
+    createDirectories(cacheDirectory);
+    std::string tempPath = cachePath + ".tmp" + std::to_string(counter++);
+    if (TextureContainer::save(tempPath, out) && std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+    }
+    return true;
+}
+
+const char* getQualityName(EncodeQuality quality) {
+    switch (quality) {
+        case EncodeQuality::Fast: return "fast";
+        case EncodeQuality::Normal: return "normal";
+        case EncodeQuality::High: return "high";
+        default: return "unknown";
+    }
+}
+
+} // namespace TextureEncoder
@@ -0,0 +1,356 @@
+#include "mesh/TextureStreamer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+const size_t kDefaultUploadBudget = 1024 * 1024;
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// level 级的边长（像素）
+float getLevelTexels(const TextureStreamer::Residency& residency, int level) {
+    return static_cast<float>(std::max(1, std::max(residency.width, residency.height) >> level));
+}
+
+} // namespace
+
+size_t TextureStreamer::Residency::getBytesFrom(int level) const {
+    size_t bytes = 0;
+    for (size_t i = static_cast<size_t>(std::max(level, 0)); i < levelBytes.size(); ++i) {
+        bytes += levelBytes[i];
+    }
+    return bytes;
+}
+
+TextureStreamer::TextureStreamer(size_t budgetBytes, unsigned int workers)
+    : decoder_(workers),
+      budget_(budgetBytes),
+      uploadBudget_(kDefaultUploadBudget) {
+}
+
+std::shared_ptr<CTexture> TextureStreamer::load(const std::string& path, TextureType type) {
+    auto texture = AsyncTextureLoader::createPlaceholder(path, type);
+    CTexture::CompressionSettings compression = CTexture::getCompressionSettings();
+    MipOptions mips = CTexture::getMipOptions(type);
+    uint64_t id = (compression.enabled && !TextureContainer::isContainerPath(path))
+        ? decoder_.submitEncoded(path, CTexture::getEncodeOptions(type), compression.cacheDirectory, mips)
+        : decoder_.submit(path, mips);
+    waiting_[id] = texture;
+    return texture;
+}
+
+void TextureStreamer::beginFrame(const glm::mat4& view, const glm::mat4& projection, float viewportHeight) {
+    view_ = view;
+    projection_ = projection;
+    viewportHeight_ = viewportHeight;
+    for (auto& it : entries_) {
+        it.second.residency.screenPixels = 0.0f;
+    }
+}
+
+void TextureStreamer::addUsage(const std::shared_ptr<CTexture>& texture, const glm::vec3& boundsMin,
+                               const glm::vec3& boundsMax, float uvScale) {
+    if (!texture) return;
+    auto it = entries_.find(texture.get());
+    if (it == entries_.end() || it->second.texture.lock() != texture) return;
+
+    float pixels = getScreenPixels(view_, projection_, viewportHeight_, boundsMin, boundsMax);
+    if (uvScale > 0.0f && pixels < FLT_MAX) pixels /= uvScale;
+    Residency& residency = it->second.residency;
+    residency.screenPixels = std::max(residency.screenPixels, pixels);
+}
+
+void TextureStreamer::update() {
+    releaseExpired();
+    size_t uploaded = collectDecoded();
+    assignLevels();
+    uploaded += streamWithinBudget(uploadBudget_);
+    stats_.bytesThisFrame = uploaded;
+    updateStats();
+}
+
+void TextureStreamer::finishAll() {
+    size_t uploaded = 0;
+    while (!isIdle()) {
+        decoder_.waitIdle();
+        releaseExpired();
+        uploaded += collectDecoded();
+        uploaded += streamWithinBudget(static_cast<size_t>(-1));
+    }
+    stats_.bytesThisFrame = uploaded;
+    updateStats();
+}
+
+bool TextureStreamer::isIdle() const {
+    if (!waiting_.empty()) return false;
+    for (const auto& it : entries_) {
+        if (it.second.residentLevel > it.second.residency.targetLevel) return false;
+    }
+    return true;
+}
+
+float TextureStreamer::getScreenPixels(const glm::mat4& view, const glm::mat4& projection, float viewportHeight,
+                                       const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    float radius = glm::length(boundsMax - boundsMin) * 0.5f;
+
+    // 正交投影：大小与距离无关
+    if (projection[3][3] == 1.0f) {
+        return radius * projection[1][1] * viewportHeight;
+    }
+
+    float distance = glm::length(glm::vec3(view * glm::vec4(center, 1.0f))) - radius;
+    if (distance <= 0.0f) return FLT_MAX;
+    return radius * projection[1][1] * viewportHeight / distance;
+}
+
+int TextureStreamer::selectLevel(int width, int height, int levelCount, float screenPixels, float bias) {
+    int coarsest = std::max(levelCount - 1, 0);
+    if (!(screenPixels > 0.0f)) return coarsest;
+
+    float texels = static_cast<float>(std::max(width, height));
+    float level = std::floor(std::log2(texels / screenPixels) + bias);
+    if (level <= 0.0f) return 0;
+    return std::min(static_cast<int>(level), coarsest);
+}
+
+void TextureStreamer::fitBudget(std::vector<Residency*>& textures, size_t budget) {
+    size_t total = 0;
+    for (Residency* residency : textures) {
+        residency->targetLevel = std::min(residency->desiredLevel, residency->tailLevel);
+        total += residency->getBytesFrom(residency->targetLevel);
+    }
+
+    while (total > budget) {
+        // 纹素 / 像素比最大的先放弃；本帧未使用的纹理比值为无穷大，同比值时先放弃更大的级别
+        Residency* victim = nullptr;
+        float victimRatio = 0.0f;
+        for (Residency* residency : textures) {
+            int level = residency->targetLevel;
+            if (level >= residency->tailLevel) continue;
+            float ratio = residency->screenPixels > 0.0f ? getLevelTexels(*residency, level) / residency->screenPixels
+                                                         : FLT_MAX;
+            if (!victim || ratio > victimRatio ||
+                (ratio == victimRatio && residency->levelBytes[level] > victim->levelBytes[victim->targetLevel])) {
+                victim = residency;
+                victimRatio = ratio;
+            }
+        }
+        if (!victim) break;
+        total -= victim->levelBytes[victim->targetLevel];
+        ++victim->targetLevel;
+    }
+}
+
+void TextureStreamer::releaseExpired() {
+    // 纹理对象属于 CTexture，随 CTexture 析构释放，这里只丢弃 CPU 数据
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.texture.expired()) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t TextureStreamer::collectDecoded() {
+    size_t uploaded = 0;
+    decoded_.clear();
+    decoder_.poll(decoded_);
+    for (auto& image : decoded_) {
+        auto it = waiting_.find(image.id);
+        if (it == waiting_.end()) continue;
+        std::shared_ptr<CTexture> texture = it->second.lock();
+        waiting_.erase(it);
+
+        image.decompressIfUnsupported();
+        if (!image.isValid()) {
+            ++stats_.failed;
+            std::cout << "Failed to load texture: " << image.path << std::endl;
+            continue;
+        }
+        if (!texture) continue;
+
+        Entry entry;
+        entry.texture = texture;
+        entry.image = std::move(image);
+        Residency& residency = entry.residency;
+        int levelCount = static_cast<int>(entry.image.getLevelCount());
+        residency.width = entry.image.width;
+        residency.height = entry.image.height;
+        residency.tailLevel = levelCount - 1;
+        for (int i = 0; i < levelCount; ++i) {
+            residency.levelBytes.push_back(entry.image.getLevelBytes(static_cast<size_t>(i)));
+            if (residency.tailLevel == levelCount - 1 &&
+                std::max(entry.image.getLevelWidth(i), entry.image.getLevelHeight(i)) <= getTailSize()) {
+                residency.tailLevel = i;
+            }
+        }
+        residency.desiredLevel = residency.targetLevel = residency.tailLevel;
+
+        uploaded += uploadTail(entry, texture);
+        entries_[texture.get()] = std::move(entry);
+    }
+    stats_.bytesUploaded += uploaded;
+    return uploaded;
+}
+
+void TextureStreamer::assignLevels() {
+    std::vector<Residency*> residencies;
+    residencies.reserve(entries_.size());
+    stats_.requestedBytes = 0;
+    for (auto& it : entries_) {
+        Residency& residency = it.second.residency;
+        residency.desiredLevel = selectLevel(residency.width, residency.height,
+                                             static_cast<int>(residency.levelBytes.size()),
+                                             residency.screenPixels, lodBias_);
+        stats_.requestedBytes += residency.getBytesFrom(std::min(residency.desiredLevel, residency.tailLevel));
+        residencies.push_back(&residency);
+    }
+    fitBudget(residencies, budget_);
+
+    for (auto& it : entries_) {
+        Entry& entry = it.second;
+        int target = entry.residency.targetLevel;
+        if (target >= entry.residentLevel) {
+            // 不再需要更细的级别：释放多余级别，放弃未完成的上传
+            evictTo(entry, target);
+            entry.streaming = false;
+        } else if (!entry.streaming) {
+            entry.streaming = true;
+            entry.requestTime = Clock::now();
+        }
+    }
+}
+
+size_t TextureStreamer::streamWithinBudget(size_t budget) {
+    // 屏幕上最缺纹素（像素 / 已驻留纹素比最大）的纹理先上传
+    std::vector<Entry*> pending;
+    for (auto& it : entries_) {
+        if (it.second.residentLevel > it.second.residency.targetLevel) pending.push_back(&it.second);
+    }
+    std::sort(pending.begin(), pending.end(), [](const Entry* a, const Entry* b) {
+        return a->residency.screenPixels / getLevelTexels(a->residency, a->residentLevel) >
+               b->residency.screenPixels / getLevelTexels(b->residency, b->residentLevel);
+    });
+
+    size_t uploaded = 0;
+    for (Entry* entry : pending) {
+        while (entry->residentLevel > entry->residency.targetLevel) {
+            int level = entry->residentLevel - 1;
+
+            int rows = entry->image.getChunkRows(static_cast<size_t>(level), entry->nextRow, budget - uploaded,
+                                                 uploaded > 0);
+            if (rows == 0) break;
+            uploaded += uploadRows(*entry, level, rows);
+            if (entry->nextRow < entry->image.getRowCount(static_cast<size_t>(level))) break;
+
+            // 整级上传完成后才降低 BASE_LEVEL，采样不会读到未写入的行
+            entry->nextRow = 0;
+            entry->residentLevel = level;
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+            ++stats_.levelsStreamed;
+            updateResidentBytes(*entry);
+
+            if (entry->streaming && entry->residentLevel <= entry->residency.targetLevel) {
+                entry->streaming = false;
+                double latency = secondsSince(entry->requestTime);
+                ++stats_.requestsCompleted;
+                stats_.lastLatencySeconds = latency;
+                stats_.maxLatencySeconds = std::max(stats_.maxLatencySeconds, latency);
+                stats_.totalLatencySeconds += latency;
+            }
+        }
+        if (uploaded >= budget) break;
+    }
+    stats_.bytesUploaded += uploaded;
+    return uploaded;
+}
+
+size_t TextureStreamer::uploadTail(Entry& entry, const std::shared_ptr<CTexture>& texture) {
+    const DecodedImage& image = entry.image;
+    int levelCount = static_cast<int>(image.getLevelCount());
+    int tail = entry.residency.tailLevel;
+
+    glGenTextures(1, &entry.id);
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, tail);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+    // 由粗到细上传，和流式上传一样逐级完成
+    size_t uploaded = 0;
+    for (int level = levelCount - 1; level >= tail; --level) {
+        entry.nextRow = 0;
+        uploaded += uploadRows(entry, level, image.getRowCount(static_cast<size_t>(level)));
+    }
+    entry.nextRow = 0;
+    entry.residentLevel = tail;
+
+    image.applySamplerDefaults();
+
+    if (image.isCompressed()) {
+        texture->adoptCompressed(entry.id, image.compressed);
+    } else {
+        texture->adopt(entry.id, image.width, image.height, image.channels);
+    }
+    updateResidentBytes(entry);
+    std::cout << "Streaming texture: " << image.path << " (" << image.width << "x" << image.height << ", "
+              << levelCount - tail << " of " << levelCount << " levels resident, decoded in "
+              << image.decodeSeconds * 1000.0 << " ms)" << std::endl;
+    return uploaded;
+}
+
+size_t TextureStreamer::uploadRows(Entry& entry, int level, int rows) {
+    const DecodedImage& image = entry.image;
+    size_t index = static_cast<size_t>(level);
+
+    // 直接从 CPU 数据上传；StreamingBuffer 可能仍绑定为 GL_PIXEL_UNPACK_BUFFER
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    if (entry.nextRow == 0) {
+        image.allocateLevel(index);
+    }
+    image.uploadRows(index, entry.nextRow, rows, image.getRowData(index, entry.nextRow));
+    entry.nextRow += rows;
+    return image.getRowBytes(index) * static_cast<size_t>(rows);
+}
+
+void TextureStreamer::evictTo(Entry& entry, int level) {
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    if (entry.nextRow > 0) {
+        entry.image.allocateLevel(static_cast<size_t>(entry.residentLevel - 1), true);
+        entry.nextRow = 0;
+    }
+    if (level <= entry.residentLevel) return;
+
+    // 先提高 BASE_LEVEL，再释放不再采样的级别
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    for (int i = entry.residentLevel; i < level; ++i) {
+        entry.image.allocateLevel(static_cast<size_t>(i), true);
+    }
+    stats_.levelsEvicted += static_cast<size_t>(level - entry.residentLevel);
+    entry.residentLevel = level;
+    updateResidentBytes(entry);
+}
+
+void TextureStreamer::updateResidentBytes(Entry& entry) {
+    if (auto texture = entry.texture.lock()) {
+        texture->setGpuMemoryBytes(entry.residency.getBytesFrom(entry.residentLevel));
+    }
+}
+
+void TextureStreamer::updateStats() {
+    stats_.textures = entries_.size();
+    stats_.residentBytes = 0;
+    stats_.targetBytes = 0;
+    for (const auto& it : entries_) {
+        const Entry& entry = it.second;
+        stats_.residentBytes += entry.residency.getBytesFrom(entry.residentLevel);
+        stats_.targetBytes += entry.residency.getBytesFrom(entry.residency.targetLevel);
+    }
+}
@@ -0,0 +1,327 @@
+#include "mesh/VertexFormat.h"
+#include "mesh/MeshKernels.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace VertexFormat {
+
+namespace {
+
+// Vertex 中各属性的字节偏移与分量数，按 VertexAttribute 枚举索引
+const size_t kSourceOffsets[] = {
+    offsetof(Vertex, position),
+    offsetof(Vertex, normal),
+    offsetof(Vertex, texCoords),
+    offsetof(Vertex, tangent),
+    offsetof(Vertex, bitangent)
+};
+const unsigned kSourceComponents[] = { 3, 3, 2, 3, 3 };
+
+bool isKnownType(VertexAttribute type) {
+    return static_cast<size_t>(type) < static_cast<size_t>(VertexAttribute::Count);
+}
+
+const float* sourceOf(const Vertex* src, VertexAttribute type) {
+    return reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(src) +
+                                          kSourceOffsets[static_cast<size_t>(type)]);
+}
+
+// 10_10_10_2 的 w 位：切线存 TBN 手性（+1 / -1），其余为 0
+uint32_t handednessBits(const Vertex& v) {
+    float sign = glm::dot(glm::cross(v.normal, v.tangent), v.bitangent);
+    return sign < 0.0f ? 0xC0000000u : 0x40000000u;
+}
+
+// 带压缩编码的布局：每个属性一列，整列交给 SIMD 内核
+void packEncoded(const VertexAttributeLayout& layout, const Vertex* src, size_t count, unsigned char* dst,
+                 const PositionRange& range) {
+    const size_t stride = layout.stride;
+    for (const auto& attr : layout.attributes) {
+        if (!isKnownType(attr.type)) continue;
+        unsigned components = std::min(attr.count, kSourceComponents[static_cast<size_t>(attr.type)]);
+        const float* in = sourceOf(src, attr.type);
+        unsigned char* out = dst + attr.offset;
+
+        // 源分量不足时，属性中多出的部分补 0
+        unsigned bytes = VertexAttributeLayout::attributeBytes(attr.count, attr.format);
+        if (attr.format != VertexAttributeFormat::Snorm10 &&
+            VertexAttributeLayout::attributeBytes(components, attr.format) < bytes) {
+            for (size_t i = 0; i < count; ++i) {
+                std::memset(out + i * stride, 0, bytes);
+            }
+        }
+
+        switch (attr.format) {
+            case VertexAttributeFormat::Half:
+                MeshKernels::encodeHalf(in, sizeof(Vertex), components, out, stride, count);
+                break;
+            case VertexAttributeFormat::Unorm16: {
+                glm::vec3 bias(0.0f);
+                glm::vec3 invScale(1.0f);
+                if (attr.type == VertexAttribute::Position) {
+                    bias = range.bias;
+                    for (int k = 0; k < 3; ++k) {
+                        invScale[k] = range.scale[k] != 0.0f ? 1.0f / range.scale[k] : 0.0f;
+                    }
+                }
+                MeshKernels::encodeUnorm16(in, sizeof(Vertex), components, bias, invScale, out, stride, count);
+                break;
+            }
+            case VertexAttributeFormat::Snorm10:
+                MeshKernels::encodeSnorm10(in, sizeof(Vertex), out, stride, count);
+                if (attr.type == VertexAttribute::Tangent) {
+                    for (size_t i = 0; i < count; ++i) {
+                        uint32_t packed;
+                        std::memcpy(&packed, out + i * stride, sizeof(packed));
+                        packed |= handednessBits(src[i]);
+                        std::memcpy(out + i * stride, &packed, sizeof(packed));
+                    }
+                }
+                break;
+            default:
+                for (size_t i = 0; i < count; ++i) {
+                    std::memcpy(out + i * stride, reinterpret_cast<const unsigned char*>(&src[i]) +
+                                kSourceOffsets[static_cast<size_t>(attr.type)], components * sizeof(float));
+                }
+                break;
+        }
+    }
+}
+
+int signExtend10(uint32_t bits) {
+    int value = static_cast<int>(bits & 0x3FFu);
+    return value >= 512 ? value - 1024 : value;
+}
+
+// 按 GL 规则解码一个属性（最多 4 个分量），用于误差统计
+glm::vec4 decodeAttribute(const unsigned char* data, const VertexAttributeLayout::Attribute& attr,
+                          const PositionRange& range) {
+    glm::vec4 result(0.0f);
+    unsigned components = std::min(attr.count, 4u);
+    switch (attr.format) {
+        case VertexAttributeFormat::Half: {
+            uint16_t h[4] = { 0, 0, 0, 0 };
+            std::memcpy(h, data, components * sizeof(uint16_t));
+            for (unsigned k = 0; k < components; ++k) result[k] = MeshKernels::halfToFloat(h[k]);
+            break;
+        }
+        case VertexAttributeFormat::Unorm16: {
+            uint16_t q[4] = { 0, 0, 0, 0 };
+            std::memcpy(q, data, components * sizeof(uint16_t));
+            for (unsigned k = 0; k < components; ++k) result[k] = q[k] / 65535.0f;
+            if (attr.type == VertexAttribute::Position) {
+                for (int k = 0; k < 3; ++k) result[k] = range.bias[k] + result[k] * range.scale[k];
+            }
+            break;
+        }
+        case VertexAttributeFormat::Snorm10: {
+            uint32_t packed;
+            std::memcpy(&packed, data, sizeof(packed));
+            for (int k = 0; k < 3; ++k) {
+                result[k] = std::max(signExtend10(packed >> (10 * k)) / 511.0f, -1.0f);
+            }
+            int w = static_cast<int>(packed >> 30);
+            result.w = std::max(static_cast<float>(w >= 2 ? w - 4 : w), -1.0f);
+            break;
+        }
+        default:
+            std::memcpy(&result[0], data, components * sizeof(float));
+            break;
+    }
+    return result;
+}
+
+float angleDegrees(const glm::vec3& a, const glm::vec3& b) {
+    float la = glm::length(a);
+    float lb = glm::length(b);
+    if (la == 0.0f || lb == 0.0f) return 0.0f;
+    float c = glm::clamp(glm::dot(a, b) / (la * lb), -1.0f, 1.0f);
+    return glm::degrees(std::acos(c));
+}
+
+} // namespace
+
+bool isQuantized(const VertexAttributeLayout& layout) {
+    for (const auto& attr : layout.attributes) {
+        if (attr.format != VertexAttributeFormat::Float) return true;
+    }
+    return false;
+}
+
+bool hasQuantizedPositions(const VertexAttributeLayout& layout) {
+    for (const auto& attr : layout.attributes) {
+        if (attr.type == VertexAttribute::Position && attr.format == VertexAttributeFormat::Unorm16) return true;
+    }
+    return false;
+}
+
+PositionRange computePositionRange(const Vertex* src, size_t count) {
+    glm::vec3 minPos, maxPos;
+    if (!src || !MeshKernels::computeAABB(&src[0].position.x, count, sizeof(Vertex), minPos, maxPos)) {
+        return PositionRange();
+    }
+    return PositionRange(minPos, maxPos - minPos);
+}
+
+void packGeneric(const VertexAttributeLayout& layout, const Vertex* src, size_t count, void* dst) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* in = reinterpret_cast<const unsigned char*>(&src[i]);
+        unsigned char* out = static_cast<unsigned char*>(dst) + i * layout.stride;
+        for (const auto& attr : layout.attributes) {
+            if (!isKnownType(attr.type) || attr.format != VertexAttributeFormat::Float) continue;
+            size_t type = static_cast<size_t>(attr.type);
+            // 分量数超过 Vertex 成员时只复制已有部分，其余补 0
+            unsigned copied = std::min(attr.count, kSourceComponents[type]);
+            std::memcpy(out + attr.offset, in + kSourceOffsets[type], copied * sizeof(float));
+            if (attr.count > copied) {
+                std::memset(out + attr.offset + copied * sizeof(float), 0, (attr.count - copied) * sizeof(float));
+            }
+        }
+    }
+}
+
+unsigned getCanonicalMask(const VertexAttributeLayout& layout) {
+    unsigned mask = 0;
+    unsigned offset = 0;
+    int previous = -1;
+    for (const auto& attr : layout.attributes) {
+        int type = static_cast<int>(attr.type);
+        if (type <= previous || type >= static_cast<int>(VertexAttribute::Count)) return 0;
+        if (attr.format != VertexAttributeFormat::Float) return 0;
+        if (attr.count != kSourceComponents[type] || attr.offset != offset) return 0;
+        mask |= 1u << type;
+        offset += attr.count * sizeof(float);
+        previous = type;
+    }
+    return offset == layout.stride ? mask : 0;
+}
+
+bool sameFormat(const VertexAttributeLayout& a, const VertexAttributeLayout& b) {
+    if (a.stride != b.stride || a.attributes.size() != b.attributes.size()) return false;
+    for (size_t i = 0; i < a.attributes.size(); ++i) {
+        if (a.attributes[i].type != b.attributes[i].type ||
+            a.attributes[i].count != b.attributes[i].count ||
+            a.attributes[i].offset != b.attributes[i].offset ||
+            a.attributes[i].format != b.attributes[i].format) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool matchesVertex(const VertexAttributeLayout& layout) {
+    return getCanonicalMask(layout) == (PositionBit | NormalBit | TexCoordsBit | TangentBit | BitangentBit);
+}
+
+VertexAttributeLayout getPositionLayout(const VertexAttributeLayout& layout) {
+    VertexAttributeLayout result;
+    for (const auto& attr : layout.attributes) {
+        if (attr.type == VertexAttribute::Position) {
+            result.addAttribute(VertexAttribute::Position, attr.count, attr.format);
+            return result;
+        }
+    }
+    return VertexAttributeLayout::PositionOnly();
+}
+
+void pack(const VertexAttributeLayout& layout, const Vertex* src, size_t count, void* dst,
+          const PositionRange& range) {
+    unsigned char* out = static_cast<unsigned char*>(dst);
+    if (isQuantized(layout)) {
+        packEncoded(layout, src, count, out, range);
+        return;
+    }
+    switch (getCanonicalMask(layout)) {
+        case PositionBit:
+            PositionOnly::pack(src, count, out);
+            break;
+        case PositionBit | NormalBit:
+            PositionNormal::pack(src, count, out);
+            break;
+        case PositionBit | NormalBit | TexCoordsBit:
+            PositionNormalTex::pack(src, count, out);
+            break;
+        case PositionBit | NormalBit | TexCoordsBit | TangentBit | BitangentBit:
+            std::memcpy(out, src, count * sizeof(Vertex));
+            break;
+        default:
+            packGeneric(layout, src, count, out);
+            break;
+    }
+}
+
+ErrorReport measureError(const VertexAttributeLayout& layout, const Vertex* src, size_t count,
+                         const PositionRange& range) {
+    ErrorReport report;
+    report.bytesPerVertex = layout.stride;
+    if (!src || count == 0 || layout.stride == 0) return report;
+
+    std::vector<unsigned char> packed(count * layout.stride);
+    pack(layout, src, count, packed.data(), range);
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex& v = src[i];
+        const unsigned char* base = packed.data() + i * layout.stride;
+        for (const auto& attr : layout.attributes) {
+            glm::vec4 decoded = decodeAttribute(base + attr.offset, attr, range);
+            switch (attr.type) {
+                case VertexAttribute::Position:
+                    report.maxPositionError = std::max(report.maxPositionError,
+                                                       glm::length(glm::vec3(decoded) - v.position));
+                    break;
+                case VertexAttribute::Normal:
+                    report.maxNormalErrorDegrees = std::max(report.maxNormalErrorDegrees,
+                                                            angleDegrees(glm::vec3(decoded), v.normal));
+                    break;
+                case VertexAttribute::TexCoords:
+                    report.maxTexCoordError = std::max(report.maxTexCoordError,
+                                                       glm::length(glm::vec2(decoded.x, decoded.y) - v.texCoords));
+                    break;
+                case VertexAttribute::Tangent:
+                    report.maxTangentErrorDegrees = std::max(report.maxTangentErrorDegrees,
+                                                             angleDegrees(glm::vec3(decoded), v.tangent));
+                    if (attr.format == VertexAttributeFormat::Snorm10 &&
+                        (decoded.w < 0.0f) != (handednessBits(v) == 0xC0000000u)) {
+                        ++report.handednessMismatches;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return report;
+}
+
+void setupAttributePointers(const VertexAttributeLayout& layout, size_t baseOffset) {
+    GLsizei stride = static_cast<GLsizei>(layout.stride);
+    for (const auto& attr : layout.attributes) {
+        if (!isKnownType(attr.type)) continue;
+
+        GLenum type = GL_FLOAT;
+        GLboolean normalized = GL_FALSE;
+        switch (attr.format) {
+            case VertexAttributeFormat::Half:
+                type = GL_HALF_FLOAT;
+                break;
+            case VertexAttributeFormat::Unorm16:
+                type = GL_UNSIGNED_SHORT;
+                normalized = GL_TRUE;
+                break;
+            case VertexAttributeFormat::Snorm10:
+                type = GL_INT_2_10_10_10_REV;
+                normalized = GL_TRUE;
+                break;
+            default:
+                break;
+        }
+
+        GLuint location = static_cast<GLuint>(attr.type);
+        glVertexAttribPointer(location, attr.count, type, normalized, stride, (void*)(baseOffset + attr.offset));
+        glEnableVertexAttribArray(location);
+    }
+}
+
+} // namespace VertexFormat
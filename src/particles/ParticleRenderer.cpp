@@ -4,21 +4,50 @@
  */
 
 #include "particles/ParticleRenderer.h"
+#include "core/GLState.h"
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
+namespace {
+
+// Per-instance layout: position(3) + color(4) + scale(3) + rotation(1)
+const size_t kFloatsPerParticle = 11;
+const size_t kMaxBufferedParticles = 10000;
+
+void writeInstanceData(float* dst, const std::vector<Particle*>& particles, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const Particle* p = particles[i];
+        dst[0] = p->position.x;
+        dst[1] = p->position.y;
+        dst[2] = p->position.z;
+        dst[3] = p->color.r;
+        dst[4] = p->color.g;
+        dst[5] = p->color.b;
+        dst[6] = p->color.a;
+        dst[7] = p->scale.x;
+        dst[8] = p->scale.y;
+        dst[9] = p->scale.z;
+        dst[10] = p->rotation;
+        dst += kFloatsPerParticle;
+    }
+}
+
+} // namespace
+
 ParticleRenderer::ParticleRenderer()
     : vao_(0)
     , vbo_(0)
     , texture_(0)
     , hasTexture_(false)
     , additiveBlending_(true)
-    , initialized_(false) {
+    , initialized_(false)
+    , usingStream_(false) {
 }
 
 ParticleRenderer::~ParticleRenderer() {
     if (vao_ != 0) {
-        glDeleteVertexArrays(1, &vao_);
+        GLState::deleteVertexArray(vao_);
     }
     if (vbo_ != 0) {
         glDeleteBuffers(1, &vbo_);
@@ -54,65 +83,67 @@ void ParticleRenderer::createQuadVAO() {
     glGenVertexArrays(1, &vao_);
     glGenBuffers(1, &vbo_);
     
-    glBindVertexArray(vao_);
+    GLState::bindVertexArray(vao_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     
     // Allocate buffer (will be updated each frame)
-    glBufferData(GL_ARRAY_BUFFER, 10000 * sizeof(float) * 11, nullptr, GL_DYNAMIC_DRAW);
-    
-    // Position attribute (location 0)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
-    glVertexAttribDivisor(0, 1);  // Instance data
-    
-    // Color attribute (location 1)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
-    glVertexAttribDivisor(1, 1);
+    glBufferData(GL_ARRAY_BUFFER, kMaxBufferedParticles * kFloatsPerParticle * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
     
-    // Scale attribute (location 2)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(7 * sizeof(float)));
-    glVertexAttribDivisor(2, 1);
-    
-    // Rotation attribute (location 3)
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(10 * sizeof(float)));
-    glVertexAttribDivisor(3, 1);
+    // Attribute locations 0-3, one element per instance
+    for (GLuint location = 0; location < 4; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    setInstanceAttributes(vbo_, 0);
     
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
 
-void ParticleRenderer::updateParticleBuffer(const ParticleEmitter& emitter) {
-    auto aliveParticles = const_cast<ParticleEmitter&>(emitter).getAliveParticles();
-    if (aliveParticles.empty()) return;
+void ParticleRenderer::setInstanceAttributes(unsigned int buffer, size_t baseOffset) {
+    const GLsizei stride = kFloatsPerParticle * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    
+    // Position (location 0), color (1), scale (2), rotation (3)
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)(baseOffset));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(baseOffset + 3 * sizeof(float)));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(baseOffset + 7 * sizeof(float)));
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(baseOffset + 10 * sizeof(float)));
+}
+
+size_t ParticleRenderer::updateParticleBuffer(const std::vector<Particle*>& particles) {
+    if (particles.empty()) return 0;
+    
+    // Ring path: write straight into mapped memory, no staging copy or driver sync
+    if (streamingBuffer_ && streamingBuffer_->isInitialized()) {
+        size_t bytes = particles.size() * kFloatsPerParticle * sizeof(float);
+        StreamingBuffer::Allocation allocation = streamingBuffer_->map(bytes, sizeof(float));
+        if (allocation.isValid()) {
+            writeInstanceData(static_cast<float*>(allocation.data), particles, particles.size());
+            streamingBuffer_->unmap();
+            
+            GLState::bindVertexArray(vao_);
+            setInstanceAttributes(streamingBuffer_->getBuffer(), static_cast<size_t>(allocation.offset));
+            GLState::bindVertexArray(0);
+            usingStream_ = true;
+            return particles.size();
+        }
+    }
+    
+    // Private VBO path, limited to the preallocated capacity
+    size_t count = std::min(particles.size(), kMaxBufferedParticles);
+    std::vector<float> data(count * kFloatsPerParticle);
+    writeInstanceData(data.data(), particles, count);
     
-    std::vector<float> data;
-    data.reserve(aliveParticles.size() * 11);
-    
-    for (const Particle* p : aliveParticles) {
-        // Position
-        data.push_back(p->position.x);
-        data.push_back(p->position.y);
-        data.push_back(p->position.z);
-        
-        // Color
-        data.push_back(p->color.r);
-        data.push_back(p->color.g);
-        data.push_back(p->color.b);
-        data.push_back(p->color.a);
-        
-        // Scale
-        data.push_back(p->scale.x);
-        data.push_back(p->scale.y);
-        data.push_back(p->scale.z);
-        
-        // Rotation
-        data.push_back(p->rotation);
+    if (usingStream_) {
+        GLState::bindVertexArray(vao_);
+        setInstanceAttributes(vbo_, 0);
+        GLState::bindVertexArray(0);
+        usingStream_ = false;
     }
     
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferSubData(GL_ARRAY_BUFFER, 0, data.size() * sizeof(float), data.data());
+    return count;
 }
 
 void ParticleRenderer::render(const ParticleEmitter& emitter, 
@@ -124,7 +155,8 @@ void ParticleRenderer::render(const ParticleEmitter& emitter,
     if (aliveParticles.empty()) return;
     
     // Update buffer
-    updateParticleBuffer(emitter);
+    size_t instanceCount = updateParticleBuffer(aliveParticles);
+    if (instanceCount == 0) return;
     
     // Enable blending
     glEnable(GL_BLEND);
@@ -160,9 +192,9 @@ void ParticleRenderer::render(const ParticleEmitter& emitter,
     }
     
     // Render particles as quads (4 vertices per particle, using instancing)
-    glBindVertexArray(vao_);
-    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(aliveParticles.size()));
-    glBindVertexArray(0);
+    GLState::bindVertexArray(vao_);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instanceCount));
+    GLState::bindVertexArray(0);
     
     // Restore state
     glDepthMask(GL_TRUE);
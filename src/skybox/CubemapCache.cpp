@@ -0,0 +1,334 @@
+/**
+ * @file CubemapCache.cpp
+ * @brief Asynchronously decoded, cached cubemap textures
+ */
+
+#include "skybox/CubemapCache.h"
+#include "skybox/HdrCubemap.h"
+#include "mesh/MeshKernels.h"
+#include "mesh/Texture.h"
+#include "mesh/stb_image.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// Faces are projected from the first mip at most this size: ambient only needs low frequencies
+const int kIrradianceFaceSize = 64;
+
+const float* srgbToLinearTable() {
+    static const std::vector<float> table = []() {
+        std::vector<float> values(256);
+        for (int i = 0; i < 256; ++i) {
+            float v = static_cast<float>(i) / 255.0f;
+            values[static_cast<size_t>(i)] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+} // namespace
+
+CubemapCache::CubemapCache(unsigned int threadCount, size_t uploadBudget)
+    : uploadBudget_(uploadBudget)
+    , hdrCacheDirectory_("cache/cubemaps")
+    , pool_(threadCount) {
+}
+
+CubemapCache::~CubemapCache() {
+    for (const Upload& upload : uploads_) {
+        if (upload.id != 0) glDeleteTextures(1, &upload.id);
+    }
+    for (const auto& item : entries_) {
+        if (item.second.texture != 0) glDeleteTextures(1, &item.second.texture);
+    }
+}
+
+CubemapCache::State CubemapCache::request(const std::string& name, const std::vector<std::string>& faces) {
+    auto it = entries_.find(name);
+    if (it != entries_.end()) {
+        ++stats_.hits;
+        return it->second.state;
+    }
+
+    entries_[name] = Entry();
+    const bool panorama = faces.size() == 1 && HdrCubemap::isHdrPath(faces[0]);
+    if (faces.size() != 6 && !panorama) {
+        std::cerr << "Cubemap requires exactly 6 faces or one .hdr panorama: " << name << std::endl;
+        fail(name);
+        updateCounts();
+        return State::Failed;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->name = name;
+    job->paths = faces;
+    job->start = std::chrono::steady_clock::now();
+    if (panorama) {
+        job->hdr = true;
+        job->remaining = 1;
+        pool_.submit([this, job]() { decodePanorama(job); });
+    } else {
+        for (int i = 0; i < 6; ++i) {
+            pool_.submit([this, job, i]() { decodeFace(job, i); });
+        }
+    }
+    updateCounts();
+    return State::Pending;
+}
+
+CubemapCache::State CubemapCache::getState(const std::string& name) const {
+    auto it = entries_.find(name);
+    return it != entries_.end() ? it->second.state : State::Missing;
+}
+
+GLuint CubemapCache::getTexture(const std::string& name) const {
+    auto it = entries_.find(name);
+    return it != entries_.end() && it->second.state == State::Ready ? it->second.texture : 0;
+}
+
+bool CubemapCache::getIrradiance(const std::string& name, SHCoefficients& out) const {
+    auto it = entries_.find(name);
+    if (it == entries_.end() || it->second.state != State::Ready) return false;
+    out = it->second.irradiance;
+    return true;
+}
+
+bool CubemapCache::isHdr(const std::string& name) const {
+    auto it = entries_.find(name);
+    return it != entries_.end() && it->second.state == State::Ready && it->second.hdr;
+}
+
+void CubemapCache::decodeFace(const std::shared_ptr<Job>& job, int face) {
+    Face& result = job->faces[face];
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(job->paths[static_cast<size_t>(face)].c_str(), &width, &height, &channels, 0);
+    if (data) {
+        // Colour data, edges clamped: faces meet at seams rather than tiling
+        MipOptions mips;
+        mips.srgb = true;
+        mips.wrap = false;
+        CTexture::prepareLevels(data, width, height, channels, mips, result.levels);
+        result.channels = CTexture::getUploadChannels(channels);
+        result.internalFormat = CTexture::getGLInternalFormat(result.channels);
+        result.format = CTexture::getGLFormat(result.channels);
+        result.decoded = true;
+        stbi_image_free(data);
+    }
+    completeTask(job);
+}
+
+void CubemapCache::decodePanorama(const std::shared_ptr<Job>& job) {
+    HdrCubemapImage image;
+    std::string error;
+    if (HdrCubemap::loadOrConvert(job->paths[0], hdrCacheDirectory_, 0, image, nullptr, &error)) {
+        for (int i = 0; i < 6; ++i) {
+            Face& face = job->faces[i];
+            face.levels = std::move(image.faces[i]);
+            face.channels = 3;
+            face.internalFormat = GL_RGB16F;
+            face.format = GL_RGB;
+            face.type = GL_HALF_FLOAT;
+            face.decoded = true;
+        }
+    } else {
+        std::cerr << "Failed to convert HDR panorama: " << job->paths[0] << " (" << error << ")" << std::endl;
+    }
+    completeTask(job);
+}
+
+void CubemapCache::completeTask(const std::shared_ptr<Job>& job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--job->remaining != 0) return;
+    }
+
+    // The last task validates and projects the irradiance, keeping both off the GL thread
+    job->valid = validate(*job);
+    if (job->valid) {
+        job->irradiance = projectIrradiance(*job);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    decoded_.push_back(job);
+}
+
+SHCoefficients CubemapCache::projectIrradiance(const Job& job) {
+    const std::vector<ImageLevel>& levels = job.faces[0].levels;
+    size_t index = 0;
+    while (index + 1 < levels.size() && levels[index].width > kIrradianceFaceSize) ++index;
+    const int size = levels[index].width;
+    const size_t texels = static_cast<size_t>(size) * size;
+
+    // Linear RGB floats: HDR faces are half floats, LDR faces are sRGB bytes
+    std::vector<float> faces[6];
+    const float* toLinear = srgbToLinearTable();
+    for (int i = 0; i < 6; ++i) {
+        const Face& face = job.faces[i];
+        const ImageLevel& level = face.levels[index];
+        faces[i].resize(texels * 3);
+        for (size_t t = 0; t < texels; ++t) {
+            for (int c = 0; c < 3; ++c) {
+                size_t source = t * static_cast<size_t>(face.channels) + static_cast<size_t>(face.channels >= 3 ? c : 0);
+                faces[i][t * 3 + c] = face.type == GL_HALF_FLOAT
+                    ? MeshKernels::halfToFloat(reinterpret_cast<const uint16_t*>(level.pixels.data())[source])
+                    : toLinear[level.pixels[source]];
+            }
+        }
+    }
+
+    SHCoefficients sh = SphericalHarmonics::projectCubemap(faces, size);
+    SphericalHarmonics::convolveIrradiance(sh);
+    return sh;
+}
+
+bool CubemapCache::validate(const Job& job) const {
+    const Face& first = job.faces[0];
+    for (int i = 0; i < 6; ++i) {
+        const Face& face = job.faces[i];
+        if (!face.decoded) {
+            // A panorama reports its own error; it has a single path
+            if (!job.hdr) {
+                std::cerr << "Failed to load cubemap face: " << job.paths[static_cast<size_t>(i)] << std::endl;
+            }
+            return false;
+        }
+        if (job.hdr) continue;
+        if (face.levels[0].width != face.levels[0].height) {
+            std::cerr << "Cubemap face is not square: " << job.paths[static_cast<size_t>(i)] << std::endl;
+            return false;
+        }
+        if (face.levels[0].width != first.levels[0].width || face.internalFormat != first.internalFormat) {
+            std::cerr << "Cubemap face size or format differs from the first face: "
+                      << job.paths[static_cast<size_t>(i)] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t CubemapCache::update() {
+    size_t completed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& job : decoded_) {
+            if (job->valid) {
+                Upload upload;
+                upload.job = job;
+                uploads_.push_back(upload);
+            } else {
+                fail(job->name);
+                ++completed;
+            }
+        }
+        decoded_.clear();
+    }
+
+    // Upload whole levels, one face after another, until the budget is spent
+    stats_.bytesThisFrame = 0;
+    while (!uploads_.empty() && (stats_.bytesThisFrame == 0 || stats_.bytesThisFrame < uploadBudget_)) {
+        Upload& upload = uploads_.front();
+        if (upload.id == 0) {
+            allocateStorage(upload);
+        } else {
+            glBindTexture(GL_TEXTURE_CUBE_MAP, upload.id);
+        }
+
+        const Face& face = upload.job->faces[upload.face];
+        const ImageLevel& level = face.levels[upload.level];
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + upload.face, static_cast<GLint>(upload.level), 0, 0,
+                        level.width, level.height, face.format, face.type, level.pixels.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        stats_.bytesThisFrame += level.pixels.size();
+
+        if (++upload.level == face.levels.size()) {
+            upload.level = 0;
+            if (++upload.face == 6) {
+                finish(upload);
+                uploads_.pop_front();
+                ++completed;
+            }
+        }
+    }
+    if (stats_.bytesThisFrame > 0) {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    }
+    updateCounts();
+    return completed;
+}
+
+void CubemapCache::finishAll() {
+    pool_.waitIdle();
+    size_t budget = uploadBudget_;
+    uploadBudget_ = static_cast<size_t>(-1);
+    update();
+    uploadBudget_ = budget;
+}
+
+void CubemapCache::allocateStorage(Upload& upload) {
+    const Face& face = upload.job->faces[0];
+    const int size = face.levels[0].width;
+    const GLsizei levels = static_cast<GLsizei>(face.levels.size());
+
+    glGenTextures(1, &upload.id);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, upload.id);
+    if (GLAD_GL_VERSION_4_2) {
+        glTexStorage2D(GL_TEXTURE_CUBE_MAP, levels, face.internalFormat, size, size);
+    } else {
+        // GL 3.3: define every face and level once up front; the storage is never respecified
+        for (int i = 0; i < 6; ++i) {
+            for (GLsizei level = 0; level < levels; ++level) {
+                int levelSize = std::max(1, size >> level);
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, face.internalFormat, levelSize, levelSize, 0,
+                             face.format, face.type, nullptr);
+            }
+        }
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    // Filter across face edges at every mip level instead of clamping per face
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+}
+
+void CubemapCache::finish(Upload& upload) {
+    size_t bytes = 0;
+    for (const Face& face : upload.job->faces) {
+        for (const ImageLevel& level : face.levels) bytes += level.pixels.size();
+    }
+
+    Entry& entry = entries_[upload.job->name];
+    entry.state = State::Ready;
+    entry.texture = upload.id;
+    entry.bytes = bytes;
+    entry.hdr = upload.job->hdr;
+    entry.irradiance = upload.job->irradiance;
+    upload.id = 0;
+    stats_.lastLoadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - upload.job->start).count();
+}
+
+void CubemapCache::fail(const std::string& name) {
+    entries_[name].state = State::Failed;
+}
+
+void CubemapCache::updateCounts() {
+    stats_.ready = stats_.pending = stats_.failed = 0;
+    stats_.gpuBytes = 0;
+    for (const auto& item : entries_) {
+        switch (item.second.state) {
+            case State::Ready:
+                ++stats_.ready;
+                stats_.gpuBytes += item.second.bytes;
+                break;
+            case State::Pending: ++stats_.pending; break;
+            case State::Failed: ++stats_.failed; break;
+            case State::Missing: break;
+        }
+    }
+}
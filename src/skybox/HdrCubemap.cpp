@@ -0,0 +1,310 @@
+/**
+ * @file HdrCubemap.cpp
+ * @brief Equirectangular HDR panorama to cubemap conversion with an on-disk cooked cache
+ */
+
+#include "skybox/HdrCubemap.h"
+#include "core/Parallel.h"
+#include "mesh/MeshKernels.h"
+#include "mesh/stb_image.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+namespace {
+
+// Bump when the conversion changes so cooked files are rebuilt
+const uint32_t kConverterVersion = 1;
+const char kMagic[8] = { 'H', 'D', 'R', 'C', 'U', 'B', 'E', '1' };
+const float kPi = 3.14159265358979323846f;
+const float kMaxHalf = 65504.0f;
+
+bool fail(std::string* error, const char* message) {
+    if (error) *error = message;
+    return false;
+}
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;   // FNV-1a
+    }
+    return hash;
+}
+
+void createDirectories(const std::string& path) {
+    for (size_t pos = 0; pos != std::string::npos;) {
+        pos = path.find_first_of("/\\", pos + 1);
+        std::string prefix = path.substr(0, pos);
+        if (prefix.empty()) continue;
+#ifdef _WIN32
+        _mkdir(prefix.c_str());
+#else
+        mkdir(prefix.c_str(), 0755);
+#endif
+    }
+}
+
+std::string getCacheFileName(const std::string& path, uint64_t key) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos) name = name.substr(0, dot);
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+    return name + "_" + hex + ".cube";
+}
+
+// Linear RGB floats to a half-float level (negative and out-of-range values clamped)
+ImageLevel toHalfLevel(const std::vector<float>& rgb, int size) {
+    ImageLevel level;
+    level.width = level.height = size;
+    level.pixels.resize(rgb.size() * sizeof(uint16_t));
+    uint16_t* out = reinterpret_cast<uint16_t*>(level.pixels.data());
+    for (size_t i = 0; i < rgb.size(); ++i) {
+        out[i] = MeshKernels::floatToHalf(std::min(std::max(rgb[i], 0.0f), kMaxHalf));
+    }
+    return level;
+}
+
+// 2x2 box average; odd edges reuse the last texel
+std::vector<float> downsample(const std::vector<float>& in, int size, int& outSize) {
+    outSize = std::max(1, size / 2);
+    std::vector<float> out(static_cast<size_t>(outSize) * outSize * 3);
+    for (int y = 0; y < outSize; ++y) {
+        int y0 = std::min(2 * y, size - 1);
+        int y1 = std::min(2 * y + 1, size - 1);
+        for (int x = 0; x < outSize; ++x) {
+            int x0 = std::min(2 * x, size - 1);
+            int x1 = std::min(2 * x + 1, size - 1);
+            for (int c = 0; c < 3; ++c) {
+                float sum = in[(static_cast<size_t>(y0) * size + x0) * 3 + c] +
+                            in[(static_cast<size_t>(y0) * size + x1) * 3 + c] +
+                            in[(static_cast<size_t>(y1) * size + x0) * 3 + c] +
+                            in[(static_cast<size_t>(y1) * size + x1) * 3 + c];
+                out[(static_cast<size_t>(y) * outSize + x) * 3 + c] = sum * 0.25f;
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+size_t HdrCubemapImage::getByteSize() const {
+    size_t bytes = 0;
+    for (const auto& face : faces) {
+        for (const ImageLevel& level : face) bytes += level.pixels.size();
+    }
+    return bytes;
+}
+
+namespace HdrCubemap {
+
+bool isHdrPath(const std::string& path) {
+    if (path.size() < 4) return false;
+    std::string ext = path.substr(path.size() - 4);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".hdr";
+}
+
+int getDefaultFaceSize(int panoramaWidth) {
+    return std::max(1, panoramaWidth / 4);
+}
+
+glm::vec3 getFaceDirection(int face, float s, float t) {
+    glm::vec3 dir;
+    switch (face) {
+        case 0: dir = glm::vec3( 1.0f,   -t,   -s); break;
+        case 1: dir = glm::vec3(-1.0f,   -t,    s); break;
+        case 2: dir = glm::vec3(    s, 1.0f,    t); break;
+        case 3: dir = glm::vec3(    s,-1.0f,   -t); break;
+        case 4: dir = glm::vec3(    s,   -t, 1.0f); break;
+        default: dir = glm::vec3(  -s,   -t,-1.0f); break;
+    }
+    return glm::normalize(dir);
+}
+
+glm::vec3 sampleEquirect(const float* pixels, int width, int height, int channels, const glm::vec3& dir) {
+    glm::vec3 d = glm::normalize(dir);
+    float u = 0.5f + std::atan2(d.z, d.x) / (2.0f * kPi);
+    float v = std::acos(std::min(std::max(d.y, -1.0f), 1.0f)) / kPi;
+
+    // Texel centres sit at half-integer coordinates
+    float x = u * width - 0.5f;
+    float y = v * height - 0.5f;
+    float fx0 = std::floor(x);
+    float fy0 = std::floor(y);
+    float fx = x - fx0;
+    float fy = y - fy0;
+    int x0 = static_cast<int>(fx0) % width;
+    if (x0 < 0) x0 += width;
+    int x1 = (x0 + 1) % width;
+    int y0 = std::min(std::max(static_cast<int>(fy0), 0), height - 1);
+    int y1 = std::min(std::max(static_cast<int>(fy0) + 1, 0), height - 1);
+
+    auto texel = [&](int tx, int ty) {
+        const float* p = pixels + (static_cast<size_t>(ty) * width + tx) * channels;
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+    glm::vec3 top = texel(x0, y0) * (1.0f - fx) + texel(x1, y0) * fx;
+    glm::vec3 bottom = texel(x0, y1) * (1.0f - fx) + texel(x1, y1) * fx;
+    return top * (1.0f - fy) + bottom * fy;
+}
+
+void convertEquirect(const float* pixels, int width, int height, int channels, int faceSize,
+                     std::vector<float> faces[6]) {
+    const size_t faceFloats = static_cast<size_t>(faceSize) * faceSize * 3;
+    for (int i = 0; i < 6; ++i) faces[i].assign(faceFloats, 0.0f);
+
+    // One work item per face row: all six faces share the worker threads
+    const float invSize = 2.0f / static_cast<float>(faceSize);
+    Parallel::forRange(static_cast<size_t>(faceSize) * 6, 8, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t row = begin; row < end; ++row) {
+            int face = static_cast<int>(row / faceSize);
+            int y = static_cast<int>(row % faceSize);
+            float t = (static_cast<float>(y) + 0.5f) * invSize - 1.0f;
+            float* out = &faces[face][static_cast<size_t>(y) * faceSize * 3];
+            for (int x = 0; x < faceSize; ++x, out += 3) {
+                float s = (static_cast<float>(x) + 0.5f) * invSize - 1.0f;
+                glm::vec3 color = sampleEquirect(pixels, width, height, channels, getFaceDirection(face, s, t));
+                out[0] = color.r;
+                out[1] = color.g;
+                out[2] = color.b;
+            }
+        }
+    });
+}
+
+void buildMipChain(const std::vector<float> faces[6], int faceSize, HdrCubemapImage& out) {
+    Parallel::forRange(6, 1, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t face = begin; face < end; ++face) {
+            std::vector<ImageLevel>& levels = out.faces[face];
+            levels.clear();
+            levels.push_back(toHalfLevel(faces[face], faceSize));
+            std::vector<float> current = faces[face];
+            int size = faceSize;
+            while (size > 1) {
+                current = downsample(current, size, size);
+                levels.push_back(toHalfLevel(current, size));
+            }
+        }
+    });
+}
+
+bool save(const std::string& path, const HdrCubemapImage& image) {
+    if (image.empty()) return false;
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    uint32_t header[2] = { static_cast<uint32_t>(image.getSize()), static_cast<uint32_t>(image.getLevelCount()) };
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for (const auto& face : image.faces) {
+        for (const ImageLevel& level : face) {
+            file.write(reinterpret_cast<const char*>(level.pixels.data()), static_cast<std::streamsize>(level.pixels.size()));
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+bool load(const std::string& path, HdrCubemapImage& image) {
+    image = HdrCubemapImage();
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    char magic[8];
+    uint32_t header[2];
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    const int size = static_cast<int>(header[0]);
+    const size_t levelCount = header[1];
+    if (size <= 0 || size > 65536 || levelCount != static_cast<size_t>(ImageKernels::getMipLevelCount(size, size))) {
+        return false;
+    }
+
+    for (auto& face : image.faces) {
+        int levelSize = size;
+        for (size_t i = 0; i < levelCount; ++i, levelSize = std::max(1, levelSize / 2)) {
+            ImageLevel level;
+            level.width = level.height = levelSize;
+            level.pixels.resize(static_cast<size_t>(levelSize) * levelSize * HdrCubemapImage::BytesPerTexel);
+            if (!file.read(reinterpret_cast<char*>(level.pixels.data()), static_cast<std::streamsize>(level.pixels.size()))) {
+                image = HdrCubemapImage();
+                return false;
+            }
+            face.push_back(std::move(level));
+        }
+    }
+    return true;
+}
+
+bool loadOrConvert(const std::string& path, const std::string& cacheDirectory, int faceSize,
+                   HdrCubemapImage& out, bool* fromCache, std::string* error) {
+    out = HdrCubemapImage();
+    if (fromCache) *fromCache = false;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return fail(error, "failed to open file");
+    }
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    int width;
+    int height;
+    int channels;
+    if (!stbi_info_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels)) {
+        return fail(error, "failed to read image header");
+    }
+    if (faceSize <= 0) faceSize = getDefaultFaceSize(width);
+
+    std::string cachePath;
+    if (!cacheDirectory.empty()) {
+        uint64_t key = hashBytes(14695981039346656037ull, bytes.data(), bytes.size());
+        const uint32_t settings[2] = { kConverterVersion, static_cast<uint32_t>(faceSize) };
+        key = hashBytes(key, settings, sizeof(settings));
+        cachePath = cacheDirectory + "/" + getCacheFileName(path, key);
+        if (load(cachePath, out) && out.getSize() == faceSize) {
+            if (fromCache) *fromCache = true;
+            return true;
+        }
+    }
+
+    std::unique_ptr<float, void (*)(void*)> pixels(
+        stbi_loadf_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels, 3),
+        stbi_image_free);
+    if (!pixels) {
+        return fail(error, "failed to decode image");
+    }
+
+    std::vector<float> faces[6];
+    convertEquirect(pixels.get(), width, height, 3, faceSize, faces);
+    buildMipChain(faces, faceSize, out);
+
+    // Write to a temporary file first so concurrent loaders never read a partial cache
+    if (!cachePath.empty()) {
+        static std::atomic<unsigned> counter(0);
+        createDirectories(cacheDirectory);
+        std::string tempPath = cachePath + ".tmp" + std::to_string(counter++);
+        if (!save(tempPath, out) || std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+            std::remove(tempPath.c_str());
+        }
+    }
+    return true;
+}
+
+} // namespace HdrCubemap
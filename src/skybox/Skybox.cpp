@@ -4,30 +4,36 @@
  */
 
 #include "skybox/Skybox.h"
+#include "skybox/HdrCubemap.h"
 #include "shader/Shader.h"
+#include "core/GLState.h"
+#include "core/Parallel.h"
+#include <algorithm>
 #include <iostream>
-#include <stb_image.h>
 
 Skybox::Skybox()
     : vao_(0)
     , vbo_(0)
     , cubemapTexture_(0)
+    // One decode thread per face at most
+    , cache_(std::min(6u, Parallel::getMaxWorkers()))
     , enabled_(true)
     , yaw_(0.0f)
-    , pitch_(0.0f) {
+    , pitch_(0.0f)
+    , exposure_(1.0f) {
 }
 
 Skybox::~Skybox() {
-    if (vao_ != 0) glDeleteVertexArrays(1, &vao_);
+    GLState::deleteVertexArray(vao_);
     if (vbo_ != 0) glDeleteBuffers(1, &vbo_);
-    if (cubemapTexture_ != 0) glDeleteTextures(1, &cubemapTexture_);
 }
 
 bool Skybox::initialize() {
-    std::shared_ptr<CShader> shader = std::make_shared<CShader>(
+    // Compiled once; render() only binds it
+    shader_ = std::unique_ptr<CShader>(new CShader(
         std::string("resources/shaders/skybox.vs"),
         std::string("resources/shaders/skybox.fs")
-    );
+    ));
     
     if (!createBuffers()) {
         return false;
@@ -73,52 +79,68 @@ bool Skybox::createBuffers() {
     glGenVertexArrays(1, &vao_);
     glGenBuffers(1, &vbo_);
     
-    glBindVertexArray(vao_);
+    GLState::bindVertexArray(vao_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
     
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
     return true;
 }
 
 bool Skybox::loadCubemap(const std::vector<std::string>& faces) {
-    if (faces.size() != 6) {
-        std::cerr << "Cubemap requires exactly 6 faces" << std::endl;
+    if (faces.size() != 6 && !(faces.size() == 1 && HdrCubemap::isHdrPath(faces[0]))) {
+        std::cerr << "Cubemap requires exactly 6 faces or one .hdr panorama" << std::endl;
         return false;
     }
     
-    glGenTextures(1, &cubemapTexture_);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture_);
+    // Cache key: the face paths themselves
+    std::string name;
+    for (const std::string& face : faces) name += face + ";";
     
-    // Set texture parameters
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    
-    // Load each face
-    for (int i = 0; i < 6; ++i) {
-        int width, height, channels;
-        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &channels, 0);
-        
-        if (!data) {
-            std::cerr << "Failed to load skybox face: " << faces[i] << std::endl;
-            continue;
-        }
-        
-        GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-        GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + i;
-        
-        glTexImage2D(target, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        stbi_image_free(data);
+    requestCubemap(name, faces);
+    cache_.finishAll();
+    update();
+    return currentName_ == name;
+}
+
+void Skybox::requestCubemap(const std::string& name, const std::vector<std::string>& faces) {
+    if (name == currentName_) {
+        pendingName_.clear();
+        return;
     }
     
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-    return true;
+    CubemapCache::State state = cache_.request(name, faces);
+    if (state == CubemapCache::State::Failed) {
+        std::cerr << "Skybox '" << name << "' is unavailable, keeping the current one" << std::endl;
+        pendingName_.clear();
+        return;
+    }
+    pendingName_ = name;
+    if (state == CubemapCache::State::Ready) {
+        update();
+    }
+}
+
+void Skybox::update() {
+    cache_.update();
+    if (pendingName_.empty()) return;
+    
+    switch (cache_.getState(pendingName_)) {
+        case CubemapCache::State::Ready:
+            cubemapTexture_ = cache_.getTexture(pendingName_);
+            currentName_ = pendingName_;
+            pendingName_.clear();
+            break;
+        case CubemapCache::State::Failed:
+            std::cerr << "Skybox '" << pendingName_ << "' is unavailable, keeping the current one" << std::endl;
+            pendingName_.clear();
+            break;
+        default:
+            break;
+    }
 }
 
 void Skybox::setRotation(float yaw, float pitch) {
@@ -127,30 +149,27 @@ void Skybox::setRotation(float yaw, float pitch) {
 }
 
 void Skybox::render(const glm::mat4& view, const glm::mat4& projection) {
-    if (!enabled_ || cubemapTexture_ == 0) return;
+    if (!enabled_ || cubemapTexture_ == 0 || !shader_) return;
     
-    // Load shader
-    std::shared_ptr<CShader> shader = std::make_shared<CShader>(
-        std::string("resources/shaders/skybox.vs"),
-        std::string("resources/shaders/skybox.fs")
-    );
-    shader->use();
+    shader_->use();
     
-    shader->setMat4("view", view);
-    shader->setMat4("projection", projection);
+    shader_->setMat4("view", view);
+    shader_->setMat4("projection", projection);
     
     // Bind skybox cubemap
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture_);
-    shader->setInt("skybox", 0);
+    shader_->setInt("skybox", 0);
+    shader_->setBool("hdr", cache_.isHdr(currentName_));
+    shader_->setFloat("exposure", exposure_);
     
     // Disable depth writing (render at far plane)
     glDepthMask(GL_FALSE);
     
     // Render skybox cube
-    glBindVertexArray(vao_);
+    GLState::bindVertexArray(vao_);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
     
     // Restore depth writing
     glDepthMask(GL_TRUE);
@@ -208,4 +227,9 @@ std::vector<std::string> createCloudy() {
     };
 }
 
+std::vector<std::string> createPanorama(const std::string& path) {
+    // Equirectangular .hdr image, converted to a cubemap on load
+    return { path };
+}
+
 } // namespace SkyboxPresets
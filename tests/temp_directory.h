@@ -0,0 +1,101 @@
+/**
+ * @file temp_directory.h
+ * @brief Unique scratch directory for tests that write files, removed with everything in it
+ */
+
+#ifndef TEST_TEMP_DIRECTORY_H
+#define TEST_TEMP_DIRECTORY_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief 在系统临时目录下创建唯一的目录，析构时递归删除
+ *
+ * 缓存类测试要求「第一次调用不命中缓存」，写进工作目录的缓存会让同一目录下的第二次运行失败。
+ */
+class TempDirectory {
+public:
+    explicit TempDirectory(const std::string& prefix) {
+#ifdef _WIN32
+        char base[MAX_PATH + 1];
+        DWORD length = GetTempPathA(sizeof(base), base);
+        std::string root = length > 0 ? std::string(base, length) : std::string(".\\");
+        for (unsigned int attempt = 0; attempt < 1000 && path_.empty(); ++attempt) {
+            std::string candidate = root + prefix + "_" + std::to_string(GetCurrentProcessId()) +
+                                    "_" + std::to_string(attempt);
+            if (_mkdir(candidate.c_str()) == 0) path_ = candidate;
+        }
+#else
+        const char* base = std::getenv("TMPDIR");
+        std::string pattern = std::string(base && *base ? base : "/tmp") + "/" + prefix + "_XXXXXX";
+        std::vector<char> buffer(pattern.begin(), pattern.end());
+        buffer.push_back('\0');
+        if (mkdtemp(buffer.data())) path_ = buffer.data();
+#endif
+    }
+
+    ~TempDirectory() {
+        if (!path_.empty()) removeRecursive(path_);
+    }
+
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    bool isValid() const { return !path_.empty(); }
+    const std::string& getPath() const { return path_; }
+    std::string file(const std::string& name) const { return path_ + "/" + name; }
+
+private:
+    std::string path_;
+
+    static void removeRecursive(const std::string& path) {
+#ifdef _WIN32
+        WIN32_FIND_DATAA entry;
+        HANDLE find = FindFirstFileA((path + "\\*").c_str(), &entry);
+        if (find != INVALID_HANDLE_VALUE) {
+            do {
+                std::string name = entry.cFileName;
+                if (name == "." || name == "..") continue;
+                std::string child = path + "\\" + name;
+                if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                    removeRecursive(child);
+                } else {
+                    std::remove(child.c_str());
+                }
+            } while (FindNextFileA(find, &entry));
+            FindClose(find);
+        }
+        _rmdir(path.c_str());
+#else
+        if (DIR* dir = opendir(path.c_str())) {
+            while (dirent* entry = readdir(dir)) {
+                std::string name = entry->d_name;
+                if (name == "." || name == "..") continue;
+                std::string child = path + "/" + name;
+                struct stat info;
+                if (lstat(child.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+                    removeRecursive(child);
+                } else {
+                    std::remove(child.c_str());
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(path.c_str());
+#endif
+    }
+};
+
+#endif // TEST_TEMP_DIRECTORY_H
@@ -0,0 +1,104 @@
+/**
+ * @file test_cubemap_cache.cpp
+ * @brief Unit tests for asynchronous cubemap decoding, caching and failure handling
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "skybox/CubemapCache.h"
+
+namespace {
+
+// 写一个 size x size 的二进制 PPM（RGB）
+std::string writePPM(const std::string& name, int size, unsigned char value) {
+    std::ofstream file(name, std::ios::binary);
+    file << "P6\n" << size << " " << size << "\n255\n";
+    std::vector<unsigned char> pixels(static_cast<size_t>(size) * size * 3, value);
+    file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+    return name;
+}
+
+std::vector<std::string> writeFaces(const std::string& prefix, int size) {
+    std::vector<std::string> faces;
+    for (int i = 0; i < 6; ++i) {
+        faces.push_back(writePPM(prefix + std::to_string(i) + ".ppm", size, static_cast<unsigned char>(i * 40)));
+    }
+    return faces;
+}
+
+void removeFaces(const std::vector<std::string>& faces) {
+    for (const std::string& face : faces) std::remove(face.c_str());
+}
+
+} // namespace
+
+TEST(CubemapCacheTest, RejectsWrongFaceCount) {
+    CubemapCache cache(1);
+    EXPECT_EQ(cache.getState("sky"), CubemapCache::State::Missing);
+    EXPECT_EQ(cache.request("sky", { "a.png", "b.png" }), CubemapCache::State::Failed);
+    EXPECT_EQ(cache.request("sky", { "a.png", "b.png" }), CubemapCache::State::Failed);
+    EXPECT_EQ(cache.getStats().hits, 1u);
+    EXPECT_EQ(cache.getStats().failed, 1u);
+    EXPECT_EQ(cache.getTexture("sky"), 0u);
+}
+
+TEST(CubemapCacheTest, MissingFacesFailWithoutBlocking) {
+    CubemapCache cache(2);
+    std::vector<std::string> faces;
+    for (int i = 0; i < 6; ++i) faces.push_back("missing_cubemap_face_" + std::to_string(i) + ".jpg");
+
+    EXPECT_EQ(cache.request("night", faces), CubemapCache::State::Pending);
+    EXPECT_EQ(cache.getStats().pending, 1u);
+    cache.finishAll();
+    EXPECT_EQ(cache.getState("night"), CubemapCache::State::Failed);
+    EXPECT_EQ(cache.getTexture("night"), 0u);
+
+    // 记为失败，不再重新解码
+    EXPECT_EQ(cache.request("night", faces), CubemapCache::State::Failed);
+    EXPECT_EQ(cache.getStats().hits, 1u);
+    EXPECT_EQ(cache.getStats().pending, 0u);
+}
+
+// 需要 OpenGL 上下文
+TEST(CubemapCacheTest, DISABLED_UploadsWithinBudgetAndCaches) {
+    std::vector<std::string> faces = writeFaces("test_cubemap_face", 16);
+    CubemapCache cache(2, 1);
+
+    ASSERT_EQ(cache.request("day", faces), CubemapCache::State::Pending);
+    cache.finishAll();
+    EXPECT_EQ(cache.getState("day"), CubemapCache::State::Ready);
+    EXPECT_NE(cache.getTexture("day"), 0u);
+    // RGB 按 RGBA 上传，完整 mip 链 16x16 到 1x1
+    EXPECT_EQ(cache.getStats().gpuBytes, 6u * 4u * (256u + 64u + 16u + 4u + 1u));
+
+    // 预算 1 字节时每次 update() 上传一个级别：6 个面 x 5 级
+    std::vector<std::string> other = writeFaces("test_cubemap_other", 16);
+    ASSERT_EQ(cache.request("dusk", other), CubemapCache::State::Pending);
+    int updates = 0;
+    while (cache.getState("dusk") == CubemapCache::State::Pending && updates < 1000) {
+        if (cache.update() == 0 && cache.getStats().bytesThisFrame == 0) continue;
+        ++updates;
+    }
+    EXPECT_EQ(cache.getState("dusk"), CubemapCache::State::Ready);
+    EXPECT_EQ(updates, 30);
+
+    // 已缓存，不再解码
+    EXPECT_EQ(cache.request("day", faces), CubemapCache::State::Ready);
+    EXPECT_EQ(cache.getStats().ready, 2u);
+    EXPECT_EQ(cache.getStats().hits, 1u);
+    removeFaces(faces);
+    removeFaces(other);
+}
+
+TEST(CubemapCacheTest, MismatchedFacesFail) {
+    std::vector<std::string> faces = writeFaces("test_cubemap_mismatch", 16);
+    writePPM(faces[3], 8, 0);
+    CubemapCache cache(2);
+    cache.request("broken", faces);
+    cache.finishAll();
+    EXPECT_EQ(cache.getState("broken"), CubemapCache::State::Failed);
+    removeFaces(faces);
+}
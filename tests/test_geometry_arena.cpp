@@ -0,0 +1,109 @@
+/**
+ * @file test_geometry_arena.cpp
+ * @brief Unit tests for GeometryArena and its free-list bookkeeping
+ */
+
+#include <gtest/gtest.h>
+#include "core/GLState.h"
+#include "mesh/GeometryArena.h"
+
+TEST(FreeListAllocatorTest, FirstFitAllocatesFromTheFront) {
+    FreeListAllocator allocator(100);
+
+    EXPECT_EQ(allocator.allocate(10), 0u);
+    EXPECT_EQ(allocator.allocate(20), 10u);
+    EXPECT_EQ(allocator.allocate(30), 30u);
+    EXPECT_EQ(allocator.getUsed(), 60u);
+    EXPECT_EQ(allocator.getFreeBlockCount(), 1u);
+}
+
+TEST(FreeListAllocatorTest, FailsWhenNoBlockIsLargeEnough) {
+    FreeListAllocator allocator(64);
+    EXPECT_EQ(allocator.allocate(0), FreeListAllocator::InvalidOffset);
+    EXPECT_EQ(allocator.allocate(65), FreeListAllocator::InvalidOffset);
+    EXPECT_EQ(allocator.allocate(64), 0u);
+    EXPECT_EQ(allocator.allocate(1), FreeListAllocator::InvalidOffset);
+}
+
+TEST(FreeListAllocatorTest, FreeCoalescesNeighbours) {
+    FreeListAllocator allocator(30);
+    size_t a = allocator.allocate(10);
+    size_t b = allocator.allocate(10);
+    size_t c = allocator.allocate(10);
+
+    allocator.free(a);
+    allocator.free(c);
+    EXPECT_EQ(allocator.getFreeBlockCount(), 2u);
+    EXPECT_EQ(allocator.getLargestFreeBlock(), 10u);
+
+    // 释放中间块后三块合并成一整块
+    allocator.free(b);
+    EXPECT_EQ(allocator.getFreeBlockCount(), 1u);
+    EXPECT_EQ(allocator.getLargestFreeBlock(), 30u);
+    EXPECT_EQ(allocator.getUsed(), 0u);
+}
+
+TEST(FreeListAllocatorTest, FreeOfUnknownOffsetIsIgnored) {
+    FreeListAllocator allocator(16);
+    allocator.allocate(8);
+    allocator.free(3);
+    EXPECT_EQ(allocator.getUsed(), 8u);
+}
+
+TEST(FreeListAllocatorTest, FragmentationAndCompaction) {
+    FreeListAllocator allocator(40);
+    size_t offsets[4];
+    for (size_t& offset : offsets) {
+        offset = allocator.allocate(10);
+    }
+    allocator.free(offsets[0]);
+    allocator.free(offsets[2]);
+
+    // 两个 10 的空闲块，最大只有一半
+    EXPECT_FLOAT_EQ(allocator.getFragmentation(), 0.5f);
+    EXPECT_EQ(allocator.allocate(20), FreeListAllocator::InvalidOffset);
+
+    std::vector<FreeListAllocator::Move> moves = allocator.compact();
+    ASSERT_EQ(moves.size(), 2u);
+    EXPECT_EQ(moves[0].from, 10u);
+    EXPECT_EQ(moves[0].to, 0u);
+    EXPECT_EQ(moves[1].from, 30u);
+    EXPECT_EQ(moves[1].to, 10u);
+
+    EXPECT_FLOAT_EQ(allocator.getFragmentation(), 0.0f);
+    EXPECT_EQ(allocator.allocate(20), 20u);
+}
+
+TEST(FreeListAllocatorTest, GrowExtendsTrailingFreeBlock) {
+    FreeListAllocator allocator(10);
+    allocator.allocate(6);
+    allocator.grow(20);
+
+    EXPECT_EQ(allocator.getCapacity(), 20u);
+    EXPECT_EQ(allocator.getFreeBlockCount(), 1u);
+    EXPECT_EQ(allocator.allocate(14), 6u);
+
+    // 满的时候扩容，新空间单独成块
+    allocator.grow(25);
+    EXPECT_EQ(allocator.allocate(5), 20u);
+}
+
+// 需要 OpenGL 上下文
+TEST(GeometryArenaTest, DISABLED_ConsecutiveDrawsBindPoolOnce) {
+    GeometryArena arena(64, 64);
+    VertexAttributeLayout layout = VertexAttributeLayout::Quantized();
+    GeometryArena::Handle a = arena.allocate(layout, 3, 3);
+    GeometryArena::Handle b = arena.allocate(layout, 3, 3);
+    ASSERT_TRUE(arena.isValid(a));
+    ASSERT_TRUE(arena.isValid(b));
+
+    GLState::invalidate();
+    GLState::resetBindCount();
+    arena.draw(a, GL_TRIANGLES);
+    arena.draw(b, GL_TRIANGLES);
+    arena.drawMulti({ a, b, a }, GL_TRIANGLES);
+
+    // 同一布局共用一个 VAO，绘制后不解绑
+    EXPECT_EQ(GLState::getBindCount(), 1u);
+    EXPECT_NE(GLState::getBoundVertexArray(), 0u);
+}
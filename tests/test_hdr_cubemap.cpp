@@ -0,0 +1,193 @@
+/**
+ * @file test_hdr_cubemap.cpp
+ * @brief Unit tests for equirectangular HDR to cubemap conversion and the cooked cache
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "skybox/HdrCubemap.h"
+#include "skybox/CubemapCache.h"
+#include "mesh/MeshKernels.h"
+#include "temp_directory.h"
+
+namespace {
+
+float halfAt(const ImageLevel& level, size_t index) {
+    return MeshKernels::halfToFloat(reinterpret_cast<const uint16_t*>(level.pixels.data())[index]);
+}
+
+// 写一个未压缩的 Radiance RGBE 文件（宽度 < 8 时 stb 按平铺像素读取）
+std::string writeHdr(const std::string& name, int width, int height, float value) {
+    std::ofstream file(name, std::ios::binary);
+    file << "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y " << height << " +X " << width << "\n";
+    int exponent;
+    float mantissa = std::frexp(value, &exponent) * 256.0f;
+    unsigned char m = static_cast<unsigned char>(mantissa);
+    unsigned char texel[4] = { m, m, m, static_cast<unsigned char>(exponent + 128) };
+    for (int i = 0; i < width * height; ++i) file.write(reinterpret_cast<const char*>(texel), 4);
+    return name;
+}
+
+} // namespace
+
+TEST(HdrCubemapTest, DetectsHdrPaths) {
+    EXPECT_TRUE(HdrCubemap::isHdrPath("sky/studio.hdr"));
+    EXPECT_TRUE(HdrCubemap::isHdrPath("STUDIO.HDR"));
+    EXPECT_FALSE(HdrCubemap::isHdrPath("right.jpg"));
+    EXPECT_FALSE(HdrCubemap::isHdrPath("hdr"));
+    EXPECT_EQ(HdrCubemap::getDefaultFaceSize(2048), 512);
+    EXPECT_EQ(HdrCubemap::getDefaultFaceSize(2), 1);
+}
+
+TEST(HdrCubemapTest, FaceCentresPointAlongAxes) {
+    const glm::vec3 axes[6] = {
+        glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0),
+        glm::vec3(0, -1, 0), glm::vec3(0, 0, 1), glm::vec3(0, 0, -1)
+    };
+    for (int face = 0; face < 6; ++face) {
+        glm::vec3 dir = HdrCubemap::getFaceDirection(face, 0.0f, 0.0f);
+        EXPECT_NEAR(dir.x, axes[face].x, 1e-6f);
+        EXPECT_NEAR(dir.y, axes[face].y, 1e-6f);
+        EXPECT_NEAR(dir.z, axes[face].z, 1e-6f);
+    }
+
+    // 侧面的第一行（t = -1）朝上
+    EXPECT_GT(HdrCubemap::getFaceDirection(0, 0.0f, -1.0f).y, 0.0f);
+    EXPECT_GT(HdrCubemap::getFaceDirection(4, 0.0f, -1.0f).y, 0.0f);
+    EXPECT_NEAR(glm::length(HdrCubemap::getFaceDirection(2, 1.0f, 1.0f)), 1.0f, 1e-5f);
+}
+
+TEST(HdrCubemapTest, SamplesPanoramaByDirection) {
+    // 4x2 全景：上半行为 1，下半行为 5
+    const int width = 4, height = 2;
+    std::vector<float> pixels(width * height * 3);
+    for (int i = 0; i < width * height; ++i) {
+        float value = i < width ? 1.0f : 5.0f;
+        for (int c = 0; c < 3; ++c) pixels[i * 3 + c] = value;
+    }
+
+    EXPECT_NEAR(HdrCubemap::sampleEquirect(pixels.data(), width, height, 3, glm::vec3(0, 1, 0)).r, 1.0f, 1e-5f);
+    EXPECT_NEAR(HdrCubemap::sampleEquirect(pixels.data(), width, height, 3, glm::vec3(0, -1, 0)).g, 5.0f, 1e-5f);
+    // 地平线在两行之间
+    EXPECT_NEAR(HdrCubemap::sampleEquirect(pixels.data(), width, height, 3, glm::vec3(1, 0, 0)).b, 3.0f, 1e-5f);
+    // 未归一化方向同样可用
+    EXPECT_NEAR(HdrCubemap::sampleEquirect(pixels.data(), width, height, 3, glm::vec3(0, 4, 0)).r, 1.0f, 1e-5f);
+}
+
+TEST(HdrCubemapTest, ConstantPanoramaGivesConstantFaces) {
+    const int width = 16, height = 8;
+    std::vector<float> pixels(width * height * 4, 2.5f);
+    std::vector<float> faces[6];
+    HdrCubemap::convertEquirect(pixels.data(), width, height, 4, 8, faces);
+
+    for (int face = 0; face < 6; ++face) {
+        ASSERT_EQ(faces[face].size(), 8u * 8u * 3u);
+        for (float value : faces[face]) EXPECT_NEAR(value, 2.5f, 1e-5f);
+    }
+}
+
+TEST(HdrCubemapTest, BuildsHalfFloatMipChain) {
+    std::vector<float> faces[6];
+    for (int face = 0; face < 6; ++face) {
+        faces[face].resize(4 * 4 * 3);
+        for (size_t i = 0; i < faces[face].size(); ++i) {
+            faces[face][i] = static_cast<float>((i / 3) % 2) * 4.0f;   // 0、4 交替的列
+        }
+    }
+    faces[2][0] = 1.0e6f;   // 超出 half 范围
+    faces[3][0] = -1.0f;
+
+    HdrCubemapImage image;
+    HdrCubemap::buildMipChain(faces, 4, image);
+    ASSERT_EQ(image.getSize(), 4);
+    ASSERT_EQ(image.getLevelCount(), 3u);
+    EXPECT_EQ(image.faces[5][1].width, 2);
+    EXPECT_EQ(image.faces[5][2].width, 1);
+    EXPECT_EQ(image.faces[0][0].pixels.size(), 4u * 4u * HdrCubemapImage::BytesPerTexel);
+    EXPECT_EQ(image.getByteSize(), 6u * HdrCubemapImage::BytesPerTexel * (16u + 4u + 1u));
+
+    EXPECT_FLOAT_EQ(halfAt(image.faces[0][0], 3), 4.0f);
+    EXPECT_FLOAT_EQ(halfAt(image.faces[0][1], 0), 2.0f);
+    EXPECT_FLOAT_EQ(halfAt(image.faces[0][2], 1), 2.0f);
+    EXPECT_FLOAT_EQ(halfAt(image.faces[2][0], 0), 65504.0f);
+    EXPECT_FLOAT_EQ(halfAt(image.faces[3][0], 0), 0.0f);
+}
+
+TEST(HdrCubemapTest, SaveLoadRoundTrip) {
+    std::vector<float> faces[6];
+    for (int face = 0; face < 6; ++face) faces[face].assign(8 * 8 * 3, static_cast<float>(face) + 0.5f);
+    HdrCubemapImage image;
+    HdrCubemap::buildMipChain(faces, 8, image);
+
+    ASSERT_TRUE(HdrCubemap::save("test_hdr_roundtrip.cube", image));
+    HdrCubemapImage loaded;
+    ASSERT_TRUE(HdrCubemap::load("test_hdr_roundtrip.cube", loaded));
+    for (int face = 0; face < 6; ++face) {
+        ASSERT_EQ(loaded.faces[face].size(), image.faces[face].size());
+        for (size_t level = 0; level < image.faces[face].size(); ++level) {
+            EXPECT_EQ(loaded.faces[face][level].pixels, image.faces[face][level].pixels);
+        }
+    }
+
+    // 截断的文件被拒绝
+    {
+        std::ofstream file("test_hdr_roundtrip.cube", std::ios::binary);
+        file.write("HDRCUBE1", 8);
+    }
+    EXPECT_FALSE(HdrCubemap::load("test_hdr_roundtrip.cube", loaded));
+    EXPECT_TRUE(loaded.empty());
+    std::remove("test_hdr_roundtrip.cube");
+}
+
+TEST(HdrCubemapTest, LoadOrConvertReusesCookedCubemap) {
+    TempDirectory temp("test_hdr_cache");
+    ASSERT_TRUE(temp.isValid());
+    const std::string panorama = writeHdr(temp.file("panorama.hdr"), 4, 2, 2.0f);
+    const std::string directory = temp.file("cooked");
+
+    HdrCubemapImage image;
+    bool fromCache = true;
+    std::string error;
+    ASSERT_TRUE(HdrCubemap::loadOrConvert(panorama, directory, 0, image, &fromCache, &error)) << error;
+    EXPECT_FALSE(fromCache);
+    EXPECT_EQ(image.getSize(), 1);
+    EXPECT_NEAR(halfAt(image.faces[4][0], 0), 2.0f, 1e-3f);
+
+    HdrCubemapImage cached;
+    ASSERT_TRUE(HdrCubemap::loadOrConvert(panorama, directory, 0, cached, &fromCache));
+    EXPECT_TRUE(fromCache);
+    EXPECT_EQ(cached.faces[4][0].pixels, image.faces[4][0].pixels);
+
+    // 面尺寸不同则重新转换
+    ASSERT_TRUE(HdrCubemap::loadOrConvert(panorama, directory, 2, cached, &fromCache));
+    EXPECT_FALSE(fromCache);
+    EXPECT_EQ(cached.getSize(), 2);
+
+    EXPECT_FALSE(HdrCubemap::loadOrConvert("missing_panorama.hdr", directory, 0, image, nullptr, &error));
+    EXPECT_FALSE(error.empty());
+}
+
+// 需要 OpenGL 上下文
+TEST(HdrCubemapTest, DISABLED_CacheUploadsPanoramaAsHalfFloat) {
+    writeHdr("test_hdr_sky.hdr", 8, 4, 1.0f);
+    CubemapCache cache(1);
+    cache.setHdrCacheDirectory("");
+
+    ASSERT_EQ(cache.request("studio", { "test_hdr_sky.hdr" }), CubemapCache::State::Pending);
+    cache.finishAll();
+    EXPECT_EQ(cache.getState("studio"), CubemapCache::State::Ready);
+    EXPECT_TRUE(cache.isHdr("studio"));
+    // 2x2 面：RGB16F 每像素 6 字节，两级 mip
+    EXPECT_EQ(cache.getStats().gpuBytes, 6u * 6u * (4u + 1u));
+
+    // 均匀环境的辐照度 / pi 等于环境亮度
+    SHCoefficients irradiance;
+    ASSERT_TRUE(cache.getIrradiance("studio", irradiance));
+    EXPECT_NEAR(SphericalHarmonics::evaluate(irradiance, glm::vec3(0, 1, 0)).g, 1.0f, 1e-2f);
+    EXPECT_FALSE(cache.getIrradiance("missing", irradiance));
+    std::remove("test_hdr_sky.hdr");
+}
@@ -0,0 +1,234 @@
+/**
+ * @file test_image_kernels.cpp
+ * @brief Unit tests for ImageKernels (mip downsampling and pixel conversion at every SIMD level supported by the host CPU)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "core/Parallel.h"
+#include "mesh/ImageKernels.h"
+
+namespace {
+
+std::vector<unsigned char> randomPixels(size_t bytes, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<unsigned char> pixels(bytes);
+    for (auto& p : pixels) p = static_cast<unsigned char>(dist(rng));
+    return pixels;
+}
+
+ImageLevel makeLevel(int width, int height, int channels, unsigned int seed) {
+    ImageLevel level;
+    level.width = width;
+    level.height = height;
+    level.pixels = randomPixels(static_cast<size_t>(width) * height * channels, seed);
+    return level;
+}
+
+int maxDifference(const std::vector<ImageLevel>& a, const std::vector<ImageLevel>& b) {
+    int diff = 0;
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+        for (size_t j = 0; j < a[i].pixels.size(); ++j) {
+            diff = std::max(diff, std::abs(a[i].pixels[j] - b[i].pixels[j]));
+        }
+    }
+    return diff;
+}
+
+// 依次切换到主机支持的每个级别，测试结束恢复自动检测的级别
+class ImageKernelsTest : public ::testing::TestWithParam<ImageKernels::SimdLevel> {
+protected:
+    void SetUp() override {
+        if (GetParam() > MeshKernels::getDetectedLevel()) {
+            GTEST_SKIP() << MeshKernels::getLevelName(GetParam()) << " not supported on this CPU";
+        }
+        ImageKernels::setActiveLevel(GetParam());
+    }
+
+    void TearDown() override {
+        ImageKernels::setActiveLevel(MeshKernels::getDetectedLevel());
+    }
+};
+
+} // namespace
+
+TEST_P(ImageKernelsTest, ExpandsRGBForOddCounts) {
+    const size_t counts[] = { 1, 5, 6, 9, 10, 17, 1001 };
+    for (size_t count : counts) {
+        std::vector<unsigned char> rgb = randomPixels(count * 3, static_cast<unsigned int>(count));
+        std::vector<unsigned char> rgba(count * 4, 0);
+        ImageKernels::expandRGBToRGBA(rgb.data(), rgba.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(rgba[i * 4 + 0], rgb[i * 3 + 0]) << "count " << count << ", pixel " << i;
+            ASSERT_EQ(rgba[i * 4 + 1], rgb[i * 3 + 1]);
+            ASSERT_EQ(rgba[i * 4 + 2], rgb[i * 3 + 2]);
+            ASSERT_EQ(rgba[i * 4 + 3], 255);
+        }
+    }
+}
+
+TEST_P(ImageKernelsTest, PremultipliesWithExactRounding) {
+    // 全部 (c, a) 组合，原地处理
+    std::vector<unsigned char> pixels(256 * 256 * 4);
+    for (int c = 0; c < 256; ++c) {
+        for (int a = 0; a < 256; ++a) {
+            unsigned char* p = &pixels[static_cast<size_t>(c * 256 + a) * 4];
+            p[0] = static_cast<unsigned char>(c);
+            p[1] = static_cast<unsigned char>(255 - c);
+            p[2] = static_cast<unsigned char>(c / 2);
+            p[3] = static_cast<unsigned char>(a);
+        }
+    }
+    std::vector<unsigned char> source = pixels;
+    ImageKernels::premultiplyAlpha(pixels.data(), pixels.data(), 256 * 256);
+    for (size_t i = 0; i < 256 * 256; ++i) {
+        int a = source[i * 4 + 3];
+        for (int k = 0; k < 3; ++k) {
+            int expected = static_cast<int>(std::floor(source[i * 4 + k] * a / 255.0 + 0.5));
+            ASSERT_EQ(pixels[i * 4 + k], expected) << "pixel " << i;
+        }
+        ASSERT_EQ(pixels[i * 4 + 3], a);
+    }
+}
+
+TEST_P(ImageKernelsTest, SwizzlesChannelsAndConstants) {
+    const size_t count = 37;
+    std::vector<unsigned char> in = randomPixels(count * 4, 7);
+    std::vector<unsigned char> out(count * 4);
+
+    ASSERT_TRUE(ImageKernels::swizzle(in.data(), out.data(), count, "bgra"));
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(out[i * 4 + 0], in[i * 4 + 2]);
+        EXPECT_EQ(out[i * 4 + 1], in[i * 4 + 1]);
+        EXPECT_EQ(out[i * 4 + 2], in[i * 4 + 0]);
+        EXPECT_EQ(out[i * 4 + 3], in[i * 4 + 3]);
+    }
+
+    // 原地重排
+    out = in;
+    ASSERT_TRUE(ImageKernels::swizzle(out.data(), out.data(), count, "ag01"));
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(out[i * 4 + 0], in[i * 4 + 3]);
+        EXPECT_EQ(out[i * 4 + 1], in[i * 4 + 1]);
+        EXPECT_EQ(out[i * 4 + 2], 0);
+        EXPECT_EQ(out[i * 4 + 3], 255);
+    }
+
+    EXPECT_FALSE(ImageKernels::swizzle(in.data(), out.data(), count, "rgbx"));
+    EXPECT_FALSE(ImageKernels::swizzle(in.data(), out.data(), count, "rgb"));
+    EXPECT_FALSE(ImageKernels::swizzle(in.data(), out.data(), count, nullptr));
+}
+
+TEST_P(ImageKernelsTest, BoxFilterAveragesInLinearSpace) {
+    // 黑白棋盘格，alpha 也是 0 / 255 交替
+    std::vector<unsigned char> checker(4 * 4 * 4);
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            unsigned char v = ((x + y) & 1) ? 255 : 0;
+            unsigned char* p = &checker[static_cast<size_t>(y * 4 + x) * 4];
+            p[0] = p[1] = p[2] = p[3] = v;
+        }
+    }
+    MipOptions options;
+    options.filter = MipFilter::Box;
+    unsigned char out[2 * 2 * 4];
+
+    options.srgb = false;
+    ImageKernels::downsample(checker.data(), 4, 4, 4, out, options);
+    for (int i = 0; i < 16; ++i) EXPECT_EQ(out[i], 128);
+
+    // 线性 0.5 编码为 sRGB 约为 188，alpha 仍按线性平均
+    options.srgb = true;
+    ImageKernels::downsample(checker.data(), 4, 4, 4, out, options);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_NEAR(out[i * 4 + 0], 188, 1);
+        EXPECT_NEAR(out[i * 4 + 2], 188, 1);
+        EXPECT_EQ(out[i * 4 + 3], 128);
+    }
+}
+
+TEST_P(ImageKernelsTest, SolidColorSurvivesFullChain) {
+    for (int channels = 1; channels <= 4; ++channels) {
+        for (int filter = 0; filter < static_cast<int>(MipFilter::Count); ++filter) {
+            const unsigned char color[4] = { 13, 200, 77, 140 };
+            std::vector<ImageLevel> levels(1);
+            levels[0].width = 13;
+            levels[0].height = 7;
+            for (int i = 0; i < 13 * 7; ++i) levels[0].pixels.insert(levels[0].pixels.end(), color, color + channels);
+
+            MipOptions options;
+            options.filter = static_cast<MipFilter>(filter);
+            ImageKernels::generateMipChain(levels, channels, options);
+            ASSERT_EQ(levels.size(), 4u);
+            EXPECT_EQ(levels[1].width, 6);
+            EXPECT_EQ(levels[1].height, 3);
+            EXPECT_EQ(levels[3].width, 1);
+            EXPECT_EQ(levels[3].height, 1);
+            for (const ImageLevel& level : levels) {
+                ASSERT_EQ(level.pixels.size(), static_cast<size_t>(level.width) * level.height * channels);
+                for (size_t i = 0; i < level.pixels.size(); ++i) {
+                    ASSERT_EQ(level.pixels[i], color[i % channels])
+                        << ImageKernels::getFilterName(options.filter) << ", " << channels << " channels";
+                }
+            }
+        }
+    }
+}
+
+TEST_P(ImageKernelsTest, WrapSamplesOppositeEdge) {
+    // 只有第一列为白色；平铺取样时最右侧的输出像素也会受到它的影响
+    const int width = 16, height = 4;
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height, 0);
+    for (int y = 0; y < height; ++y) pixels[static_cast<size_t>(y) * width] = 255;
+    std::vector<unsigned char> clamped(8 * 2);
+    std::vector<unsigned char> wrapped(8 * 2);
+
+    MipOptions options;
+    options.srgb = false;
+    ImageKernels::downsample(pixels.data(), width, height, 1, clamped.data(), options);
+    options.wrap = true;
+    ImageKernels::downsample(pixels.data(), width, height, 1, wrapped.data(), options);
+    EXPECT_EQ(clamped[7], 0);
+    EXPECT_GT(wrapped[7], 0);
+    // 左边缘：重复边缘像素相当于白色更宽，平铺时左侧是黑色；中间不受影响
+    EXPECT_LT(wrapped[0], clamped[0]);
+    EXPECT_EQ(clamped[3], wrapped[3]);
+}
+
+TEST_P(ImageKernelsTest, MatchesScalarAndThreadCount) {
+    for (int channels : { 1, 3, 4 }) {
+        std::vector<ImageLevel> levels(1, makeLevel(75, 41, channels, static_cast<unsigned int>(channels)));
+        MipOptions options;
+        ImageKernels::generateMipChain(levels, channels, options);
+
+        Parallel::setMaxWorkers(1);
+        std::vector<ImageLevel> serial(1, levels[0]);
+        ImageKernels::generateMipChain(serial, channels, options);
+        Parallel::setMaxWorkers(0);
+        EXPECT_EQ(maxDifference(levels, serial), 0);
+
+        // SSE2 与标量逐字节一致；AVX2 使用 FMA，允许相差 1
+        ImageKernels::setActiveLevel(ImageKernels::SimdLevel::Scalar);
+        std::vector<ImageLevel> scalar(1, levels[0]);
+        ImageKernels::generateMipChain(scalar, channels, options);
+        ImageKernels::setActiveLevel(GetParam());
+        EXPECT_LE(maxDifference(levels, scalar), GetParam() == ImageKernels::SimdLevel::AVX2 ? 1 : 0)
+            << channels << " channels";
+    }
+}
+
+TEST(ImageKernelsLevelTest, MipLevelCount) {
+    EXPECT_EQ(ImageKernels::getMipLevelCount(1, 1), 1);
+    EXPECT_EQ(ImageKernels::getMipLevelCount(256, 256), 9);
+    EXPECT_EQ(ImageKernels::getMipLevelCount(130, 66), 8);
+    EXPECT_EQ(ImageKernels::getMipLevelCount(1, 5), 3);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, ImageKernelsTest,
+                         ::testing::Values(ImageKernels::SimdLevel::Scalar,
+                                           ImageKernels::SimdLevel::SSE2,
+                                           ImageKernels::SimdLevel::AVX2));
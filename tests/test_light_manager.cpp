@@ -186,3 +186,17 @@ TEST(LightManagerTest, SetAmbientColor) {
     
     EXPECT_EQ(manager.getAmbientColor(), glm::vec3(0.2f, 0.1f, 0.1f));
 }
+
+TEST(LightManagerTest, AmbientSH) {
+    LightManager manager;
+    EXPECT_FALSE(manager.hasAmbientSH());
+
+    SHCoefficients sh;
+    sh.coefficients[0] = glm::vec3(1.0f, 0.5f, 0.25f);
+    manager.setAmbientSH(sh);
+    EXPECT_TRUE(manager.hasAmbientSH());
+    EXPECT_EQ(manager.getAmbientSH().coefficients[0], glm::vec3(1.0f, 0.5f, 0.25f));
+
+    manager.clearAmbientSH();
+    EXPECT_FALSE(manager.hasAmbientSH());
+}
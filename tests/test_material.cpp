@@ -102,3 +102,19 @@ TEST_F(MaterialTest, GetTextureByTypeNone) {
     CMaterial material;
     EXPECT_EQ(material.getTextureByType(TextureType::Diffuse), nullptr);
 }
+
+TEST_F(MaterialTest, UVTransform) {
+    CMaterial material;
+    EXPECT_FALSE(material.hasUVTransform());
+    EXPECT_EQ(material.uvScale, glm::vec2(1.0f));
+    EXPECT_EQ(material.uvOffset, glm::vec2(0.0f));
+
+    material.setUVTransform(glm::vec2(0.25f, 0.5f), glm::vec2(0.125f, 0.0f));
+    EXPECT_TRUE(material.hasUVTransform());
+
+    CMaterial copy(material);
+    EXPECT_EQ(copy.uvScale, glm::vec2(0.25f, 0.5f));
+    CMaterial assigned;
+    assigned = material;
+    EXPECT_EQ(assigned.uvOffset, glm::vec2(0.125f, 0.0f));
+}
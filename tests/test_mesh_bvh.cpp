@@ -0,0 +1,255 @@
+/**
+ * @file test_mesh_bvh.cpp
+ * @brief Unit tests for MeshBVH ray queries (no OpenGL context)
+ */
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include "mesh/MeshBVH.h"
+#include "mesh/PrimitiveTables.h"
+
+namespace {
+
+typedef MeshBVH::Ray Ray;
+
+// 随机三角形汤：大小不一、相互穿插，覆盖 SAH 的各种划分
+void makeTriangleSoup(size_t count, unsigned int seed,
+                      std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> center(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    vertices.clear();
+    indices.clear();
+    for (size_t t = 0; t < count; ++t) {
+        glm::vec3 c(center(rng), center(rng), center(rng));
+        float size = (t % 7 == 0) ? 4.0f : 0.5f;
+        for (int k = 0; k < 3; ++k) {
+            glm::vec3 p = c + size * glm::vec3(offset(rng), offset(rng), offset(rng));
+            vertices.push_back(Vertex(p, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f)));
+            indices.push_back(static_cast<unsigned int>(vertices.size() - 1));
+        }
+    }
+}
+
+// 逐个三角形求交的参考实现
+bool bruteForce(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                const Ray& ray, float& closestT) {
+    bool found = false;
+    closestT = ray.tMax;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        glm::vec3 p0 = vertices[indices[i]].position;
+        glm::vec3 e1 = vertices[indices[i + 1]].position - p0;
+        glm::vec3 e2 = vertices[indices[i + 2]].position - p0;
+        glm::vec3 pvec = glm::cross(ray.direction, e2);
+        float det = glm::dot(e1, pvec);
+        if (std::fabs(det) < 1e-30f) continue;
+        glm::vec3 tvec = ray.origin - p0;
+        float u = glm::dot(tvec, pvec) / det;
+        if (u < 0.0f || u > 1.0f) continue;
+        glm::vec3 qvec = glm::cross(tvec, e1);
+        float v = glm::dot(ray.direction, qvec) / det;
+        if (v < 0.0f || u + v > 1.0f) continue;
+        float t = glm::dot(e2, qvec) / det;
+        if (t >= ray.tMin && t <= closestT) {
+            closestT = t;
+            found = true;
+        }
+    }
+    return found;
+}
+
+Ray randomRay(std::mt19937& rng) {
+    std::uniform_real_distribution<float> origin(-15.0f, 15.0f);
+    std::uniform_real_distribution<float> target(-8.0f, 8.0f);
+    glm::vec3 o(origin(rng), origin(rng), origin(rng));
+    glm::vec3 t(target(rng), target(rng), target(rng));
+    return Ray(o, glm::normalize(t - o));
+}
+
+void makeUnitCube(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    PrimitiveTables::copyTo(PrimitiveTables::cube(), 1.0f, vertices, indices);
+}
+
+} // namespace
+
+TEST(MeshBVHTest, ClosestHitMatchesBruteForce) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeTriangleSoup(2000, 7, vertices, indices);
+
+    MeshBVH bvh;
+    ASSERT_TRUE(bvh.build(vertices, indices));
+    EXPECT_EQ(bvh.getTriangleCount(), 2000u);
+    EXPECT_GT(bvh.getNodeCount(), 1u);
+
+    std::mt19937 rng(11);
+    int hits = 0;
+    for (int i = 0; i < 3000; ++i) {
+        Ray ray = randomRay(rng);
+        float expectedT;
+        bool expected = bruteForce(vertices, indices, ray, expectedT);
+
+        MeshBVH::Hit hit;
+        ASSERT_EQ(bvh.intersect(ray, hit), expected) << "ray " << i;
+        if (!expected) continue;
+        ++hits;
+        EXPECT_NEAR(hit.t, expectedT, 1e-4f * std::max(1.0f, expectedT)) << "ray " << i;
+
+        // 命中的三角形与重心坐标能还原交点
+        ASSERT_LT(hit.triangle, indices.size() / 3);
+        glm::vec3 p0 = vertices[indices[hit.triangle * 3]].position;
+        glm::vec3 p1 = vertices[indices[hit.triangle * 3 + 1]].position;
+        glm::vec3 p2 = vertices[indices[hit.triangle * 3 + 2]].position;
+        glm::vec3 fromBarycentric = (1.0f - hit.u - hit.v) * p0 + hit.u * p1 + hit.v * p2;
+        EXPECT_NEAR(glm::length(fromBarycentric - (ray.origin + hit.t * ray.direction)), 0.0f, 1e-3f);
+    }
+    // 随机射线大部分命中，测试才有意义
+    EXPECT_GT(hits, 1000);
+}
+
+TEST(MeshBVHTest, AnyHitMatchesBruteForce) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeTriangleSoup(500, 3, vertices, indices);
+
+    MeshBVH bvh;
+    ASSERT_TRUE(bvh.build(vertices, indices));
+
+    std::mt19937 rng(5);
+    for (int i = 0; i < 2000; ++i) {
+        Ray ray = randomRay(rng);
+        ray.tMax = 12.0f;
+        float ignored;
+        EXPECT_EQ(bvh.occluded(ray), bruteForce(vertices, indices, ray, ignored)) << "ray " << i;
+    }
+}
+
+TEST(MeshBVHTest, RespectsRayInterval) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeUnitCube(vertices, indices);
+
+    MeshBVH bvh;
+    ASSERT_TRUE(bvh.build(vertices, indices));
+
+    // 从 z = 5 沿 -z 射入：前面在 t = 4.5，背面在 t = 5.5
+    Ray ray(glm::vec3(0.1f, 0.2f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    MeshBVH::Hit hit;
+    ASSERT_TRUE(bvh.intersect(ray, hit));
+    EXPECT_FLOAT_EQ(hit.t, 4.5f);
+
+    ray.tMin = 5.0f;
+    ASSERT_TRUE(bvh.intersect(ray, hit));
+    EXPECT_FLOAT_EQ(hit.t, 5.5f);
+
+    ray.tMin = 0.0f;
+    ray.tMax = 4.0f;
+    EXPECT_FALSE(bvh.intersect(ray, hit));
+    EXPECT_FALSE(bvh.occluded(ray));
+
+    // 平行于坐标轴、擦过包围盒外侧的射线
+    Ray miss(glm::vec3(0.6f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    EXPECT_FALSE(bvh.intersect(miss, hit));
+}
+
+TEST(MeshBVHTest, SceneRaycastUsesInstanceTransforms) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeUnitCube(vertices, indices);
+    MeshBVH bvh;
+    ASSERT_TRUE(bvh.build(vertices, indices));
+
+    std::vector<MeshBVH::Instance> instances;
+    // 远处放大 4 倍的立方体，近处旋转的立方体，以及没有 BVH 的实例
+    instances.emplace_back(&bvh, glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f)),
+                                            glm::vec3(4.0f)));
+    instances.emplace_back(&bvh, glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -3.0f)),
+                                             glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    instances.emplace_back(nullptr, glm::mat4(1.0f));
+
+    Ray ray(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    MeshBVH::SceneHit hit;
+    ASSERT_TRUE(MeshBVH::raycast(instances, ray, hit));
+    EXPECT_EQ(hit.instance, 1u);
+    // 旋转 45° 后棱角朝向射线，离中心 sqrt(0.5)
+    EXPECT_NEAR(hit.t, 8.0f - std::sqrt(0.5f), 1e-4f);
+    EXPECT_NEAR(hit.position.z, -3.0f + std::sqrt(0.5f), 1e-4f);
+
+    // 偏离近处立方体后命中远处的大立方体，t 以世界单位计
+    Ray offset(glm::vec3(1.5f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    ASSERT_TRUE(MeshBVH::raycast(instances, offset, hit));
+    EXPECT_EQ(hit.instance, 0u);
+    EXPECT_NEAR(hit.t, 13.0f, 1e-4f);
+
+    Ray away(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    EXPECT_FALSE(MeshBVH::raycast(instances, away, hit));
+    EXPECT_FALSE(MeshBVH::occluded(instances, away));
+    EXPECT_TRUE(MeshBVH::occluded(instances, ray));
+}
+
+TEST(MeshBVHTest, RayFromScreenCenterFollowsView) {
+    glm::vec3 eye(1.0f, 2.0f, 3.0f);
+    glm::vec3 target(1.0f, 2.0f, -7.0f);
+    glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
+
+    Ray center = MeshBVH::rayFromScreen(glm::vec2(0.0f), view, projection);
+    EXPECT_NEAR(glm::length(center.direction - glm::vec3(0.0f, 0.0f, -1.0f)), 0.0f, 1e-4f);
+    EXPECT_NEAR(glm::length(center.origin - (eye + glm::vec3(0.0f, 0.0f, -0.1f))), 0.0f, 1e-4f);
+
+    // 屏幕上方的射线向上偏
+    Ray top = MeshBVH::rayFromScreen(glm::vec2(0.0f, 1.0f), view, projection);
+    EXPECT_NEAR(std::atan2(top.direction.y, -top.direction.z), glm::radians(22.5f), 1e-4f);
+}
+
+TEST(MeshBVHTest, EmptyAndInvalidInput) {
+    MeshBVH bvh;
+    MeshBVH::Hit hit;
+    Ray ray(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    EXPECT_TRUE(bvh.empty());
+    EXPECT_FALSE(bvh.intersect(ray, hit));
+    EXPECT_FALSE(bvh.occluded(ray));
+
+    std::vector<Vertex> vertices(3);
+    vertices[1].position = glm::vec3(1.0f, 0.0f, 0.0f);
+    vertices[2].position = glm::vec3(0.0f, 1.0f, 0.0f);
+    EXPECT_FALSE(bvh.build(vertices, { 0, 1, 3 }));
+    EXPECT_FALSE(bvh.build(vertices, { 0, 1 }));
+    EXPECT_TRUE(bvh.empty());
+
+    // 只有退化三角形：构建成功但没有可命中的三角形
+    EXPECT_TRUE(bvh.build(vertices, { 0, 1, 1 }));
+    EXPECT_TRUE(bvh.empty());
+
+    ASSERT_TRUE(bvh.build(vertices, { 0, 1, 1, 0, 1, 2 }));
+    EXPECT_EQ(bvh.getTriangleCount(), 1u);
+    Ray front(glm::vec3(0.2f, 0.2f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    ASSERT_TRUE(bvh.intersect(front, hit));
+    EXPECT_EQ(hit.triangle, 1u);
+    EXPECT_FLOAT_EQ(hit.t, 1.0f);
+}
+
+TEST(MeshBVHTest, CoincidentCentroidsStillSplit) {
+    // 大量中心重合的三角形：SAH 无法划分，按数量对半分，叶子仍保持小
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    for (int i = 0; i < 256; ++i) {
+        vertices.push_back(Vertex(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(0.0f)));
+        vertices.push_back(Vertex(glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(0.0f)));
+        vertices.push_back(Vertex(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f), glm::vec2(0.0f)));
+        for (int k = 0; k < 3; ++k) indices.push_back(static_cast<unsigned int>(i * 3 + k));
+    }
+    MeshBVH bvh;
+    ASSERT_TRUE(bvh.build(vertices, indices));
+    MeshBVH::Stats stats = bvh.getStats();
+    EXPECT_EQ(stats.triangleCount, 256u);
+    EXPECT_GE(stats.leafCount, 256u / 4);
+
+    Ray ray(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    MeshBVH::Hit hit;
+    ASSERT_TRUE(bvh.intersect(ray, hit));
+    EXPECT_FLOAT_EQ(hit.t, 3.0f);
+}
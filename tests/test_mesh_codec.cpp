@@ -0,0 +1,236 @@
+/**
+ * @file test_mesh_codec.cpp
+ * @brief Unit tests for the lossless mesh codec
+ */
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include "mesh/MeshCodec.h"
+#include "mesh/MeshUtils.h"
+#include "mesh/ModelLoader.h"
+
+namespace {
+
+// columns x rows 个格子的起伏网格，顶点和索引都按行排列
+void makeGrid(size_t columns, size_t rows, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    vertices.clear();
+    indices.clear();
+    for (size_t z = 0; z <= rows; ++z) {
+        for (size_t x = 0; x <= columns; ++x) {
+            float u = static_cast<float>(x) / static_cast<float>(columns);
+            float v = static_cast<float>(z) / static_cast<float>(rows);
+            float h = 0.2f * std::sin(u * 7.0f) * std::cos(v * 5.0f);
+            vertices.push_back(Vertex(glm::vec3(u, h, v), glm::normalize(glm::vec3(-h, 1.0f, h)), glm::vec2(u, v)));
+        }
+    }
+    for (size_t z = 0; z < rows; ++z) {
+        for (size_t x = 0; x < columns; ++x) {
+            unsigned int i0 = static_cast<unsigned int>(z * (columns + 1) + x);
+            unsigned int i2 = i0 + static_cast<unsigned int>(columns + 1);
+            indices.insert(indices.end(), { i0, i2, i0 + 1, i0 + 1, i2, i2 + 1 });
+        }
+    }
+}
+
+std::vector<unsigned char> roundTripVertices(const void* data, size_t count, size_t stride) {
+    std::vector<unsigned char> encoded;
+    EXPECT_TRUE(MeshCodec::encodeVertices(data, count, stride, encoded));
+    EXPECT_LE(encoded.size(), MeshCodec::getVertexBufferBound(count, stride));
+    std::vector<unsigned char> decoded(count * stride + 1, 0xCD);
+    EXPECT_TRUE(MeshCodec::decodeVertices(encoded.data(), encoded.size(), decoded.data(), count, stride));
+    // 不写出界
+    EXPECT_EQ(decoded.back(), 0xCD);
+    decoded.pop_back();
+    return decoded;
+}
+
+} // namespace
+
+TEST(MeshCodecTest, VerticesRoundTripBitExact) {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<uint32_t> bits;
+    // 跨越分组（16）和分块（256）边界的数量
+    const size_t counts[] = { 0, 1, 15, 16, 17, 255, 256, 257, 1000 };
+    for (size_t count : counts) {
+        std::vector<uint32_t> words(count * 14);
+        for (auto& w : words) w = bits(rng);
+        std::vector<unsigned char> decoded = roundTripVertices(words.data(), count, 56);
+        ASSERT_EQ(std::memcmp(decoded.data(), words.data(), decoded.size()), 0) << count;
+    }
+
+    // 特殊浮点值按位保留
+    std::vector<float> specials = { 0.0f, -0.0f, std::numeric_limits<float>::infinity(),
+                                    -std::numeric_limits<float>::infinity(),
+                                    std::numeric_limits<float>::quiet_NaN(),
+                                    std::numeric_limits<float>::denorm_min(), 1.0f, -1e30f };
+    std::vector<unsigned char> decoded = roundTripVertices(specials.data(), specials.size(), 4);
+    EXPECT_EQ(std::memcmp(decoded.data(), specials.data(), decoded.size()), 0);
+}
+
+TEST(MeshCodecTest, SmoothVerticesCompress) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeGrid(64, 64, vertices, indices);
+
+    std::vector<unsigned char> encoded;
+    ASSERT_TRUE(MeshCodec::encodeVertices(vertices.data(), vertices.size(), sizeof(Vertex), encoded));
+    // 切线 / 副切线全为 0，平滑的位置 / 纹理坐标高位字节几乎不变
+    EXPECT_LT(encoded.size(), vertices.size() * sizeof(Vertex) / 2);
+
+    std::vector<Vertex> decoded(vertices.size());
+    ASSERT_TRUE(MeshCodec::decodeVertices(encoded.data(), encoded.size(), decoded.data(), decoded.size(), sizeof(Vertex)));
+    EXPECT_EQ(std::memcmp(decoded.data(), vertices.data(), vertices.size() * sizeof(Vertex)), 0);
+}
+
+TEST(MeshCodecTest, VertexStrideValidation) {
+    unsigned char data[24] = {};
+    std::vector<unsigned char> encoded;
+    EXPECT_FALSE(MeshCodec::encodeVertices(data, 2, 6, encoded));
+    EXPECT_FALSE(MeshCodec::encodeVertices(data, 2, 0, encoded));
+    ASSERT_TRUE(MeshCodec::encodeVertices(data, 2, 12, encoded));
+
+    unsigned char out[24];
+    EXPECT_FALSE(MeshCodec::decodeVertices(encoded.data(), encoded.size(), out, 2, 6));
+    EXPECT_TRUE(MeshCodec::decodeVertices(encoded.data(), encoded.size(), out, 2, 12));
+}
+
+TEST(MeshCodecTest, TruncatedVertexStreamFails) {
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<uint32_t> bits;
+    std::vector<uint32_t> words(40 * 4);
+    for (auto& w : words) w = bits(rng) & 0x00FF0F03u;
+
+    std::vector<unsigned char> encoded;
+    ASSERT_TRUE(MeshCodec::encodeVertices(words.data(), 40, 16, encoded));
+    std::vector<uint32_t> decoded(words.size());
+    for (size_t size = 0; size < encoded.size(); ++size) {
+        EXPECT_FALSE(MeshCodec::decodeVertices(encoded.data(), size, decoded.data(), 40, 16)) << size;
+    }
+    // 多余的尾部数据也视为格式错误
+    encoded.push_back(0);
+    EXPECT_FALSE(MeshCodec::decodeVertices(encoded.data(), encoded.size(), decoded.data(), 40, 16));
+}
+
+TEST(MeshCodecTest, IndicesRoundTrip) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> grid;
+    makeGrid(32, 32, vertices, grid);
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<unsigned int> anyIndex(0, 100000);
+    std::vector<unsigned int> scattered(999);
+    for (auto& i : scattered) i = anyIndex(rng);
+    std::vector<unsigned int> extremes = { 0u, 0xFFFFFFFEu, 7u, 0x80000000u, 0u, 1u };
+
+    const std::vector<unsigned int>* cases[] = { &grid, &scattered, &extremes };
+    for (const auto* indices : cases) {
+        std::vector<unsigned char> encoded;
+        ASSERT_TRUE(MeshCodec::encodeIndices(indices->data(), indices->size(), encoded));
+        EXPECT_LE(encoded.size(), MeshCodec::getIndexBufferBound(indices->size()));
+        std::vector<unsigned int> decoded(indices->size());
+        ASSERT_TRUE(MeshCodec::decodeIndices(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+        EXPECT_EQ(decoded, *indices);
+    }
+}
+
+TEST(MeshCodecTest, CacheFriendlyIndicesCompress) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+
+    // 窄条带：上一行的顶点仍在 FIFO 中，每个索引都是 FIFO 命中、下一个新顶点或上一个 + 1，
+    // 只有第一行跳着出现的几个顶点需要转义（每个 1 字节）
+    makeGrid(4, 256, vertices, indices);
+    std::vector<unsigned char> encoded;
+    ASSERT_TRUE(MeshCodec::encodeIndices(indices.data(), indices.size(), encoded));
+    EXPECT_LE(encoded.size(), 1 + (indices.size() + 1) / 2 + 5);
+
+    // 宽网格的上一行已离开 FIFO，换行处需要转义，仍远小于 12 字节 / 三角形
+    makeGrid(64, 64, vertices, indices);
+    ASSERT_TRUE(MeshCodec::encodeIndices(indices.data(), indices.size(), encoded));
+    EXPECT_LT(static_cast<double>(encoded.size()) / (indices.size() / 3), 2.5);
+}
+
+TEST(MeshCodecTest, CorruptedIndexStreamFails) {
+    std::vector<unsigned int> indices = { 0, 5, 9, 9, 5, 100, 3, 2, 1 };
+    std::vector<unsigned char> encoded;
+    ASSERT_TRUE(MeshCodec::encodeIndices(indices.data(), indices.size(), encoded));
+
+    std::vector<unsigned int> decoded(indices.size());
+    for (size_t size = 0; size < encoded.size(); ++size) {
+        EXPECT_FALSE(MeshCodec::decodeIndices(encoded.data(), size, decoded.data(), decoded.size())) << size;
+    }
+    encoded[0] = 0x7F;
+    EXPECT_FALSE(MeshCodec::decodeIndices(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+
+    // 引用空 FIFO 槽位的代码
+    std::vector<unsigned char> bogus = { 1, 0x55 };
+    EXPECT_FALSE(MeshCodec::decodeIndices(bogus.data(), bogus.size(), decoded.data(), 2));
+}
+
+TEST(MeshCodecTest, CorruptMeshHeaderRejectedBeforeAllocation) {
+    // 与 MeshCodec.cpp 中的文件头布局一致
+    struct Header {
+        char magic[4];
+        uint32_t version, primitive, vertexCount, indexCount, stride, vertexBytes, indexBytes;
+    };
+    std::vector<unsigned char> vertexStream, indexStream;
+    ASSERT_TRUE(MeshCodec::encodeVertices(nullptr, 0, sizeof(Vertex), vertexStream));
+    ASSERT_TRUE(MeshCodec::encodeIndices(nullptr, 0, indexStream));
+
+    auto build = [&](uint32_t primitive, uint32_t vertexCount, uint32_t indexCount) {
+        Header header = { { 'M', 'S', 'H', 'C' }, 1, primitive, vertexCount, indexCount,
+                          static_cast<uint32_t>(sizeof(Vertex)),
+                          static_cast<uint32_t>(vertexStream.size()), static_cast<uint32_t>(indexStream.size()) };
+        std::vector<unsigned char> data(sizeof(header));
+        std::memcpy(data.data(), &header, sizeof(header));
+        data.insert(data.end(), vertexStream.begin(), vertexStream.end());
+        data.insert(data.end(), indexStream.begin(), indexStream.end());
+        return data;
+    };
+
+    // 数量远超流长度：不分配 40 亿个顶点 / 索引
+    std::vector<unsigned char> huge = build(GL_TRIANGLES, 0xFFFFFFFFu, 0);
+    EXPECT_EQ(MeshCodec::decodeMesh(huge.data(), huge.size()), nullptr);
+    huge = build(GL_TRIANGLES, 0, 0xFFFFFFFFu);
+    EXPECT_EQ(MeshCodec::decodeMesh(huge.data(), huge.size()), nullptr);
+
+    // 未知图元类型
+    std::vector<unsigned char> bogus = build(12345, 0, 0);
+    EXPECT_EQ(MeshCodec::decodeMesh(bogus.data(), bogus.size()), nullptr);
+}
+
+// 需要 OpenGL 上下文
+TEST(MeshCodecTest, DISABLED_MeshRoundTripThroughLoader) {
+    auto sphere = MeshUtils::createSphere(1.0f, 24);
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeGrid(16, 16, vertices, indices);
+    auto grid = std::make_shared<CMesh>(vertices, indices);
+
+    std::vector<unsigned char> encoded;
+    ASSERT_TRUE(MeshCodec::encodeMesh(*sphere, encoded));
+    size_t consumed = 0;
+    auto decoded = MeshCodec::decodeMesh(encoded.data(), encoded.size(), &consumed);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(consumed, encoded.size());
+    EXPECT_EQ(decoded->getIndices(), sphere->getIndices());
+    ASSERT_EQ(decoded->getVertexCount(), sphere->getVertexCount());
+    EXPECT_EQ(std::memcmp(decoded->getVertices().data(), sphere->getVertices().data(),
+                          sphere->getVertexCount() * sizeof(Vertex)), 0);
+    EXPECT_EQ(decoded->getBoundingBox().max, sphere->getBoundingBox().max);
+
+    EXPECT_EQ(MeshCodec::decodeMesh(encoded.data(), encoded.size() - 1), nullptr);
+
+    const std::string path = "test_mesh_codec_roundtrip.mshc";
+    ASSERT_TRUE(MeshCodec::saveMeshes(path, { sphere, grid }));
+    auto loaded = CModelLoader::load(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(loaded.size(), 2u);
+    EXPECT_EQ(loaded[1]->getIndices(), indices);
+    EXPECT_EQ(loaded[1]->getVertices()[17].position, vertices[17].position);
+}
@@ -354,6 +354,237 @@ TEST_F(MeshBoundingBoxExtendedTest, DISABLED_OffCenterMesh) {
     EXPECT_FLOAT_EQ(box.getSize().z, 0.0f);  // Z 方向没有变化
 }
 
+// ============================================================================
+// 右值构造与 CPU 数据释放测试
+// ============================================================================
+
+class MeshCpuReleaseTest : public ::testing::Test {
+protected:
+    std::vector<Vertex> makeQuad() {
+        return {
+            Vertex(glm::vec3(-1.0f, -1.0f, 0.0f)),
+            Vertex(glm::vec3( 1.0f, -1.0f, 0.0f)),
+            Vertex(glm::vec3( 1.0f,  1.0f, 0.0f)),
+            Vertex(glm::vec3(-1.0f,  1.0f, 0.0f))
+        };
+    }
+};
+
+TEST_F(MeshCpuReleaseTest, DefaultMeshHasNothingReleased) {
+    CMesh mesh;
+    EXPECT_FALSE(mesh.isCpuDataReleased());
+    EXPECT_FALSE(mesh.getReleaseCpuDataAfterUpload());
+    EXPECT_EQ(mesh.getCpuMemoryUsage(), 0u);
+    EXPECT_FALSE(mesh.releaseCpuData());  // 未上传时不能释放
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshCpuReleaseTest, DISABLED_RvalueConstructorTakesStorage) {
+    std::vector<Vertex> vertices = makeQuad();
+    std::vector<unsigned int> indices = {0, 1, 2, 2, 3, 0};
+    const Vertex* storage = vertices.data();
+    
+    CMesh mesh(std::move(vertices), std::move(indices));
+    EXPECT_EQ(mesh.getVertices().data(), storage);
+    EXPECT_EQ(mesh.getVertexCount(), 4u);
+    EXPECT_EQ(mesh.getIndexCount(), 6u);
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshCpuReleaseTest, DISABLED_ReleaseKeepsCountsAndBounds) {
+    size_t before = CMesh::getTotalReleasedCpuBytes();
+    {
+        CMesh mesh(makeQuad(), std::vector<unsigned int>{0, 1, 2, 2, 3, 0});
+        ASSERT_TRUE(mesh.releaseCpuData());
+        
+        EXPECT_TRUE(mesh.isCpuDataReleased());
+        EXPECT_TRUE(mesh.getVertices().empty());
+        EXPECT_EQ(mesh.getVertexCount(), 4u);
+        EXPECT_EQ(mesh.getIndexCount(), 6u);
+        EXPECT_TRUE(mesh.hasIndices());
+        EXPECT_EQ(mesh.getCpuMemoryUsage(), 0u);
+        
+        mesh.calculateBoundingBox();
+        EXPECT_TRUE(mesh.getBoundingBox().isValid);
+        EXPECT_FLOAT_EQ(mesh.getBoundingBox().getSize().x, 2.0f);
+        
+        EXPECT_EQ(CMesh::getTotalReleasedCpuBytes() - before,
+                  4 * sizeof(Vertex) + 6 * sizeof(unsigned int));
+    }
+    EXPECT_EQ(CMesh::getTotalReleasedCpuBytes(), before);
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshCpuReleaseTest, DISABLED_ReleaseAfterUploadAndReupload) {
+    CMesh mesh;
+    mesh.setReleaseCpuDataAfterUpload(true);
+    mesh.setVertices(makeQuad());
+    EXPECT_TRUE(mesh.isCpuDataReleased());
+    
+    // 重新设置数据后再次上传并释放
+    std::vector<Vertex> triangle = makeQuad();
+    triangle.pop_back();
+    mesh.updateVertexData(std::move(triangle));
+    EXPECT_EQ(mesh.getVertexCount(), 3u);
+    EXPECT_TRUE(mesh.getVertices().empty());
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshCpuReleaseTest, DISABLED_CopyOfReleasedMeshStaysDrawable) {
+    CMesh source(makeQuad());
+    source.releaseCpuData();
+    
+    CMesh copy(source);
+    EXPECT_EQ(copy.getVertexCount(), 4u);
+    EXPECT_TRUE(copy.isCpuDataReleased());
+    EXPECT_TRUE(copy.getBoundingBox().isValid);
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshCpuReleaseTest, DISABLED_StreamMeshCannotRelease) {
+    CMesh mesh(makeQuad());
+    mesh.setBufferUsage(BufferUsage::Stream, std::make_shared<StreamingBuffer>(1 << 16));
+    EXPECT_FALSE(mesh.releaseCpuData());
+}
+
+// ============================================================================
+// 共享几何数据与写时复制测试
+// ============================================================================
+
+class MeshSharedGeometryTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+};
+
+TEST_F(MeshSharedGeometryTest, CopyKeepsOwnMaterial) {
+    CMesh original;
+    CMesh copy(original);
+    EXPECT_TRUE(copy.sharesGeometryWith(original));
+    
+    copy.setMaterial(std::make_shared<CMaterial>());
+    EXPECT_TRUE(copy.hasMaterial());
+    EXPECT_FALSE(original.hasMaterial());
+    EXPECT_TRUE(copy.sharesGeometryWith(original));  // 换材质不影响几何数据
+}
+
+TEST_F(MeshSharedGeometryTest, LayoutChangeDetaches) {
+    CMesh original;
+    CMesh copy = original;
+    
+    copy.setVertexLayout(VertexAttributeLayout::PositionOnly());
+    EXPECT_FALSE(copy.sharesGeometryWith(original));
+    EXPECT_EQ(copy.getVertexLayout().attributes.size(), 1u);
+    EXPECT_EQ(original.getVertexLayout().attributes.size(),
+              VertexAttributeLayout::PositionNormalTex().attributes.size());
+}
+
+TEST_F(MeshSharedGeometryTest, MovedFromMeshIsEmpty) {
+    CMesh source;
+    source.setVertexLayout(VertexAttributeLayout::Full());
+    CMesh target(std::move(source));
+    
+    EXPECT_EQ(target.getGeometryUseCount(), 1);
+    EXPECT_EQ(source.getVertexCount(), 0u);
+    EXPECT_FALSE(source.sharesGeometryWith(target));
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshSharedGeometryTest, DISABLED_CopyOnWriteKeepsOriginalData) {
+    std::vector<Vertex> vertices = {
+        Vertex(glm::vec3(0.0f, 0.0f, 0.0f)),
+        Vertex(glm::vec3(1.0f, 0.0f, 0.0f)),
+        Vertex(glm::vec3(0.0f, 1.0f, 0.0f))
+    };
+    CMesh original(vertices);
+    CMesh copy(original);
+    EXPECT_EQ(original.getGeometryUseCount(), 2);
+    
+    Vertex moved(glm::vec3(5.0f, 5.0f, 5.0f));
+    ASSERT_TRUE(copy.updateVertexRange(0, &moved, 1));
+    EXPECT_FALSE(copy.sharesGeometryWith(original));
+    EXPECT_EQ(original.getVertices()[0].position, glm::vec3(0.0f));
+    EXPECT_EQ(copy.getVertices()[0].position, glm::vec3(5.0f));
+}
+
+// ============================================================================
+// 深度专用位置流测试
+// ============================================================================
+
+class MeshPositionStreamTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+};
+
+TEST_F(MeshPositionStreamTest, StrideFollowsPositionEncoding) {
+    CMesh mesh;
+    EXPECT_FALSE(mesh.hasPositionStream());
+    EXPECT_EQ(mesh.getPositionStreamStride(), 0u);
+    
+    ASSERT_TRUE(mesh.setPositionStreamEnabled(true));
+    EXPECT_TRUE(mesh.hasPositionStream());
+    EXPECT_EQ(mesh.getPositionStreamStride(), 12u);
+    
+    // unorm16 位置的位置流同样量化，每顶点 8 字节
+    mesh.setVertexLayout(VertexAttributeLayout::Quantized());
+    EXPECT_EQ(mesh.getPositionStreamStride(), 8u);
+    
+    ASSERT_TRUE(mesh.setPositionStreamEnabled(false));
+    EXPECT_EQ(mesh.getPositionStreamStride(), 0u);
+}
+
+TEST_F(MeshPositionStreamTest, StreamUsageDropsPositionStream) {
+    CMesh mesh;
+    ASSERT_TRUE(mesh.setPositionStreamEnabled(true));
+    mesh.setBufferUsage(BufferUsage::Stream);
+    EXPECT_FALSE(mesh.hasPositionStream());
+    EXPECT_FALSE(mesh.setPositionStreamEnabled(true));
+}
+
+TEST_F(MeshPositionStreamTest, EnablingDetachesSharedGeometry) {
+    CMesh original;
+    original.setVertexLayout(VertexAttributeLayout::Full());
+    CMesh copy(original);
+    ASSERT_TRUE(copy.sharesGeometryWith(original));
+    
+    copy.setPositionStreamEnabled(true);
+    EXPECT_FALSE(copy.sharesGeometryWith(original));
+    EXPECT_FALSE(original.hasPositionStream());
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshPositionStreamTest, DISABLED_ReleasedMeshCannotEnable) {
+    std::vector<Vertex> vertices = {
+        Vertex(glm::vec3(0.0f, 0.0f, 0.0f)),
+        Vertex(glm::vec3(1.0f, 0.0f, 0.0f)),
+        Vertex(glm::vec3(0.0f, 1.0f, 0.0f))
+    };
+    CMesh mesh(vertices);
+    ASSERT_TRUE(mesh.releaseCpuData());
+    EXPECT_FALSE(mesh.setPositionStreamEnabled(true));
+    
+    CMesh kept(vertices);
+    ASSERT_TRUE(kept.setPositionStreamEnabled(true));
+    ASSERT_TRUE(kept.releaseCpuData());
+    EXPECT_TRUE(kept.hasPositionStream());
+}
+
+// 需要 OpenGL 上下文
+TEST_F(MeshPositionStreamTest, DISABLED_MultiDrawNeedsPositionStreamAndIndices) {
+    std::vector<Vertex> vertices = {
+        Vertex(glm::vec3(0.0f, 0.0f, 0.0f)),
+        Vertex(glm::vec3(1.0f, 0.0f, 0.0f)),
+        Vertex(glm::vec3(0.0f, 1.0f, 0.0f))
+    };
+    CMesh indexed(vertices, { 0, 1, 2 });
+    EXPECT_FALSE(indexed.drawPositionsOnlyMulti(4));
+    ASSERT_TRUE(indexed.setPositionStreamEnabled(true));
+    EXPECT_TRUE(indexed.drawPositionsOnlyMulti(4));
+    
+    CMesh unindexed(vertices);
+    ASSERT_TRUE(unindexed.setPositionStreamEnabled(true));
+    EXPECT_FALSE(unindexed.drawPositionsOnlyMulti(4));
+}
+
 // main 函数由测试框架提供
 // int main(int argc, char** argv) {
 //     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,268 @@
+/**
+ * @file test_mesh_kernels.cpp
+ * @brief Unit tests for MeshKernels (every SIMD level supported by the host CPU is checked against glm)
+ */
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "mesh/MeshKernels.h"
+
+namespace {
+
+std::vector<Vertex> randomVertices(size_t count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-50.0f, 50.0f);
+    std::vector<Vertex> vertices(count);
+    for (auto& v : vertices) {
+        v.position = glm::vec3(dist(rng), dist(rng), dist(rng));
+        v.normal = glm::vec3(dist(rng), dist(rng), dist(rng));
+        v.tangent = glm::vec3(dist(rng), dist(rng), dist(rng));
+        v.bitangent = glm::vec3(dist(rng), dist(rng), dist(rng));
+    }
+    return vertices;
+}
+
+glm::mat4 testMatrix() {
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, -2.0f, 7.0f));
+    m = glm::rotate(m, 0.8f, glm::normalize(glm::vec3(0.2f, 1.0f, -0.4f)));
+    return glm::scale(m, glm::vec3(2.0f, 0.5f, 1.5f));
+}
+
+void expectVecNear(const glm::vec3& a, const glm::vec3& b, float eps) {
+    EXPECT_NEAR(a.x, b.x, eps);
+    EXPECT_NEAR(a.y, b.y, eps);
+    EXPECT_NEAR(a.z, b.z, eps);
+}
+
+// 依次切换到主机支持的每个级别，测试结束恢复自动检测的级别
+class MeshKernelsTest : public ::testing::TestWithParam<MeshKernels::SimdLevel> {
+protected:
+    void SetUp() override {
+        if (GetParam() > MeshKernels::getDetectedLevel()) {
+            GTEST_SKIP() << MeshKernels::getLevelName(GetParam()) << " not supported on this CPU";
+        }
+        MeshKernels::setActiveLevel(GetParam());
+    }
+
+    void TearDown() override {
+        MeshKernels::setActiveLevel(MeshKernels::getDetectedLevel());
+    }
+};
+
+} // namespace
+
+TEST_P(MeshKernelsTest, AABBMatchesReferenceForOddCounts) {
+    const size_t counts[] = { 1, 2, 3, 5, 8, 1001 };
+    for (size_t count : counts) {
+        std::vector<Vertex> vertices = randomVertices(count, static_cast<unsigned int>(count));
+        glm::vec3 refMin = vertices[0].position, refMax = vertices[0].position;
+        for (const auto& v : vertices) {
+            refMin = glm::min(refMin, v.position);
+            refMax = glm::max(refMax, v.position);
+        }
+
+        glm::vec3 mn, mx;
+        ASSERT_TRUE(MeshKernels::computeAABB(vertices, mn, mx));
+        EXPECT_EQ(mn, refMin) << "count " << count;
+        EXPECT_EQ(mx, refMax) << "count " << count;
+    }
+}
+
+TEST_P(MeshKernelsTest, AABBOnTightlyPackedPositions) {
+    std::vector<glm::vec3> positions = { {1, 2, 3}, {-4, 5, 0}, {2, -6, 9} };
+    glm::vec3 mn, mx;
+    ASSERT_TRUE(MeshKernels::computeAABB(&positions[0].x, positions.size(), sizeof(glm::vec3), mn, mx));
+    EXPECT_EQ(mn, glm::vec3(-4, -6, 0));
+    EXPECT_EQ(mx, glm::vec3(2, 5, 9));
+}
+
+TEST_P(MeshKernelsTest, EmptyInputReturnsFalse) {
+    std::vector<Vertex> empty;
+    glm::vec3 mn, mx, center;
+    float radius = 0.0f;
+    EXPECT_FALSE(MeshKernels::computeAABB(empty, mn, mx));
+    EXPECT_FALSE(MeshKernels::computeBoundingSphere(empty, center, radius));
+}
+
+TEST_P(MeshKernelsTest, BoundingSphereContainsAllPoints) {
+    std::vector<Vertex> vertices = randomVertices(777, 42);
+    glm::vec3 center;
+    float radius = 0.0f;
+    ASSERT_TRUE(MeshKernels::computeBoundingSphere(vertices, center, radius));
+
+    float farthest = 0.0f;
+    for (const auto& v : vertices) {
+        farthest = std::max(farthest, glm::length(v.position - center));
+    }
+    EXPECT_NEAR(radius, farthest, 1e-3f);
+}
+
+TEST_P(MeshKernelsTest, TransformPositionsMatchesGlm) {
+    std::vector<Vertex> vertices = randomVertices(257, 7);
+    std::vector<Vertex> out(vertices.size());
+    glm::mat4 m = testMatrix();
+
+    MeshKernels::transformPositions(&vertices[0].position.x, sizeof(Vertex),
+                                    &out[0].position.x, sizeof(Vertex), vertices.size(), m);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        expectVecNear(out[i].position, glm::vec3(m * glm::vec4(vertices[i].position, 1.0f)), 1e-3f);
+        // 跨步写入不能碰到相邻字段
+        EXPECT_EQ(out[i].normal, glm::vec3(0.0f));
+    }
+}
+
+TEST_P(MeshKernelsTest, TransformInPlace) {
+    std::vector<Vertex> vertices = randomVertices(33, 9);
+    std::vector<Vertex> original = vertices;
+    glm::mat4 m = testMatrix();
+
+    MeshKernels::transformPositions(&vertices[0].position.x, sizeof(Vertex),
+                                    &vertices[0].position.x, sizeof(Vertex), vertices.size(), m);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        expectVecNear(vertices[i].position, glm::vec3(m * glm::vec4(original[i].position, 1.0f)), 1e-3f);
+        EXPECT_EQ(vertices[i].normal, original[i].normal);
+    }
+}
+
+TEST_P(MeshKernelsTest, TransformNormalsRenormalizes) {
+    std::vector<Vertex> vertices = randomVertices(65, 11);
+    vertices[3].normal = glm::vec3(0.0f);
+    glm::mat3 nm = glm::transpose(glm::inverse(glm::mat3(testMatrix())));
+
+    MeshKernels::transformNormals(&vertices[0].normal.x, sizeof(Vertex),
+                                  &vertices[0].normal.x, sizeof(Vertex), vertices.size(), nm, true);
+    std::vector<Vertex> reference = randomVertices(65, 11);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (i == 3) {
+            EXPECT_EQ(vertices[i].normal, glm::vec3(0.0f));
+            continue;
+        }
+        expectVecNear(vertices[i].normal, glm::normalize(nm * reference[i].normal), 1e-5f);
+    }
+}
+
+TEST_P(MeshKernelsTest, TransformVerticesKeepsNormalPerpendicular) {
+    // 非均匀缩放下，法线用逆转置变换后仍应垂直于变换后的切线
+    std::vector<Vertex> vertices(1);
+    vertices[0].position = glm::vec3(1.0f, 1.0f, 0.0f);
+    vertices[0].normal = glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f));
+    vertices[0].tangent = glm::normalize(glm::vec3(1.0f, -1.0f, 0.0f));
+    vertices[0].bitangent = glm::vec3(0.0f, 0.0f, 1.0f);
+
+    glm::mat4 m = glm::scale(glm::mat4(1.0f), glm::vec3(4.0f, 1.0f, 1.0f));
+    MeshKernels::transformVertices(vertices.data(), vertices.size(), m);
+
+    expectVecNear(vertices[0].position, glm::vec3(4.0f, 1.0f, 0.0f), 1e-5f);
+    EXPECT_NEAR(glm::length(vertices[0].normal), 1.0f, 1e-5f);
+    EXPECT_NEAR(glm::dot(vertices[0].normal, vertices[0].tangent), 0.0f, 1e-5f);
+}
+
+TEST_P(MeshKernelsTest, EncodeSnorm10MatchesReference) {
+    // 含越界值，编码前应被限制在 [-1, 1]
+    std::vector<Vertex> vertices = randomVertices(37, 11);
+    for (auto& v : vertices) v.normal *= 0.03f;
+    std::vector<uint32_t> packed(vertices.size(), 0xFFFFFFFFu);
+    MeshKernels::encodeSnorm10(&vertices[0].normal.x, sizeof(Vertex), packed.data(), sizeof(uint32_t),
+                               vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        uint32_t expected = 0;
+        for (int c = 0; c < 3; ++c) {
+            float f = glm::clamp(vertices[i].normal[c], -1.0f, 1.0f);
+            int q = static_cast<int>(std::nearbyint(f * 511.0f));
+            expected |= (static_cast<uint32_t>(q) & 0x3FFu) << (10 * c);
+        }
+        EXPECT_EQ(packed[i], expected) << "vertex " << i;
+    }
+}
+
+TEST_P(MeshKernelsTest, EncodeUnorm16MatchesReference) {
+    std::vector<Vertex> vertices = randomVertices(29, 12);
+    const glm::vec3 bias(-40.0f);
+    const glm::vec3 invScale(1.0f / 80.0f);   // ±50 的随机值有一部分越界，应被截断
+    for (unsigned components = 1; components <= 3; ++components) {
+        const size_t shorts = (components + 1) & ~1u;
+        std::vector<uint16_t> packed(vertices.size() * shorts, 0xFFFFu);
+        MeshKernels::encodeUnorm16(&vertices[0].position.x, sizeof(Vertex), components, bias, invScale,
+                                   packed.data(), shorts * sizeof(uint16_t), vertices.size());
+
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            for (unsigned c = 0; c < shorts; ++c) {
+                uint16_t expected = 0;
+                if (c < components) {
+                    float f = glm::clamp((vertices[i].position[c] - bias[c]) * invScale[c], 0.0f, 1.0f);
+                    expected = static_cast<uint16_t>(std::nearbyint(f * 65535.0f));
+                }
+                EXPECT_EQ(packed[i * shorts + c], expected) << "components " << components << " vertex " << i;
+            }
+        }
+    }
+}
+
+TEST_P(MeshKernelsTest, EncodeHalfMatchesScalarConversion) {
+    // 覆盖次正规数、最大有限值、溢出和负零
+    const float special[] = { 0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65520.0f, -1e6f,
+                              6.1e-5f, 3.0e-6f, 1.0e-8f, 0.333333f, 1024.7f };
+    std::vector<float> values(special, special + sizeof(special) / sizeof(special[0]));
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    while (values.size() < 64) values.push_back(dist(rng));
+
+    const size_t count = values.size() / 2;
+    std::vector<uint16_t> packed(values.size(), 0xFFFFu);
+    MeshKernels::encodeHalf(values.data(), 2 * sizeof(float), 2, packed.data(), 2 * sizeof(uint16_t), count);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(packed[i], MeshKernels::floatToHalf(values[i])) << "value " << values[i];
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, MeshKernelsTest,
+                         ::testing::Values(MeshKernels::SimdLevel::Scalar,
+                                           MeshKernels::SimdLevel::SSE2,
+                                           MeshKernels::SimdLevel::AVX2));
+
+TEST(MeshKernelsDispatchTest, SetActiveLevelClampsToDetected) {
+    MeshKernels::setActiveLevel(MeshKernels::SimdLevel::AVX2);
+    EXPECT_LE(MeshKernels::getActiveLevel(), MeshKernels::getDetectedLevel());
+    MeshKernels::setActiveLevel(MeshKernels::SimdLevel::Scalar);
+    EXPECT_EQ(MeshKernels::getActiveLevel(), MeshKernels::SimdLevel::Scalar);
+    MeshKernels::setActiveLevel(MeshKernels::getDetectedLevel());
+}
+
+TEST(MeshKernelsDispatchTest, TransformAABBContainsTransformedCorners) {
+    glm::vec3 mn(-1.0f, -2.0f, -0.5f), mx(3.0f, 1.0f, 2.0f);
+    glm::mat4 m = testMatrix();
+    glm::vec3 outMin, outMax;
+    MeshKernels::transformAABB(mn, mx, m, outMin, outMax);
+
+    glm::vec3 cornerMin(1e30f), cornerMax(-1e30f);
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 c((i & 1) ? mx.x : mn.x, (i & 2) ? mx.y : mn.y, (i & 4) ? mx.z : mn.z);
+        glm::vec3 w(m * glm::vec4(c, 1.0f));
+        cornerMin = glm::min(cornerMin, w);
+        cornerMax = glm::max(cornerMax, w);
+    }
+    // Arvo 方法得到的正是 8 个角点变换后的紧包围盒
+    expectVecNear(outMin, cornerMin, 1e-4f);
+    expectVecNear(outMax, cornerMax, 1e-4f);
+}
+
+TEST(MeshKernelsDispatchTest, HalfConversionRoundTrips) {
+    EXPECT_EQ(MeshKernels::floatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(MeshKernels::floatToHalf(-2.0f), 0xC000);
+    EXPECT_EQ(MeshKernels::floatToHalf(65504.0f), 0x7BFF);
+    EXPECT_EQ(MeshKernels::floatToHalf(65520.0f), 0x7C00);     // 舍入后溢出为 inf
+    EXPECT_EQ(MeshKernels::floatToHalf(5.9604645e-8f), 0x0001); // 最小次正规数
+
+    // 每个有限 half 转成 float 再转回应得到原值
+    for (uint32_t h = 0; h < 0x7C00; ++h) {
+        uint16_t bits = static_cast<uint16_t>(h);
+        ASSERT_EQ(MeshKernels::floatToHalf(MeshKernels::halfToFloat(bits)), bits);
+        uint16_t negative = static_cast<uint16_t>(h | 0x8000);
+        ASSERT_EQ(MeshKernels::floatToHalf(MeshKernels::halfToFloat(negative)), negative);
+    }
+}
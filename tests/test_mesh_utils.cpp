@@ -0,0 +1,701 @@
+/**
+ * @file test_mesh_utils.cpp
+ * @brief Unit tests for MeshUtils vertex processing (CPU only, no OpenGL context)
+ */
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <vector>
+#include "mesh/MeshUtils.h"
+#include "core/Parallel.h"
+
+namespace {
+
+// 单位立方体：每个面 4 个独立顶点（UV 不同），法线先置零
+void buildCube(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    const glm::vec3 corners[6][4] = {
+        { {-0.5f,-0.5f, 0.5f}, { 0.5f,-0.5f, 0.5f}, { 0.5f, 0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f} },
+        { { 0.5f,-0.5f,-0.5f}, {-0.5f,-0.5f,-0.5f}, {-0.5f, 0.5f,-0.5f}, { 0.5f, 0.5f,-0.5f} },
+        { {-0.5f, 0.5f, 0.5f}, { 0.5f, 0.5f, 0.5f}, { 0.5f, 0.5f,-0.5f}, {-0.5f, 0.5f,-0.5f} },
+        { {-0.5f,-0.5f,-0.5f}, { 0.5f,-0.5f,-0.5f}, { 0.5f,-0.5f, 0.5f}, {-0.5f,-0.5f, 0.5f} },
+        { { 0.5f,-0.5f, 0.5f}, { 0.5f,-0.5f,-0.5f}, { 0.5f, 0.5f,-0.5f}, { 0.5f, 0.5f, 0.5f} },
+        { {-0.5f,-0.5f,-0.5f}, {-0.5f,-0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, {-0.5f, 0.5f,-0.5f} }
+    };
+    const glm::vec2 uvs[4] = { {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f} };
+
+    for (int f = 0; f < 6; ++f) {
+        unsigned int base = static_cast<unsigned int>(vertices.size());
+        for (int i = 0; i < 4; ++i) {
+            vertices.push_back(Vertex(corners[f][i], glm::vec3(0.0f), uvs[i]));
+        }
+        unsigned int quad[6] = { base, base + 1, base + 2, base + 2, base + 3, base };
+        indices.insert(indices.end(), quad, quad + 6);
+    }
+}
+
+// 共享 8 个角点的立方体（不带 UV 接缝）
+void buildSharedCube(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    for (int i = 0; i < 8; ++i) {
+        vertices.push_back(Vertex(glm::vec3((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f)));
+    }
+    indices = {
+        4, 5, 7, 7, 6, 4,   // +Z
+        1, 0, 2, 2, 3, 1,   // -Z
+        5, 1, 3, 3, 7, 5,   // +X
+        0, 4, 6, 6, 2, 0,   // -X
+        6, 7, 3, 3, 2, 6,   // +Y
+        0, 1, 5, 5, 4, 0    // -Y
+    };
+}
+
+// XZ 平面网格，法线朝 +Y，U 沿 +X，V 沿 +Z
+void buildGrid(unsigned int n, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    for (unsigned int z = 0; z <= n; ++z) {
+        for (unsigned int x = 0; x <= n; ++x) {
+            float u = static_cast<float>(x) / n;
+            float v = static_cast<float>(z) / n;
+            vertices.push_back(Vertex(glm::vec3(u, 0.0f, v), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(u, v)));
+        }
+    }
+    for (unsigned int z = 0; z < n; ++z) {
+        for (unsigned int x = 0; x < n; ++x) {
+            unsigned int i0 = z * (n + 1) + x;
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + n + 1;
+            unsigned int i3 = i2 + 1;
+            unsigned int quad[6] = { i0, i2, i1, i1, i2, i3 };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Parallel 测试
+// ============================================================================
+
+TEST(ParallelTest, CoversEveryIndexOnce) {
+    Parallel::setMaxWorkers(3);
+    const size_t count = 100003;
+    std::vector<std::atomic<int>> hits(count);
+    for (auto& h : hits) h = 0;
+
+    Parallel::forRange(count, 1000, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) hits[i]++;
+    });
+
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(hits[i].load(), 1) << "index " << i;
+    }
+    Parallel::setMaxWorkers(0);
+}
+
+TEST(ParallelTest, WorkerIndexWithinCount) {
+    Parallel::setMaxWorkers(4);
+    const size_t count = 50000;
+    unsigned int workers = Parallel::getWorkerCount(count, 100);
+    std::atomic<unsigned int> maxWorker(0);
+
+    Parallel::forRange(count, 100, [&](size_t, size_t, unsigned int worker) {
+        unsigned int prev = maxWorker.load();
+        while (worker > prev && !maxWorker.compare_exchange_weak(prev, worker)) {}
+    });
+
+    EXPECT_LT(maxWorker.load(), workers);
+    EXPECT_EQ(workers, 4u);
+    Parallel::setMaxWorkers(0);
+}
+
+TEST(ParallelTest, SmallInputRunsSingleWorker) {
+    EXPECT_EQ(Parallel::getWorkerCount(10, 1000), 1u);
+    EXPECT_EQ(Parallel::getWorkerCount(0, 1000), 1u);
+}
+
+// ============================================================================
+// 法线生成测试
+// ============================================================================
+
+TEST(MeshNormalsTest, FlatGridPointsUp) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(8, vertices, indices);
+    for (auto& v : vertices) v.normal = glm::vec3(0.0f);
+
+    MeshUtils::calculateNormals(vertices, indices);
+
+    for (const auto& v : vertices) {
+        EXPECT_NEAR(v.normal.y, 1.0f, 1e-5f);
+    }
+}
+
+TEST(MeshNormalsTest, SmoothCubeCornersPointDiagonally) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildSharedCube(vertices, indices);
+
+    MeshUtils::calculateNormals(vertices, indices);
+
+    // 角度加权后每个角点的三个面贡献相同，法线沿对角线
+    float expected = 1.0f / std::sqrt(3.0f);
+    for (const auto& v : vertices) {
+        EXPECT_NEAR(std::fabs(v.normal.x), expected, 1e-4f);
+        EXPECT_NEAR(std::fabs(v.normal.y), expected, 1e-4f);
+        EXPECT_NEAR(std::fabs(v.normal.z), expected, 1e-4f);
+        EXPECT_GT(glm::dot(v.normal, v.position), 0.0f);
+    }
+}
+
+TEST(MeshNormalsTest, UvSeamVerticesShareNormal) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildCube(vertices, indices);
+
+    // 按位置焊接：不同面上同一角点得到相同的平滑法线
+    MeshUtils::calculateNormals(vertices, indices);
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        for (size_t j = i + 1; j < vertices.size(); ++j) {
+            if (vertices[i].position == vertices[j].position) {
+                EXPECT_NEAR(glm::dot(vertices[i].normal, vertices[j].normal), 1.0f, 1e-5f);
+            }
+        }
+    }
+}
+
+TEST(MeshNormalsTest, CreaseAngleKeepsHardEdges) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildSharedCube(vertices, indices);
+
+    MeshUtils::calculateNormals(vertices, indices, 60.0f);
+
+    // 8 个角点各被 3 个面以不同法线引用，拆分为 24 个顶点
+    EXPECT_EQ(vertices.size(), 24u);
+    ASSERT_EQ(indices.size(), 36u);
+
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        const glm::vec3& p0 = vertices[indices[t * 3]].position;
+        const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+        const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+        glm::vec3 face = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+        for (int k = 0; k < 3; ++k) {
+            EXPECT_NEAR(glm::dot(vertices[indices[t * 3 + k]].normal, face), 1.0f, 1e-5f);
+        }
+    }
+}
+
+TEST(MeshNormalsTest, KeepNormalsLeavesMarkedVerticesUntouched) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildSharedCube(vertices, indices);
+    const glm::vec3 custom(0.0f, 0.0f, 1.0f);
+    vertices[7].normal = custom;
+    std::vector<char> keep(vertices.size(), 0);
+    keep[7] = 1;
+
+    MeshUtils::calculateNormals(vertices, indices, 60.0f, &keep);
+
+    // 顶点 7 既不改写也不拆分，其余 7 个角点仍按面拆分
+    EXPECT_EQ(vertices[7].normal, custom);
+    EXPECT_EQ(vertices.size(), 8u + 7u * 2u);
+    EXPECT_EQ(std::count(indices.begin(), indices.end(), 7u), 4);
+
+    std::vector<Vertex> smooth;
+    std::vector<unsigned int> smoothIndices;
+    buildSharedCube(smooth, smoothIndices);
+    smooth[7].normal = custom;
+    MeshUtils::calculateNormals(smooth, smoothIndices, &keep);
+    EXPECT_EQ(smooth[7].normal, custom);
+    EXPECT_NEAR(glm::length(smooth[0].normal), 1.0f, 1e-5f);
+}
+
+TEST(MeshNormalsTest, CreaseAngleAboveFaceAngleSmooths) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildSharedCube(vertices, indices);
+
+    MeshUtils::calculateNormals(vertices, indices, 120.0f);
+
+    EXPECT_EQ(vertices.size(), 8u);
+}
+
+TEST(MeshNormalsTest, DegenerateTrianglesIgnored) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(2, vertices, indices);
+    for (auto& v : vertices) v.normal = glm::vec3(0.0f);
+
+    // 追加一个零面积三角形和一个越界三角形
+    indices.push_back(0);
+    indices.push_back(0);
+    indices.push_back(1);
+    indices.push_back(0);
+    indices.push_back(1);
+    indices.push_back(999);
+
+    MeshUtils::calculateNormals(vertices, indices);
+
+    for (const auto& v : vertices) {
+        EXPECT_FALSE(std::isnan(v.normal.x));
+        EXPECT_NEAR(v.normal.y, 1.0f, 1e-5f);
+    }
+}
+
+TEST(MeshNormalsTest, LargeMeshMatchesAcrossWorkers) {
+    // 强制多个 worker 以覆盖每线程累加 + 归约路径，结果应与解析法线一致
+    Parallel::setMaxWorkers(4);
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(300, vertices, indices);
+    for (auto& v : vertices) {
+        v.position.y = 0.25f * std::sin(v.position.x * 6.0f);
+        v.normal = glm::vec3(0.0f);
+    }
+
+    MeshUtils::calculateNormals(vertices, indices);
+
+    for (const auto& v : vertices) {
+        float slope = 1.5f * std::cos(v.position.x * 6.0f);
+        glm::vec3 analytic = glm::normalize(glm::vec3(-slope, 1.0f, 0.0f));
+        if (v.position.x > 0.01f && v.position.x < 0.99f) {
+            EXPECT_GT(glm::dot(v.normal, analytic), 0.999f);
+        }
+    }
+    Parallel::setMaxWorkers(0);
+}
+
+TEST(MeshNormalsTest, WorkerCountDoesNotChangeResult) {
+    std::vector<Vertex> single;
+    std::vector<unsigned int> indices;
+    buildGrid(200, single, indices);
+    for (auto& v : single) v.position.y = 0.1f * std::cos(v.position.z * 9.0f);
+    std::vector<Vertex> multi = single;
+    std::vector<unsigned int> singleIndices = indices;
+    std::vector<unsigned int> multiIndices = indices;
+
+    Parallel::setMaxWorkers(1);
+    MeshUtils::calculateNormals(single, singleIndices, 45.0f);
+    MeshUtils::calculateTangentsAndBitangents(single, singleIndices);
+    Parallel::setMaxWorkers(3);
+    MeshUtils::calculateNormals(multi, multiIndices, 45.0f);
+    MeshUtils::calculateTangentsAndBitangents(multi, multiIndices);
+    Parallel::setMaxWorkers(0);
+
+    ASSERT_EQ(single.size(), multi.size());
+    EXPECT_EQ(singleIndices, multiIndices);
+    for (size_t i = 0; i < single.size(); ++i) {
+        EXPECT_NEAR(glm::dot(single[i].normal, multi[i].normal), 1.0f, 1e-5f);
+        EXPECT_NEAR(glm::dot(single[i].tangent, multi[i].tangent), 1.0f, 1e-4f);
+    }
+}
+
+// ============================================================================
+// 切线生成测试
+// ============================================================================
+
+TEST(MeshTangentsTest, GridTangentFollowsU) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(4, vertices, indices);
+
+    MeshUtils::calculateTangentsAndBitangents(vertices, indices);
+
+    for (const auto& v : vertices) {
+        EXPECT_NEAR(v.tangent.x, 1.0f, 1e-5f);
+        EXPECT_NEAR(v.bitangent.z, 1.0f, 1e-5f);
+        EXPECT_NEAR(glm::dot(v.tangent, v.normal), 0.0f, 1e-5f);
+    }
+}
+
+TEST(MeshTangentsTest, MirroredUvFlipsHandedness) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(4, vertices, indices);
+    for (auto& v : vertices) v.texCoords.y = 1.0f - v.texCoords.y;
+
+    MeshUtils::calculateTangentsAndBitangents(vertices, indices);
+
+    for (const auto& v : vertices) {
+        EXPECT_NEAR(v.tangent.x, 1.0f, 1e-5f);
+        EXPECT_NEAR(v.bitangent.z, -1.0f, 1e-5f);
+    }
+}
+
+TEST(MeshTangentsTest, MissingUvsStillOrthonormal) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(2, vertices, indices);
+    for (auto& v : vertices) v.texCoords = glm::vec2(0.0f);
+
+    MeshUtils::calculateTangentsAndBitangents(vertices, indices);
+
+    for (const auto& v : vertices) {
+        EXPECT_NEAR(glm::length(v.tangent), 1.0f, 1e-5f);
+        EXPECT_NEAR(glm::dot(v.tangent, v.normal), 0.0f, 1e-5f);
+    }
+}
+
+// ============================================================================
+// 合批测试
+// ============================================================================
+
+TEST(MeshMergeTest, CoalesceJoinsAdjacentRangesWithSameMaterial) {
+    auto stone = std::make_shared<CMaterial>("Stone");
+    auto wood = std::make_shared<CMaterial>("Wood");
+    std::vector<MeshUtils::SubMesh> subMeshes(4);
+    const size_t counts[4] = { 6, 12, 36, 6 };
+    const std::shared_ptr<CMaterial> materials[4] = { stone, stone, wood, stone };
+    size_t firstIndex = 0, baseVertex = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        subMeshes[i].firstIndex = firstIndex;
+        subMeshes[i].indexCount = counts[i];
+        subMeshes[i].baseVertex = baseVertex;
+        subMeshes[i].vertexCount = counts[i] / 2;
+        subMeshes[i].material = materials[i];
+        firstIndex += counts[i];
+        baseVertex += counts[i] / 2;
+    }
+
+    std::vector<MeshUtils::SubMesh> draws = MeshUtils::coalesceSubMeshes(subMeshes);
+    ASSERT_EQ(draws.size(), 3u);
+    EXPECT_EQ(draws[0].material, stone);
+    EXPECT_EQ(draws[0].firstIndex, 0u);
+    EXPECT_EQ(draws[0].indexCount, 18u);
+    EXPECT_EQ(draws[0].vertexCount, 9u);
+    EXPECT_EQ(draws[1].material, wood);
+    EXPECT_EQ(draws[2].firstIndex, 54u);
+}
+
+// 需要 OpenGL 上下文
+TEST(MeshMergeTest, DISABLED_SubMeshTableAndRebasedIndices) {
+    std::vector<Vertex> cubeVertices;
+    std::vector<unsigned int> cubeIndices;
+    buildCube(cubeVertices, cubeIndices);
+    auto cube = std::make_shared<CMesh>(cubeVertices, cubeIndices);
+    cube->setMaterial(std::make_shared<CMaterial>("Cube"));
+    // 无索引的三角形在合并结果中补上顺序索引
+    auto triangle = std::make_shared<CMesh>(std::vector<Vertex>{
+        Vertex(glm::vec3(0.0f)), Vertex(glm::vec3(1.0f, 0.0f, 0.0f)), Vertex(glm::vec3(0.0f, 1.0f, 0.0f)) });
+
+    std::vector<MeshUtils::SubMesh> subMeshes;
+    auto merged = MeshUtils::mergeMeshes({ cube, triangle }, std::vector<glm::mat4>(), subMeshes);
+    ASSERT_TRUE(merged);
+    ASSERT_EQ(subMeshes.size(), 2u);
+    EXPECT_EQ(merged->getVertexCount(), 27u);
+    EXPECT_EQ(merged->getIndexCount(), 39u);
+
+    EXPECT_EQ(subMeshes[0].material, cube->getMaterial());
+    EXPECT_EQ(subMeshes[1].firstIndex, 36u);
+    EXPECT_EQ(subMeshes[1].indexCount, 3u);
+    EXPECT_EQ(subMeshes[1].baseVertex, 24u);
+    EXPECT_EQ(merged->getIndices()[5], cubeIndices[5]);
+    EXPECT_EQ(merged->getIndices()[36], 24u);
+    EXPECT_EQ(merged->getIndices()[38], 26u);
+}
+
+// 需要 OpenGL 上下文
+TEST(MeshMergeTest, DISABLED_TransformedMergeMatchesAcrossWorkers) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(64, vertices, indices);
+    auto grid = std::make_shared<CMesh>(vertices, indices);
+
+    std::vector<std::shared_ptr<CMesh>> meshes(40, grid);
+    std::vector<glm::mat4> transforms;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        transforms.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i) * 2.0f, 0.0f, 0.0f)));
+    }
+
+    std::vector<MeshUtils::SubMesh> singleTable, multiTable;
+    Parallel::setMaxWorkers(1);
+    auto single = MeshUtils::mergeMeshes(meshes, transforms, singleTable);
+    Parallel::setMaxWorkers(4);
+    auto multi = MeshUtils::mergeMeshes(meshes, transforms, multiTable);
+    Parallel::setMaxWorkers(0);
+
+    ASSERT_TRUE(single && multi);
+    EXPECT_EQ(single->getIndices(), multi->getIndices());
+    ASSERT_EQ(single->getVertexCount(), multi->getVertexCount());
+    for (size_t i = 0; i < single->getVertexCount(); ++i) {
+        ASSERT_EQ(single->getVertices()[i].position, multi->getVertices()[i].position);
+    }
+    size_t last = meshes.size() - 1;
+    const Vertex& moved = multi->getVertices()[multiTable[last].baseVertex];
+    EXPECT_FLOAT_EQ(moved.position.x, vertices[0].position.x + last * 2.0f);
+}
+
+// ============================================================================
+// Loop 细分测试
+// ============================================================================
+
+namespace {
+
+// 单位八面体：6 个顶点、12 条边、8 个三角形，封闭流形
+void buildOctahedron(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    const glm::vec3 points[6] = { {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1} };
+    for (const auto& p : points) vertices.push_back(Vertex(p));
+    indices = { 0, 2, 4,  2, 1, 4,  1, 3, 4,  3, 0, 4,
+                2, 0, 5,  1, 2, 5,  3, 1, 5,  0, 3, 5 };
+}
+
+} // namespace
+
+TEST(MeshSubdivisionTest, ClosedMeshFollowsClosedFormGrowth) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildOctahedron(vertices, indices);
+
+    ASSERT_TRUE(MeshUtils::subdivideLoop(vertices, indices, 2));
+    // V1 = 6 + 12 = 18，E1 = 2 * 12 + 3 * 8 = 48，V2 = 18 + 48 = 66
+    EXPECT_EQ(indices.size(), 8u * 16u * 3u);
+    EXPECT_EQ(vertices.size(), 66u);
+
+    // 仍然封闭：每条边恰好被两个三角形引用
+    std::map<std::pair<unsigned int, unsigned int>, int> edgeUses;
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            unsigned int a = indices[t * 3 + k], b = indices[t * 3 + (k + 1) % 3];
+            ++edgeUses[std::make_pair(std::min(a, b), std::max(a, b))];
+        }
+    }
+    EXPECT_EQ(edgeUses.size(), 48u * 2u + 3u * 32u);
+    for (const auto& use : edgeUses) {
+        ASSERT_EQ(use.second, 2);
+    }
+
+    // 凸控制网格的细分结果收缩在控制网格内部
+    for (const auto& v : vertices) {
+        float r = glm::length(v.position);
+        EXPECT_LT(r, 1.0f);
+        EXPECT_GT(r, 0.4f);
+        EXPECT_NEAR(glm::length(v.normal), 1.0f, 1e-4f);
+    }
+}
+
+TEST(MeshSubdivisionTest, AdjacentTrianglesShareEdgeVertex) {
+    std::vector<Vertex> vertices = {
+        Vertex(glm::vec3(0, 0, 0), glm::vec3(0), glm::vec2(0, 0)),
+        Vertex(glm::vec3(1, 0, 0), glm::vec3(0), glm::vec2(1, 0)),
+        Vertex(glm::vec3(1, 1, 0), glm::vec3(0), glm::vec2(1, 1)),
+        Vertex(glm::vec3(0, 1, 0), glm::vec3(0), glm::vec2(0, 1))
+    };
+    std::vector<unsigned int> indices = { 0, 1, 2, 2, 3, 0 };
+
+    ASSERT_TRUE(MeshUtils::subdivideLoop(vertices, indices, 1));
+    // 5 条边（对角线共享）→ 4 + 5 个顶点
+    EXPECT_EQ(vertices.size(), 9u);
+    EXPECT_EQ(indices.size(), 24u);
+
+    // 边界边的新顶点取中点，纹理坐标线性插值
+    bool foundBottomMidpoint = false;
+    for (size_t i = 4; i < vertices.size(); ++i) {
+        if (glm::length(vertices[i].position - glm::vec3(0.5f, 0.0f, 0.0f)) < 1e-6f) {
+            foundBottomMidpoint = true;
+            EXPECT_NEAR(vertices[i].texCoords.x, 0.5f, 1e-6f);
+            EXPECT_NEAR(vertices[i].texCoords.y, 0.0f, 1e-6f);
+        }
+        EXPECT_NEAR(vertices[i].position.z, 0.0f, 1e-6f);
+    }
+    EXPECT_TRUE(foundBottomMidpoint);
+}
+
+TEST(MeshSubdivisionTest, RegularInteriorVerticesStayOnPlane) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(8, vertices, indices);
+    std::vector<Vertex> original = vertices;
+
+    ASSERT_TRUE(MeshUtils::subdivideLoop(vertices, indices, 1));
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        EXPECT_NEAR(vertices[i].position.y, 0.0f, 1e-6f);
+        EXPECT_NEAR(vertices[i].normal.y, 1.0f, 1e-5f);
+    }
+    // 规则网格内部的 6 度顶点一环邻居关于自身对称，位置不变
+    const unsigned int interior = 4 * 9 + 4;
+    EXPECT_NEAR(vertices[interior].position.x, original[interior].position.x, 1e-6f);
+    EXPECT_NEAR(vertices[interior].position.z, original[interior].position.z, 1e-6f);
+}
+
+TEST(MeshSubdivisionTest, WorkerCountDoesNotChangeResult) {
+    std::vector<Vertex> single;
+    std::vector<unsigned int> singleIndices;
+    buildGrid(160, single, singleIndices);
+    for (auto& v : single) v.position.y = 0.2f * std::sin(v.position.x * 7.0f) * std::cos(v.position.z * 5.0f);
+    std::vector<Vertex> multi = single;
+    std::vector<unsigned int> multiIndices = singleIndices;
+
+    Parallel::setMaxWorkers(1);
+    ASSERT_TRUE(MeshUtils::subdivideLoop(single, singleIndices, 2));
+    Parallel::setMaxWorkers(4);
+    ASSERT_TRUE(MeshUtils::subdivideLoop(multi, multiIndices, 2));
+    Parallel::setMaxWorkers(0);
+
+    EXPECT_EQ(singleIndices, multiIndices);
+    ASSERT_EQ(single.size(), multi.size());
+    for (size_t i = 0; i < single.size(); ++i) {
+        ASSERT_EQ(single[i].position, multi[i].position) << "vertex " << i;
+    }
+}
+
+TEST(MeshSubdivisionTest, InvalidInputLeftUnchanged) {
+    std::vector<Vertex> vertices = { Vertex(glm::vec3(0.0f)), Vertex(glm::vec3(1.0f)) };
+    std::vector<unsigned int> indices = { 0, 1, 2 };
+    EXPECT_FALSE(MeshUtils::subdivideLoop(vertices, indices, 1));
+    EXPECT_EQ(vertices.size(), 2u);
+    EXPECT_EQ(indices.size(), 3u);
+
+    // 0 层直接返回
+    indices = { 0, 1, 1 };
+    EXPECT_TRUE(MeshUtils::subdivideLoop(vertices, indices, 0));
+    EXPECT_EQ(indices.size(), 3u);
+}
+
+// ============================================================================
+// 几何体缓存测试
+// ============================================================================
+
+// 需要 OpenGL 上下文
+TEST(PrimitiveCacheTest, DISABLED_ThousandsOfSpheresUploadOncePerSize) {
+    MeshUtils::clearPrimitiveCache();
+    std::vector<std::shared_ptr<CMesh>> spheres;
+    const float radii[3] = { 0.5f, 1.0f, 2.0f };
+    for (int i = 0; i < 3000; ++i) {
+        spheres.push_back(MeshUtils::createSphere(radii[i % 3], 24));
+    }
+
+    MeshUtils::PrimitiveCacheStats stats = MeshUtils::getPrimitiveCacheStats();
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.hits, 2997u);
+    EXPECT_EQ(stats.liveEntries, 3u);
+    EXPECT_TRUE(spheres[0]->sharesGeometryWith(*spheres[3]));
+    EXPECT_FALSE(spheres[0]->sharesGeometryWith(*spheres[1]));
+    EXPECT_NE(spheres[0].get(), spheres[3].get());
+
+    // 材质各自独立
+    spheres[0]->setMaterial(std::make_shared<CMaterial>());
+    EXPECT_FALSE(spheres[3]->hasMaterial());
+}
+
+// 需要 OpenGL 上下文
+TEST(PrimitiveCacheTest, DISABLED_UnusedPrimitivesAreFreed) {
+    MeshUtils::clearPrimitiveCache();
+    {
+        auto a = MeshUtils::createTorus(1.0f, 0.5f, 16, 16);
+        auto b = MeshUtils::createTorus(1.0f, 0.5f, 16, 16);
+        EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().liveEntries, 1u);
+    }
+    EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().liveEntries, 0u);
+
+    // 全部销毁后重新生成
+    auto c = MeshUtils::createTorus(1.0f, 0.5f, 16, 16);
+    EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().misses, 2u);
+    EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().hits, 1u);
+}
+
+// 需要 OpenGL 上下文
+TEST(PrimitiveCacheTest, DISABLED_ModifiedCopyDoesNotAffectCache) {
+    MeshUtils::clearPrimitiveCache();
+    auto a = MeshUtils::createPlane(2.0f, 2.0f, 4, 4);
+    auto b = MeshUtils::createPlane(2.0f, 2.0f, 4, 4);
+    std::vector<Vertex> moved = a->getVertices();
+    for (auto& v : moved) v.position.y = 1.0f;
+    a->updateVertexData(moved);
+
+    EXPECT_FALSE(a->sharesGeometryWith(*b));
+    EXPECT_EQ(b->getVertices()[0].position.y, 0.0f);
+    EXPECT_EQ(MeshUtils::createPlane(2.0f, 2.0f, 4, 4)->getVertices()[0].position.y, 0.0f);
+
+    // 缓存的几何数据释放 CPU 数据后，下次重新生成
+    b->releaseCpuData();
+    auto c = MeshUtils::createPlane(2.0f, 2.0f, 4, 4);
+    EXPECT_FALSE(c->isCpuDataReleased());
+    EXPECT_FALSE(c->sharesGeometryWith(*b));
+    EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().misses, 2u);
+}
+
+// 需要 OpenGL 上下文
+TEST(PrimitiveCacheTest, DISABLED_DifferentParametersAndDisabledCache) {
+    MeshUtils::clearPrimitiveCache();
+    auto a = MeshUtils::createCylinder(1.0f, 2.0f, 16);
+    auto b = MeshUtils::createCylinder(1.0f, 2.0f, 17);
+    auto c = MeshUtils::createCone(1.0f, 2.0f, 16);
+    EXPECT_FALSE(a->sharesGeometryWith(*b));
+    EXPECT_FALSE(a->sharesGeometryWith(*c));
+    EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().misses, 3u);
+
+    MeshUtils::setPrimitiveCacheEnabled(false);
+    auto d = MeshUtils::createCylinder(1.0f, 2.0f, 16);
+    MeshUtils::setPrimitiveCacheEnabled(true);
+    EXPECT_FALSE(a->sharesGeometryWith(*d));
+    EXPECT_EQ(d->getGeometryUseCount(), 1);
+    EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().hits, 0u);
+}
+
+// 需要 OpenGL 上下文
+TEST(PrimitiveCacheTest, DISABLED_RingGenerationMatchesAcrossWorkers) {
+    MeshUtils::setPrimitiveCacheEnabled(false);
+    Parallel::setMaxWorkers(1);
+    auto sphereSingle = MeshUtils::createSphere(1.0f, 256);
+    auto capsuleSingle = MeshUtils::createCapsule(1.0f, 2.0f, 256);
+    Parallel::setMaxWorkers(4);
+    auto sphereMulti = MeshUtils::createSphere(1.0f, 256);
+    auto capsuleMulti = MeshUtils::createCapsule(1.0f, 2.0f, 256);
+    Parallel::setMaxWorkers(0);
+    MeshUtils::setPrimitiveCacheEnabled(true);
+
+    EXPECT_EQ(sphereSingle->getIndices(), sphereMulti->getIndices());
+    EXPECT_EQ(capsuleSingle->getIndices(), capsuleMulti->getIndices());
+    ASSERT_EQ(sphereSingle->getVertexCount(), 257u * 257u);
+    ASSERT_EQ(capsuleSingle->getVertexCount(), 257u * (2u * 128u + 4u));
+    for (size_t i = 0; i < sphereSingle->getVertexCount(); ++i) {
+        ASSERT_EQ(sphereSingle->getVertices()[i].position, sphereMulti->getVertices()[i].position);
+    }
+    for (size_t i = 0; i < capsuleSingle->getVertexCount(); ++i) {
+        ASSERT_EQ(capsuleSingle->getVertices()[i].position, capsuleMulti->getVertices()[i].position);
+    }
+    for (unsigned int index : capsuleSingle->getIndices()) {
+        ASSERT_LT(index, capsuleSingle->getVertexCount());
+    }
+}
+
+// 需要 OpenGL 上下文
+TEST(PrimitiveCacheTest, DISABLED_StaticTablesUploadWithoutCpuCopy) {
+    MeshUtils::clearPrimitiveCache();
+    auto sphere = MeshUtils::createStaticSphere(32);
+    ASSERT_NE(sphere, nullptr);
+    EXPECT_TRUE(sphere->isCpuDataReleased());
+    EXPECT_EQ(sphere->getCpuMemoryUsage(), 0u);
+    EXPECT_EQ(sphere->getVertexCount(), 33u * 33u);
+    EXPECT_EQ(sphere->getIndexCount(), 32u * 32u * 6u);
+    EXPECT_EQ(sphere->getVertexStride(), 32u);
+    EXPECT_NEAR(sphere->getBoundingBox().max.y, 1.0f, 1e-6f);
+
+    // 静态网格没有 CPU 数据也会命中缓存
+    auto again = MeshUtils::createStaticSphere(32);
+    EXPECT_TRUE(again->sharesGeometryWith(*sphere));
+    EXPECT_EQ(MeshUtils::getPrimitiveCacheStats().misses, 1u);
+
+    EXPECT_EQ(MeshUtils::createStaticSphere(24), nullptr);
+    EXPECT_EQ(MeshUtils::createStaticCube()->getIndexCount(), 36u);
+    EXPECT_EQ(MeshUtils::createStaticTorus(16)->getVertexCount(), 17u * 17u);
+}
+
+// 需要 OpenGL 上下文
+TEST(PrimitiveCacheTest, DISABLED_TableBackedGeneratorsScale) {
+    MeshUtils::setPrimitiveCacheEnabled(false);
+    auto cube = MeshUtils::createCube(3.0f);
+    auto sphere = MeshUtils::createSphere(2.0f, 32);
+    auto torus = MeshUtils::createTorus(4.0f, 2.0f, 32, 32);
+    MeshUtils::setPrimitiveCacheEnabled(true);
+
+    EXPECT_EQ(cube->getBoundingBox().max, glm::vec3(1.5f));
+    EXPECT_NEAR(sphere->getBoundingBox().max.y, 2.0f, 1e-6f);
+    EXPECT_NEAR(torus->getBoundingBox().max.x, 4.0f, 1e-5f);
+    EXPECT_NEAR(torus->getBoundingBox().max.y, 1.0f, 1e-5f);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file test_primitive_tables.cpp
+ * @brief Unit tests for compile-time primitive tables (no OpenGL context)
+ */
+
+// Windows compatibility for M_PI
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include "mesh/PrimitiveTables.h"
+
+using PrimitiveTables::StaticVertex;
+using PrimitiveTables::TableView;
+
+// 生成函数在编译期求值
+static_assert(PrimitiveTables::makeCube().vertices[0].position[0] == -0.5f, "cube table is constexpr");
+static_assert(PrimitiveTables::makeSphere<4>().indices[0] == 5, "sphere table is constexpr");
+static_assert(PrimitiveTables::detail::sin(0.0) == 0.0, "constexpr sin");
+
+namespace {
+
+glm::vec3 positionOf(const StaticVertex& v) { return glm::vec3(v.position[0], v.position[1], v.position[2]); }
+glm::vec3 normalOf(const StaticVertex& v) { return glm::vec3(v.normal[0], v.normal[1], v.normal[2]); }
+
+} // namespace
+
+TEST(PrimitiveTablesTest, ConstexprTrigMatchesStd) {
+    for (int i = -40; i <= 40; ++i) {
+        double x = i * 0.37;
+        EXPECT_NEAR(PrimitiveTables::detail::sin(x), std::sin(x), 1e-14) << x;
+        EXPECT_NEAR(PrimitiveTables::detail::cos(x), std::cos(x), 1e-14) << x;
+    }
+}
+
+TEST(PrimitiveTablesTest, CubeFacesPointOutward) {
+    TableView cube = PrimitiveTables::cube();
+    ASSERT_EQ(cube.vertexCount, 24u);
+    ASSERT_EQ(cube.indexCount, 36u);
+
+    for (size_t t = 0; t < cube.indexCount / 3; ++t) {
+        glm::vec3 p0 = positionOf(cube.vertices[cube.indices[t * 3]]);
+        glm::vec3 p1 = positionOf(cube.vertices[cube.indices[t * 3 + 1]]);
+        glm::vec3 p2 = positionOf(cube.vertices[cube.indices[t * 3 + 2]]);
+        glm::vec3 faceNormal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+        glm::vec3 vertexNormal = normalOf(cube.vertices[cube.indices[t * 3]]);
+        EXPECT_NEAR(glm::dot(faceNormal, vertexNormal), 1.0f, 1e-6f) << "triangle " << t;
+        EXPECT_NEAR(glm::dot(p0, vertexNormal), 0.5f, 1e-6f);
+    }
+    for (int c = 0; c < 3; ++c) {
+        EXPECT_EQ(cube.boundsMin[c], -0.5f);
+        EXPECT_EQ(cube.boundsMax[c], 0.5f);
+    }
+
+    // 后面从外侧看不镜像：x 最小的角 u = 1
+    const StaticVertex& back = cube.vertices[4];
+    EXPECT_EQ(positionOf(back), glm::vec3(0.5f, -0.5f, -0.5f));
+    EXPECT_EQ(back.texCoords[0], 0.0f);
+    EXPECT_EQ(cube.vertices[5].position[0], -0.5f);
+    EXPECT_EQ(cube.vertices[5].texCoords[0], 1.0f);
+}
+
+TEST(PrimitiveTablesTest, SphereMatchesRuntimeTrig) {
+    const unsigned int levels[3] = { 16, 32, 64 };
+    for (unsigned int segments : levels) {
+        TableView sphere = PrimitiveTables::sphere(segments);
+        ASSERT_EQ(sphere.vertexCount, (segments + 1u) * (segments + 1u));
+        ASSERT_EQ(sphere.indexCount, segments * segments * 6u);
+
+        for (unsigned int y = 0; y <= segments; ++y) {
+            for (unsigned int x = 0; x <= segments; ++x) {
+                float xSegment = (float)x / (float)segments;
+                float ySegment = (float)y / (float)segments;
+                glm::vec3 expected(std::cos(xSegment * 2.0f * M_PI) * std::sin(ySegment * M_PI),
+                                   std::cos(ySegment * M_PI),
+                                   std::sin(xSegment * 2.0f * M_PI) * std::sin(ySegment * M_PI));
+                const StaticVertex& v = sphere.vertices[y * (segments + 1) + x];
+                ASSERT_NEAR(glm::length(positionOf(v) - expected), 0.0f, 1e-6f) << segments << ": " << x << ", " << y;
+                EXPECT_EQ(v.texCoords[0], xSegment);
+                EXPECT_EQ(v.texCoords[1], ySegment);
+            }
+        }
+        for (size_t i = 0; i < sphere.indexCount; ++i) {
+            ASSERT_LT(sphere.indices[i], sphere.vertexCount);
+        }
+        EXPECT_NEAR(sphere.boundsMax[1], 1.0f, 1e-6f);
+        EXPECT_NEAR(sphere.boundsMin[1], -1.0f, 1e-6f);
+    }
+}
+
+TEST(PrimitiveTablesTest, TorusMatchesRuntimeTrig) {
+    TableView torus = PrimitiveTables::torus(32);
+    ASSERT_EQ(torus.vertexCount, 33u * 33u);
+    for (unsigned int ring = 0; ring <= 32; ++ring) {
+        for (unsigned int side = 0; side <= 32; ++side) {
+            float theta = static_cast<float>(ring) / 32 * 2.0f * M_PI;
+            float phi = static_cast<float>(side) / 32 * 2.0f * M_PI;
+            glm::vec3 expected((0.75f + 0.25f * std::cos(phi)) * std::cos(theta),
+                               0.25f * std::sin(phi),
+                               (0.75f + 0.25f * std::cos(phi)) * std::sin(theta));
+            const StaticVertex& v = torus.vertices[ring * 33 + side];
+            ASSERT_NEAR(glm::length(positionOf(v) - expected), 0.0f, 1e-6f);
+            ASSERT_NEAR(glm::length(normalOf(v)), 1.0f, 1e-6f);
+        }
+    }
+    // 第一个四边形连接第 0 环与第 1 环
+    EXPECT_EQ(torus.indices[0], 0u);
+    EXPECT_EQ(torus.indices[1], 33u);
+    EXPECT_EQ(torus.indices[2], 1u);
+}
+
+TEST(PrimitiveTablesTest, UnsupportedLevelsAreEmpty) {
+    EXPECT_TRUE(PrimitiveTables::sphere(24).empty());
+    EXPECT_TRUE(PrimitiveTables::torus(64).empty());
+    EXPECT_FALSE(PrimitiveTables::sphere(32).empty());
+}
+
+TEST(PrimitiveTablesTest, CopyToScalesPositions) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    PrimitiveTables::copyTo(PrimitiveTables::cube(), 2.0f, vertices, indices);
+    ASSERT_EQ(vertices.size(), 24u);
+    ASSERT_EQ(indices.size(), 36u);
+    EXPECT_EQ(vertices[0].position, glm::vec3(-1.0f, -1.0f, 1.0f));
+    EXPECT_EQ(vertices[0].normal, glm::vec3(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(vertices[2].texCoords, glm::vec2(1.0f, 1.0f));
+}
@@ -0,0 +1,101 @@
+/**
+ * @file test_spherical_harmonics.cpp
+ * @brief Unit tests for L2 spherical harmonics projection of cubemaps
+ */
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <vector>
+#include "lighting/SphericalHarmonics.h"
+#include "mesh/ImageKernels.h"
+#include "skybox/HdrCubemap.h"
+
+namespace {
+
+// 按方向函数填充立方体贴图（与 HdrCubemap 使用同一面约定）
+void fillCubemap(int size, const std::function<glm::vec3(const glm::vec3&)>& radiance, std::vector<float> faces[6]) {
+    for (int face = 0; face < 6; ++face) {
+        faces[face].resize(static_cast<size_t>(size) * size * 3);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                float s = (x + 0.5f) * 2.0f / size - 1.0f;
+                float t = (y + 0.5f) * 2.0f / size - 1.0f;
+                glm::vec3 value = radiance(HdrCubemap::getFaceDirection(face, s, t));
+                size_t index = (static_cast<size_t>(y) * size + x) * 3;
+                faces[face][index + 0] = value.r;
+                faces[face][index + 1] = value.g;
+                faces[face][index + 2] = value.b;
+            }
+        }
+    }
+}
+
+void expectNear(const glm::vec3& a, const glm::vec3& b, float tolerance) {
+    EXPECT_NEAR(a.x, b.x, tolerance);
+    EXPECT_NEAR(a.y, b.y, tolerance);
+    EXPECT_NEAR(a.z, b.z, tolerance);
+}
+
+const glm::vec3 kNormals[] = {
+    glm::vec3(1, 0, 0), glm::vec3(0, -1, 0), glm::vec3(0, 0, 1),
+    glm::vec3(0.6f, 0.8f, 0.0f), glm::vec3(-0.48f, 0.6f, 0.64f)
+};
+
+} // namespace
+
+TEST(SphericalHarmonicsTest, ConstantEnvironmentGivesConstantIrradiance) {
+    std::vector<float> faces[6];
+    fillCubemap(8, [](const glm::vec3&) { return glm::vec3(0.5f, 1.0f, 2.0f); }, faces);
+
+    SHCoefficients sh = SphericalHarmonics::projectCubemap(faces, 8);
+    for (int i = 1; i < SHCoefficients::Count; ++i) expectNear(sh.coefficients[i], glm::vec3(0.0f), 1e-4f);
+
+    // 均匀环境下白色朗伯表面的出射辐亮度等于环境辐亮度
+    SphericalHarmonics::convolveIrradiance(sh);
+    for (const glm::vec3& n : kNormals) {
+        expectNear(SphericalHarmonics::evaluate(sh, n), glm::vec3(0.5f, 1.0f, 2.0f), 1e-4f);
+    }
+}
+
+TEST(SphericalHarmonicsTest, MatchesAnalyticIrradiance) {
+    // L = 1 + y + xz 只含 0~2 阶：E / pi = 1 + (2/3) y + (1/4) xz
+    std::vector<float> faces[6];
+    fillCubemap(32, [](const glm::vec3& d) { return glm::vec3(1.0f + d.y + d.x * d.z); }, faces);
+
+    SHCoefficients sh = SphericalHarmonics::projectCubemap(faces, 32);
+    SphericalHarmonics::convolveIrradiance(sh);
+    for (const glm::vec3& n : kNormals) {
+        float expected = 1.0f + 2.0f / 3.0f * n.y + 0.25f * n.x * n.z;
+        expectNear(SphericalHarmonics::evaluate(sh, n), glm::vec3(expected), 2e-3f);
+    }
+}
+
+TEST(SphericalHarmonicsTest, SimdMatchesScalar) {
+    // 宽度 6 覆盖 4 像素主循环与标量尾部
+    std::vector<float> faces[6];
+    fillCubemap(6, [](const glm::vec3& d) { return glm::vec3(d.x * d.x, 0.5f + d.y, d.z > 0.0f ? 3.0f : 0.0f); }, faces);
+
+    ImageKernels::SimdLevel previous = ImageKernels::getActiveLevel();
+    ImageKernels::setActiveLevel(ImageKernels::SimdLevel::Scalar);
+    SHCoefficients scalar = SphericalHarmonics::projectCubemap(faces, 6);
+    ImageKernels::setActiveLevel(ImageKernels::SimdLevel::AVX2);
+    SHCoefficients simd = SphericalHarmonics::projectCubemap(faces, 6);
+    ImageKernels::setActiveLevel(previous);
+
+    for (int i = 0; i < SHCoefficients::Count; ++i) expectNear(simd.coefficients[i], scalar.coefficients[i], 1e-4f);
+}
+
+TEST(SphericalHarmonicsTest, BrightSkyLightsUpwardNormals) {
+    std::vector<float> faces[6];
+    fillCubemap(16, [](const glm::vec3& d) { return glm::vec3(d.y > 0.0f ? 1.0f : 0.1f); }, faces);
+
+    SHCoefficients sh = SphericalHarmonics::projectCubemap(faces, 16);
+    SphericalHarmonics::convolveIrradiance(sh);
+    float up = SphericalHarmonics::evaluate(sh, glm::vec3(0, 1, 0)).r;
+    float side = SphericalHarmonics::evaluate(sh, glm::vec3(1, 0, 0)).r;
+    float down = SphericalHarmonics::evaluate(sh, glm::vec3(0, -1, 0)).r;
+    EXPECT_GT(up, side);
+    EXPECT_GT(side, down);
+    EXPECT_NEAR(side, 0.55f, 0.02f);
+    EXPECT_TRUE(SphericalHarmonics::projectCubemap(faces, 0).coefficients[0] == glm::vec3(0.0f));
+}
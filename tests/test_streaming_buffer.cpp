@@ -0,0 +1,119 @@
+/**
+ * @file test_streaming_buffer.cpp
+ * @brief Unit tests for the ring bookkeeping behind StreamingBuffer (no OpenGL context)
+ */
+
+#include <gtest/gtest.h>
+#include "core/StreamingBuffer.h"
+
+TEST(RingAllocatorTest, AllocationsAreAlignedAndSequential) {
+    RingAllocator ring(1024);
+    size_t offset = 0;
+    uint64_t position = 0;
+
+    ASSERT_TRUE(ring.tryAllocate(10, 16, offset, position));
+    EXPECT_EQ(offset, 0u);
+    ASSERT_TRUE(ring.tryAllocate(10, 16, offset, position));
+    EXPECT_EQ(offset, 16u);
+    ASSERT_TRUE(ring.tryAllocate(4, 4, offset, position));
+    EXPECT_EQ(offset, 28u);
+    EXPECT_EQ(ring.getHead(), 32u);
+}
+
+TEST(RingAllocatorTest, FullRingRejectsUntilRetired) {
+    RingAllocator ring(256);
+    size_t offset = 0;
+    uint64_t position = 0;
+
+    ASSERT_TRUE(ring.tryAllocate(200, 1, offset, position));
+    uint64_t frameEnd = ring.getHead();
+    EXPECT_FALSE(ring.tryAllocate(100, 1, offset, position));
+    EXPECT_EQ(ring.getHead(), frameEnd);  // 失败的分配不改变状态
+
+    ring.retire(frameEnd);
+    ASSERT_TRUE(ring.tryAllocate(100, 1, offset, position));
+    // 尾部只剩 56 字节，跳回开头
+    EXPECT_EQ(offset, 0u);
+    EXPECT_EQ(position, 256u);
+}
+
+TEST(RingAllocatorTest, WrapPaddingCountsAsUsed) {
+    RingAllocator ring(256);
+    size_t offset = 0;
+    uint64_t position = 0;
+
+    ASSERT_TRUE(ring.tryAllocate(100, 1, offset, position));
+    ASSERT_TRUE(ring.tryAllocate(100, 1, offset, position));
+    ring.retire(100);
+
+    // 尾部剩 56 字节放不下 80，跳过的 56 字节也算占用：200 - 100 + 56 + 80 = 236 <= 256
+    ASSERT_TRUE(ring.tryAllocate(80, 1, offset, position));
+    EXPECT_EQ(offset, 0u);
+    EXPECT_EQ(ring.getUsedBytes(), 236u);
+
+    // 再要 30 字节会覆盖第二块仍在使用的数据
+    EXPECT_FALSE(ring.tryAllocate(30, 1, offset, position));
+}
+
+TEST(RingAllocatorTest, OversizedAllocationFails) {
+    RingAllocator ring(64);
+    size_t offset = 0;
+    uint64_t position = 0;
+    EXPECT_FALSE(ring.tryAllocate(65, 1, offset, position));
+    EXPECT_FALSE(ring.tryAllocate(0, 1, offset, position));
+}
+
+TEST(RingAllocatorTest, LivenessEndsWhenRangeIsOverwritten) {
+    RingAllocator ring(128);
+    size_t offset = 0;
+    uint64_t first = 0, position = 0;
+
+    ASSERT_TRUE(ring.tryAllocate(64, 1, offset, first));
+    EXPECT_TRUE(ring.isLive(first));
+
+    ring.retire(ring.getHead());
+    ASSERT_TRUE(ring.tryAllocate(64, 1, offset, position));
+    EXPECT_TRUE(ring.isLive(first));  // 刚好写满一圈，第一块还没被覆盖
+
+    ring.retire(ring.getHead());
+    ASSERT_TRUE(ring.tryAllocate(16, 1, offset, position));
+    EXPECT_FALSE(ring.isLive(first));
+    EXPECT_TRUE(ring.isLive(position));
+}
+
+TEST(RingAllocatorTest, ResetInvalidatesEarlierAllocations) {
+    RingAllocator ring(128);
+    size_t offset = 0;
+    uint64_t before = 0, after = 0;
+
+    ASSERT_TRUE(ring.tryAllocate(100, 1, offset, before));
+    ring.reset();
+    EXPECT_FALSE(ring.isLive(before));
+    EXPECT_EQ(ring.getUsedBytes(), 0u);
+
+    ASSERT_TRUE(ring.tryAllocate(100, 1, offset, after));
+    EXPECT_TRUE(ring.isLive(after));
+}
+
+TEST(RingAllocatorTest, OnlyCurrentFrameAllocationsAreDrawable) {
+    RingAllocator ring(1024);
+    size_t offset = 0;
+    uint64_t previous = 0, current = 0;
+
+    ASSERT_TRUE(ring.tryAllocate(64, 1, offset, previous));
+    EXPECT_TRUE(ring.isCurrentFrame(previous));
+
+    // 上一帧的区间未被覆盖，但它的 fence 一触发就会被回收，不能在新的一帧里继续绘制
+    ring.beginFrame();
+    EXPECT_TRUE(ring.isLive(previous));
+    EXPECT_FALSE(ring.isCurrentFrame(previous));
+
+    ASSERT_TRUE(ring.tryAllocate(64, 1, offset, current));
+    EXPECT_TRUE(ring.isCurrentFrame(current));
+
+    // orphan 之后本帧更早的分配也作废
+    ring.reset();
+    EXPECT_FALSE(ring.isCurrentFrame(current));
+    ASSERT_TRUE(ring.tryAllocate(64, 1, offset, current));
+    EXPECT_TRUE(ring.isCurrentFrame(current));
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_texture_array_pool.cpp
+ * @brief Unit tests for texture array pools and material layer references
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "core/GLState.h"
+#include "mesh/Material.h"
+#include "mesh/TextureArrayPool.h"
+
+TEST(TextureArrayPoolTest, FormatClassUsesUploadChannels) {
+    TextureArrayPool::FormatClass rgb = TextureArrayPool::getFormatClass(256, 128, 3);
+    TextureArrayPool::FormatClass rgba = TextureArrayPool::getFormatClass(256, 128, 4);
+    EXPECT_EQ(rgb.channels, 4);
+    EXPECT_EQ(rgb, rgba);
+    EXPECT_NE(rgb, TextureArrayPool::getFormatClass(128, 256, 4));
+    EXPECT_NE(rgb, TextureArrayPool::getFormatClass(256, 128, 1));
+}
+
+TEST(TextureArrayPoolTest, UsesDedicatedTextureUnit) {
+    // 单元 0 为 diffuseTexture、1 为 shadowMap（均为 sampler2D）
+    EXPECT_GE(TextureArrayPool::TextureUnit, 2u);
+}
+
+TEST(TextureArrayPoolTest, RejectsInvalidImages) {
+    TextureArrayPool pool;
+    std::vector<unsigned char> pixels(16 * 16 * 4, 0);
+    EXPECT_FALSE(pool.add(nullptr, 16, 16, 4).isValid());
+    EXPECT_FALSE(pool.add(pixels.data(), 0, 16, 4).isValid());
+    EXPECT_FALSE(pool.add(pixels.data(), 16, 16, 5).isValid());
+    EXPECT_EQ(pool.getArrayCount(), 0u);
+}
+
+// 需要 OpenGL 上下文
+TEST(TextureArrayPoolTest, DISABLED_GroupsLayersByFormatClass) {
+    TextureArrayPool pool(2);
+    std::vector<unsigned char> rgba(64 * 64 * 4, 200);
+    std::vector<unsigned char> rgb(64 * 64 * 3, 100);
+    std::vector<unsigned char> small(32 * 32 * 4, 50);
+
+    TextureArrayPool::Slot a = pool.add(rgba.data(), 64, 64, 4);
+    TextureArrayPool::Slot b = pool.add(rgb.data(), 64, 64, 3);
+    ASSERT_TRUE(a.isValid());
+    ASSERT_TRUE(b.isValid());
+    EXPECT_EQ(a.array, b.array);
+    EXPECT_EQ(a.layer, 0);
+    EXPECT_EQ(b.layer, 1);
+    EXPECT_TRUE(a.array->isArray());
+    EXPECT_EQ(a.array->getTarget(), static_cast<GLenum>(GL_TEXTURE_2D_ARRAY));
+    EXPECT_EQ(a.array->getLayerCount(), 2);
+
+    // 数组已满时新建一个，不同尺寸另建一个
+    TextureArrayPool::Slot c = pool.add(rgba.data(), 64, 64, 4);
+    TextureArrayPool::Slot d = pool.add(small.data(), 32, 32, 4);
+    EXPECT_NE(c.array, a.array);
+    EXPECT_EQ(c.layer, 0);
+    EXPECT_NE(d.array, c.array);
+    EXPECT_EQ(pool.getArrayCount(), 3u);
+
+    TextureArrayPool::Stats stats = pool.getStats();
+    EXPECT_EQ(stats.layersUsed, 4u);
+    EXPECT_EQ(stats.layersCapacity, 6u);
+    EXPECT_EQ(a.array->getGpuMemoryBytes(), 2u * 4u * (4096u + 1024u + 256u + 64u + 16u + 4u + 1u));
+
+    // 归还的层优先复用
+    pool.release(a);
+    TextureArrayPool::Slot e = pool.add(rgba.data(), 64, 64, 4);
+    EXPECT_EQ(e.array, a.array);
+    EXPECT_EQ(e.layer, 0);
+    EXPECT_EQ(pool.getArrayCount(), 3u);
+}
+
+// 需要 OpenGL 上下文
+TEST(TextureArrayPoolTest, DISABLED_MaterialsShareArray) {
+    TextureArrayPool pool;
+    std::vector<unsigned char> pixels(16 * 16 * 4, 255);
+
+    CMaterial first;
+    CMaterial second;
+    EXPECT_FALSE(first.hasTextureLayer());
+    TextureArrayPool::Slot a = pool.add(pixels.data(), 16, 16, 4);
+    TextureArrayPool::Slot b = pool.add(pixels.data(), 16, 16, 4);
+    first.setTextureLayer(a.array, a.layer);
+    second.setTextureLayer(b.array, b.layer);
+    EXPECT_TRUE(first.hasTextureLayer());
+    EXPECT_EQ(first.textureArray, second.textureArray);
+    EXPECT_NE(first.textureLayer, second.textureLayer);
+
+    CMaterial copy(second);
+    EXPECT_EQ(copy.textureLayer, b.layer);
+    copy.setTextureLayer(nullptr, 3);
+    EXPECT_FALSE(copy.hasTextureLayer());
+    EXPECT_EQ(copy.textureLayer, -1);
+}
+
+// 需要 OpenGL 上下文
+TEST(TextureArrayPoolTest, DISABLED_ClearInstanceLayersResetsDivisor) {
+    GLuint vao = 0, buffer = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &buffer);
+    GLState::bindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(float), nullptr, GL_STATIC_DRAW);
+
+    TextureArrayPool::setInstanceLayers(buffer, 0);
+    TextureArrayPool::clearInstanceLayers();
+
+    // 共享 VAO 上的后续非实例化绘制不再读取每实例层号
+    GLint divisor = 0, enabled = 0;
+    glGetVertexAttribiv(TextureArrayPool::LayerAttribute, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+    glGetVertexAttribiv(TextureArrayPool::LayerAttribute, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+    EXPECT_EQ(divisor, 0);
+    EXPECT_EQ(enabled, GL_FALSE);
+
+    glDeleteBuffers(1, &buffer);
+    GLState::deleteVertexArray(vao);
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_texture_atlas.cpp
+ * @brief Unit tests for MaxRects packing, atlas page building with mip gutters and UV remapping
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "mesh/Material.h"
+#include "mesh/TextureAtlas.h"
+
+namespace {
+
+std::vector<unsigned char> solidImage(int width, int height, const unsigned char color[4]) {
+    std::vector<unsigned char> pixels;
+    for (int i = 0; i < width * height; ++i) pixels.insert(pixels.end(), color, color + 4);
+    return pixels;
+}
+
+const unsigned char* pixelAt(const ImageLevel& level, int x, int y) {
+    return &level.pixels[(static_cast<size_t>(y) * level.width + x) * 4];
+}
+
+} // namespace
+
+TEST(MaxRectsPackerTest, PacksWithoutOverlap) {
+    MaxRectsPacker packer(512, 512);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> size(8, 96);
+
+    std::vector<MaxRectsPacker::Rect> placed;
+    size_t area = 0;
+    for (int i = 0; i < 200; ++i) {
+        int w = size(rng);
+        int h = size(rng);
+        MaxRectsPacker::Rect rect;
+        if (!packer.insert(w, h, rect)) continue;
+        EXPECT_EQ(rect.width, w);
+        EXPECT_EQ(rect.height, h);
+        EXPECT_GE(rect.x, 0);
+        EXPECT_GE(rect.y, 0);
+        EXPECT_LE(rect.x + rect.width, 512);
+        EXPECT_LE(rect.y + rect.height, 512);
+        for (const auto& other : placed) {
+            ASSERT_FALSE(rect.intersects(other));
+        }
+        placed.push_back(rect);
+        area += static_cast<size_t>(w) * h;
+    }
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), static_cast<float>(area) / (512.0f * 512.0f));
+    // 随机尺寸下 MaxRects 应能填满大部分面积
+    EXPECT_GT(packer.getOccupancy(), 0.8f);
+}
+
+TEST(MaxRectsPackerTest, FillsExactlyAndRejectsOverflow) {
+    MaxRectsPacker packer(256, 256);
+    MaxRectsPacker::Rect rect;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(packer.insert(128, 128, rect));
+    }
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), 1.0f);
+    EXPECT_FALSE(packer.insert(1, 1, rect));
+
+    MaxRectsPacker small(64, 64);
+    EXPECT_FALSE(small.insert(65, 10, rect));
+    EXPECT_FALSE(small.insert(0, 10, rect));
+}
+
+TEST(TextureAtlasTest, PadsImagesAndKeepsMipGutters) {
+    AtlasOptions options;
+    options.pageSize = 256;
+    options.padding = 4;
+    TextureAtlas atlas(options);
+    EXPECT_EQ(atlas.getMipLevelCount(), 3);
+
+    const unsigned char colors[3][4] = { { 255, 0, 0, 255 }, { 0, 200, 30, 128 }, { 10, 20, 250, 255 } };
+    const int sizes[3][2] = { { 60, 40 }, { 13, 29 }, { 100, 7 } };
+    for (int i = 0; i < 3; ++i) {
+        std::vector<unsigned char> pixels = solidImage(sizes[i][0], sizes[i][1], colors[i]);
+        ASSERT_EQ(atlas.addImage("image" + std::to_string(i), pixels.data(), sizes[i][0], sizes[i][1], 4), i);
+    }
+    ASSERT_TRUE(atlas.build());
+    ASSERT_EQ(atlas.getPageCount(), 1u);
+    EXPECT_EQ(atlas.findImage("image1"), 1);
+    EXPECT_GT(atlas.getOccupancy(), 0.0f);
+
+    const std::vector<ImageLevel>& levels = atlas.getPageLevels(0);
+    ASSERT_EQ(levels.size(), 3u);
+    EXPECT_EQ(levels[2].width, 64);
+
+    for (int i = 0; i < 3; ++i) {
+        const AtlasRegion& region = atlas.getRegion(i);
+        ASSERT_TRUE(region.isValid());
+        EXPECT_EQ(region.width, sizes[i][0]);
+        EXPECT_EQ(region.height, sizes[i][1]);
+        EXPECT_EQ(region.transform(glm::vec2(0.0f)), glm::vec2(region.x / 256.0f, region.y / 256.0f));
+        EXPECT_EQ(region.transform(glm::vec2(1.0f)),
+                  glm::vec2((region.x + region.width) / 256.0f, (region.y + region.height) / 256.0f));
+
+        // 每一级上，图片及外围至少 1 个纹素只含该图片的颜色（纯色在 sRGB 往返后不变）
+        for (size_t level = 0; level < levels.size(); ++level) {
+            int scale = 1 << level;
+            int x0 = region.x / scale - 1;
+            int y0 = region.y / scale - 1;
+            int x1 = (region.x + region.width + scale - 1) / scale + 1;
+            int y1 = (region.y + region.height + scale - 1) / scale + 1;
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    const unsigned char* p = pixelAt(levels[level], x, y);
+                    for (int c = 0; c < 4; ++c) {
+                        ASSERT_EQ(p[c], colors[i][c]) << "image " << i << ", level " << level << " at " << x << "," << y;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(TextureAtlasTest, ConvertsChannelsAndSkipsOversizedImages) {
+    AtlasOptions options;
+    options.pageSize = 128;
+    options.maxImageSize = 64;
+    TextureAtlas atlas(options);
+
+    const unsigned char gray[2] = { 77, 200 };
+    EXPECT_EQ(atlas.addImage("gray", gray, 1, 1, 2), 0);
+    std::vector<unsigned char> big(100 * 100 * 3, 9);
+    EXPECT_EQ(atlas.addImage("big", big.data(), 100, 100, 3), 1);
+    EXPECT_EQ(atlas.addImage("invalid", big.data(), 0, 100, 3), -1);
+    std::vector<unsigned char> medium(60 * 60, 5);
+    for (int i = 0; i < 5; ++i) atlas.addImage("medium", medium.data(), 60, 60, 1);
+
+    EXPECT_FALSE(atlas.build());
+    EXPECT_FALSE(atlas.getRegion(1).isValid());
+    const AtlasRegion& region = atlas.getRegion(0);
+    ASSERT_TRUE(region.isValid());
+    const unsigned char* p = pixelAt(atlas.getPageLevels(static_cast<size_t>(region.page))[0], region.x, region.y);
+    EXPECT_EQ(p[0], 77);
+    EXPECT_EQ(p[2], 77);
+    EXPECT_EQ(p[3], 200);
+
+    // 60 + 2 * 4 对齐到 4 后为 68，128 的页每页只能放一个
+    EXPECT_EQ(atlas.getPageCount(), 5u);
+    for (int i = 2; i < 7; ++i) EXPECT_TRUE(atlas.getRegion(i).isValid());
+}
+
+TEST(TextureAtlasTest, RemapsUVsIntoRegion) {
+    AtlasRegion region;
+    region.page = 0;
+    region.uvScale = glm::vec2(0.25f, 0.5f);
+    region.uvOffset = glm::vec2(0.5f, 0.125f);
+
+    std::vector<Vertex> vertices = {
+        Vertex(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 0.0f)),
+        Vertex(glm::vec3(1.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 1.00001f)),
+        Vertex(glm::vec3(2.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.5f, 0.25f))
+    };
+    ASSERT_TRUE(TextureAtlas::remapUVs(vertices, region));
+    EXPECT_EQ(vertices[0].texCoords, glm::vec2(0.5f, 0.125f));
+    EXPECT_EQ(vertices[1].texCoords, glm::vec2(0.75f, 0.625f));
+    EXPECT_EQ(vertices[2].texCoords, glm::vec2(0.625f, 0.25f));
+
+    // 平铺的纹理坐标不能映射，保持原样
+    vertices[2].texCoords = glm::vec2(2.0f, 0.5f);
+    std::vector<Vertex> before = vertices;
+    EXPECT_FALSE(TextureAtlas::remapUVs(vertices, region));
+    EXPECT_EQ(vertices[0].texCoords, before[0].texCoords);
+
+    EXPECT_FALSE(TextureAtlas::remapUVs(vertices, AtlasRegion()));
+}
+
+// 需要 OpenGL 上下文
+TEST(TextureAtlasTest, DISABLED_MaterialsShareAtlasPage) {
+    AtlasOptions options;
+    options.pageSize = 64;
+    TextureAtlas atlas(options);
+    const unsigned char red[4] = { 255, 0, 0, 255 };
+    std::vector<unsigned char> pixels = solidImage(16, 16, red);
+    atlas.addImage("a", pixels.data(), 16, 16, 4);
+    atlas.addImage("b", pixels.data(), 16, 16, 4);
+    ASSERT_TRUE(atlas.build());
+
+    std::shared_ptr<CTexture> page = atlas.createTexture(0);
+    EXPECT_EQ(page->width, 64);
+    EXPECT_EQ(page->getGpuMemoryBytes(), 4u * (64u * 64u + 32u * 32u + 16u * 16u));
+
+    CMaterial first;
+    CMaterial second;
+    TextureAtlas::applyToMaterial(first, atlas.getRegion(0), page);
+    TextureAtlas::applyToMaterial(second, atlas.getRegion(1), page);
+    EXPECT_EQ(first.getTexture(0), second.getTexture(0));
+    EXPECT_EQ(first.getTextureCount(), 1u);
+    EXPECT_TRUE(first.hasUVTransform());
+    EXPECT_NE(first.uvOffset, second.uvOffset);
+}
@@ -0,0 +1,255 @@
+/**
+ * @file test_texture_container.cpp
+ * @brief Unit tests for KTX / DDS block-compressed texture parsing
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mesh/AsyncTextureLoader.h"
+#include "mesh/TextureContainer.h"
+
+namespace {
+
+void putU32(std::vector<unsigned char>& out, size_t offset, uint32_t value, bool bigEndian = false) {
+    for (int i = 0; i < 4; ++i) {
+        int shift = bigEndian ? (3 - i) * 8 : i * 8;
+        out[offset + static_cast<size_t>(i)] = static_cast<unsigned char>(value >> shift);
+    }
+}
+
+// 各级别数据依次填充 level 序号，便于核对偏移
+std::vector<unsigned char> makeLevelData(BlockFormat format, int width, int height, int levels) {
+    std::vector<unsigned char> data;
+    for (int i = 0; i < levels; ++i) {
+        size_t size = TextureContainer::getLevelSize(format, std::max(1, width >> i), std::max(1, height >> i));
+        data.insert(data.end(), size, static_cast<unsigned char>(i + 1));
+    }
+    return data;
+}
+
+std::vector<unsigned char> makeDDS(const char* fourCC, int width, int height, int levels,
+                                   const std::vector<unsigned char>& levelData, uint32_t dxgi = 0) {
+    bool dx10 = std::strcmp(fourCC, "DX10") == 0;
+    std::vector<unsigned char> file(4 + 124 + (dx10 ? 20 : 0), 0);
+    std::memcpy(file.data(), "DDS ", 4);
+    putU32(file, 4, 124);
+    putU32(file, 4 + 8, static_cast<uint32_t>(height));
+    putU32(file, 4 + 12, static_cast<uint32_t>(width));
+    putU32(file, 4 + 24, static_cast<uint32_t>(levels));
+    putU32(file, 4 + 72, 32);
+    putU32(file, 4 + 76, 0x4);
+    std::memcpy(file.data() + 4 + 80, fourCC, 4);
+    if (dx10) {
+        putU32(file, 128, dxgi);
+        putU32(file, 132, 3);   // TEXTURE2D
+        putU32(file, 140, 1);   // arraySize
+    }
+    file.insert(file.end(), levelData.begin(), levelData.end());
+    return file;
+}
+
+std::vector<unsigned char> makeKTX(uint32_t internalFormat, int width, int height, int levels,
+                                   BlockFormat format, bool bigEndian = false) {
+    const unsigned char identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+    std::vector<unsigned char> file(64 + 8, 0);
+    std::memcpy(file.data(), identifier, 12);
+    putU32(file, 12, 0x04030201, bigEndian);
+    putU32(file, 28, internalFormat, bigEndian);
+    putU32(file, 36, static_cast<uint32_t>(width), bigEndian);
+    putU32(file, 40, static_cast<uint32_t>(height), bigEndian);
+    putU32(file, 52, 1, bigEndian);
+    putU32(file, 56, static_cast<uint32_t>(levels), bigEndian);
+    putU32(file, 60, 8, bigEndian);   // 8 字节的键值数据，解析时跳过
+    for (int i = 0; i < levels; ++i) {
+        size_t size = TextureContainer::getLevelSize(format, std::max(1, width >> i), std::max(1, height >> i));
+        size_t at = file.size();
+        file.resize(at + 4);
+        putU32(file, at, static_cast<uint32_t>(size), bigEndian);
+        file.insert(file.end(), size, static_cast<unsigned char>(i + 1));
+        file.resize((file.size() + 3) & ~size_t(3), 0);
+    }
+    return file;
+}
+
+} // namespace
+
+TEST(TextureContainerTest, LevelSizesRoundUpToBlocks) {
+    EXPECT_EQ(TextureContainer::getLevelSize(BlockFormat::BC1, 256, 256), 64u * 64u * 8u);
+    EXPECT_EQ(TextureContainer::getLevelSize(BlockFormat::BC7, 256, 256), 64u * 64u * 16u);
+    EXPECT_EQ(TextureContainer::getLevelSize(BlockFormat::BC4, 1, 1), 8u);
+    EXPECT_EQ(TextureContainer::getLevelSize(BlockFormat::BC5, 6, 2), 2u * 16u);
+    EXPECT_TRUE(TextureContainer::isContainerPath("textures/brick.DDS"));
+    EXPECT_TRUE(TextureContainer::isContainerPath("brick.ktx"));
+    EXPECT_FALSE(TextureContainer::isContainerPath("brick.png"));
+}
+
+TEST(TextureContainerTest, ParsesDDSFourCCFormats) {
+    struct Case { const char* code; BlockFormat format; };
+    const Case cases[] = { { "DXT1", BlockFormat::BC1 }, { "DXT5", BlockFormat::BC3 },
+                           { "ATI1", BlockFormat::BC4 }, { "ATI2", BlockFormat::BC5 },
+                           { "BC5U", BlockFormat::BC5 } };
+    for (const auto& c : cases) {
+        auto file = makeDDS(c.code, 64, 32, 7, makeLevelData(c.format, 64, 32, 7));
+        CompressedImage image;
+        std::string error;
+        ASSERT_TRUE(TextureContainer::parse(file.data(), file.size(), image, &error)) << c.code << ": " << error;
+        EXPECT_EQ(image.format, c.format);
+        EXPECT_EQ(image.width, 64);
+        EXPECT_EQ(image.height, 32);
+        ASSERT_EQ(image.levels.size(), 7u);
+        EXPECT_EQ(image.levels[6].width, 1);
+        EXPECT_EQ(image.levels[6].height, 1);
+        EXPECT_EQ(image.getLevelData(3)[0], 4);
+        EXPECT_EQ(image.getByteSize(), image.levels[6].offset + image.levels[6].size);
+    }
+}
+
+TEST(TextureContainerTest, ParsesDDSWithDX10Header) {
+    auto file = makeDDS("DX10", 40, 24, 3, makeLevelData(BlockFormat::BC7, 40, 24, 3), 99);
+    CompressedImage image;
+    ASSERT_TRUE(TextureContainer::parseDDS(file.data(), file.size(), image));
+    EXPECT_EQ(image.format, BlockFormat::BC7);
+    EXPECT_TRUE(image.srgb);
+    EXPECT_EQ(image.getGLInternalFormat(), static_cast<GLenum>(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM));
+    EXPECT_EQ(image.levels[1].size, TextureContainer::getLevelSize(BlockFormat::BC7, 20, 12));
+    EXPECT_EQ(image.getChannels(), 4);
+
+    // 不支持的 DXGI 格式（R8G8B8A8_UNORM）
+    file = makeDDS("DX10", 4, 4, 1, std::vector<unsigned char>(64), 28);
+    std::string error;
+    EXPECT_FALSE(TextureContainer::parseDDS(file.data(), file.size(), image, &error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_TRUE(image.empty());
+}
+
+TEST(TextureContainerTest, ParsesKTXBothEndiannesses) {
+    for (bool bigEndian : { false, true }) {
+        auto file = makeKTX(GL_COMPRESSED_RG_RGTC2, 30, 10, 5, BlockFormat::BC5, bigEndian);
+        CompressedImage image;
+        std::string error;
+        ASSERT_TRUE(TextureContainer::parse(file.data(), file.size(), image, &error)) << error;
+        EXPECT_EQ(image.format, BlockFormat::BC5);
+        EXPECT_EQ(image.getChannels(), 2);
+        ASSERT_EQ(image.levels.size(), 5u);
+        EXPECT_EQ(image.levels[4].width, 1);
+        EXPECT_EQ(image.getLevelData(2)[0], 3);
+        EXPECT_EQ(image.getLevelData(4)[image.levels[4].size - 1], 5);
+    }
+}
+
+TEST(TextureContainerTest, RejectsTruncatedAndInconsistentFiles) {
+    auto dds = makeDDS("DXT1", 16, 16, 5, makeLevelData(BlockFormat::BC1, 16, 16, 5));
+    auto ktx = makeKTX(GL_COMPRESSED_RGBA_BPTC_UNORM, 16, 16, 5, BlockFormat::BC7);
+    CompressedImage image;
+    for (size_t size = 0; size < dds.size(); ++size) {
+        EXPECT_FALSE(TextureContainer::parse(dds.data(), size, image)) << size;
+    }
+    // KTX 最后一级后的对齐填充不影响结果
+    for (size_t size = 0; size + 3 < ktx.size(); ++size) {
+        EXPECT_FALSE(TextureContainer::parse(ktx.data(), size, image)) << size;
+    }
+
+    // 级别数多于尺寸允许的数量
+    auto tooMany = makeDDS("DXT1", 4, 4, 4, makeLevelData(BlockFormat::BC1, 4, 4, 4));
+    EXPECT_FALSE(TextureContainer::parse(tooMany.data(), tooMany.size(), image));
+
+    // KTX 中 imageSize 与尺寸不符
+    putU32(ktx, 64 + 8, 12345);
+    std::string error;
+    EXPECT_FALSE(TextureContainer::parse(ktx.data(), ktx.size(), image, &error));
+    EXPECT_NE(error.find("size"), std::string::npos);
+
+    // 立方体贴图
+    auto cube = makeDDS("DXT1", 4, 4, 1, makeLevelData(BlockFormat::BC1, 4, 4, 1));
+    putU32(cube, 4 + 108, 0x200);
+    EXPECT_FALSE(TextureContainer::parse(cube.data(), cube.size(), image));
+
+    const unsigned char png[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    EXPECT_FALSE(TextureContainer::parse(png, sizeof(png), image));
+}
+
+TEST(TextureContainerTest, WrittenFilesParseBack) {
+    struct Case { const char* code; BlockFormat format; uint32_t dxgi; };
+    const Case cases[] = { { "DXT1", BlockFormat::BC1, 0 }, { "BC4U", BlockFormat::BC4, 0 },
+                           { "DX10", BlockFormat::BC7, 99 }, { "DX10", BlockFormat::BC1, 72 } };
+    for (const auto& c : cases) {
+        auto file = makeDDS(c.code, 20, 12, 5, makeLevelData(c.format, 20, 12, 5), c.dxgi);
+        CompressedImage image;
+        ASSERT_TRUE(TextureContainer::parse(file.data(), file.size(), image));
+
+        std::vector<unsigned char> written;
+        for (int ktx = 0; ktx < 2; ++ktx) {
+            if (ktx) {
+                TextureContainer::writeKTX(image, written);
+            } else {
+                TextureContainer::writeDDS(image, written);
+            }
+            CompressedImage parsed;
+            std::string error;
+            ASSERT_TRUE(TextureContainer::parse(written.data(), written.size(), parsed, &error)) << error;
+            EXPECT_EQ(parsed.format, image.format);
+            EXPECT_EQ(parsed.srgb, image.srgb);
+            EXPECT_EQ(parsed.width, 20);
+            EXPECT_EQ(parsed.height, 12);
+            EXPECT_EQ(parsed.levels.size(), 5u);
+            EXPECT_EQ(parsed.data, image.data);
+        }
+    }
+}
+
+// 需要 OpenGL 上下文
+TEST(TextureContainerTest, DISABLED_CompressedTexturesTrackMemoryAndStreamByBlockRows) {
+    if (!CTexture::isBlockFormatSupported(BlockFormat::BC3)) {
+        GTEST_SKIP() << "EXT_texture_compression_s3tc not supported by the driver";
+    }
+    auto ktx = makeKTX(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 64, 64, 7, BlockFormat::BC3);
+    const std::string path = "test_texture_container.ktx";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(ktx.data()), static_cast<std::streamsize>(ktx.size()));
+    }
+
+    size_t before = CTexture::getTotalGpuMemoryBytes();
+    {
+        CTexture texture(path);
+        EXPECT_TRUE(texture.isCompressed());
+        EXPECT_EQ(texture.getInternalFormat(), static_cast<GLenum>(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT));
+        // BC3 为 1 字节/像素，含 mip 链
+        size_t expected = 0;
+        for (int i = 0; i < 7; ++i) expected += TextureContainer::getLevelSize(BlockFormat::BC3, 64 >> i, 64 >> i);
+        EXPECT_EQ(texture.getGpuMemoryBytes(), expected);
+        EXPECT_EQ(CTexture::getTotalGpuMemoryBytes(), before + expected);
+
+        unsigned char rgba[64 * 64 * 4] = {};
+        CTexture uncompressed(rgba, 64, 64, 4);
+        // RGBA8 为 4 字节/像素，约为 BC3 的 4 倍（最小的几级按整块计，略少于 4 倍）
+        EXPECT_GT(uncompressed.getGpuMemoryBytes(), 3 * texture.getGpuMemoryBytes());
+    }
+    EXPECT_EQ(CTexture::getTotalGpuMemoryBytes(), before);
+
+    // 异步加载：每帧 4 个块行（BC3 宽 64 为 16 块 x 16 字节）
+    AsyncTextureLoader loader(nullptr, 1);
+    loader.setUploadBudget(4 * 16 * 16);
+    auto texture = loader.load(path);
+    int frames = 0;
+    while (!loader.isIdle() && frames < 5000) {
+        loader.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++frames;
+    }
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(texture->isCompressed());
+    EXPECT_EQ(texture->width, 64);
+    EXPECT_EQ(loader.getStats().compressed, 1u);
+    // 0 级 16 块行分 4 块，其余 6 级每级一块
+    EXPECT_EQ(loader.getStats().directChunks, 4u + 6u);
+}
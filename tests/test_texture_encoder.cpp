@@ -0,0 +1,250 @@
+/**
+ * @file test_texture_encoder.cpp
+ * @brief Unit tests for the CPU BC1/BC3/BC4/BC5 encoder
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "core/Parallel.h"
+#include "mesh/TextureEncoder.h"
+#include "temp_directory.h"
+
+namespace {
+
+// 平滑渐变叠加少量高频纹理，channels 为 1~4
+std::vector<unsigned char> makeImage(int width, int height, int channels) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * channels);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                double v = 128.0 + 100.0 * std::sin(x * 0.05 * (c + 1) + y * 0.03) + 12.0 * std::sin(x * 0.9 + y * 1.3 + c);
+                pixels[(static_cast<size_t>(y) * width + x) * channels + c] =
+                    static_cast<unsigned char>(std::min(255.0, std::max(0.0, v)));
+            }
+        }
+    }
+    return pixels;
+}
+
+std::string writePPM(const std::string& name, int width, int height, int seed) {
+    std::ofstream file(name, std::ios::binary);
+    file << "P6\n" << width << " " << height << "\n255\n";
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            unsigned char rgb[3] = { static_cast<unsigned char>(x * 4 + seed), static_cast<unsigned char>(y * 4),
+                                     static_cast<unsigned char>((x + y) * 2) };
+            file.write(reinterpret_cast<const char*>(rgb), 3);
+        }
+    }
+    return name;
+}
+
+double encodePSNR(const std::vector<unsigned char>& pixels, int width, int height, int channels,
+                  BlockFormat format, EncodeQuality quality) {
+    EncodeOptions options;
+    options.format = format;
+    options.quality = quality;
+    CompressedImage image;
+    EXPECT_TRUE(TextureEncoder::encode(pixels.data(), width, height, channels, options, image));
+    return TextureEncoder::measurePSNR(pixels.data(), width, height, channels, image);
+}
+
+} // namespace
+
+TEST(TextureEncoderTest, SolidBlocksDecodeExactlyOrNearly) {
+    unsigned char rgba[64];
+    unsigned char block[16];
+    unsigned char decoded[64];
+    for (int value : { 0, 37, 128, 200, 255 }) {
+        for (int i = 0; i < 16; ++i) {
+            rgba[i * 4 + 0] = static_cast<unsigned char>(value);
+            rgba[i * 4 + 1] = static_cast<unsigned char>(255 - value);
+            rgba[i * 4 + 2] = static_cast<unsigned char>(value / 2);
+            rgba[i * 4 + 3] = 255;
+        }
+        TextureEncoder::encodeBlock(BlockFormat::BC1, EncodeQuality::Fast, rgba, block);
+        TextureEncoder::decodeBlock(BlockFormat::BC1, block, decoded);
+        for (int i = 0; i < 16; ++i) {
+            // 单色表使 1/3 插值点最多偏差 1
+            EXPECT_NEAR(decoded[i * 4 + 0], value, 1);
+            EXPECT_NEAR(decoded[i * 4 + 1], 255 - value, 1);
+            EXPECT_NEAR(decoded[i * 4 + 2], value / 2, 1);
+            EXPECT_EQ(decoded[i * 4 + 3], 255);
+        }
+
+        TextureEncoder::encodeBlock(BlockFormat::BC4, EncodeQuality::Fast, rgba, block);
+        TextureEncoder::decodeBlock(BlockFormat::BC4, block, decoded);
+        for (int i = 0; i < 16; ++i) EXPECT_EQ(decoded[i * 4], value);
+    }
+}
+
+TEST(TextureEncoderTest, BC1KeepsPunchThroughAlpha) {
+    unsigned char rgba[64];
+    for (int i = 0; i < 16; ++i) {
+        rgba[i * 4 + 0] = static_cast<unsigned char>(i * 16);
+        rgba[i * 4 + 1] = 90;
+        rgba[i * 4 + 2] = static_cast<unsigned char>(255 - i * 16);
+        rgba[i * 4 + 3] = (i % 3 == 0) ? 10 : 255;
+    }
+    for (int q = 0; q < static_cast<int>(EncodeQuality::Count); ++q) {
+        unsigned char block[8];
+        unsigned char decoded[64];
+        TextureEncoder::encodeBlock(BlockFormat::BC1, static_cast<EncodeQuality>(q), rgba, block);
+        TextureEncoder::decodeBlock(BlockFormat::BC1, block, decoded);
+        for (int i = 0; i < 16; ++i) {
+            EXPECT_EQ(decoded[i * 4 + 3], (i % 3 == 0) ? 0 : 255) << "pixel " << i;
+        }
+    }
+
+    // 全部不透明时不会出现透明像素
+    for (int i = 0; i < 16; ++i) rgba[i * 4 + 3] = 255;
+    unsigned char block[8];
+    unsigned char decoded[64];
+    TextureEncoder::encodeBlock(BlockFormat::BC1, EncodeQuality::High, rgba, block);
+    TextureEncoder::decodeBlock(BlockFormat::BC1, block, decoded);
+    for (int i = 0; i < 16; ++i) EXPECT_EQ(decoded[i * 4 + 3], 255);
+}
+
+TEST(TextureEncoderTest, ChannelBlocksUseBothModes) {
+    // 两个值的块无损
+    unsigned char rgba[64] = {};
+    for (int i = 0; i < 16; ++i) rgba[i * 4] = (i & 1) ? 17 : 230;
+    unsigned char block[8];
+    unsigned char decoded[64];
+    TextureEncoder::encodeBlock(BlockFormat::BC4, EncodeQuality::Fast, rgba, block);
+    TextureEncoder::decodeBlock(BlockFormat::BC4, block, decoded);
+    for (int i = 0; i < 16; ++i) EXPECT_EQ(decoded[i * 4], rgba[i * 4]);
+
+    // 含 0 和 255 的块：6 值模式直接表示两端，中间值集中在小范围内
+    for (int i = 0; i < 16; ++i) rgba[i * 4] = static_cast<unsigned char>(i == 0 ? 0 : i == 1 ? 255 : 100 + i);
+    TextureEncoder::encodeBlock(BlockFormat::BC4, EncodeQuality::Normal, rgba, block);
+    EXPECT_LE(block[0], block[1]);
+    TextureEncoder::decodeBlock(BlockFormat::BC4, block, decoded);
+    EXPECT_EQ(decoded[0], 0);
+    EXPECT_EQ(decoded[4], 255);
+    for (int i = 2; i < 16; ++i) EXPECT_NEAR(decoded[i * 4], rgba[i * 4], 2);
+}
+
+TEST(TextureEncoderTest, ImageQualityImprovesWithPreset) {
+    const int width = 70, height = 45;   // 不是 4 的倍数
+    auto rgb = makeImage(width, height, 3);
+    auto rgba = makeImage(width, height, 4);
+    auto red = makeImage(width, height, 1);
+    auto rg = makeImage(width, height, 2);
+
+    struct Case { const std::vector<unsigned char>* pixels; int channels; BlockFormat format; double minPSNR; };
+    const Case cases[] = { { &rgb, 3, BlockFormat::BC1, 28.0 }, { &rgba, 4, BlockFormat::BC3, 28.0 },
+                           { &red, 1, BlockFormat::BC4, 42.0 }, { &rg, 2, BlockFormat::BC5, 42.0 } };
+    for (const Case& c : cases) {
+        double fast = encodePSNR(*c.pixels, width, height, c.channels, c.format, EncodeQuality::Fast);
+        double normal = encodePSNR(*c.pixels, width, height, c.channels, c.format, EncodeQuality::Normal);
+        double high = encodePSNR(*c.pixels, width, height, c.channels, c.format, EncodeQuality::High);
+        const char* name = TextureContainer::getFormatName(c.format);
+        EXPECT_GT(fast, c.minPSNR) << name;
+        EXPECT_GE(normal, fast) << name;
+        EXPECT_GE(high, normal) << name;
+    }
+}
+
+TEST(TextureEncoderTest, EncodesFullMipChainIndependentOfThreadCount) {
+    const int width = 130, height = 66;
+    auto pixels = makeImage(width, height, 4);
+    EncodeOptions options;
+    CompressedImage parallel;
+    ASSERT_TRUE(TextureEncoder::encode(pixels.data(), width, height, 4, options, parallel));
+    EXPECT_EQ(parallel.format, BlockFormat::BC3);   // alpha 不全为 255
+    ASSERT_EQ(parallel.levels.size(), 8u);
+    EXPECT_EQ(parallel.levels[7].width, 1);
+    EXPECT_EQ(parallel.levels[7].height, 1);
+    EXPECT_EQ(parallel.levels[1].size, TextureContainer::getLevelSize(BlockFormat::BC3, 65, 33));
+    EXPECT_EQ(parallel.getByteSize(), parallel.levels[7].offset + parallel.levels[7].size);
+
+    Parallel::setMaxWorkers(1);
+    CompressedImage serial;
+    ASSERT_TRUE(TextureEncoder::encode(pixels.data(), width, height, 4, options, serial));
+    Parallel::setMaxWorkers(0);
+    EXPECT_EQ(serial.data, parallel.data);
+
+    options.generateMips = false;
+    options.format = BlockFormat::BC7;
+    std::string error;
+    EXPECT_FALSE(TextureEncoder::encode(pixels.data(), width, height, 4, options, serial, &error));
+    EXPECT_FALSE(error.empty());
+    options.format = BlockFormat::BC1;
+    ASSERT_TRUE(TextureEncoder::encode(pixels.data(), width, height, 4, options, serial));
+    EXPECT_EQ(serial.levels.size(), 1u);
+}
+
+TEST(TextureEncoderTest, DecompressesMipChainForUnsupportedDrivers) {
+    const int width = 10, height = 6;
+    auto pixels = makeImage(width, height, 4);
+    EncodeOptions options;
+    options.format = BlockFormat::BC3;
+    CompressedImage image;
+    ASSERT_TRUE(TextureEncoder::encode(pixels.data(), width, height, 4, options, image));
+
+    std::vector<ImageLevel> levels;
+    ASSERT_TRUE(TextureEncoder::decompress(image, levels));
+    ASSERT_EQ(levels.size(), image.levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        EXPECT_EQ(levels[i].width, image.levels[i].width);
+        EXPECT_EQ(levels[i].height, image.levels[i].height);
+        std::vector<unsigned char> rgba;
+        TextureEncoder::decodeLevel(image, i, rgba);
+        EXPECT_EQ(levels[i].pixels, rgba);
+    }
+
+    // BC7 不能在 CPU 上解码
+    image.format = BlockFormat::BC7;
+    EXPECT_FALSE(TextureEncoder::decompress(image, levels));
+    EXPECT_TRUE(levels.empty());
+}
+
+TEST(TextureEncoderTest, ChoosesFormatFromContent) {
+    std::vector<unsigned char> opaque(16 * 4, 255);
+    EXPECT_EQ(TextureEncoder::chooseFormat(opaque.data(), 4, 4, 4, false), BlockFormat::BC1);
+    EXPECT_EQ(TextureEncoder::chooseFormat(opaque.data(), 4, 4, 4, true), BlockFormat::BC5);
+    EXPECT_EQ(TextureEncoder::chooseFormat(opaque.data(), 4, 4, 3, false), BlockFormat::BC1);
+    EXPECT_EQ(TextureEncoder::chooseFormat(opaque.data(), 4, 4, 2, false), BlockFormat::BC5);
+    EXPECT_EQ(TextureEncoder::chooseFormat(opaque.data(), 4, 4, 1, false), BlockFormat::BC4);
+    opaque[11 * 4 + 3] = 254;
+    EXPECT_EQ(TextureEncoder::chooseFormat(opaque.data(), 4, 4, 4, false), BlockFormat::BC3);
+}
+
+TEST(TextureEncoderTest, CachesEncodedResultUntilSourceChanges) {
+    TempDirectory temp("test_encoder_cache");
+    ASSERT_TRUE(temp.isValid());
+    const std::string path = writePPM(temp.file("source.ppm"), 24, 20, 0);
+    const std::string cache = temp.file("nested");
+    EncodeOptions options;
+    options.quality = EncodeQuality::Fast;
+
+    CompressedImage first;
+    bool fromCache = true;
+    std::string error;
+    ASSERT_TRUE(TextureEncoder::loadOrEncode(path, options, cache, first, &fromCache, &error)) << error;
+    EXPECT_FALSE(fromCache);
+    EXPECT_EQ(first.format, BlockFormat::BC1);
+    EXPECT_EQ(first.width, 24);
+
+    CompressedImage second;
+    ASSERT_TRUE(TextureEncoder::loadOrEncode(path, options, cache, second, &fromCache));
+    EXPECT_TRUE(fromCache);
+    EXPECT_EQ(second.data, first.data);
+    EXPECT_EQ(second.levels.size(), first.levels.size());
+
+    // 参数或内容变化后重新编码
+    options.quality = EncodeQuality::High;
+    ASSERT_TRUE(TextureEncoder::loadOrEncode(path, options, cache, second, &fromCache));
+    EXPECT_FALSE(fromCache);
+    writePPM(path, 24, 20, 1);
+    ASSERT_TRUE(TextureEncoder::loadOrEncode(path, options, cache, second, &fromCache));
+    EXPECT_FALSE(fromCache);
+
+    EXPECT_FALSE(TextureEncoder::loadOrEncode("missing_texture.png", options, cache, second, &fromCache, &error));
+    EXPECT_TRUE(second.empty());
+}
@@ -0,0 +1,192 @@
+/**
+ * @file test_texture_streamer.cpp
+ * @brief Unit tests for screen-space mip selection, budget fitting and mip streaming
+ */
+
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+#include "mesh/TextureStreamer.h"
+
+namespace {
+
+// 写一个 width x height 的二进制 PPM（RGB）
+std::string writePPM(const std::string& name, int width, int height) {
+    std::ofstream file(name, std::ios::binary);
+    file << "P6\n" << width << " " << height << "\n255\n";
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            unsigned char rgb[3] = { static_cast<unsigned char>(x), static_cast<unsigned char>(y),
+                                     static_cast<unsigned char>(x ^ y) };
+            file.write(reinterpret_cast<const char*>(rgb), 3);
+        }
+    }
+    return name;
+}
+
+// 正方形纹理的完整 mip 链，每像素 bytesPerPixel 字节，边长不超过 64 的级别为常驻尾部
+TextureStreamer::Residency makeResidency(int size, size_t bytesPerPixel) {
+    TextureStreamer::Residency residency;
+    residency.width = residency.height = size;
+    residency.tailLevel = -1;
+    for (int level = 0; (size >> level) > 0; ++level) {
+        int s = size >> level;
+        residency.levelBytes.push_back(static_cast<size_t>(s) * s * bytesPerPixel);
+        if (residency.tailLevel < 0 && s <= TextureStreamer::getTailSize()) residency.tailLevel = level;
+    }
+    return residency;
+}
+
+} // namespace
+
+TEST(TextureStreamerTest, SelectsLevelFromScreenSize) {
+    EXPECT_EQ(TextureStreamer::selectLevel(1024, 512, 11, 1024.0f, 0.0f), 0);
+    EXPECT_EQ(TextureStreamer::selectLevel(1024, 512, 11, 512.0f, 0.0f), 1);
+    EXPECT_EQ(TextureStreamer::selectLevel(1024, 512, 11, 100.0f, 0.0f), 3);
+    EXPECT_EQ(TextureStreamer::selectLevel(1024, 512, 11, 512.0f, 1.0f), 2);
+    EXPECT_EQ(TextureStreamer::selectLevel(1024, 512, 11, 0.5f, 0.0f), 10);
+    EXPECT_EQ(TextureStreamer::selectLevel(1024, 512, 11, FLT_MAX, 0.0f), 0);
+    // 未使用时只需要最粗级别
+    EXPECT_EQ(TextureStreamer::selectLevel(1024, 512, 11, 0.0f, 0.0f), 10);
+    EXPECT_EQ(TextureStreamer::selectLevel(16, 16, 1, 0.0f, 0.0f), 0);
+}
+
+TEST(TextureStreamerTest, ScreenPixelsFollowDistanceNotDirection) {
+    // 90 度视角：projection[1][1] = 1
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+    glm::vec3 boundsMin(-1.0f), boundsMax(1.0f);
+    float radius = std::sqrt(3.0f);
+
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    float pixels = TextureStreamer::getScreenPixels(view, projection, 600.0f, boundsMin, boundsMax);
+    EXPECT_NEAR(pixels, radius * 600.0f / (10.0f - radius), 0.01f);
+
+    // 背对物体时结果不变，距离加倍时明显变小
+    glm::mat4 away = glm::lookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f, 0.0f, 20.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    EXPECT_NEAR(TextureStreamer::getScreenPixels(away, projection, 600.0f, boundsMin, boundsMax), pixels, 0.01f);
+    glm::mat4 far = glm::lookAt(glm::vec3(0.0f, 0.0f, 20.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    EXPECT_LT(TextureStreamer::getScreenPixels(far, projection, 600.0f, boundsMin, boundsMax), pixels * 0.5f);
+
+    // 相机在包围球内
+    glm::mat4 inside = glm::lookAt(glm::vec3(0.5f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(TextureStreamer::getScreenPixels(inside, projection, 600.0f, boundsMin, boundsMax), FLT_MAX);
+
+    // 正交投影与距离无关：高 4 个单位的视口，直径 2√3 占 600 * 2√3 / 4 像素
+    glm::mat4 ortho = glm::ortho(-2.0f, 2.0f, -2.0f, 2.0f, 0.1f, 100.0f);
+    EXPECT_NEAR(TextureStreamer::getScreenPixels(far, ortho, 600.0f, boundsMin, boundsMax),
+                600.0f * 2.0f * radius / 4.0f, 0.01f);
+}
+
+TEST(TextureStreamerTest, FitBudgetKeepsRequestWhenItFits) {
+    TextureStreamer::Residency a = makeResidency(256, 4);
+    a.desiredLevel = 0;
+    a.screenPixels = 300.0f;
+    std::vector<TextureStreamer::Residency*> textures = { &a };
+
+    TextureStreamer::fitBudget(textures, a.getBytesFrom(0));
+    EXPECT_EQ(a.targetLevel, 0);
+
+    // 所需级别比常驻尾部粗时仍保留尾部
+    a.desiredLevel = 6;
+    TextureStreamer::fitBudget(textures, 0);
+    EXPECT_EQ(a.targetLevel, a.tailLevel);
+}
+
+TEST(TextureStreamerTest, FitBudgetDropsMostOversampledFirst) {
+    // near 在屏幕上 256 像素，far 只有 32 像素却也请求 0 级（如 LOD 偏移为负）
+    TextureStreamer::Residency near = makeResidency(256, 4);
+    TextureStreamer::Residency far = makeResidency(256, 4);
+    TextureStreamer::Residency unused = makeResidency(256, 4);
+    near.screenPixels = 256.0f;
+    far.screenPixels = 32.0f;
+    near.desiredLevel = far.desiredLevel = unused.desiredLevel = 0;
+    std::vector<TextureStreamer::Residency*> textures = { &near, &far, &unused };
+
+    // 只差 0 级的一半：先放弃未使用的纹理
+    size_t full = near.getBytesFrom(0) * 3;
+    TextureStreamer::fitBudget(textures, full - near.levelBytes[0] / 2);
+    EXPECT_EQ(near.targetLevel, 0);
+    EXPECT_EQ(far.targetLevel, 0);
+    EXPECT_EQ(unused.targetLevel, 1);
+
+    // 再紧：未使用的纹理退到尾部，far 也退到尾部之前，near 保持 0 级
+    size_t budget = near.getBytesFrom(0) + far.getBytesFrom(2) + unused.getBytesFrom(2);
+    TextureStreamer::fitBudget(textures, budget);
+    EXPECT_EQ(near.targetLevel, 0);
+    EXPECT_EQ(far.targetLevel, 2);
+    EXPECT_EQ(unused.targetLevel, 2);
+
+    // 预算连尾部都放不下：只剩常驻尾部
+    TextureStreamer::fitBudget(textures, 1);
+    for (const TextureStreamer::Residency* residency : textures) {
+        EXPECT_EQ(residency->targetLevel, residency->tailLevel);
+    }
+}
+
+// 需要 OpenGL 上下文
+TEST(TextureStreamerTest, DISABLED_StreamsAndEvictsLevels) {
+    std::string path = writePPM("test_texture_streamer.ppm", 256, 256);
+
+    // RGB 按 RGBA 上传；常驻尾部为 64x64 到 1x1
+    const size_t tailBytes = 4u * (4096u + 1024u + 256u + 64u + 16u + 4u + 1u);
+    const size_t level1Bytes = 4u * 128u * 128u;
+    const size_t fullBytes = 4u * 256u * 256u + level1Bytes + tailBytes;
+
+    TextureStreamer streamer(1024 * 1024, 1);
+    auto texture = streamer.load(path);
+    EXPECT_EQ(texture->width, 1);
+    streamer.finishAll();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(texture->width, 256);
+    EXPECT_EQ(streamer.getStats().textures, 1u);
+    EXPECT_EQ(streamer.getStats().residentBytes, tailBytes);
+    EXPECT_EQ(texture->getGpuMemoryBytes(), tailBytes);
+
+    // 近处的物体需要 0 级，按每帧 64 行上传
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+    streamer.setUploadBudget(256 * 4 * 64);
+    int frames = 0;
+    do {
+        streamer.beginFrame(view, projection, 512.0f);
+        streamer.addUsage(texture, glm::vec3(-1.0f), glm::vec3(1.0f));
+        streamer.update();
+        EXPECT_LE(streamer.getStats().bytesThisFrame, streamer.getUploadBudget());
+        ++frames;
+    } while (!streamer.isIdle() && frames < 100);
+
+    const TextureStreamer::Stats& stats = streamer.getStats();
+    EXPECT_EQ(stats.requestedBytes, fullBytes);
+    EXPECT_EQ(stats.residentBytes, fullBytes);
+    EXPECT_EQ(stats.levelsStreamed, 2u);
+    EXPECT_EQ(stats.requestsCompleted, 1u);
+    EXPECT_GE(stats.maxLatencySeconds, stats.lastLatencySeconds);
+    // 1 级 1 帧，0 级 4 帧
+    EXPECT_EQ(frames, 5);
+
+    // 预算不够 0 级：放弃 0 级
+    streamer.setBudget(fullBytes - 1);
+    streamer.beginFrame(view, projection, 512.0f);
+    streamer.addUsage(texture, glm::vec3(-1.0f), glm::vec3(1.0f));
+    streamer.update();
+    EXPECT_EQ(stats.requestedBytes, fullBytes);
+    EXPECT_EQ(stats.residentBytes, level1Bytes + tailBytes);
+    EXPECT_EQ(stats.levelsEvicted, 1u);
+    EXPECT_EQ(texture->getGpuMemoryBytes(), level1Bytes + tailBytes);
+
+    // 本帧未使用：只保留常驻尾部
+    streamer.beginFrame(view, projection, 512.0f);
+    streamer.update();
+    EXPECT_EQ(stats.residentBytes, tailBytes);
+    EXPECT_EQ(stats.levelsEvicted, 2u);
+
+    texture.reset();
+    streamer.update();
+    EXPECT_EQ(stats.textures, 0u);
+    EXPECT_EQ(stats.residentBytes, 0u);
+}
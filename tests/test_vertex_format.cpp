@@ -0,0 +1,204 @@
+/**
+ * @file test_vertex_format.cpp
+ * @brief Unit tests for layout-driven vertex packing (no OpenGL context)
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include "mesh/VertexFormat.h"
+
+namespace {
+
+std::vector<Vertex> makeVertices() {
+    std::vector<Vertex> vertices;
+    for (int i = 0; i < 4; ++i) {
+        float f = static_cast<float>(i);
+        vertices.push_back(Vertex(glm::vec3(f, f + 0.1f, f + 0.2f),
+                                  glm::vec3(1.0f, f, 0.0f),
+                                  glm::vec2(f * 0.5f, 1.0f - f),
+                                  glm::vec3(0.0f, 0.0f, f),
+                                  glm::vec3(f, 0.0f, 1.0f)));
+    }
+    return vertices;
+}
+
+const float* floatsAt(const std::vector<unsigned char>& data, size_t byteOffset) {
+    return reinterpret_cast<const float*>(data.data() + byteOffset);
+}
+
+} // namespace
+
+TEST(VertexFormatTest, TemplateStridesMatchPresets) {
+    EXPECT_EQ(VertexFormat::PositionOnly::stride, VertexAttributeLayout::PositionOnly().stride);
+    EXPECT_EQ(VertexFormat::PositionNormal::stride, VertexAttributeLayout::PositionNormal().stride);
+    EXPECT_EQ(VertexFormat::PositionNormalTex::stride, VertexAttributeLayout::PositionNormalTex().stride);
+    EXPECT_EQ(VertexFormat::Full::stride, sizeof(Vertex));
+}
+
+TEST(VertexFormatTest, CanonicalMaskRecognisesPresets) {
+    EXPECT_EQ(VertexFormat::getCanonicalMask(VertexAttributeLayout::PositionOnly()), VertexFormat::PositionBit);
+    EXPECT_EQ(VertexFormat::getCanonicalMask(VertexAttributeLayout::PositionNormalTex()),
+              VertexFormat::PositionBit | VertexFormat::NormalBit | VertexFormat::TexCoordsBit);
+    EXPECT_TRUE(VertexFormat::matchesVertex(VertexAttributeLayout::Full()));
+    EXPECT_FALSE(VertexFormat::matchesVertex(VertexAttributeLayout::PositionNormalTex()));
+
+    // 顺序颠倒或分量数不同的布局不是常用形式
+    VertexAttributeLayout reversed;
+    reversed.addAttribute(VertexAttribute::Normal, 3);
+    reversed.addAttribute(VertexAttribute::Position, 3);
+    EXPECT_EQ(VertexFormat::getCanonicalMask(reversed), 0u);
+
+    VertexAttributeLayout shortPosition;
+    shortPosition.addAttribute(VertexAttribute::Position, 2);
+    EXPECT_EQ(VertexFormat::getCanonicalMask(shortPosition), 0u);
+}
+
+TEST(VertexFormatTest, PositionNormalTexPacksTightly) {
+    std::vector<Vertex> vertices = makeVertices();
+    VertexAttributeLayout layout = VertexAttributeLayout::PositionNormalTex();
+    std::vector<unsigned char> packed(vertices.size() * layout.stride);
+    VertexFormat::pack(layout, vertices.data(), vertices.size(), packed.data());
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const float* v = floatsAt(packed, i * layout.stride);
+        EXPECT_FLOAT_EQ(v[0], vertices[i].position.x);
+        EXPECT_FLOAT_EQ(v[2], vertices[i].position.z);
+        EXPECT_FLOAT_EQ(v[4], vertices[i].normal.y);
+        EXPECT_FLOAT_EQ(v[6], vertices[i].texCoords.x);
+        EXPECT_FLOAT_EQ(v[7], vertices[i].texCoords.y);
+    }
+}
+
+TEST(VertexFormatTest, SpecializedAndGenericPathsAgree) {
+    std::vector<Vertex> vertices = makeVertices();
+    const VertexAttributeLayout layouts[] = {
+        VertexAttributeLayout::PositionOnly(),
+        VertexAttributeLayout::PositionNormal(),
+        VertexAttributeLayout::PositionNormalTex(),
+        VertexAttributeLayout::Full()
+    };
+    for (const auto& layout : layouts) {
+        std::vector<unsigned char> specialized(vertices.size() * layout.stride);
+        std::vector<unsigned char> generic(vertices.size() * layout.stride);
+        VertexFormat::pack(layout, vertices.data(), vertices.size(), specialized.data());
+        VertexFormat::packGeneric(layout, vertices.data(), vertices.size(), generic.data());
+        EXPECT_EQ(specialized, generic) << "stride " << layout.stride;
+    }
+}
+
+TEST(VertexFormatTest, CustomLayoutUsesLayoutOffsets) {
+    std::vector<Vertex> vertices = makeVertices();
+    VertexAttributeLayout layout;
+    layout.addAttribute(VertexAttribute::TexCoords, 2);
+    layout.addAttribute(VertexAttribute::Position, 3);
+    layout.addAttribute(VertexAttribute::Tangent, 4);   // 多出的 w 分量补 0
+    ASSERT_EQ(layout.stride, 36u);
+
+    std::vector<unsigned char> packed(vertices.size() * layout.stride);
+    VertexFormat::pack(layout, vertices.data(), vertices.size(), packed.data());
+
+    const float* v = floatsAt(packed, 3 * layout.stride);
+    EXPECT_FLOAT_EQ(v[0], vertices[3].texCoords.x);
+    EXPECT_FLOAT_EQ(v[2], vertices[3].position.x);
+    EXPECT_FLOAT_EQ(v[7], vertices[3].tangent.z);
+    EXPECT_FLOAT_EQ(v[8], 0.0f);
+}
+
+TEST(VertexFormatTest, SameFormatComparesOffsetsAndStride) {
+    EXPECT_TRUE(VertexFormat::sameFormat(VertexAttributeLayout::PositionNormalTex(),
+                                         VertexAttributeLayout::PositionNormalTex()));
+    EXPECT_FALSE(VertexFormat::sameFormat(VertexAttributeLayout::PositionNormal(),
+                                          VertexAttributeLayout::PositionNormalTex()));
+
+    VertexAttributeLayout padded = VertexAttributeLayout::PositionOnly();
+    padded.stride = 16;
+    EXPECT_FALSE(VertexFormat::sameFormat(padded, VertexAttributeLayout::PositionOnly()));
+}
+
+TEST(VertexFormatTest, QuantizedPresetsShrinkStride) {
+    EXPECT_EQ(VertexAttributeLayout::Compact().stride, 20u);
+    EXPECT_EQ(VertexAttributeLayout::Quantized().stride, 16u);
+    EXPECT_TRUE(VertexFormat::isQuantized(VertexAttributeLayout::Compact()));
+    EXPECT_FALSE(VertexFormat::hasQuantizedPositions(VertexAttributeLayout::Compact()));
+    EXPECT_TRUE(VertexFormat::hasQuantizedPositions(VertexAttributeLayout::Quantized()));
+    EXPECT_FALSE(VertexFormat::isQuantized(VertexAttributeLayout::Full()));
+
+    // 编码不同的布局既不是常用形式，也不与 float 布局格式相同
+    EXPECT_EQ(VertexFormat::getCanonicalMask(VertexAttributeLayout::Quantized()), 0u);
+    VertexAttributeLayout halfPosition;
+    halfPosition.addAttribute(VertexAttribute::Position, 3, VertexAttributeFormat::Half);
+    halfPosition.stride = VertexAttributeLayout::PositionOnly().stride;
+    EXPECT_FALSE(VertexFormat::sameFormat(halfPosition, VertexAttributeLayout::PositionOnly()));
+}
+
+TEST(VertexFormatTest, PositionRangeCoversBoundingBox) {
+    std::vector<Vertex> vertices = makeVertices();
+    VertexFormat::PositionRange range = VertexFormat::computePositionRange(vertices.data(), vertices.size());
+    EXPECT_FLOAT_EQ(range.bias.x, 0.0f);
+    EXPECT_NEAR(range.bias.z, 0.2f, 1e-6f);
+    EXPECT_FLOAT_EQ(range.scale.x, 3.0f);
+    EXPECT_NEAR(range.scale.y, 3.0f, 1e-5f);
+}
+
+TEST(VertexFormatTest, QuantizedErrorStaysWithinBounds) {
+    // 单位球面上的顶点：法线即位置，切线沿纬线方向
+    std::vector<Vertex> vertices;
+    for (int i = 0; i < 16; ++i) {
+        for (int j = 1; j < 16; ++j) {
+            float phi = static_cast<float>(i) / 16.0f * 6.2831853f;
+            float theta = static_cast<float>(j) / 16.0f * 3.1415926f;
+            glm::vec3 n(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+            glm::vec3 t(-std::sin(phi), 0.0f, std::cos(phi));
+            glm::vec3 b = (i % 2) ? glm::cross(n, t) : -glm::cross(n, t);
+            vertices.push_back(Vertex(n * 10.0f, n, glm::vec2(phi / 6.2831853f, theta / 3.1415926f), t, b));
+        }
+    }
+
+    VertexAttributeLayout layout = VertexAttributeLayout::Quantized();
+    layout.addAttribute(VertexAttribute::Tangent, 4, VertexAttributeFormat::Snorm10);
+    VertexFormat::PositionRange range = VertexFormat::computePositionRange(vertices.data(), vertices.size());
+    VertexFormat::ErrorReport report = VertexFormat::measureError(layout, vertices.data(), vertices.size(), range);
+
+    EXPECT_EQ(report.bytesPerVertex, 20u);
+    // 20 单位的包围盒：每轴误差不超过半个量化步长
+    EXPECT_LE(report.maxPositionError, 20.0f / 65535.0f * 0.5f * 1.7321f + 1e-5f);
+    EXPECT_LT(report.maxNormalErrorDegrees, 0.2f);
+    EXPECT_LT(report.maxTangentErrorDegrees, 0.2f);
+    EXPECT_LT(report.maxTexCoordError, 1e-3f);
+    EXPECT_EQ(report.handednessMismatches, 0u);
+}
+
+TEST(VertexFormatTest, TangentHandednessStoredInW) {
+    std::vector<Vertex> vertices(2, Vertex(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f),
+                                           glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    vertices[1].bitangent = -vertices[1].bitangent;   // 镜像 UV
+
+    VertexAttributeLayout layout;
+    layout.addAttribute(VertexAttribute::Tangent, 4, VertexAttributeFormat::Snorm10);
+    std::vector<unsigned char> packed(vertices.size() * layout.stride);
+    VertexFormat::pack(layout, vertices.data(), vertices.size(), packed.data());
+
+    uint32_t first, second;
+    std::memcpy(&first, packed.data(), sizeof(first));
+    std::memcpy(&second, packed.data() + layout.stride, sizeof(second));
+    EXPECT_EQ(first >> 30, 1u);     // +1
+    EXPECT_EQ(second >> 30, 3u);    // -1（2 位补码）
+    EXPECT_EQ(first & 0x3FFu, 511u);
+}
+
+TEST(VertexFormatTest, PositionLayoutKeepsPositionEncoding) {
+    VertexAttributeLayout floatPositions = VertexFormat::getPositionLayout(VertexAttributeLayout::Full());
+    ASSERT_EQ(floatPositions.attributes.size(), 1u);
+    EXPECT_EQ(floatPositions.stride, 12u);
+    EXPECT_TRUE(VertexFormat::sameFormat(floatPositions, VertexAttributeLayout::PositionOnly()));
+
+    VertexAttributeLayout quantized = VertexFormat::getPositionLayout(VertexAttributeLayout::Quantized());
+    EXPECT_EQ(quantized.stride, 8u);
+    EXPECT_TRUE(VertexFormat::hasQuantizedPositions(quantized));
+
+    // 没有位置属性的布局退回 float3
+    VertexAttributeLayout texOnly;
+    texOnly.addAttribute(VertexAttribute::TexCoords, 2);
+    EXPECT_EQ(VertexFormat::getPositionLayout(texOnly).stride, 12u);
+}
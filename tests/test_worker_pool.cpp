@@ -0,0 +1,84 @@
+/**
+ * @file test_worker_pool.cpp
+ * @brief Unit tests for the background WorkerPool
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "core/WorkerPool.h"
+
+TEST(WorkerPoolTest, RunsAllSubmittedTasks) {
+    WorkerPool pool(3);
+    EXPECT_EQ(pool.getThreadCount(), 3u);
+
+    std::atomic<int> sum(0);
+    for (int i = 1; i <= 100; ++i) {
+        pool.submit([&sum, i]() { sum += i; });
+    }
+    pool.waitIdle();
+    EXPECT_EQ(sum.load(), 5050);
+    EXPECT_EQ(pool.getQueuedCount(), 0u);
+}
+
+TEST(WorkerPoolTest, TasksRunOffTheCallingThread) {
+    WorkerPool pool(2);
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    for (int i = 0; i < 8; ++i) {
+        pool.submit([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            ids.insert(std::this_thread::get_id());
+        });
+    }
+    pool.waitIdle();
+    EXPECT_EQ(ids.count(std::this_thread::get_id()), 0u);
+    EXPECT_LE(ids.size(), 2u);
+}
+
+TEST(WorkerPoolTest, SubmitDoesNotWaitForTasks) {
+    WorkerPool pool(1);
+    std::atomic<bool> release(false);
+    std::atomic<int> done(0);
+    pool.submit([&]() {
+        while (!release) std::this_thread::yield();
+        ++done;
+    });
+    pool.submit([&]() { ++done; });
+
+    // 第一个任务阻塞着唯一的线程，submit 仍然立即返回
+    EXPECT_EQ(done.load(), 0);
+    release = true;
+    pool.waitIdle();
+    EXPECT_EQ(done.load(), 2);
+}
+
+TEST(WorkerPoolTest, DestructorDropsQueuedTasks) {
+    std::atomic<bool> started(false);
+    std::atomic<bool> release(false);
+    std::atomic<int> ran(0);
+    {
+        WorkerPool pool(1);
+        pool.submit([&]() {
+            started = true;
+            while (!release) std::this_thread::yield();
+            ++ran;
+        });
+        for (int i = 0; i < 10; ++i) {
+            pool.submit([&]() { ++ran; });
+        }
+        while (!started) std::this_thread::yield();
+        EXPECT_EQ(pool.getQueuedCount(), 10u);
+
+        std::thread releaser([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            release = true;
+        });
+        releaser.detach();
+    }
+    // 正在执行的任务完成，排队的任务被丢弃
+    EXPECT_EQ(ran.load(), 1);
+}
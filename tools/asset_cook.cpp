@@ -0,0 +1,165 @@
+/**
+ * @file asset_cook.cpp
+ * @brief 离线纹理烘焙：把图片编码为带完整 mip 链的块压缩纹理（DDS / KTX）
+ *
+ * 用法：asset_cook [--format auto|bc1|bc3|bc4|bc5] [--quality fast|normal|high]
+ *                  [--mip-filter box|kaiser] [--linear-mips] [--normal] [--srgb] [--no-mips] [--ktx]
+ *                  [--output DIR] input...
+ *
+ * 默认按内容自动选择格式、输出到输入文件所在目录；mip 链用 Kaiser 滤波，颜色在线性空间计算。
+ * 每个文件输出尺寸、格式、编码吞吐与 0 级的 PSNR。
+ */
+
+#include "core/Parallel.h"
+#include "mesh/TextureEncoder.h"
+#include "mesh/stb_image.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    std::printf("usage: asset_cook [--format auto|bc1|bc3|bc4|bc5] [--quality fast|normal|high]\n"
+                "                  [--mip-filter box|kaiser] [--linear-mips] [--normal] [--srgb] [--no-mips] [--ktx]\n"
+                "                  [--output DIR] input...\n");
+}
+
+bool parseFormat(const char* name, BlockFormat& format) {
+    const struct { const char* name; BlockFormat format; } formats[] = {
+        { "auto", BlockFormat::Count }, { "bc1", BlockFormat::BC1 }, { "bc3", BlockFormat::BC3 },
+        { "bc4", BlockFormat::BC4 }, { "bc5", BlockFormat::BC5 }
+    };
+    for (const auto& f : formats) {
+        if (std::strcmp(name, f.name) == 0) {
+            format = f.format;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseQuality(const char* name, EncodeQuality& quality) {
+    for (int q = 0; q < static_cast<int>(EncodeQuality::Count); ++q) {
+        if (std::strcmp(name, TextureEncoder::getQualityName(static_cast<EncodeQuality>(q))) == 0) {
+            quality = static_cast<EncodeQuality>(q);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseFilter(const char* name, MipFilter& filter) {
+    for (int f = 0; f < static_cast<int>(MipFilter::Count); ++f) {
+        if (std::strcmp(name, ImageKernels::getFilterName(static_cast<MipFilter>(f))) == 0) {
+            filter = static_cast<MipFilter>(f);
+            return true;
+        }
+    }
+    return false;
+}
+
+// 输出路径：替换扩展名，指定了输出目录时放到该目录下
+std::string getOutputPath(const std::string& input, const std::string& outputDirectory, bool ktx) {
+    size_t slash = input.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? input : input.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos) name = name.substr(0, dot);
+    name += ktx ? ".ktx" : ".dds";
+
+    if (!outputDirectory.empty()) return outputDirectory + "/" + name;
+    return slash == std::string::npos ? name : input.substr(0, slash + 1) + name;
+}
+
+bool cook(const std::string& input, const std::string& output, const EncodeOptions& options) {
+    int width;
+    int height;
+    int channels;
+    unsigned char* pixels = stbi_load(input.c_str(), &width, &height, &channels, 0);
+    if (!pixels) {
+        std::printf("%s: failed to load image\n", input.c_str());
+        return false;
+    }
+
+    CompressedImage image;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    bool encoded = TextureEncoder::encode(pixels, width, height, channels, options, image, &error);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double psnr = encoded ? TextureEncoder::measurePSNR(pixels, width, height, channels, image) : 0.0;
+    stbi_image_free(pixels);
+
+    if (!encoded || !TextureContainer::save(output, image, &error)) {
+        std::printf("%s: %s\n", input.c_str(), error.c_str());
+        return false;
+    }
+
+    // 吞吐按全部级别的像素数计
+    double megapixels = 0.0;
+    for (const auto& level : image.levels) megapixels += static_cast<double>(level.width) * level.height / 1e6;
+    std::printf("%s -> %s (%dx%d %s, %zu levels, %zu KB, %.1f MP/s, PSNR %.2f dB)\n",
+                input.c_str(), output.c_str(), width, height, TextureContainer::getFormatName(image.format),
+                image.levels.size(), image.getByteSize() / 1024, megapixels / seconds, psnr);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    EncodeOptions options;
+    std::string outputDirectory;
+    bool ktx = false;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--format") == 0 && hasValue) {
+            if (!parseFormat(argv[++i], options.format)) {
+                std::printf("unknown format: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--quality") == 0 && hasValue) {
+            if (!parseQuality(argv[++i], options.quality)) {
+                std::printf("unknown quality: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--mip-filter") == 0 && hasValue) {
+            if (!parseFilter(argv[++i], options.mipFilter)) {
+                std::printf("unknown mip filter: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--output") == 0 && hasValue) {
+            outputDirectory = argv[++i];
+        } else if (std::strcmp(arg, "--normal") == 0) {
+            options.normalMap = true;
+        } else if (std::strcmp(arg, "--linear-mips") == 0) {
+            options.gammaCorrectMips = false;
+        } else if (std::strcmp(arg, "--srgb") == 0) {
+            options.srgb = true;
+        } else if (std::strcmp(arg, "--no-mips") == 0) {
+            options.generateMips = false;
+        } else if (std::strcmp(arg, "--ktx") == 0) {
+            ktx = true;
+        } else if (arg[0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::printf("asset_cook: %s quality, %s mips, %u threads\n", TextureEncoder::getQualityName(options.quality),
+                ImageKernels::getFilterName(options.mipFilter), Parallel::getMaxWorkers());
+    int failed = 0;
+    for (const std::string& input : inputs) {
+        if (!cook(input, getOutputPath(input, outputDirectory, ktx), options)) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}